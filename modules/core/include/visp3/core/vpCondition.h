@@ -0,0 +1,164 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Condition variable.
+ *
+ *****************************************************************************/
+
+#ifndef __vpCondition_h_
+#define __vpCondition_h_
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpMutex.h>
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+
+/*!
+
+   \class vpCondition
+
+   \ingroup group_core_threading
+
+   Condition variable that blocks a thread until another thread notifies it,
+   to be used with a vpMutex.
+
+   This class implements native pthread functionalities if available, or
+   native Windows condition variables if pthread is not available under
+   Windows.
+
+   As with any condition variable, wait() may return without notification:
+   the condition should always be checked again in a loop with the mutex
+   locked.
+
+\code
+#include <visp3/core/vpCondition.h>
+
+vpMutex mutex;
+vpCondition cond;
+bool ready = false;
+
+void consumer()
+{
+  vpMutex::vpScopedLock lock(mutex);
+  while (!ready)
+    cond.wait(mutex);
+}
+
+void producer()
+{
+  vpMutex::vpScopedLock lock(mutex);
+  ready = true;
+  cond.notifyAll();
+}
+\endcode
+
+   \sa vpMutex, vpThread
+*/
+class vpCondition
+{
+public:
+  vpCondition() : m_cond()
+  {
+#if defined(VISP_HAVE_PTHREAD)
+    pthread_cond_init(&m_cond, NULL);
+#elif defined(_WIN32)
+    InitializeConditionVariable(&m_cond);
+    InitializeSRWLock(&m_lock);
+#endif
+  }
+
+  ~vpCondition()
+  {
+#if defined(VISP_HAVE_PTHREAD)
+    pthread_cond_destroy(&m_cond);
+#endif
+  }
+
+  /*!
+    Unlock \e mutex, block until the condition is notified and lock \e mutex
+    again before returning.
+
+    \param mutex : Mutex locked by the calling thread.
+  */
+  void wait(vpMutex &mutex)
+  {
+#if defined(VISP_HAVE_PTHREAD)
+    pthread_cond_wait(&m_cond, &mutex.m_mutex);
+#elif defined(_WIN32)
+    // vpMutex is not a critical section: the internal lock is taken before
+    // the mutex is released, so that a notification cannot be sent before
+    // the thread sleeps
+    AcquireSRWLockExclusive(&m_lock);
+    mutex.unlock();
+    SleepConditionVariableSRW(&m_cond, &m_lock, INFINITE, 0);
+    ReleaseSRWLockExclusive(&m_lock);
+    mutex.lock();
+#endif
+  }
+
+  //! Wake up one of the threads waiting for the condition.
+  void notifyOne()
+  {
+#if defined(VISP_HAVE_PTHREAD)
+    pthread_cond_signal(&m_cond);
+#elif defined(_WIN32)
+    AcquireSRWLockExclusive(&m_lock);
+    WakeConditionVariable(&m_cond);
+    ReleaseSRWLockExclusive(&m_lock);
+#endif
+  }
+
+  //! Wake up all the threads waiting for the condition.
+  void notifyAll()
+  {
+#if defined(VISP_HAVE_PTHREAD)
+    pthread_cond_broadcast(&m_cond);
+#elif defined(_WIN32)
+    AcquireSRWLockExclusive(&m_lock);
+    WakeAllConditionVariable(&m_cond);
+    ReleaseSRWLockExclusive(&m_lock);
+#endif
+  }
+
+private:
+  vpCondition(const vpCondition &);
+  vpCondition &operator=(const vpCondition &);
+
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_cond_t m_cond;
+#elif defined(_WIN32)
+  CONDITION_VARIABLE m_cond;
+  SRWLOCK m_lock;
+#endif
+};
+
+#endif
+#endif
@@ -247,6 +247,8 @@ public:
   void init(unsigned int height, unsigned int width, Type value);
   //! init from an image stored as a continuous array in memory
   void init(Type *const array, const unsigned int height, const unsigned int width, const bool copyData = false);
+  //! init as a view on an image stored as a continuous array in memory it does not own
+  void initView(Type *const array, const unsigned int height, const unsigned int width);
   void insert(const vpImage<Type> &src, const vpImagePoint &topLeft);
 
   //------------------------------------------------------------------
@@ -347,6 +349,7 @@ private:
   unsigned int width;   ///! number of columns
   unsigned int height;  ///! number of rows
   Type **row;           ///! points the row pointer array
+  bool hasOwnership;    ///! true if the bitmap is allocated and freed by the image
 };
 
 template <class Type> std::ostream &operator<<(std::ostream &s, const vpImage<Type> &I)
@@ -667,10 +670,11 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
     }
   }
 
-  if ((h != this->height) || (w != this->width)) {
+  if ((h != this->height) || (w != this->width) || !hasOwnership) {
     if (bitmap != NULL) {
       vpDEBUG_TRACE(10, "Destruction bitmap[]");
-      delete[] bitmap;
+      if (hasOwnership)
+        delete[] bitmap;
       bitmap = NULL;
     }
   }
@@ -680,8 +684,10 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
 
   npixels = width * height;
 
-  if (bitmap == NULL)
+  if (bitmap == NULL) {
     bitmap = new Type[npixels];
+    hasOwnership = true;
+  }
 
   if (bitmap == NULL) {
     throw(vpException(vpException::memoryAllocationError, "cannot allocate bitmap "));
@@ -721,9 +727,11 @@ void vpImage<Type>::init(Type *const array, const unsigned int h, const unsigned
   }
 
   // Delete bitmap if copyData==false, otherwise only if the dimension differs
-  if ((copyData && ((h != this->height) || (w != this->width))) || !copyData) {
+  // or if the bitmap is not owned by the image
+  if ((copyData && ((h != this->height) || (w != this->width) || !hasOwnership)) || !copyData) {
     if (bitmap != NULL) {
-      delete[] bitmap;
+      if (hasOwnership)
+        delete[] bitmap;
       bitmap = NULL;
     }
   }
@@ -743,9 +751,11 @@ void vpImage<Type>::init(Type *const array, const unsigned int h, const unsigned
 
     // Copy the image data
     memcpy(bitmap, array, (size_t)(npixels * sizeof(Type)));
+    hasOwnership = true;
   } else {
     // Copy the address of the array in the bitmap
     bitmap = array;
+    hasOwnership = true;
   }
 
   if (row == NULL)
@@ -759,6 +769,32 @@ void vpImage<Type>::init(Type *const array, const unsigned int h, const unsigned
   }
 }
 
+/*!
+  \brief Image initialization
+
+  Init the image as a view on image data stored as a continuous array in
+  memory, without copying them. Contrary to init(Type *const, const unsigned int,
+  const unsigned int, const bool), the image does not own \e array: it is not
+  freed by the image, it has to remain valid while the image uses it and has
+  to be released by the caller. Resizing the image afterwards allocates a new
+  bitmap owned by the image.
+
+  This is useful to access memory that was not allocated with new[], like a
+  memory mapped file.
+
+  \param array : Image data stored as a continuous array in memory
+  \param h : Image height.
+  \param w : Image width.
+
+  \exception vpException::memoryAllocationError
+*/
+template <class Type>
+void vpImage<Type>::initView(Type *const array, const unsigned int h, const unsigned int w)
+{
+  init(array, h, w, false);
+  hasOwnership = false;
+}
+
 /*!
   \brief Constructor
 
@@ -779,7 +815,7 @@ void vpImage<Type>::init(Type *const array, const unsigned int h, const unsigned
 */
 template <class Type>
 vpImage<Type>::vpImage(unsigned int h, unsigned int w)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
 {
   init(h, w, 0);
 }
@@ -803,7 +839,7 @@ vpImage<Type>::vpImage(unsigned int h, unsigned int w)
 */
 template <class Type>
 vpImage<Type>::vpImage(unsigned int h, unsigned int w, Type value)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
 {
   init(h, w, value);
 }
@@ -825,7 +861,7 @@ vpImage<Type>::vpImage(unsigned int h, unsigned int w, Type value)
 */
 template <class Type>
 vpImage<Type>::vpImage(Type *const array, const unsigned int h, const unsigned int w, const bool copyData)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
 {
   init(array, h, w, copyData);
 }
@@ -839,7 +875,9 @@ vpImage<Type>::vpImage(Type *const array, const unsigned int h, const unsigned i
 
   \sa vpImage::resize(height, width) for memory allocation
 */
-template <class Type> vpImage<Type>::vpImage() : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+template <class Type>
+vpImage<Type>::vpImage()
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
 {
 }
 
@@ -899,9 +937,11 @@ template <class Type> void vpImage<Type>::destroy()
   if (bitmap != NULL) {
     //  vpERROR_TRACE("Deallocate bitmap memory %p",bitmap);
     //    vpDEBUG_TRACE(20,"Deallocate bitmap memory %p",bitmap);
-    delete[] bitmap;
+    if (hasOwnership)
+      delete[] bitmap;
     bitmap = NULL;
   }
+  hasOwnership = true;
 
   if (row != NULL) {
     //   vpERROR_TRACE("Deallocate row memory %p",row);
@@ -923,7 +963,8 @@ template <class Type> vpImage<Type>::~vpImage() { destroy(); }
   Copy constructor
 */
 template <class Type>
-vpImage<Type>::vpImage(const vpImage<Type> &I) : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+vpImage<Type>::vpImage(const vpImage<Type> &I)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
 {
   resize(I.getHeight(), I.getWidth());
   memcpy(bitmap, I.bitmap, I.npixels * sizeof(Type));
@@ -935,7 +976,8 @@ vpImage<Type>::vpImage(const vpImage<Type> &I) : bitmap(NULL), display(NULL), np
 */
 template <class Type>
 vpImage<Type>::vpImage(vpImage<Type> &&I)
-  : bitmap(I.bitmap), display(I.display), npixels(I.npixels), width(I.width), height(I.height), row(I.row)
+  : bitmap(I.bitmap), display(I.display), npixels(I.npixels), width(I.width), height(I.height), row(I.row),
+    hasOwnership(I.hasOwnership)
 {
   I.bitmap = NULL;
   I.display = NULL;
@@ -943,6 +985,7 @@ vpImage<Type>::vpImage(vpImage<Type> &&I)
   I.width = 0;
   I.height = 0;
   I.row = NULL;
+  I.hasOwnership = true;
 }
 #endif
 
@@ -1973,6 +2016,7 @@ template <class Type> void swap(vpImage<Type> &first, vpImage<Type> &second)
   swap(first.width, second.width);
   swap(first.height, second.height);
   swap(first.row, second.row);
+  swap(first.hasOwnership, second.hasOwnership);
 }
 
 #endif
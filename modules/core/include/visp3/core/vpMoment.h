@@ -153,11 +153,13 @@ public:
      \return vector of values
    */
   const std::vector<double> &get() const { return values; }
+  virtual void getDependencies(std::vector<const char *> &names) const;
   void linkTo(vpMomentDatabase &moments);
   virtual const char *name() const = 0;
   virtual void printDependencies(std::ostream &os) const;
   void update(vpMomentObject &object);
   //@}
   friend VISP_EXPORT std::ostream &operator<<(std::ostream &os, const vpMoment &m);
+  friend class vpMomentDatabase;
 };
 #endif
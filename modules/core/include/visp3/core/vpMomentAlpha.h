@@ -227,6 +227,7 @@ public:
           Moment name.
           */
   const char *name() const { return "vpMomentAlpha"; }
+  void getDependencies(std::vector<const char *> &names) const;
 
   inline bool is_ref() const
   {
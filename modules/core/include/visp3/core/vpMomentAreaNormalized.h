@@ -173,6 +173,7 @@ public:
     Moment name.
   */
   const char *name() const { return "vpMomentAreaNormalized"; }
+  void getDependencies(std::vector<const char *> &names) const;
   friend VISP_EXPORT std::ostream &operator<<(std::ostream &os, const vpMomentAreaNormalized &v);
   void printDependencies(std::ostream &os) const;
 };
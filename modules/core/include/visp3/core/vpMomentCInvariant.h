@@ -230,6 +230,7 @@ public:
     Moment name.
     */
   const char *name() const { return "vpMomentCInvariant"; }
+  void getDependencies(std::vector<const char *> &names) const;
 
   /*!
     Print partial invariant.
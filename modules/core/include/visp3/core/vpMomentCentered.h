@@ -90,6 +90,7 @@ public:
      Moment name.
   */
   inline const char *name() const { return "vpMomentCentered"; }
+  void getDependencies(std::vector<const char *> &names) const;
 
   friend VISP_EXPORT std::ostream &operator<<(std::ostream &os, const vpMomentCentered &v);
   void printWithIndices(std::ostream &os) const;
@@ -47,6 +47,7 @@
 #include <cstring>
 #include <iostream>
 #include <map>
+#include <vector>
 
 class vpMoment;
 class vpMomentObject;
@@ -127,6 +128,26 @@ Centered moments:
 Consequently, a database can contain at most one moment of each type. Often it
 is useful to update all moments with the same object. Shortcuts
 (vpMomentDatabase::updateAll) are provided for that matter.
+
+  The dependencies declared by each moment (see vpMoment::getDependencies())
+are resolved once into an ordered list of moments, so that
+vpMomentDatabase::computeAll() updates and computes all the moments in a single
+linear pass:
+\code
+  vpMomentDatabase db;
+  vpMomentGravityCenter g;
+  vpMomentCentered mc;
+  mc.linkTo(db); // the link order does not matter
+  g.linkTo(db);
+
+  db.computeAll(obj); // computes g before mc
+\endcode
+  computeAll() always computes all the moments. When the same object may be
+given several times, computeAllIfChanged() can be used instead: it returns
+without computing anything if the object did not change since the last
+computation. Each time the moments are computed the database revision returned
+by getRevision() is incremented. This allows moment features to detect that
+the moments they rely on have changed.
 */
 class VISP_EXPORT vpMomentDatabase
 {
@@ -137,14 +158,34 @@ private:
   };
 #endif
   std::map<const char *, vpMoment *, cmp_str> moments;
+  //! Moments in the order they were linked to the database
+  std::vector<vpMoment *> linkOrder;
+  //! Moments sorted such as each moment comes after its dependencies
+  std::vector<vpMoment *> computeOrder;
+  bool compiled;
+  bool upToDate;
+  unsigned long revision;
+  //! Copy of the object used for the last computation
+  std::vector<double> lastObjectValues;
+  int lastObjectType;
+
   void add(vpMoment &moment, const char *name);
+  void compileNode(unsigned int index, std::vector<int> &state);
+  void computeOrdered(vpMomentObject &object);
 
 public:
-  vpMomentDatabase() : moments() {}
+  vpMomentDatabase()
+    : moments(), linkOrder(), computeOrder(), compiled(false), upToDate(false), revision(0), lastObjectValues(),
+      lastObjectType(-1)
+  {
+  }
   virtual ~vpMomentDatabase() {}
 
   /** @name Inherited functionalities from vpMomentDatabase */
   //@{
+  void compile();
+  virtual void computeAll(vpMomentObject &object);
+  bool computeAllIfChanged(vpMomentObject &object);
   const vpMoment &get(const char *type, bool &found) const;
   /*!
     Get the first element in the database.
@@ -152,6 +193,21 @@ public:
     in the database. \return the first element in the database.
     */
   vpMoment &get_first() { return *(moments.begin()->second); }
+  /*!
+    Moments of the database sorted in computation order. Updated by
+    compile().
+  */
+  const std::vector<vpMoment *> &getComputeOrder() const { return computeOrder; }
+  /*!
+    Number of times the moments were computed by computeAll() or updated by
+    updateAll().
+  */
+  unsigned long getRevision() const { return revision; }
+  /*!
+    Forces the next call to computeAllIfChanged() to compute all the moments,
+    for example after a change of a moment parameter.
+  */
+  void invalidate() { upToDate = false; }
 
   virtual void updateAll(vpMomentObject &object);
   //@}
@@ -261,6 +261,8 @@ public:
   void fromImage(const vpImage<unsigned char> &image, const vpCameraParameters &cam, vpCameraImgBckGrndType bg_type,
                  bool normalize_with_pix_size = true); // Photometric version
 
+  static void fromLabels(const vpImage<int> &labels, const vpCameraParameters &cam,
+                         std::vector<vpMomentObject> &objects);
   void fromVector(std::vector<vpPoint> &points);
   const std::vector<double> &get() const;
   double get(unsigned int i, unsigned int j) const;
@@ -308,6 +310,9 @@ protected:
 
 private:
   void cacheValues(std::vector<double> &cache, double x, double y, double IntensityNormalized);
+  void addPowers(std::vector<double> &sums, double x) const;
+  static void computeCoordinateTables(unsigned int ncols, unsigned int nrows, const vpCameraParameters &cam,
+                                      std::vector<double> &xtab, std::vector<double> &ytab);
   double calc_mom_polygon(unsigned int p, unsigned int q, const std::vector<vpPoint> &points);
 };
 
@@ -40,6 +40,9 @@
 #define vpNetwork_H
 
 #include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpRGBa.h>
 #include <visp3/core/vpRequest.h>
 
 #include <iostream>
@@ -54,7 +57,9 @@
 #  include <arpa/inet.h>
 #  include <netdb.h>
 #  include <netinet/in.h>
+#  include <poll.h>
 #  include <sys/socket.h>
+#  include <sys/uio.h>
 #  include <unistd.h>
 #else
 #  include <io.h>
@@ -77,6 +82,24 @@
   TCP provides reliable, ordered delivery of a stream of bytes from a program
   on one computer to another program on another computer.
 
+  Besides the string based requests (see vpRequest), the network can
+  exchange binary frames. A frame is a small fixed size header giving the
+  type, the dimensions and the size of the payload, followed by the raw
+  payload. Frames are sent with a single scatter/gather system call directly
+  from the image or matrix memory, and received directly in the destination
+  image or matrix, without any intermediate string. Both sides are supposed
+  to share the same endianness and floating point representation.
+
+  \code
+vpImage<unsigned char> I;
+// On the emitter side
+client.sendImage(I);
+// On the receptor side
+if (server.receiveImageFrom(I, 0) > 0) {
+  // I is resized to the received image and filled
+}
+  \endcode
+
   \warning This class shouldn't be used directly. You better use vpClient and
   vpServer to simulate your network. Some exemples are provided in these
   classes.
@@ -86,6 +109,16 @@
 */
 class VISP_EXPORT vpNetwork
 {
+public:
+  /*! Type of the payload carried by a binary frame. */
+  typedef enum {
+    FRAME_RAW = 0,     /*!< Opaque array of bytes. */
+    FRAME_IMAGE_UCHAR, /*!< vpImage<unsigned char>. */
+    FRAME_IMAGE_RGBA,  /*!< vpImage<vpRGBa>. */
+    FRAME_IMAGE_FLOAT, /*!< vpImage<float>. */
+    FRAME_MATRIX       /*!< vpMatrix. */
+  } vpFrameType;
+
 protected:
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
   struct vpReceptor {
@@ -143,6 +176,10 @@ protected:
 
   std::string currentMessageReceived;
 
+  // Binary frames
+  unsigned int max_size_frame;
+  std::vector<unsigned char> frameDiscarded;
+
   struct timeval tv;
   long tv_sec;
   long tv_usec;
@@ -158,6 +195,16 @@ private:
   int _receiveRequestOnce();
   int _receiveRequestOnceFrom(const unsigned int &receptorEmitting);
 
+  int _waitForReceptor(const int &receptorEmitting, unsigned int &receptorReady);
+  int _sendFrameTo(const unsigned int &type, const unsigned int &rows, const unsigned int &cols, const void *data,
+                   const unsigned int &size, const unsigned int &dest);
+  int _receiveFrameHeaderFrom(const int &receptorEmitting, unsigned int &receptorReady, unsigned int &type,
+                              unsigned int &rows, unsigned int &cols, unsigned int &size);
+  int _receiveFramePayloadFrom(const unsigned int &receptorEmitting, void *data, const unsigned int &size);
+  int _discardFramePayloadFrom(const unsigned int &receptorEmitting, const unsigned int &size);
+  template <class Type>
+  int _receiveImageFrom(vpImage<Type> &I, const unsigned int &type, const int &receptorEmitting);
+
 public:
   vpNetwork();
   virtual ~vpNetwork();
@@ -189,6 +236,15 @@ public:
   */
   unsigned int getMaxSizeReceivedMessage() { return max_size_message; }
 
+  /*!
+    Get the maximum payload size of a binary frame that can be received.
+
+    \sa vpNetwork::setMaxSizeReceivedFrame()
+
+    \return Actual max size value.
+  */
+  unsigned int getMaxSizeReceivedFrame() { return max_size_frame; }
+
   void print(const char *id = "");
 
   template <typename T> int receive(T *object, const unsigned int &sizeOfObject = sizeof(T));
@@ -200,6 +256,17 @@ public:
   int receiveRequestOnce();
   int receiveRequestOnceFrom(const unsigned int &receptorEmitting);
 
+  int receiveFrame(std::vector<unsigned char> &data);
+  int receiveFrameFrom(std::vector<unsigned char> &data, const unsigned int &receptorEmitting);
+  int receiveImage(vpImage<unsigned char> &I);
+  int receiveImage(vpImage<vpRGBa> &I);
+  int receiveImage(vpImage<float> &I);
+  int receiveImageFrom(vpImage<unsigned char> &I, const unsigned int &receptorEmitting);
+  int receiveImageFrom(vpImage<vpRGBa> &I, const unsigned int &receptorEmitting);
+  int receiveImageFrom(vpImage<float> &I, const unsigned int &receptorEmitting);
+  int receiveMatrix(vpMatrix &M);
+  int receiveMatrixFrom(vpMatrix &M, const unsigned int &receptorEmitting);
+
   std::vector<int> receiveAndDecodeRequest();
   std::vector<int> receiveAndDecodeRequestFrom(const unsigned int &receptorEmitting);
   int receiveAndDecodeRequestOnce();
@@ -210,6 +277,17 @@ public:
   template <typename T> int send(T *object, const int unsigned &sizeOfObject = sizeof(T));
   template <typename T> int sendTo(T *object, const unsigned int &dest, const unsigned int &sizeOfObject = sizeof(T));
 
+  int sendFrame(const void *data, const unsigned int &size);
+  int sendFrameTo(const void *data, const unsigned int &size, const unsigned int &dest);
+  int sendImage(const vpImage<unsigned char> &I);
+  int sendImage(const vpImage<vpRGBa> &I);
+  int sendImage(const vpImage<float> &I);
+  int sendImageTo(const vpImage<unsigned char> &I, const unsigned int &dest);
+  int sendImageTo(const vpImage<vpRGBa> &I, const unsigned int &dest);
+  int sendImageTo(const vpImage<float> &I, const unsigned int &dest);
+  int sendMatrix(const vpMatrix &M);
+  int sendMatrixTo(const vpMatrix &M, const unsigned int &dest);
+
   int sendRequest(vpRequest &req);
   int sendRequestTo(vpRequest &req, const unsigned int &dest);
 
@@ -225,6 +303,18 @@ public:
   */
   void setMaxSizeReceivedMessage(const unsigned int &s) { max_size_message = s; }
 
+  /*!
+    Change the maximum payload size of a binary frame that can be received.
+    A frame announcing a larger payload is considered as corrupted and the
+    connection with its emitter is closed. Initially this value is set to
+    64 MB.
+
+    \sa vpNetwork::getMaxSizeReceivedFrame()
+
+    \param s : new maximum size value.
+  */
+  void setMaxSizeReceivedFrame(const unsigned int &s) { max_size_frame = s; }
+
   /*!
     Change the time the emitter spend to check if he receives a message from a
     receptor. Initially this value is set to 10usec.
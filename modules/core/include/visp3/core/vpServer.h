@@ -159,6 +159,36 @@ int main(int argc,const char** argv)
 }
   \endcode
 
+  Exemple of server's code, serving several clients streaming images as
+  binary frames (see vpNetwork). A single poll() call accepts the new
+  clients, detects the disconnected ones and returns the clients having
+  sent something.
+
+  \code
+#include <visp3/core/vpServer.h>
+
+int main()
+{
+  vpServer serv(35000);
+  serv.setTimeoutSec(1);
+  serv.start();
+
+  vpImage<unsigned char> I;
+  std::vector<unsigned int> clients;
+
+  while (true) {
+    if (serv.checkForEvents(clients) > 0) {
+      for (size_t i = 0; i < clients.size(); i++) {
+        if (serv.receiveImageFrom(I, clients[i]) > 0)
+          std::cout << "Image " << I.getWidth() << "x" << I.getHeight() << " from client " << clients[i] << std::endl;
+      }
+    }
+  }
+
+  return 0;
+}
+  \endcode
+
   \sa vpClient
   \sa vpRequest
   \sa vpNetwork
@@ -174,6 +204,8 @@ private:
   bool started;
   unsigned int max_clients;
 
+  bool _acceptClient();
+
 public:
   vpServer();
   explicit vpServer(const int &port);
@@ -182,6 +214,7 @@ public:
   virtual ~vpServer();
 
   bool checkForConnections();
+  int checkForEvents(std::vector<unsigned int> &clients);
 
   /*!
     Check if the server is started.
@@ -0,0 +1,177 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Shared memory ring of images and point clouds between processes.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpSharedMemoryRing.h
+  \brief Shared memory ring of images and point clouds between processes.
+*/
+
+#ifndef vpSharedMemoryRing_h
+#define vpSharedMemoryRing_h
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+#include <visp3/core/vpTime.h>
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+
+/*!
+  \class vpSharedMemoryRing
+
+  \ingroup group_core_com
+
+  \brief Ring of frames in POSIX shared memory, written by a single
+  producer process and read by several consumer processes.
+
+  The producer creates a named ring of fixed size slots with create() and
+  publishes images, depth maps or point clouds with write(). Each published
+  frame gets an increasing sequence number and a timestamp. Consumers
+  attach to the ring with open(), wait for a new frame with wait() and get
+  a view on the latest frame with acquire(): the image returned by
+  acquire() doesn't own its pixels but points directly into the shared
+  memory, so that nothing is copied on the consumer side.
+
+  An acquired slot is pinned and never overwritten by the producer until it
+  is released, either explicitly with release() or by the next call to
+  acquire(). When all the slots are pinned by consumers, the producer drops
+  the frame instead of blocking (see getDroppedFrames()), so that a slow
+  consumer never slows down the acquisition. A ring should thus have more
+  slots than consumers.
+
+  On Linux the consumers sleep on a futex located in the shared memory and
+  are woken up by the producer at each new frame. On other UNIX systems
+  they poll the sequence number every millisecond.
+
+  \code
+#include <visp3/core/vpSharedMemoryRing.h>
+
+// Producer process
+vpSharedMemoryRing producer;
+producer.create("/camera", 4, 640 * 480 * sizeof(vpRGBa));
+vpImage<vpRGBa> I(480, 640);
+while (grab(I))
+  producer.write(I, vpTime::measureTimeMs());
+
+// Consumer process
+vpSharedMemoryRing consumer;
+consumer.open("/camera");
+vpImage<vpRGBa> view;
+unsigned long long sequence = 0;
+double timestamp;
+while (consumer.wait(sequence, 1000)) {
+  if (consumer.acquire(view, sequence, timestamp)) {
+    // view is valid until the next call to acquire() or release()
+  }
+}
+  \endcode
+
+  \warning The pixels of an acquired image must not be modified. A consumer
+  that crashes while holding a slot keeps it pinned until the ring is
+  created again.
+*/
+class VISP_EXPORT vpSharedMemoryRing
+{
+public:
+  //! Type of the data stored in a slot.
+  typedef enum {
+    DATA_UCHAR,      //!< vpImage<unsigned char>.
+    DATA_UINT16,     //!< vpImage<uint16_t>, for instance a raw depth map.
+    DATA_FLOAT,      //!< vpImage<float>, for instance a metric depth map.
+    DATA_RGBA,       //!< vpImage<vpRGBa>.
+    DATA_POINT_CLOUD //!< Point cloud stored as a vpImage<float> with one (X, Y, Z) row per point.
+  } vpDataType;
+
+  vpSharedMemoryRing();
+  virtual ~vpSharedMemoryRing();
+
+  bool acquire(vpImage<unsigned char> &I, unsigned long long &sequence, double &timestamp);
+  bool acquire(vpImage<uint16_t> &I, unsigned long long &sequence, double &timestamp);
+  bool acquire(vpImage<float> &I, unsigned long long &sequence, double &timestamp);
+  bool acquire(vpImage<vpRGBa> &I, unsigned long long &sequence, double &timestamp);
+  bool acquirePointCloud(vpImage<float> &pointcloud, unsigned long long &sequence, double &timestamp);
+
+  void close();
+  void create(const std::string &name, const unsigned int nb_slots, const size_t slot_size);
+
+  //! Return the number of frames dropped by the producer because all the
+  //! slots were pinned by consumers.
+  inline unsigned int getDroppedFrames() const { return m_droppedFrames; }
+  //! Return the name of the shared memory object.
+  inline std::string getName() const { return m_name; }
+  unsigned int getNbSlots() const;
+  unsigned long long getSequence() const;
+  size_t getSlotSize() const;
+  //! Return true if the ring has been created or opened.
+  inline bool isOpen() const { return m_data != NULL; }
+
+  void open(const std::string &name);
+  void release();
+  bool wait(const unsigned long long sequence, const int timeout_ms);
+
+  bool write(const vpImage<unsigned char> &I, const double timestamp = vpTime::measureTimeMs());
+  bool write(const vpImage<uint16_t> &I, const double timestamp = vpTime::measureTimeMs());
+  bool write(const vpImage<float> &I, const double timestamp = vpTime::measureTimeMs());
+  bool write(const vpImage<vpRGBa> &I, const double timestamp = vpTime::measureTimeMs());
+  bool writePointCloud(const std::vector<vpColVector> &pointcloud, const double timestamp = vpTime::measureTimeMs());
+
+private:
+  vpSharedMemoryRing(const vpSharedMemoryRing &);            // noncopyable
+  vpSharedMemoryRing &operator=(const vpSharedMemoryRing &); //
+
+  template <class Type>
+  bool acquireSlot(vpImage<Type> &I, const vpDataType type, unsigned long long &sequence, double &timestamp);
+  int beginWrite(const size_t size);
+  void endWrite(const int slot, const vpDataType type, const unsigned int width, const unsigned int height,
+                const size_t size, const double timestamp);
+  unsigned char *getSlotData(const int slot) const;
+  template <class Type> bool writeImage(const vpImage<Type> &I, const vpDataType type, const double timestamp);
+
+  std::string m_name;
+  unsigned char *m_data;
+  size_t m_size;
+  bool m_isProducer;
+  int m_acquiredSlot;
+  int m_writtenSlot;
+  unsigned int m_droppedFrames;
+};
+
+#endif
+#endif
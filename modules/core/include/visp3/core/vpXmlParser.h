@@ -53,7 +53,9 @@
 #include <libxml/parser.h>
 
 #include <iomanip>
+#include <istream>
 #include <map>
+#include <ostream>
 #include <sstream>
 #include <string.h>
 #include <string>
@@ -173,6 +175,28 @@
   }
   \endcode
 
+  When the same configuration files are loaded at each startup, the values
+  resolved by the parser can be cached with setCacheDirectory(). The child
+  class has then to implement readCacheData() and writeCacheData() to
+  serialize its internal variables:
+
+  \code
+  bool
+  vpDataParser::readCacheData(std::istream &is)
+  {
+    return readCacheValue(is, m_range) && readCacheValue(is, m_step) && readCacheValue(is, m_size_filter);
+  }
+
+  bool
+  vpDataParser::writeCacheData(std::ostream &os) const
+  {
+    writeCacheValue(os, m_range);
+    writeCacheValue(os, m_step);
+    writeCacheValue(os, m_size_filter);
+    return true;
+  }
+  \endcode
+
 */
 class VISP_EXPORT vpXmlParser
 {
@@ -217,6 +241,66 @@ protected:
   void xmlWriteIntChild(xmlNodePtr node, const char *label, const int value);
   void xmlWriteStringChild(xmlNodePtr node, const char *label, const std::string &value);
   void xmlWriteUnsignedIntChild(xmlNodePtr node, const char *label, const unsigned int value);
+
+  /*!
+    Read the internal variables of the child class from a cache entry written
+    by writeCacheData(). The default implementation returns false, meaning
+    that the child class does not support caching.
+
+    The variables should only be modified once the whole entry is read, so
+    that an invalid entry leaves the parser unchanged.
+
+    \param is : Stream to read from.
+    \return true if the variables were successfully read.
+  */
+  virtual bool readCacheData(std::istream & /*is*/) { return false; }
+
+  /*!
+    Write the internal variables of the child class that are modified by
+    readMainClass(). The default implementation returns false, meaning that
+    the child class does not support caching.
+
+    This method is also used before parsing to identify the initial state of
+    the parser, since values that are not in the file keep their previous
+    value.
+
+    \param os : Stream to write to.
+    \return true if the variables were written.
+  */
+  virtual bool writeCacheData(std::ostream & /*os*/) const { return false; }
+
+  std::string getCacheFilename(const std::string &content, const std::string &key) const;
+  static bool readCacheFile(const std::string &filename, std::string &data);
+  static bool readFile(const std::string &filename, std::string &content);
+  static void writeCacheFile(const std::string &filename, const std::string &data);
+
+  /*!
+    Read a value written by writeCacheValue().
+
+    \param is : Stream to read from.
+    \param value : Read value.
+    \return true if the value was read.
+  */
+  template <typename Type> static bool readCacheValue(std::istream &is, Type &value)
+  {
+    is.read(reinterpret_cast<char *>(&value), sizeof(Type));
+    return !is.fail();
+  }
+  static bool readCacheValue(std::istream &is, std::string &value);
+
+  /*!
+    Write a value of a plain type in a cache entry. The value is stored with
+    the native representation, cache entries being only intended to be read
+    on the machine that wrote them.
+
+    \param os : Stream to write to.
+    \param value : Value to write.
+  */
+  template <typename Type> static void writeCacheValue(std::ostream &os, const Type &value)
+  {
+    os.write(reinterpret_cast<const char *>(&value), sizeof(Type));
+  }
+  static void writeCacheValue(std::ostream &os, const std::string &value);
   //@}
 
 protected:
@@ -230,6 +314,12 @@ protected:
   */
   std::string main_tag;
 
+  /*!
+    Directory where the parsed values are cached, empty if the cache is
+    disabled
+  */
+  std::string m_cacheDirectory;
+
 public:
   /** @name Public Member Functions Inherited from vpXmlParser */
   //@{
@@ -240,6 +330,32 @@ public:
   /* virtual */ void parse(const std::string &filename);
   /* virtual */ void save(const std::string &filename, const bool append = false);
 
+  /*!
+    Get the directory where parsed values are cached.
+
+    \return The cache directory, empty if the cache is disabled.
+
+    \sa setCacheDirectory()
+  */
+  inline std::string getCacheDirectory() const { return m_cacheDirectory; }
+
+  /*!
+    Enable the cache of the parsed values. When enabled, parse() stores the
+    values it resolved in a binary file of \e dirname whose name is a hash of
+    the XML file content, of the parser type and of the parser state before
+    parsing. The next parse of an unchanged file with the same parser state
+    reads this entry instead of parsing the XML document.
+
+    The directory is created if it does not exist. Cache entries are native
+    binary files that are only intended to be read on the machine that wrote
+    them. If the cache cannot be read or written, the XML file is parsed as
+    usual.
+
+    \param dirname : Cache directory. Set an empty string to disable the
+    cache, which is the default.
+  */
+  inline void setCacheDirectory(const std::string &dirname) { m_cacheDirectory = dirname; }
+
   /*!
     Set the map describing the data to parse. This map stores the name of each
     node and an associated key used to simplify the parsing of the file.
@@ -308,6 +424,9 @@ public:
   could be called just before exit().
     */
   static void cleanup() { xmlCleanupParser(); }
+
+  static std::string getDefaultCacheDirectory();
+  static void setDefaultCacheDirectory(const std::string &dirname);
   //@}
 };
 
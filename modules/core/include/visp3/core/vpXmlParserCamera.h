@@ -51,6 +51,7 @@
 #ifdef VISP_HAVE_XML2
 
 #include <libxml/xmlmemory.h> /* Functions of libxml.                */
+#include <libxml/xmlreader.h>
 #include <string>
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpXmlParser.h>
@@ -70,6 +71,10 @@ https://visp.inria.fr/3rd_xml2.
   corresponding projection model implemented in ViSP, see
   vpCameraParameters.
 
+  Files are read with a streaming parser that expands the camera entries one
+  at a time. When the same files are loaded at each startup, the resolved
+  parameters can be cached with setCacheDirectory() to skip XML parsing.
+
   Example of an XML file "myXmlFile.xml" containing intrinsic camera
   parameters:
 
@@ -260,7 +265,7 @@ public:
   void setWidth(const unsigned int width) { this->image_width = width; }
 
 private:
-  int read(xmlDocPtr doc, xmlNodePtr node, const std::string &camera_name,
+  int read(xmlTextReaderPtr reader, const std::string &camera_name,
            const vpCameraParameters::vpCameraParametersProjType &projModel, const unsigned int image_width = 0,
            const unsigned int image_height = 0, const unsigned int subsampling_width = 0,
            const unsigned int subsampling_height = 0);
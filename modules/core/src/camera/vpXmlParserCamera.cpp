@@ -45,6 +45,7 @@
 #include <visp3/core/vpXmlParserCamera.h>
 #ifdef VISP_HAVE_XML2
 
+#include <sstream>
 #include <stdlib.h>
 #include <string.h>
 
@@ -78,6 +79,82 @@
 #define LABEL_XML_MODEL_WITH_DISTORTION "perspectiveProjWithDistortion"
 
 #define LABEL_XML_ADDITIONAL_INFO "additional_information"
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+struct vpXmlCameraLabel {
+  const char *label;
+  vpXmlParserCamera::vpXmlCodeType code;
+};
+
+const vpXmlCameraLabel xmlCameraLabels[] = {
+    {LABEL_XML_CAMERA, vpXmlParserCamera::CODE_XML_CAMERA},
+    {LABEL_XML_CAMERA_NAME, vpXmlParserCamera::CODE_XML_CAMERA_NAME},
+    {LABEL_XML_MODEL, vpXmlParserCamera::CODE_XML_MODEL},
+    {LABEL_XML_MODEL_TYPE, vpXmlParserCamera::CODE_XML_MODEL_TYPE},
+    {LABEL_XML_WIDTH, vpXmlParserCamera::CODE_XML_WIDTH},
+    {LABEL_XML_HEIGHT, vpXmlParserCamera::CODE_XML_HEIGHT},
+    {LABEL_XML_SUBSAMPLING_WIDTH, vpXmlParserCamera::CODE_XML_SUBSAMPLING_WIDTH},
+    {LABEL_XML_SUBSAMPLING_HEIGHT, vpXmlParserCamera::CODE_XML_SUBSAMPLING_HEIGHT},
+    {LABEL_XML_FULL_WIDTH, vpXmlParserCamera::CODE_XML_FULL_WIDTH},
+    {LABEL_XML_FULL_HEIGHT, vpXmlParserCamera::CODE_XML_FULL_HEIGHT},
+    {LABEL_XML_U0, vpXmlParserCamera::CODE_XML_U0},
+    {LABEL_XML_V0, vpXmlParserCamera::CODE_XML_V0},
+    {LABEL_XML_PX, vpXmlParserCamera::CODE_XML_PX},
+    {LABEL_XML_PY, vpXmlParserCamera::CODE_XML_PY},
+    {LABEL_XML_KUD, vpXmlParserCamera::CODE_XML_KUD},
+    {LABEL_XML_KDU, vpXmlParserCamera::CODE_XML_KDU},
+    {LABEL_XML_ADDITIONAL_INFO, vpXmlParserCamera::CODE_XML_ADDITIONAL_INFO}};
+
+/*!
+  Open addressing hash table of the labels, so that a node name is usually
+  resolved with a single string comparison.
+*/
+class vpXmlCameraLabelTable
+{
+public:
+  vpXmlCameraLabelTable()
+  {
+    for (unsigned int i = 0; i < tableSize; i++) {
+      m_slots[i] = NULL;
+    }
+    for (unsigned int i = 0; i < sizeof(xmlCameraLabels) / sizeof(xmlCameraLabels[0]); i++) {
+      unsigned int h = hash(xmlCameraLabels[i].label);
+      while (m_slots[h] != NULL) {
+        h = (h + 1) % tableSize;
+      }
+      m_slots[h] = &xmlCameraLabels[i];
+    }
+  }
+
+  vpXmlParserCamera::vpXmlCodeType find(const char *str) const
+  {
+    for (unsigned int h = hash(str); m_slots[h] != NULL; h = (h + 1) % tableSize) {
+      if (!strcmp(str, m_slots[h]->label)) {
+        return m_slots[h]->code;
+      }
+    }
+    return vpXmlParserCamera::CODE_XML_OTHER;
+  }
+
+private:
+  // Must be larger than the number of labels
+  static const unsigned int tableSize = 64;
+
+  static unsigned int hash(const char *str)
+  {
+    unsigned int h = 2166136261u; // FNV-1a
+    for (; *str != '\0'; str++) {
+      h = (h ^ static_cast<unsigned char>(*str)) * 16777619u;
+    }
+    return h % tableSize;
+  }
+
+  const vpXmlCameraLabel *m_slots[tableSize];
+};
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
 /*!
   Default constructor
 */
@@ -123,6 +200,12 @@ vpXmlParserCamera &vpXmlParserCamera::operator=(const vpXmlParserCamera &twinPar
 
 /*!
   Parse an xml file to load camera parameters.
+
+  The file is read with a streaming parser: only one camera entry is
+  expanded in memory at a time. If a cache directory is set with
+  setCacheDirectory(), the parameters found for a given file content and
+  request are stored so that next calls skip XML parsing.
+
   \param cam : camera parameters to fill.
   \param filename : name of the xml file to parse
   \param cam_name : name of the camera : useful if the xml file has multiple
@@ -139,25 +222,72 @@ int vpXmlParserCamera::parse(vpCameraParameters &cam, const std::string &filenam
                              const vpCameraParameters::vpCameraParametersProjType &projModel,
                              const unsigned int im_width, const unsigned int im_height)
 {
-  xmlDocPtr doc;
-  xmlNodePtr node;
-
-  doc = xmlParseFile(filename.c_str());
-  if (doc == NULL) {
+  std::string content;
+  if (!readFile(filename, content)) {
     return SEQUENCE_ERROR;
   }
 
-  node = xmlDocGetRootElement(doc);
-  if (node == NULL) {
-    xmlFreeDoc(doc);
+  std::ostringstream key;
+  writeCacheValue(key, cam_name);
+  writeCacheValue(key, projModel);
+  writeCacheValue(key, im_width);
+  writeCacheValue(key, im_height);
+  const std::string cache_filename = getCacheFilename(content, key.str());
+
+  std::string data;
+  if (readCacheFile(cache_filename, data)) {
+    std::istringstream is(data);
+    std::string camera_name_tmp;
+    unsigned int size[6];
+    vpCameraParameters::vpCameraParametersProjType model;
+    double px, py, u0, v0, kud, kdu;
+    if (readCacheValue(is, camera_name_tmp) && readCacheValue(is, size) && readCacheValue(is, model) &&
+        readCacheValue(is, px) && readCacheValue(is, py) && readCacheValue(is, u0) && readCacheValue(is, v0) &&
+        readCacheValue(is, kud) && readCacheValue(is, kdu)) {
+      if (model == vpCameraParameters::perspectiveProjWithDistortion) {
+        camera.initPersProjWithDistortion(px, py, u0, v0, kud, kdu);
+      } else {
+        camera.initPersProjWithoutDistortion(px, py, u0, v0);
+      }
+      this->camera_name = camera_name_tmp;
+      this->image_width = size[0];
+      this->image_height = size[1];
+      this->subsampling_width = size[2];
+      this->subsampling_height = size[3];
+      this->full_width = size[4];
+      this->full_height = size[5];
+
+      cam = camera;
+      return SEQUENCE_OK;
+    }
+  }
+
+  xmlTextReaderPtr reader = xmlReaderForMemory(content.c_str(), static_cast<int>(content.size()), filename.c_str(),
+                                               NULL, 0);
+  if (reader == NULL) {
     return SEQUENCE_ERROR;
   }
 
-  int ret = this->read(doc, node, cam_name, projModel, im_width, im_height);
+  int ret = this->read(reader, cam_name, projModel, im_width, im_height);
 
   cam = camera;
 
-  xmlFreeDoc(doc);
+  xmlFreeTextReader(reader);
+
+  if (ret == SEQUENCE_OK && !cache_filename.empty()) {
+    std::ostringstream os;
+    unsigned int size[6] = {image_width, image_height, subsampling_width, subsampling_height, full_width, full_height};
+    writeCacheValue(os, camera_name);
+    writeCacheValue(os, size);
+    writeCacheValue(os, camera.get_projModel());
+    writeCacheValue(os, camera.get_px());
+    writeCacheValue(os, camera.get_py());
+    writeCacheValue(os, camera.get_u0());
+    writeCacheValue(os, camera.get_v0());
+    writeCacheValue(os, camera.get_kud());
+    writeCacheValue(os, camera.get_kdu());
+    writeCacheFile(cache_filename, os.str());
+  }
 
   return ret;
 }
@@ -295,8 +425,10 @@ int vpXmlParserCamera::save(const vpCameraParameters &cam, const std::string &fi
 /*!
   Read camera parameters from a XML file.
 
-  \param doc : XML file.
-  \param node : XML tree, pointing on a marker equipement.
+  The children of the root node are visited with a streaming reader, each
+  camera entry being expanded and released in turn.
+
+  \param reader : XML reader positioned before the root node.
   \param cam_name : name of the camera : useful if the xml file has multiple
   camera parameters. Set as "" if the camera name is not ambiguous.
   \param im_width : width of image  on which camera calibration was performed.
@@ -310,44 +442,55 @@ int vpXmlParserCamera::save(const vpCameraParameters &cam, const std::string &fi
 
   \return error code.
  */
-int vpXmlParserCamera::read(xmlDocPtr doc, xmlNodePtr node, const std::string &cam_name,
+int vpXmlParserCamera::read(xmlTextReaderPtr reader, const std::string &cam_name,
                             const vpCameraParameters::vpCameraParametersProjType &projModel,
                             const unsigned int im_width, const unsigned int im_height,
                             const unsigned int subsampl_width, const unsigned int subsampl_height)
 {
-  //    char * val_char;
   vpXmlCodeType prop;
 
   vpXmlCodeSequenceType back = SEQUENCE_OK;
   unsigned int nbCamera = 0;
+  bool root_found = false;
 
-  for (node = node->xmlChildrenNode; node != NULL; node = node->next) {
-    if (node->type != XML_ELEMENT_NODE)
+  int status = xmlTextReaderRead(reader);
+  while (status == 1) {
+    if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
+      status = xmlTextReaderRead(reader);
       continue;
-    if (SEQUENCE_OK != str2xmlcode((char *)(node->name), prop)) {
-      prop = CODE_XML_OTHER;
-      back = SEQUENCE_ERROR;
     }
-    /*
-    switch (prop)
-    {
-    case CODE_XML_CAMERA:
-      if (SEQUENCE_OK == this->read_camera (doc, node, camera_name, projModel,
-          image_width, image_height, subsampling_width, subsampling_height)){
-        nbCamera++;
+
+    int depth = xmlTextReaderDepth(reader);
+    if (depth == 0) {
+      root_found = true;
+      status = xmlTextReaderRead(reader);
+      continue;
+    }
+
+    if (depth == 1) {
+      if (SEQUENCE_OK != str2xmlcode((char *)xmlTextReaderConstName(reader), prop)) {
+        prop = CODE_XML_OTHER;
       }
-      break;
-    default:
-      back = SEQUENCE_ERROR;
-      break;
+
+      if (prop == CODE_XML_CAMERA) {
+        xmlNodePtr node = xmlTextReaderExpand(reader);
+        if (node == NULL) {
+          status = -1;
+          break;
+        }
+        if (SEQUENCE_OK == this->read_camera(xmlTextReaderCurrentDoc(reader), node, cam_name, projModel, im_width,
+                                             im_height, subsampl_width, subsampl_height))
+          nbCamera++;
+      } else
+        back = SEQUENCE_ERROR;
     }
-    */
-    if (prop == CODE_XML_CAMERA) {
-      if (SEQUENCE_OK ==
-          this->read_camera(doc, node, cam_name, projModel, im_width, im_height, subsampl_width, subsampl_height))
-        nbCamera++;
-    } else
-      back = SEQUENCE_ERROR;
+
+    // Skip the subtree of the element
+    status = xmlTextReaderNext(reader);
+  }
+
+  if (status != 0 || !root_found) {
+    return SEQUENCE_ERROR;
   }
 
   if (nbCamera == 0) {
@@ -1058,51 +1201,11 @@ int vpXmlParserCamera::write_camera(xmlNodePtr node_camera)
 
 vpXmlParserCamera::vpXmlCodeSequenceType vpXmlParserCamera::str2xmlcode(char *str, vpXmlCodeType &res)
 {
-  vpXmlCodeType val_int = CODE_XML_BAD;
-  vpXmlCodeSequenceType back = vpXmlParserCamera::SEQUENCE_OK;
-
-  // DEBUG_TRACE (9, "# Entree :str=%s.", str);
-
-  if (!strcmp(str, LABEL_XML_CAMERA)) {
-    val_int = CODE_XML_CAMERA;
-  } else if (!strcmp(str, LABEL_XML_CAMERA_NAME)) {
-    val_int = CODE_XML_CAMERA_NAME;
-  } else if (!strcmp(str, LABEL_XML_MODEL)) {
-    val_int = CODE_XML_MODEL;
-  } else if (!strcmp(str, LABEL_XML_MODEL_TYPE)) {
-    val_int = CODE_XML_MODEL_TYPE;
-  } else if (!strcmp(str, LABEL_XML_WIDTH)) {
-    val_int = CODE_XML_WIDTH;
-  } else if (!strcmp(str, LABEL_XML_HEIGHT)) {
-    val_int = CODE_XML_HEIGHT;
-  } else if (!strcmp(str, LABEL_XML_SUBSAMPLING_WIDTH)) {
-    val_int = CODE_XML_SUBSAMPLING_WIDTH;
-  } else if (!strcmp(str, LABEL_XML_SUBSAMPLING_HEIGHT)) {
-    val_int = CODE_XML_SUBSAMPLING_HEIGHT;
-  } else if (!strcmp(str, LABEL_XML_FULL_WIDTH)) {
-    val_int = CODE_XML_FULL_WIDTH;
-  } else if (!strcmp(str, LABEL_XML_FULL_HEIGHT)) {
-    val_int = CODE_XML_FULL_HEIGHT;
-  } else if (!strcmp(str, LABEL_XML_U0)) {
-    val_int = CODE_XML_U0;
-  } else if (!strcmp(str, LABEL_XML_V0)) {
-    val_int = CODE_XML_V0;
-  } else if (!strcmp(str, LABEL_XML_PX)) {
-    val_int = CODE_XML_PX;
-  } else if (!strcmp(str, LABEL_XML_PY)) {
-    val_int = CODE_XML_PY;
-  } else if (!strcmp(str, LABEL_XML_KUD)) {
-    val_int = CODE_XML_KUD;
-  } else if (!strcmp(str, LABEL_XML_KDU)) {
-    val_int = CODE_XML_KDU;
-  } else if (!strcmp(str, LABEL_XML_ADDITIONAL_INFO)) {
-    val_int = CODE_XML_ADDITIONAL_INFO;
-  } else {
-    val_int = CODE_XML_OTHER;
-  }
-  res = val_int;
+  static const vpXmlCameraLabelTable table;
 
-  return back;
+  res = table.find(str);
+
+  return vpXmlParserCamera::SEQUENCE_OK;
 }
 #elif !defined(VISP_BUILD_SHARED_LIBS)
 // Work arround to avoid warning: libvisp_core.a(vpXmlParserCamera.cpp.o) has
@@ -41,9 +41,143 @@
 // inet_ntop() not supported on win XP
 #ifdef VISP_HAVE_FUNC_INET_NTOP
 
+#include <errno.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+typedef int vpSocket;
+#else
+typedef SOCKET vpSocket;
+#endif
+
+// "VPF1", first word of every binary frame
+const unsigned int vp_frameMagic = 0x56504631;
+
+// Header preceding the payload of a binary frame. All the fields are sent in
+// network byte order.
+struct vpFrameHeader {
+  unsigned int magic;
+  unsigned int type;
+  unsigned int rows;
+  unsigned int cols;
+  unsigned int size;
+};
+
+int vp_poll(struct pollfd *fds, unsigned int nfds, int timeout)
+{
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  int value = poll(fds, (nfds_t)nfds, timeout);
+  while (value == -1 && errno == EINTR)
+    value = poll(fds, (nfds_t)nfds, timeout);
+  return value;
+#else
+  return WSAPoll(fds, (ULONG)nfds, timeout);
+#endif
+}
+
+/*
+  Send the header and the payload with a single scatter/gather call, looping
+  on partial writes. Return true when everything has been sent.
+*/
+bool vp_sendAll(vpSocket fd, const vpFrameHeader &header, const void *data, const unsigned int &size)
+{
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  struct iovec iov[2];
+  iov[0].iov_base = (void *)&header;
+  iov[0].iov_len = sizeof(header);
+  iov[1].iov_base = (void *)data;
+  iov[1].iov_len = size;
+
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = (size > 0) ? 2 : 1;
+
+  int flags = 0;
+#if defined(__linux__)
+  flags = MSG_NOSIGNAL; // Only for Linux
+#endif
+
+  size_t remaining = sizeof(header) + size;
+  while (remaining > 0) {
+    ssize_t numbytes = sendmsg(fd, &msg, flags);
+    if (numbytes == -1 && errno == EINTR)
+      continue;
+    if (numbytes <= 0)
+      return false;
+
+    remaining -= (size_t)numbytes;
+    while (numbytes > 0) {
+      if ((size_t)numbytes >= msg.msg_iov[0].iov_len) {
+        numbytes -= (ssize_t)msg.msg_iov[0].iov_len;
+        msg.msg_iov++;
+        msg.msg_iovlen--;
+      } else {
+        msg.msg_iov[0].iov_base = (char *)msg.msg_iov[0].iov_base + numbytes;
+        msg.msg_iov[0].iov_len -= (size_t)numbytes;
+        numbytes = 0;
+      }
+    }
+  }
+  return true;
+#else
+  WSABUF buffers[2];
+  buffers[0].buf = (char *)&header;
+  buffers[0].len = (ULONG)sizeof(header);
+  buffers[1].buf = (char *)data;
+  buffers[1].len = (ULONG)size;
+
+  // A blocking socket sends all the buffers before returning
+  DWORD numbytes = 0;
+  if (WSASend(fd, buffers, (size > 0) ? 2 : 1, &numbytes, 0, NULL, NULL) != 0)
+    return false;
+  return numbytes == sizeof(header) + size;
+#endif
+}
+
+/*
+  Receive exactly size bytes. Return false if the connection has been closed
+  or an error occured.
+*/
+bool vp_receiveAll(vpSocket fd, void *data, unsigned int size)
+{
+  char *ptr = (char *)data;
+  while (size > 0) {
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+    ssize_t numbytes = recv(fd, ptr, size, MSG_WAITALL);
+    if (numbytes == -1 && errno == EINTR)
+      continue;
+#else
+    int numbytes = recv(fd, ptr, (int)size, 0);
+#endif
+    if (numbytes <= 0)
+      return false;
+
+    ptr += numbytes;
+    size -= (unsigned int)numbytes;
+  }
+  return true;
+}
+
+void vp_closeSocket(vpSocket fd)
+{
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  shutdown(fd, SHUT_RDWR);
+  close(fd);
+#else
+  shutdown(fd, SD_BOTH);
+  closesocket(fd);
+#endif
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 vpNetwork::vpNetwork()
   : emitter(), receptor_list(), readFileDescriptor(), socketMax(0), request_list(), max_size_message(999999),
-    separator("[*@*]"), beginning("[*start*]"), end("[*end*]"), param_sep("[*|*]"), currentMessageReceived(), tv(),
+    separator("[*@*]"), beginning("[*start*]"), end("[*end*]"), param_sep("[*|*]"), currentMessageReceived(),
+    max_size_frame(64 * 1024 * 1024), frameDiscarded(), tv(),
     tv_sec(0), tv_usec(10), verboseMode(false)
 {
   tv.tv_sec = tv_sec;
@@ -695,6 +829,7 @@ int vpNetwork::_receiveRequestOnce()
 
         if (numbytes <= 0) {
           std::cout << "Disconnected : " << inet_ntoa(receptor_list[i].receptorAddress.sin_addr) << std::endl;
+          vp_closeSocket(receptor_list[i].socketFileDescriptorReceptor);
           receptor_list.erase(receptor_list.begin() + (int)i);
           delete[] buf;
           return numbytes;
@@ -775,6 +910,7 @@ int vpNetwork::_receiveRequestOnceFrom(const unsigned int &receptorEmitting)
       if (numbytes <= 0) {
         std::cout << "Disconnected : " << inet_ntoa(receptor_list[receptorEmitting].receptorAddress.sin_addr)
                   << std::endl;
+        vp_closeSocket(receptor_list[receptorEmitting].socketFileDescriptorReceptor);
         receptor_list.erase(receptor_list.begin() + (int)receptorEmitting);
         delete[] buf;
         return numbytes;
@@ -789,6 +925,573 @@ int vpNetwork::_receiveRequestOnceFrom(const unsigned int &receptorEmitting)
   return numbytes;
 }
 
+/*!
+  Send a binary frame containing an array of bytes to the first receptor in
+  the list. The header and the payload are sent with a single scatter/gather
+  call, without copying the payload.
+
+  \sa vpNetwork::sendFrameTo()
+  \sa vpNetwork::receiveFrame()
+
+  \param data : Pointer to the bytes to send.
+  \param size : Number of bytes to send.
+
+  \return The number of bytes that have been sent (header included), -1 if an
+  error occured.
+*/
+int vpNetwork::sendFrame(const void *data, const unsigned int &size) { return sendFrameTo(data, size, 0); }
+
+/*!
+  Send a binary frame containing an array of bytes to a specific receptor.
+
+  \sa vpNetwork::sendFrame()
+  \sa vpNetwork::receiveFrameFrom()
+
+  \param data : Pointer to the bytes to send.
+  \param size : Number of bytes to send.
+  \param dest : Index of the receptor receiving the frame.
+
+  \return The number of bytes that have been sent (header included), -1 if an
+  error occured.
+*/
+int vpNetwork::sendFrameTo(const void *data, const unsigned int &size, const unsigned int &dest)
+{
+  return _sendFrameTo(FRAME_RAW, 1, size, data, size, dest);
+}
+
+/*!
+  Send a grey level image as a binary frame to the first receptor in the
+  list. The pixels are sent directly from the image bitmap.
+
+  \sa vpNetwork::sendImageTo()
+  \sa vpNetwork::receiveImage()
+
+  \param I : Image to send.
+
+  \return The number of bytes that have been sent (header included), -1 if an
+  error occured.
+*/
+int vpNetwork::sendImage(const vpImage<unsigned char> &I) { return sendImageTo(I, 0); }
+
+/*!
+  Send a color image as a binary frame to the first receptor in the list.
+  The pixels are sent directly from the image bitmap.
+
+  \sa vpNetwork::sendImageTo()
+  \sa vpNetwork::receiveImage()
+
+  \param I : Image to send.
+
+  \return The number of bytes that have been sent (header included), -1 if an
+  error occured.
+*/
+int vpNetwork::sendImage(const vpImage<vpRGBa> &I) { return sendImageTo(I, 0); }
+
+/*!
+  Send a float image as a binary frame to the first receptor in the list.
+  The pixels are sent directly from the image bitmap.
+
+  \sa vpNetwork::sendImageTo()
+  \sa vpNetwork::receiveImage()
+
+  \param I : Image to send.
+
+  \return The number of bytes that have been sent (header included), -1 if an
+  error occured.
+*/
+int vpNetwork::sendImage(const vpImage<float> &I) { return sendImageTo(I, 0); }
+
+/*!
+  Send a grey level image as a binary frame to a specific receptor.
+
+  \sa vpNetwork::sendImage()
+  \sa vpNetwork::receiveImageFrom()
+
+  \param I : Image to send.
+  \param dest : Index of the receptor receiving the image.
+
+  \return The number of bytes that have been sent (header included), -1 if an
+  error occured.
+*/
+int vpNetwork::sendImageTo(const vpImage<unsigned char> &I, const unsigned int &dest)
+{
+  return _sendFrameTo(FRAME_IMAGE_UCHAR, I.getHeight(), I.getWidth(), I.bitmap,
+                      (unsigned int)(I.getSize() * sizeof(unsigned char)), dest);
+}
+
+/*!
+  Send a color image as a binary frame to a specific receptor.
+
+  \sa vpNetwork::sendImage()
+  \sa vpNetwork::receiveImageFrom()
+
+  \param I : Image to send.
+  \param dest : Index of the receptor receiving the image.
+
+  \return The number of bytes that have been sent (header included), -1 if an
+  error occured.
+*/
+int vpNetwork::sendImageTo(const vpImage<vpRGBa> &I, const unsigned int &dest)
+{
+  return _sendFrameTo(FRAME_IMAGE_RGBA, I.getHeight(), I.getWidth(), I.bitmap,
+                      (unsigned int)(I.getSize() * sizeof(vpRGBa)), dest);
+}
+
+/*!
+  Send a float image as a binary frame to a specific receptor.
+
+  \sa vpNetwork::sendImage()
+  \sa vpNetwork::receiveImageFrom()
+
+  \param I : Image to send.
+  \param dest : Index of the receptor receiving the image.
+
+  \return The number of bytes that have been sent (header included), -1 if an
+  error occured.
+*/
+int vpNetwork::sendImageTo(const vpImage<float> &I, const unsigned int &dest)
+{
+  return _sendFrameTo(FRAME_IMAGE_FLOAT, I.getHeight(), I.getWidth(), I.bitmap,
+                      (unsigned int)(I.getSize() * sizeof(float)), dest);
+}
+
+/*!
+  Send a matrix as a binary frame to the first receptor in the list. The
+  coefficients are sent directly from the matrix data.
+
+  \sa vpNetwork::sendMatrixTo()
+  \sa vpNetwork::receiveMatrix()
+
+  \param M : Matrix to send.
+
+  \return The number of bytes that have been sent (header included), -1 if an
+  error occured.
+*/
+int vpNetwork::sendMatrix(const vpMatrix &M) { return sendMatrixTo(M, 0); }
+
+/*!
+  Send a matrix as a binary frame to a specific receptor.
+
+  \sa vpNetwork::sendMatrix()
+  \sa vpNetwork::receiveMatrixFrom()
+
+  \param M : Matrix to send.
+  \param dest : Index of the receptor receiving the matrix.
+
+  \return The number of bytes that have been sent (header included), -1 if an
+  error occured.
+*/
+int vpNetwork::sendMatrixTo(const vpMatrix &M, const unsigned int &dest)
+{
+  return _sendFrameTo(FRAME_MATRIX, M.getRows(), M.getCols(), M.data, (unsigned int)(M.size() * sizeof(double)),
+                      dest);
+}
+
+/*!
+  Receive a binary frame containing an array of bytes from the first
+  receptor having sent something. The vector is only reallocated when it is
+  too small.
+
+  \sa vpNetwork::receiveFrameFrom()
+  \sa vpNetwork::sendFrame()
+
+  \param data : Received bytes.
+
+  \return The number of bytes received (header included), 0 if nothing has
+  been received before the timeout, -1 if an error occured or if the frame
+  doesn't contain an array of bytes.
+*/
+int vpNetwork::receiveFrame(std::vector<unsigned char> &data)
+{
+  unsigned int receptorReady, type, rows, cols, size;
+  int value = _receiveFrameHeaderFrom(-1, receptorReady, type, rows, cols, size);
+  if (value <= 0)
+    return value;
+
+  if (type != FRAME_RAW) {
+    _discardFramePayloadFrom(receptorReady, size);
+    return -1;
+  }
+
+  data.resize(size);
+  if (_receiveFramePayloadFrom(receptorReady, size > 0 ? &data[0] : NULL, size) < 0)
+    return -1;
+
+  return value + (int)size;
+}
+
+/*!
+  Receive a binary frame containing an array of bytes from a specific
+  receptor.
+
+  \sa vpNetwork::receiveFrame()
+  \sa vpNetwork::sendFrameTo()
+
+  \param data : Received bytes.
+  \param receptorEmitting : Index of the receptor emitting the frame.
+
+  \return The number of bytes received (header included), 0 if nothing has
+  been received before the timeout, -1 if an error occured or if the frame
+  doesn't contain an array of bytes.
+*/
+int vpNetwork::receiveFrameFrom(std::vector<unsigned char> &data, const unsigned int &receptorEmitting)
+{
+  unsigned int receptorReady, type, rows, cols, size;
+  int value = _receiveFrameHeaderFrom((int)receptorEmitting, receptorReady, type, rows, cols, size);
+  if (value <= 0)
+    return value;
+
+  if (type != FRAME_RAW) {
+    _discardFramePayloadFrom(receptorReady, size);
+    return -1;
+  }
+
+  data.resize(size);
+  if (_receiveFramePayloadFrom(receptorReady, size > 0 ? &data[0] : NULL, size) < 0)
+    return -1;
+
+  return value + (int)size;
+}
+
+/*!
+  Receive an image frame of the given type.
+
+  \return The number of bytes received, 0 on timeout, -1 if an error occured.
+*/
+template <class Type>
+int vpNetwork::_receiveImageFrom(vpImage<Type> &I, const unsigned int &type, const int &receptorEmitting)
+{
+  unsigned int receptorReady, frameType, rows, cols, size;
+  int value = _receiveFrameHeaderFrom(receptorEmitting, receptorReady, frameType, rows, cols, size);
+  if (value <= 0)
+    return value;
+
+  if (frameType != type || (size_t)rows * cols * sizeof(Type) != size) {
+    _discardFramePayloadFrom(receptorReady, size);
+    return -1;
+  }
+
+  I.resize(rows, cols);
+  if (_receiveFramePayloadFrom(receptorReady, I.bitmap, size) < 0)
+    return -1;
+
+  return value + (int)size;
+}
+
+/*!
+  Receive a grey level image from the first receptor having sent something.
+  The image is resized to the received dimensions, and the pixels are
+  received directly in its bitmap.
+
+  \sa vpNetwork::receiveImageFrom()
+  \sa vpNetwork::sendImage()
+
+  \param I : Received image.
+
+  \return The number of bytes received (header included), 0 if nothing has
+  been received before the timeout, -1 if an error occured or if the frame
+  doesn't contain a grey level image.
+*/
+int vpNetwork::receiveImage(vpImage<unsigned char> &I) { return _receiveImageFrom(I, FRAME_IMAGE_UCHAR, -1); }
+
+/*!
+  Receive a color image from the first receptor having sent something.
+
+  \sa vpNetwork::receiveImageFrom()
+  \sa vpNetwork::sendImage()
+
+  \param I : Received image.
+
+  \return The number of bytes received (header included), 0 if nothing has
+  been received before the timeout, -1 if an error occured or if the frame
+  doesn't contain a color image.
+*/
+int vpNetwork::receiveImage(vpImage<vpRGBa> &I) { return _receiveImageFrom(I, FRAME_IMAGE_RGBA, -1); }
+
+/*!
+  Receive a float image from the first receptor having sent something.
+
+  \sa vpNetwork::receiveImageFrom()
+  \sa vpNetwork::sendImage()
+
+  \param I : Received image.
+
+  \return The number of bytes received (header included), 0 if nothing has
+  been received before the timeout, -1 if an error occured or if the frame
+  doesn't contain a float image.
+*/
+int vpNetwork::receiveImage(vpImage<float> &I) { return _receiveImageFrom(I, FRAME_IMAGE_FLOAT, -1); }
+
+/*!
+  Receive a grey level image from a specific receptor. The image is resized
+  to the received dimensions, and the pixels are received directly in its
+  bitmap.
+
+  \sa vpNetwork::receiveImage()
+  \sa vpNetwork::sendImageTo()
+
+  \param I : Received image.
+  \param receptorEmitting : Index of the receptor emitting the image.
+
+  \return The number of bytes received (header included), 0 if nothing has
+  been received before the timeout, -1 if an error occured or if the frame
+  doesn't contain a grey level image.
+*/
+int vpNetwork::receiveImageFrom(vpImage<unsigned char> &I, const unsigned int &receptorEmitting)
+{
+  return _receiveImageFrom(I, FRAME_IMAGE_UCHAR, (int)receptorEmitting);
+}
+
+/*!
+  Receive a color image from a specific receptor.
+
+  \sa vpNetwork::receiveImage()
+  \sa vpNetwork::sendImageTo()
+
+  \param I : Received image.
+  \param receptorEmitting : Index of the receptor emitting the image.
+
+  \return The number of bytes received (header included), 0 if nothing has
+  been received before the timeout, -1 if an error occured or if the frame
+  doesn't contain a color image.
+*/
+int vpNetwork::receiveImageFrom(vpImage<vpRGBa> &I, const unsigned int &receptorEmitting)
+{
+  return _receiveImageFrom(I, FRAME_IMAGE_RGBA, (int)receptorEmitting);
+}
+
+/*!
+  Receive a float image from a specific receptor.
+
+  \sa vpNetwork::receiveImage()
+  \sa vpNetwork::sendImageTo()
+
+  \param I : Received image.
+  \param receptorEmitting : Index of the receptor emitting the image.
+
+  \return The number of bytes received (header included), 0 if nothing has
+  been received before the timeout, -1 if an error occured or if the frame
+  doesn't contain a float image.
+*/
+int vpNetwork::receiveImageFrom(vpImage<float> &I, const unsigned int &receptorEmitting)
+{
+  return _receiveImageFrom(I, FRAME_IMAGE_FLOAT, (int)receptorEmitting);
+}
+
+/*!
+  Receive a matrix from the first receptor having sent something. The matrix
+  is resized to the received dimensions, and the coefficients are received
+  directly in its data.
+
+  \sa vpNetwork::receiveMatrixFrom()
+  \sa vpNetwork::sendMatrix()
+
+  \param M : Received matrix.
+
+  \return The number of bytes received (header included), 0 if nothing has
+  been received before the timeout, -1 if an error occured or if the frame
+  doesn't contain a matrix.
+*/
+int vpNetwork::receiveMatrix(vpMatrix &M)
+{
+  unsigned int receptorReady, type, rows, cols, size;
+  int value = _receiveFrameHeaderFrom(-1, receptorReady, type, rows, cols, size);
+  if (value <= 0)
+    return value;
+
+  if (type != FRAME_MATRIX || (size_t)rows * cols * sizeof(double) != size) {
+    _discardFramePayloadFrom(receptorReady, size);
+    return -1;
+  }
+
+  M.resize(rows, cols, false, false);
+  if (_receiveFramePayloadFrom(receptorReady, M.data, size) < 0)
+    return -1;
+
+  return value + (int)size;
+}
+
+/*!
+  Receive a matrix from a specific receptor.
+
+  \sa vpNetwork::receiveMatrix()
+  \sa vpNetwork::sendMatrixTo()
+
+  \param M : Received matrix.
+  \param receptorEmitting : Index of the receptor emitting the matrix.
+
+  \return The number of bytes received (header included), 0 if nothing has
+  been received before the timeout, -1 if an error occured or if the frame
+  doesn't contain a matrix.
+*/
+int vpNetwork::receiveMatrixFrom(vpMatrix &M, const unsigned int &receptorEmitting)
+{
+  unsigned int receptorReady, type, rows, cols, size;
+  int value = _receiveFrameHeaderFrom((int)receptorEmitting, receptorReady, type, rows, cols, size);
+  if (value <= 0)
+    return value;
+
+  if (type != FRAME_MATRIX || (size_t)rows * cols * sizeof(double) != size) {
+    _discardFramePayloadFrom(receptorReady, size);
+    return -1;
+  }
+
+  M.resize(rows, cols, false, false);
+  if (_receiveFramePayloadFrom(receptorReady, M.data, size) < 0)
+    return -1;
+
+  return value + (int)size;
+}
+
+/*!
+  Wait until a receptor has something to read, using the timeout set with
+  setTimeoutSec() and setTimeoutUSec().
+
+  \param receptorEmitting : Index of the receptor to wait for, or -1 to wait
+  for any receptor.
+  \param receptorReady : Index of the first receptor having something to
+  read.
+
+  \return -1 if an error occured, 0 on timeout, a positive value otherwise.
+*/
+int vpNetwork::_waitForReceptor(const int &receptorEmitting, unsigned int &receptorReady)
+{
+  unsigned int first = (receptorEmitting < 0) ? 0 : (unsigned int)receptorEmitting;
+  unsigned int last = (receptorEmitting < 0) ? (unsigned int)receptor_list.size() : first + 1;
+
+  std::vector<struct pollfd> fds(last - first);
+  for (unsigned int i = first; i < last; i++) {
+    fds[i - first].fd = receptor_list[i].socketFileDescriptorReceptor;
+    fds[i - first].events = POLLIN;
+    fds[i - first].revents = 0;
+  }
+
+  // Round up so that a small non null timeout doesn't become a busy loop
+  int timeout = (int)(tv_sec * 1000 + (tv_usec + 999) / 1000);
+  int value = vp_poll(&fds[0], (unsigned int)fds.size(), timeout);
+  if (value == -1) {
+    if (verboseMode)
+      vpERROR_TRACE("Poll error");
+    return -1;
+  }
+
+  for (unsigned int i = 0; i < fds.size() && value > 0; i++) {
+    if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+      receptorReady = first + i;
+      return value;
+    }
+  }
+
+  return 0;
+}
+
+/*!
+  Send a frame header followed by its payload to a receptor.
+
+  \return The number of bytes that have been sent, -1 if an error occured.
+*/
+int vpNetwork::_sendFrameTo(const unsigned int &type, const unsigned int &rows, const unsigned int &cols,
+                            const void *data, const unsigned int &size, const unsigned int &dest)
+{
+  if (dest >= receptor_list.size()) {
+    if (verboseMode)
+      vpTRACE("Cannot send frame! Bad Index");
+    return -1;
+  }
+
+  vpFrameHeader header;
+  header.magic = htonl(vp_frameMagic);
+  header.type = htonl(type);
+  header.rows = htonl(rows);
+  header.cols = htonl(cols);
+  header.size = htonl(size);
+
+  if (!vp_sendAll(receptor_list[dest].socketFileDescriptorReceptor, header, data, size)) {
+    if (verboseMode)
+      vpERROR_TRACE("Cannot send frame");
+    return -1;
+  }
+
+  return (int)(sizeof(header) + size);
+}
+
+/*!
+  Wait for a frame and receive its header. A receptor sending a corrupted
+  header is disconnected, since the stream can't be resynchronized.
+
+  \return The number of bytes of the header, 0 on timeout, -1 if an error
+  occured.
+*/
+int vpNetwork::_receiveFrameHeaderFrom(const int &receptorEmitting, unsigned int &receptorReady, unsigned int &type,
+                                       unsigned int &rows, unsigned int &cols, unsigned int &size)
+{
+  if (receptor_list.size() == 0 || receptorEmitting >= (int)receptor_list.size()) {
+    if (verboseMode)
+      vpTRACE("No receptor at the specified index");
+    return -1;
+  }
+
+  int value = _waitForReceptor(receptorEmitting, receptorReady);
+  if (value <= 0)
+    return value;
+
+  vpFrameHeader header;
+  if (!vp_receiveAll(receptor_list[receptorReady].socketFileDescriptorReceptor, &header, sizeof(header))) {
+    std::cout << "Disconnected : " << inet_ntoa(receptor_list[receptorReady].receptorAddress.sin_addr) << std::endl;
+    vp_closeSocket(receptor_list[receptorReady].socketFileDescriptorReceptor);
+    receptor_list.erase(receptor_list.begin() + (int)receptorReady);
+    return -1;
+  }
+
+  type = ntohl(header.type);
+  rows = ntohl(header.rows);
+  cols = ntohl(header.cols);
+  size = ntohl(header.size);
+
+  if (ntohl(header.magic) != vp_frameMagic || size > max_size_frame) {
+    if (verboseMode)
+      vpTRACE("Incorrect frame");
+    vp_closeSocket(receptor_list[receptorReady].socketFileDescriptorReceptor);
+    receptor_list.erase(receptor_list.begin() + (int)receptorReady);
+    return -1;
+  }
+
+  return (int)sizeof(header);
+}
+
+/*!
+  Receive the payload of a frame whose header has just been received.
+
+  \return The number of bytes received, -1 if an error occured.
+*/
+int vpNetwork::_receiveFramePayloadFrom(const unsigned int &receptorEmitting, void *data, const unsigned int &size)
+{
+  if (!vp_receiveAll(receptor_list[receptorEmitting].socketFileDescriptorReceptor, data, size)) {
+    std::cout << "Disconnected : " << inet_ntoa(receptor_list[receptorEmitting].receptorAddress.sin_addr)
+              << std::endl;
+    vp_closeSocket(receptor_list[receptorEmitting].socketFileDescriptorReceptor);
+    receptor_list.erase(receptor_list.begin() + (int)receptorEmitting);
+    return -1;
+  }
+
+  return (int)size;
+}
+
+/*!
+  Skip the payload of a frame that doesn't match the expected type, to keep
+  the stream synchronized.
+
+  \return The number of bytes skipped, -1 if an error occured.
+*/
+int vpNetwork::_discardFramePayloadFrom(const unsigned int &receptorEmitting, const unsigned int &size)
+{
+  if (verboseMode)
+    vpTRACE("Unexpected frame type");
+
+  frameDiscarded.resize(size);
+  return _receiveFramePayloadFrom(receptorEmitting, size > 0 ? &frameDiscarded[0] : NULL, size);
+}
+
 #elif !defined(VISP_BUILD_SHARED_LIBS)
 // Work arround to avoid warning: libvisp_core.a(vpNetwork.cpp.o) has no symbols
 void dummy_vpNetwork(){};
@@ -41,6 +41,8 @@
 // inet_ntop() not supported on win XP
 #ifdef VISP_HAVE_FUNC_INET_NTOP
 
+#include <errno.h>
+
 #if defined(__APPLE__) && defined(__MACH__) // Apple OSX and iOS (Darwin)
 #include <TargetConditionals.h>             // To detect OSX or IOS using TARGET_OS_IPHONE or TARGET_OS_IOS macro
 #endif
@@ -237,28 +239,7 @@ bool vpServer::checkForConnections()
     return false;
   } else {
     if (FD_ISSET((unsigned int)emitter.socketFileDescriptorEmitter, &readFileDescriptor)) {
-      vpNetwork::vpReceptor client;
-      client.receptorAddressSize = sizeof(client.receptorAddress);
-#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-      client.socketFileDescriptorReceptor = accept(
-          emitter.socketFileDescriptorEmitter, (struct sockaddr *)&client.receptorAddress, &client.receptorAddressSize);
-#else // Win32
-      client.socketFileDescriptorReceptor =
-          accept((unsigned int)emitter.socketFileDescriptorEmitter, (struct sockaddr *)&client.receptorAddress,
-                 &client.receptorAddressSize);
-#endif
-
-#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-      if ((client.socketFileDescriptorReceptor) == -1)
-#else
-      if ((client.socketFileDescriptorReceptor) == INVALID_SOCKET)
-#endif
-        vpERROR_TRACE("vpServer::run(), accept()");
-
-      client.receptorIP = inet_ntoa(client.receptorAddress.sin_addr);
-      printf("New client connected : %s\n", inet_ntoa(client.receptorAddress.sin_addr));
-      receptor_list.push_back(client);
-
+      _acceptClient();
       return true;
     } else {
       for (unsigned int i = 0; i < receptor_list.size(); i++) {
@@ -283,6 +264,130 @@ bool vpServer::checkForConnections()
   return false;
 }
 
+/*!
+  Wait for the activity of the server and its clients with a single poll()
+  call, using the timeout set with setTimeoutSec() and setTimeoutUSec().
+  Contrary to checkForConnections(), all the events are handled at once: a
+  new client is accepted, the disconnected clients are removed, and the
+  indexes of the clients having something to read are returned. Unlike
+  select(), the number of clients isn't limited by FD_SETSIZE.
+
+  \param clients : Indexes of the clients having data to be received, valid
+  after the disconnected clients have been removed.
+
+  \return The number of clients having data to be received, or -1 if an
+  error occured or if the server can't be started.
+*/
+int vpServer::checkForEvents(std::vector<unsigned int> &clients)
+{
+  clients.clear();
+
+  if (!started)
+    if (!start()) {
+      return -1;
+    }
+
+  std::vector<struct pollfd> fds(receptor_list.size() + 1);
+  fds[0].fd = emitter.socketFileDescriptorEmitter;
+  fds[0].events = POLLIN;
+  fds[0].revents = 0;
+  for (unsigned int i = 0; i < receptor_list.size(); i++) {
+    fds[i + 1].fd = receptor_list[i].socketFileDescriptorReceptor;
+    fds[i + 1].events = POLLIN;
+    fds[i + 1].revents = 0;
+  }
+
+  int timeout = (int)(tv_sec * 1000 + (tv_usec + 999) / 1000);
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  int value = poll(&fds[0], (nfds_t)fds.size(), timeout);
+  if (value == -1 && errno == EINTR)
+    return 0;
+#else
+  int value = WSAPoll(&fds[0], (ULONG)fds.size(), timeout);
+#endif
+  if (value == -1) {
+    if (verboseMode)
+      vpERROR_TRACE("Poll error");
+    return -1;
+  } else if (value == 0) {
+    return 0;
+  }
+
+  // Remove the disconnected clients, from the last one so that the indexes
+  // of the remaining ones stay valid while iterating
+  std::vector<bool> readable(receptor_list.size(), false);
+  for (unsigned int i = (unsigned int)receptor_list.size(); i > 0; i--) {
+    short revents = fds[i].revents;
+    if (!(revents & (POLLIN | POLLHUP | POLLERR)))
+      continue;
+
+    char deco;
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+    ssize_t numbytes = recv(receptor_list[i - 1].socketFileDescriptorReceptor, &deco, 1, MSG_PEEK);
+#else // Win32
+    int numbytes = recv((unsigned int)receptor_list[i - 1].socketFileDescriptorReceptor, &deco, 1, MSG_PEEK);
+#endif
+    if (numbytes <= 0) {
+      std::cout << "Disconnected : " << inet_ntoa(receptor_list[i - 1].receptorAddress.sin_addr) << std::endl;
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+      close(receptor_list[i - 1].socketFileDescriptorReceptor);
+#else // Win32
+      closesocket((unsigned)receptor_list[i - 1].socketFileDescriptorReceptor);
+#endif
+      receptor_list.erase(receptor_list.begin() + (int)(i - 1));
+      readable.erase(readable.begin() + (int)(i - 1));
+    } else {
+      readable[i - 1] = true;
+    }
+  }
+
+  for (unsigned int i = 0; i < readable.size(); i++) {
+    if (readable[i])
+      clients.push_back(i);
+  }
+
+  // New clients are appended, so the indexes computed above stay valid
+  if (fds[0].revents & POLLIN)
+    _acceptClient();
+
+  return (int)clients.size();
+}
+
+/*!
+  Accept a client waiting for a connection and add it to the receptor list.
+
+  \return True if a client has been accepted, false otherwise.
+*/
+bool vpServer::_acceptClient()
+{
+  vpNetwork::vpReceptor client;
+  client.receptorAddressSize = sizeof(client.receptorAddress);
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  client.socketFileDescriptorReceptor = accept(
+      emitter.socketFileDescriptorEmitter, (struct sockaddr *)&client.receptorAddress, &client.receptorAddressSize);
+#else // Win32
+  client.socketFileDescriptorReceptor =
+      accept((unsigned int)emitter.socketFileDescriptorEmitter, (struct sockaddr *)&client.receptorAddress,
+             &client.receptorAddressSize);
+#endif
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  if ((client.socketFileDescriptorReceptor) == -1)
+#else
+  if ((client.socketFileDescriptorReceptor) == INVALID_SOCKET)
+#endif
+  {
+    vpERROR_TRACE("vpServer::run(), accept()");
+    return false;
+  }
+
+  client.receptorIP = inet_ntoa(client.receptorAddress.sin_addr);
+  printf("New client connected : %s\n", inet_ntoa(client.receptorAddress.sin_addr));
+  receptor_list.push_back(client);
+
+  return true;
+}
+
 /*!
   Print the connected clients.
 */
@@ -0,0 +1,646 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Shared memory ring of images and point clouds between processes.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpSharedMemoryRing.cpp
+  \brief Shared memory ring of images and point clouds between processes.
+*/
+
+#include <visp3/core/vpSharedMemoryRing.h>
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+#include <visp3/core/vpException.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+const char vp_ringMagic[8] = {'V', 'I', 'S', 'P', 'S', 'H', 'M', '1'};
+const unsigned int vp_ringVersion = 1;
+
+enum vpSlotState { SLOT_EMPTY = 0, SLOT_WRITING, SLOT_READY };
+
+// Layout of the shared memory: the header, followed by the slot descriptors,
+// followed by the page aligned slot data. The fields modified after the
+// creation are only accessed with atomic operations.
+struct vpRingHeader {
+  char magic[8];
+  unsigned int version;
+  unsigned int nbSlots;
+  unsigned long long slotSize;
+  unsigned long long dataOffset;
+  unsigned long long published; // Sequence of the last published frame, 0 if none
+  int futex;                    // Incremented at each publication
+  int reserved;
+};
+
+struct vpRingSlot {
+  unsigned long long sequence;
+  int state;
+  int readers; // Number of consumers having acquired the slot
+  unsigned int type;
+  unsigned int width;
+  unsigned int height;
+  unsigned int reserved;
+  unsigned long long size;
+  double timestamp;
+};
+
+template <class T> inline T vp_load(const T *ptr) { return __atomic_load_n(ptr, __ATOMIC_SEQ_CST); }
+template <class T> inline void vp_store(T *ptr, const T value) { __atomic_store_n(ptr, value, __ATOMIC_SEQ_CST); }
+
+inline size_t vp_roundUp(const size_t value, const size_t alignment)
+{
+  return ((value + alignment - 1) / alignment) * alignment;
+}
+
+inline vpRingHeader *vp_header(unsigned char *data) { return reinterpret_cast<vpRingHeader *>(data); }
+
+inline vpRingSlot *vp_slots(unsigned char *data)
+{
+  return reinterpret_cast<vpRingSlot *>(data + vp_roundUp(sizeof(vpRingHeader), 64));
+}
+
+void vp_futexWake(int *futex)
+{
+#if defined(__linux__)
+  syscall(SYS_futex, futex, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#else
+  (void)futex;
+#endif
+}
+
+// Sleep until the futex value differs from expected, or the timeout expires.
+void vp_futexWait(int *futex, const int expected, const double timeout_ms)
+{
+#if defined(__linux__)
+  struct timespec ts;
+  ts.tv_sec = (time_t)(timeout_ms / 1000.);
+  ts.tv_nsec = (long)((timeout_ms - ts.tv_sec * 1000.) * 1e6);
+  syscall(SYS_futex, futex, FUTEX_WAIT, expected, timeout_ms < 0 ? NULL : &ts, NULL, 0);
+#else
+  (void)futex;
+  (void)expected;
+  vpTime::sleepMs(timeout_ms < 0 || timeout_ms > 1. ? 1. : timeout_ms);
+#endif
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor. The ring has to be created with create() or opened
+  with open().
+*/
+vpSharedMemoryRing::vpSharedMemoryRing()
+  : m_name(), m_data(NULL), m_size(0), m_isProducer(false), m_acquiredSlot(-1), m_writtenSlot(-1),
+    m_droppedFrames(0)
+{
+}
+
+/*!
+  Destructor that calls close().
+*/
+vpSharedMemoryRing::~vpSharedMemoryRing() { close(); }
+
+/*!
+  Create a ring as producer. A previous shared memory object with the same
+  name is replaced.
+
+  \param name : Name of the shared memory object, starting with a slash,
+  for instance "/camera".
+  \param nb_slots : Number of slots of the ring. It should be greater than
+  the number of consumers.
+  \param slot_size : Maximum size in bytes of a frame.
+
+  \exception vpException::badValue : If a parameter is null.
+  \exception vpException::ioError : If the shared memory object can't be
+  created or mapped.
+*/
+void vpSharedMemoryRing::create(const std::string &name, const unsigned int nb_slots, const size_t slot_size)
+{
+  close();
+
+  if (nb_slots == 0 || slot_size == 0) {
+    throw(vpException(vpException::badValue, "Cannot create a shared memory ring with %u slots of %lu bytes",
+                      nb_slots, (unsigned long)slot_size));
+  }
+
+  size_t padded_slot_size = vp_roundUp(slot_size, 64);
+  size_t data_offset =
+      vp_roundUp(vp_roundUp(sizeof(vpRingHeader), 64) + nb_slots * sizeof(vpRingSlot), (size_t)sysconf(_SC_PAGESIZE));
+  size_t size = data_offset + nb_slots * padded_slot_size;
+
+  shm_unlink(name.c_str());
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+  if (fd == -1) {
+    throw(vpException(vpException::ioError, "Cannot create shared memory \"%s\": %s", name.c_str(), strerror(errno)));
+  }
+
+  if (ftruncate(fd, (off_t)size) != 0) {
+    ::close(fd);
+    shm_unlink(name.c_str());
+    throw(vpException(vpException::ioError, "Cannot allocate %lu bytes of shared memory \"%s\"", (unsigned long)size,
+                      name.c_str()));
+  }
+
+  void *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    throw(vpException(vpException::ioError, "Cannot map shared memory \"%s\"", name.c_str()));
+  }
+
+  m_name = name;
+  m_data = static_cast<unsigned char *>(data);
+  m_size = size;
+  m_isProducer = true;
+  m_writtenSlot = -1;
+  m_droppedFrames = 0;
+
+  // The memory is zero filled by ftruncate(): all the slots are empty
+  vpRingHeader *header = vp_header(m_data);
+  header->version = vp_ringVersion;
+  header->nbSlots = nb_slots;
+  header->slotSize = padded_slot_size;
+  header->dataOffset = data_offset;
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  memcpy(header->magic, vp_ringMagic, sizeof(vp_ringMagic));
+}
+
+/*!
+  Open as consumer a ring created by a producer with create().
+
+  \param name : Name of the shared memory object.
+
+  \exception vpException::ioError : If the shared memory object doesn't
+  exist or isn't a ring.
+*/
+void vpSharedMemoryRing::open(const std::string &name)
+{
+  close();
+
+  int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd == -1) {
+    throw(vpException(vpException::ioError, "Cannot open shared memory \"%s\": %s", name.c_str(), strerror(errno)));
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(vpRingHeader)) {
+    ::close(fd);
+    throw(vpException(vpException::ioError, "Shared memory \"%s\" is not a ring", name.c_str()));
+  }
+
+  size_t size = (size_t)st.st_size;
+  void *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    throw(vpException(vpException::ioError, "Cannot map shared memory \"%s\"", name.c_str()));
+  }
+
+  const vpRingHeader *header = vp_header(static_cast<unsigned char *>(data));
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (memcmp(header->magic, vp_ringMagic, sizeof(vp_ringMagic)) != 0 || header->version != vp_ringVersion ||
+      header->dataOffset + (unsigned long long)header->nbSlots * header->slotSize > size) {
+    munmap(data, size);
+    throw(vpException(vpException::ioError, "Shared memory \"%s\" is not a valid ring", name.c_str()));
+  }
+
+  m_name = name;
+  m_data = static_cast<unsigned char *>(data);
+  m_size = size;
+  m_isProducer = false;
+}
+
+/*!
+  Release the acquired slot and unmap the ring. The producer also removes
+  the shared memory object name; the consumers that are still attached keep
+  a valid mapping until they close it.
+*/
+void vpSharedMemoryRing::close()
+{
+  if (m_data == NULL)
+    return;
+
+  release();
+  munmap(m_data, m_size);
+  if (m_isProducer)
+    shm_unlink(m_name.c_str());
+
+  m_data = NULL;
+  m_size = 0;
+  m_isProducer = false;
+  m_writtenSlot = -1;
+}
+
+/*!
+  Return the number of slots of the ring.
+*/
+unsigned int vpSharedMemoryRing::getNbSlots() const { return m_data == NULL ? 0 : vp_header(m_data)->nbSlots; }
+
+/*!
+  Return the sequence number of the last published frame, or 0 if no frame
+  has been published yet. Sequence numbers start at 1.
+*/
+unsigned long long vpSharedMemoryRing::getSequence() const
+{
+  return m_data == NULL ? 0 : vp_load(&vp_header(m_data)->published);
+}
+
+/*!
+  Return the size in bytes of a slot, that is the maximum size of a frame.
+*/
+size_t vpSharedMemoryRing::getSlotSize() const
+{
+  return m_data == NULL ? 0 : (size_t)vp_header(m_data)->slotSize;
+}
+
+/*!
+  Release the slot acquired with acquire(). The view returned by acquire()
+  must not be used anymore.
+*/
+void vpSharedMemoryRing::release()
+{
+  if (m_acquiredSlot < 0)
+    return;
+
+  __atomic_sub_fetch(&vp_slots(m_data)[m_acquiredSlot].readers, 1, __ATOMIC_SEQ_CST);
+  m_acquiredSlot = -1;
+}
+
+/*!
+  Wait until a frame more recent than a given sequence number is published.
+
+  \param sequence : Sequence number of the last frame known by the caller,
+  0 to wait for the first frame.
+  \param timeout_ms : Maximum waiting time in ms, or a negative value to
+  wait forever.
+
+  \return true if a more recent frame is available, false on timeout.
+*/
+bool vpSharedMemoryRing::wait(const unsigned long long sequence, const int timeout_ms)
+{
+  if (m_data == NULL) {
+    throw(vpException(vpException::notInitialized, "The shared memory ring is not opened"));
+  }
+
+  vpRingHeader *header = vp_header(m_data);
+  double t_end = vpTime::measureTimeMs() + timeout_ms;
+  for (;;) {
+    // Read the futex before the sequence, so that a publication in between
+    // makes the futex wait return immediately
+    int futex = vp_load(&header->futex);
+    if (vp_load(&header->published) > sequence)
+      return true;
+
+    double remaining = -1.;
+    if (timeout_ms >= 0) {
+      remaining = t_end - vpTime::measureTimeMs();
+      if (remaining <= 0.)
+        return false;
+    }
+    vp_futexWait(&header->futex, futex, remaining);
+  }
+}
+
+/*!
+  Find a slot that can be overwritten and mark it as being written. The slot
+  of the last published frame and the slots pinned by consumers are skipped.
+
+  \return The slot index, or -1 if all the slots are pinned.
+*/
+int vpSharedMemoryRing::beginWrite(const size_t size)
+{
+  if (m_data == NULL || !m_isProducer) {
+    throw(vpException(vpException::notInitialized, "The shared memory ring is not created"));
+  }
+
+  vpRingHeader *header = vp_header(m_data);
+  if (size > header->slotSize) {
+    throw(vpException(vpException::dimensionError, "Frame of %lu bytes larger than the %lu bytes ring slots",
+                      (unsigned long)size, (unsigned long)header->slotSize));
+  }
+
+  int nb_slots = (int)header->nbSlots;
+  vpRingSlot *slots = vp_slots(m_data);
+  for (int k = 1; k <= nb_slots; k++) {
+    int i = (m_writtenSlot + k) % nb_slots;
+    if (i == m_writtenSlot && nb_slots > 1)
+      continue;
+
+    vpRingSlot &slot = slots[i];
+    if (vp_load(&slot.readers) != 0)
+      continue;
+
+    // A consumer pins a slot before checking its state, so that either it
+    // sees the slot being written, or the producer sees the slot pinned
+    int state = vp_load(&slot.state);
+    vp_store(&slot.state, (int)SLOT_WRITING);
+    if (vp_load(&slot.readers) != 0) {
+      vp_store(&slot.state, state);
+      continue;
+    }
+
+    return i;
+  }
+
+  m_droppedFrames++;
+  return -1;
+}
+
+/*!
+  Publish a frame written in a slot and wake up the consumers.
+*/
+void vpSharedMemoryRing::endWrite(const int slot_index, const vpDataType type, const unsigned int width,
+                                  const unsigned int height, const size_t size, const double timestamp)
+{
+  vpRingHeader *header = vp_header(m_data);
+  vpRingSlot &slot = vp_slots(m_data)[slot_index];
+  unsigned long long sequence = vp_load(&header->published) + 1;
+
+  slot.type = (unsigned int)type;
+  slot.width = width;
+  slot.height = height;
+  slot.size = size;
+  slot.timestamp = timestamp;
+  vp_store(&slot.sequence, sequence);
+  vp_store(&slot.state, (int)SLOT_READY);
+
+  vp_store(&header->published, sequence);
+  __atomic_add_fetch(&header->futex, 1, __ATOMIC_SEQ_CST);
+  vp_futexWake(&header->futex);
+
+  m_writtenSlot = slot_index;
+}
+
+/*!
+  Return a pointer to the data of a slot.
+*/
+unsigned char *vpSharedMemoryRing::getSlotData(const int slot_index) const
+{
+  const vpRingHeader *header = vp_header(m_data);
+  return m_data + header->dataOffset + (size_t)slot_index * header->slotSize;
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template <class Type>
+bool vpSharedMemoryRing::writeImage(const vpImage<Type> &I, const vpDataType type, const double timestamp)
+{
+  size_t size = I.getSize() * sizeof(Type);
+  int slot = beginWrite(size);
+  if (slot < 0)
+    return false;
+
+  if (size > 0)
+    memcpy(getSlotData(slot), I.bitmap, size);
+  endWrite(slot, type, I.getWidth(), I.getHeight(), size, timestamp);
+  return true;
+}
+
+template <class Type>
+bool vpSharedMemoryRing::acquireSlot(vpImage<Type> &I, const vpDataType type, unsigned long long &sequence,
+                                     double &timestamp)
+{
+  release();
+
+  if (m_data == NULL) {
+    throw(vpException(vpException::notInitialized, "The shared memory ring is not opened"));
+  }
+
+  vpRingHeader *header = vp_header(m_data);
+  vpRingSlot *slots = vp_slots(m_data);
+  int nb_slots = (int)header->nbSlots;
+
+  // The producer may publish several frames while we look for the slot of
+  // the last one: retry a bounded number of times
+  for (int attempt = 0; attempt < 16 * nb_slots; attempt++) {
+    unsigned long long published = vp_load(&header->published);
+    if (published == 0)
+      return false;
+
+    int i = 0;
+    while (i < nb_slots && vp_load(&slots[i].sequence) != published)
+      i++;
+    if (i == nb_slots)
+      continue;
+
+    vpRingSlot &slot = slots[i];
+    __atomic_add_fetch(&slot.readers, 1, __ATOMIC_SEQ_CST);
+    if (vp_load(&slot.state) != SLOT_READY || vp_load(&slot.sequence) != published) {
+      __atomic_sub_fetch(&slot.readers, 1, __ATOMIC_SEQ_CST);
+      continue;
+    }
+
+    if (slot.type != (unsigned int)type) {
+      __atomic_sub_fetch(&slot.readers, 1, __ATOMIC_SEQ_CST);
+      return false;
+    }
+
+    m_acquiredSlot = i;
+    I.initView(reinterpret_cast<Type *>(getSlotData(i)), slot.height, slot.width);
+    sequence = published;
+    timestamp = slot.timestamp;
+    return true;
+  }
+
+  return false;
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Publish a grey level image.
+
+  \param I : Image to publish.
+  \param timestamp : Timestamp of the frame, by default the current time in
+  ms.
+
+  \return true if the image has been published, false if it has been dropped
+  because all the slots were pinned by consumers.
+
+  \exception vpException::dimensionError : If the image is larger than a
+  slot.
+*/
+bool vpSharedMemoryRing::write(const vpImage<unsigned char> &I, const double timestamp)
+{
+  return writeImage(I, DATA_UCHAR, timestamp);
+}
+
+/*!
+  Publish a 16 bits image, for instance a raw depth map.
+
+  \sa write(const vpImage<unsigned char> &, const double)
+*/
+bool vpSharedMemoryRing::write(const vpImage<uint16_t> &I, const double timestamp)
+{
+  return writeImage(I, DATA_UINT16, timestamp);
+}
+
+/*!
+  Publish a float image, for instance a depth map in meter.
+
+  \sa write(const vpImage<unsigned char> &, const double)
+*/
+bool vpSharedMemoryRing::write(const vpImage<float> &I, const double timestamp)
+{
+  return writeImage(I, DATA_FLOAT, timestamp);
+}
+
+/*!
+  Publish a color image.
+
+  \sa write(const vpImage<unsigned char> &, const double)
+*/
+bool vpSharedMemoryRing::write(const vpImage<vpRGBa> &I, const double timestamp)
+{
+  return writeImage(I, DATA_RGBA, timestamp);
+}
+
+/*!
+  Publish a point cloud. Each point is stored as three floats (X, Y, Z), so
+  that consumers get it with acquirePointCloud() as a Nx3 float image.
+
+  \param pointcloud : Points with at least three coordinates, as given by
+  vpRealSense2::acquire() for instance.
+  \param timestamp : Timestamp of the frame, by default the current time in
+  ms.
+
+  \return true if the point cloud has been published, false if it has been
+  dropped because all the slots were pinned by consumers.
+
+  \exception vpException::dimensionError : If the point cloud is larger than
+  a slot or if a point has less than three coordinates.
+*/
+bool vpSharedMemoryRing::writePointCloud(const std::vector<vpColVector> &pointcloud, const double timestamp)
+{
+  size_t size = pointcloud.size() * 3 * sizeof(float);
+  int slot = beginWrite(size);
+  if (slot < 0)
+    return false;
+
+  float *points = reinterpret_cast<float *>(getSlotData(slot));
+  for (size_t i = 0; i < pointcloud.size(); i++) {
+    if (pointcloud[i].size() < 3) {
+      // Give the slot back without publishing it
+      vp_store(&vp_slots(m_data)[slot].state, (int)SLOT_EMPTY);
+      throw(vpException(vpException::dimensionError, "Point %lu has only %u coordinates", (unsigned long)i,
+                        pointcloud[i].size()));
+    }
+    points[3 * i] = (float)pointcloud[i][0];
+    points[3 * i + 1] = (float)pointcloud[i][1];
+    points[3 * i + 2] = (float)pointcloud[i][2];
+  }
+
+  endWrite(slot, DATA_POINT_CLOUD, 3, (unsigned int)pointcloud.size(), size, timestamp);
+  return true;
+}
+
+/*!
+  Acquire the last published frame as a view on a grey level image. The
+  pixels are not copied: \e I points into the shared memory and remains
+  valid until the next call to acquire() or release(). The previously
+  acquired frame is released.
+
+  \param I : View on the frame.
+  \param sequence : Sequence number of the frame.
+  \param timestamp : Timestamp of the frame.
+
+  \return true if a frame has been acquired, false if no frame has been
+  published yet or if the last frame isn't a grey level image.
+*/
+bool vpSharedMemoryRing::acquire(vpImage<unsigned char> &I, unsigned long long &sequence, double &timestamp)
+{
+  return acquireSlot(I, DATA_UCHAR, sequence, timestamp);
+}
+
+/*!
+  Acquire the last published frame as a view on a 16 bits image.
+
+  \sa acquire(vpImage<unsigned char> &, unsigned long long &, double &)
+*/
+bool vpSharedMemoryRing::acquire(vpImage<uint16_t> &I, unsigned long long &sequence, double &timestamp)
+{
+  return acquireSlot(I, DATA_UINT16, sequence, timestamp);
+}
+
+/*!
+  Acquire the last published frame as a view on a float image.
+
+  \sa acquire(vpImage<unsigned char> &, unsigned long long &, double &)
+*/
+bool vpSharedMemoryRing::acquire(vpImage<float> &I, unsigned long long &sequence, double &timestamp)
+{
+  return acquireSlot(I, DATA_FLOAT, sequence, timestamp);
+}
+
+/*!
+  Acquire the last published frame as a view on a color image.
+
+  \sa acquire(vpImage<unsigned char> &, unsigned long long &, double &)
+*/
+bool vpSharedMemoryRing::acquire(vpImage<vpRGBa> &I, unsigned long long &sequence, double &timestamp)
+{
+  return acquireSlot(I, DATA_RGBA, sequence, timestamp);
+}
+
+/*!
+  Acquire the last published frame as a view on a point cloud, given as a
+  Nx3 float image where row \e i contains the (X, Y, Z) coordinates of the
+  point \e i.
+
+  \sa acquire(vpImage<unsigned char> &, unsigned long long &, double &)
+*/
+bool vpSharedMemoryRing::acquirePointCloud(vpImage<float> &pointcloud, unsigned long long &sequence,
+                                           double &timestamp)
+{
+  return acquireSlot(pointcloud, DATA_POINT_CLOUD, sequence, timestamp);
+}
+
+#elif !defined(VISP_BUILD_SHARED_LIBS)
+// Work arround to avoid warning: libvisp_core.a(vpSharedMemoryRing.cpp.o) has no symbols
+void dummy_vpSharedMemoryRing(){};
+#endif
@@ -44,18 +44,47 @@
 #include <libxml/parser.h>
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpException.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpTime.h>
 
+#include <fstream>
 #include <iomanip>
 #include <sstream>
+#include <stdint.h>
 #include <string>
 #include <typeinfo>
 
+namespace
+{
+// Header of the cache entries: magic, format version, payload size
+const char vpXmlCacheMagic[4] = {'V', 'X', 'M', 'L'};
+const uint32_t vpXmlCacheVersion = 1;
+
+// 64 bits FNV-1a hash, the size is hashed first to separate chained strings
+uint64_t hashFnv1a(const std::string &str, uint64_t hash)
+{
+  const uint64_t prime = (static_cast<uint64_t>(0x100) << 32) | 0x1b3;
+  const uint64_t size = str.size();
+  for (unsigned int i = 0; i < sizeof(size); i++) {
+    hash = (hash ^ ((size >> (8 * i)) & 0xff)) * prime;
+  }
+  for (size_t i = 0; i < str.size(); i++) {
+    hash = (hash ^ static_cast<unsigned char>(str[i])) * prime;
+  }
+  return hash;
+}
+
+// Cache directory of the parsers created afterwards
+std::string vpXmlDefaultCacheDirectory;
+}
+
 /*!
   Basic constructor.
 
-  Initialise the main tag with default value.
+  Initialise the main tag with default value and the cache directory with
+  the one given to setDefaultCacheDirectory().
 */
-vpXmlParser::vpXmlParser() : nodeMap(), main_tag("config") {}
+vpXmlParser::vpXmlParser() : nodeMap(), main_tag("config"), m_cacheDirectory(vpXmlDefaultCacheDirectory) {}
 
 /*!
   Basic destructor that does nothing.
@@ -82,7 +111,10 @@ vpXmlParser::~vpXmlParser()
 
   \param _twin : The parser to copy.
 */
-vpXmlParser::vpXmlParser(const vpXmlParser &_twin) : nodeMap(_twin.nodeMap), main_tag(_twin.main_tag) {}
+vpXmlParser::vpXmlParser(const vpXmlParser &_twin)
+  : nodeMap(_twin.nodeMap), main_tag(_twin.main_tag), m_cacheDirectory(_twin.m_cacheDirectory)
+{
+}
 
 /* utilities functions to read/write data from an xml document */
 
@@ -404,6 +436,176 @@ void vpXmlParser::xmlWriteBoolChild(xmlNodePtr node, const char *label, const bo
   xmlAddChild(node, tmp);
 }
 
+/* utilities functions to cache the parsed data */
+
+/*!
+  Read the whole content of a file.
+
+  \param filename : Name of the file to read.
+  \param content : Content of the file.
+
+  \return true if the file was read.
+*/
+bool vpXmlParser::readFile(const std::string &filename, std::string &content)
+{
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  std::ostringstream ss;
+  ss << file.rdbuf();
+  content = ss.str();
+  return !file.bad();
+}
+
+/*!
+  Get the name of the cache entry associated to an XML document.
+
+  \param content : Content of the XML document.
+  \param key : Additional data identifying the request, for example the
+  state of the parser before parsing.
+
+  \return The name of the cache entry in the cache directory, or an empty
+  string if the cache is disabled.
+
+  \sa setCacheDirectory()
+*/
+std::string vpXmlParser::getCacheFilename(const std::string &content, const std::string &key) const
+{
+  if (m_cacheDirectory.empty()) {
+    return "";
+  }
+
+  uint64_t hash = (static_cast<uint64_t>(0xcbf29ce4) << 32) | 0x84222325;
+  hash = hashFnv1a(content, hash);
+  hash = hashFnv1a(typeid(*this).name(), hash);
+  hash = hashFnv1a(key, hash);
+
+  std::ostringstream ss;
+  ss << std::hex << std::setfill('0') << std::setw(8) << static_cast<uint32_t>(hash >> 32) << std::setw(8)
+     << static_cast<uint32_t>(hash & 0xffffffff) << ".xmlcache";
+  return vpIoTools::createFilePath(m_cacheDirectory, ss.str());
+}
+
+/*!
+  Read a cache entry written by writeCacheFile().
+
+  \param filename : Name of the cache entry.
+  \param data : Data stored in the entry.
+
+  \return true if the entry exists and is valid.
+*/
+bool vpXmlParser::readCacheFile(const std::string &filename, std::string &data)
+{
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  char magic[4];
+  uint32_t version = 0, size = 0;
+  file.read(magic, sizeof(magic));
+  if (!file || memcmp(magic, vpXmlCacheMagic, sizeof(magic)) != 0 || !readCacheValue(file, version) ||
+      version != vpXmlCacheVersion || !readCacheValue(file, size)) {
+    return false;
+  }
+
+  data.resize(size);
+  if (size > 0) {
+    file.read(&data[0], size);
+  }
+  return !file.fail();
+}
+
+/*!
+  Write a cache entry. The entry is first written in a temporary file that
+  is then renamed, so that concurrent readers never see a partial entry.
+  Failures are ignored since the cache is only an optimization.
+
+  \param filename : Name of the cache entry.
+  \param data : Data to store.
+*/
+void vpXmlParser::writeCacheFile(const std::string &filename, const std::string &data)
+{
+  try {
+    std::string dirname = vpIoTools::getParent(filename);
+    if (!dirname.empty() && !vpIoTools::checkDirectory(dirname)) {
+      vpIoTools::makeDirectory(dirname);
+    }
+  } catch (...) {
+    return;
+  }
+
+  std::ostringstream ss;
+  ss << filename << "." << std::fixed << std::setprecision(0) << vpTime::measureTimeMicros() << ".tmp";
+  const std::string tmp_filename = ss.str();
+
+  std::ofstream file(tmp_filename.c_str(), std::ios::out | std::ios::binary);
+  if (!file.is_open()) {
+    return;
+  }
+  file.write(vpXmlCacheMagic, sizeof(vpXmlCacheMagic));
+  writeCacheValue(file, vpXmlCacheVersion);
+  writeCacheValue(file, static_cast<uint32_t>(data.size()));
+  file.write(data.c_str(), static_cast<std::streamsize>(data.size()));
+  file.close();
+
+  if (file.fail() || !vpIoTools::rename(tmp_filename, filename)) {
+    remove(tmp_filename.c_str());
+  }
+}
+
+/*!
+  Read a string written by writeCacheValue().
+
+  \param is : Stream to read from.
+  \param value : Read string.
+  \return true if the string was read.
+*/
+bool vpXmlParser::readCacheValue(std::istream &is, std::string &value)
+{
+  uint32_t size = 0;
+  if (!readCacheValue(is, size)) {
+    return false;
+  }
+  value.resize(size);
+  if (size > 0) {
+    is.read(&value[0], size);
+  }
+  return !is.fail();
+}
+
+/*!
+  Write a string in a cache entry.
+
+  \param os : Stream to write to.
+  \param value : String to write.
+*/
+void vpXmlParser::writeCacheValue(std::ostream &os, const std::string &value)
+{
+  writeCacheValue(os, static_cast<uint32_t>(value.size()));
+  os.write(value.c_str(), static_cast<std::streamsize>(value.size()));
+}
+
+/*!
+  Get the cache directory used by default by the new parsers.
+
+  \sa setDefaultCacheDirectory()
+*/
+std::string vpXmlParser::getDefaultCacheDirectory() { return vpXmlDefaultCacheDirectory; }
+
+/*!
+  Set the cache directory used by default by the parsers created afterwards,
+  see setCacheDirectory(). This allows to cache the configuration files
+  loaded by classes that create their own parser, such as the model-based
+  trackers or vpKeyPoint. It should be called at startup, before other
+  threads create parsers.
+
+  \param dirname : Cache directory. Set an empty string to disable the
+  cache, which is the default.
+*/
+void vpXmlParser::setDefaultCacheDirectory(const std::string &dirname) { vpXmlDefaultCacheDirectory = dirname; }
+
 /* --------------------------------------------------------------------------
  */
 /*                                MAIN METHODS */
@@ -416,14 +618,43 @@ void vpXmlParser::xmlWriteBoolChild(xmlNodePtr node, const char *label, const bo
   method calls the readMainClass method which has to be implemented for every
   child class depending on the content to parse.
 
+  If a cache directory is set and the child class supports caching, the
+  values are read from the cache when the same file was already parsed with
+  the same initial parser state, see setCacheDirectory().
+
   \param filename : name of the file to parse
 */
 void vpXmlParser::parse(const std::string &filename)
 {
   xmlDocPtr doc;
   xmlNodePtr root_node;
+  std::string cache_filename;
+
+  std::ostringstream initial_state;
+  if (m_cacheDirectory.empty() || !writeCacheData(initial_state)) {
+    doc = xmlParseFile(filename.c_str());
+  } else {
+    std::string content;
+    if (!readFile(filename, content)) {
+      vpERROR_TRACE("cannot open file");
+      throw vpException(vpException::ioError, "cannot open file");
+    }
+
+    cache_filename = getCacheFilename(content, initial_state.str());
+    std::string data;
+    if (readCacheFile(cache_filename, data)) {
+      std::istringstream is(data);
+      if (readCacheData(is)) {
+        return;
+      }
+      // Invalid entry, restore the initial state before parsing
+      std::istringstream is_initial(initial_state.str());
+      readCacheData(is_initial);
+    }
+
+    doc = xmlReadMemory(content.c_str(), static_cast<int>(content.size()), filename.c_str(), NULL, 0);
+  }
 
-  doc = xmlParseFile(filename.c_str());
   if (doc == NULL) {
     vpERROR_TRACE("cannot open file");
     throw vpException(vpException::ioError, "cannot open file");
@@ -431,6 +662,7 @@ void vpXmlParser::parse(const std::string &filename)
 
   root_node = xmlDocGetRootElement(doc);
   if (root_node == NULL) {
+    xmlFreeDoc(doc);
     vpERROR_TRACE("cannot get root element");
     throw vpException(vpException::ioError, "cannot get root element");
   }
@@ -438,6 +670,13 @@ void vpXmlParser::parse(const std::string &filename)
   readMainClass(doc, root_node);
 
   xmlFreeDoc(doc);
+
+  if (!cache_filename.empty()) {
+    std::ostringstream os;
+    if (writeCacheData(os)) {
+      writeCacheFile(cache_filename, os.str());
+    }
+  }
 }
 
 /*!
@@ -139,3 +139,15 @@ void vpMoment::printDependencies(std::ostream &os) const
         "the derived classes!"
      << std::endl;
 }
+
+/*!
+  Appends to \e names the names of the moments that must be computed before
+  this moment. They are used by vpMomentDatabase::computeAll() to order the
+  computations. The default implementation declares no dependency.
+  Types inheriting from vpMoment that access other moments of the database
+  should implement this function.
+
+  \param names : Names of the moments this moment depends on, as returned by
+  vpMoment::name().
+*/
+void vpMoment::getDependencies(std::vector<const char *> &names) const { (void)names; }
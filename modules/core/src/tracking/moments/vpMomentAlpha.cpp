@@ -170,3 +170,13 @@ void vpMomentAlpha::printDependencies(std::ostream &os) const
   os << "mu20 = " << momentCentered.get(2, 0) << "\t";
   os << "mu02 = " << momentCentered.get(0, 2) << std::endl;
 }
+
+/*!
+  Appends the names of the moments required to compute the orientation:
+  vpMomentCentered.
+  \param names : Names of the moments this moment depends on.
+*/
+void vpMomentAlpha::getDependencies(std::vector<const char *> &names) const
+{
+  names.push_back("vpMomentCentered");
+}
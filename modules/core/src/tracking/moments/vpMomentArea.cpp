@@ -103,3 +103,13 @@ void vpMomentArea::printDependencies(std::ostream &os) const
     os << "mu00 = " << momentCentered.get(0, 0) << std::endl;
   }
 }
+
+/*!
+  Appends the names of the moments required to compute the area (only used for discrete objects):
+  vpMomentCentered.
+  \param names : Names of the moments this moment depends on.
+*/
+void vpMomentArea::getDependencies(std::vector<const char *> &names) const
+{
+  names.push_back("vpMomentCentered");
+}
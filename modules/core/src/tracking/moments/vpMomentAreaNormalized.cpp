@@ -118,3 +118,13 @@ void vpMomentAreaNormalized::printDependencies(std::ostream &os) const
     a = getObject().get(0, 0);
   os << "a = " << a << std::endl;
 }
+
+/*!
+  Appends the names of the moments required to compute the normalized area:
+  vpMomentCentered.
+  \param names : Names of the moments this moment depends on.
+*/
+void vpMomentAreaNormalized::getDependencies(std::vector<const char *> &names) const
+{
+  names.push_back("vpMomentCentered");
+}
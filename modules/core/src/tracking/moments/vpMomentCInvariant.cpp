@@ -282,6 +282,16 @@ void vpMomentCInvariant::printInvariants(std::ostream &os) const
   os << std::endl;
 }
 
+/*!
+  Appends the names of the moments required to compute the invariants:
+  vpMomentCentered.
+  \param names : Names of the moments this moment depends on.
+*/
+void vpMomentCInvariant::getDependencies(std::vector<const char *> &names) const
+{
+  names.push_back("vpMomentCentered");
+}
+
 /*!
   Outputs the moment's values to a stream.
 */
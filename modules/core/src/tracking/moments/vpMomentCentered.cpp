@@ -189,3 +189,13 @@ void vpMomentCentered::printDependencies(std::ostream &os) const
   os << "Xg = " << momentGravity.getXg() << "\t"
      << "Yg = " << momentGravity.getYg() << std::endl;
 }
+
+/*!
+  Appends the names of the moments required to compute the centered moments:
+  vpMomentGravityCenter.
+  \param names : Names of the moments this moment depends on.
+*/
+void vpMomentCentered::getDependencies(std::vector<const char *> &names) const
+{
+  names.push_back("vpMomentGravityCenter");
+}
@@ -70,9 +70,12 @@ vpMomentCommon::vpMomentCommon(double dstSurface, const std::vector<double> &ref
 
 /*!
 Updates all moments in the database with the object and computes all their
-values. This is possible because this particular database knows the link
-between the moments it contains. The order of computation is as follows:
-vpMomentGravityCenter,vpMomentCentered,vpMomentAlpha,vpMomentCInvariant,vpMomentSInvariant,vpMomentAreaNormalized,vpMomentGravityCenterNormalized
+values. The moments are computed in the order given by their dependencies
+(see vpMomentDatabase::computeAll()), that is vpMomentGravityCenter and
+vpMomentCentered before the other moments, and vpMomentAreaNormalized before
+vpMomentGravityCenterNormalized. All the moments are computed at each call;
+use vpMomentDatabase::computeAllIfChanged() to skip the computation when the
+object did not change.
 \param object : Moment object.
 
 Example of using a preconfigured database to compute one of the C-invariants:
@@ -126,17 +129,7 @@ int main()
 void vpMomentCommon::updateAll(vpMomentObject &object)
 {
   try {
-    vpMomentDatabase::updateAll(object);
-
-    momentGravity.compute();
-    momentCentered.compute();
-    momentAlpha.compute();
-    momentCInvariant->compute();
-
-    momentSurfaceNormalized.compute();
-    momentGravityNormalized.compute();
-    momentArea.compute();
-
+    vpMomentDatabase::computeAll(object);
   } catch (const char *ex) {
     std::cout << "exception:" << ex << std::endl;
   }
@@ -38,6 +38,7 @@
 
 #include <iostream>
 #include <typeinfo>
+#include <visp3/core/vpException.h>
 #include <visp3/core/vpMoment.h>
 #include <visp3/core/vpMomentDatabase.h>
 #include <visp3/core/vpMomentObject.h>
@@ -52,7 +53,143 @@
 */
 void vpMomentDatabase::add(vpMoment &moment, const char *name)
 {
-  moments.insert(std::pair<const char *, vpMoment *>((const char *)name, &moment));
+  if (moments.insert(std::pair<const char *, vpMoment *>((const char *)name, &moment)).second) {
+    linkOrder.push_back(&moment);
+    compiled = false;
+    upToDate = false;
+  }
+}
+
+/*!
+  Resolves the dependencies between the moments of the database and sorts
+  them such as each moment is computed after the moments it depends on (see
+  vpMoment::getDependencies()). Moments without dependencies between them
+  keep the order in which they were linked to the database. Dependencies that
+  are not in the database are ignored.
+
+  This function is called by computeAll() when a moment was linked to the
+  database since the last call.
+
+  \exception vpException::badValue : If there is a cyclic dependency between
+  the moments.
+*/
+void vpMomentDatabase::compile()
+{
+  computeOrder.clear();
+  computeOrder.reserve(linkOrder.size());
+
+  // 0: not visited, 1: being visited, 2: sorted
+  std::vector<int> state(linkOrder.size(), 0);
+  for (unsigned int i = 0; i < linkOrder.size(); i++) {
+    compileNode(i, state);
+  }
+  compiled = true;
+}
+
+/*!
+  Depth-first traversal used by compile() to add a moment after its
+  dependencies.
+*/
+void vpMomentDatabase::compileNode(unsigned int index, std::vector<int> &state)
+{
+  if (state[index] == 2) {
+    return;
+  }
+  if (state[index] == 1) {
+    throw vpException(vpException::badValue, "Cyclic dependency involving %s in the moment database",
+                      linkOrder[index]->name());
+  }
+  state[index] = 1;
+
+  std::vector<const char *> dependencies;
+  linkOrder[index]->getDependencies(dependencies);
+  for (size_t i = 0; i < dependencies.size(); i++) {
+    std::map<const char *, vpMoment *, vpMomentDatabase::cmp_str>::const_iterator it = moments.find(dependencies[i]);
+    if (it == moments.end()) {
+      continue;
+    }
+    for (unsigned int j = 0; j < linkOrder.size(); j++) {
+      if (linkOrder[j] == it->second) {
+        compileNode(j, state);
+        break;
+      }
+    }
+  }
+
+  state[index] = 2;
+  computeOrder.push_back(linkOrder[index]);
+}
+
+/*!
+  Updates all the moments of the database with the object and computes
+  their values in dependency order (see compile()). The database revision
+  (see getRevision()) is incremented.
+
+  \param object : Moment object for which all the moments in the database
+  should be computed.
+
+  \sa computeAllIfChanged()
+*/
+void vpMomentDatabase::computeAll(vpMomentObject &object)
+{
+  if (!compiled) {
+    compile();
+  }
+
+  for (std::vector<vpMoment *>::const_iterator it = computeOrder.begin(); it != computeOrder.end(); ++it) {
+    (*it)->object = &object;
+  }
+
+  computeOrdered(object);
+}
+
+/*!
+  Same as computeAll(), except that nothing is computed if the object has
+  the same type and the same basic moments as during the last computation
+  done by computeAll() or computeAllIfChanged(). The moments are then
+  linked to \e object and keep their values.
+
+  The moment parameters are not taken into account: call invalidate() after
+  changing them.
+
+  \param object : Moment object for which all the moments in the database
+  should be computed.
+  \return true if the moments were computed, false if they were up to date.
+*/
+bool vpMomentDatabase::computeAllIfChanged(vpMomentObject &object)
+{
+  if (!compiled) {
+    compile();
+  }
+
+  for (std::vector<vpMoment *>::const_iterator it = computeOrder.begin(); it != computeOrder.end(); ++it) {
+    (*it)->object = &object;
+  }
+
+  if (upToDate && lastObjectType == (int)object.getType() && lastObjectValues == object.get()) {
+    return false;
+  }
+
+  computeOrdered(object);
+  return true;
+}
+
+/*!
+  Computes the moments in dependency order and records the object used for
+  computeAllIfChanged().
+*/
+void vpMomentDatabase::computeOrdered(vpMomentObject &object)
+{
+  upToDate = false;
+  for (std::vector<vpMoment *>::const_iterator it = computeOrder.begin(); it != computeOrder.end(); ++it) {
+    (*it)->compute();
+  }
+
+  // Assignment between vectors of the same size does not allocate
+  lastObjectValues = object.get();
+  lastObjectType = (int)object.getType();
+  upToDate = true;
+  revision++;
 }
 
 /*!
@@ -81,10 +218,12 @@ const vpMoment &vpMomentDatabase::get(const char *type, bool &found) const
 */
 void vpMomentDatabase::updateAll(vpMomentObject &object)
 {
-  std::map<const char *, vpMoment *, vpMomentDatabase::cmp_str>::const_iterator itr;
-  for (itr = moments.begin(); itr != moments.end(); ++itr) {
-    (*itr).second->update(object);
+  for (std::vector<vpMoment *>::const_iterator it = linkOrder.begin(); it != linkOrder.end(); ++it) {
+    (*it)->update(object);
   }
+  // The moments are computed outside of the database
+  upToDate = false;
+  revision++;
 }
 
 /*!
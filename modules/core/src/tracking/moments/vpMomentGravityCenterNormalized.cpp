@@ -107,3 +107,14 @@ void vpMomentGravityCenterNormalized::printDependencies(std::ostream &os) const
      << "Yg = " << momentGravity.get()[1] << std::endl;
   os << "An = " << momentSurfaceNormalized.get()[0] << std::endl;
 }
+
+/*!
+  Appends the names of the moments required to compute the normalized gravity center:
+  vpMomentGravityCenter and vpMomentAreaNormalized.
+  \param names : Names of the moments this moment depends on.
+*/
+void vpMomentGravityCenterNormalized::getDependencies(std::vector<const char *> &names) const
+{
+  names.push_back("vpMomentGravityCenter");
+  names.push_back("vpMomentAreaNormalized");
+}
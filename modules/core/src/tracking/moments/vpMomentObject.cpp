@@ -37,6 +37,7 @@
  *****************************************************************************/
 
 #include <stdexcept>
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpMomentBasic.h>
@@ -51,6 +52,11 @@
 #endif
 #include <cassert>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
 /*!
   Computes moments from a vector of points describing a polygon.
   The points must be stored in a clockwise order. Used internally.
@@ -289,72 +295,250 @@ image
 void vpMomentObject::fromImage(const vpImage<unsigned char> &image, unsigned char threshold,
                                const vpCameraParameters &cam)
 {
-#ifdef VISP_HAVE_OPENMP
-#pragma omp parallel shared(threshold)
-  {
-    std::vector<double> curvals(order * order);
-    curvals.assign(order * order, 0.);
-
-#pragma omp for nowait // automatically organize loop counter between threads
-    for (int i = 0; i < (int)image.getCols(); i++) {
-      for (int j = 0; j < (int)image.getRows(); j++) {
-        unsigned int i_ = static_cast<unsigned int>(i);
-        unsigned int j_ = static_cast<unsigned int>(j);
-        if (image[j_][i_] > threshold) {
+  values.assign(order * order, 0.);
+
+  if (cam.get_projModel() == vpCameraParameters::perspectiveProjWithDistortion) {
+    // With distortion, x depends on both pixel coordinates: no separability
+    std::vector<double> cache(order * order, 0.);
+    for (unsigned int j = 0; j < image.getRows(); j++) {
+      const unsigned char *row = image[j];
+      for (unsigned int i = 0; i < image.getCols(); i++) {
+        if (row[i] > threshold) {
           double x = 0;
           double y = 0;
-          vpPixelMeterConversion::convertPoint(cam, i_, j_, x, y);
+          vpPixelMeterConversion::convertPoint(cam, i, j, x, y);
+          cacheValues(cache, x, y);
+          for (unsigned int k = 0; k < order; k++) {
+            for (unsigned int l = 0; l < order - k; l++) {
+              values[k * order + l] += cache[k * order + l];
+            }
+          }
+        }
+      }
+    }
+  } else {
+    // Without distortion x only depends on the column and y on the row. For
+    // each row we accumulate the power sums of x over the foreground pixels,
+    // sum_j x_j^l, that are then combined with the powers of y:
+    // m_lk += y^k sum_j x_j^l
+    std::vector<double> xtab, ytab;
+    computeCoordinateTables(image.getCols(), image.getRows(), cam, xtab, ytab);
+
+    const unsigned int ncols = image.getCols();
+    const int nrows = (int)image.getRows();
+#if VISP_HAVE_SSE2
+    const bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#endif
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel
+#endif
+    {
+      std::vector<double> curvals(order * order, 0.);
+      std::vector<double> rowsums(order, 0.);
 
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for nowait
+#endif
+      for (int j = 0; j < nrows; j++) {
+        const unsigned char *row = image[(unsigned int)j];
+        rowsums.assign(order, 0.);
+
+        unsigned int i = 0;
+#if VISP_HAVE_SSE2
+        if (checkSSE2 && ncols >= 16) {
+          // Unsigned comparison using a signed one after a shift of 128
+          const __m128i offset = _mm_set1_epi8((char)0x80);
+          const __m128i thresh = _mm_xor_si128(_mm_set1_epi8((char)threshold), offset);
+          for (; i <= ncols - 16; i += 16) {
+            __m128i pix = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(row + i)), offset);
+            int mask = _mm_movemask_epi8(_mm_cmpgt_epi8(pix, thresh));
+            while (mask != 0) {
+              unsigned int b = 0;
+              while (!(mask & (1 << b)))
+                b++;
+              mask &= ~(1 << b);
+              addPowers(rowsums, xtab[i + b]);
+            }
+          }
+        }
+#endif
+        for (; i < ncols; i++) {
+          if (row[i] > threshold) {
+            addPowers(rowsums, xtab[i]);
+          }
+        }
+
+        if (rowsums[0] > 0.) {
           double yval = 1.;
+          double y = ytab[(unsigned int)j];
           for (unsigned int k = 0; k < order; k++) {
-            double xval = 1.;
             for (unsigned int l = 0; l < order - k; l++) {
-              curvals[(k * order + l)] += (xval * yval);
-              xval *= x;
+              curvals[k * order + l] += yval * rowsums[l];
             }
             yval *= y;
           }
         }
       }
-    }
 
-#pragma omp master // only set this variable in master thread
-    {
-      values.assign(order * order, 0.);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp critical
+#endif
+      {
+        for (unsigned int k = 0; k < order * order; k++) {
+          values[k] += curvals[k];
+        }
+      }
     }
+  }
 
-#pragma omp barrier
-    for (unsigned int k = 0; k < order; k++) {
-      for (unsigned int l = 0; l < order - k; l++) {
-#pragma omp atomic
-        values[k * order + l] += curvals[k * order + l];
-      }
+  // Normalisation equivalent to sampling interval/pixel size delX x delY
+  double norm_factor = 1. / (cam.get_px() * cam.get_py());
+  for (std::vector<double>::iterator it = values.begin(); it != values.end(); ++it) {
+    *it = (*it) * norm_factor;
+  }
+}
+
+/*!
+  Computes in a single pass the basic moments of several objects defined by
+  a label image, as the one produced by a connected components analysis
+  (see vpImgproc::connectedComponents()).
+
+  The pixels with label \e k, with \f$1 \leq k \leq\f$ objects.size(), are
+  used to compute the moments of objects[k-1]. Pixels with label 0 (the
+  background) or with a label greater than objects.size() are ignored. Each
+  row is split in runs of pixels with the same label. The power sums of
+  \f$x\f$ along a run are combined with the powers of \f$y\f$ once at the end
+  of the run.
+
+  \param labels : Label image.
+  \param cam : Camera parameters used to convert pixels coordinates in meters
+  in the image plane.
+  \param objects : Moment objects to update. They must have the same order.
+
+  The code below shows how to use this function.
+  \code
+#include <visp3/core/vpMomentObject.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+int main()
+{
+  vpCameraParameters cam;
+  vpImage<unsigned char> I;
+  // ... Initialize the binary image
+
+  vpImage<int> labels;
+  int nbComponents = 0;
+  vp::connectedComponents(I, labels, nbComponents);
+
+  std::vector<vpMomentObject> objects(nbComponents, vpMomentObject(3));
+  vpMomentObject::fromLabels(labels, cam, objects);
+
+  return 0;
+}
+  \endcode
+*/
+void vpMomentObject::fromLabels(const vpImage<int> &labels, const vpCameraParameters &cam,
+                                std::vector<vpMomentObject> &objects)
+{
+  if (objects.empty()) {
+    return;
+  }
+
+  const unsigned int ord = objects[0].order;
+  for (size_t n = 0; n < objects.size(); n++) {
+    if (objects[n].order != ord) {
+      throw vpException(vpException::dimensionError, "Moment objects should have the same order");
     }
+    objects[n].values.assign(ord * ord, 0.);
   }
-#else
-  std::vector<double> cache(order * order, 0.);
-  values.assign(order * order, 0);
-  for (unsigned int i = 0; i < image.getCols(); i++) {
-    for (unsigned int j = 0; j < image.getRows(); j++) {
-      if (image[j][i] > threshold) {
-        double x = 0;
-        double y = 0;
-        vpPixelMeterConversion::convertPoint(cam, i, j, x, y);
-        cacheValues(cache, x, y);
-        for (unsigned int k = 0; k < order; k++) {
-          for (unsigned int l = 0; l < order - k; l++) {
-            values[k * order + l] += cache[k * order + l];
+
+  const int nb_objects = (int)objects.size();
+  const unsigned int ncols = labels.getCols();
+  const bool distortion = (cam.get_projModel() == vpCameraParameters::perspectiveProjWithDistortion);
+  std::vector<double> xtab, ytab;
+  if (!distortion) {
+    computeCoordinateTables(ncols, labels.getRows(), cam, xtab, ytab);
+  }
+
+  std::vector<double> runsums(ord, 0.);
+  std::vector<double> cache(ord * ord, 0.);
+
+  for (unsigned int j = 0; j < labels.getRows(); j++) {
+    const int *row = labels[j];
+    unsigned int i = 0;
+    while (i < ncols) {
+      int label = row[i];
+      if (label <= 0 || label > nb_objects) {
+        i++;
+        continue;
+      }
+
+      vpMomentObject &obj = objects[(size_t)(label - 1)];
+      if (distortion) {
+        for (; i < ncols && row[i] == label; i++) {
+          double x = 0;
+          double y = 0;
+          vpPixelMeterConversion::convertPoint(cam, i, j, x, y);
+          obj.cacheValues(cache, x, y);
+          for (unsigned int k = 0; k < ord; k++) {
+            for (unsigned int l = 0; l < ord - k; l++) {
+              obj.values[k * ord + l] += cache[k * ord + l];
+            }
+          }
+        }
+      } else {
+        runsums.assign(ord, 0.);
+        for (; i < ncols && row[i] == label; i++) {
+          obj.addPowers(runsums, xtab[i]);
+        }
+
+        double yval = 1.;
+        for (unsigned int k = 0; k < ord; k++) {
+          for (unsigned int l = 0; l < ord - k; l++) {
+            obj.values[k * ord + l] += yval * runsums[l];
           }
+          yval *= ytab[j];
         }
       }
     }
   }
-#endif
 
   // Normalisation equivalent to sampling interval/pixel size delX x delY
   double norm_factor = 1. / (cam.get_px() * cam.get_py());
-  for (std::vector<double>::iterator it = values.begin(); it != values.end(); ++it) {
-    *it = (*it) * norm_factor;
+  for (size_t n = 0; n < objects.size(); n++) {
+    for (std::vector<double>::iterator it = objects[n].values.begin(); it != objects[n].values.end(); ++it) {
+      *it = (*it) * norm_factor;
+    }
+  }
+}
+
+/*!
+  Computes the coordinates in meter of the image columns and rows. Used
+  internally when the camera model has no distortion.
+*/
+void vpMomentObject::computeCoordinateTables(unsigned int ncols, unsigned int nrows, const vpCameraParameters &cam,
+                                             std::vector<double> &xtab, std::vector<double> &ytab)
+{
+  xtab.resize(ncols);
+  ytab.resize(nrows);
+  for (unsigned int i = 0; i < ncols; i++) {
+    xtab[i] = (i - cam.get_u0()) * cam.get_px_inverse();
+  }
+  for (unsigned int j = 0; j < nrows; j++) {
+    ytab[j] = (j - cam.get_v0()) * cam.get_py_inverse();
+  }
+}
+
+/*!
+  Adds the powers \f$x^l\f$, \f$0 \leq l < order\f$, to the power sums.
+*/
+void vpMomentObject::addPowers(std::vector<double> &sums, double x) const
+{
+  double xval = 1.;
+  for (unsigned int l = 0; l < order; l++) {
+    sums[l] += xval;
+    xval *= x;
   }
 }
 
@@ -0,0 +1,264 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * PNG and JPEG compression presets and batch image reading/writing.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageIoBatch.cpp
+  \brief Writes PNG and JPEG images with the different compression presets
+  and checks that they are read back correctly, then writes and reads a list
+  of images with several threads.
+*/
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpImageIo.h>
+
+namespace
+{
+void createImage(vpImage<vpRGBa> &I, unsigned int k)
+{
+  I.resize(37, 53);
+  for (unsigned int i = 0; i < I.getHeight(); i++)
+    for (unsigned int j = 0; j < I.getWidth(); j++)
+      I[i][j] = vpRGBa((unsigned char)(4 * i + k), (unsigned char)(3 * j), (unsigned char)(i + j + 2 * k),
+                       vpRGBa::alpha_default);
+}
+
+void createImage(vpImage<unsigned char> &I, unsigned int k)
+{
+  vpImage<vpRGBa> Irgba;
+  createImage(Irgba, k);
+  vpImageConvert::convert(Irgba, I);
+}
+
+template <class Type> double meanAbsDiff(const vpImage<Type> &I1, const vpImage<Type> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth())
+    return 1e6;
+  const unsigned char *p1 = reinterpret_cast<const unsigned char *>(I1.bitmap);
+  const unsigned char *p2 = reinterpret_cast<const unsigned char *>(I2.bitmap);
+  double sum = 0;
+  size_t n = I1.getSize() * sizeof(Type);
+  for (size_t i = 0; i < n; i++)
+    sum += p1[i] > p2[i] ? p1[i] - p2[i] : p2[i] - p1[i];
+  return sum / n;
+}
+
+unsigned int maxAbsDiff(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2)
+{
+  unsigned int max = 0;
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    unsigned int diff = I1.bitmap[i] > I2.bitmap[i] ? I1.bitmap[i] - I2.bitmap[i] : I2.bitmap[i] - I1.bitmap[i];
+    if (diff > max)
+      max = diff;
+  }
+  return max;
+}
+
+bool testPresets(const std::string &opath)
+{
+  vpImage<unsigned char> I, I_read, I_ref;
+  vpImage<vpRGBa> Irgba, Irgba_read, Irgba_ref;
+  createImage(I, 0);
+  createImage(Irgba, 0);
+  std::string filename;
+
+#if defined(VISP_HAVE_PNG) || defined(VISP_HAVE_OPENCV)
+  vpImageIo::vpPNGCompression presets[4] = {vpImageIo::PNG_COMPRESSION_DEFAULT, vpImageIo::PNG_COMPRESSION_FAST,
+                                            vpImageIo::PNG_COMPRESSION_FASTEST, vpImageIo::PNG_COMPRESSION_BEST};
+  filename = vpIoTools::createFilePath(opath, "image.png");
+  for (unsigned int i = 0; i < 4; i++) {
+    vpImageIo::write(I, filename, 75, presets[i]);
+    vpImageIo::read(I_read, filename);
+    if (!(I_read == I)) {
+      std::cerr << "PNG gray level image differs with preset " << i << std::endl;
+      return false;
+    }
+    vpImageIo::read(Irgba_read, filename);
+    vpImageConvert::convert(I, Irgba_ref);
+    if (!(Irgba_read == Irgba_ref)) {
+      std::cerr << "PNG gray level image read as color differs with preset " << i << std::endl;
+      return false;
+    }
+
+    vpImageIo::writePNG(Irgba, filename, presets[i]);
+    vpImageIo::read(Irgba_read, filename);
+    if (!(Irgba_read == Irgba)) {
+      std::cerr << "PNG color image differs with preset " << i << std::endl;
+      return false;
+    }
+    vpImageIo::read(I_read, filename);
+    vpImageConvert::convert(Irgba, I_ref);
+    if (!(I_read == I_ref)) {
+      std::cerr << "PNG color image read as gray level differs with preset " << i << std::endl;
+      return false;
+    }
+  }
+  std::cout << "PNG presets ok" << std::endl;
+#endif
+
+#if defined(VISP_HAVE_JPEG) || defined(VISP_HAVE_OPENCV)
+  filename = vpIoTools::createFilePath(opath, "image.jpg");
+  int qualities[3] = {30, 75, 95};
+  double errors[3];
+  for (unsigned int i = 0; i < 3; i++) {
+    vpImageIo::write(Irgba, filename, qualities[i]);
+    vpImageIo::read(Irgba_read, filename);
+    errors[i] = meanAbsDiff(Irgba, Irgba_read);
+    // Rounding may differ between the vectorized and scalar conversions
+    vpImageIo::read(I_read, filename);
+    vpImageConvert::convert(Irgba_read, I_ref);
+    if (maxAbsDiff(I_read, I_ref) > 1) {
+      std::cerr << "JPEG color image read as gray level differs from its conversion" << std::endl;
+      return false;
+    }
+
+    vpImageIo::writeJPEG(I, filename, qualities[i]);
+    vpImageIo::read(I_read, filename);
+    if (meanAbsDiff(I, I_read) > 4.) {
+      std::cerr << "JPEG gray level image differs with quality " << qualities[i] << std::endl;
+      return false;
+    }
+    vpImageIo::read(Irgba_read, filename);
+    vpImageConvert::convert(I_read, Irgba_ref);
+    if (!(Irgba_read == Irgba_ref)) {
+      std::cerr << "JPEG gray level image read as color differs from its conversion" << std::endl;
+      return false;
+    }
+  }
+  if (errors[2] > 4. || errors[0] < errors[2]) {
+    std::cerr << "JPEG quality not taken into account: " << errors[0] << " " << errors[1] << " " << errors[2]
+              << std::endl;
+    return false;
+  }
+  std::cout << "JPEG qualities ok" << std::endl;
+#endif
+  return true;
+}
+
+bool testBatch(const std::string &opath)
+{
+  const unsigned int nb_images = 12;
+  const char *extensions[2] = {"pgm", "png"};
+
+  std::vector<vpImage<unsigned char> > images(nb_images), images_read;
+  std::vector<std::string> filenames(nb_images);
+  for (unsigned int k = 0; k < nb_images; k++) {
+    createImage(images[k], k);
+#if defined(VISP_HAVE_PNG) || defined(VISP_HAVE_OPENCV)
+    const char *extension = extensions[k % 2];
+#else
+    const char *extension = extensions[0];
+#endif
+    char name[FILENAME_MAX];
+    sprintf(name, "batch%02u.%s", k, extension);
+    filenames[k] = vpIoTools::createFilePath(opath, name);
+  }
+
+  vpImageIo::writeBatch(images, filenames, 3, 90, vpImageIo::PNG_COMPRESSION_FAST);
+  vpImageIo::readBatch(images_read, filenames, 3);
+  if (images_read.size() != nb_images) {
+    std::cerr << "readBatch() returned " << images_read.size() << " images" << std::endl;
+    return false;
+  }
+  for (unsigned int k = 0; k < nb_images; k++) {
+    if (!(images_read[k] == images[k])) {
+      std::cerr << "Batch image " << k << " differs" << std::endl;
+      return false;
+    }
+  }
+
+  // Color images decoded sequentially and in parallel are the same
+  std::vector<vpImage<vpRGBa> > rgba_seq, rgba_par;
+  vpImageIo::readBatch(rgba_seq, filenames, 0);
+  vpImageIo::readBatch(rgba_par, filenames, 4);
+  for (unsigned int k = 0; k < nb_images; k++) {
+    if (!(rgba_seq[k] == rgba_par[k])) {
+      std::cerr << "Color batch image " << k << " differs" << std::endl;
+      return false;
+    }
+  }
+
+  // A missing file is reported once all the other images are read
+  std::string missing = vpIoTools::createFilePath(opath, "missing.pgm");
+  filenames[5] = missing;
+  images_read.clear();
+  bool thrown = false;
+  try {
+    vpImageIo::readBatch(images_read, filenames, 2);
+  } catch (const vpException &e) {
+    thrown = e.getStringMessage().find("missing.pgm") != std::string::npos;
+  }
+  if (!thrown || !(images_read[nb_images - 1] == images[nb_images - 1])) {
+    std::cerr << "readBatch() does not report the missing file" << std::endl;
+    return false;
+  }
+
+  std::cout << "Batch ok" << std::endl;
+  return true;
+}
+}
+
+int main()
+{
+  try {
+#if defined(_WIN32)
+    std::string opath = "C:/temp";
+#else
+    std::string opath = "/tmp";
+#endif
+    std::string username;
+    vpIoTools::getUserName(username);
+    opath = vpIoTools::createFilePath(opath, username);
+    opath = vpIoTools::createFilePath(opath, "testImageIoBatch");
+    vpIoTools::makeDirectory(opath);
+
+    if (!testPresets(opath) || !testBatch(opath)) {
+      return EXIT_FAILURE;
+    }
+
+    vpIoTools::remove(opath);
+
+    std::cout << "testImageIoBatch is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getStringMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
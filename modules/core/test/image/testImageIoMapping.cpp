@@ -0,0 +1,337 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Memory mapped image reading and raw frame container.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageIoMapping.cpp
+  \brief Checks that PGM, PPM and PFM images read through a memory mapping
+  are identical to the written ones, that vpImageIo::mapPGM() and
+  vpImageIo::mapPFM() do not copy the pixels, and that frames stored in a
+  vpRawFrameFile can be randomly accessed.
+*/
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpThread.h>
+#include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpMemoryMappedFile.h>
+#include <visp3/io/vpRawFrameFile.h>
+
+#if defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+namespace
+{
+template <typename Type> void createFrame(vpImage<Type> &I, unsigned int k)
+{
+  I.resize(17, 23);
+  for (unsigned int i = 0; i < I.getHeight(); i++)
+    for (unsigned int j = 0; j < I.getWidth(); j++)
+      I[i][j] = (Type)((k * 7 + i * 3 + j) % 251);
+}
+
+template <typename Type> bool isMapped(const vpImage<Type> &I, const vpMemoryMappedFile &file)
+{
+  const unsigned char *ptr = reinterpret_cast<const unsigned char *>(I.bitmap);
+  return ptr >= file.getData() && ptr + I.getSize() * sizeof(Type) <= file.getData() + file.getSize();
+}
+
+#if defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
+struct vpFifoData {
+  std::string filename;
+  const vpImage<unsigned char> *I;
+};
+
+vpThread::Return writeFifo(vpThread::Args args)
+{
+  vpFifoData *data = static_cast<vpFifoData *>(args);
+  // Blocks until the reader opens the fifo
+  FILE *fd = fopen(data->filename.c_str(), "wb");
+  if (fd != NULL) {
+    fprintf(fd, "P5\n%u %u\n255\n", data->I->getWidth(), data->I->getHeight());
+    fwrite(data->I->bitmap, 1, data->I->getSize(), fd);
+    fclose(fd);
+  }
+  return 0;
+}
+
+// A fifo cannot be mapped: the image is read as a stream
+bool testFifo(const std::string &opath, const vpImage<unsigned char> &I)
+{
+  vpFifoData data;
+  data.filename = vpIoTools::createFilePath(opath, "fifo.pgm");
+  data.I = &I;
+  if (mkfifo(data.filename.c_str(), 0600) != 0) {
+    std::cout << "Cannot create a fifo, skip the test" << std::endl;
+    return true;
+  }
+  if (vpMemoryMappedFile::isMappable(data.filename)) {
+    std::cerr << "A fifo should not be mappable" << std::endl;
+    return false;
+  }
+  vpThread writer((vpThread::Fn)writeFifo, (vpThread::Args)&data);
+  vpImage<unsigned char> I_read;
+  vpImageIo::readPGM(I_read, data.filename);
+  writer.join();
+  remove(data.filename.c_str());
+  if (!(I_read == I)) {
+    std::cerr << "readPGM() does not give the image written in a fifo" << std::endl;
+    return false;
+  }
+  return true;
+}
+#endif
+
+bool testPNM(const std::string &opath)
+{
+  vpImage<unsigned char> I, I_read;
+  createFrame(I, 1);
+  std::string filename = vpIoTools::createFilePath(opath, "image.pgm");
+  vpImageIo::write(I, filename);
+  vpImageIo::read(I_read, filename);
+  if (!(I_read == I)) {
+    std::cerr << "readPGM() does not give the written image" << std::endl;
+    return false;
+  }
+
+  vpMemoryMappedFile file;
+  vpImage<unsigned char> I_map;
+  vpImageIo::mapPGM(I_map, file, filename);
+  if (!(I_map == I) || !isMapped(I_map, file)) {
+    std::cerr << "mapPGM() does not give a view on the written image" << std::endl;
+    return false;
+  }
+  // Writing in the view should not alter the file
+  I_map[0][0] = 255;
+  vpImageIo::readPGM(I_read, filename);
+  if (I_read[0][0] != I[0][0]) {
+    std::cerr << "Modifying a mapped image altered the file" << std::endl;
+    return false;
+  }
+  file.close();
+
+  // Header with comments, several values on a line and no trailing newline
+  filename = vpIoTools::createFilePath(opath, "comment.pgm");
+  FILE *fd = fopen(filename.c_str(), "wb");
+  fprintf(fd, "P5 # gray image\n# size\n%u\t%u 255 ", I.getWidth(), I.getHeight());
+  fwrite(I.bitmap, 1, I.getSize(), fd);
+  fclose(fd);
+  vpImageIo::readPGM(I_read, filename);
+  if (!(I_read == I)) {
+    std::cerr << "Cannot decode a PGM header with comments" << std::endl;
+    return false;
+  }
+
+  // Truncated file
+  fd = fopen(filename.c_str(), "wb");
+  fprintf(fd, "P5\n%u %u\n255\n", I.getWidth(), I.getHeight());
+  fwrite(I.bitmap, 1, I.getSize() / 2, fd);
+  fclose(fd);
+  bool thrown = false;
+  try {
+    vpImageIo::readPGM(I_read, filename);
+  } catch (const vpImageException &) {
+    thrown = true;
+  }
+  if (!thrown) {
+    std::cerr << "Reading a truncated PGM file should fail" << std::endl;
+    return false;
+  }
+
+#if defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
+  if (!testFifo(opath, I)) {
+    return false;
+  }
+#endif
+
+  vpImage<vpRGBa> Irgba, Irgba_read;
+  vpImageConvert::convert(I, Irgba);
+  for (unsigned int i = 0; i < Irgba.getHeight(); i++)
+    Irgba[i][0].R = 12;
+  filename = vpIoTools::createFilePath(opath, "image.ppm");
+  vpImageIo::write(Irgba, filename);
+  vpImageIo::read(Irgba_read, filename);
+  if (!(Irgba_read == Irgba)) {
+    std::cerr << "readPPM() does not give the written image" << std::endl;
+    return false;
+  }
+  vpImage<unsigned char> I_ref;
+  vpImageConvert::convert(Irgba, I_ref);
+  vpImageIo::read(I_read, filename);
+  if (!(I_read == I_ref)) {
+    std::cerr << "readPPM() does not give the expected gray level image" << std::endl;
+    return false;
+  }
+
+  // Various widths change the alignment of the PFM payload
+  for (unsigned int w = 1; w < 40; w += 3) {
+    vpImage<float> F(5, w), F_read;
+    for (unsigned int i = 0; i < F.getSize(); i++)
+      F.bitmap[i] = i * 0.5f - 3.f;
+    filename = vpIoTools::createFilePath(opath, "image.pfm");
+    vpImageIo::writePFM(F, filename);
+    vpImageIo::readPFM(F_read, filename);
+    if (!(F_read == F)) {
+      std::cerr << "readPFM() does not give the written image" << std::endl;
+      return false;
+    }
+    vpImageIo::mapPFM(F_read, file, filename);
+    if (!(F_read == F) || !isMapped(F_read, file)) {
+      std::cerr << "mapPFM() does not give a view on the written image" << std::endl;
+      return false;
+    }
+    file.close();
+  }
+
+  std::cout << "PGM, PPM and PFM mapping ok" << std::endl;
+  return true;
+}
+
+template <typename Type> bool testRawFrames(const std::string &filename, vpRawFrameFile::vpPixelType type)
+{
+  const unsigned int nb_frames = 6;
+  vpImage<Type> I;
+
+  vpRawFrameFile writer;
+  createFrame(I, 0);
+  writer.create(filename, type, I.getWidth(), I.getHeight());
+  for (unsigned int k = 0; k < nb_frames; k++) {
+    createFrame(I, k);
+    writer.write(I);
+  }
+  bool thrown = false;
+  try {
+    writer.write(vpImage<Type>(3, 3));
+  } catch (const vpException &) {
+    thrown = true;
+  }
+  if (!thrown) {
+    std::cerr << "Writing an image with another size should fail" << std::endl;
+    return false;
+  }
+  writer.close();
+
+  vpRawFrameFile reader;
+  reader.open(filename);
+  if (reader.getNumberOfFrames() != nb_frames || reader.getPixelType() != type || reader.getWidth() != I.getWidth() ||
+      reader.getHeight() != I.getHeight()) {
+    std::cerr << "Bad raw frame file header" << std::endl;
+    return false;
+  }
+  unsigned int indexes[5] = {4, 0, 5, 2, 2};
+  vpImage<Type> I_ref;
+  for (unsigned int i = 0; i < 5; i++) {
+    reader.getFrame(I, indexes[i]);
+    createFrame(I_ref, indexes[i]);
+    if (!(I_ref == I)) {
+      std::cerr << "Frame " << indexes[i] << " is not the expected one" << std::endl;
+      return false;
+    }
+  }
+  thrown = false;
+  try {
+    reader.getFrame(I, nb_frames);
+  } catch (const vpException &) {
+    thrown = true;
+  }
+  if (!thrown) {
+    std::cerr << "Reading after the last frame should fail" << std::endl;
+    return false;
+  }
+  reader.close();
+
+  // The view is released on resize
+  I.resize(2, 2);
+  I = 0;
+  return true;
+}
+}
+
+int main()
+{
+  try {
+#if defined(_WIN32)
+    std::string opath = "C:/temp";
+#else
+    std::string opath = "/tmp";
+#endif
+    std::string username;
+    vpIoTools::getUserName(username);
+    opath = vpIoTools::createFilePath(opath, username);
+    opath = vpIoTools::createFilePath(opath, "testImageIoMapping");
+    vpIoTools::makeDirectory(opath);
+
+    if (!testPNM(opath)) {
+      return EXIT_FAILURE;
+    }
+
+    std::string filename = vpIoTools::createFilePath(opath, "frames.raw");
+    if (!testRawFrames<unsigned char>(filename, vpRawFrameFile::PIXEL_UCHAR) ||
+        !testRawFrames<uint16_t>(filename, vpRawFrameFile::PIXEL_UINT16) ||
+        !testRawFrames<float>(filename, vpRawFrameFile::PIXEL_FLOAT)) {
+      return EXIT_FAILURE;
+    }
+
+    vpRawFrameFile reader;
+    reader.open(filename);
+    vpImage<unsigned char> I;
+    bool thrown = false;
+    try {
+      reader.getFrame(I, 0);
+    } catch (const vpException &) {
+      thrown = true;
+    }
+    if (!thrown) {
+      std::cerr << "Reading frames with another pixel type should fail" << std::endl;
+      return EXIT_FAILURE;
+    }
+    reader.close();
+    std::cout << "Raw frame file ok" << std::endl;
+
+    vpIoTools::remove(opath);
+
+    std::cout << "testImageIoMapping is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getStringMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
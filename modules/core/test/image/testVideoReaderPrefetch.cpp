@@ -0,0 +1,185 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Read an image sequence with and without prefetching.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testVideoReaderPrefetch.cpp
+  \brief Writes a short image sequence on the disk and checks that
+  vpVideoReader and vpDiskGrabber return the same frames in the same order
+  with and without prefetching, for positive and negative frame steps and
+  after a direct access to a frame.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpDiskGrabber.h>
+#include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpVideoReader.h>
+
+namespace
+{
+const long nbFrames = 30;
+
+// Frame k is a gradient starting at value k
+void createFrame(vpImage<unsigned char> &I, long k)
+{
+  I.resize(24, 32);
+  for (unsigned int i = 0; i < I.getHeight(); i++)
+    for (unsigned int j = 0; j < I.getWidth(); j++)
+      I[i][j] = (unsigned char)((k + i + j) % 256);
+}
+
+bool isFrame(const vpImage<unsigned char> &I, long k)
+{
+  vpImage<unsigned char> I_ref;
+  createFrame(I_ref, k);
+  return I_ref == I;
+}
+
+// Read the sequence with vpVideoReader and return the indexes of the frames.
+// The frame is positioned with getFrame() when start is positive.
+bool readSequence(const std::string &filename, long step, long start, unsigned int nb_threads,
+                  std::vector<long> &indexes)
+{
+  vpVideoReader reader;
+  reader.setFileName(filename);
+  reader.setFrameStep(step);
+  reader.setPrefetch(nb_threads, 4);
+
+  vpImage<unsigned char> I;
+  reader.open(I);
+  if (start >= 0)
+    reader.getFrame(I, start);
+
+  indexes.clear();
+  while (!reader.end()) {
+    reader.acquire(I);
+    if (!isFrame(I, reader.getFrameIndex())) {
+      std::cerr << "The content of frame " << reader.getFrameIndex() << " is not the expected one" << std::endl;
+      return false;
+    }
+    indexes.push_back(reader.getFrameIndex());
+  }
+  return true;
+}
+
+bool compare(const std::string &filename, long step, long start)
+{
+  std::vector<long> ref, indexes;
+  if (!readSequence(filename, step, start, 0, ref))
+    return false;
+  unsigned int nb_threads[2] = {1, 3};
+  for (unsigned int i = 0; i < 2; i++) {
+    if (!readSequence(filename, step, start, nb_threads[i], indexes))
+      return false;
+    if (indexes != ref) {
+      std::cerr << "Step " << step << ": the frames are not returned in the same order with " << nb_threads[i]
+                << " prefetching threads" << std::endl;
+      return false;
+    }
+  }
+  std::cout << "Step " << step << ": " << ref.size() << " frames read in the same order" << std::endl;
+  return !ref.empty();
+}
+}
+
+int main()
+{
+  try {
+#if defined(_WIN32)
+    std::string opath = "C:/temp";
+#else
+    std::string opath = "/tmp";
+#endif
+    std::string username;
+    vpIoTools::getUserName(username);
+    opath = vpIoTools::createFilePath(opath, username);
+    opath = vpIoTools::createFilePath(opath, "testVideoReaderPrefetch");
+    vpIoTools::makeDirectory(opath);
+
+    vpImage<unsigned char> I;
+    for (long k = 0; k < nbFrames; k++) {
+      createFrame(I, k);
+      char name[FILENAME_MAX];
+      sprintf(name, "%s/image%04ld.pgm", opath.c_str(), k);
+      vpImageIo::write(I, name);
+    }
+    std::string filename = vpIoTools::createFilePath(opath, "image%04d.pgm");
+
+    if (!compare(filename, 1, -1) || !compare(filename, 3, -1) || !compare(filename, 2, 11) ||
+        !compare(filename, -1, nbFrames - 1) || !compare(filename, -4, 25)) {
+      return EXIT_FAILURE;
+    }
+
+    // Random access, type change and end of sequence with vpDiskGrabber
+    vpDiskGrabber g(filename);
+    g.setPrefetch(2, 5);
+    vpImage<vpRGBa> Irgba;
+    long numbers[6] = {3, 4, 5, 17, 16, 5};
+    for (unsigned int i = 0; i < 6; i++) {
+      g.acquire(I, numbers[i]);
+      if (!isFrame(I, numbers[i])) {
+        std::cerr << "vpDiskGrabber: frame " << numbers[i] << " is not the expected one" << std::endl;
+        return EXIT_FAILURE;
+      }
+      g.acquire(Irgba, numbers[i]);
+      if (Irgba[2][3].R != I[2][3]) {
+        std::cerr << "vpDiskGrabber: color frame " << numbers[i] << " is not the expected one" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    bool thrown = false;
+    try {
+      g.acquire(I, nbFrames);
+    } catch (const vpImageException &) {
+      thrown = true;
+    }
+    if (!thrown) {
+      std::cerr << "vpDiskGrabber: reading after the last frame should fail" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpIoTools::remove(opath);
+
+    std::cout << "testVideoReaderPrefetch is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getStringMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,187 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Write an image sequence with asynchronous encoding threads.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testVideoWriterAsync.cpp
+  \brief Writes image sequences with vpVideoWriter in asynchronous mode and
+  checks the written frames, the drop policies and the error reporting.
+*/
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpVideoWriter.h>
+
+namespace
+{
+void createFrame(vpImage<unsigned char> &I, unsigned int k)
+{
+  I.resize(120, 160);
+  for (unsigned int i = 0; i < I.getHeight(); i++)
+    for (unsigned int j = 0; j < I.getWidth(); j++)
+      I[i][j] = (unsigned char)((k * 13 + i * j) % 256);
+}
+
+// Check the written frames and return their number
+bool checkSequence(const std::string &filename, unsigned int nb_frames, unsigned int &nb_written)
+{
+  vpImage<unsigned char> I, I_ref;
+  nb_written = 0;
+  for (unsigned int k = 0; k < nb_frames; k++) {
+    char name[FILENAME_MAX];
+    sprintf(name, filename.c_str(), k);
+    if (!vpIoTools::checkFilename(name))
+      continue;
+    vpImageIo::read(I, name);
+    createFrame(I_ref, k);
+    if (!(I_ref == I)) {
+      std::cerr << "Frame " << k << " is not the expected one" << std::endl;
+      return false;
+    }
+    vpIoTools::remove(name);
+    nb_written++;
+  }
+  return true;
+}
+
+bool testPolicy(const std::string &filename, unsigned int nb_threads, unsigned int queue_size,
+                vpVideoWriter::vpQueuePolicy policy)
+{
+  const unsigned int nb_frames = 60;
+  vpImage<unsigned char> I;
+  createFrame(I, 0);
+
+  vpVideoWriter writer;
+  writer.setFileName(filename);
+  writer.setCompression(75, vpImageIo::PNG_COMPRESSION_BEST);
+  writer.setAsync(nb_threads, queue_size, policy);
+  writer.open(I);
+  for (unsigned int k = 0; k < nb_frames; k++) {
+    createFrame(I, k);
+    writer.saveFrame(I);
+    if (writer.getQueueDepth() > queue_size) {
+      std::cerr << "Queue depth " << writer.getQueueDepth() << " exceeds the queue size" << std::endl;
+      return false;
+    }
+  }
+  writer.close();
+
+  // The last frame is never dropped when the oldest frames are
+  char last[FILENAME_MAX];
+  sprintf(last, filename.c_str(), nb_frames - 1);
+  if (policy == vpVideoWriter::QUEUE_DROP_OLDEST && !vpIoTools::checkFilename(last)) {
+    std::cerr << "The last frame was dropped" << std::endl;
+    return false;
+  }
+
+  unsigned int nb_written = 0;
+  if (!checkSequence(filename, nb_frames, nb_written))
+    return false;
+  std::cout << "Policy " << policy << ": " << nb_written << " frames written, " << writer.getDroppedFrames()
+            << " dropped, max queue depth " << writer.getMaxQueueDepth() << std::endl;
+
+  if (writer.getCurrentFrameIndex() != nb_frames || nb_written + writer.getDroppedFrames() != nb_frames ||
+      writer.getMaxQueueDepth() > queue_size || writer.getQueueDepth() != 0) {
+    std::cerr << "Bad frame counters" << std::endl;
+    return false;
+  }
+  if (policy == vpVideoWriter::QUEUE_BLOCK && writer.getDroppedFrames() != 0) {
+    std::cerr << "No frame should be dropped when blocking" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int main()
+{
+  try {
+#if defined(_WIN32)
+    std::string opath = "C:/temp";
+#else
+    std::string opath = "/tmp";
+#endif
+    std::string username;
+    vpIoTools::getUserName(username);
+    opath = vpIoTools::createFilePath(opath, username);
+    opath = vpIoTools::createFilePath(opath, "testVideoWriterAsync");
+    vpIoTools::makeDirectory(opath);
+
+    std::string filename = vpIoTools::createFilePath(opath, "image%04d.pgm");
+    if (!testPolicy(filename, 2, 4, vpVideoWriter::QUEUE_BLOCK) ||
+        !testPolicy(filename, 0, 4, vpVideoWriter::QUEUE_BLOCK)) {
+      return EXIT_FAILURE;
+    }
+#if defined(VISP_HAVE_PNG) || defined(VISP_HAVE_OPENCV)
+    filename = vpIoTools::createFilePath(opath, "image%04d.png");
+#endif
+    if (!testPolicy(filename, 1, 2, vpVideoWriter::QUEUE_DROP_OLDEST) ||
+        !testPolicy(filename, 1, 2, vpVideoWriter::QUEUE_DROP_NEWEST)) {
+      return EXIT_FAILURE;
+    }
+
+    // Writing in a missing directory is reported by saveFrame() or close()
+    vpImage<unsigned char> I;
+    createFrame(I, 0);
+    vpVideoWriter writer;
+    writer.setFileName(vpIoTools::createFilePath(opath, "missing/image%04d.pgm"));
+    writer.setAsync(1);
+    writer.open(I);
+    bool thrown = false;
+    try {
+      for (unsigned int k = 0; k < 10; k++)
+        writer.saveFrame(I);
+      writer.close();
+    } catch (const vpException &) {
+      thrown = true;
+    }
+    if (!thrown) {
+      std::cerr << "Writing in a missing directory should fail" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpIoTools::remove(opath);
+
+    std::cout << "testVideoWriterAsync is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getStringMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,219 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Exchange images and matrices as binary frames over the loopback.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testNetworkFrame.cpp
+  \brief Sends images, a matrix and raw bytes as binary frames from a client
+  thread to a server, and checks the received data, the poll based server
+  event loop and the skipping of unexpected frames.
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+
+#include <visp3/core/vpClient.h>
+#include <visp3/core/vpMutex.h>
+#include <visp3/core/vpServer.h>
+#include <visp3/core/vpThread.h>
+
+#if defined(VISP_HAVE_FUNC_INET_NTOP) && (defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0)))
+
+namespace
+{
+const int port = 35123;
+
+void createImages(vpImage<unsigned char> &I, vpImage<vpRGBa> &Ic, vpImage<float> &If, vpMatrix &M)
+{
+  I.resize(240, 320);
+  Ic.resize(120, 160);
+  If.resize(60, 80);
+  for (unsigned int i = 0; i < I.getHeight(); i++)
+    for (unsigned int j = 0; j < I.getWidth(); j++)
+      I[i][j] = (unsigned char)((i * 7 + j * 3) % 256);
+  for (unsigned int i = 0; i < Ic.getHeight(); i++)
+    for (unsigned int j = 0; j < Ic.getWidth(); j++)
+      Ic[i][j] = vpRGBa((unsigned char)i, (unsigned char)j, (unsigned char)(i + j), 255);
+  for (unsigned int i = 0; i < If.getHeight(); i++)
+    for (unsigned int j = 0; j < If.getWidth(); j++)
+      If[i][j] = i * 0.5f - j * 0.25f;
+
+  M.resize(4, 6);
+  for (unsigned int i = 0; i < M.getRows(); i++)
+    for (unsigned int j = 0; j < M.getCols(); j++)
+      M[i][j] = i * 10.0 + j / 3.0;
+}
+
+bool clientOk = false;
+
+vpThread::Return clientThread(vpThread::Args)
+{
+  vpClient client;
+  if (!client.connectToIP("127.0.0.1", port))
+    return 0;
+
+  vpImage<unsigned char> I;
+  vpImage<vpRGBa> Ic;
+  vpImage<float> If;
+  vpMatrix M;
+  createImages(I, Ic, If, M);
+
+  const char raw[] = "raw frame";
+  bool ok = client.sendImage(I) > 0 && client.sendImage(Ic) > 0 && client.sendImage(If) > 0 &&
+            client.sendMatrix(M) > 0 && client.sendFrame(raw, sizeof(raw)) > 0;
+
+  // The server sends a matrix, that is skipped, then the grey level image
+  vpImage<unsigned char> I_back;
+  client.setTimeoutSec(5);
+  ok = ok && client.receiveImage(I_back) == -1 && client.receiveImage(I_back) > 0 && I_back == I;
+
+  clientOk = ok;
+  return 0;
+}
+
+bool receive(vpServer &serv, vpImage<unsigned char> &I, vpImage<vpRGBa> &Ic, vpImage<float> &If, vpMatrix &M,
+             std::vector<unsigned char> &raw)
+{
+  std::vector<unsigned int> clients;
+  unsigned int nb_received = 0;
+  for (unsigned int k = 0; k < 100 && nb_received < 5; k++) {
+    if (serv.checkForEvents(clients) <= 0)
+      continue;
+
+    if (clients.size() != 1 || clients[0] != 0) {
+      std::cerr << "Unexpected client index" << std::endl;
+      return false;
+    }
+
+    int value = 0;
+    switch (nb_received) {
+    case 0:
+      value = serv.receiveImageFrom(I, 0);
+      break;
+    case 1:
+      value = serv.receiveImageFrom(Ic, 0);
+      break;
+    case 2:
+      value = serv.receiveImageFrom(If, 0);
+      break;
+    case 3:
+      value = serv.receiveMatrixFrom(M, 0);
+      break;
+    default:
+      value = serv.receiveFrameFrom(raw, 0);
+      break;
+    }
+
+    if (value <= 0) {
+      std::cerr << "Cannot receive frame " << nb_received << std::endl;
+      return false;
+    }
+    nb_received++;
+  }
+
+  return nb_received == 5;
+}
+}
+
+int main()
+{
+  try {
+    vpServer serv("127.0.0.1", port);
+    serv.setTimeoutSec(1);
+    if (!serv.start())
+      return EXIT_FAILURE;
+
+    vpThread *thread = new vpThread((vpThread::Fn)clientThread);
+
+    vpImage<unsigned char> I_ref, I;
+    vpImage<vpRGBa> Ic_ref, Ic;
+    vpImage<float> If_ref, If;
+    vpMatrix M_ref, M;
+    createImages(I_ref, Ic_ref, If_ref, M_ref);
+
+    // Already allocated destinations are reused
+    I.resize(I_ref.getHeight(), I_ref.getWidth());
+    unsigned char *bitmap = I.bitmap;
+
+    std::vector<unsigned char> raw;
+    bool ok = receive(serv, I, Ic, If, M, raw);
+
+    if (ok && I.bitmap != bitmap) {
+      std::cerr << "The image buffer has been reallocated" << std::endl;
+      ok = false;
+    }
+    if (ok && !(I == I_ref && Ic == Ic_ref && If == If_ref)) {
+      std::cerr << "Received images differ" << std::endl;
+      ok = false;
+    }
+    if (ok && !(M.getRows() == M_ref.getRows() && M.getCols() == M_ref.getCols() &&
+                std::equal(M.data, M.data + M.size(), M_ref.data))) {
+      std::cerr << "Received matrix differs" << std::endl;
+      ok = false;
+    }
+    if (ok && std::string((const char *)&raw[0]) != "raw frame") {
+      std::cerr << "Received raw frame differs" << std::endl;
+      ok = false;
+    }
+
+    // A frame of another type is skipped without desynchronizing the stream
+    if (ok && (serv.sendMatrixTo(M, 0) <= 0 || serv.sendImageTo(I, 0) <= 0)) {
+      std::cerr << "Cannot send the image back" << std::endl;
+      ok = false;
+    }
+
+    delete thread;
+
+    if (!ok || !clientOk) {
+      std::cerr << "testNetworkFrame failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "testNetworkFrame is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
+
+#else
+int main()
+{
+  std::cout << "This test requires inet_ntop() and threads" << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
@@ -0,0 +1,263 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Exchange images and point clouds through a shared memory ring.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testSharedMemoryRing.cpp
+  \brief Streams images from a producer process to a consumer process through
+  vpSharedMemoryRing, and checks the zero-copy views, the slot pinning and
+  the point cloud and depth frames.
+*/
+
+#include <iostream>
+#include <sstream>
+#include <stdlib.h>
+
+#include <visp3/core/vpSharedMemoryRing.h>
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+const unsigned int nb_frames = 50;
+
+void createFrame(vpImage<unsigned char> &I, unsigned int k)
+{
+  I.resize(240, 320, (unsigned char)(k % 256));
+}
+
+// Consumer process: check that each acquired frame is complete and that the
+// sequence numbers and timestamps increase.
+int consume(const std::string &name)
+{
+  vpSharedMemoryRing ring;
+  ring.open(name);
+
+  vpImage<unsigned char> I;
+  unsigned long long sequence = 0;
+  double timestamp = 0;
+  while (sequence < nb_frames) {
+    if (!ring.wait(sequence, 5000)) {
+      std::cerr << "Timeout after frame " << sequence << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    unsigned long long previous_sequence = sequence;
+    double previous_timestamp = timestamp;
+    if (!ring.acquire(I, sequence, timestamp)) {
+      std::cerr << "Cannot acquire a frame" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (sequence <= previous_sequence || timestamp < previous_timestamp || I.getWidth() != 320 ||
+        I.getHeight() != 240) {
+      std::cerr << "Bad frame " << sequence << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    unsigned char value = (unsigned char)(timestamp);
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      if (I.bitmap[i] != value) {
+        std::cerr << "Frame " << sequence << " overwritten while acquired" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+bool testProcesses(const std::string &name)
+{
+  vpSharedMemoryRing producer;
+  producer.create(name, 3, 320 * 240);
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    int res = EXIT_FAILURE;
+    try {
+      res = consume(name);
+    } catch (vpException &e) {
+      std::cerr << "Consumer: " << e.getStringMessage() << std::endl;
+    }
+    _exit(res);
+  }
+
+  vpImage<unsigned char> I;
+  for (unsigned int k = 1; k <= nb_frames; k++) {
+    createFrame(I, k);
+    // The timestamp carries the pixel value to check the frame content
+    producer.write(I, (double)k);
+    vpTime::sleepMs(2);
+  }
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+    std::cerr << "The consumer process failed" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool testPinning(const std::string &name)
+{
+  vpSharedMemoryRing producer, consumer;
+  producer.create(name, 2, 320 * 240);
+  consumer.open(name);
+
+  vpImage<unsigned char> I, view;
+  unsigned long long sequence;
+  double timestamp;
+  if (consumer.acquire(view, sequence, timestamp)) {
+    std::cerr << "A frame is acquired from an empty ring" << std::endl;
+    return false;
+  }
+
+  createFrame(I, 1);
+  producer.write(I);
+  if (!consumer.acquire(view, sequence, timestamp) || sequence != 1 || view.bitmap == I.bitmap) {
+    std::cerr << "Cannot acquire the first frame" << std::endl;
+    return false;
+  }
+
+  // The acquired slot and the last published one can't be overwritten
+  createFrame(I, 2);
+  bool written = producer.write(I);
+  createFrame(I, 3);
+  bool dropped = !producer.write(I);
+  if (!written || !dropped || producer.getDroppedFrames() != 1 || view[0][0] != 1 || consumer.getSequence() != 2) {
+    std::cerr << "Acquired slot has been overwritten" << std::endl;
+    return false;
+  }
+
+  consumer.release();
+  createFrame(I, 4);
+  if (!producer.write(I) || !consumer.acquire(view, sequence, timestamp) || sequence != 3 || view[0][0] != 4) {
+    std::cerr << "Released slot has not been reused" << std::endl;
+    return false;
+  }
+
+  // Type mismatch
+  vpImage<float> If;
+  if (consumer.acquire(If, sequence, timestamp)) {
+    std::cerr << "Grey level frame acquired as a float image" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool testDepthAndPointCloud(const std::string &name)
+{
+  vpSharedMemoryRing producer, consumer;
+  producer.create(name, 4, 640 * 480 * sizeof(uint16_t));
+  consumer.open(name);
+
+  vpImage<uint16_t> depth(480, 640), depth_view;
+  for (unsigned int i = 0; i < depth.getSize(); i++)
+    depth.bitmap[i] = (uint16_t)(i * 7);
+
+  unsigned long long sequence;
+  double timestamp;
+  producer.write(depth, 12.5);
+  if (!consumer.acquire(depth_view, sequence, timestamp) || !(depth_view == depth) || timestamp != 12.5) {
+    std::cerr << "Bad depth frame" << std::endl;
+    return false;
+  }
+
+  std::vector<vpColVector> pointcloud(1000, vpColVector(4, 1.));
+  for (size_t i = 0; i < pointcloud.size(); i++) {
+    pointcloud[i][0] = i * 0.5;
+    pointcloud[i][1] = -(double)i;
+    pointcloud[i][2] = 2.;
+  }
+  producer.writePointCloud(pointcloud);
+
+  vpImage<float> points;
+  if (!consumer.acquirePointCloud(points, sequence, timestamp) || points.getHeight() != pointcloud.size() ||
+      points.getWidth() != 3 || sequence != 2) {
+    std::cerr << "Bad point cloud frame" << std::endl;
+    return false;
+  }
+  for (unsigned int i = 0; i < points.getHeight(); i++) {
+    if (points[i][0] != (float)(i * 0.5) || points[i][1] != -(float)i || points[i][2] != 2.f) {
+      std::cerr << "Bad point " << i << std::endl;
+      return false;
+    }
+  }
+
+  // Frames larger than a slot are rejected
+  vpImage<vpRGBa> Ic(480, 640);
+  try {
+    producer.write(Ic);
+    std::cerr << "A frame larger than a slot has been written" << std::endl;
+    return false;
+  } catch (vpException &e) {
+    if (e.getCode() != vpException::dimensionError)
+      throw;
+  }
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    std::stringstream ss;
+    ss << "/visp_testSharedMemoryRing_" << getpid();
+    std::string name = ss.str();
+
+    if (!testProcesses(name) || !testPinning(name) || !testDepthAndPointCloud(name)) {
+      std::cerr << "testSharedMemoryRing failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "testSharedMemoryRing is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
+
+#else
+int main()
+{
+  std::cout << "vpSharedMemoryRing requires POSIX shared memory" << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
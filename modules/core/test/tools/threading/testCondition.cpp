@@ -0,0 +1,166 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test condition variables.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testCondition.cpp
+
+  \brief Test condition variables: a producer and a consumer exchanging values
+  through a bounded queue, and threads woken up together.
+*/
+
+#include <iostream>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+
+#include <deque>
+#include <vector>
+#include <stdlib.h>
+
+#include <visp3/core/vpCondition.h>
+#include <visp3/core/vpThread.h>
+
+namespace
+{
+const unsigned int nbValues = 10000;
+const size_t queueSize = 4;
+
+struct Queue {
+  Queue() : mutex(), notEmpty(), notFull(), values(), received(0), inOrder(true) {}
+
+  vpMutex mutex;
+  vpCondition notEmpty;
+  vpCondition notFull;
+  std::deque<unsigned int> values;
+  unsigned int received;
+  bool inOrder;
+};
+
+vpThread::Return consumer(vpThread::Args args)
+{
+  Queue *queue = static_cast<Queue *>(args);
+  vpMutex::vpScopedLock lock(queue->mutex);
+  while (queue->received < nbValues) {
+    while (queue->values.empty())
+      queue->notEmpty.wait(queue->mutex);
+    if (queue->values.front() != queue->received)
+      queue->inOrder = false;
+    queue->values.pop_front();
+    queue->received++;
+    queue->notFull.notifyOne();
+  }
+  return 0;
+}
+
+struct Barrier {
+  Barrier() : mutex(), cond(), waiting(0), open(false), woken(0) {}
+
+  vpMutex mutex;
+  vpCondition cond;
+  unsigned int waiting;
+  bool open;
+  unsigned int woken;
+};
+
+vpThread::Return waiter(vpThread::Args args)
+{
+  Barrier *barrier = static_cast<Barrier *>(args);
+  vpMutex::vpScopedLock lock(barrier->mutex);
+  barrier->waiting++;
+  barrier->cond.notifyAll();
+  while (!barrier->open)
+    barrier->cond.wait(barrier->mutex);
+  barrier->woken++;
+  return 0;
+}
+}
+
+int main()
+{
+  // Producer and consumer
+  Queue queue;
+  {
+    vpThread thread((vpThread::Fn)consumer, (vpThread::Args)&queue);
+    for (unsigned int i = 0; i < nbValues; i++) {
+      vpMutex::vpScopedLock lock(queue.mutex);
+      while (queue.values.size() >= queueSize)
+        queue.notFull.wait(queue.mutex);
+      queue.values.push_back(i);
+      queue.notEmpty.notifyOne();
+    }
+  } // join
+  if (queue.received != nbValues || !queue.inOrder) {
+    std::cerr << "The consumer received " << queue.received << " values"
+              << (queue.inOrder ? "" : " out of order") << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // All the waiting threads are woken up
+  const unsigned int nbThreads = 4;
+  Barrier barrier;
+  {
+    std::vector<vpThread *> threads(nbThreads);
+    for (unsigned int i = 0; i < nbThreads; i++)
+      threads[i] = new vpThread((vpThread::Fn)waiter, (vpThread::Args)&barrier);
+    {
+      vpMutex::vpScopedLock lock(barrier.mutex);
+      while (barrier.waiting < nbThreads)
+        barrier.cond.wait(barrier.mutex);
+      barrier.open = true;
+      barrier.cond.notifyAll();
+    }
+    for (unsigned int i = 0; i < nbThreads; i++)
+      delete threads[i]; // join
+  }
+  if (barrier.woken != nbThreads) {
+    std::cerr << barrier.woken << " threads woken up instead of " << nbThreads << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testCondition is ok" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+#else
+int main()
+{
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  std::cout << "You should enable pthread usage and rebuild ViSP..." << std::endl;
+#else
+  std::cout << "Multi-threading seems not supported on this platform" << std::endl;
+#endif
+}
+#endif
@@ -0,0 +1,264 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test camera parameters parsing and cache of the xml parsers.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testXmlParserCamera.cpp
+
+  Test vpXmlParserCamera with several cameras in the same file and the cache
+  of the parsed values enabled with vpXmlParser::setCacheDirectory().
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+
+#if defined(VISP_HAVE_XML2)
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpXmlParserCamera.h>
+
+namespace
+{
+class vpCachedDataParser : public vpXmlParser
+{
+public:
+  int m_step;
+  double m_range;
+
+  typedef enum { config, step, range } dataToParse;
+
+  vpCachedDataParser() : m_step(0), m_range(0.)
+  {
+    nodeMap["config"] = config;
+    nodeMap["step"] = step;
+    nodeMap["range"] = range;
+  }
+
+protected:
+  virtual void readMainClass(xmlDocPtr doc, xmlNodePtr node)
+  {
+    for (xmlNodePtr dataNode = node->xmlChildrenNode; dataNode != NULL; dataNode = dataNode->next) {
+      if (dataNode->type == XML_ELEMENT_NODE) {
+        std::map<std::string, int>::iterator iter_data = nodeMap.find((char *)dataNode->name);
+        if (iter_data != nodeMap.end() && iter_data->second == step) {
+          m_step = xmlReadIntChild(doc, dataNode);
+        } else if (iter_data != nodeMap.end() && iter_data->second == range) {
+          m_range = xmlReadDoubleChild(doc, dataNode);
+        }
+      }
+    }
+  }
+
+  virtual void writeMainClass(xmlNodePtr node)
+  {
+    xmlWriteIntChild(node, "step", m_step);
+    xmlWriteDoubleChild(node, "range", m_range);
+  }
+
+  virtual bool readCacheData(std::istream &is) { return readCacheValue(is, m_step) && readCacheValue(is, m_range); }
+
+  virtual bool writeCacheData(std::ostream &os) const
+  {
+    writeCacheValue(os, m_step);
+    writeCacheValue(os, m_range);
+    return true;
+  }
+};
+
+bool equal(const vpCameraParameters &cam1, const vpCameraParameters &cam2)
+{
+  return cam1.get_projModel() == cam2.get_projModel() && vpMath::equal(cam1.get_px(), cam2.get_px(), 1e-6) &&
+         vpMath::equal(cam1.get_py(), cam2.get_py(), 1e-6) && vpMath::equal(cam1.get_u0(), cam2.get_u0(), 1e-6) &&
+         vpMath::equal(cam1.get_v0(), cam2.get_v0(), 1e-6) && vpMath::equal(cam1.get_kud(), cam2.get_kud(), 1e-6) &&
+         vpMath::equal(cam1.get_kdu(), cam2.get_kdu(), 1e-6);
+}
+
+unsigned int countCacheEntries(const std::string &dirname)
+{
+  std::vector<std::string> files = vpIoTools::getDirFiles(dirname);
+  unsigned int nb = 0;
+  for (size_t i = 0; i < files.size(); i++) {
+    if (vpIoTools::getFileExtension(files[i]) == ".xmlcache") {
+      nb++;
+    }
+  }
+  return nb;
+}
+
+bool testCamera(const std::string &filename, const std::string &cache_dirname)
+{
+  vpCameraParameters cam1, cam2, cam;
+  cam1.initPersProjWithoutDistortion(600.5, 601.5, 320.5, 240.5);
+  cam2.initPersProjWithDistortion(300.5, 301.5, 160.5, 120.5, -0.1, 0.1);
+
+  if (vpIoTools::checkFilename(filename)) {
+    vpIoTools::remove(filename);
+  }
+  {
+    vpXmlParserCamera p;
+    if (p.save(cam1, filename, "cam1", 640, 480) != vpXmlParserCamera::SEQUENCE_OK ||
+        p.save(cam2, filename, "cam2", 320, 240) != vpXmlParserCamera::SEQUENCE_OK) {
+      std::cerr << "Cannot save camera parameters in " << filename << std::endl;
+      return false;
+    }
+  }
+
+  for (int iter = 0; iter < 2; iter++) {
+    vpXmlParserCamera p;
+    p.setCacheDirectory(iter == 0 ? "" : cache_dirname);
+    for (int repeat = 0; repeat < 2; repeat++) {
+      if (p.parse(cam, filename, "cam2", vpCameraParameters::perspectiveProjWithDistortion, 320, 240) !=
+              vpXmlParserCamera::SEQUENCE_OK ||
+          !equal(cam, cam2) || p.getCameraName() != "cam2" || p.getWidth() != 320 || p.getHeight() != 240) {
+        std::cerr << "Cannot read cam2 (cache: " << p.getCacheDirectory() << ")" << std::endl;
+        return false;
+      }
+      if (p.parse(cam, filename, "cam1", vpCameraParameters::perspectiveProjWithoutDistortion) !=
+              vpXmlParserCamera::SEQUENCE_OK ||
+          !equal(cam, cam1) || p.getCameraName() != "cam1" || p.getWidth() != 640) {
+        std::cerr << "Cannot read cam1 (cache: " << p.getCacheDirectory() << ")" << std::endl;
+        return false;
+      }
+      if (p.parse(cam, filename, "cam3", vpCameraParameters::perspectiveProjWithoutDistortion) !=
+          vpXmlParserCamera::SEQUENCE_ERROR) {
+        std::cerr << "cam3 should not be found" << std::endl;
+        return false;
+      }
+    }
+  }
+
+  // Only the successful requests are cached
+  if (countCacheEntries(cache_dirname) != 2) {
+    std::cerr << "Unexpected number of cache entries: " << countCacheEntries(cache_dirname) << std::endl;
+    return false;
+  }
+
+  // A modified file should not use the previous entries
+  vpCameraParameters cam4;
+  cam4.initPersProjWithoutDistortion(800., 800., 400., 300.);
+  {
+    vpXmlParserCamera p;
+    p.save(cam4, filename, "cam4", 800, 600);
+    p.setCacheDirectory(cache_dirname);
+    if (p.parse(cam, filename, "cam4", vpCameraParameters::perspectiveProjWithoutDistortion) !=
+            vpXmlParserCamera::SEQUENCE_OK ||
+        !equal(cam, cam4) ||
+        p.parse(cam, filename, "cam1", vpCameraParameters::perspectiveProjWithoutDistortion) !=
+            vpXmlParserCamera::SEQUENCE_OK ||
+        !equal(cam, cam1)) {
+      std::cerr << "Cannot read the modified file" << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool testParser(const std::string &filename, const std::string &cache_dirname)
+{
+  {
+    // File without range
+    std::ofstream file(filename.c_str());
+    file << "<?xml version=\"1.0\"?>\n<config>\n  <step>7</step>\n</config>\n";
+  }
+
+  for (int repeat = 0; repeat < 2; repeat++) {
+    vpCachedDataParser p;
+    p.setCacheDirectory(cache_dirname);
+    p.m_range = 1.5;
+    p.parse(filename);
+    if (p.m_step != 7 || !vpMath::equal(p.m_range, 1.5)) {
+      std::cerr << "Bad values: " << p.m_step << " " << p.m_range << std::endl;
+      return false;
+    }
+
+    // The initial value of range is part of the cache key
+    vpCachedDataParser p2;
+    p2.setCacheDirectory(cache_dirname);
+    p2.m_range = 2.5;
+    p2.parse(filename);
+    if (p2.m_step != 7 || !vpMath::equal(p2.m_range, 2.5)) {
+      std::cerr << "Bad values: " << p2.m_step << " " << p2.m_range << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+}
+
+int main()
+{
+  try {
+#if defined(_WIN32)
+    std::string opath = "C:\\temp";
+#else
+    std::string opath = "/tmp";
+#endif
+    std::string dirname = vpIoTools::createFilePath(opath, "testXmlParserCamera_" + vpIoTools::getUserName());
+    std::string cache_dirname = vpIoTools::createFilePath(dirname, "cache");
+    if (vpIoTools::checkDirectory(dirname)) {
+      vpIoTools::remove(dirname);
+    }
+    vpIoTools::makeDirectory(dirname);
+
+    bool ok = testCamera(vpIoTools::createFilePath(dirname, "camera.xml"), cache_dirname) &&
+              testParser(vpIoTools::createFilePath(dirname, "config.xml"), cache_dirname);
+
+    vpIoTools::remove(dirname);
+    vpXmlParser::cleanup();
+
+    if (!ok) {
+      return EXIT_FAILURE;
+    }
+  } catch (vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testXmlParserCamera is ok" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+#else
+int main()
+{
+  std::cout << "Xml parser requires libxml2." << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
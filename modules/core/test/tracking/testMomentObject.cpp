@@ -0,0 +1,150 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test image moments computation.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMomentObject.cpp
+  \brief Compares the basic moments computed from a binary image and from a
+  label image to a per pixel reference implementation.
+*/
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpMomentObject.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+
+#include <iostream>
+#include <stdlib.h>
+
+namespace
+{
+// Moments computed pixel by pixel
+void referenceMoments(const vpImage<unsigned char> &I, unsigned char threshold, const vpCameraParameters &cam,
+                      unsigned int order, std::vector<double> &values)
+{
+  values.assign(order * order, 0.);
+  for (unsigned int j = 0; j < I.getHeight(); j++) {
+    for (unsigned int i = 0; i < I.getWidth(); i++) {
+      if (I[j][i] > threshold) {
+        double x = 0, y = 0;
+        vpPixelMeterConversion::convertPoint(cam, i, j, x, y);
+        for (unsigned int k = 0; k < order; k++) {
+          for (unsigned int l = 0; l < order - k; l++) {
+            values[k * order + l] += pow(x, (int)l) * pow(y, (int)k);
+          }
+        }
+      }
+    }
+  }
+  for (size_t k = 0; k < values.size(); k++) {
+    values[k] /= cam.get_px() * cam.get_py();
+  }
+}
+
+bool compare(const std::vector<double> &values, const std::vector<double> &ref, const std::string &name)
+{
+  for (size_t k = 0; k < ref.size(); k++) {
+    if (std::fabs(values[k] - ref[k]) > 1e-9 * std::max(1., std::fabs(ref[k]))) {
+      std::cerr << name << ": moment " << k << " differs: " << values[k] << " vs " << ref[k] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    unsigned int h = 121, w = 163, order = 5;
+    vpImage<unsigned char> I(h, w, 0);
+    vpImage<int> labels(h, w, 0);
+    // Two ellipses and a rectangle on a gradient background
+    for (unsigned int j = 0; j < h; j++) {
+      for (unsigned int i = 0; i < w; i++) {
+        I[j][i] = (unsigned char)((i + j) % 100);
+        double e1 = vpMath::sqr((i - 50.) / 30.) + vpMath::sqr((j - 40.) / 20.);
+        double e2 = vpMath::sqr((i - 120.) / 25.) + vpMath::sqr((j - 80.) / 35.);
+        if (e1 < 1.) {
+          I[j][i] = 200;
+          labels[j][i] = 1;
+        } else if (e2 < 1.) {
+          I[j][i] = 255;
+          labels[j][i] = 2;
+        } else if (i >= 10 && i < 30 && j >= 90 && j < 115) {
+          I[j][i] = 130;
+          labels[j][i] = 3;
+        }
+      }
+    }
+
+    vpCameraParameters cam(600., 580., w / 2. + 3., h / 2. - 2.);
+    vpCameraParameters cam_dist(600., 580., w / 2. + 3., h / 2. - 2., -0.2, 0.2);
+    const unsigned char threshold = 127;
+
+    for (int model = 0; model < 2; model++) {
+      const vpCameraParameters &c = (model == 0 ? cam : cam_dist);
+      std::string name = (model == 0 ? "without distortion" : "with distortion");
+
+      vpMomentObject obj(order);
+      obj.setType(vpMomentObject::DENSE_FULL_OBJECT);
+      obj.fromImage(I, threshold, c);
+      std::vector<double> ref;
+      // Moments up to order 5 are stored in a 6 x 6 array
+      referenceMoments(I, threshold, c, order + 1, ref);
+      if (!compare(obj.get(), ref, "fromImage " + name)) {
+        return EXIT_FAILURE;
+      }
+
+      // One pass over the label image, each object compared to its own mask
+      std::vector<vpMomentObject> objects(2, vpMomentObject(order));
+      vpMomentObject::fromLabels(labels, c, objects);
+      for (int n = 0; n < 2; n++) {
+        vpImage<unsigned char> mask(h, w, 0);
+        for (unsigned int k = 0; k < h * w; k++) {
+          mask.bitmap[k] = (labels.bitmap[k] == n + 1) ? 255 : 0;
+        }
+        referenceMoments(mask, 0, c, order + 1, ref);
+        if (!compare(objects[(size_t)n].get(), ref, "fromLabels " + name)) {
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    std::cout << "testMomentObject is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
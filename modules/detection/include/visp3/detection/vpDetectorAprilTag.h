@@ -65,7 +65,8 @@ using getBBox() and the center of gravity using getCog().
   detect(const vpImage<unsigned char> &, const double, const
 vpCameraParameters &, std::vector<vpHomogeneousMatrix> &) this class allows
 also to estimate the 3D pose of the tag in terms of position and orientation
-wrt the camera.
+wrt the camera. The poses of the detected tags are estimated in parallel,
+using the number of threads set with setAprilTagNbThreads().
 
   The following sample code shows how to use this class to detect the location
 of 36h11 AprilTag patterns in an image.
@@ -157,6 +158,12 @@ Tag number 1:
   Tag Id: 1
 \endcode
 
+  When processing a video stream where tags move little between frames, the
+  tracking mode enabled with setAprilTagTracking() runs the detection only
+  in regions of interest around the locations predicted from the previous
+  detections, and falls back to a full image search periodically or when a
+  tag is lost.
+
   Other examples are also provided in tutorial-apriltag-detector.cpp and
   tutorial-apriltag-detector-live.cpp
 */
@@ -194,7 +201,9 @@ public:
                                 initialized by the Lagrange approach */
     BEST_RESIDUAL_VIRTUAL_VS /*!< Non linear virtual visual servoing approach
                                 initialized by the approach that gives the
-                                lowest residual */
+                                lowest residual between the homography and
+                                the two solutions of the Infinitesimal
+                                Plane-based Pose Estimation (IPPE) */
   };
 
   vpDetectorAprilTag(const vpAprilTagFamily &tagFamily = TAG_36h11,
@@ -217,6 +226,8 @@ public:
   void setAprilTagRefineDecode(const bool refineDecode);
   void setAprilTagRefineEdges(const bool refineEdges);
   void setAprilTagRefinePose(const bool refinePose);
+  void setAprilTagTracking(const bool tracking, const unsigned int fullSearchPeriod = 10);
+  void setAprilTagTrackingRoiMargin(const double margin);
 
   /*! Allow to enable the display of overlay tag information in the windows
    * (vpDisplay) associated to the input image. */
@@ -35,7 +35,11 @@
 #include <visp3/core/vpConfig.h>
 
 #ifdef VISP_HAVE_APRILTAG
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <map>
+#include <string.h>
 
 #include <apriltag.h>
 #include <common/homography.h>
@@ -52,13 +56,244 @@
 #include <visp3/detection/vpDetectorAprilTag.h>
 #include <visp3/vision/vpPose.h>
 
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
+#endif
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/*!
+  Sum of the squared reprojection errors, in normalized coordinates, of the
+  planar points (X, Y, 0) observed in (x, y). Same value as
+  vpPose::computeResidual().
+*/
+double computePlanarResidual(const vpHomogeneousMatrix &cMo, const double X[4], const double Y[4], const double x[4],
+                             const double y[4])
+{
+  double residual = 0.0;
+  for (int i = 0; i < 4; i++) {
+    double cX = cMo[0][0] * X[i] + cMo[0][1] * Y[i] + cMo[0][3];
+    double cY = cMo[1][0] * X[i] + cMo[1][1] * Y[i] + cMo[1][3];
+    double cZ = cMo[2][0] * X[i] + cMo[2][1] * Y[i] + cMo[2][3];
+    residual += vpMath::sqr(x[i] - cX / cZ) + vpMath::sqr(y[i] - cY / cZ);
+  }
+  return residual;
+}
+
+/*!
+  Homography H, normalized such as H[2][2] = 1, that maps the planar points
+  (X, Y) to the image points (x, y). The 8x8 linear system is solved by
+  Gaussian elimination with partial pivoting.
+*/
+bool computePlanarHomography(const double X[4], const double Y[4], const double x[4], const double y[4],
+                             double H[3][3])
+{
+  double A[8][9];
+  for (int i = 0; i < 4; i++) {
+    double *r1 = A[2 * i], *r2 = A[2 * i + 1];
+    r1[0] = X[i];
+    r1[1] = Y[i];
+    r1[2] = 1.0;
+    r1[3] = 0.0;
+    r1[4] = 0.0;
+    r1[5] = 0.0;
+    r1[6] = -X[i] * x[i];
+    r1[7] = -Y[i] * x[i];
+    r1[8] = x[i];
+    r2[0] = 0.0;
+    r2[1] = 0.0;
+    r2[2] = 0.0;
+    r2[3] = X[i];
+    r2[4] = Y[i];
+    r2[5] = 1.0;
+    r2[6] = -X[i] * y[i];
+    r2[7] = -Y[i] * y[i];
+    r2[8] = y[i];
+  }
+
+  for (int c = 0; c < 8; c++) {
+    int pivot = c;
+    for (int r = c + 1; r < 8; r++) {
+      if (std::fabs(A[r][c]) > std::fabs(A[pivot][c])) {
+        pivot = r;
+      }
+    }
+    if (std::fabs(A[pivot][c]) < std::numeric_limits<double>::epsilon()) {
+      return false;
+    }
+    if (pivot != c) {
+      for (int k = c; k < 9; k++) {
+        std::swap(A[c][k], A[pivot][k]);
+      }
+    }
+    for (int r = c + 1; r < 8; r++) {
+      double f = A[r][c] / A[c][c];
+      for (int k = c; k < 9; k++) {
+        A[r][k] -= f * A[c][k];
+      }
+    }
+  }
+
+  double h[8];
+  for (int c = 7; c >= 0; c--) {
+    double sum = A[c][8];
+    for (int k = c + 1; k < 8; k++) {
+      sum -= A[c][k] * h[k];
+    }
+    h[c] = sum / A[c][c];
+  }
+
+  for (int i = 0; i < 8; i++) {
+    H[i / 3][i % 3] = h[i];
+  }
+  H[2][2] = 1.0;
+  return true;
+}
+
+/*!
+  Least squares translation of the pose with rotation R, given the planar
+  points (X, Y, 0) observed in (x, y).
+*/
+bool computePlanarTranslation(const double R[3][3], const double X[4], const double Y[4], const double x[4],
+                              const double y[4], double t[3])
+{
+  // Normal equations of x_i (R P_i + t)_z = (R P_i + t)_x, same for y_i
+  double N[3][3] = {{0., 0., 0.}, {0., 0., 0.}, {0., 0., 0.}};
+  double b[3] = {0., 0., 0.};
+  for (int i = 0; i < 4; i++) {
+    double P[3];
+    for (int j = 0; j < 3; j++) {
+      P[j] = R[j][0] * X[i] + R[j][1] * Y[i];
+    }
+    double a1[3] = {1.0, 0.0, -x[i]}, a2[3] = {0.0, 1.0, -y[i]};
+    double b1 = x[i] * P[2] - P[0], b2 = y[i] * P[2] - P[1];
+    for (int j = 0; j < 3; j++) {
+      for (int k = 0; k < 3; k++) {
+        N[j][k] += a1[j] * a1[k] + a2[j] * a2[k];
+      }
+      b[j] += a1[j] * b1 + a2[j] * b2;
+    }
+  }
+
+  double det = N[0][0] * (N[1][1] * N[2][2] - N[1][2] * N[2][1]) - N[0][1] * (N[1][0] * N[2][2] - N[1][2] * N[2][0]) +
+               N[0][2] * (N[1][0] * N[2][1] - N[1][1] * N[2][0]);
+  if (std::fabs(det) < std::numeric_limits<double>::epsilon()) {
+    return false;
+  }
+  // Cramer's rule
+  for (int j = 0; j < 3; j++) {
+    double M[3][3];
+    for (int r = 0; r < 3; r++) {
+      for (int c = 0; c < 3; c++) {
+        M[r][c] = (c == j) ? b[r] : N[r][c];
+      }
+    }
+    t[j] = (M[0][0] * (M[1][1] * M[2][2] - M[1][2] * M[2][1]) - M[0][1] * (M[1][0] * M[2][2] - M[1][2] * M[2][0]) +
+            M[0][2] * (M[1][0] * M[2][1] - M[1][1] * M[2][0])) /
+           det;
+  }
+  return true;
+}
+
+/*!
+  Infinitesimal Plane-based Pose Estimation (IPPE) of the planar points
+  (X, Y, 0), centered on the object frame origin, observed in (x, y).
+
+  The rotation is recovered from the Jacobian of the homography at the
+  origin, which leads to two solutions corresponding to the well known
+  planar pose ambiguity. Both are returned in cMo.
+
+  See T. Collins and A. Bartoli, "Infinitesimal Plane-Based Pose Estimation",
+  International Journal of Computer Vision, 2014.
+*/
+bool computePlanarPoseIPPE(const double X[4], const double Y[4], const double x[4], const double y[4],
+                           vpHomogeneousMatrix cMo[2])
+{
+  double H[3][3];
+  if (!computePlanarHomography(X, Y, x, y, H)) {
+    return false;
+  }
+
+  // Image of the origin and Jacobian of the homography at the origin
+  double p = H[0][2], q = H[1][2];
+  double J00 = H[0][0] - H[2][0] * p, J01 = H[0][1] - H[2][1] * p;
+  double J10 = H[1][0] - H[2][0] * q, J11 = H[1][1] - H[2][1] * q;
+
+  // Rotation Rv that brings the z axis onto the line of sight of the origin
+  double n = std::sqrt(p * p + q * q + 1.0);
+  double ax = p / n, ay = q / n, az = 1.0 / n;
+  double d = 1.0 / (1.0 + az);
+  double Rv[3][3] = {{1.0 - ax * ax * d, -ax * ay * d, ax},
+                     {-ax * ay * d, 1.0 - ay * ay * d, ay},
+                     {-ax, -ay, 1.0 - (ax * ax + ay * ay) * d}};
+
+  // A = B^-1 J is, up to scale, the upper left 2x2 block of Rv^T R
+  double B00 = Rv[0][0] - p * Rv[2][0], B01 = Rv[0][1] - p * Rv[2][1];
+  double B10 = Rv[1][0] - q * Rv[2][0], B11 = Rv[1][1] - q * Rv[2][1];
+  double det = B00 * B11 - B01 * B10;
+  if (std::fabs(det) < std::numeric_limits<double>::epsilon()) {
+    return false;
+  }
+  double A00 = (B11 * J00 - B01 * J10) / det, A01 = (B11 * J01 - B01 * J11) / det;
+  double A10 = (B00 * J10 - B10 * J00) / det, A11 = (B00 * J11 - B10 * J01) / det;
+
+  // The scale is the largest singular value of A
+  double S00 = A00 * A00 + A01 * A01, S01 = A00 * A10 + A01 * A11, S11 = A10 * A10 + A11 * A11;
+  double gamma = std::sqrt(0.5 * (S00 + S11 + std::sqrt((S00 - S11) * (S00 - S11) + 4.0 * S01 * S01)));
+  if (gamma < std::numeric_limits<float>::epsilon()) {
+    return false;
+  }
+  double r00 = A00 / gamma, r01 = A01 / gamma, r10 = A10 / gamma, r11 = A11 / gamma;
+
+  // Complete the first two columns to unit and orthogonal vectors
+  double b0 = std::sqrt((std::max)(0.0, 1.0 - r00 * r00 - r10 * r10));
+  double b1 = std::sqrt((std::max)(0.0, 1.0 - r01 * r01 - r11 * r11));
+  if (r00 * r01 + r10 * r11 > 0) {
+    b1 = -b1;
+  }
+
+  for (int s = 0; s < 2; s++) {
+    double sign = (s == 0) ? 1.0 : -1.0;
+    double c0[3] = {r00, r10, sign * b0}, c1[3] = {r01, r11, sign * b1};
+    double c2[3] = {c0[1] * c1[2] - c0[2] * c1[1], c0[2] * c1[0] - c0[0] * c1[2], c0[0] * c1[1] - c0[1] * c1[0]};
+
+    double R[3][3];
+    for (int i = 0; i < 3; i++) {
+      R[i][0] = Rv[i][0] * c0[0] + Rv[i][1] * c0[1] + Rv[i][2] * c0[2];
+      R[i][1] = Rv[i][0] * c1[0] + Rv[i][1] * c1[1] + Rv[i][2] * c1[2];
+      R[i][2] = Rv[i][0] * c2[0] + Rv[i][1] * c2[1] + Rv[i][2] * c2[2];
+    }
+
+    double t[3];
+    if (!computePlanarTranslation(R, X, Y, x, y, t)) {
+      return false;
+    }
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        cMo[s][i][j] = R[i][j];
+      }
+      cMo[s][i][3] = t[i];
+    }
+  }
+
+  return true;
+}
+}
+
 class vpDetectorAprilTag::Impl
 {
 public:
+  struct vpTrackedTag {
+    int id;
+    double p[4][2]; //!< Corners at the last detection
+    double v[4][2]; //!< Displacement of the corners between the two last detections
+  };
+
   Impl(const vpAprilTagFamily &tagFamily, const vpPoseEstimationMethod &method)
     : m_cam(), m_poseEstimationMethod(method), m_tagFamily(tagFamily), m_tagPoses(), m_tagSize(1.0), m_td(NULL),
-      m_tf(NULL)
+      m_tf(NULL), m_tracking(false), m_trackingFullSearchPeriod(10), m_trackingRoiMargin(0.5),
+      m_nbFramesSinceFullSearch(0), m_trackedTags(), m_roiDetectors()
   {
     switch (m_tagFamily) {
     case TAG_36h11:
@@ -99,6 +334,9 @@ public:
 
   ~Impl()
   {
+    for (size_t i = 0; i < m_roiDetectors.size(); i++) {
+      apriltag_detector_destroy(m_roiDetectors[i]);
+    }
     apriltag_detector_destroy(m_td);
 
     switch (m_tagFamily) {
@@ -137,21 +375,26 @@ public:
   {
     m_tagPoses.clear();
 
-    image_u8_t im = {/*.width =*/(int32_t)I.getWidth(),
-                     /*.height =*/(int32_t)I.getHeight(),
-                     /*.stride =*/(int32_t)I.getWidth(),
-                     /*.buf =*/I.bitmap};
+    std::vector<apriltag_detection_t *> detections;
+    if (!m_tracking || m_trackedTags.empty() || m_nbFramesSinceFullSearch + 1 >= m_trackingFullSearchPeriod ||
+        !detectInRois(I, detections)) {
+      detectFullImage(I, detections);
+    } else {
+      m_nbFramesSinceFullSearch++;
+    }
+
+    if (m_tracking) {
+      updateTrackedTags(detections);
+    }
 
-    zarray_t *detections = apriltag_detector_detect(m_td, &im);
-    int nb_detections = zarray_size(detections);
+    int nb_detections = (int)detections.size();
     bool detected = nb_detections > 0;
 
     polygons.resize((size_t)nb_detections);
     messages.resize((size_t)nb_detections);
 
-    for (int i = 0; i < zarray_size(detections); i++) {
-      apriltag_detection_t *det;
-      zarray_get(detections, i, &det);
+    for (int i = 0; i < nb_detections; i++) {
+      apriltag_detection_t *det = detections[(size_t)i];
 
       std::vector<vpImagePoint> polygon;
       for (int j = 0; j < 4; j++) {
@@ -177,109 +420,359 @@ public:
         vpDisplay::displayLine(I, (int)det->p[2][1], (int)det->p[2][0], (int)det->p[3][1], (int)det->p[3][0],
                                Oy2, thickness);
       }
+    }
 
-      if (computePose) {
-        vpHomogeneousMatrix cMo;
-        if (m_poseEstimationMethod == HOMOGRAPHY || m_poseEstimationMethod == HOMOGRAPHY_VIRTUAL_VS
-            || m_poseEstimationMethod == BEST_RESIDUAL_VIRTUAL_VS) {
-          double fx = m_cam.get_px(), fy = m_cam.get_py();
-          double cx = m_cam.get_u0(), cy = m_cam.get_v0();
+    bool pose_failed = false;
+    vpException pose_exception(vpException::fatalError, "Cannot compute tag pose");
+    if (computePose) {
+      // Poses are independent, estimate them in parallel
+      m_tagPoses.resize((size_t)nb_detections);
+#ifdef VISP_HAVE_OPENMP
+      int nb_workers = (std::max)(1, (std::min)(m_td->nthreads, nb_detections));
+#pragma omp parallel for schedule(dynamic) num_threads(nb_workers)
+#endif
+      for (int i = 0; i < nb_detections; i++) {
+        try {
+          getPose(detections[(size_t)i], m_tagPoses[(size_t)i]);
+        } catch (const vpException &e) {
+#ifdef VISP_HAVE_OPENMP
+#pragma omp critical(vpDetectorAprilTag_pose)
+#endif
+          {
+            pose_failed = true;
+            pose_exception = e;
+          }
+        }
+      }
+    }
 
-          matd_t *M = homography_to_pose(det->H, fx, fy, cx, cy, m_tagSize / 2);
+    // The zarrays were already destroyed by appendDetections(), release the
+    // detections before reporting a pose failure
+    for (size_t i = 0; i < detections.size(); i++) {
+      apriltag_detection_destroy(detections[i]);
+    }
 
-          for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-              cMo[i][j] = MATD_EL(M, i, j);
-            }
-            cMo[i][3] = MATD_EL(M, i, 3);
-          }
+    if (pose_failed) {
+      throw pose_exception;
+    }
+
+    return detected;
+  }
 
-          matd_destroy(M);
+  /*!
+    Estimate the pose of a detected tag. Only relies on local variables, so
+    that it can be called concurrently for different tags.
+  */
+  void getPose(const apriltag_detection_t *det, vpHomogeneousMatrix &cMo) const
+  {
+    cMo.eye();
+    if (m_poseEstimationMethod == HOMOGRAPHY || m_poseEstimationMethod == HOMOGRAPHY_VIRTUAL_VS ||
+        m_poseEstimationMethod == BEST_RESIDUAL_VIRTUAL_VS) {
+      double fx = m_cam.get_px(), fy = m_cam.get_py();
+      double cx = m_cam.get_u0(), cy = m_cam.get_v0();
+
+      matd_t *M = homography_to_pose(det->H, fx, fy, cx, cy, m_tagSize / 2);
+
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+          cMo[i][j] = MATD_EL(M, i, j);
         }
+        cMo[i][3] = MATD_EL(M, i, 3);
+      }
 
-        // Add marker object points
-        vpPose pose;
-        if (m_poseEstimationMethod != HOMOGRAPHY) {
-          vpPoint pt;
-
-          vpImagePoint imPt;
-          double x = 0.0, y = 0.0;
-          std::vector<vpPoint> pts(4);
-          pt.setWorldCoordinates(-m_tagSize / 2.0, -m_tagSize / 2.0, 0.0);
-          imPt.set_uv(det->p[0][0], det->p[0][1]);
-          vpPixelMeterConversion::convertPoint(m_cam, imPt, x, y);
-          pt.set_x(x);
-          pt.set_y(y);
-          pts[0] = pt;
-
-          pt.setWorldCoordinates(m_tagSize / 2.0, -m_tagSize / 2.0, 0.0);
-          imPt.set_uv(det->p[1][0], det->p[1][1]);
-          vpPixelMeterConversion::convertPoint(m_cam, imPt, x, y);
-          pt.set_x(x);
-          pt.set_y(y);
-          pts[1] = pt;
-
-          pt.setWorldCoordinates(m_tagSize / 2.0, m_tagSize / 2.0, 0.0);
-          imPt.set_uv(det->p[2][0], det->p[2][1]);
-          vpPixelMeterConversion::convertPoint(m_cam, imPt, x, y);
-          pt.set_x(x);
-          pt.set_y(y);
-          pts[2] = pt;
-
-          pt.setWorldCoordinates(-m_tagSize / 2.0, m_tagSize / 2.0, 0.0);
-          imPt.set_uv(det->p[3][0], det->p[3][1]);
-          vpPixelMeterConversion::convertPoint(m_cam, imPt, x, y);
-          pt.set_x(x);
-          pt.set_y(y);
-          pts[3] = pt;
-
-          pose.addPoints(pts);
+      matd_destroy(M);
+    }
+
+    if (m_poseEstimationMethod == HOMOGRAPHY) {
+      return;
+    }
+
+    // Marker object points and their normalized image coordinates
+    const double X[4] = {-m_tagSize / 2.0, m_tagSize / 2.0, m_tagSize / 2.0, -m_tagSize / 2.0};
+    const double Y[4] = {-m_tagSize / 2.0, -m_tagSize / 2.0, m_tagSize / 2.0, m_tagSize / 2.0};
+    double x[4], y[4];
+    for (int i = 0; i < 4; i++) {
+      vpPixelMeterConversion::convertPoint(m_cam, det->p[i][0], det->p[i][1], x[i], y[i]);
+    }
+
+    if (m_poseEstimationMethod == BEST_RESIDUAL_VIRTUAL_VS) {
+      // Keep the candidate with the lowest residual between the homography
+      // decomposition and the two IPPE solutions
+      double residual = computePlanarResidual(cMo, X, Y, x, y);
+      vpHomogeneousMatrix cMo_ippe[2];
+      if (computePlanarPoseIPPE(X, Y, x, y, cMo_ippe)) {
+        for (int i = 0; i < 2; i++) {
+          double residual_ippe = computePlanarResidual(cMo_ippe[i], X, Y, x, y);
+          if (residual_ippe < residual) {
+            residual = residual_ippe;
+            cMo = cMo_ippe[i];
+          }
         }
+      }
+    }
+
+    vpPose pose;
+    for (int i = 0; i < 4; i++) {
+      vpPoint pt;
+      pt.setWorldCoordinates(X[i], Y[i], 0.0);
+      pt.set_x(x[i]);
+      pt.set_y(y[i]);
+      pose.addPoint(pt);
+    }
+
+    if (m_poseEstimationMethod == DEMENTHON_VIRTUAL_VS || m_poseEstimationMethod == LAGRANGE_VIRTUAL_VS) {
+      std::map<vpPoseEstimationMethod, vpPose::vpPoseMethodType>::const_iterator it =
+          m_mapOfCorrespondingPoseMethods.find(m_poseEstimationMethod);
+      pose.computePose(it->second, cMo);
+    }
 
-        if (m_poseEstimationMethod != HOMOGRAPHY && m_poseEstimationMethod != HOMOGRAPHY_VIRTUAL_VS) {
-          if (m_poseEstimationMethod == BEST_RESIDUAL_VIRTUAL_VS) {
-            vpHomogeneousMatrix cMo_dementhon, cMo_lagrange, cMo_homography = cMo;
-
-            double residual_dementhon = std::numeric_limits<double>::max(),
-                   residual_lagrange = std::numeric_limits<double>::max();
-            double residual_homography = pose.computeResidual(cMo_homography);
-
-            if (pose.computePose(vpPose::DEMENTHON, cMo_dementhon)) {
-              residual_dementhon = pose.computeResidual(cMo_dementhon);
-            }
-
-            if (pose.computePose(vpPose::LAGRANGE, cMo_lagrange)) {
-              residual_lagrange = pose.computeResidual(cMo_lagrange);
-            }
-
-            if (residual_dementhon < residual_lagrange) {
-              if (residual_dementhon < residual_homography) {
-                cMo = cMo_dementhon;
-              } else {
-                cMo = cMo_homography;
-              }
-            } else if (residual_lagrange < residual_homography) {
-              cMo = cMo_lagrange;
-            } else {
-              //              cMo = cMo_homography; //already the case
-            }
-          } else {
-            pose.computePose(m_mapOfCorrespondingPoseMethods[m_poseEstimationMethod], cMo);
+    // Compute final pose using VVS
+    pose.computePose(vpPose::VIRTUAL_VS, cMo);
+  }
+
+  /*!
+    Run the detector on the whole image.
+  */
+  void detectFullImage(const vpImage<unsigned char> &I, std::vector<apriltag_detection_t *> &detections)
+  {
+    image_u8_t im = {/*.width =*/(int32_t)I.getWidth(),
+                     /*.height =*/(int32_t)I.getHeight(),
+                     /*.stride =*/(int32_t)I.getWidth(),
+                     /*.buf =*/I.bitmap};
+
+    zarray_t *zdetections = apriltag_detector_detect(m_td, &im);
+    appendDetections(zdetections, 0, 0, detections);
+    m_nbFramesSinceFullSearch = 0;
+  }
+
+  /*!
+    Run the detector only around the predicted locations of the tracked tags.
+    The regions of interest are processed at full resolution, in parallel
+    when several threads are allowed.
+
+    \return false if a full image search is required, either because the
+    regions are larger than the decimated image or because a tracked tag was
+    lost. The detections are then left empty.
+  */
+  bool detectInRois(const vpImage<unsigned char> &I, std::vector<apriltag_detection_t *> &detections)
+  {
+    const int width = (int)I.getWidth(), height = (int)I.getHeight();
+
+    std::vector<vpRect> rois;
+    for (size_t i = 0; i < m_trackedTags.size(); i++) {
+      const vpTrackedTag &tag = m_trackedTags[i];
+      double u_min = width, u_max = 0, v_min = height, v_max = 0, speed = 0;
+      for (int j = 0; j < 4; j++) {
+        double u = tag.p[j][0] + tag.v[j][0], v = tag.p[j][1] + tag.v[j][1];
+        u_min = (std::min)(u_min, u);
+        u_max = (std::max)(u_max, u);
+        v_min = (std::min)(v_min, v);
+        v_max = (std::max)(v_max, v);
+        speed = (std::max)(speed, (std::max)(std::fabs(tag.v[j][0]), std::fabs(tag.v[j][1])));
+      }
+      // Pad with a ratio of the tag size and the displacement uncertainty
+      double margin = m_trackingRoiMargin * (std::max)(u_max - u_min, v_max - v_min) + speed + 2;
+      double left = (std::max)(0.0, std::floor(u_min - margin));
+      double top = (std::max)(0.0, std::floor(v_min - margin));
+      double right = (std::min)(width - 1.0, std::ceil(u_max + margin));
+      double bottom = (std::min)(height - 1.0, std::ceil(v_max + margin));
+      if (right <= left || bottom <= top) {
+        return false;
+      }
+      rois.push_back(vpRect(vpImagePoint(top, left), vpImagePoint(bottom, right)));
+    }
+
+    // Merge the overlapping regions so that a tag is searched only once
+    bool merged = true;
+    while (merged) {
+      merged = false;
+      for (size_t i = 0; i < rois.size() && !merged; i++) {
+        for (size_t j = i + 1; j < rois.size() && !merged; j++) {
+          if (rois[i].getLeft() <= rois[j].getRight() && rois[j].getLeft() <= rois[i].getRight() &&
+              rois[i].getTop() <= rois[j].getBottom() && rois[j].getTop() <= rois[i].getBottom()) {
+            rois[i] = vpRect(vpImagePoint((std::min)(rois[i].getTop(), rois[j].getTop()),
+                                          (std::min)(rois[i].getLeft(), rois[j].getLeft())),
+                             vpImagePoint((std::max)(rois[i].getBottom(), rois[j].getBottom()),
+                                          (std::max)(rois[i].getRight(), rois[j].getRight())));
+            rois.erase(rois.begin() + (std::ptrdiff_t)j);
+            merged = true;
           }
         }
+      }
+    }
+
+    double area = 0;
+    for (size_t i = 0; i < rois.size(); i++) {
+      area += rois[i].getWidth() * rois[i].getHeight();
+    }
+    double decimate = (std::max)(1.0f, m_td->quad_decimate);
+    if (area > width * height / (decimate * decimate)) {
+      return false;
+    }
 
-        if (m_poseEstimationMethod != HOMOGRAPHY) {
-          // Compute final pose using VVS
-          pose.computePose(vpPose::VIRTUAL_VS, cMo);
+    int nb_rois = (int)rois.size();
+    int nb_workers = (std::max)(1, (std::min)(m_td->nthreads, nb_rois));
+    while (m_roiDetectors.size() < (size_t)nb_workers) {
+      // The family decoding table is shared, it is only read while detecting
+      apriltag_detector_t *td = apriltag_detector_create();
+      apriltag_detector_add_family(td, m_tf);
+      m_roiDetectors.push_back(td);
+    }
+    for (size_t i = 0; i < m_roiDetectors.size(); i++) {
+      apriltag_detector_t *td = m_roiDetectors[i];
+      td->nthreads = 1;
+      td->quad_decimate = 1.0f;
+      td->quad_sigma = m_td->quad_sigma;
+      td->refine_edges = m_td->refine_edges;
+      td->refine_decode = m_td->refine_decode;
+      td->refine_pose = m_td->refine_pose;
+    }
+
+    std::vector<zarray_t *> zdetections((size_t)nb_rois, NULL);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nb_workers)
+#endif
+    for (int i = 0; i < nb_rois; i++) {
+#ifdef VISP_HAVE_OPENMP
+      apriltag_detector_t *td = m_roiDetectors[(size_t)omp_get_thread_num()];
+#else
+      apriltag_detector_t *td = m_roiDetectors[0];
+#endif
+      const vpRect &roi = rois[(size_t)i];
+      int left = (int)roi.getLeft(), top = (int)roi.getTop();
+      int w = (int)roi.getWidth(), h = (int)roi.getHeight();
+
+      // Copy the region since the detector may read whole rows of the stride
+      std::vector<uint8_t> buf((size_t)(w * h));
+      for (int r = 0; r < h; r++) {
+        memcpy(&buf[(size_t)(r * w)], I.bitmap + (top + r) * width + left, (size_t)w);
+      }
+      image_u8_t im = {/*.width =*/w, /*.height =*/h, /*.stride =*/w, /*.buf =*/&buf[0]};
+      zdetections[(size_t)i] = apriltag_detector_detect(td, &im);
+    }
+
+    for (int i = 0; i < nb_rois; i++) {
+      appendDetections(zdetections[(size_t)i], rois[(size_t)i].getLeft(), rois[(size_t)i].getTop(), detections);
+    }
+
+    // Each tracked tag should be found again, otherwise it may have moved
+    // outside its region
+    std::vector<bool> found(detections.size(), false);
+    for (size_t i = 0; i < m_trackedTags.size(); i++) {
+      if (matchTrackedTag(m_trackedTags[i], detections, found) < 0) {
+        for (size_t j = 0; j < detections.size(); j++) {
+          apriltag_detection_destroy(detections[j]);
         }
+        detections.clear();
+        return false;
+      }
+    }
 
-        m_tagPoses.push_back(cMo);
+    return true;
+  }
+
+  /*!
+    Move the detections of a zarray into a vector after translating them from
+    the region of interest to the image frame. The zarray is destroyed.
+  */
+  static void appendDetections(zarray_t *zdetections, const double left, const double top,
+                               std::vector<apriltag_detection_t *> &detections)
+  {
+    for (int i = 0; i < zarray_size(zdetections); i++) {
+      apriltag_detection_t *det;
+      zarray_get(zdetections, i, &det);
+      if (left != 0 || top != 0) {
+        for (int j = 0; j < 4; j++) {
+          det->p[j][0] += left;
+          det->p[j][1] += top;
+        }
+        det->c[0] += left;
+        det->c[1] += top;
+        // H' = T H with T the translation of the region
+        for (int j = 0; j < 3; j++) {
+          MATD_EL(det->H, 0, j) += left * MATD_EL(det->H, 2, j);
+          MATD_EL(det->H, 1, j) += top * MATD_EL(det->H, 2, j);
+        }
       }
+      detections.push_back(det);
     }
+    zarray_destroy(zdetections);
+  }
 
-    apriltag_detections_destroy(detections);
+  /*!
+    Find the detection corresponding to a tracked tag: same id and closest
+    center to the predicted one, among detections not already matched.
 
-    return detected;
+    \return The index of the detection or -1.
+  */
+  static int matchTrackedTag(const vpTrackedTag &tag, const std::vector<apriltag_detection_t *> &detections,
+                             std::vector<bool> &matched)
+  {
+    double cu = 0, cv = 0, size = 0;
+    for (int j = 0; j < 4; j++) {
+      cu += (tag.p[j][0] + tag.v[j][0]) / 4;
+      cv += (tag.p[j][1] + tag.v[j][1]) / 4;
+    }
+    size = (std::max)(std::fabs(tag.p[2][0] - tag.p[0][0]), std::fabs(tag.p[2][1] - tag.p[0][1]));
+
+    int best = -1;
+    double best_dist = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < detections.size(); i++) {
+      if (matched[i] || detections[i]->id != tag.id) {
+        continue;
+      }
+      double dist = vpMath::sqr(detections[i]->c[0] - cu) + vpMath::sqr(detections[i]->c[1] - cv);
+      if (dist < best_dist) {
+        best_dist = dist;
+        best = (int)i;
+      }
+    }
+
+    // Reject a match farther than twice the tag size
+    if (best >= 0 && best_dist > 4 * vpMath::sqr(size) + 100) {
+      best = -1;
+    }
+    if (best >= 0) {
+      matched[(size_t)best] = true;
+    }
+    return best;
+  }
+
+  /*!
+    Update the tracked tags from the current detections, estimating the
+    displacement of their corners for the next prediction.
+  */
+  void updateTrackedTags(const std::vector<apriltag_detection_t *> &detections)
+  {
+    std::vector<vpTrackedTag> tags(detections.size());
+    std::vector<bool> matched(detections.size(), false);
+    std::vector<bool> updated(detections.size(), false);
+
+    for (size_t i = 0; i < m_trackedTags.size(); i++) {
+      int idx = matchTrackedTag(m_trackedTags[i], detections, matched);
+      if (idx >= 0) {
+        vpTrackedTag &tag = tags[(size_t)idx];
+        for (int j = 0; j < 4; j++) {
+          tag.v[j][0] = detections[(size_t)idx]->p[j][0] - m_trackedTags[i].p[j][0];
+          tag.v[j][1] = detections[(size_t)idx]->p[j][1] - m_trackedTags[i].p[j][1];
+        }
+        updated[(size_t)idx] = true;
+      }
+    }
+
+    for (size_t i = 0; i < detections.size(); i++) {
+      vpTrackedTag &tag = tags[i];
+      tag.id = detections[i]->id;
+      for (int j = 0; j < 4; j++) {
+        tag.p[j][0] = detections[i]->p[j][0];
+        tag.p[j][1] = detections[i]->p[j][1];
+        if (!updated[i]) {
+          tag.v[j][0] = tag.v[j][1] = 0;
+        }
+      }
+    }
+
+    m_trackedTags = tags;
   }
 
   void getTagPoses(std::vector<vpHomogeneousMatrix> &tagPoses) const { tagPoses = m_tagPoses; }
@@ -302,7 +795,17 @@ public:
 
   void setPoseEstimationMethod(const vpPoseEstimationMethod &method) { m_poseEstimationMethod = method; }
 
+  void setTracking(const bool tracking, const unsigned int fullSearchPeriod)
+  {
+    m_tracking = tracking;
+    m_trackingFullSearchPeriod = fullSearchPeriod;
+    m_trackedTags.clear();
+  }
+
+  void setTrackingRoiMargin(const double margin) { m_trackingRoiMargin = margin; }
+
 protected:
+
   vpCameraParameters m_cam;
   std::map<vpPoseEstimationMethod, vpPose::vpPoseMethodType> m_mapOfCorrespondingPoseMethods;
   vpPoseEstimationMethod m_poseEstimationMethod;
@@ -311,6 +814,13 @@ protected:
   double m_tagSize;
   apriltag_detector_t *m_td;
   apriltag_family_t *m_tf;
+  bool m_tracking;
+  unsigned int m_trackingFullSearchPeriod;
+  double m_trackingRoiMargin;
+  unsigned int m_nbFramesSinceFullSearch;
+  std::vector<vpTrackedTag> m_trackedTags;
+  //! One detector per thread processing the regions of interest
+  std::vector<apriltag_detector_t *> m_roiDetectors;
 };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
@@ -472,6 +982,49 @@ void vpDetectorAprilTag::setAprilTagRefineEdges(const bool refineEdges) { m_impl
   \param refinePose : If true, set refine_pose to 1.
 */
 void vpDetectorAprilTag::setAprilTagRefinePose(const bool refinePose) { m_impl->setRefinePose(refinePose); }
+
+/*!
+  Enable or disable the tracking mode, intended for video streams where the
+  tags move little between two frames.
+
+  In tracking mode, the location of each detected tag in the next frame is
+  predicted with a constant velocity model. The detection is then only run
+  in regions of interest around the predicted locations, at full resolution
+  and in parallel using the number of threads set with
+  setAprilTagNbThreads(). A full image search, using the decimation set with
+  setAprilTagQuadDecimate(), is done instead:
+  - every \e fullSearchPeriod frames, in order to detect new tags,
+  - when a tracked tag is not found in its region of interest,
+  - when no tag was detected in the previous frame,
+  - when the regions of interest cover more pixels than the decimated image.
+
+  \param tracking : If true, enable the tracking mode. Tracked tags are reset
+  in any case.
+  \param fullSearchPeriod : Number of frames between two full image
+  searches. With 0 or 1, a full image search is done at each frame.
+
+  \sa setAprilTagTrackingRoiMargin()
+*/
+void vpDetectorAprilTag::setAprilTagTracking(const bool tracking, const unsigned int fullSearchPeriod)
+{
+  m_impl->setTracking(tracking, fullSearchPeriod);
+}
+
+/*!
+  Set the margin added around the predicted location of a tag to define its
+  region of interest in tracking mode. The margin is expressed as a ratio of
+  the tag size in the image, the predicted displacement of the tag being
+  also added.
+
+  \param margin : Margin ratio. Default is 0.5.
+
+  \sa setAprilTagTracking()
+*/
+void vpDetectorAprilTag::setAprilTagTrackingRoiMargin(const double margin)
+{
+  if (margin >= 0)
+    m_impl->setTrackingRoiMargin(margin);
+}
 #elif !defined(VISP_BUILD_SHARED_LIBS)
 // Work arround to avoid warning: libvisp_core.a(vpDetectorAprilTag.cpp.o) has
 // no symbols
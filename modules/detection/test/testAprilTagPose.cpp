@@ -0,0 +1,229 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test AprilTag pose estimation.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testAprilTagPose.cpp
+
+  \brief Test AprilTag pose estimation on a synthetic image with many tags
+  rendered in perspective. The poses estimated with each method are compared
+  to the ground truth.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/detection/vpDetectorAprilTag.h>
+
+#if defined(VISP_HAVE_APRILTAG)
+
+namespace
+{
+// 36 bits codes of the first tags of the tag36h11 family
+const unsigned int codes[4][2] = {{0xd, 0x5d628584}, {0xd, 0x97f18b49}, {0xd, 0xd280910e}, {0xe, 0x479e9c98}};
+
+// Value of the tag pattern at (X, Y) in the pattern frame: 6x6 bits inside a
+// black border, surrounded by a white border
+unsigned char tagValue(const unsigned int code[2], const double tagSize, const double X, const double Y)
+{
+  int x = vpMath::round(std::floor((X / tagSize + 0.5) * 8));
+  int y = vpMath::round(std::floor((Y / tagSize + 0.5) * 8));
+  if (x < 0 || x > 7 || y < 0 || y > 7) {
+    return 255;
+  }
+  if (x == 0 || x == 7 || y == 0 || y == 7) {
+    return 0;
+  }
+  unsigned int bit = (unsigned int)(35 - ((y - 1) * 6 + (x - 1)));
+  unsigned int word = bit >= 32 ? code[0] : code[1];
+  return ((word >> (bit % 32)) & 1) ? 255 : 0;
+}
+
+// Render a tag whose pattern frame is seen from the pose cMo, with 4x4
+// supersampling
+void drawTag(vpImage<unsigned char> &I, const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo,
+             const unsigned int code[2], const double tagSize)
+{
+  // Homography from the tag plane to the normalized image plane, and its inverse
+  vpMatrix H(3, 3);
+  for (unsigned int i = 0; i < 3; i++) {
+    H[i][0] = cMo[i][0];
+    H[i][1] = cMo[i][1];
+    H[i][2] = cMo[i][3];
+  }
+  vpMatrix Hinv = H.inverseByLU();
+
+  double umin = I.getWidth(), umax = 0, vmin = I.getHeight(), vmax = 0;
+  for (int i = 0; i < 4; i++) {
+    double X = (i == 0 || i == 3 ? -0.75 : 0.75) * tagSize, Y = (i < 2 ? -0.75 : 0.75) * tagSize;
+    double x = (H[0][0] * X + H[0][1] * Y + H[0][2]) / (H[2][0] * X + H[2][1] * Y + H[2][2]);
+    double y = (H[1][0] * X + H[1][1] * Y + H[1][2]) / (H[2][0] * X + H[2][1] * Y + H[2][2]);
+    double u = 0, v = 0;
+    vpMeterPixelConversion::convertPoint(cam, x, y, u, v);
+    umin = (std::min)(umin, u);
+    umax = (std::max)(umax, u);
+    vmin = (std::min)(vmin, v);
+    vmax = (std::max)(vmax, v);
+  }
+
+  for (int v = (std::max)(0, (int)vmin); v <= (std::min)((int)I.getHeight() - 1, (int)vmax); v++) {
+    for (int u = (std::max)(0, (int)umin); u <= (std::min)((int)I.getWidth() - 1, (int)umax); u++) {
+      unsigned int sum = 0;
+      for (int k = 0; k < 16; k++) {
+        double x = 0, y = 0;
+        vpPixelMeterConversion::convertPoint(cam, u - 0.375 + 0.25 * (k % 4), v - 0.375 + 0.25 * (k / 4), x, y);
+        double w = Hinv[2][0] * x + Hinv[2][1] * y + Hinv[2][2];
+        double X = (Hinv[0][0] * x + Hinv[0][1] * y + Hinv[0][2]) / w;
+        double Y = (Hinv[1][0] * x + Hinv[1][1] * y + Hinv[1][2]) / w;
+        sum += tagValue(code, tagSize, X, Y);
+      }
+      I[v][u] = (unsigned char)(sum / 16);
+    }
+  }
+}
+}
+
+int main()
+{
+  try {
+    const double tagSize = 0.05;
+    const int nb_cols = 8, nb_rows = 6;
+    vpCameraParameters cam;
+    cam.initPersProjWithoutDistortion(800., 800., 640., 480.);
+
+    // Tags on a grid, each one with its own orientation
+    vpImage<unsigned char> I(960, 1280, 255);
+    std::vector<vpHomogeneousMatrix> cMo_truth;
+    std::vector<vpImagePoint> centers;
+    for (int r = 0; r < nb_rows; r++) {
+      for (int c = 0; c < nb_cols; c++) {
+        int i = r * nb_cols + c;
+        double Z = 0.5 + 0.05 * (i % 5);
+        double x = (160. * c + 80. - cam.get_u0()) / cam.get_px();
+        double y = (160. * r + 80. - cam.get_v0()) / cam.get_py();
+        vpHomogeneousMatrix cMo(x * Z, y * Z, Z, vpMath::rad(30. * std::cos(0.7 * i)),
+                                vpMath::rad(30. * std::sin(1.3 * i)), vpMath::rad(15. * i));
+        drawTag(I, cam, cMo, codes[i % 4], tagSize);
+        // The tag frame of the detector is rotated by 180 degrees around the
+        // x-axis of the pattern frame
+        cMo_truth.push_back(cMo * vpHomogeneousMatrix(0, 0, 0, M_PI, 0, 0));
+        centers.push_back(vpImagePoint(160. * r + 80., 160. * c + 80.));
+      }
+    }
+
+    // Dementhon and Lagrange initializations are not tested, since for
+    // 4 coplanar points they may converge to the wrong planar pose
+    vpDetectorAprilTag::vpPoseEstimationMethod methods[] = {vpDetectorAprilTag::HOMOGRAPHY_VIRTUAL_VS,
+                                                            vpDetectorAprilTag::BEST_RESIDUAL_VIRTUAL_VS};
+    const char *names[] = {"HOMOGRAPHY_VIRTUAL_VS", "BEST_RESIDUAL_VIRTUAL_VS"};
+    for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); m++) {
+      std::vector<vpHomogeneousMatrix> cMo_single_thread(cMo_truth.size());
+      for (int nb_threads = 1; nb_threads <= 4; nb_threads *= 4) {
+        vpDetectorAprilTag detector(vpDetectorAprilTag::TAG_36h11, methods[m]);
+        detector.setAprilTagNbThreads(nb_threads);
+        std::vector<vpHomogeneousMatrix> cMo_vec;
+        const int nb_runs = 5;
+        double t_pose = 0;
+        for (int run = 0; run < nb_runs; run++) {
+          double t = vpTime::measureTimeMs();
+          detector.detect(I);
+          double t_detection = vpTime::measureTimeMs() - t;
+          t = vpTime::measureTimeMs();
+          detector.detect(I, tagSize, cam, cMo_vec);
+          t_pose += (vpTime::measureTimeMs() - t - t_detection) / nb_runs;
+        }
+
+        if (detector.getNbObjects() != cMo_truth.size()) {
+          std::cerr << names[m] << ": " << detector.getNbObjects() << " tags detected instead of "
+                    << cMo_truth.size() << std::endl;
+          return EXIT_FAILURE;
+        }
+
+        double max_t_err = 0, max_r_err = 0;
+        bool same_poses = true;
+        for (size_t i = 0; i < detector.getNbObjects(); i++) {
+          // The ground truth is the tag whose center is the closest
+          size_t k = 0;
+          for (size_t j = 1; j < centers.size(); j++) {
+            if (vpImagePoint::distance(detector.getCog(i), centers[j]) <
+                vpImagePoint::distance(detector.getCog(i), centers[k])) {
+              k = j;
+            }
+          }
+          vpHomogeneousMatrix cdMc = cMo_truth[k] * cMo_vec[i].inverse();
+          max_t_err = (std::max)(max_t_err, cdMc.getTranslationVector().euclideanNorm());
+          max_r_err = (std::max)(max_r_err, vpMath::deg(std::sqrt(vpThetaUVector(cdMc.getRotationMatrix()).sumSquare())));
+
+          // Poses must not depend on the number of threads
+          if (nb_threads == 1) {
+            cMo_single_thread[k] = cMo_vec[i];
+          } else {
+            for (unsigned int j = 0; j < 3; j++) {
+              same_poses = same_poses && vpMath::equal(cMo_vec[i][j][3], cMo_single_thread[k][j][3], 1e-9);
+            }
+          }
+        }
+
+        std::cout << names[m] << " with " << nb_threads << " thread(s): pose estimation in " << t_pose
+                  << " ms, max errors " << max_t_err * 1000 << " mm " << max_r_err << " deg" << std::endl;
+        if (max_t_err > 1.5e-2 || max_r_err > 1.5) {
+          std::cerr << "Wrong pose estimation" << std::endl;
+          return EXIT_FAILURE;
+        }
+
+        if (!same_poses) {
+          std::cerr << "Poses differ with " << nb_threads << " threads" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  } catch (vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testAprilTagPose is ok" << std::endl;
+  return EXIT_SUCCESS;
+}
+#else
+int main()
+{
+  std::cout << "AprilTag detection requires the apriltag 3rd party." << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
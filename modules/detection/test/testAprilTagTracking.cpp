@@ -0,0 +1,201 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test AprilTag detection in tracking mode.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testAprilTagTracking.cpp
+
+  \brief Test AprilTag detection in tracking mode on a synthetic sequence
+  where tags move, disappear and appear. Detections and poses are compared to
+  the ones obtained with a full image search at each frame.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/detection/vpDetectorAprilTag.h>
+
+#if defined(VISP_HAVE_APRILTAG)
+
+namespace
+{
+struct SyntheticTag {
+  unsigned int hi, lo; // 36 bits code of the tag36h11 family
+  double u, v;         // Top left corner at the first frame
+  int first_frame, last_frame;
+};
+
+// Draw a tag36h11 pattern: 6x6 bits inside a one bit wide black border
+void drawTag(vpImage<unsigned char> &I, const SyntheticTag &tag, const double u, const double v,
+             const unsigned int cell)
+{
+  for (unsigned int y = 0; y < 8; y++) {
+    for (unsigned int x = 0; x < 8; x++) {
+      unsigned char value = 0;
+      if (x > 0 && x < 7 && y > 0 && y < 7) {
+        unsigned int bit = 35 - ((y - 1) * 6 + (x - 1));
+        unsigned int word = bit >= 32 ? tag.hi : tag.lo;
+        value = ((word >> (bit % 32)) & 1) ? 255 : 0;
+      }
+      for (unsigned int i = 0; i < cell; i++) {
+        for (unsigned int j = 0; j < cell; j++) {
+          I[(unsigned int)v + y * cell + i][(unsigned int)u + x * cell + j] = value;
+        }
+      }
+    }
+  }
+}
+
+bool sameDetections(vpDetectorAprilTag &tracker, const std::vector<vpHomogeneousMatrix> &cMo_tracker,
+                    vpDetectorAprilTag &reference, const std::vector<vpHomogeneousMatrix> &cMo_reference,
+                    const std::string &missing)
+{
+  for (size_t i = 0; i < tracker.getNbObjects(); i++) {
+    bool found = false;
+    for (size_t j = 0; j < reference.getNbObjects() && !found; j++) {
+      if (tracker.getMessage(i) != reference.getMessage(j)) {
+        continue;
+      }
+      std::vector<vpImagePoint> p1 = tracker.getPolygon(i), p2 = reference.getPolygon(j);
+      found = true;
+      for (size_t k = 0; k < 4; k++) {
+        if (vpImagePoint::distance(p1[k], p2[k]) > 0.5) {
+          found = false;
+        }
+      }
+      for (unsigned int k = 0; k < 3; k++) {
+        if (!vpMath::equal(cMo_tracker[i][k][3], cMo_reference[j][k][3], 1e-3)) {
+          found = false;
+        }
+      }
+    }
+    if (!found) {
+      std::cerr << "Unexpected detection: " << tracker.getMessage(i) << std::endl;
+      return false;
+    }
+  }
+
+  size_t expected = reference.getNbObjects();
+  for (size_t j = 0; j < reference.getNbObjects(); j++) {
+    if (reference.getMessage(j) == missing) {
+      bool tracked = false;
+      for (size_t i = 0; i < tracker.getNbObjects(); i++) {
+        tracked = tracked || tracker.getMessage(i) == missing;
+      }
+      if (!tracked) {
+        expected--;
+      }
+    }
+  }
+  if (tracker.getNbObjects() != expected) {
+    std::cerr << "Found " << tracker.getNbObjects() << " tags instead of " << expected << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    const unsigned int cell = 10;
+    const int nb_frames = 30;
+    const unsigned int full_search_period = 10;
+    SyntheticTag tags[] = {{0xd, 0x5d628584, 100, 100, 0, nb_frames},
+                           {0xd, 0x97f18b49, 700, 300, 0, 14},
+                           {0xd, 0xd280910e, 1300, 600, 0, nb_frames},
+                           {0xe, 0x479e9c98, 400, 800, 20, nb_frames}};
+    const std::string new_tag = "36h11 id: 3";
+
+    vpDetectorAprilTag tracker(vpDetectorAprilTag::TAG_36h11), reference(vpDetectorAprilTag::TAG_36h11);
+    tracker.setAprilTagTracking(true, full_search_period);
+    tracker.setAprilTagNbThreads(2);
+
+    vpCameraParameters cam;
+    cam.initPersProjWithoutDistortion(1000., 1000., 960., 540.);
+    const double tagSize = 0.05;
+    std::vector<vpHomogeneousMatrix> cMo_tracker, cMo_reference;
+
+    vpImage<unsigned char> I(1080, 1920);
+    double t_tracker = 0, t_reference = 0;
+    bool new_tag_found = false;
+    for (int frame = 0; frame < nb_frames; frame++) {
+      I = 255;
+      for (size_t i = 0; i < sizeof(tags) / sizeof(tags[0]); i++) {
+        if (frame >= tags[i].first_frame && frame <= tags[i].last_frame) {
+          drawTag(I, tags[i], tags[i].u + 3 * frame, tags[i].v + 2 * frame, cell);
+        }
+      }
+
+      double t = vpTime::measureTimeMs();
+      reference.detect(I, tagSize, cam, cMo_reference);
+      t_reference += vpTime::measureTimeMs() - t;
+      t = vpTime::measureTimeMs();
+      tracker.detect(I, tagSize, cam, cMo_tracker);
+      t_tracker += vpTime::measureTimeMs() - t;
+
+      // A new tag may only be missed until the next full image search
+      if (!sameDetections(tracker, cMo_tracker, reference, cMo_reference, new_tag_found ? "" : new_tag)) {
+        std::cerr << "Wrong detections at frame " << frame << std::endl;
+        return EXIT_FAILURE;
+      }
+      for (size_t i = 0; i < tracker.getNbObjects(); i++) {
+        new_tag_found = new_tag_found || tracker.getMessage(i) == new_tag;
+      }
+    }
+
+    if (!new_tag_found) {
+      std::cerr << "The tag appearing during the sequence was not detected" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "Mean detection time: " << t_reference / nb_frames << " ms with full image search, "
+              << t_tracker / nb_frames << " ms in tracking mode" << std::endl;
+  } catch (vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testAprilTagTracking is ok" << std::endl;
+  return EXIT_SUCCESS;
+}
+#else
+int main()
+{
+  std::cout << "AprilTag detection requires the apriltag 3rd party." << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
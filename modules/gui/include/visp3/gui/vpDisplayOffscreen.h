@@ -0,0 +1,195 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Display rendering in an image in memory.
+ *
+ *****************************************************************************/
+
+#ifndef vpDisplayOffscreen_h
+#define vpDisplayOffscreen_h
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpDisplay.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+
+/*!
+  \file vpDisplayOffscreen.h
+  \brief Display that renders images and overlays in memory.
+*/
+
+/*!
+
+  \class vpDisplayOffscreen
+
+  \ingroup group_gui_display
+
+  \brief The vpDisplayOffscreen rasterizes images and overlay drawings
+  (lines, circles, rectangles, points, text...) in a vpImage<vpRGBa>
+  kept in memory, without any window system.
+
+  It is a regular vpDisplay, so that any code using the vpDisplay static
+  functions, like the display() methods of the trackers, can annotate
+  images in a headless process. The drawings are done in software directly
+  in the image buffer, so that there is no per call overhead and a display
+  can be used in a worker thread (each display owns its image; two
+  threads must not draw in the same display at the same time). The
+  rendering is retrieved with getImage() or vpDisplay::getImage().
+
+  Lines and circles are drawn aliased by default, like the other displays.
+  Anti-aliasing can be enabled with setAntialiasing(). Text is rendered
+  with a built-in 8x8 bitmap font. Since there is no user interaction,
+  getClick(), getKeyboardEvent() and related functions never block and
+  always return false.
+
+  \code
+#include <visp3/gui/vpDisplayOffscreen.h>
+#include <visp3/io/vpImageIo.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640, 128);
+  vpDisplayOffscreen d(I);
+  d.setAntialiasing(true);
+
+  vpDisplay::display(I);
+  vpDisplay::displayLine(I, vpImagePoint(10, 10), vpImagePoint(200, 300), vpColor::red, 2);
+  vpDisplay::displayCircle(I, vpImagePoint(240, 320), 50, vpColor::green);
+  vpDisplay::displayText(I, vpImagePoint(20, 20), "frame 0", vpColor::yellow);
+  vpDisplay::flush(I);
+
+  vpImage<vpRGBa> O;
+  vpDisplay::getImage(I, O);
+  vpImageIo::write(O, "overlay.png");
+}
+  \endcode
+*/
+class VISP_EXPORT vpDisplayOffscreen : public vpDisplay
+{
+public:
+  vpDisplayOffscreen();
+  vpDisplayOffscreen(int winx, int winy, const std::string &title = "");
+  vpDisplayOffscreen(vpImage<unsigned char> &I, vpScaleType type);
+  vpDisplayOffscreen(vpImage<unsigned char> &I, int winx = -1, int winy = -1, const std::string &title = "",
+                     vpScaleType type = SCALE_DEFAULT);
+  vpDisplayOffscreen(vpImage<vpRGBa> &I, vpScaleType type);
+  vpDisplayOffscreen(vpImage<vpRGBa> &I, int winx = -1, int winy = -1, const std::string &title = "",
+                     vpScaleType type = SCALE_DEFAULT);
+
+  virtual ~vpDisplayOffscreen();
+
+  /*!
+    Return the image in which the display is rendered. Its size is the
+    size of the displayed image divided by the down scaling factor.
+  */
+  const vpImage<vpRGBa> &getCanvas() const { return m_canvas; }
+  /*!
+    Return true if lines and circles are anti-aliased.
+  */
+  bool getAntialiasing() const { return m_antialiasing; }
+  void getImage(vpImage<vpRGBa> &I);
+  unsigned int getScreenDepth() { return 32; }
+  unsigned int getScreenHeight();
+  void getScreenSize(unsigned int &width, unsigned int &height);
+  unsigned int getScreenWidth();
+
+  void init(vpImage<unsigned char> &I, int winx = -1, int winy = -1, const std::string &title = "");
+  void init(vpImage<vpRGBa> &I, int winx = -1, int winy = -1, const std::string &title = "");
+  void init(unsigned int width, unsigned int height, int winx = -1, int winy = -1, const std::string &title = "");
+
+  /*!
+    Enable or disable the anti-aliasing of lines and circles.
+  */
+  void setAntialiasing(bool antialiasing) { m_antialiasing = antialiasing; }
+  void setFont(const std::string &font);
+  void setTitle(const std::string &title);
+  void setWindowPosition(int winx, int winy);
+
+protected:
+  void clearDisplay(const vpColor &color = vpColor::white);
+
+  void closeDisplay();
+
+  void displayArrow(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color = vpColor::white,
+                    unsigned int w = 4, unsigned int h = 2, unsigned int thickness = 1);
+
+  void displayCharString(const vpImagePoint &ip, const char *text, const vpColor &color = vpColor::green);
+
+  void displayCircle(const vpImagePoint &center, unsigned int radius, const vpColor &color, bool fill = false,
+                     unsigned int thickness = 1);
+  void displayCross(const vpImagePoint &ip, unsigned int size, const vpColor &color, unsigned int thickness = 1);
+  void displayDotLine(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color,
+                      unsigned int thickness = 1);
+
+  void displayImage(const vpImage<unsigned char> &I);
+  void displayImage(const vpImage<vpRGBa> &I);
+
+  void displayImageROI(const vpImage<unsigned char> &I, const vpImagePoint &iP, const unsigned int width,
+                       const unsigned int height);
+  void displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &iP, const unsigned int width,
+                       const unsigned int height);
+
+  void displayLine(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color, unsigned int thickness = 1);
+  void displayPoint(const vpImagePoint &ip, const vpColor &color, unsigned int thickness = 1);
+
+  void displayRectangle(const vpImagePoint &topLeft, unsigned int width, unsigned int height, const vpColor &color,
+                        bool fill = false, unsigned int thickness = 1);
+  void displayRectangle(const vpImagePoint &topLeft, const vpImagePoint &bottomRight, const vpColor &color,
+                        bool fill = false, unsigned int thickness = 1);
+  void displayRectangle(const vpRect &rectangle, const vpColor &color, bool fill = false, unsigned int thickness = 1);
+
+  void flushDisplay();
+  void flushDisplayROI(const vpImagePoint &iP, const unsigned int width, const unsigned int height);
+
+  bool getClick(bool blocking = true);
+  bool getClick(vpImagePoint &ip, bool blocking = true);
+  bool getClick(vpImagePoint &ip, vpMouseButton::vpMouseButtonType &button, bool blocking = true);
+  bool getClickUp(vpImagePoint &ip, vpMouseButton::vpMouseButtonType &button, bool blocking = true);
+
+  bool getKeyboardEvent(bool blocking = true);
+  bool getKeyboardEvent(std::string &key, bool blocking = true);
+  bool getPointerMotionEvent(vpImagePoint &ip);
+  bool getPointerPosition(vpImagePoint &ip);
+
+private:
+  void blendPixel(int u, int v, const vpRGBa &color, double alpha);
+  void drawDisc(double uc, double vc, double r_out, double r_in, const vpRGBa &color);
+  void drawRectangle(int u, int v, int w, int h, const vpRGBa &color, bool fill, unsigned int thickness);
+  void drawSegment(double u1, double v1, double u2, double v2, const vpRGBa &color, unsigned int thickness);
+  void drawSegmentThin(double u1, double v1, double u2, double v2, const vpRGBa &color);
+  void fillPolygon(const double *u, const double *v, unsigned int n, const vpRGBa &color);
+  void fillRect(int u, int v, int w, int h, const vpRGBa &color);
+
+  vpImage<vpRGBa> m_canvas;
+  bool m_antialiasing;
+};
+
+#endif
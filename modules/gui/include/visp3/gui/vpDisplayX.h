@@ -47,6 +47,9 @@
 //{
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
+#ifdef VISP_HAVE_X11_XSHM
+#include <X11/extensions/XShm.h>
+#endif
 //#include <X11/Xatom.h>
 //#include <X11/cursorfont.h>
 //} ;
@@ -58,6 +61,8 @@
 #undef Success // See http://eigen.tuxfamily.org/bz/show_bug.cgi?id=253
 #endif
 
+#include <vector>
+
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpRect.h>
 
@@ -146,6 +151,13 @@ int main()
 }
   \endcode
 
+  When the X server runs on the same machine, the image is transferred to
+  the server through the MIT shared memory extension (XShm) instead of the
+  X protocol. The gray level and color images are converted to the visual
+  format with SSE2/SSSE3 instructions when available. Finally, the regions
+  modified since the last flush are tracked, so that flushDisplay() only
+  refreshes the parts of the window changed by displayROI() and by the
+  overlay drawings.
 */
 
 class VISP_EXPORT vpDisplayX : public vpDisplay
@@ -167,6 +179,20 @@ private:
   bool ximage_data_init;
   unsigned int RMask, GMask, BMask;
   int RShift, GShift, BShift;
+#ifdef VISP_HAVE_X11_XSHM
+  XShmSegmentInfo m_shmInfo;
+#endif
+  bool m_useShm;
+  bool m_shmPending;
+  XFontStruct *m_font;
+  std::vector<XRectangle> m_dirtyRects;
+  bool m_dirtyAll;
+
+  void addDirtyRect(int x, int y, int w, int h);
+  void createXImage();
+  void destroyXImage();
+  void putXImage(int x, int y, unsigned int w, unsigned int h);
+  void waitXImage();
 
   // private:
   //#ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -204,6 +230,12 @@ public:
   void getScreenSize(unsigned int &width, unsigned int &height);
   unsigned int getScreenWidth();
 
+  /*!
+    Return true if the image is transferred to the X server through the MIT
+    shared memory extension.
+  */
+  bool isSharedMemoryUsed() const { return m_useShm; }
+
   void init(vpImage<unsigned char> &I, int winx = -1, int winy = -1, const std::string &title = "");
   void init(vpImage<vpRGBa> &I, int winx = -1, int winy = -1, const std::string &title = "");
   void init(unsigned int width, unsigned int height, int winx = -1, int winy = -1, const std::string &title = "");
@@ -190,12 +190,17 @@ public:
       vpDisplay::setFont(I, font.c_str());
   }
   void setLegend(const unsigned int graphNum, const unsigned int curveNum, const std::string &legend);
+  void setMaxNumberOfPoints(const unsigned int graphNum, const unsigned int nbPoints);
   void setTitle(const unsigned int graphNum, const std::string &title);
   void setUnitX(const unsigned int graphNum, const std::string &unitx);
   void setUnitY(const unsigned int graphNum, const std::string &unity);
   void setUnitZ(const unsigned int graphNum, const std::string &unitz);
   void setThickness(const unsigned int graphNum, const unsigned int curveNum, const unsigned int thickness);
 
+  void startDataRecording(const unsigned int graphNum, const std::string &dataFile,
+                          const std::string &title_prefix = "");
+  void stopDataRecording(const unsigned int graphNum);
+
 private:
   void initNbGraph(unsigned int nbGraph);
   void displayGrid();
@@ -50,11 +50,11 @@
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpPoint.h>
 
-#include <list>
+#include <vector>
 
 #if defined(VISP_HAVE_DISPLAY)
 
-class vpPlotCurve
+class VISP_EXPORT vpPlotCurve
 {
 public:
   //! Different styles to plot the curve.
@@ -65,11 +65,16 @@ public:
   // vpMarkerStyle markerStyle;
   // char lineStyle[20];
   // vpList<vpImagePoint> pointList;
+  //! Number of points stored in the ring buffers
   unsigned int nbPoint;
   vpImagePoint lastPoint;
-  std::list<double> pointListx;
-  std::list<double> pointListy;
-  std::list<double> pointListz;
+  // Ring buffers of the plotted points. Once maxNbPoint points are stored,
+  // the oldest point at index pointHead is overwritten.
+  std::vector<double> pointListx;
+  std::vector<double> pointListy;
+  std::vector<double> pointListz;
+  unsigned int pointHead;
+  unsigned int maxNbPoint;
   std::string legend;
   double xmin;
   double xmax;
@@ -79,9 +84,13 @@ public:
 public:
   vpPlotCurve();
   ~vpPlotCurve();
+  void addPoint(const double x, const double y, const double z);
+  void clearPointList();
+  void getPoint(const unsigned int k, double &x, double &y, double &z) const;
   void plotPoint(const vpImage<unsigned char> &I, const vpImagePoint &iP, const double x, const double y);
   void plotList(const vpImage<unsigned char> &I, const double xorg, const double yorg, const double zoomx,
                 const double zoomy);
+  void setMaxNumberOfPoints(const unsigned int nb);
 };
 
 #endif
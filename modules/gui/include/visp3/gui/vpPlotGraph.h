@@ -55,7 +55,9 @@
 
 #if defined(VISP_HAVE_DISPLAY)
 
-class vpPlotGraph
+class vpPlotDataRecorder;
+
+class VISP_EXPORT vpPlotGraph
 {
 public:
   double xorg;
@@ -140,6 +142,13 @@ public:
 
   unsigned int gridThickness;
 
+  // Maximum number of points stored per curve, applied to the curves
+  // created by initGraph()
+  unsigned int maxNbPoint;
+
+  // Asynchronous writer of all the plotted points, NULL when not recording
+  vpPlotDataRecorder *recorder;
+
   // private:
   //#ifndef DOXYGEN_SHOULD_SKIP_THIS
   //    vpPlotGraph(const vpPlotGraph &)
@@ -214,8 +223,11 @@ public:
 
   void setCurveColor(const unsigned int curveNum, const vpColor &color);
   void setCurveThickness(const unsigned int curveNum, const unsigned int thickness);
+  void startDataRecording(const std::string &dataFile, const std::string &title_prefix);
+  void stopDataRecording();
   void setGridThickness(const unsigned int thickness) { this->gridThickness = thickness; };
   void setLegend(const unsigned int curveNum, const std::string &legend);
+  void setMaxNumberOfPoints(const unsigned int nb);
   void setTitle(const std::string &title);
   void setUnitX(const std::string &unitx);
   void setUnitY(const std::string &unity);
@@ -0,0 +1,1129 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Display rendering in an image in memory.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpDisplayOffscreen.cpp
+  \brief Display that renders images and overlays in memory.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string.h>
+#include <vector>
+
+#include <visp3/core/vpDisplayException.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpRect.h>
+#include <visp3/gui/vpDisplayOffscreen.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Size of the virtual screen, large enough to never down scale images with
+// vpDisplay::SCALE_AUTO
+const unsigned int vp_offscreenScreenSize = 16384;
+
+// Length in pixels of the dashes drawn by displayDotLine()
+const double vp_offscreenDashLength = 4.;
+
+/*
+  8x8 bitmap font for the printable ASCII characters (from 32 to 126). Each
+  glyph is stored as 8 rows from top to bottom; the least significant bit is
+  the leftmost pixel.
+*/
+const unsigned char vp_offscreenFont[95][8] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+    {0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00}, // '!'
+    {0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // '"'
+    {0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00}, // '#'
+    {0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00}, // '$'
+    {0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00}, // '%'
+    {0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00}, // '&'
+    {0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00}, // '''
+    {0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00}, // '('
+    {0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00}, // ')'
+    {0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00}, // '*'
+    {0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00}, // '+'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x06}, // ','
+    {0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00}, // '-'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00}, // '.'
+    {0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00}, // '/'
+    {0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00}, // '0'
+    {0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00}, // '1'
+    {0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00}, // '2'
+    {0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00}, // '3'
+    {0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00}, // '4'
+    {0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00}, // '5'
+    {0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00}, // '6'
+    {0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00}, // '7'
+    {0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00}, // '8'
+    {0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00}, // '9'
+    {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00}, // ':'
+    {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x06}, // ';'
+    {0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00}, // '<'
+    {0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00}, // '='
+    {0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00}, // '>'
+    {0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00}, // '?'
+    {0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00}, // '@'
+    {0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00}, // 'A'
+    {0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00}, // 'B'
+    {0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00}, // 'C'
+    {0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00}, // 'D'
+    {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00}, // 'E'
+    {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00}, // 'F'
+    {0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00}, // 'G'
+    {0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00}, // 'H'
+    {0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // 'I'
+    {0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00}, // 'J'
+    {0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00}, // 'K'
+    {0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00}, // 'L'
+    {0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00}, // 'M'
+    {0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00}, // 'N'
+    {0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00}, // 'O'
+    {0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00}, // 'P'
+    {0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00}, // 'Q'
+    {0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00}, // 'R'
+    {0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00}, // 'S'
+    {0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // 'T'
+    {0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00}, // 'U'
+    {0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00}, // 'V'
+    {0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00}, // 'W'
+    {0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00}, // 'X'
+    {0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00}, // 'Y'
+    {0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00}, // 'Z'
+    {0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00}, // '['
+    {0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00}, // '\'
+    {0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00}, // ']'
+    {0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00}, // '^'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF}, // '_'
+    {0x0C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00}, // '`'
+    {0x00, 0x00, 0x1E, 0x30, 0x3E, 0x33, 0x6E, 0x00}, // 'a'
+    {0x07, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3B, 0x00}, // 'b'
+    {0x00, 0x00, 0x1E, 0x33, 0x03, 0x33, 0x1E, 0x00}, // 'c'
+    {0x38, 0x30, 0x30, 0x3E, 0x33, 0x33, 0x6E, 0x00}, // 'd'
+    {0x00, 0x00, 0x1E, 0x33, 0x3F, 0x03, 0x1E, 0x00}, // 'e'
+    {0x1C, 0x36, 0x06, 0x0F, 0x06, 0x06, 0x0F, 0x00}, // 'f'
+    {0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x1F}, // 'g'
+    {0x07, 0x06, 0x36, 0x6E, 0x66, 0x66, 0x67, 0x00}, // 'h'
+    {0x0C, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // 'i'
+    {0x30, 0x00, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E}, // 'j'
+    {0x07, 0x06, 0x66, 0x36, 0x1E, 0x36, 0x67, 0x00}, // 'k'
+    {0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // 'l'
+    {0x00, 0x00, 0x33, 0x7F, 0x7F, 0x6B, 0x63, 0x00}, // 'm'
+    {0x00, 0x00, 0x1F, 0x33, 0x33, 0x33, 0x33, 0x00}, // 'n'
+    {0x00, 0x00, 0x1E, 0x33, 0x33, 0x33, 0x1E, 0x00}, // 'o'
+    {0x00, 0x00, 0x3B, 0x66, 0x66, 0x3E, 0x06, 0x0F}, // 'p'
+    {0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x78}, // 'q'
+    {0x00, 0x00, 0x3B, 0x6E, 0x66, 0x06, 0x0F, 0x00}, // 'r'
+    {0x00, 0x00, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x00}, // 's'
+    {0x08, 0x0C, 0x3E, 0x0C, 0x0C, 0x2C, 0x18, 0x00}, // 't'
+    {0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x6E, 0x00}, // 'u'
+    {0x00, 0x00, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00}, // 'v'
+    {0x00, 0x00, 0x63, 0x6B, 0x7F, 0x7F, 0x36, 0x00}, // 'w'
+    {0x00, 0x00, 0x63, 0x36, 0x1C, 0x36, 0x63, 0x00}, // 'x'
+    {0x00, 0x00, 0x33, 0x33, 0x33, 0x3E, 0x30, 0x1F}, // 'y'
+    {0x00, 0x00, 0x3F, 0x19, 0x0C, 0x26, 0x3F, 0x00}, // 'z'
+    {0x38, 0x0C, 0x0C, 0x07, 0x0C, 0x0C, 0x38, 0x00}, // '{'
+    {0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00}, // '|'
+    {0x07, 0x0C, 0x0C, 0x38, 0x0C, 0x0C, 0x07, 0x00}, // '}'
+    {0x6E, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}  // '~'
+};
+
+inline double vp_clamp01(double x) { return (x < 0.) ? 0. : ((x > 1.) ? 1. : x); }
+
+/*
+  Liang-Barsky clipping of the segment [(u1, v1), (u2, v2)] against the
+  rectangle umin <= u <= umax, vmin <= v <= vmax. Returns false if the segment
+  is outside of the rectangle, otherwise the extremities are moved on its
+  border.
+*/
+bool vp_clipSegment(double &u1, double &v1, double &u2, double &v2, double umin, double vmin, double umax,
+                    double vmax)
+{
+  const double f1[4] = {u1 - umin, umax - u1, v1 - vmin, vmax - v1};
+  const double f2[4] = {u2 - umin, umax - u2, v2 - vmin, vmax - v2};
+  double t1 = 0., t2 = 1.;
+
+  for (unsigned int k = 0; k < 4; k++) {
+    if (!(f1[k] >= 0. || f2[k] >= 0.)) // both outside, or NaN
+      return false;
+    if (f1[k] < 0.)
+      t1 = (std::max)(t1, f1[k] / (f1[k] - f2[k]));
+    else if (f2[k] < 0.)
+      t2 = (std::min)(t2, f1[k] / (f1[k] - f2[k]));
+    if (t1 > t2)
+      return false;
+  }
+
+  const double du = u2 - u1, dv = v2 - v1;
+  if (t2 < 1.) {
+    u2 = u1 + t2 * du;
+    v2 = v1 + t2 * dv;
+  }
+  if (t1 > 0.) {
+    u1 += t1 * du;
+    v1 += t1 * dv;
+  }
+  return true;
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Constructor. Initialize a display to render a gray level image (8 bits).
+
+  \param I : Image to be displayed (note that image has to be initialized)
+  \param scaleType : If this parameter is set to:
+  - vpDisplay::SCALE_AUTO or vpDisplay::SCALE_DEFAULT or vpDisplay::SCALE_1,
+  the rendered image has the same size than the image;
+  - vpDisplay::SCALE_2, the rendered image is down scaled by 2 along the lines
+  and the columns.
+  - and so on...
+*/
+vpDisplayOffscreen::vpDisplayOffscreen(vpImage<unsigned char> &I, vpScaleType scaleType)
+  : vpDisplay(), m_canvas(), m_antialiasing(false)
+{
+  setScale(scaleType, I.getWidth(), I.getHeight());
+  init(I);
+}
+
+/*!
+  Constructor. Initialize a display to render a gray level image (8 bits).
+
+  \param I : Image to be displayed (note that image has to be initialized)
+  \param x, y : Virtual window position, only kept for compatibility with the
+  other displays.
+  \param title : Virtual window title.
+  \param scaleType : Down scaling factor of the rendering, see
+  vpDisplayOffscreen(vpImage<unsigned char> &, vpScaleType).
+*/
+vpDisplayOffscreen::vpDisplayOffscreen(vpImage<unsigned char> &I, int x, int y, const std::string &title,
+                                       vpScaleType scaleType)
+  : vpDisplay(), m_canvas(), m_antialiasing(false)
+{
+  setScale(scaleType, I.getWidth(), I.getHeight());
+  init(I, x, y, title);
+}
+
+/*!
+  Constructor. Initialize a display to render a RGBa image (32 bits).
+
+  \param I : Image to be displayed (note that image has to be initialized)
+  \param scaleType : Down scaling factor of the rendering, see
+  vpDisplayOffscreen(vpImage<unsigned char> &, vpScaleType).
+*/
+vpDisplayOffscreen::vpDisplayOffscreen(vpImage<vpRGBa> &I, vpScaleType scaleType)
+  : vpDisplay(), m_canvas(), m_antialiasing(false)
+{
+  setScale(scaleType, I.getWidth(), I.getHeight());
+  init(I);
+}
+
+/*!
+  Constructor. Initialize a display to render a RGBa image (32 bits).
+
+  \param I : Image to be displayed (note that image has to be initialized)
+  \param x, y : Virtual window position, only kept for compatibility with the
+  other displays.
+  \param title : Virtual window title.
+  \param scaleType : Down scaling factor of the rendering, see
+  vpDisplayOffscreen(vpImage<unsigned char> &, vpScaleType).
+*/
+vpDisplayOffscreen::vpDisplayOffscreen(vpImage<vpRGBa> &I, int x, int y, const std::string &title,
+                                       vpScaleType scaleType)
+  : vpDisplay(), m_canvas(), m_antialiasing(false)
+{
+  setScale(scaleType, I.getWidth(), I.getHeight());
+  init(I, x, y, title);
+}
+
+/*!
+  Constructor that just initialize the virtual window position and title.
+  To initialize the display size, you need to call init().
+
+  \param x, y : Virtual window position.
+  \param title : Virtual window title.
+*/
+vpDisplayOffscreen::vpDisplayOffscreen(int x, int y, const std::string &title)
+  : vpDisplay(), m_canvas(), m_antialiasing(false)
+{
+  m_windowXPosition = x;
+  m_windowYPosition = y;
+  m_title = title;
+}
+
+/*!
+  Basic constructor. To initialize the display size, you need to call init().
+*/
+vpDisplayOffscreen::vpDisplayOffscreen() : vpDisplay(), m_canvas(), m_antialiasing(false) {}
+
+/*!
+  Destructor.
+*/
+vpDisplayOffscreen::~vpDisplayOffscreen() { closeDisplay(); }
+
+/*!
+  Initialize the display size, position and title for a gray level image.
+
+  \param I : Image to be displayed (note that image has to be initialized)
+  \param x, y : Virtual window position.
+  \param title : Virtual window title.
+*/
+void vpDisplayOffscreen::init(vpImage<unsigned char> &I, int x, int y, const std::string &title)
+{
+  if ((I.getHeight() == 0) || (I.getWidth() == 0)) {
+    throw(vpDisplayException(vpDisplayException::notInitializedError, "Image not initialized"));
+  }
+  setScale(m_scaleType, I.getWidth(), I.getHeight());
+  init(I.getWidth(), I.getHeight(), x, y, title);
+  I.display = this;
+}
+
+/*!
+  Initialize the display size, position and title for a RGBa image.
+
+  \param I : Image to be displayed (note that image has to be initialized)
+  \param x, y : Virtual window position.
+  \param title : Virtual window title.
+*/
+void vpDisplayOffscreen::init(vpImage<vpRGBa> &I, int x, int y, const std::string &title)
+{
+  if ((I.getHeight() == 0) || (I.getWidth() == 0)) {
+    throw(vpDisplayException(vpDisplayException::notInitializedError, "Image not initialized"));
+  }
+  setScale(m_scaleType, I.getWidth(), I.getHeight());
+  init(I.getWidth(), I.getHeight(), x, y, title);
+  I.display = this;
+}
+
+/*!
+  Initialize the display size, position and title. The rendering image is
+  allocated and set to black.
+
+  \param w, h : Width and height of the displayed images.
+  \param x, y : Virtual window position.
+  \param title : Virtual window title.
+*/
+void vpDisplayOffscreen::init(unsigned int w, unsigned int h, int x, int y, const std::string &title)
+{
+  setScale(m_scaleType, w, h);
+
+  m_width = w / m_scale;
+  m_height = h / m_scale;
+
+  if (x != -1)
+    m_windowXPosition = x;
+  if (y != -1)
+    m_windowYPosition = y;
+  if (!title.empty())
+    m_title = title;
+
+  m_canvas.resize(m_height, m_width);
+  clearDisplay(vpColor::black);
+
+  m_displayHasBeenInitialized = true;
+}
+
+/*!
+  The rendering always uses the built-in 8x8 bitmap font. This function has
+  no effect.
+*/
+void vpDisplayOffscreen::setFont(const std::string & /* font */) {}
+
+/*!
+  Set the virtual window title.
+
+  \param title : Window title.
+*/
+void vpDisplayOffscreen::setTitle(const std::string &title) { m_title = title; }
+
+/*!
+  Set the virtual window position.
+
+  \param x, y : Window position.
+*/
+void vpDisplayOffscreen::setWindowPosition(int x, int y)
+{
+  m_windowXPosition = x;
+  m_windowYPosition = y;
+}
+
+/*!
+  Copy the rendering in \e I.
+
+  \param I : Image updated with the displayed image and the overlay drawings.
+  Its size is the displayed image size divided by the down scaling factor.
+*/
+void vpDisplayOffscreen::getImage(vpImage<vpRGBa> &I)
+{
+  if (!m_displayHasBeenInitialized) {
+    throw(vpDisplayException(vpDisplayException::notInitializedError, "Offscreen display not initialized"));
+  }
+  I = m_canvas;
+}
+
+/*!
+  Return the virtual screen height. Since there is no screen, it is chosen
+  large enough so that vpDisplay::SCALE_AUTO does not down scale the images.
+*/
+unsigned int vpDisplayOffscreen::getScreenHeight() { return vp_offscreenScreenSize; }
+
+/*!
+  Return the virtual screen size, see getScreenHeight().
+*/
+void vpDisplayOffscreen::getScreenSize(unsigned int &w, unsigned int &h)
+{
+  w = vp_offscreenScreenSize;
+  h = vp_offscreenScreenSize;
+}
+
+/*!
+  Return the virtual screen width, see getScreenHeight().
+*/
+unsigned int vpDisplayOffscreen::getScreenWidth() { return vp_offscreenScreenSize; }
+
+/*!
+  Fill the rendering with \e color.
+
+  \param color : Background color.
+*/
+void vpDisplayOffscreen::clearDisplay(const vpColor &color)
+{
+  vpRGBa c(color.R, color.G, color.B, vpRGBa::alpha_default);
+  unsigned int size = m_canvas.getWidth() * m_canvas.getHeight();
+  for (unsigned int i = 0; i < size; i++)
+    m_canvas.bitmap[i] = c;
+}
+
+/*!
+  Release the rendering image.
+*/
+void vpDisplayOffscreen::closeDisplay()
+{
+  if (m_displayHasBeenInitialized) {
+    m_canvas.destroy();
+    m_displayHasBeenInitialized = false;
+  }
+}
+
+/*!
+  Display an arrow from image point \e ip1 to image point \e ip2.
+
+  \param ip1,ip2 : Initial and final image point.
+  \param color : Arrow color.
+  \param w,h : Width and height of the arrow.
+  \param thickness : Thickness of the lines used to display the arrow.
+*/
+void vpDisplayOffscreen::displayArrow(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color,
+                                      unsigned int w, unsigned int h, unsigned int thickness)
+{
+  double a = ip2.get_i() - ip1.get_i();
+  double b = ip2.get_j() - ip1.get_j();
+  double lg = sqrt(vpMath::sqr(a) + vpMath::sqr(b));
+
+  if ((std::fabs(a) > std::numeric_limits<double>::epsilon()) ||
+      (std::fabs(b) > std::numeric_limits<double>::epsilon())) {
+    a /= lg;
+    b /= lg;
+
+    vpImagePoint ip3;
+    ip3.set_i(ip2.get_i() - w * a);
+    ip3.set_j(ip2.get_j() - w * b);
+
+    vpImagePoint ip4;
+    ip4.set_i(ip3.get_i() - b * h);
+    ip4.set_j(ip3.get_j() + a * h);
+
+    if (lg > 2 * vpImagePoint::distance(ip2, ip4))
+      displayLine(ip2, ip4, color, thickness);
+
+    ip4.set_i(ip3.get_i() + b * h);
+    ip4.set_j(ip3.get_j() - a * h);
+
+    if (lg > 2 * vpImagePoint::distance(ip2, ip4))
+      displayLine(ip2, ip4, color, thickness);
+
+    displayLine(ip1, ip2, color, thickness);
+  }
+}
+
+/*!
+  Display a string with the built-in 8x8 font.
+
+  \param ip : Upper left image point location of the string.
+  \param text : String to display in overlay.
+  \param color : String color.
+*/
+void vpDisplayOffscreen::displayCharString(const vpImagePoint &ip, const char *text, const vpColor &color)
+{
+  int u0 = vpMath::round(ip.get_u() / m_scale);
+  int v0 = vpMath::round(ip.get_v() / m_scale);
+  size_t len = strlen(text);
+  for (size_t k = 0; k < len; k++) {
+    int c = (unsigned char)text[k];
+    if (c < 32 || c > 126)
+      c = '?';
+    const unsigned char *glyph = vp_offscreenFont[c - 32];
+    int u = u0 + 8 * (int)k;
+    for (int row = 0; row < 8; row++) {
+      for (int col = 0; col < 8; col++) {
+        if (glyph[row] & (1 << col))
+          blendPixel(u + col, v0 + row, color, 1.);
+      }
+    }
+  }
+}
+
+/*!
+  Display a circle.
+
+  \param center : Circle center position.
+  \param radius : Circle radius.
+  \param color : Circle color.
+  \param fill : When set to true fill the circle.
+  \param thickness : Thickness of the circle. This parameter is only useful
+  when \e fill is set to false.
+*/
+void vpDisplayOffscreen::displayCircle(const vpImagePoint &center, unsigned int radius, const vpColor &color,
+                                       bool fill, unsigned int thickness)
+{
+  double uc = center.get_u() / m_scale;
+  double vc = center.get_v() / m_scale;
+  double r = (double)radius / m_scale;
+  if (fill) {
+    drawDisc(uc, vc, r + 0.5, -1., color);
+  } else {
+    double half = 0.5 * (std::max)(thickness, 1u);
+    drawDisc(uc, vc, r + half, r - half, color);
+  }
+}
+
+/*!
+  Display a cross at the image point \e ip location.
+
+  \param ip : Cross location.
+  \param cross_size : Size (width and height) of the cross.
+  \param color : Cross color.
+  \param thickness : Thickness of the lines used to display the cross.
+*/
+void vpDisplayOffscreen::displayCross(const vpImagePoint &ip, unsigned int cross_size, const vpColor &color,
+                                      unsigned int thickness)
+{
+  double i = ip.get_i();
+  double j = ip.get_j();
+  vpImagePoint ip1, ip2;
+
+  ip1.set_i(i - cross_size / 2);
+  ip1.set_j(j);
+  ip2.set_i(i + cross_size / 2);
+  ip2.set_j(j);
+  displayLine(ip1, ip2, color, thickness);
+
+  ip1.set_i(i);
+  ip1.set_j(j - cross_size / 2);
+  ip2.set_i(i);
+  ip2.set_j(j + cross_size / 2);
+  displayLine(ip1, ip2, color, thickness);
+}
+
+/*!
+  Display a dashed line from image point \e ip1 to image point \e ip2.
+
+  \param ip1,ip2 : Initial and final image points.
+  \param color : Line color.
+  \param thickness : Line thickness.
+*/
+void vpDisplayOffscreen::displayDotLine(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color,
+                                        unsigned int thickness)
+{
+  double u1 = ip1.get_u() / m_scale;
+  double v1 = ip1.get_v() / m_scale;
+  double du = ip2.get_u() / m_scale - u1;
+  double dv = ip2.get_v() / m_scale - v1;
+  double lg = sqrt(du * du + dv * dv);
+  if (lg <= std::numeric_limits<double>::epsilon()) {
+    drawSegment(u1, v1, u1, v1, color, thickness);
+    return;
+  }
+  du /= lg;
+  dv /= lg;
+  for (double s = 0; s < lg; s += 2 * vp_offscreenDashLength) {
+    double e = (std::min)(s + vp_offscreenDashLength, lg);
+    drawSegment(u1 + s * du, v1 + s * dv, u1 + e * du, v1 + e * dv, color, thickness);
+  }
+}
+
+/*!
+  Display the gray level image \e I (8bits).
+
+  \param I : Image to display.
+*/
+void vpDisplayOffscreen::displayImage(const vpImage<unsigned char> &I)
+{
+  if (!m_displayHasBeenInitialized) {
+    throw(vpDisplayException(vpDisplayException::notInitializedError, "Offscreen display not initialized"));
+  }
+  unsigned int h = (std::min)(m_height, I.getHeight() / m_scale);
+  unsigned int w = (std::min)(m_width, I.getWidth() / m_scale);
+  for (unsigned int i = 0; i < h; i++) {
+    const unsigned char *src = I[i * m_scale];
+    vpRGBa *dst = m_canvas[i];
+    for (unsigned int j = 0; j < w; j++) {
+      unsigned char val = src[j * m_scale];
+      dst[j] = vpRGBa(val, val, val, vpRGBa::alpha_default);
+    }
+  }
+}
+
+/*!
+  Display the color image \e I in RGBa format (32bits).
+
+  \param I : Image to display.
+*/
+void vpDisplayOffscreen::displayImage(const vpImage<vpRGBa> &I)
+{
+  if (!m_displayHasBeenInitialized) {
+    throw(vpDisplayException(vpDisplayException::notInitializedError, "Offscreen display not initialized"));
+  }
+  unsigned int h = (std::min)(m_height, I.getHeight() / m_scale);
+  unsigned int w = (std::min)(m_width, I.getWidth() / m_scale);
+  for (unsigned int i = 0; i < h; i++) {
+    const vpRGBa *src = I[i * m_scale];
+    vpRGBa *dst = m_canvas[i];
+    if (m_scale == 1) {
+      std::copy(src, src + w, dst);
+    } else {
+      for (unsigned int j = 0; j < w; j++)
+        dst[j] = src[j * m_scale];
+    }
+  }
+}
+
+/*!
+  Display a selection of the gray level image \e I (8bits).
+
+  \param I : Image to display.
+  \param iP : Top left corner of the region of interest
+  \param w, h : Width and height of the region of interest
+*/
+void vpDisplayOffscreen::displayImageROI(const vpImage<unsigned char> &I, const vpImagePoint &iP,
+                                         const unsigned int w, const unsigned int h)
+{
+  if (!m_displayHasBeenInitialized) {
+    throw(vpDisplayException(vpDisplayException::notInitializedError, "Offscreen display not initialized"));
+  }
+  int i_min = (std::max)((int)ceil(iP.get_i() / m_scale), 0);
+  int j_min = (std::max)((int)ceil(iP.get_j() / m_scale), 0);
+  int i_max = (std::min)((int)ceil((iP.get_i() + h) / m_scale), (int)(std::min)(m_height, I.getHeight() / m_scale));
+  int j_max = (std::min)((int)ceil((iP.get_j() + w) / m_scale), (int)(std::min)(m_width, I.getWidth() / m_scale));
+
+  for (int i = i_min; i < i_max; i++) {
+    const unsigned char *src = I[(unsigned int)i * m_scale];
+    vpRGBa *dst = m_canvas[(unsigned int)i];
+    for (int j = j_min; j < j_max; j++) {
+      unsigned char val = src[(unsigned int)j * m_scale];
+      dst[j] = vpRGBa(val, val, val, vpRGBa::alpha_default);
+    }
+  }
+}
+
+/*!
+  Display a selection of the color image \e I in RGBa format (32bits).
+
+  \param I : Image to display.
+  \param iP : Top left corner of the region of interest
+  \param w, h : Width and height of the region of interest
+*/
+void vpDisplayOffscreen::displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &iP, const unsigned int w,
+                                         const unsigned int h)
+{
+  if (!m_displayHasBeenInitialized) {
+    throw(vpDisplayException(vpDisplayException::notInitializedError, "Offscreen display not initialized"));
+  }
+  int i_min = (std::max)((int)ceil(iP.get_i() / m_scale), 0);
+  int j_min = (std::max)((int)ceil(iP.get_j() / m_scale), 0);
+  int i_max = (std::min)((int)ceil((iP.get_i() + h) / m_scale), (int)(std::min)(m_height, I.getHeight() / m_scale));
+  int j_max = (std::min)((int)ceil((iP.get_j() + w) / m_scale), (int)(std::min)(m_width, I.getWidth() / m_scale));
+
+  for (int i = i_min; i < i_max; i++) {
+    const vpRGBa *src = I[(unsigned int)i * m_scale];
+    vpRGBa *dst = m_canvas[(unsigned int)i];
+    for (int j = j_min; j < j_max; j++)
+      dst[j] = src[(unsigned int)j * m_scale];
+  }
+}
+
+/*!
+  Display a line from image point \e ip1 to image point \e ip2.
+
+  \param ip1,ip2 : Initial and final image points.
+  \param color : Line color.
+  \param thickness : Line thickness.
+*/
+void vpDisplayOffscreen::displayLine(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color,
+                                     unsigned int thickness)
+{
+  drawSegment(ip1.get_u() / m_scale, ip1.get_v() / m_scale, ip2.get_u() / m_scale, ip2.get_v() / m_scale, color,
+              thickness);
+}
+
+/*!
+  Display a point at the image point \e ip location.
+
+  \param ip : Point location.
+  \param color : Point color.
+  \param thickness : Point thickness.
+*/
+void vpDisplayOffscreen::displayPoint(const vpImagePoint &ip, const vpColor &color, unsigned int thickness)
+{
+  int u = vpMath::round(ip.get_u() / m_scale);
+  int v = vpMath::round(ip.get_v() / m_scale);
+  if (thickness <= 1) {
+    blendPixel(u, v, color, 1.);
+  } else {
+    fillRect(u, v, (int)thickness, (int)thickness, color);
+  }
+}
+
+/*!
+  Display a rectangle with \e topLeft as the top-left corner and \e
+  width and \e height the rectangle size.
+
+  \param topLeft : Top-left corner of the rectangle.
+  \param w,h : Rectangle size in terms of width and height.
+  \param color : Rectangle color.
+  \param fill : When set to true fill the rectangle.
+  \param thickness : Thickness of the four lines used to display the
+  rectangle. This parameter is only useful when \e fill is set to
+  false.
+*/
+void vpDisplayOffscreen::displayRectangle(const vpImagePoint &topLeft, unsigned int w, unsigned int h,
+                                          const vpColor &color, bool fill, unsigned int thickness)
+{
+  drawRectangle(vpMath::round(topLeft.get_u() / m_scale), vpMath::round(topLeft.get_v() / m_scale),
+                (int)(w / m_scale), (int)(h / m_scale), color, fill, thickness);
+}
+
+/*!
+  Display a rectangle.
+
+  \param topLeft : Top-left corner of the rectangle.
+  \param bottomRight : Bottom-right corner of the rectangle.
+  \param color : Rectangle color.
+  \param fill : When set to true fill the rectangle.
+  \param thickness : Thickness of the four lines used to display the
+  rectangle. This parameter is only useful when \e fill is set to
+  false.
+*/
+void vpDisplayOffscreen::displayRectangle(const vpImagePoint &topLeft, const vpImagePoint &bottomRight,
+                                          const vpColor &color, bool fill, unsigned int thickness)
+{
+  vpImagePoint topLeft_ = topLeft / m_scale;
+  vpImagePoint bottomRight_ = bottomRight / m_scale;
+  int w = vpMath::round(std::fabs(bottomRight_.get_u() - topLeft_.get_u()));
+  int h = vpMath::round(std::fabs(bottomRight_.get_v() - topLeft_.get_v()));
+  drawRectangle(vpMath::round((std::min)(topLeft_.get_u(), bottomRight_.get_u())),
+                vpMath::round((std::min)(topLeft_.get_v(), bottomRight_.get_v())), w, h, color, fill, thickness);
+}
+
+/*!
+  Display a rectangle.
+
+  \param rectangle : Rectangle characteristics.
+  \param color : Rectangle color.
+  \param fill : When set to true fill the rectangle.
+  \param thickness : Thickness of the four lines used to display the
+  rectangle. This parameter is only useful when \e fill is set to
+  false.
+*/
+void vpDisplayOffscreen::displayRectangle(const vpRect &rectangle, const vpColor &color, bool fill,
+                                          unsigned int thickness)
+{
+  int w = vpMath::round(rectangle.getWidth() / m_scale);
+  int h = vpMath::round(rectangle.getHeight() / m_scale);
+  if (!fill) {
+    // Like the other displays, the outline is drawn inside the rectangle
+    w--;
+    h--;
+  }
+  drawRectangle(vpMath::round(rectangle.getLeft() / m_scale), vpMath::round(rectangle.getTop() / m_scale), w, h,
+                color, fill, thickness);
+}
+
+/*!
+  The rendering is always up to date. This function does nothing.
+*/
+void vpDisplayOffscreen::flushDisplay() {}
+
+/*!
+  The rendering is always up to date. This function does nothing.
+*/
+void vpDisplayOffscreen::flushDisplayROI(const vpImagePoint & /* iP */, const unsigned int /* width */,
+                                         const unsigned int /* height */)
+{
+}
+
+/*!
+  There is no user interaction with an offscreen display.
+
+  \return Always false.
+*/
+bool vpDisplayOffscreen::getClick(bool /* blocking */) { return false; }
+
+/*!
+  There is no user interaction with an offscreen display.
+
+  \return Always false.
+*/
+bool vpDisplayOffscreen::getClick(vpImagePoint & /* ip */, bool /* blocking */) { return false; }
+
+/*!
+  There is no user interaction with an offscreen display.
+
+  \return Always false.
+*/
+bool vpDisplayOffscreen::getClick(vpImagePoint & /* ip */, vpMouseButton::vpMouseButtonType & /* button */,
+                                  bool /* blocking */)
+{
+  return false;
+}
+
+/*!
+  There is no user interaction with an offscreen display.
+
+  \return Always false.
+*/
+bool vpDisplayOffscreen::getClickUp(vpImagePoint & /* ip */, vpMouseButton::vpMouseButtonType & /* button */,
+                                    bool /* blocking */)
+{
+  return false;
+}
+
+/*!
+  There is no user interaction with an offscreen display.
+
+  \return Always false.
+*/
+bool vpDisplayOffscreen::getKeyboardEvent(bool /* blocking */) { return false; }
+
+/*!
+  There is no user interaction with an offscreen display.
+
+  \return Always false.
+*/
+bool vpDisplayOffscreen::getKeyboardEvent(std::string & /* key */, bool /* blocking */) { return false; }
+
+/*!
+  There is no user interaction with an offscreen display.
+
+  \return Always false.
+*/
+bool vpDisplayOffscreen::getPointerMotionEvent(vpImagePoint & /* ip */) { return false; }
+
+/*!
+  There is no user interaction with an offscreen display.
+
+  \return Always false.
+*/
+bool vpDisplayOffscreen::getPointerPosition(vpImagePoint & /* ip */) { return false; }
+
+/*!
+  Blend \e color with the pixel (\e u, \e v) of the rendering.
+
+  \param u, v : Pixel location; ignored when outside the rendering.
+  \param color : Color to draw.
+  \param alpha : Coverage of the pixel, between 0 and 1.
+*/
+void vpDisplayOffscreen::blendPixel(int u, int v, const vpRGBa &color, double alpha)
+{
+  if (u < 0 || v < 0 || u >= (int)m_canvas.getWidth() || v >= (int)m_canvas.getHeight() || alpha <= 0.)
+    return;
+
+  vpRGBa &dst = m_canvas[(unsigned int)v][(unsigned int)u];
+  if (alpha >= 1.) {
+    dst.R = color.R;
+    dst.G = color.G;
+    dst.B = color.B;
+  } else {
+    dst.R = (unsigned char)(dst.R + alpha * ((int)color.R - (int)dst.R) + 0.5);
+    dst.G = (unsigned char)(dst.G + alpha * ((int)color.G - (int)dst.G) + 0.5);
+    dst.B = (unsigned char)(dst.B + alpha * ((int)color.B - (int)dst.B) + 0.5);
+  }
+}
+
+/*!
+  Draw the pixels whose center distance to (\e uc, \e vc) is between \e r_in
+  and \e r_out. When anti-aliasing is enabled, the pixels on the borders are
+  blended according to their approximated coverage.
+
+  \param uc, vc : Center.
+  \param r_out : Outer radius.
+  \param r_in : Inner radius, negative to draw a disc.
+  \param color : Color to draw.
+*/
+void vpDisplayOffscreen::drawDisc(double uc, double vc, double r_out, double r_in, const vpRGBa &color)
+{
+  // With anti-aliasing, pixels partially covered by the one pixel wide
+  // border around the radii are also drawn
+  double border = m_antialiasing ? 0.5 : 0.;
+  double r_ext = r_out + border;
+  double r_int = r_in - border;
+
+  int v_min = (std::max)((int)floor(vc - r_ext), 0);
+  int v_max = (std::min)((int)ceil(vc + r_ext), (int)m_canvas.getHeight() - 1);
+  for (int v = v_min; v <= v_max; v++) {
+    double dv = v - vc;
+    double dv2 = dv * dv;
+    if (dv2 > r_ext * r_ext)
+      continue;
+    double du_ext = sqrt(r_ext * r_ext - dv2);
+    // Half width of the hole of the ring in this row
+    double du_int = (r_int > 0. && dv2 < r_int * r_int) ? sqrt(r_int * r_int - dv2) : -1.;
+
+    int u_min = (std::max)((int)ceil(uc - du_ext), 0);
+    int u_max = (std::min)((int)floor(uc + du_ext), (int)m_canvas.getWidth() - 1);
+    for (int u = u_min; u <= u_max; u++) {
+      double du = u - uc;
+      if (std::fabs(du) < du_int) {
+        // Jump over the hole
+        u = (int)floor(uc + du_int);
+        continue;
+      }
+      if (m_antialiasing) {
+        double d = sqrt(du * du + dv2);
+        double alpha = vp_clamp01(r_out - d + 0.5);
+        if (r_in > 0.)
+          alpha *= vp_clamp01(d - r_in + 0.5);
+        blendPixel(u, v, color, alpha);
+      } else {
+        blendPixel(u, v, color, 1.);
+      }
+    }
+  }
+}
+
+/*!
+  Draw a segment with a given thickness. Thick segments are drawn as filled
+  polygons with butt ends.
+
+  \param u1, v1, u2, v2 : Segment extremities in the rendering.
+  \param color : Color to draw.
+  \param thickness : Segment thickness.
+*/
+void vpDisplayOffscreen::drawSegment(double u1, double v1, double u2, double v2, const vpRGBa &color,
+                                     unsigned int thickness)
+{
+  if (thickness <= 1) {
+    drawSegmentThin(u1, v1, u2, v2, color);
+    return;
+  }
+
+  double du = u2 - u1;
+  double dv = v2 - v1;
+  double lg = sqrt(du * du + dv * dv);
+  double half = 0.5 * thickness;
+  if (lg <= std::numeric_limits<double>::epsilon()) {
+    fillRect(vpMath::round(u1 - half), vpMath::round(v1 - half), (int)thickness, (int)thickness, color);
+    return;
+  }
+  // Normal to the segment with a length of half the thickness
+  double nu = -dv / lg * half;
+  double nv = du / lg * half;
+  double u[4] = {u1 + nu, u2 + nu, u2 - nu, u1 - nu};
+  double v[4] = {v1 + nv, v2 + nv, v2 - nv, v1 - nv};
+  fillPolygon(u, v, 4, color);
+  if (m_antialiasing) {
+    drawSegmentThin(u[0], v[0], u[1], v[1], color);
+    drawSegmentThin(u[2], v[2], u[3], v[3], color);
+  }
+}
+
+/*!
+  Draw a one pixel wide segment, with the Bresenham algorithm or with the Wu
+  algorithm when anti-aliasing is enabled.
+
+  \param u1, v1, u2, v2 : Segment extremities in the rendering.
+  \param color : Color to draw.
+*/
+void vpDisplayOffscreen::drawSegmentThin(double u1, double v1, double u2, double v2, const vpRGBa &color)
+{
+  // Only rasterize the part of the segment in the canvas. The one pixel
+  // margin keeps the anti-aliased border pixels.
+  if (!vp_clipSegment(u1, v1, u2, v2, -1., -1., (double)m_canvas.getWidth(), (double)m_canvas.getHeight())) {
+    return;
+  }
+
+  if (!m_antialiasing) {
+    int x1 = vpMath::round(u1), y1 = vpMath::round(v1);
+    int x2 = vpMath::round(u2), y2 = vpMath::round(v2);
+    int dx = std::abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
+    int dy = -std::abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
+    int err = dx + dy;
+    for (;;) {
+      blendPixel(x1, y1, color, 1.);
+      if (x1 == x2 && y1 == y2)
+        break;
+      int e2 = 2 * err;
+      if (e2 >= dy) {
+        err += dy;
+        x1 += sx;
+      }
+      if (e2 <= dx) {
+        err += dx;
+        y1 += sy;
+      }
+    }
+    return;
+  }
+
+  // Wu algorithm: iterate along the major axis, split the intensity between
+  // the two pixels closest to the segment along the minor axis
+  bool steep = std::fabs(v2 - v1) > std::fabs(u2 - u1);
+  if (steep) {
+    std::swap(u1, v1);
+    std::swap(u2, v2);
+  }
+  if (u1 > u2) {
+    std::swap(u1, u2);
+    std::swap(v1, v2);
+  }
+  double gradient = (u2 - u1 > std::numeric_limits<double>::epsilon()) ? (v2 - v1) / (u2 - u1) : 0.;
+  int x_start = vpMath::round(u1);
+  int x_end = vpMath::round(u2);
+  double y = v1 + gradient * (x_start - u1);
+  for (int x = x_start; x <= x_end; x++) {
+    double y_floor = floor(y);
+    double frac = y - y_floor;
+    if (steep) {
+      blendPixel((int)y_floor, x, color, 1. - frac);
+      blendPixel((int)y_floor + 1, x, color, frac);
+    } else {
+      blendPixel(x, (int)y_floor, color, 1. - frac);
+      blendPixel(x, (int)y_floor + 1, color, frac);
+    }
+    y += gradient;
+  }
+}
+
+/*!
+  Fill a polygon with the scanline algorithm. A pixel is drawn when its
+  center is inside the polygon.
+
+  \param u, v : Coordinates of the polygon vertices.
+  \param n : Number of vertices.
+  \param color : Color to draw.
+*/
+void vpDisplayOffscreen::fillPolygon(const double *u, const double *v, unsigned int n, const vpRGBa &color)
+{
+  double v_lo = v[0], v_hi = v[0];
+  for (unsigned int k = 1; k < n; k++) {
+    v_lo = (std::min)(v_lo, v[k]);
+    v_hi = (std::max)(v_hi, v[k]);
+  }
+  int v_min = (std::max)((int)ceil(v_lo), 0);
+  int v_max = (std::min)((int)floor(v_hi), (int)m_canvas.getHeight() - 1);
+
+  std::vector<double> crossings;
+  for (int y = v_min; y <= v_max; y++) {
+    crossings.clear();
+    for (unsigned int k = 0; k < n; k++) {
+      unsigned int l = (k + 1) % n;
+      // Half open rule so that a vertex on the scanline is counted once
+      if ((v[k] <= y && v[l] > y) || (v[l] <= y && v[k] > y)) {
+        crossings.push_back(u[k] + (y - v[k]) / (v[l] - v[k]) * (u[l] - u[k]));
+      }
+    }
+    std::sort(crossings.begin(), crossings.end());
+    for (size_t k = 0; k + 1 < crossings.size(); k += 2) {
+      int x_min = (std::max)((int)ceil(crossings[k]), 0);
+      int x_max = (std::min)((int)floor(crossings[k + 1]), (int)m_canvas.getWidth() - 1);
+      vpRGBa *row = m_canvas[(unsigned int)y];
+      for (int x = x_min; x <= x_max; x++) {
+        row[x].R = color.R;
+        row[x].G = color.G;
+        row[x].B = color.B;
+      }
+    }
+  }
+}
+
+/*!
+  Fill a rectangle.
+
+  \param u, v : Top left corner.
+  \param w, h : Size of the rectangle.
+  \param color : Color to draw.
+*/
+void vpDisplayOffscreen::fillRect(int u, int v, int w, int h, const vpRGBa &color)
+{
+  int u_min = (std::max)(u, 0);
+  int v_min = (std::max)(v, 0);
+  int u_max = (std::min)(u + w, (int)m_canvas.getWidth());
+  int v_max = (std::min)(v + h, (int)m_canvas.getHeight());
+  for (int y = v_min; y < v_max; y++) {
+    vpRGBa *row = m_canvas[(unsigned int)y];
+    for (int x = u_min; x < u_max; x++) {
+      row[x].R = color.R;
+      row[x].G = color.G;
+      row[x].B = color.B;
+    }
+  }
+}
+
+/*!
+  Draw a rectangle. The outline is centered on the border of the rectangle
+  that spans from \e u to \e u + \e w and from \e v to \e v + \e h.
+
+  \param u, v : Top left corner.
+  \param w, h : Size of the rectangle.
+  \param color : Color to draw.
+  \param fill : When true, fill the rectangle.
+  \param thickness : Thickness of the outline.
+*/
+void vpDisplayOffscreen::drawRectangle(int u, int v, int w, int h, const vpRGBa &color, bool fill,
+                                       unsigned int thickness)
+{
+  if (fill) {
+    fillRect(u, v, w, h, color);
+    return;
+  }
+  int t = (int)(std::max)(thickness, 1u);
+  int half = t / 2;
+  fillRect(u - half, v - half, w + t, t, color);     // top
+  fillRect(u - half, v + h - half, w + t, t, color); // bottom
+  fillRect(u - half, v - half, t, h + t, color);     // left
+  fillRect(u + w - half, v - half, t, h + t, color); // right
+}
@@ -62,6 +62,97 @@
 // math
 #include <visp3/core/vpMath.h>
 
+#ifdef VISP_HAVE_X11_XSHM
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#endif
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+
+#if defined __SSSE3__ || (defined _MSC_VER && _MSC_VER >= 1500)
+#include <tmmintrin.h>
+#define VISP_HAVE_SSSE3 1
+#endif
+#endif
+
+#include <visp3/core/vpCPUFeatures.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Beyond this number of dirty rectangles, they are merged in their bounding
+// box to bound the number of requests sent at each flush
+const size_t vp_maxDirtyRects = 32;
+
+/*
+  Convert gray levels to 32 bits little endian BGRA pixels.
+*/
+void vp_greyToBGRA(const unsigned char *src, unsigned char *dst, unsigned int size)
+{
+  unsigned int i = 0;
+#if VISP_HAVE_SSE2
+  if (size >= 16) {
+    const __m128i alpha = _mm_set1_epi8((char)vpRGBa::alpha_default);
+    for (; i <= size - 16; i += 16) {
+      const __m128i grey = _mm_loadu_si128((const __m128i *)(src + i));
+      // (g, g) and (g, alpha) pairs, then (g, g, g, alpha) quadruplets
+      const __m128i gg_lo = _mm_unpacklo_epi8(grey, grey);
+      const __m128i gg_hi = _mm_unpackhi_epi8(grey, grey);
+      const __m128i ga_lo = _mm_unpacklo_epi8(grey, alpha);
+      const __m128i ga_hi = _mm_unpackhi_epi8(grey, alpha);
+      _mm_storeu_si128((__m128i *)(dst + 4 * i), _mm_unpacklo_epi16(gg_lo, ga_lo));
+      _mm_storeu_si128((__m128i *)(dst + 4 * i + 16), _mm_unpackhi_epi16(gg_lo, ga_lo));
+      _mm_storeu_si128((__m128i *)(dst + 4 * i + 32), _mm_unpacklo_epi16(gg_hi, ga_hi));
+      _mm_storeu_si128((__m128i *)(dst + 4 * i + 48), _mm_unpackhi_epi16(gg_hi, ga_hi));
+    }
+  }
+#endif
+  for (; i < size; i++) {
+    unsigned char val = src[i];
+    dst[4 * i] = val;     // Blue
+    dst[4 * i + 1] = val; // Green
+    dst[4 * i + 2] = val; // Red
+    dst[4 * i + 3] = vpRGBa::alpha_default;
+  }
+}
+
+/*
+  Convert RGBa pixels to 32 bits little endian BGRA pixels.
+*/
+void vp_RGBaToBGRA(const vpRGBa *src, unsigned char *dst, unsigned int size)
+{
+  unsigned int i = 0;
+#if VISP_HAVE_SSSE3
+  if (size >= 4 && vpCPUFeatures::checkSSSE3()) {
+    const __m128i mask = _mm_set_epi8(15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2);
+    for (; i <= size - 4; i += 4) {
+      const __m128i rgba = _mm_loadu_si128((const __m128i *)(src + i));
+      _mm_storeu_si128((__m128i *)(dst + 4 * i), _mm_shuffle_epi8(rgba, mask));
+    }
+  }
+#endif
+  for (; i < size; i++) {
+    dst[4 * i] = src[i].B;
+    dst[4 * i + 1] = src[i].G;
+    dst[4 * i + 2] = src[i].R;
+    dst[4 * i + 3] = src[i].A;
+  }
+}
+
+#ifdef VISP_HAVE_X11_XSHM
+bool vp_shmError = false;
+
+int vp_shmErrorHandler(Display *, XErrorEvent *)
+{
+  vp_shmError = true;
+  return 0;
+}
+#endif
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
 
   Constructor : initialize a display to visualize a gray level image
@@ -86,7 +177,11 @@
 vpDisplayX::vpDisplayX(vpImage<unsigned char> &I, vpScaleType scaleType)
   : display(NULL), window(), Ximage(NULL), lut(), context(), screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false), RMask(0), GMask(0), BMask(0), RShift(0), GShift(0),
-    BShift(0)
+    BShift(0),
+#ifdef VISP_HAVE_X11_XSHM
+    m_shmInfo(),
+#endif
+    m_useShm(false), m_shmPending(false), m_font(NULL), m_dirtyRects(), m_dirtyAll(false)
 {
   setScale(scaleType, I.getWidth(), I.getHeight());
 
@@ -119,7 +214,11 @@ vpDisplayX::vpDisplayX(vpImage<unsigned char> &I, vpScaleType scaleType)
 vpDisplayX::vpDisplayX(vpImage<unsigned char> &I, int x, int y, const std::string &title, vpScaleType scaleType)
   : display(NULL), window(), Ximage(NULL), lut(), context(), screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false), RMask(0), GMask(0), BMask(0), RShift(0), GShift(0),
-    BShift(0)
+    BShift(0),
+#ifdef VISP_HAVE_X11_XSHM
+    m_shmInfo(),
+#endif
+    m_useShm(false), m_shmPending(false), m_font(NULL), m_dirtyRects(), m_dirtyAll(false)
 {
   setScale(scaleType, I.getWidth(), I.getHeight());
   init(I, x, y, title);
@@ -147,7 +246,11 @@ vpDisplayX::vpDisplayX(vpImage<unsigned char> &I, int x, int y, const std::strin
 vpDisplayX::vpDisplayX(vpImage<vpRGBa> &I, vpScaleType scaleType)
   : display(NULL), window(), Ximage(NULL), lut(), context(), screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false), RMask(0), GMask(0), BMask(0), RShift(0), GShift(0),
-    BShift(0)
+    BShift(0),
+#ifdef VISP_HAVE_X11_XSHM
+    m_shmInfo(),
+#endif
+    m_useShm(false), m_shmPending(false), m_font(NULL), m_dirtyRects(), m_dirtyAll(false)
 {
   setScale(scaleType, I.getWidth(), I.getHeight());
   init(I);
@@ -177,7 +280,11 @@ vpDisplayX::vpDisplayX(vpImage<vpRGBa> &I, vpScaleType scaleType)
 vpDisplayX::vpDisplayX(vpImage<vpRGBa> &I, int x, int y, const std::string &title, vpScaleType scaleType)
   : display(NULL), window(), Ximage(NULL), lut(), context(), screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false), RMask(0), GMask(0), BMask(0), RShift(0), GShift(0),
-    BShift(0)
+    BShift(0),
+#ifdef VISP_HAVE_X11_XSHM
+    m_shmInfo(),
+#endif
+    m_useShm(false), m_shmPending(false), m_font(NULL), m_dirtyRects(), m_dirtyAll(false)
 {
   setScale(scaleType, I.getWidth(), I.getHeight());
   init(I, x, y, title);
@@ -208,7 +315,11 @@ int main()
 vpDisplayX::vpDisplayX(int x, int y, const std::string &title)
   : display(NULL), window(), Ximage(NULL), lut(), context(), screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false), RMask(0), GMask(0), BMask(0), RShift(0), GShift(0),
-    BShift(0)
+    BShift(0),
+#ifdef VISP_HAVE_X11_XSHM
+    m_shmInfo(),
+#endif
+    m_useShm(false), m_shmPending(false), m_font(NULL), m_dirtyRects(), m_dirtyAll(false)
 {
   m_windowXPosition = x;
   m_windowYPosition = y;
@@ -238,7 +349,11 @@ int main()
 vpDisplayX::vpDisplayX()
   : display(NULL), window(), Ximage(NULL), lut(), context(), screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false), RMask(0), GMask(0), BMask(0), RShift(0), GShift(0),
-    BShift(0)
+    BShift(0),
+#ifdef VISP_HAVE_X11_XSHM
+    m_shmInfo(),
+#endif
+    m_useShm(false), m_shmPending(false), m_font(NULL), m_dirtyRects(), m_dirtyAll(false)
 {
 }
 
@@ -659,13 +774,7 @@ void vpDisplayX::init(vpImage<unsigned char> &I, int x, int y, const std::string
   //    XNextEvent ( display, &event );
   //  while ( event.xany.type != Expose );
 
-  {
-    Ximage = XCreateImage(display, DefaultVisual(display, screen), screen_depth, ZPixmap, 0, NULL, m_width, m_height,
-                          XBitmapPad(display), 0);
-
-    Ximage->data = (char *)malloc(m_height * (unsigned int)Ximage->bytes_per_line);
-    ximage_data_init = true;
-  }
+  createXImage();
   m_displayHasBeenInitialized = true;
 
   XStoreName(display, window, m_title.c_str());
@@ -1091,13 +1200,7 @@ void vpDisplayX::init(vpImage<vpRGBa> &I, int x, int y, const std::string &title
   //    XNextEvent ( display, &event );
   //  while ( event.xany.type != Expose );
 
-  {
-    Ximage = XCreateImage(display, DefaultVisual(display, screen), screen_depth, ZPixmap, 0, NULL, m_width, m_height,
-                          XBitmapPad(display), 0);
-
-    Ximage->data = (char *)malloc(m_height * (unsigned int)Ximage->bytes_per_line);
-    ximage_data_init = true;
-  }
+  createXImage();
   m_displayHasBeenInitialized = true;
 
   XSync(display, true);
@@ -1542,13 +1645,7 @@ void vpDisplayX::init(unsigned int w, unsigned int h, int x, int y, const std::s
   //    XNextEvent ( display, &event );
   //  while ( event.xany.type != Expose );
 
-  {
-    Ximage = XCreateImage(display, DefaultVisual(display, screen), screen_depth, ZPixmap, 0, NULL, m_width, m_height,
-                          XBitmapPad(display), 0);
-
-    Ximage->data = (char *)malloc(m_height * (unsigned int)Ximage->bytes_per_line);
-    ximage_data_init = true;
-  }
+  createXImage();
   m_displayHasBeenInitialized = true;
 
   XSync(display, true);
@@ -1578,6 +1675,9 @@ void vpDisplayX::setFont(const std::string &font)
         Font stringfont;
         stringfont = XLoadFont(display, font.c_str()); //"-adobe-times-bold-r-normal--18*");
         XSetFont(display, context, stringfont);
+        if (m_font != NULL)
+          XFreeFontInfo(NULL, m_font, 1);
+        m_font = XQueryFont(display, stringfont);
       } catch (...) {
         throw(vpDisplayException(vpDisplayException::notInitializedError, "Bad font"));
       }
@@ -1634,6 +1734,7 @@ void vpDisplayX::setWindowPosition(int winx, int winy)
 void vpDisplayX::displayImage(const vpImage<unsigned char> &I)
 {
   if (m_displayHasBeenInitialized) {
+    waitXImage();
     switch (screen_depth) {
     case 8: {
       // Correction de l'image de facon a liberer les niveaux de gris
@@ -1670,7 +1771,7 @@ void vpDisplayX::displayImage(const vpImage<unsigned char> &I)
       }
 
       // Affichage de l'image dans la Pixmap.
-      XPutImage(display, pixmap, context, Ximage, 0, 0, 0, 0, m_width, m_height);
+      putXImage(0, 0, m_width, m_height);
       XSetWindowBackgroundPixmap(display, window, pixmap);
       break;
     }
@@ -1695,7 +1796,7 @@ void vpDisplayX::displayImage(const vpImage<unsigned char> &I)
       }
 
       // Affichage de l'image dans la Pixmap.
-      XPutImage(display, pixmap, context, Ximage, 0, 0, 0, 0, m_width, m_height);
+      putXImage(0, 0, m_width, m_height);
       XSetWindowBackgroundPixmap(display, window, pixmap);
       break;
     }
@@ -1720,13 +1821,7 @@ void vpDisplayX::displayImage(const vpImage<unsigned char> &I)
           }
         } else {
           // little endian
-          while (bitmap < n) {
-            unsigned char val = *(bitmap++);
-            *(dst_32++) = val; // Blue
-            *(dst_32++) = val; // Green
-            *(dst_32++) = val; // Red
-            *(dst_32++) = vpRGBa::alpha_default;
-          }
+          vp_greyToBGRA(bitmap, dst_32, size_);
         }
       } else {
         if (XImageByteOrder(display) == 1) {
@@ -1755,7 +1850,7 @@ void vpDisplayX::displayImage(const vpImage<unsigned char> &I)
       }
 
       // Affichage de l'image dans la Pixmap.
-      XPutImage(display, pixmap, context, Ximage, 0, 0, 0, 0, m_width, m_height);
+      putXImage(0, 0, m_width, m_height);
       XSetWindowBackgroundPixmap(display, window, pixmap);
       break;
     }
@@ -1778,6 +1873,7 @@ void vpDisplayX::displayImage(const vpImage<unsigned char> &I)
 void vpDisplayX::displayImage(const vpImage<vpRGBa> &I)
 {
   if (m_displayHasBeenInitialized) {
+    waitXImage();
     switch (screen_depth) {
     case 16: {
       vpRGBa *bitmap = I.bitmap;
@@ -1813,7 +1909,7 @@ void vpDisplayX::displayImage(const vpImage<vpRGBa> &I)
         }
       }
 
-      XPutImage(display, pixmap, context, Ximage, 0, 0, 0, 0, m_width, m_height);
+      putXImage(0, 0, m_width, m_height);
       XSetWindowBackgroundPixmap(display, window, pixmap);
 
       break;
@@ -1839,13 +1935,7 @@ void vpDisplayX::displayImage(const vpImage<vpRGBa> &I)
           }
         } else {
           // little endian
-          for (unsigned int i = 0; i < sizeI; i++) {
-            *(dst_32++) = bitmap->B;
-            *(dst_32++) = bitmap->G;
-            *(dst_32++) = bitmap->R;
-            *(dst_32++) = bitmap->A;
-            bitmap++;
-          }
+          vp_RGBaToBGRA(bitmap, dst_32, sizeI);
         }
       } else {
         if (XImageByteOrder(display) == 1) {
@@ -1874,7 +1964,7 @@ void vpDisplayX::displayImage(const vpImage<vpRGBa> &I)
       }
 
       // Affichage de l'image dans la Pixmap.
-      XPutImage(display, pixmap, context, Ximage, 0, 0, 0, 0, m_width, m_height);
+      putXImage(0, 0, m_width, m_height);
       XSetWindowBackgroundPixmap(display, window, pixmap);
       break;
     }
@@ -1900,8 +1990,8 @@ void vpDisplayX::displayImage(const vpImage<vpRGBa> &I)
 */
 void vpDisplayX::displayImage(const unsigned char *bitmap)
 {
-
   if (m_displayHasBeenInitialized) {
+    waitXImage();
     unsigned char *dst_32 = (unsigned char *)Ximage->data;
     for (unsigned int i = 0; i < m_width * m_height; i++) {
       *(dst_32++) = *bitmap; // red component.
@@ -1912,7 +2002,7 @@ void vpDisplayX::displayImage(const unsigned char *bitmap)
     }
 
     // Affichage de l'image dans la Pixmap.
-    XPutImage(display, pixmap, context, Ximage, 0, 0, 0, 0, m_width, m_height);
+    putXImage(0, 0, m_width, m_height);
     XSetWindowBackgroundPixmap(display, window, pixmap);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
@@ -1938,6 +2028,7 @@ void vpDisplayX::displayImageROI(const vpImage<unsigned char> &I, const vpImageP
                                  const unsigned int h)
 {
   if (m_displayHasBeenInitialized) {
+    waitXImage();
     switch (screen_depth) {
     case 8: {
       // Correction de l'image de facon a liberer les niveaux de gris
@@ -1967,8 +2058,7 @@ void vpDisplayX::displayImageROI(const vpImage<unsigned char> &I, const vpImageP
           i++;
         }
 
-        XPutImage(display, pixmap, context, Ximage, (int)iP.get_u(), (int)iP.get_v(), (int)iP.get_u(), (int)iP.get_v(),
-                  w, h);
+        putXImage((int)iP.get_u(), (int)iP.get_v(), w, h);
       } else {
         // Correction de l'image de facon a liberer les niveaux de gris
         // ROUGE, VERT, BLEU, JAUNE
@@ -1992,7 +2082,7 @@ void vpDisplayX::displayImageROI(const vpImage<unsigned char> &I, const vpImageP
               dst_8[j] = nivGris;
           }
         }
-        XPutImage(display, pixmap, context, Ximage, j_min, i_min, j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
+        putXImage(j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
       }
 
       // Affichage de l'image dans la Pixmap.
@@ -2010,8 +2100,7 @@ void vpDisplayX::displayImageROI(const vpImage<unsigned char> &I, const vpImageP
           }
         }
 
-        XPutImage(display, pixmap, context, Ximage, (int)iP.get_u(), (int)iP.get_v(), (int)iP.get_u(), (int)iP.get_v(),
-                  w, h);
+        putXImage((int)iP.get_u(), (int)iP.get_v(), w, h);
       } else {
         int i_min = (std::max)((int)ceil(iP.get_i() / m_scale), 0);
         int j_min = (std::max)((int)ceil(iP.get_j() / m_scale), 0);
@@ -2031,7 +2120,7 @@ void vpDisplayX::displayImageROI(const vpImage<unsigned char> &I, const vpImageP
           }
         }
 
-        XPutImage(display, pixmap, context, Ximage, j_min, i_min, j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
+        putXImage(j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
       }
 
       XSetWindowBackgroundPixmap(display, window, pixmap);
@@ -2064,25 +2153,14 @@ void vpDisplayX::displayImageROI(const vpImage<unsigned char> &I, const vpImageP
           }
         } else {
           // little endian
-          unsigned int i = 0;
-          while (i < h) {
-            unsigned int j = 0;
-            while (j < w) {
-              unsigned char val = *(src_8 + j);
-              *(dst_32 + 4 * j) = val;
-              *(dst_32 + 4 * j + 1) = val;
-              *(dst_32 + 4 * j + 2) = val;
-              *(dst_32 + 4 * j + 3) = vpRGBa::alpha_default;
-              j++;
-            }
+          for (unsigned int i = 0; i < h; i++) {
+            vp_greyToBGRA(src_8, dst_32, w);
             src_8 = src_8 + iwidth;
             dst_32 = dst_32 + 4 * m_width;
-            i++;
           }
         }
 
-        XPutImage(display, pixmap, context, Ximage, (int)iP.get_u(), (int)iP.get_v(), (int)iP.get_u(), (int)iP.get_v(),
-                  w, h);
+        putXImage((int)iP.get_u(), (int)iP.get_v(), w, h);
       } else {
         int i_min = (std::max)((int)ceil(iP.get_i() / m_scale), 0);
         int j_min = (std::max)((int)ceil(iP.get_j() / m_scale), 0);
@@ -2120,7 +2198,7 @@ void vpDisplayX::displayImageROI(const vpImage<unsigned char> &I, const vpImageP
           }
         }
 
-        XPutImage(display, pixmap, context, Ximage, j_min, i_min, j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
+        putXImage(j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
       }
 
       XSetWindowBackgroundPixmap(display, window, pixmap);
@@ -2151,6 +2229,7 @@ void vpDisplayX::displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &i
                                  const unsigned int h)
 {
   if (m_displayHasBeenInitialized) {
+    waitXImage();
     switch (screen_depth) {
     case 16: {
       if (m_scale == 1) {
@@ -2167,8 +2246,7 @@ void vpDisplayX::displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &i
                 (((r << 8) >> RShift) & RMask) | (((g << 8) >> GShift) & GMask) | (((b << 8) >> BShift) & BMask);
           }
         }
-        XPutImage(display, pixmap, context, Ximage, (int)iP.get_u(), (int)iP.get_v(), (int)iP.get_u(), (int)iP.get_v(),
-                  w, h);
+        putXImage((int)iP.get_u(), (int)iP.get_v(), w, h);
       } else {
         unsigned int bytes_per_line = (unsigned int)Ximage->bytes_per_line;
         int i_min = (std::max)((int)ceil(iP.get_i() / m_scale), 0);
@@ -2193,7 +2271,7 @@ void vpDisplayX::displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &i
                 (((r << 8) >> RShift) & RMask) | (((g << 8) >> GShift) & GMask) | (((b << 8) >> BShift) & BMask);
           }
         }
-        XPutImage(display, pixmap, context, Ximage, j_min, i_min, j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
+        putXImage(j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
       }
 
       XSetWindowBackgroundPixmap(display, window, pixmap);
@@ -2237,23 +2315,14 @@ void vpDisplayX::displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &i
         } else {
           // little endian
           while (i < h) {
-            unsigned int j = 0;
-            while (j < w) {
-              *(dst_32 + 4 * j) = (src_32 + j)->B;
-              *(dst_32 + 4 * j + 1) = (src_32 + j)->G;
-              *(dst_32 + 4 * j + 2) = (src_32 + j)->R;
-              *(dst_32 + 4 * j + 3) = (src_32 + j)->A;
-
-              j++;
-            }
+            vp_RGBaToBGRA(src_32, dst_32, w);
             src_32 = src_32 + iwidth;
             dst_32 = dst_32 + 4 * m_width;
             i++;
           }
         }
 
-        XPutImage(display, pixmap, context, Ximage, (int)iP.get_u(), (int)iP.get_v(), (int)iP.get_u(), (int)iP.get_v(),
-                  w, h);
+        putXImage((int)iP.get_u(), (int)iP.get_v(), w, h);
       } else {
         int i_min = (std::max)((int)ceil(iP.get_i() / m_scale), 0);
         int j_min = (std::max)((int)ceil(iP.get_j() / m_scale), 0);
@@ -2290,7 +2359,7 @@ void vpDisplayX::displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &i
             }
           }
         }
-        XPutImage(display, pixmap, context, Ximage, j_min, i_min, j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
+        putXImage(j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
       }
 
       XSetWindowBackgroundPixmap(display, window, pixmap);
@@ -2315,11 +2384,7 @@ void vpDisplayX::displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &i
 void vpDisplayX::closeDisplay()
 {
   if (m_displayHasBeenInitialized) {
-    if (ximage_data_init == true)
-      free(Ximage->data);
-
-    Ximage->data = NULL;
-    XDestroyImage(Ximage);
+    destroyXImage();
 
     XFreePixmap(display, pixmap);
 
@@ -2336,6 +2401,184 @@ void vpDisplayX::closeDisplay()
   }
 }
 
+/*!
+  Create the image used to transfer the pixels to the X server. When the
+  MIT shared memory extension is available and the server is local, the
+  image data is allocated in a shared memory segment so that XShmPutImage()
+  avoids copying the pixels through the X socket. Otherwise the image data
+  is allocated with malloc() and sent with XPutImage().
+*/
+void vpDisplayX::createXImage()
+{
+  m_useShm = false;
+  m_shmPending = false;
+  Ximage = NULL;
+
+#ifdef VISP_HAVE_X11_XSHM
+  if (XShmQueryExtension(display)) {
+    Ximage = XShmCreateImage(display, DefaultVisual(display, screen), screen_depth, ZPixmap, NULL, &m_shmInfo,
+                             m_width, m_height);
+    if (Ximage != NULL) {
+      m_shmInfo.shmid = shmget(IPC_PRIVATE, (size_t)Ximage->bytes_per_line * Ximage->height, IPC_CREAT | 0600);
+      if (m_shmInfo.shmid >= 0) {
+        m_shmInfo.shmaddr = (char *)shmat(m_shmInfo.shmid, NULL, 0);
+        if (m_shmInfo.shmaddr != (char *)-1) {
+          Ximage->data = m_shmInfo.shmaddr;
+          m_shmInfo.readOnly = False;
+
+          // XShmAttach() fails asynchronously when the server is remote
+          XSync(display, False);
+          vp_shmError = false;
+          XErrorHandler handler = XSetErrorHandler(vp_shmErrorHandler);
+          XShmAttach(display, &m_shmInfo);
+          XSync(display, False);
+          XSetErrorHandler(handler);
+
+          m_useShm = !vp_shmError;
+          if (!m_useShm)
+            shmdt(m_shmInfo.shmaddr);
+        }
+        // The segment is destroyed once detached by both the server and us
+        shmctl(m_shmInfo.shmid, IPC_RMID, NULL);
+      }
+      if (!m_useShm) {
+        Ximage->data = NULL;
+        XDestroyImage(Ximage);
+        Ximage = NULL;
+      }
+    }
+  }
+#endif
+
+  if (!m_useShm) {
+    Ximage = XCreateImage(display, DefaultVisual(display, screen), screen_depth, ZPixmap, 0, NULL, m_width, m_height,
+                          XBitmapPad(display), 0);
+
+    Ximage->data = (char *)malloc(m_height * (unsigned int)Ximage->bytes_per_line);
+    ximage_data_init = true;
+  }
+
+  if (m_font != NULL)
+    XFreeFontInfo(NULL, m_font, 1);
+  m_font = XQueryFont(display, XGContextFromGC(context));
+
+  m_dirtyRects.clear();
+  m_dirtyAll = true;
+}
+
+/*!
+  Release the image created by createXImage().
+*/
+void vpDisplayX::destroyXImage()
+{
+  if (Ximage != NULL) {
+#ifdef VISP_HAVE_X11_XSHM
+    if (m_useShm) {
+      XShmDetach(display, &m_shmInfo);
+      XSync(display, False);
+      Ximage->data = NULL;
+      XDestroyImage(Ximage);
+      shmdt(m_shmInfo.shmaddr);
+    } else
+#endif
+    {
+      if (ximage_data_init == true)
+        free(Ximage->data);
+
+      Ximage->data = NULL;
+      XDestroyImage(Ximage);
+    }
+    Ximage = NULL;
+  }
+  ximage_data_init = false;
+  m_useShm = false;
+  m_shmPending = false;
+
+  if (m_font != NULL) {
+    XFreeFontInfo(NULL, m_font, 1);
+    m_font = NULL;
+  }
+  m_dirtyRects.clear();
+  m_dirtyAll = false;
+}
+
+/*!
+  Copy a part of the image into the pixmap and mark it as modified.
+
+  \param x, y : Top left corner of the area in the window.
+  \param w, h : Size of the area.
+*/
+void vpDisplayX::putXImage(int x, int y, unsigned int w, unsigned int h)
+{
+#ifdef VISP_HAVE_X11_XSHM
+  if (m_useShm) {
+    XShmPutImage(display, pixmap, context, Ximage, x, y, x, y, w, h, False);
+    m_shmPending = true;
+  } else
+#endif
+  {
+    XPutImage(display, pixmap, context, Ximage, x, y, x, y, w, h);
+  }
+  addDirtyRect(x, y, (int)w, (int)h);
+}
+
+/*!
+  When the image is shared with the X server, wait until the server has
+  finished reading it before its content is overwritten.
+*/
+void vpDisplayX::waitXImage()
+{
+  if (m_shmPending) {
+    XSync(display, False);
+    m_shmPending = false;
+  }
+}
+
+/*!
+  Record an area of the window that has to be repainted by the next call to
+  flushDisplay().
+
+  \param x, y : Top left corner of the area.
+  \param w, h : Size of the area.
+*/
+void vpDisplayX::addDirtyRect(int x, int y, int w, int h)
+{
+  if (m_dirtyAll)
+    return;
+
+  // Clip to the window
+  int x_max = (std::min)(x + w, (int)m_width);
+  int y_max = (std::min)(y + h, (int)m_height);
+  x = (std::max)(x, 0);
+  y = (std::max)(y, 0);
+  if (x >= x_max || y >= y_max)
+    return;
+
+  if (x == 0 && y == 0 && x_max == (int)m_width && y_max == (int)m_height) {
+    m_dirtyRects.clear();
+    m_dirtyAll = true;
+    return;
+  }
+
+  if (m_dirtyRects.size() >= vp_maxDirtyRects) {
+    // Merge all the areas in their bounding box
+    for (size_t i = 0; i < m_dirtyRects.size(); i++) {
+      x = (std::min)(x, (int)m_dirtyRects[i].x);
+      y = (std::min)(y, (int)m_dirtyRects[i].y);
+      x_max = (std::max)(x_max, (int)m_dirtyRects[i].x + (int)m_dirtyRects[i].width);
+      y_max = (std::max)(y_max, (int)m_dirtyRects[i].y + (int)m_dirtyRects[i].height);
+    }
+    m_dirtyRects.clear();
+  }
+
+  XRectangle rect;
+  rect.x = (short)x;
+  rect.y = (short)y;
+  rect.width = (unsigned short)(x_max - x);
+  rect.height = (unsigned short)(y_max - y);
+  m_dirtyRects.push_back(rect);
+}
+
 /*!
   Flushes the X buffer.
   It's necessary to use this function to see the results of any drawing.
@@ -2344,7 +2587,18 @@ void vpDisplayX::closeDisplay()
 void vpDisplayX::flushDisplay()
 {
   if (m_displayHasBeenInitialized) {
-    XClearWindow(display, window);
+    // Only repaint the parts of the window that were modified since the
+    // last flush
+    if (m_dirtyAll) {
+      XClearWindow(display, window);
+    } else {
+      for (size_t i = 0; i < m_dirtyRects.size(); i++) {
+        XClearArea(display, window, m_dirtyRects[i].x, m_dirtyRects[i].y, m_dirtyRects[i].width,
+                   m_dirtyRects[i].height, 0);
+      }
+    }
+    m_dirtyRects.clear();
+    m_dirtyAll = false;
     XFlush(display);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
@@ -2392,6 +2646,8 @@ void vpDisplayX::clearDisplay(const vpColor &color)
     XFreePixmap(display, pixmap);
     // Pixmap creation.
     pixmap = XCreatePixmap(display, window, m_width, m_height, screen_depth);
+    m_dirtyRects.clear();
+    m_dirtyAll = true;
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2468,8 +2724,16 @@ void vpDisplayX::displayCharString(const vpImagePoint &ip, const char *text, con
       XAllocColor(display, lut, &xcolor);
       XSetForeground(display, context, xcolor.pixel);
     }
-    XDrawString(display, pixmap, context, (int)(ip.get_u() / m_scale), (int)(ip.get_v() / m_scale), text,
-                (int)strlen(text));
+    int x = (int)(ip.get_u() / m_scale);
+    int y = (int)(ip.get_v() / m_scale);
+    int len = (int)strlen(text);
+    XDrawString(display, pixmap, context, x, y, text, len);
+    if (m_font != NULL) {
+      // The string is drawn from its baseline
+      addDirtyRect(x, y - m_font->ascent, XTextWidth(m_font, text, len), m_font->ascent + m_font->descent);
+    } else {
+      m_dirtyAll = true;
+    }
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2512,6 +2776,9 @@ void vpDisplayX::displayCircle(const vpImagePoint &center, unsigned int radius,
                vpMath::round((center.get_v() - radius) / m_scale), radius * 2 / m_scale, radius * 2 / m_scale, 0,
                23040); /* 23040 = 360*64 */
     }
+    addDirtyRect(vpMath::round((center.get_u() - radius) / m_scale) - (int)thickness,
+                 vpMath::round((center.get_v() - radius) / m_scale) - (int)thickness,
+                 (int)(radius * 2 / m_scale + 2 * thickness + 1), (int)(radius * 2 / m_scale + 2 * thickness + 1));
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2574,8 +2841,13 @@ void vpDisplayX::displayDotLine(const vpImagePoint &ip1, const vpImagePoint &ip2
 
     XSetLineAttributes(display, context, thickness, LineOnOffDash, CapButt, JoinBevel);
 
-    XDrawLine(display, pixmap, context, vpMath::round(ip1.get_u() / m_scale), vpMath::round(ip1.get_v() / m_scale),
-              vpMath::round(ip2.get_u() / m_scale), vpMath::round(ip2.get_v() / m_scale));
+    int u1 = vpMath::round(ip1.get_u() / m_scale);
+    int v1 = vpMath::round(ip1.get_v() / m_scale);
+    int u2 = vpMath::round(ip2.get_u() / m_scale);
+    int v2 = vpMath::round(ip2.get_v() / m_scale);
+    XDrawLine(display, pixmap, context, u1, v1, u2, v2);
+    addDirtyRect((std::min)(u1, u2) - (int)thickness, (std::min)(v1, v2) - (int)thickness,
+                 std::abs(u2 - u1) + 2 * (int)thickness + 1, std::abs(v2 - v1) + 2 * (int)thickness + 1);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2607,8 +2879,13 @@ void vpDisplayX::displayLine(const vpImagePoint &ip1, const vpImagePoint &ip2, c
 
     XSetLineAttributes(display, context, thickness, LineSolid, CapButt, JoinBevel);
 
-    XDrawLine(display, pixmap, context, vpMath::round(ip1.get_u() / m_scale), vpMath::round(ip1.get_v() / m_scale),
-              vpMath::round(ip2.get_u() / m_scale), vpMath::round(ip2.get_v() / m_scale));
+    int u1 = vpMath::round(ip1.get_u() / m_scale);
+    int v1 = vpMath::round(ip1.get_v() / m_scale);
+    int u2 = vpMath::round(ip2.get_u() / m_scale);
+    int v2 = vpMath::round(ip2.get_v() / m_scale);
+    XDrawLine(display, pixmap, context, u1, v1, u2, v2);
+    addDirtyRect((std::min)(u1, u2) - (int)thickness, (std::min)(v1, v2) - (int)thickness,
+                 std::abs(u2 - u1) + 2 * (int)thickness + 1, std::abs(v2 - v1) + 2 * (int)thickness + 1);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2634,12 +2911,14 @@ void vpDisplayX::displayPoint(const vpImagePoint &ip, const vpColor &color, unsi
       XSetForeground(display, context, xcolor.pixel);
     }
 
+    int u = vpMath::round(ip.get_u() / m_scale);
+    int v = vpMath::round(ip.get_v() / m_scale);
     if (thickness == 1) {
-      XDrawPoint(display, pixmap, context, vpMath::round(ip.get_u() / m_scale), vpMath::round(ip.get_v() / m_scale));
+      XDrawPoint(display, pixmap, context, u, v);
     } else {
-      XFillRectangle(display, pixmap, context, vpMath::round(ip.get_u() / m_scale), vpMath::round(ip.get_v() / m_scale),
-                     thickness, thickness);
+      XFillRectangle(display, pixmap, context, u, v, thickness, thickness);
     }
+    addDirtyRect(u, v, (int)thickness, (int)thickness);
 
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
@@ -2676,13 +2955,15 @@ void vpDisplayX::displayRectangle(const vpImagePoint &topLeft, unsigned int w, u
       XSetForeground(display, context, xcolor.pixel);
     }
     XSetLineAttributes(display, context, thickness, LineSolid, CapButt, JoinBevel);
+    int u = vpMath::round(topLeft.get_u() / m_scale);
+    int v = vpMath::round(topLeft.get_v() / m_scale);
     if (fill == false) {
-      XDrawRectangle(display, pixmap, context, vpMath::round(topLeft.get_u() / m_scale),
-                     vpMath::round(topLeft.get_v() / m_scale), w / m_scale, h / m_scale);
+      XDrawRectangle(display, pixmap, context, u, v, w / m_scale, h / m_scale);
     } else {
-      XFillRectangle(display, pixmap, context, vpMath::round(topLeft.get_u() / m_scale),
-                     vpMath::round(topLeft.get_v() / m_scale), w / m_scale, h / m_scale);
+      XFillRectangle(display, pixmap, context, u, v, w / m_scale, h / m_scale);
     }
+    addDirtyRect(u - (int)thickness, v - (int)thickness, (int)(w / m_scale + 2 * thickness + 1),
+                 (int)(h / m_scale + 2 * thickness + 1));
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2723,18 +3004,14 @@ void vpDisplayX::displayRectangle(const vpImagePoint &topLeft, const vpImagePoin
     vpImagePoint bottomRight_ = bottomRight / m_scale;
     unsigned int w = (unsigned int)vpMath::round(std::fabs(bottomRight_.get_u() - topLeft_.get_u()));
     unsigned int h = (unsigned int)vpMath::round(std::fabs(bottomRight_.get_v() - topLeft_.get_v()));
+    int u = vpMath::round(topLeft_.get_u() < bottomRight_.get_u() ? topLeft_.get_u() : bottomRight_.get_u());
+    int v = vpMath::round(topLeft_.get_v() < bottomRight_.get_v() ? topLeft_.get_v() : bottomRight_.get_v());
     if (fill == false) {
-
-      XDrawRectangle(display, pixmap, context,
-                     vpMath::round(topLeft_.get_u() < bottomRight_.get_u() ? topLeft_.get_u() : bottomRight_.get_u()),
-                     vpMath::round(topLeft_.get_v() < bottomRight_.get_v() ? topLeft_.get_v() : bottomRight_.get_v()),
-                     w > 0 ? w : 1, h > 0 ? h : 1);
+      XDrawRectangle(display, pixmap, context, u, v, w > 0 ? w : 1, h > 0 ? h : 1);
     } else {
-      XFillRectangle(display, pixmap, context,
-                     vpMath::round(topLeft_.get_u() < bottomRight_.get_u() ? topLeft_.get_u() : bottomRight_.get_u()),
-                     vpMath::round(topLeft_.get_v() < bottomRight_.get_v() ? topLeft_.get_v() : bottomRight_.get_v()),
-                     w, h);
+      XFillRectangle(display, pixmap, context, u, v, w, h);
     }
+    addDirtyRect(u - (int)thickness, v - (int)thickness, (int)(w + 2 * thickness + 2), (int)(h + 2 * thickness + 2));
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2770,17 +3047,16 @@ void vpDisplayX::displayRectangle(const vpRect &rectangle, const vpColor &color,
 
     XSetLineAttributes(display, context, thickness, LineSolid, CapButt, JoinBevel);
 
+    int u = vpMath::round(rectangle.getLeft() / m_scale);
+    int v = vpMath::round(rectangle.getTop() / m_scale);
+    int w = vpMath::round(rectangle.getWidth() / m_scale);
+    int h = vpMath::round(rectangle.getHeight() / m_scale);
     if (fill == false) {
-      XDrawRectangle(display, pixmap, context, vpMath::round(rectangle.getLeft() / m_scale),
-                     vpMath::round(rectangle.getTop() / m_scale),
-                     (unsigned int)vpMath::round(rectangle.getWidth() / m_scale - 1),
-                     (unsigned int)vpMath::round(rectangle.getHeight() / m_scale - 1));
+      XDrawRectangle(display, pixmap, context, u, v, (unsigned int)(w - 1), (unsigned int)(h - 1));
     } else {
-      XFillRectangle(display, pixmap, context, vpMath::round(rectangle.getLeft() / m_scale),
-                     vpMath::round(rectangle.getTop() / m_scale),
-                     (unsigned int)vpMath::round(rectangle.getWidth() / m_scale),
-                     (unsigned int)vpMath::round(rectangle.getHeight() / m_scale));
+      XFillRectangle(display, pixmap, context, u, v, (unsigned int)w, (unsigned int)h);
     }
+    addDirtyRect(u - (int)thickness, v - (int)thickness, w + 2 * (int)thickness + 1, h + 2 * (int)thickness + 1);
 
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
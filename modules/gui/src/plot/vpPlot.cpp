@@ -39,8 +39,8 @@
 #include <visp3/core/vpConfig.h>
 
 #if defined(VISP_HAVE_DISPLAY)
+#include <algorithm>
 #include <fstream>
-#include <list>
 #include <vector>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMeterPixelConversion.h>
@@ -619,7 +619,8 @@ void vpPlot::resetPointList(const unsigned int graphNum, const unsigned int curv
 
 /*!
   This function enables to save in a text file all the plotted points of a
-  graphic.
+  graphic that are still stored, see setMaxNumberOfPoints(). To save every
+  plotted point whatever the number of points, use startDataRecording().
 
   The content of the file is the following:
   - The first line of the text file is the graphic title prefixed by \e
@@ -648,82 +649,89 @@ void vpPlot::saveData(const unsigned int graphNum, const std::string &dataFile,
   std::ofstream fichier;
   fichier.open(dataFile.c_str());
 
-  unsigned int ind;
-  double *p = new double[3];
-  bool end = false;
-
-  std::vector<std::list<double>::const_iterator> vec_iter_pointListx((graphList + graphNum)->curveNbr);
-  std::vector<std::list<double>::const_iterator> vec_iter_pointListy((graphList + graphNum)->curveNbr);
-  std::vector<std::list<double>::const_iterator> vec_iter_pointListz((graphList + graphNum)->curveNbr);
+  vpPlotGraph *graph = graphList + graphNum;
+  fichier << title_prefix << graph->title << std::endl;
 
-  fichier << title_prefix << (graphList + graphNum)->title << std::endl;
+  unsigned int nbLines = 0;
+  for (unsigned int ind = 0; ind < graph->curveNbr; ind++)
+    nbLines = (std::max)(nbLines, graph->curveList[ind].nbPoint);
 
-  for (ind = 0; ind < (graphList + graphNum)->curveNbr; ind++) {
-    vec_iter_pointListx[ind] = (graphList + graphNum)->curveList[ind].pointListx.begin();
-    vec_iter_pointListy[ind] = (graphList + graphNum)->curveList[ind].pointListy.begin();
-    vec_iter_pointListz[ind] = (graphList + graphNum)->curveList[ind].pointListz.begin();
-    //    (graphList+graphNum)->curveList[ind].pointListx.front();
-    //    (graphList+graphNum)->curveList[ind].pointListy.front();
-    //    (graphList+graphNum)->curveList[ind].pointListz.front();
-  }
-
-  while (end == false) {
-    end = true;
-    for (ind = 0; ind < (graphList + graphNum)->curveNbr; ind++) {
-      //      if (!(graphList+graphNum)->curveList[ind].pointListx.outside()
-      //          &&
-      //          !(graphList+graphNum)->curveList[ind].pointListy.outside()
-      //          &&
-      //          !(graphList+graphNum)->curveList[ind].pointListz.outside())
-      if ((vec_iter_pointListx[ind] != (graphList + graphNum)->curveList[ind].pointListx.end()) &&
-          (vec_iter_pointListy[ind] != (graphList + graphNum)->curveList[ind].pointListy.end()) &&
-          (vec_iter_pointListz[ind] != (graphList + graphNum)->curveList[ind].pointListz.end())) {
-        p[0] = *vec_iter_pointListx[ind];
-        p[1] = *vec_iter_pointListy[ind];
-        p[2] = *vec_iter_pointListz[ind];
-        //        p[0] =
-        //        (graphList+graphNum)->curveList[ind].pointListx.value();
-        //        p[1] =
-        //        (graphList+graphNum)->curveList[ind].pointListy.value();
-        //        p[2] =
-        //        (graphList+graphNum)->curveList[ind].pointListz.value();
-
-        fichier << p[0] << "\t" << p[1] << "\t" << p[2] << "\t";
-        ++vec_iter_pointListx[ind];
-        ++vec_iter_pointListy[ind];
-        ++vec_iter_pointListz[ind];
-        //        (graphList+graphNum)->curveList[ind].pointListx.next();
-        //        (graphList+graphNum)->curveList[ind].pointListy.next();
-        //        (graphList+graphNum)->curveList[ind].pointListz.next();
-        //        if(!(graphList+graphNum)->curveList[ind].pointListx.nextOutside()
-        //           &&
-        //           !(graphList+graphNum)->curveList[ind].pointListy.nextOutside()
-        //           &&
-        //           !(graphList+graphNum)->curveList[ind].pointListz.nextOutside())
-        if ((vec_iter_pointListx[ind] != (graphList + graphNum)->curveList[ind].pointListx.end()) &&
-            (vec_iter_pointListy[ind] != (graphList + graphNum)->curveList[ind].pointListy.end()) &&
-            (vec_iter_pointListz[ind] != (graphList + graphNum)->curveList[ind].pointListz.end()))
-          end = false;
+  double p[3];
+  for (unsigned int k = 0; k < nbLines; k++) {
+    for (unsigned int ind = 0; ind < graph->curveNbr; ind++) {
+      const vpPlotCurve &curve = graph->curveList[ind];
+      // Curves with less points repeat their last point
+      if (curve.nbPoint > 0) {
+        curve.getPoint((std::min)(k, curve.nbPoint - 1), p[0], p[1], p[2]);
       } else {
-        //        p[0] =
-        //        (graphList+graphNum)->curveList[ind].pointListx.value();
-        //        p[1] =
-        //        (graphList+graphNum)->curveList[ind].pointListy.value();
-        //        p[2] =
-        //        (graphList+graphNum)->curveList[ind].pointListz.value();
-        p[0] = (graphList + graphNum)->curveList[ind].pointListx.back();
-        p[1] = (graphList + graphNum)->curveList[ind].pointListy.back();
-        p[2] = (graphList + graphNum)->curveList[ind].pointListz.back();
-        fichier << p[0] << "\t" << p[1] << "\t" << p[2] << "\t";
+        p[0] = p[1] = p[2] = 0.;
       }
+      fichier << p[0] << "\t" << p[1] << "\t" << p[2] << "\t";
     }
     fichier << std::endl;
   }
 
-  delete[] p;
   fichier.close();
 }
 
+/*!
+  Set the maximum number of points stored for each curve of a graphic. Once
+  this number is reached, each new point replaces the oldest one. This bounds
+  the memory used by the plot and the time needed to redraw it when the scale
+  changes. By default, the 100000 last points of each curve are stored.
+
+  This function can be called before or after initGraph(). To save all the
+  plotted points whatever this limit, use startDataRecording().
+
+  \param graphNum : The index of the graph in the window. As the number of
+  graphic in a window is less or equal to 4, this parameter is between 0
+  and 3.
+  \param nbPoints : Maximum number of points stored per curve.
+
+  \exception vpException::badValue : If \e nbPoints is 0.
+*/
+void vpPlot::setMaxNumberOfPoints(const unsigned int graphNum, const unsigned int nbPoints)
+{
+  (graphList + graphNum)->setMaxNumberOfPoints(nbPoints);
+}
+
+/*!
+  Start to save in a text file every point that is plotted in a graphic from
+  now on, until stopDataRecording() is called. The points are written by a
+  background thread, so that the plot is not slowed down by disk accesses.
+
+  The first line of the file is the graphic title prefixed by \e
+  title_prefix. Then each line gives a plotted point: the index of the curve
+  followed by the x, y and z coordinates of the point (z is 0 for 2D
+  graphics), delimited by tabulations.
+
+  \param graphNum : The index of the graph in the window. As the number of
+  graphic in a window is less or equal to 4, this parameter is between 0
+  and 3.
+  \param dataFile : Name of the text file.
+  \param title_prefix : Prefix introduced in the first line of the file, for
+  example "# " for gnuplot or "% " for Matlab.
+
+  \exception vpException::ioError : If the file cannot be created.
+
+  \sa saveData()
+*/
+void vpPlot::startDataRecording(const unsigned int graphNum, const std::string &dataFile,
+                                const std::string &title_prefix)
+{
+  (graphList + graphNum)->startDataRecording(dataFile, title_prefix);
+}
+
+/*!
+  Stop the recording started with startDataRecording(). The points that are
+  not yet written are saved before the file is closed.
+
+  \param graphNum : The index of the graph in the window. As the number of
+  graphic in a window is less or equal to 4, this parameter is between 0
+  and 3.
+*/
+void vpPlot::stopDataRecording(const unsigned int graphNum) { (graphList + graphNum)->stopDataRecording(); }
+
 #elif !defined(VISP_BUILD_SHARED_LIBS)
 // Work arround to avoid warning: libvisp_core.a(vpPlot.cpp.o) has no symbols
 void dummy_vpPlot(){};
@@ -37,6 +37,8 @@
  *****************************************************************************/
 #include <visp3/core/vpConfig.h>
 
+#include <algorithm>
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
 #include <visp3/gui/vpDisplayD3D.h>
@@ -46,25 +48,78 @@
 #include <visp3/gui/vpDisplayX.h>
 #include <visp3/gui/vpPlotCurve.h>
 
+#include <visp3/core/vpMath.h>
+
 #if defined(VISP_HAVE_DISPLAY)
 vpPlotCurve::vpPlotCurve()
   : color(vpColor::red), curveStyle(point), thickness(1), nbPoint(0), lastPoint(), pointListx(), pointListy(),
-    pointListz(), legend(), xmin(0), xmax(0), ymin(0), ymax(0)
+    pointListz(), pointHead(0), maxNbPoint(100000), legend(), xmin(0), xmax(0), ymin(0), ymax(0)
+{
+}
+
+vpPlotCurve::~vpPlotCurve() { clearPointList(); }
+
+/*
+  Store a point. When the ring buffers are full, the oldest point is
+  replaced.
+*/
+void vpPlotCurve::addPoint(const double x, const double y, const double z)
 {
+  if (pointListx.size() < maxNbPoint) {
+    // The buffers grow until they reach their capacity
+    pointListx.push_back(x);
+    pointListy.push_back(y);
+    pointListz.push_back(z);
+    nbPoint++;
+  } else if (maxNbPoint > 0) {
+    pointListx[pointHead] = x;
+    pointListy[pointHead] = y;
+    pointListz[pointHead] = z;
+    pointHead = (pointHead + 1) % maxNbPoint;
+  }
 }
 
-vpPlotCurve::~vpPlotCurve()
+void vpPlotCurve::clearPointList()
 {
   pointListx.clear();
   pointListy.clear();
   pointListz.clear();
+  pointHead = 0;
+  nbPoint = 0;
 }
 
-void vpPlotCurve::plotPoint(const vpImage<unsigned char> &I, const vpImagePoint &iP, const double x, const double y)
+/*
+  Get the k-th stored point, k = 0 being the oldest one.
+*/
+void vpPlotCurve::getPoint(const unsigned int k, double &x, double &y, double &z) const
 {
-  nbPoint++;
+  size_t index = (pointHead + k) % pointListx.size();
+  x = pointListx[index];
+  y = pointListy[index];
+  z = pointListz[index];
+}
+
+/*
+  Change the capacity of the ring buffers, keeping the most recent points.
+*/
+void vpPlotCurve::setMaxNumberOfPoints(const unsigned int nb)
+{
+  unsigned int kept = (std::min)(nbPoint, nb);
+  std::vector<double> x(kept), y(kept), z(kept);
+  for (unsigned int k = 0; k < kept; k++)
+    getPoint(nbPoint - kept + k, x[k], y[k], z[k]);
 
-  if (nbPoint > 1) {
+  pointListx.swap(x);
+  pointListy.swap(y);
+  pointListz.swap(z);
+  pointHead = 0;
+  nbPoint = kept;
+  maxNbPoint = nb;
+}
+
+void vpPlotCurve::plotPoint(const vpImage<unsigned char> &I, const vpImagePoint &iP, const double x, const double y)
+{
+  if (nbPoint > 0) {
     vpDisplay::displayLine(I, lastPoint, iP, color, thickness);
   }
 #if defined(VISP_HAVE_DISPLAY)
@@ -90,30 +145,60 @@ void vpPlotCurve::plotPoint(const vpImage<unsigned char> &I, const vpImagePoint
   vpDisplay::flushROI(I, vpRect(left, top, width, height));
 #endif
   lastPoint = iP;
-  pointListx.push_back(x);
-  pointListy.push_back(y);
-  pointListz.push_back(0.0);
+  addPoint(x, y, 0.0);
 }
 
+/*
+  Draw the stored points. The points falling in the same pixel column are
+  merged: the curve coming from the previous column is joined to the first
+  point of the column, and a vertical segment covers the range between the
+  minimum and the maximum of the points. This preserves the extrema of the
+  curve while the number of drawn segments is bounded by twice the width of
+  the graph instead of the number of points.
+*/
 void vpPlotCurve::plotList(const vpImage<unsigned char> &I, const double xorg, const double yorg, const double zoomx,
                            const double zoomy)
 {
-  std::list<double>::const_iterator it_ptListx = pointListx.begin();
-  std::list<double>::const_iterator it_ptListy = pointListy.begin();
+  if (nbPoint == 0)
+    return;
 
-  unsigned int k = 0;
-  vpImagePoint iP;
-  while (k < nbPoint) {
-    iP.set_ij(yorg - (zoomy * (*it_ptListy)), xorg + (zoomx * (*it_ptListx)));
+  double x, y, z;
+  bool previous = false; // true once a column has been drawn
+  int column = 0;
+  double i_first = 0, i_min = 0, i_max = 0, i_last = 0;
+  double j_first = 0, j_last = 0;
 
-    if (k > 0)
-      vpDisplay::displayLine(I, lastPoint, iP, color, thickness);
+  for (unsigned int k = 0; k <= nbPoint; k++) {
+    double i = 0, j = 0;
+    int c = 0;
+    if (k < nbPoint) {
+      getPoint(k, x, y, z);
+      i = yorg - (zoomy * y);
+      j = xorg + (zoomx * x);
+      c = vpMath::round(j);
+      if (k > 0 && c == column) {
+        i_min = (std::min)(i_min, i);
+        i_max = (std::max)(i_max, i);
+        i_last = i;
+        j_last = j;
+        continue;
+      }
+    }
 
-    lastPoint = iP;
+    if (k > 0) {
+      // Draw the column that has just been completed
+      vpImagePoint iP_first(i_first, j_first);
+      if (previous)
+        vpDisplay::displayLine(I, lastPoint, iP_first, color, thickness);
+      if (i_max - i_min >= 1.)
+        vpDisplay::displayLine(I, vpImagePoint(i_min, column), vpImagePoint(i_max, column), color, thickness);
+      lastPoint.set_ij(i_last, j_last);
+      previous = true;
+    }
 
-    ++it_ptListx;
-    ++it_ptListy;
-    k++;
+    column = c;
+    i_first = i_min = i_max = i_last = i;
+    j_first = j_last = j;
   }
 }
 
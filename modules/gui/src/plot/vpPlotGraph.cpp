@@ -53,14 +53,131 @@
 #include <visp3/gui/vpDisplayX.h>
 
 #include <cmath>  // std::fabs
+#include <fstream>
 #include <limits> // numeric_limits
+#include <visp3/core/vpCondition.h>
 #include <visp3/core/vpMath.h>
+#include <visp3/core/vpThread.h>
+#include <visp3/core/vpTime.h>
 
 #if defined(VISP_HAVE_DISPLAY)
 
 int laFonctionSansNom(const double delta);
 void getGrid3DPoint(const double pente, vpImagePoint &iPunit, vpImagePoint &ip1, vpImagePoint &ip2, vpImagePoint &ip3);
 
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+#define VP_PLOT_RECORDER_THREAD
+#endif
+
+/*
+  Write all the points plotted in a graph to a text file, one line per point
+  with the curve index and the x, y, z coordinates.
+
+  The plotting thread only appends the points to a buffer and wakes up a
+  background thread. This thread swaps the buffer with a second one and
+  writes it, so that the disk accesses never slow down the plot. Without
+  thread support, the buffer is written each time it reaches a given size.
+*/
+class vpPlotDataRecorder
+{
+public:
+  vpPlotDataRecorder(const std::string &dataFile, const std::string &header)
+    : m_file(),
+#ifdef VP_PLOT_RECORDER_THREAD
+      m_mutex(), m_wakeUp(), m_thread(NULL), m_stop(false),
+#endif
+      m_pending(), m_writing()
+  {
+    m_file.open(dataFile.c_str());
+    if (!m_file.is_open()) {
+      throw(vpException(vpException::ioError, "Cannot create the plot data file %s", dataFile.c_str()));
+    }
+    m_file << header << std::endl;
+#ifdef VP_PLOT_RECORDER_THREAD
+    m_thread = new vpThread((vpThread::Fn)writingFunction, (vpThread::Args)this);
+#endif
+  }
+
+  // The points that are still buffered are written before closing the file
+  ~vpPlotDataRecorder()
+  {
+#ifdef VP_PLOT_RECORDER_THREAD
+    m_mutex.lock();
+    m_stop = true;
+    m_wakeUp.notifyOne();
+    m_mutex.unlock();
+    delete m_thread; // join
+#endif
+    write(m_pending);
+    m_file.close();
+  }
+
+  void push(const unsigned int curveNum, const double x, const double y, const double z)
+  {
+#ifdef VP_PLOT_RECORDER_THREAD
+    vpMutex::vpScopedLock lock(m_mutex);
+    // The writing thread only waits when there is nothing to write
+    if (m_pending.empty())
+      m_wakeUp.notifyOne();
+#endif
+    m_pending.push_back(curveNum);
+    m_pending.push_back(x);
+    m_pending.push_back(y);
+    m_pending.push_back(z);
+#ifndef VP_PLOT_RECORDER_THREAD
+    if (m_pending.size() >= 4 * 4096)
+      write(m_pending);
+#endif
+  }
+
+private:
+  void write(std::vector<double> &points)
+  {
+    for (size_t k = 0; k + 3 < points.size(); k += 4) {
+      m_file << (unsigned int)points[k] << "\t" << points[k + 1] << "\t" << points[k + 2] << "\t" << points[k + 3]
+             << "\n";
+    }
+    m_file.flush();
+    points.clear();
+  }
+
+#ifdef VP_PLOT_RECORDER_THREAD
+  static vpThread::Return writingFunction(vpThread::Args args)
+  {
+    static_cast<vpPlotDataRecorder *>(args)->run();
+    return 0;
+  }
+
+  void run()
+  {
+    m_mutex.lock();
+    for (;;) {
+      if (m_pending.empty()) {
+        if (m_stop)
+          break;
+        m_wakeUp.wait(m_mutex);
+        continue;
+      }
+      m_writing.swap(m_pending);
+      m_mutex.unlock();
+      write(m_writing);
+      m_mutex.lock();
+    }
+    m_mutex.unlock();
+  }
+#endif
+
+  std::ofstream m_file;
+#ifdef VP_PLOT_RECORDER_THREAD
+  vpMutex m_mutex;
+  vpCondition m_wakeUp;
+  vpThread *m_thread;
+  bool m_stop;
+#endif
+  std::vector<double> m_pending;
+  std::vector<double> m_writing;
+};
+
 vpPlotGraph::vpPlotGraph()
   : xorg(0.), yorg(0.), zoomx(1.), zoomy(1.), xmax(10), ymax(10), xmin(0), ymin(-10), xdelt(1), ydelt(1), gridx(true),
     gridy(true), gridColor(), curveNbr(1), curveList(NULL), scaleInitialized(false), firstPoint(true), nbDivisionx(10),
@@ -68,7 +185,8 @@ vpPlotGraph::vpPlotGraph()
     dTopLeft3D(), dGraphZone3D(), cam(), cMo(), cMf(), w_xval(0), w_xsize(0), w_yval(0), w_ysize(0), w_zval(0),
     w_zsize(0), ptXorg(0), ptYorg(0), ptZorg(0), zoomx_3D(1.), zoomy_3D(1.), zoomz_3D(1.), nbDivisionz(10), zorg(1.),
     zoomz(1.), zmax(10), zmin(-10), zdelt(1), old_iPr(), old_iPz(), blockedr(false), blockedz(false), blocked(false),
-    epsi(5), epsj(6), dispUnit(false), dispTitle(false), dispLegend(false), gridThickness(1)
+    epsi(5), epsj(6), dispUnit(false), dispTitle(false), dispLegend(false), gridThickness(1), maxNbPoint(100000),
+    recorder(NULL)
 {
   gridColor.setColor(200, 200, 200);
 
@@ -80,6 +198,7 @@ vpPlotGraph::vpPlotGraph()
 
 vpPlotGraph::~vpPlotGraph()
 {
+  stopDataRecording();
   if (curveList != NULL) {
     delete[] curveList;
     curveList = NULL;
@@ -96,8 +215,8 @@ void vpPlotGraph::initGraph(unsigned int nbCurve)
   for (unsigned int i = 0; i < curveNbr; i++) {
     (curveList + i)->color = colors[i % 6];
     (curveList + i)->curveStyle = vpPlotCurve::line;
-    (curveList + i)->pointListx.clear();
-    (curveList + i)->pointListy.clear();
+    (curveList + i)->clearPointList();
+    (curveList + i)->setMaxNumberOfPoints(maxNbPoint);
     (curveList + i)->legend.clear();
   }
 }
@@ -542,6 +661,8 @@ void vpPlotGraph::plot(vpImage<unsigned char> &I, const unsigned int curveNb, co
   }
 
   (curveList + curveNb)->plotPoint(I, iP, x, y);
+  if (recorder != NULL)
+    recorder->push(curveNb, x, y, 0.0);
 #if (!defined VISP_HAVE_X11 && defined FLUSH_ON_PLOT)
   vpDisplay::flushROI(I, graphZone);
 // vpDisplay::flush(I);
@@ -580,12 +701,36 @@ bool vpPlotGraph::getPixelValue(vpImage<unsigned char> &I, vpImagePoint &iP)
   return false;
 }
 
+void vpPlotGraph::setMaxNumberOfPoints(const unsigned int nb)
+{
+  if (nb == 0) {
+    throw(vpException(vpException::badValue, "The maximum number of points of a curve cannot be 0"));
+  }
+  maxNbPoint = nb;
+  // The curves are created by initGraph(), that applies maxNbPoint
+  if (curveList != NULL) {
+    for (unsigned int i = 0; i < curveNbr; i++)
+      (curveList + i)->setMaxNumberOfPoints(nb);
+  }
+}
+
+void vpPlotGraph::startDataRecording(const std::string &dataFile, const std::string &title_prefix)
+{
+  stopDataRecording();
+  recorder = new vpPlotDataRecorder(dataFile, title_prefix + title);
+}
+
+void vpPlotGraph::stopDataRecording()
+{
+  if (recorder != NULL) {
+    delete recorder;
+    recorder = NULL;
+  }
+}
+
 void vpPlotGraph::resetPointList(const unsigned int curveNum)
 {
-  (curveList + curveNum)->pointListx.clear();
-  (curveList + curveNum)->pointListy.clear();
-  (curveList + curveNum)->pointListz.clear();
-  (curveList + curveNum)->nbPoint = 0;
+  (curveList + curveNum)->clearPointList();
   firstPoint = true;
 }
 
@@ -1157,10 +1302,9 @@ vpMouseButton::vpMouseButtonType vpPlotGraph::plot(vpImage<unsigned char> &I, co
 #endif
 
   (curveList + curveNb)->lastPoint = iP;
-  (curveList + curveNb)->pointListx.push_back(x);
-  (curveList + curveNb)->pointListy.push_back(y);
-  (curveList + curveNb)->pointListz.push_back(z);
-  (curveList + curveNb)->nbPoint++;
+  (curveList + curveNb)->addPoint(x, y, z);
+  if (recorder != NULL)
+    recorder->push(curveNb, x, y, z);
 
 #if (!defined VISP_HAVE_X11 && defined FLUSH_ON_PLOT)
   vpDisplay::flushROI(I, graphZone);
@@ -1174,17 +1318,12 @@ void vpPlotGraph::replot3D(vpImage<unsigned char> &I)
   displayGrid3D(I);
 
   for (unsigned int i = 0; i < curveNbr; i++) {
-    std::list<double>::const_iterator it_ptListx = (curveList + i)->pointListx.begin();
-    std::list<double>::const_iterator it_ptListy = (curveList + i)->pointListy.begin();
-    std::list<double>::const_iterator it_ptListz = (curveList + i)->pointListz.begin();
-
-    unsigned int k = 0;
+    vpPlotCurve *curve = curveList + i;
     vpImagePoint iP;
     vpPoint pointPlot;
-    while (k < (curveList + i)->nbPoint) {
-      double x = *it_ptListx;
-      double y = *it_ptListy;
-      double z = *it_ptListz;
+    for (unsigned int k = 0; k < curve->nbPoint; k++) {
+      double x, y, z;
+      curve->getPoint(k, x, y, z);
       pointPlot.setWorldCoordinates(ptXorg + (zoomx_3D * x), ptYorg - (zoomy_3D * y), ptZorg + (zoomz_3D * z));
       pointPlot.track(cMo);
       double u = 0.0, v = 0.0;
@@ -1192,19 +1331,18 @@ void vpPlotGraph::replot3D(vpImage<unsigned char> &I)
       iP.set_uv(u, v);
       iP = iP + dTopLeft3D;
 
-      // vpDisplay::displayCross(I,iP,3,vpColor::cyan);
       if (k > 0) {
-        if (check3Dline((curveList + i)->lastPoint, iP))
-          vpDisplay::displayLine(I, (curveList + i)->lastPoint, iP, (curveList + i)->color);
-        // vpDisplay::displayCross(I,iP,3,vpColor::orange);
+        // Skip the points projected in the same pixel than the last drawn
+        // one, so that the number of drawn segments is bounded by the length
+        // of the curve in pixels
+        if (k + 1 < curve->nbPoint && std::fabs(iP.get_u() - curve->lastPoint.get_u()) < 1. &&
+            std::fabs(iP.get_v() - curve->lastPoint.get_v()) < 1.)
+          continue;
+        if (check3Dline(curve->lastPoint, iP))
+          vpDisplay::displayLine(I, curve->lastPoint, iP, curve->color);
       }
 
-      (curveList + i)->lastPoint = iP;
-
-      ++it_ptListx;
-      ++it_ptListy;
-      ++it_ptListz;
-      k++;
+      curve->lastPoint = iP;
     }
   }
   vpDisplay::flushROI(I, graphZone);
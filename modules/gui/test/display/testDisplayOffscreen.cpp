@@ -0,0 +1,202 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the offscreen display.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testDisplayOffscreen.cpp
+
+  \brief Render images and overlay drawings in memory with
+  vpDisplayOffscreen, possibly from several threads, and check the rendering.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpThread.h>
+#include <visp3/gui/vpDisplayOffscreen.h>
+
+namespace
+{
+bool sameColor(const vpRGBa &a, const vpRGBa &b) { return a.R == b.R && a.G == b.G && a.B == b.B; }
+
+// Draw a set of overlays on a grey image and return the rendering
+void render(vpImage<vpRGBa> &O, bool antialiasing)
+{
+  vpImage<unsigned char> I(120, 160, 50);
+  vpDisplayOffscreen d(I);
+  d.setAntialiasing(antialiasing);
+
+  vpDisplay::display(I);
+  vpDisplay::displayLine(I, vpImagePoint(10, 10), vpImagePoint(10, 100), vpColor::red);
+  vpDisplay::displayLine(I, vpImagePoint(20, 10), vpImagePoint(60, 100), vpColor::blue);
+  vpDisplay::displayLine(I, vpImagePoint(100, 10), vpImagePoint(100, 60), vpColor::red, 5);
+  vpDisplay::displayRectangle(I, vpImagePoint(30, 110), 20, 10, vpColor::green, true);
+  vpDisplay::displayRectangle(I, vpImagePoint(70, 110), 20, 10, vpColor::yellow, false, 3);
+  vpDisplay::displayCircle(I, vpImagePoint(60, 60), 20, vpColor::cyan);
+  vpDisplay::displayCircle(I, vpImagePoint(90, 130), 8, vpColor::orange, true);
+  vpDisplay::displayCross(I, vpImagePoint(110, 120), 7, vpColor::purple);
+  vpDisplay::displayText(I, vpImagePoint(0, 110), "ViSP", vpColor::white);
+  vpDisplay::flush(I);
+  vpDisplay::getImage(I, O);
+}
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+struct vpRenderTask {
+  vpImage<vpRGBa> m_rendering;
+  bool m_antialiasing;
+};
+
+vpThread::Return renderFunction(vpThread::Args args)
+{
+  vpRenderTask *task = static_cast<vpRenderTask *>(args);
+  for (unsigned int n = 0; n < 20; n++)
+    render(task->m_rendering, task->m_antialiasing);
+  return 0;
+}
+#endif
+}
+
+int main()
+{
+  try {
+    vpImage<vpRGBa> O;
+    render(O, false);
+
+    if (!(O.getHeight() == 120 && O.getWidth() == 160))
+      throw vpException(vpException::fatalError, "Wrong rendering size");
+    if (!(sameColor(O[10][10], vpColor::red) && sameColor(O[10][100], vpColor::red)))
+      throw vpException(vpException::fatalError, "Wrong line extremities");
+    if (!sameColor(O[11][50], vpRGBa(50)))
+      throw vpException(vpException::fatalError, "Wrong pixel near the line");
+    if (!(sameColor(O[98][30], vpColor::red) && sameColor(O[102][30], vpColor::red) &&
+          sameColor(O[104][30], vpRGBa(50))))
+      throw vpException(vpException::fatalError, "Wrong thick line");
+    if (!(sameColor(O[30][110], vpColor::green) && sameColor(O[39][129], vpColor::green) &&
+          sameColor(O[40][110], vpRGBa(50))))
+      throw vpException(vpException::fatalError, "Wrong filled rectangle");
+    if (!(sameColor(O[69][109], vpColor::yellow) && sameColor(O[75][120], vpRGBa(50))))
+      throw vpException(vpException::fatalError, "Wrong rectangle outline");
+    if (!(sameColor(O[60][80], vpColor::cyan) && sameColor(O[40][60], vpColor::cyan) &&
+          sameColor(O[60][70], vpRGBa(50))))
+      throw vpException(vpException::fatalError, "Wrong circle");
+    if (!(sameColor(O[90][130], vpColor::orange) && sameColor(O[90][137], vpColor::orange)))
+      throw vpException(vpException::fatalError, "Wrong disc");
+
+    unsigned int text_pixels = 0;
+    for (unsigned int i = 0; i < 8; i++)
+      for (unsigned int j = 110; j < 142; j++)
+        if (sameColor(O[i][j], vpColor::white))
+          text_pixels++;
+    if (text_pixels <= 20)
+      throw vpException(vpException::fatalError, "Wrong text");
+
+    // With anti-aliasing, the slanted line has blended pixels
+    vpImage<vpRGBa> A;
+    render(A, true);
+    unsigned int blended = 0;
+    for (unsigned int j = 12; j < 98; j++) {
+      for (unsigned int i = 18; i < 64; i++) {
+        if (A[i][j].B > 50 && A[i][j].B < 255 && A[i][j].R < 50)
+          blended++;
+      }
+    }
+    if (blended <= 50)
+      throw vpException(vpException::fatalError, "Wrong anti-aliased line");
+    if (!sameColor(A[10][50], vpColor::red))
+      throw vpException(vpException::fatalError, "Wrong anti-aliased horizontal line");
+
+    // Down scaled rendering
+    vpImage<vpRGBa> C(100, 200, vpRGBa(10, 20, 30));
+    vpDisplayOffscreen d(C, vpDisplay::SCALE_2);
+    vpDisplay::display(C);
+    vpDisplay::displayPoint(C, vpImagePoint(40, 80), vpColor::red);
+    vpImage<vpRGBa> S;
+    vpDisplay::getImage(C, S);
+    if (!(S.getHeight() == 50 && S.getWidth() == 100))
+      throw vpException(vpException::fatalError, "Wrong down scaled size");
+    if (!(sameColor(S[20][40], vpColor::red) && sameColor(S[0][0], vpRGBa(10, 20, 30))))
+      throw vpException(vpException::fatalError, "Wrong down scaled content");
+    if (vpDisplay::getClick(C, true))
+      throw vpException(vpException::fatalError, "Unexpected click");
+
+    // Segments with far away extremities are clipped to the canvas
+    for (unsigned int k = 0; k < 2; k++) {
+      vpImage<unsigned char> F(60, 80, 50);
+      vpDisplayOffscreen df(F);
+      df.setAntialiasing(k == 1);
+      vpDisplay::display(F);
+      vpDisplay::displayLine(F, vpImagePoint(30, -1e9), vpImagePoint(30, 1e9), vpColor::red);
+      vpDisplay::displayLine(F, vpImagePoint(-1e9, -1e9), vpImagePoint(1e9, 1e9), vpColor::blue);
+      vpDisplay::displayLine(F, vpImagePoint(-1e9, 100), vpImagePoint(1e9, 100), vpColor::green);
+      vpDisplay::flush(F);
+      vpImage<vpRGBa> R;
+      vpDisplay::getImage(F, R);
+      if (!(sameColor(R[30][0], vpColor::red) && sameColor(R[30][79], vpColor::red)))
+        throw vpException(vpException::fatalError, "Wrong clipped line");
+      if (!(R[10][10].B > 50 && R[50][50].B > 50))
+        throw vpException(vpException::fatalError, "Wrong clipped diagonal line");
+      bool outside = true;
+      for (unsigned int i = 0; i < R.getHeight(); i++)
+        for (unsigned int j = 0; j < R.getWidth(); j++)
+          outside &= (R[i][j].G <= 50 || R[i][j].R > 50);
+      if (!outside)
+        throw vpException(vpException::fatalError, "Wrong line outside of the canvas");
+    }
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+    // Concurrent renderings in worker threads give the same result
+    vpRenderTask tasks[4];
+    vpThread *threads[4];
+    for (unsigned int k = 0; k < 4; k++) {
+      tasks[k].m_antialiasing = (k % 2 == 1);
+      threads[k] = new vpThread(renderFunction, &tasks[k]);
+    }
+    for (unsigned int k = 0; k < 4; k++) {
+      threads[k]->join();
+      delete threads[k];
+    }
+    for (unsigned int k = 0; k < 4; k++) {
+      if (!(tasks[k].m_rendering == (tasks[k].m_antialiasing ? A : O)))
+        throw vpException(vpException::fatalError, "Wrong rendering in thread %u", k);
+    }
+#endif
+
+    std::cout << "testDisplayOffscreen is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (vpException &e) {
+    std::cerr << "Catch an exception: " << e.getStringMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,268 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test incremental refresh of the X11 display.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testDisplayXOverlay.cpp
+
+  \brief Check that images, regions of interest and overlay drawings are
+  rendered by vpDisplayX whatever the transfer mode (shared memory or not)
+  and that only the modified areas need to be refreshed.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRect.h>
+#include <visp3/gui/vpDisplayX.h>
+#include <visp3/io/vpParseArgv.h>
+
+// List of allowed command line options
+#define GETOPTARGS "cdh"
+
+void usage(const char *name, const char *badparam);
+bool getOptions(int argc, const char **argv, bool &click_allowed, bool &display);
+
+/*!
+
+  Print the program options.
+
+  \param name : Program name.
+  \param badparam : Bad parameter name.
+
+ */
+void usage(const char *name, const char *badparam)
+{
+  fprintf(stdout, "\n\
+Display grey level and color images with vpDisplayX, draw overlays\n\
+and regions of interest, and check the content of the window.\n\
+\n\
+SYNOPSIS\n\
+  %s [-c] [-d] [-h]\n", name);
+
+  fprintf(stdout, "\n\
+OPTIONS:                                               Default\n\
+  -c\n\
+     Disable the mouse click. Useful to automate the \n\
+     execution of this program without humain intervention.\n\
+\n\
+  -d                                             \n\
+     Disable the image display. This can be useful \n\
+     for automatic tests using crontab under Unix.\n\
+\n\
+  -h\n\
+     Print the help.\n\n");
+
+  if (badparam) {
+    fprintf(stderr, "ERROR: \n");
+    fprintf(stderr, "\nBad parameter [%s]\n", badparam);
+  }
+}
+
+/*!
+
+  Set the program options.
+
+  \param argc : Command line number of parameters.
+  \param argv : Array of command line parameters.
+  \param click_allowed : Enable/disable mouse click.
+  \param display : Set as true, activates the image display. This is
+  the default configuration. When set to false, the display is
+  disabled.
+
+  \return false if the program has to be stopped, true otherwise.
+
+*/
+bool getOptions(int argc, const char **argv, bool &click_allowed, bool &display)
+{
+  const char *optarg_;
+  int c;
+  while ((c = vpParseArgv::parse(argc, argv, GETOPTARGS, &optarg_)) > 1) {
+
+    switch (c) {
+    case 'c':
+      click_allowed = false;
+      break;
+    case 'd':
+      display = false;
+      break;
+    case 'h':
+      usage(argv[0], NULL);
+      return false;
+      break;
+
+    default:
+      usage(argv[0], optarg_);
+      return false;
+      break;
+    }
+  }
+
+  if ((c == 1) || (c == -1)) {
+    // standalone param or error
+    usage(argv[0], NULL);
+    std::cerr << "ERROR: " << std::endl;
+    std::cerr << "  Bad argument " << optarg_ << std::endl << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+#if defined(VISP_HAVE_X11)
+namespace
+{
+bool sameColor(const vpRGBa &a, const vpRGBa &b) { return a.R == b.R && a.G == b.G && a.B == b.B; }
+
+bool checkGrey(const vpImage<vpRGBa> &Iwin, const vpImage<unsigned char> &I, const vpRect &roi)
+{
+  for (unsigned int i = (unsigned int)roi.getTop(); i <= (unsigned int)roi.getBottom(); i++) {
+    for (unsigned int j = (unsigned int)roi.getLeft(); j <= (unsigned int)roi.getRight(); j++) {
+      if (!sameColor(Iwin[i][j], vpRGBa(I[i][j]))) {
+        std::cerr << "Bad grey pixel (" << i << ", " << j << ")" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool checkColor(const vpImage<vpRGBa> &Iwin, const vpImage<vpRGBa> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      if (!sameColor(Iwin[i][j], I[i][j])) {
+        std::cerr << "Bad color pixel (" << i << ", " << j << ")" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+#endif
+
+int main(int argc, const char **argv)
+{
+#if defined(VISP_HAVE_X11)
+  try {
+    bool opt_click_allowed = true;
+    bool opt_display = true;
+
+    // Read the command line options
+    if (getOptions(argc, argv, opt_click_allowed, opt_display) == false) {
+      return EXIT_FAILURE;
+    }
+
+    if (opt_display) {
+      // Odd width to exercise the tail of the vectorized conversions
+      vpImage<unsigned char> I(241, 323);
+      for (unsigned int i = 0; i < I.getHeight(); i++)
+        for (unsigned int j = 0; j < I.getWidth(); j++)
+          I[i][j] = (unsigned char)((3 * i + j) % 256);
+
+      vpDisplayX d(I);
+      std::cout << "Shared memory transfer: " << (d.isSharedMemoryUsed() ? "yes" : "no") << std::endl;
+      if (d.getScreenDepth() < 24) {
+        std::cout << "Screen depth " << d.getScreenDepth() << " not tested" << std::endl;
+        return EXIT_SUCCESS;
+      }
+      vpRect full(0, 0, I.getWidth(), I.getHeight());
+
+      vpImage<vpRGBa> Iwin;
+      vpDisplay::display(I);
+      vpDisplay::flush(I);
+      vpDisplay::getImage(I, Iwin);
+      if (!checkGrey(Iwin, I, full)) {
+        return EXIT_FAILURE;
+      }
+
+      // Overlay only refreshes the area of the drawing
+      vpDisplay::displayRectangle(I, vpImagePoint(20, 30), 40, 50, vpColor::red, true);
+      vpDisplay::displayText(I, vpImagePoint(150, 10), "ViSP", vpColor::green);
+      vpDisplay::flush(I);
+      vpDisplay::getImage(I, Iwin);
+      if (!sameColor(Iwin[40][50], vpColor::red) || !checkGrey(Iwin, I, vpRect(100, 0, 200, 100))) {
+        std::cerr << "Bad overlay" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      // Region of interest
+      for (unsigned int i = 0; i < I.getHeight(); i++)
+        for (unsigned int j = 0; j < I.getWidth(); j++)
+          I[i][j] = (unsigned char)(255 - I[i][j]);
+      vpRect roi(61, 47, 101, 77);
+      vpDisplay::displayROI(I, roi);
+      vpDisplay::flushROI(I, roi);
+      vpDisplay::getImage(I, Iwin);
+      if (!checkGrey(Iwin, I, roi)) {
+        return EXIT_FAILURE;
+      }
+      vpDisplay::close(I);
+
+      vpImage<vpRGBa> C(241, 323);
+      for (unsigned int i = 0; i < C.getHeight(); i++)
+        for (unsigned int j = 0; j < C.getWidth(); j++)
+          C[i][j] = vpRGBa((unsigned char)i, (unsigned char)j, (unsigned char)(i + j));
+
+      d.init(C);
+      for (unsigned int n = 0; n < 3; n++) {
+        vpDisplay::display(C);
+        vpDisplay::flush(C);
+      }
+      vpImage<vpRGBa> Cwin;
+      vpDisplay::getImage(C, Cwin);
+      if (!checkColor(Cwin, C)) {
+        return EXIT_FAILURE;
+      }
+
+      if (opt_click_allowed) {
+        std::cout << "A click in the image to exit..." << std::endl;
+        vpDisplay::getClick(C);
+      }
+    }
+    std::cout << "testDisplayXOverlay is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (vpException &e) {
+    std::cerr << "Catch an exception: " << e.getStringMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+#else
+  (void)argc;
+  (void)argv;
+  std::cout << "This test requires X11" << std::endl;
+  return EXIT_SUCCESS;
+#endif
+}
@@ -0,0 +1,140 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the bounded point storage and the data recording of a plot graph.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testPlotGraph.cpp
+
+  \brief Plot curves in an offscreen image and check that the number of
+  stored points is bounded while the data recording keeps every point.
+*/
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpIoTools.h>
+
+#if defined(VISP_HAVE_DISPLAY)
+
+#include <visp3/gui/vpDisplayOffscreen.h>
+#include <visp3/gui/vpPlotGraph.h>
+
+int main()
+{
+  try {
+    vpImage<unsigned char> I(350, 500, 255);
+    vpDisplayOffscreen d(I);
+    vpDisplay::display(I);
+
+    vpPlotGraph graph;
+    graph.initSize(vpImagePoint(0, 0), 500, 350, 30, 40);
+
+    // 0 is not a valid capacity
+    bool rejected = false;
+    try {
+      graph.setMaxNumberOfPoints(0);
+    } catch (vpException &e) {
+      rejected = (e.getCode() == vpException::badValue);
+    }
+    if (!rejected)
+      throw vpException(vpException::fatalError, "A capacity of 0 is not rejected");
+
+    // The capacity set before initGraph() applies to the curves it creates
+    graph.setMaxNumberOfPoints(50);
+    graph.initGraph(2);
+
+#if defined(_WIN32)
+    std::string opath = "C:/temp";
+#else
+    std::string opath = "/tmp";
+#endif
+    std::string username;
+    vpIoTools::getUserName(username);
+    opath = vpIoTools::createFilePath(opath, username);
+    opath = vpIoTools::createFilePath(opath, "testPlotGraph");
+    vpIoTools::makeDirectory(opath);
+    std::string dataFile = vpIoTools::createFilePath(opath, "plot.dat");
+    graph.startDataRecording(dataFile, "# ");
+    const unsigned int nbPoints = 1000;
+    for (unsigned int k = 0; k < nbPoints; k++) {
+      graph.plot(I, 0, k, sin(k / 20.));
+      graph.plot(I, 1, k, cos(k / 20.));
+    }
+    graph.stopDataRecording();
+
+    if (graph.curveList[0].nbPoint != 50 || graph.curveList[1].nbPoint != 50)
+      throw vpException(vpException::fatalError, "The curves do not store the 50 last points");
+    double x = 0, y = 0, z = 0;
+    graph.curveList[0].getPoint(0, x, y, z);
+    if (x != nbPoints - 50)
+      throw vpException(vpException::fatalError, "The oldest stored point is not the 50th last one");
+    graph.curveList[1].getPoint(49, x, y, z);
+    if (x != nbPoints - 1)
+      throw vpException(vpException::fatalError, "The newest stored point is not the last one");
+
+    // Reducing the capacity keeps the most recent points
+    graph.setMaxNumberOfPoints(10);
+    graph.curveList[0].getPoint(0, x, y, z);
+    if (graph.curveList[0].nbPoint != 10 || x != nbPoints - 10)
+      throw vpException(vpException::fatalError, "The capacity is not reduced to the 10 most recent points");
+
+    // The recording contains the title line and every plotted point
+    std::ifstream file(dataFile.c_str());
+    std::string line;
+    unsigned int nbLines = 0;
+    while (std::getline(file, line))
+      nbLines++;
+    file.close();
+    vpIoTools::remove(dataFile);
+    if (nbLines != 1 + 2 * nbPoints)
+      throw vpException(vpException::fatalError, "%u lines are recorded instead of %u", nbLines, 1 + 2 * nbPoints);
+
+    std::cout << "testPlotGraph is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
+
+#else
+int main()
+{
+  std::cout << "No display available, skip testPlotGraph" << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
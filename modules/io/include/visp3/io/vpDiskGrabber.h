@@ -103,6 +103,23 @@ int main(){
     g.acquire(I) ;
   }
 }
+\endcode
+
+  When decoding the images is the bottleneck, for example when replaying a
+  sequence of PNG or JPEG images, the images can be read in advance by
+  background threads with setPrefetch(). The next images, following the step,
+  are decoded in a bounded ring of buffers and acquire() only exchanges the
+  content of the requested image with the one of the ring. Images are always
+  returned in the order requested by the caller: after a call to
+  setImageNumber() or setStep(), or when reading an image by its number, the
+  images that were prefetched for another position are dropped.
+
+\code
+  vpDiskGrabber g("/local/soft/ViSP/ViSP-images/cube/image.%04d.png");
+  g.setPrefetch(2, 8); // 2 decoding threads, 8 images in advance
+  g.open(I);
+  for (unsigned int cpt = 1; cpt < 10; cpt++)
+    g.acquire(I);
 \endcode
 */
 class VISP_EXPORT vpDiskGrabber : public vpFrameGrabber
@@ -121,6 +138,16 @@ private:
   bool m_use_generic_name;
   std::string m_generic_name;
 
+  unsigned int m_prefetch_threads; //!< number of decoding threads
+  unsigned int m_prefetch_size;    //!< number of images decoded in advance
+  class Impl;
+  Impl *m_impl;
+
+  vpDiskGrabber(const vpDiskGrabber &);            // noncopyable
+  vpDiskGrabber &operator=(const vpDiskGrabber &); //
+
+  std::string getImageName(long number) const;
+
 public:
   vpDiskGrabber();
   explicit vpDiskGrabber(const std::string &genericName);
@@ -142,6 +169,14 @@ public:
   */
   long getImageNumber() { return m_image_number; };
 
+  /*!
+    Return the number of threads used to decode the images in advance, 0 if
+    the images are read when acquired.
+
+    \sa setPrefetch()
+  */
+  unsigned int getPrefetchThreads() const { return m_prefetch_threads; }
+
   void open(vpImage<unsigned char> &I);
   void open(vpImage<vpRGBa> &I);
   void open(vpImage<float> &I);
@@ -152,6 +187,7 @@ public:
   void setGenericName(const std::string &genericName);
   void setImageNumber(long number);
   void setNumberOfZero(unsigned int noz);
+  void setPrefetch(unsigned int nb_threads, unsigned int buffer_size = 8);
   void setStep(long step);
 };
 
@@ -48,9 +48,11 @@
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpRGBa.h>
+#include <visp3/io/vpMemoryMappedFile.h>
 
 #include <iostream>
 #include <stdio.h>
+#include <vector>
 
 #if defined(_WIN32)
 // Include WinSock2.h before windows.h to ensure that winsock.h is not
@@ -76,6 +78,8 @@
   \brief Read/write images with various image format.
 
   This class has its own implementation of PGM and PPM images read/write.
+  PGM and PFM images can also be memory mapped with mapPGM() and mapPFM() to
+  access their pixels without any copy (see vpMemoryMappedFile).
 
   This class may benefit from optional 3rd parties:
   - libpng: If installed this optional 3rd party is used to read/write PNG
@@ -115,6 +119,17 @@ int main()
   This other example available in tutorial-image-reader.cpp shows how to
 read/write jpeg images. It supposes that \c libjpeg is installed. \include
 tutorial-image-reader.cpp
+
+  Data loggers that save many images per second may reduce the encoding time
+  with the \e jpeg_quality and \e png_compression parameters of write(), and
+  encode or decode several files in parallel with writeBatch() and
+  readBatch():
+  \code
+  std::vector<vpImage<unsigned char> > images(10, vpImage<unsigned char>(480, 640));
+  std::vector<std::string> filenames;
+  // ...
+  vpImageIo::writeBatch(images, filenames, 4, 90, vpImageIo::PNG_COMPRESSION_FAST);
+  \endcode
 */
 
 class VISP_EXPORT vpImageIo
@@ -140,11 +155,39 @@ private:
   static std::string getExtension(const std::string &filename);
 
 public:
+  /*!
+    Compression presets used to write PNG images. The fast presets trade a
+    larger file for a much shorter encoding time.
+  */
+  typedef enum {
+    PNG_COMPRESSION_DEFAULT, //!< libpng defaults: adaptive filtering and zlib level 6.
+    PNG_COMPRESSION_FAST,    //!< Sub filter and zlib level 1.
+    PNG_COMPRESSION_FASTEST, //!< No filter and zlib level 1.
+    PNG_COMPRESSION_BEST     //!< Adaptive filtering and zlib level 9.
+  } vpPNGCompression;
+
   static void read(vpImage<unsigned char> &I, const std::string &filename);
   static void read(vpImage<vpRGBa> &I, const std::string &filename);
 
-  static void write(const vpImage<unsigned char> &I, const std::string &filename);
-  static void write(const vpImage<vpRGBa> &I, const std::string &filename);
+  static void readBatch(std::vector<vpImage<unsigned char> > &I, const std::vector<std::string> &filenames,
+                        const unsigned int nb_threads = 0);
+  static void readBatch(std::vector<vpImage<vpRGBa> > &I, const std::vector<std::string> &filenames,
+                        const unsigned int nb_threads = 0);
+
+  static void write(const vpImage<unsigned char> &I, const std::string &filename, const int jpeg_quality = 75,
+                    const vpPNGCompression png_compression = PNG_COMPRESSION_DEFAULT);
+  static void write(const vpImage<vpRGBa> &I, const std::string &filename, const int jpeg_quality = 75,
+                    const vpPNGCompression png_compression = PNG_COMPRESSION_DEFAULT);
+
+  static void writeBatch(const std::vector<vpImage<unsigned char> > &I, const std::vector<std::string> &filenames,
+                         const unsigned int nb_threads = 0, const int jpeg_quality = 75,
+                         const vpPNGCompression png_compression = PNG_COMPRESSION_DEFAULT);
+  static void writeBatch(const std::vector<vpImage<vpRGBa> > &I, const std::vector<std::string> &filenames,
+                         const unsigned int nb_threads = 0, const int jpeg_quality = 75,
+                         const vpPNGCompression png_compression = PNG_COMPRESSION_DEFAULT);
+
+  static void mapPFM(vpImage<float> &I, vpMemoryMappedFile &file, const std::string &filename);
+  static void mapPGM(vpImage<unsigned char> &I, vpMemoryMappedFile &file, const std::string &filename);
 
   static void readPFM(vpImage<float> &I, const std::string &filename);
 
@@ -174,13 +217,15 @@ public:
   static void writePPM(const vpImage<vpRGBa> &I, const std::string &filename);
 
 #if (defined(VISP_HAVE_JPEG) || defined(VISP_HAVE_OPENCV))
-  static void writeJPEG(const vpImage<unsigned char> &I, const std::string &filename);
-  static void writeJPEG(const vpImage<vpRGBa> &I, const std::string &filename);
+  static void writeJPEG(const vpImage<unsigned char> &I, const std::string &filename, const int quality = 75);
+  static void writeJPEG(const vpImage<vpRGBa> &I, const std::string &filename, const int quality = 75);
 #endif
 
 #if (defined(VISP_HAVE_PNG) || defined(VISP_HAVE_OPENCV))
-  static void writePNG(const vpImage<unsigned char> &I, const std::string &filename);
-  static void writePNG(const vpImage<vpRGBa> &I, const std::string &filename);
+  static void writePNG(const vpImage<unsigned char> &I, const std::string &filename,
+                       const vpPNGCompression compression = PNG_COMPRESSION_DEFAULT);
+  static void writePNG(const vpImage<vpRGBa> &I, const std::string &filename,
+                       const vpPNGCompression compression = PNG_COMPRESSION_DEFAULT);
 #endif
 };
 #endif
@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Read-only memory mapping of a file.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpMemoryMappedFile.h
+  \brief Map a file in memory.
+*/
+
+#ifndef vpMemoryMappedFile_h
+#define vpMemoryMappedFile_h
+
+#include <string>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpMemoryMappedFile
+
+  \ingroup group_io_image
+
+  \brief Map the content of a file in the address space of the process.
+
+  The file is opened read-only and mapped copy-on-write: the pages are loaded
+  on demand by the operating system, and writing in the mapped memory
+  modifies a private copy of the page without altering the file on disk.
+
+  This class is used by vpImageIo::mapPGM(), vpImageIo::mapPFM() and
+  vpRawFrameFile to expose the pixels stored in a file as a non-owning image
+  (see vpImage::initView()). Such an image is only valid while the
+  vpMemoryMappedFile remains open, and while the file is not truncated by
+  another process: accessing a page beyond the end of the file raises a bus
+  error. Only regular files can be mapped (see isMappable()).
+
+  \code
+#include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpMemoryMappedFile.h>
+
+int main()
+{
+  vpMemoryMappedFile file;
+  vpImage<unsigned char> I;
+  vpImageIo::mapPGM(I, file, "image.pgm"); // No pixel is copied
+  std::cout << "Image size: " << I.getWidth() << " x " << I.getHeight() << std::endl;
+  file.close(); // I must not be accessed anymore
+}
+  \endcode
+*/
+class VISP_EXPORT vpMemoryMappedFile
+{
+public:
+  vpMemoryMappedFile();
+  explicit vpMemoryMappedFile(const std::string &filename);
+  virtual ~vpMemoryMappedFile();
+
+  void close();
+
+  /*!
+    Return a pointer to the first byte of the mapped file, or NULL if no file
+    is mapped or if the file is empty.
+  */
+  inline unsigned char *getData() const { return m_data; }
+  //! Return the name of the mapped file.
+  inline std::string getFileName() const { return m_filename; }
+  //! Return the size in bytes of the mapped file.
+  inline size_t getSize() const { return m_size; }
+  //! Return true if a file is currently mapped.
+  inline bool isOpen() const { return m_isOpen; }
+  static bool isMappable(const std::string &filename);
+
+  void open(const std::string &filename);
+
+private:
+  vpMemoryMappedFile(const vpMemoryMappedFile &);            // noncopyable
+  vpMemoryMappedFile &operator=(const vpMemoryMappedFile &); //
+
+  std::string m_filename;
+  unsigned char *m_data;
+  size_t m_size;
+  bool m_isOpen;
+#if defined(_WIN32)
+  void *m_file;
+  void *m_mapping;
+#endif
+};
+
+#endif
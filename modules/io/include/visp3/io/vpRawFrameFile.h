@@ -0,0 +1,163 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Raw multi-frame image container.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpRawFrameFile.h
+  \brief Raw multi-frame image container that can be memory mapped.
+*/
+
+#ifndef vpRawFrameFile_h
+#define vpRawFrameFile_h
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+#include <visp3/io/vpMemoryMappedFile.h>
+
+/*!
+  \class vpRawFrameFile
+
+  \ingroup group_io_video
+
+  \brief Store a sequence of images of the same size and type in a single
+  binary file that can be memory mapped and randomly accessed.
+
+  The file starts with a 64 bytes header containing the magic string
+  "VISPRAW1", a byte order mark, the format version, the pixel type, the
+  image size and the number of frames. It is followed by the frames stored
+  one after the other without any compression, the frame \f$k\f$ starting at
+  offset \f$64 + k \times width \times height \times pixel\_size\f$. The
+  supported pixel types are unsigned char, uint16_t (depth maps), float and
+  vpRGBa.
+
+  When a file is read, it is memory mapped and getFrame() initializes an
+  image that points directly to the pixels of the requested frame: no pixel
+  is copied and only the accessed pages are loaded from the disk. Such an
+  image does not own its bitmap and remains valid only until close() is
+  called. Modifying it does not alter the file.
+
+  The example below records depth maps and reads them back.
+  \code
+#include <visp3/io/vpRawFrameFile.h>
+
+int main()
+{
+  vpImage<uint16_t> depth(480, 640, 0);
+
+  vpRawFrameFile writer;
+  writer.create("depth.raw", vpRawFrameFile::PIXEL_UINT16, depth.getWidth(), depth.getHeight());
+  for (unsigned int k = 0; k < 10; k++) {
+    // Acquire depth...
+    writer.write(depth);
+  }
+  writer.close();
+
+  vpRawFrameFile reader;
+  reader.open("depth.raw");
+  for (unsigned int k = 0; k < reader.getNumberOfFrames(); k++) {
+    reader.getFrame(depth, k); // depth points to the mapped file
+  }
+  reader.close();
+}
+  \endcode
+
+  \note The byte order of the file is the one of the machine that wrote it.
+  Opening a file written with another byte order throws an exception.
+*/
+class VISP_EXPORT vpRawFrameFile
+{
+public:
+  //! Type of the pixels stored in the file.
+  typedef enum {
+    PIXEL_UCHAR,  //!< unsigned char pixels.
+    PIXEL_UINT16, //!< uint16_t pixels, typically depth maps.
+    PIXEL_FLOAT,  //!< float pixels.
+    PIXEL_RGBA    //!< vpRGBa pixels.
+  } vpPixelType;
+
+  vpRawFrameFile();
+  virtual ~vpRawFrameFile();
+
+  void close();
+  void create(const std::string &filename, const vpPixelType type, const unsigned int width,
+              const unsigned int height);
+
+  void getFrame(vpImage<unsigned char> &I, const unsigned int index);
+  void getFrame(vpImage<uint16_t> &I, const unsigned int index);
+  void getFrame(vpImage<float> &I, const unsigned int index);
+  void getFrame(vpImage<vpRGBa> &I, const unsigned int index);
+
+  //! Return the size in bytes of a frame.
+  inline size_t getFrameSize() const { return (size_t)m_width * m_height * getPixelSize(m_pixelType); }
+  //! Return the height of the frames.
+  inline unsigned int getHeight() const { return m_height; }
+  //! Return the number of frames stored in the file.
+  inline unsigned int getNumberOfFrames() const { return m_nbFrames; }
+  //! Return the type of the pixels.
+  inline vpPixelType getPixelType() const { return m_pixelType; }
+  //! Return the width of the frames.
+  inline unsigned int getWidth() const { return m_width; }
+
+  void open(const std::string &filename);
+
+  void write(const vpImage<unsigned char> &I);
+  void write(const vpImage<uint16_t> &I);
+  void write(const vpImage<float> &I);
+  void write(const vpImage<vpRGBa> &I);
+
+  static size_t getPixelSize(const vpPixelType type);
+
+private:
+  vpRawFrameFile(const vpRawFrameFile &);            // noncopyable
+  vpRawFrameFile &operator=(const vpRawFrameFile &); //
+
+  unsigned char *getFrameData(const vpPixelType type, const unsigned int index);
+  void writeFrame(const unsigned char *bitmap, const vpPixelType type, const unsigned int width,
+                  const unsigned int height);
+  void writeHeader();
+
+  std::string m_filename;
+  vpPixelType m_pixelType;
+  unsigned int m_width;
+  unsigned int m_height;
+  unsigned int m_nbFrames;
+  vpMemoryMappedFile m_file;
+  std::ofstream m_writer;
+};
+
+#endif
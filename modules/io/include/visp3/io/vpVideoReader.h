@@ -145,6 +145,17 @@ int main()
 }
   \endcode
 
+  When decoding the images of a sequence is the bottleneck, setPrefetch()
+  allows to decode the next images in background threads. The frames are
+  still returned in the same order, including with a negative frame step.
+  \code
+  reader.setFileName("./image/image%04d.png");
+  reader.setPrefetch(2); // 2 decoding threads
+  reader.open(I);
+  while (! reader.end() )
+    reader.acquire(I);
+  \endcode
+
   Note that it is also possible to access to a specific frame using
 getFrame().
 \code
@@ -223,6 +234,10 @@ private:
   //! The frame step
   long frameStep;
   double frameRate;
+  //! Number of threads decoding the images of a sequence in advance
+  unsigned int prefetchThreads;
+  //! Number of images of a sequence decoded in advance
+  unsigned int prefetchSize;
 
   // private:
   //#ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -374,6 +389,7 @@ public:
   \sa setFrameStep()
 */
   inline void setFrameStep(const long frame_step) { this->frameStep = frame_step; }
+  void setPrefetch(unsigned int nb_threads, unsigned int buffer_size = 8);
 
 private:
   vpVideoFormatType getFormat(const char *filename);
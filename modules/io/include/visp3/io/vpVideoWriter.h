@@ -151,6 +151,26 @@ int main()
   return 0;
 }
   \endcode
+
+  Encoding and writing the frames may take longer than the period of a
+  control loop, especially when the disk stalls. setAsync() moves this work
+  to background threads: saveFrame() only copies the image in a recycled
+  buffer of a bounded queue and returns. When the queue is full, the
+  vpQueuePolicy decides whether saveFrame() waits or a frame is dropped.
+  getDroppedFrames() and getQueueDepth() allow to monitor the recording.
+
+  \code
+  vpVideoWriter writer;
+  writer.setFileName("./image/image%04d.png");
+  writer.setCompression(90, vpImageIo::PNG_COMPRESSION_FAST);
+  writer.setAsync(2, 16, vpVideoWriter::QUEUE_DROP_OLDEST); // 2 encoding threads
+  writer.open(I);
+  for ( ; ; ) {
+    writer.saveFrame(I); // Returns as soon as I is copied
+  }
+  writer.close(); // Waits until all the queued frames are written
+  std::cout << writer.getDroppedFrames() << " frames dropped" << std::endl;
+  \endcode
 */
 
 class VISP_EXPORT vpVideoWriter
@@ -196,6 +216,34 @@ private:
   unsigned int width;
   unsigned int height;
 
+public:
+  /*!
+    Policy applied by saveFrame() in asynchronous mode when all the buffers
+    of the queue are used.
+  */
+  typedef enum {
+    QUEUE_BLOCK,       //!< Wait until an encoding thread releases a buffer.
+    QUEUE_DROP_OLDEST, //!< Drop the oldest frame that is waiting to be encoded.
+    QUEUE_DROP_NEWEST  //!< Drop the frame given to saveFrame().
+  } vpQueuePolicy;
+
+private:
+  //! Number of encoding threads, 0 when frames are written synchronously
+  unsigned int asyncThreads;
+  //! Number of frames that can wait to be encoded
+  unsigned int queueSize;
+  //! Policy when the queue is full
+  vpQueuePolicy queuePolicy;
+  //! Quality of JPEG images
+  int jpegQuality;
+  //! Compression of PNG images
+  vpImageIo::vpPNGCompression pngCompression;
+  //! Counters of the last asynchronous recording
+  unsigned int droppedFrames;
+  unsigned int maxQueueDepth;
+  class Impl;
+  Impl *impl;
+
 public:
   vpVideoWriter();
   ~vpVideoWriter();
@@ -209,6 +257,10 @@ public:
   */
   inline unsigned int getCurrentFrameIndex() const { return frameCount; }
 
+  unsigned int getDroppedFrames() const;
+  unsigned int getMaxQueueDepth() const;
+  unsigned int getQueueDepth() const;
+
   void open(vpImage<vpRGBa> &I);
   void open(vpImage<unsigned char> &I);
   /*!
@@ -221,10 +273,14 @@ public:
   void saveFrame(vpImage<vpRGBa> &I);
   void saveFrame(vpImage<unsigned char> &I);
 
+  void setAsync(const unsigned int nb_threads, const unsigned int queue_size = 8,
+                const vpQueuePolicy policy = QUEUE_BLOCK);
+
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
   inline void setCodec(const int fourcc_codec) { this->fourcc = fourcc_codec; }
 #endif
 
+  void setCompression(const int jpeg_quality, const vpImageIo::vpPNGCompression png_compression);
   void setFileName(const char *filename);
   void setFileName(const std::string &filename);
   /*!
@@ -245,8 +301,15 @@ public:
 #endif
 
 private:
+  vpVideoWriter(const vpVideoWriter &);            // noncopyable
+  vpVideoWriter &operator=(const vpVideoWriter &); //
+
   vpVideoFormatType getFormat(const char *filename);
   static std::string getExtension(const std::string &filename);
+  bool isImageSequence() const;
+  void startAsync();
+  void writeFrame(const vpImage<vpRGBa> &I, const unsigned int frame_index);
+  void writeFrame(const vpImage<unsigned char> &I, const unsigned int frame_index);
 };
 
 #endif
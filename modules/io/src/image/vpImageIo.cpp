@@ -44,75 +44,225 @@
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageConvert.h> //image  conversion
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMutex.h>
+#include <visp3/core/vpThread.h>
 #include <visp3/io/vpImageIo.h>
 
-void vp_decodeHeaderPNM(const std::string &filename, std::ifstream &fd, const std::string &magic, unsigned int &w,
-                        unsigned int &h, unsigned int &maxval);
+#include <ctype.h>
+#include <fstream>
+#include <sstream>
+#include <string.h>
+#include <vector>
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Characters of a PNM header stored in memory
+class vpPNMMemorySource
+{
+public:
+  vpPNMMemorySource(const unsigned char *data, size_t size) : m_data(data), m_size(size), m_pos(0) {}
+  int get() { return (m_pos < m_size) ? m_data[m_pos++] : EOF; }
+  int peek() const { return (m_pos < m_size) ? m_data[m_pos] : EOF; }
+  size_t tell() const { return m_pos; }
+
+private:
+  const unsigned char *m_data;
+  size_t m_size;
+  size_t m_pos;
+};
+
+// Characters of a PNM header read from a stream
+class vpPNMStreamSource
+{
+public:
+  explicit vpPNMStreamSource(std::istream &fd) : m_fd(fd) {}
+  int get() { return m_fd.get(); }
+  int peek() const { return m_fd.peek(); }
+
+private:
+  std::istream &m_fd;
+};
+
 /*!
- * Decode the PNM image header.
+ * Decode the PNM image header. After the call \e src points to the first
+ * byte of the pixels.
  * \param filename[in] : File name.
- * \param fd[in] : File desdcriptor.
+ * \param src[in] : Header characters, vpPNMMemorySource or vpPNMStreamSource.
  * \param magic[in] : Magic number for identifying the file type.
  * \param w[out] : Image width.
  * \param h[out] : Image height.
  * \param maxval[out] : Maximum pixel value.
  */
-void vp_decodeHeaderPNM(const std::string &filename, std::ifstream &fd, const std::string &magic, unsigned int &w,
+template <class Source>
+void vp_decodeHeaderPNM(const std::string &filename, Source &src, const std::string &magic, unsigned int &w,
                         unsigned int &h, unsigned int &maxval)
 {
-  std::string line;
-  unsigned int nb_elt = 4, cpt_elt = 0;
-  while (cpt_elt != nb_elt) {
-    // Skip empty lines or lines starting with # (comment)
-    while (std::getline(fd, line) && (line.compare(0, 1, "#") == 0 || line.size() == 0)) {
-    };
-
-    if (fd.eof()) {
-      fd.close();
-      throw(vpImageException(vpImageException::ioError, "Cannot read header of file \"%s\"", filename.c_str()));
+  unsigned int values[3] = {0, 0, 0};
+  for (unsigned int cpt_elt = 0; cpt_elt < 4; cpt_elt++) {
+    // Skip white spaces and comments
+    int c = src.peek();
+    while (c != EOF && (c == '#' || isspace(c))) {
+      if (c == '#') {
+        while (c != EOF && c != '\n')
+          c = src.get();
+      } else {
+        src.get();
+      }
+      c = src.peek();
     }
 
-    std::vector<std::string> header = vpIoTools::splitChain(line, std::string(" "));
-
-    if (header.size() == 0) {
-      fd.close();
+    std::string token;
+    while (c != EOF && !isspace(c) && c != '#') {
+      token += (char)src.get();
+      c = src.peek();
+    }
+    if (token.empty()) {
       throw(vpImageException(vpImageException::ioError, "Cannot read header of file \"%s\"", filename.c_str()));
     }
 
     if (cpt_elt == 0) { // decode magic
-      if (header[0].compare(0, magic.size(), magic) != 0) {
-        fd.close();
+      if (token.compare(0, magic.size(), magic) != 0) {
         throw(vpImageException(vpImageException::ioError, "\"%s\" is not a PNM file with magic number %s",
                                filename.c_str(), magic.c_str()));
       }
-      cpt_elt++;
-      header.erase(header.begin(),
-                   header.begin() + 1); // erase first element that is processed
+    } else { // decode width, height and maxval
+      std::istringstream ss(token);
+      if (!(ss >> values[cpt_elt - 1])) {
+        throw(vpImageException(vpImageException::ioError, "Cannot read header of file \"%s\"", filename.c_str()));
+      }
     }
-    while (header.size()) {
-      if (cpt_elt == 1) { // decode width
-        std::istringstream ss(header[0]);
-        ss >> w;
-        cpt_elt++;
-        header.erase(header.begin(),
-                     header.begin() + 1); // erase first element that is processed
-      } else if (cpt_elt == 2) {          // decode height
-        std::istringstream ss(header[0]);
-        ss >> h;
-        cpt_elt++;
-        header.erase(header.begin(),
-                     header.begin() + 1); // erase first element that is processed
-      } else if (cpt_elt == 3) {          // decode maxval
-        std::istringstream ss(header[0]);
-        ss >> maxval;
-        cpt_elt++;
-        header.erase(header.begin(),
-                     header.begin() + 1); // erase first element that is processed
+  }
+  w = values[0];
+  h = values[1];
+  maxval = values[2];
+
+  // A single white space separates maxval from the pixels
+  src.get();
+}
+
+/*!
+ * Check the image size and maxval decoded from a PNM header.
+ */
+void vp_checkHeaderPNM(const std::string &filename, unsigned int w, unsigned int h, unsigned int maxval)
+{
+  unsigned int w_max = 100000, h_max = 100000, maxval_max = 255;
+  if (w > w_max || h > h_max) {
+    throw(vpException(vpException::badValue, "Bad image size in \"%s\"", filename.c_str()));
+  }
+  if (maxval > maxval_max) {
+    throw(vpImageException(vpImageException::ioError, "Bad maxval in \"%s\"", filename.c_str()));
+  }
+}
+
+/*!
+ * Map a PNM file in memory and check its header.
+ * \param file[out] : Memory mapping of the file.
+ * \param filename[in] : File name.
+ * \param magic[in] : Magic number for identifying the file type.
+ * \param pixel_size[in] : Size in bytes of a pixel in the file.
+ * \param w[out] : Image width.
+ * \param h[out] : Image height.
+ * \return The offset of the pixel payload in the mapped file.
+ */
+size_t vp_mapPNM(vpMemoryMappedFile &file, const std::string &filename, const std::string &magic, size_t pixel_size,
+                 unsigned int &w, unsigned int &h)
+{
+  unsigned int maxval = 0;
+
+  try {
+    file.open(filename);
+  } catch (...) {
+    throw(vpImageException(vpImageException::ioError, "Cannot open file \"%s\"", filename.c_str()));
+  }
+
+  vpPNMMemorySource src(file.getData(), file.getSize());
+  try {
+    vp_decodeHeaderPNM(filename, src, magic, w, h, maxval);
+    vp_checkHeaderPNM(filename, w, h, maxval);
+  } catch (...) {
+    file.close();
+    throw;
+  }
+  size_t offset = src.tell();
+
+  size_t nbyte = (size_t)w * h * pixel_size;
+  if (file.getSize() - offset < nbyte) {
+    size_t available = file.getSize() - offset;
+    file.close();
+    throw(vpImageException(vpImageException::ioError, "Read only %d of %d bytes in file \"%s\"", (int)available,
+                           (int)nbyte, filename.c_str()));
+  }
+
+  return offset;
+}
+
+/*
+ * Pixels of a PNM file being read. Regular files are mapped in memory;
+ * pipes and devices like /dev/stdin, that cannot be mapped, are read as a
+ * stream.
+ */
+class vpPNMReader
+{
+public:
+  vpPNMReader(const std::string &filename, const std::string &magic, size_t pixel_size)
+    : m_filename(filename), m_file(), m_fd(), m_payload(NULL), m_nbyte(0), m_w(0), m_h(0)
+  {
+    if (vpMemoryMappedFile::isMappable(filename)) {
+      size_t offset = vp_mapPNM(m_file, filename, magic, pixel_size, m_w, m_h);
+      m_payload = m_file.getData() + offset;
+    } else {
+      m_fd.open(filename.c_str(), std::ios::binary);
+      if (!m_fd.is_open()) {
+        throw(vpImageException(vpImageException::ioError, "Cannot open file \"%s\"", filename.c_str()));
       }
+      unsigned int maxval = 0;
+      vpPNMStreamSource src(m_fd);
+      vp_decodeHeaderPNM(filename, src, magic, m_w, m_h, maxval);
+      vp_checkHeaderPNM(filename, m_w, m_h, maxval);
     }
+    m_nbyte = (size_t)m_w * m_h * pixel_size;
   }
+
+  unsigned int getHeight() const { return m_h; }
+  unsigned int getWidth() const { return m_w; }
+
+  // Copy the pixels in dst, that has to store getWidth()*getHeight() pixels
+  void read(unsigned char *dst)
+  {
+    if (m_payload != NULL) {
+      memcpy(dst, m_payload, m_nbyte);
+    } else {
+      m_fd.read(reinterpret_cast<char *>(dst), (std::streamsize)m_nbyte);
+      if (!m_fd) {
+        throw(vpImageException(vpImageException::ioError, "Read only %d of %d bytes in file \"%s\"",
+                               (int)m_fd.gcount(), (int)m_nbyte, m_filename.c_str()));
+      }
+    }
+  }
+
+  // Pixels of the file, either in the mapping or in buffer
+  unsigned char *data(std::vector<unsigned char> &buffer)
+  {
+    if (m_payload != NULL) {
+      return m_payload;
+    }
+    buffer.resize(m_nbyte);
+    if (m_nbyte > 0) {
+      read(&buffer[0]);
+    }
+    return buffer.empty() ? NULL : &buffer[0];
+  }
+
+private:
+  std::string m_filename;
+  vpMemoryMappedFile m_file;
+  std::ifstream m_fd;
+  unsigned char *m_payload;
+  size_t m_nbyte;
+  unsigned int m_w;
+  unsigned int m_h;
+};
 }
 #endif
 
@@ -371,8 +521,11 @@ void vpImageIo::read(vpImage<vpRGBa> &I, const std::string &filename)
 
   \param I : Image to write.
   \param filename : Name of the file containing the image.
+  \param jpeg_quality : Quality in [0, 100] used to write JPEG files.
+  \param png_compression : Compression preset used to write PNG files.
  */
-void vpImageIo::write(const vpImage<unsigned char> &I, const std::string &filename)
+void vpImageIo::write(const vpImage<unsigned char> &I, const std::string &filename, const int jpeg_quality,
+                      const vpPNGCompression png_compression)
 {
   bool try_opencv_writer = false;
 
@@ -385,14 +538,14 @@ void vpImageIo::write(const vpImage<unsigned char> &I, const std::string &filena
     break;
   case FORMAT_JPEG:
 #ifdef VISP_HAVE_JPEG
-    writeJPEG(I, filename);
+    writeJPEG(I, filename, jpeg_quality);
 #else
     try_opencv_writer = true;
 #endif
     break;
   case FORMAT_PNG:
 #ifdef VISP_HAVE_PNG
-    writePNG(I, filename);
+    writePNG(I, filename, png_compression);
 #else
     try_opencv_writer = true;
 #endif
@@ -433,8 +586,11 @@ void vpImageIo::write(const vpImage<unsigned char> &I, const std::string &filena
 
   \param I : Image to write.
   \param filename : Name of the file containing the image.
+  \param jpeg_quality : Quality in [0, 100] used to write JPEG files.
+  \param png_compression : Compression preset used to write PNG files.
  */
-void vpImageIo::write(const vpImage<vpRGBa> &I, const std::string &filename)
+void vpImageIo::write(const vpImage<vpRGBa> &I, const std::string &filename, const int jpeg_quality,
+                      const vpPNGCompression png_compression)
 {
   bool try_opencv_writer = false;
 
@@ -447,14 +603,14 @@ void vpImageIo::write(const vpImage<vpRGBa> &I, const std::string &filename)
     break;
   case FORMAT_JPEG:
 #ifdef VISP_HAVE_JPEG
-    writeJPEG(I, filename);
+    writeJPEG(I, filename, jpeg_quality);
 #else
     try_opencv_writer = true;
 #endif
     break;
   case FORMAT_PNG:
 #ifdef VISP_HAVE_PNG
-    writePNG(I, filename);
+    writePNG(I, filename, png_compression);
 #else
     try_opencv_writer = true;
 #endif
@@ -483,6 +639,228 @@ void vpImageIo::write(const vpImage<vpRGBa> &I, const std::string &filename)
   }
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/*
+  Read or write a list of images. The images are shared between the threads
+  that pick the next image to process under a mutex. All the images are
+  processed even if one of them fails; the error of the first failing image is
+  rethrown once all the threads are joined.
+*/
+template <class Type> class vpImageIoBatch
+{
+public:
+  vpImageIoBatch(std::vector<vpImage<Type> > *read_images, const std::vector<vpImage<Type> > *write_images,
+                 const std::vector<std::string> &filenames, int jpeg_quality,
+                 vpImageIo::vpPNGCompression png_compression)
+    : m_readImages(read_images), m_writeImages(write_images), m_filenames(filenames), m_jpegQuality(jpeg_quality),
+      m_pngCompression(png_compression),
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+      m_mutex(),
+#endif
+      m_next(0), m_failed(false), m_failedIndex(0), m_imageError(false), m_errorCode(0), m_errorMessage()
+  {
+  }
+
+  void run(unsigned int nb_threads)
+  {
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+    if (nb_threads > m_filenames.size())
+      nb_threads = (unsigned int)m_filenames.size();
+    if (nb_threads > 1) {
+      std::vector<vpThread *> threads(nb_threads, NULL);
+      for (size_t i = 0; i < threads.size(); i++)
+        threads[i] = new vpThread((vpThread::Fn)processingFunction, (vpThread::Args)this);
+      for (size_t i = 0; i < threads.size(); i++)
+        delete threads[i]; // join
+    } else
+#else
+    (void)nb_threads;
+#endif
+    {
+      process();
+    }
+
+    if (m_failed) {
+      if (m_imageError)
+        throw(vpImageException(m_errorCode, m_errorMessage));
+      throw(vpException(m_errorCode, m_errorMessage));
+    }
+  }
+
+private:
+  bool next(size_t &index)
+  {
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+    vpMutex::vpScopedLock lock(m_mutex);
+#endif
+    if (m_next >= m_filenames.size())
+      return false;
+    index = m_next++;
+    return true;
+  }
+
+  void setError(size_t index, bool image_error, int code, const std::string &message)
+  {
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+    vpMutex::vpScopedLock lock(m_mutex);
+#endif
+    if (m_failed && m_failedIndex < index)
+      return;
+    m_failed = true;
+    m_failedIndex = index;
+    m_imageError = image_error;
+    m_errorCode = code;
+    m_errorMessage = message;
+  }
+
+  void process()
+  {
+    size_t index;
+    while (next(index)) {
+      const std::string &filename = m_filenames[index];
+      try {
+        if (m_readImages != NULL)
+          vpImageIo::read((*m_readImages)[index], filename);
+        else
+          vpImageIo::write((*m_writeImages)[index], filename, m_jpegQuality, m_pngCompression);
+      } catch (vpImageException &e) {
+        setError(index, true, e.getCode(), e.getStringMessage());
+      } catch (vpException &e) {
+        setError(index, false, e.getCode(), e.getStringMessage());
+      } catch (...) {
+        setError(index, false, vpException::ioError, "Cannot process image \"" + filename + "\"");
+      }
+    }
+  }
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  static vpThread::Return processingFunction(vpThread::Args args)
+  {
+    static_cast<vpImageIoBatch *>(args)->process();
+    return 0;
+  }
+#endif
+
+  std::vector<vpImage<Type> > *m_readImages;
+  const std::vector<vpImage<Type> > *m_writeImages;
+  const std::vector<std::string> &m_filenames;
+  int m_jpegQuality;
+  vpImageIo::vpPNGCompression m_pngCompression;
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  vpMutex m_mutex;
+#endif
+  size_t m_next;
+  bool m_failed;
+  size_t m_failedIndex;
+  bool m_imageError;
+  int m_errorCode;
+  std::string m_errorMessage;
+};
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Read a list of images, possibly in parallel. Each image is read with read()
+  so that the file format is deduced from the extension.
+
+  \param I : Images to set with the content of the files. The vector is
+  resized to the number of files.
+  \param filenames : Names of the files to read.
+  \param nb_threads : Number of threads used to decode the images. With 0 or 1
+  thread the images are read sequentially by the calling thread.
+
+  \exception vpImageException, vpException : The exception thrown by read()
+  for the first image that cannot be read. All the other images are read.
+ */
+void vpImageIo::readBatch(std::vector<vpImage<unsigned char> > &I, const std::vector<std::string> &filenames,
+                          const unsigned int nb_threads)
+{
+  I.resize(filenames.size());
+  vpImageIoBatch<unsigned char> batch(&I, NULL, filenames, 75, PNG_COMPRESSION_DEFAULT);
+  batch.run(nb_threads);
+}
+
+/*!
+  Read a list of images, possibly in parallel. Each image is read with read()
+  so that the file format is deduced from the extension.
+
+  \param I : Images to set with the content of the files. The vector is
+  resized to the number of files.
+  \param filenames : Names of the files to read.
+  \param nb_threads : Number of threads used to decode the images. With 0 or 1
+  thread the images are read sequentially by the calling thread.
+
+  \exception vpImageException, vpException : The exception thrown by read()
+  for the first image that cannot be read. All the other images are read.
+ */
+void vpImageIo::readBatch(std::vector<vpImage<vpRGBa> > &I, const std::vector<std::string> &filenames,
+                          const unsigned int nb_threads)
+{
+  I.resize(filenames.size());
+  vpImageIoBatch<vpRGBa> batch(&I, NULL, filenames, 75, PNG_COMPRESSION_DEFAULT);
+  batch.run(nb_threads);
+}
+
+/*!
+  Write a list of images, possibly in parallel. Each image is written with
+  write() so that the file format is deduced from the extension.
+
+  \param I : Images to write.
+  \param filenames : Names of the files, one for each image.
+  \param nb_threads : Number of threads used to encode the images. With 0 or
+  1 thread the images are written sequentially by the calling thread.
+  \param jpeg_quality : Quality in [0, 100] used to write JPEG files.
+  \param png_compression : Compression preset used to write PNG files.
+
+  \exception vpException::dimensionError : If the number of images and file
+  names differ.
+  \exception vpImageException, vpException : The exception thrown by write()
+  for the first image that cannot be written. All the other images are
+  written.
+ */
+void vpImageIo::writeBatch(const std::vector<vpImage<unsigned char> > &I, const std::vector<std::string> &filenames,
+                           const unsigned int nb_threads, const int jpeg_quality,
+                           const vpPNGCompression png_compression)
+{
+  if (I.size() != filenames.size()) {
+    throw(vpException(vpException::dimensionError, "Cannot write %d images in %d files", (int)I.size(),
+                      (int)filenames.size()));
+  }
+  vpImageIoBatch<unsigned char> batch(NULL, &I, filenames, jpeg_quality, png_compression);
+  batch.run(nb_threads);
+}
+
+/*!
+  Write a list of images, possibly in parallel. Each image is written with
+  write() so that the file format is deduced from the extension.
+
+  \param I : Images to write.
+  \param filenames : Names of the files, one for each image.
+  \param nb_threads : Number of threads used to encode the images. With 0 or
+  1 thread the images are written sequentially by the calling thread.
+  \param jpeg_quality : Quality in [0, 100] used to write JPEG files.
+  \param png_compression : Compression preset used to write PNG files.
+
+  \exception vpException::dimensionError : If the number of images and file
+  names differ.
+  \exception vpImageException, vpException : The exception thrown by write()
+  for the first image that cannot be written. All the other images are
+  written.
+ */
+void vpImageIo::writeBatch(const std::vector<vpImage<vpRGBa> > &I, const std::vector<std::string> &filenames,
+                           const unsigned int nb_threads, const int jpeg_quality,
+                           const vpPNGCompression png_compression)
+{
+  if (I.size() != filenames.size()) {
+    throw(vpException(vpException::dimensionError, "Cannot write %d images in %d files", (int)I.size(),
+                      (int)filenames.size()));
+  }
+  vpImageIoBatch<vpRGBa> batch(NULL, &I, filenames, jpeg_quality, png_compression);
+  batch.run(nb_threads);
+}
+
 //--------------------------------------------------------------------------
 // PFM
 //--------------------------------------------------------------------------
@@ -492,6 +870,9 @@ void vpImageIo::write(const vpImage<vpRGBa> &I, const std::string &filename)
   filename. This function is built like portable gray pixmap (eg PGM P5) file.
   but considers float image data.
 
+  The header is padded with a comment line so that the pixels start at a
+  16 bytes aligned offset, which allows mapPFM() to access them without copy.
+
   \param I : Image to save as a (PFM P8) file.
   \param filename : Name of the file containing the image.
 */
@@ -511,10 +892,21 @@ void vpImageIo::writePFM(const vpImage<float> &I, const std::string &filename)
     throw(vpImageException(vpImageException::ioError, "Cannot create PFM file \"%s\"", filename.c_str()));
   }
 
-  // Write the head
-  fprintf(fd, "P8\n");                                 // Magic number
-  fprintf(fd, "%u %u\n", I.getWidth(), I.getHeight()); // Image size
-  fprintf(fd, "255\n");                                // Max level
+  // Write the head. A comment line pads the header so that the floats are
+  // aligned in memory when the file is mapped by mapPFM()
+  char size_line[32];
+  int size_len = sprintf(size_line, "%u %u\n", I.getWidth(), I.getHeight());
+  size_t header_len = 3 + (size_t)size_len + 4;
+  size_t padding = (16 - header_len % 16) % 16;
+  if (padding == 1)
+    padding += 16;
+
+  fprintf(fd, "P8\n"); // Magic number
+  if (padding > 0) {
+    fprintf(fd, "#%*s\n", (int)padding - 2, ""); // Padding comment
+  }
+  fprintf(fd, "%s", size_line); // Image size
+  fprintf(fd, "255\n");         // Max level
 
   // Write the bitmap
   size_t ierr;
@@ -664,41 +1056,44 @@ void vpImageIo::writePGM(const vpImage<vpRGBa> &I, const std::string &filename)
 
 void vpImageIo::readPFM(vpImage<float> &I, const std::string &filename)
 {
-  unsigned int w = 0, h = 0, maxval = 0;
-  unsigned int w_max = 100000, h_max = 100000, maxval_max = 255;
-  std::string magic("P8");
-
-  std::ifstream fd(filename.c_str(), std::ios::binary);
+  vpPNMReader reader(filename, "P8", sizeof(float));
 
-  // Open the filename
-  if (!fd.is_open()) {
-    throw(vpImageException(vpImageException::ioError, "Cannot open file \"%s\"", filename.c_str()));
+  if ((reader.getHeight() != I.getHeight()) || (reader.getWidth() != I.getWidth())) {
+    I.resize(reader.getHeight(), reader.getWidth());
   }
 
-  vp_decodeHeaderPNM(filename, fd, magic, w, h, maxval);
+  reader.read(reinterpret_cast<unsigned char *>(I.bitmap));
+}
 
-  if (w > w_max || h > h_max) {
-    fd.close();
-    throw(vpException(vpException::badValue, "Bad image size in \"%s\"", filename.c_str()));
-  }
-  if (maxval > maxval_max) {
-    fd.close();
-    throw(vpImageException(vpImageException::ioError, "Bad maxval in \"%s\"", filename.c_str()));
-  }
+/*!
+  Map a PFM P8 file in memory and initialize a float image that points to the
+  pixels stored in the file.
 
-  if ((h != I.getHeight()) || (w != I.getWidth())) {
-    I.resize(h, w);
-  }
+  Unlike readPFM(), no memory is allocated for the bitmap: \e I does not own
+  its pixels and remains valid only while \e file is open. Modifying \e I
+  does not alter the file on disk. If the pixels are not aligned on a float
+  boundary in the file (PFM files that were not written by writePFM()), they
+  are copied in a bitmap owned by \e I.
 
-  unsigned int nbyte = I.getHeight() * I.getWidth();
-  fd.read((char *)I.bitmap, sizeof(float) * nbyte);
-  if (!fd) {
-    fd.close();
-    throw(vpImageException(vpImageException::ioError, "Read only %d of %d bytes in file \"%s\"", fd.gcount(), nbyte,
-                           filename.c_str()));
-  }
+  \param I : Image to set with the \e filename content.
+  \param file : Memory mapping of \e filename. It has to be kept open as
+  long as \e I is used.
+  \param filename : Name of the file containing the image.
+
+  \sa readPFM(), vpMemoryMappedFile
+*/
+void vpImageIo::mapPFM(vpImage<float> &I, vpMemoryMappedFile &file, const std::string &filename)
+{
+  unsigned int w = 0, h = 0;
+  size_t offset = vp_mapPNM(file, filename, "P8", sizeof(float), w, h);
 
-  fd.close();
+  unsigned char *data = file.getData() + offset;
+  if (reinterpret_cast<size_t>(data) % sizeof(float) == 0) {
+    I.initView(reinterpret_cast<float *>(data), h, w);
+  } else {
+    I.init(h, w);
+    memcpy(I.bitmap, data, (size_t)w * h * sizeof(float));
+  }
 }
 
 /*!
@@ -718,41 +1113,13 @@ void vpImageIo::readPFM(vpImage<float> &I, const std::string &filename)
 
 void vpImageIo::readPGM(vpImage<unsigned char> &I, const std::string &filename)
 {
-  unsigned int w = 0, h = 0, maxval = 0;
-  unsigned int w_max = 100000, h_max = 100000, maxval_max = 255;
-  std::string magic("P5");
-
-  std::ifstream fd(filename.c_str(), std::ios::binary);
-
-  // Open the filename
-  if (!fd.is_open()) {
-    throw(vpImageException(vpImageException::ioError, "Cannot open file \"%s\"", filename.c_str()));
-  }
-
-  vp_decodeHeaderPNM(filename, fd, magic, w, h, maxval);
-
-  if (w > w_max || h > h_max) {
-    fd.close();
-    throw(vpException(vpException::badValue, "Bad image size in \"%s\"", filename.c_str()));
-  }
-  if (maxval > maxval_max) {
-    fd.close();
-    throw(vpImageException(vpImageException::ioError, "Bad maxval in \"%s\"", filename.c_str()));
-  }
+  vpPNMReader reader(filename, "P5", 1);
 
-  if ((h != I.getHeight()) || (w != I.getWidth())) {
-    I.resize(h, w);
+  if ((reader.getHeight() != I.getHeight()) || (reader.getWidth() != I.getWidth())) {
+    I.resize(reader.getHeight(), reader.getWidth());
   }
 
-  unsigned int nbyte = I.getHeight() * I.getWidth();
-  fd.read((char *)I.bitmap, nbyte);
-  if (!fd) {
-    fd.close();
-    throw(vpImageException(vpImageException::ioError, "Read only %d of %d bytes in file \"%s\"", fd.gcount(), nbyte,
-                           filename.c_str()));
-  }
-
-  fd.close();
+  reader.read(I.bitmap);
 }
 
 /*!
@@ -782,6 +1149,29 @@ void vpImageIo::readPGM(vpImage<vpRGBa> &I, const std::string &filename)
   vpImageConvert::convert(Itmp, I);
 }
 
+/*!
+  Map a PGM P5 file in memory and initialize a scalar image that points to
+  the pixels stored in the file.
+
+  Unlike readPGM(), no memory is allocated for the bitmap and no pixel is
+  copied: \e I does not own its pixels and remains valid only while \e file
+  is open. Modifying \e I does not alter the file on disk.
+
+  \param I : Image to set with the \e filename content.
+  \param file : Memory mapping of \e filename. It has to be kept open as
+  long as \e I is used.
+  \param filename : Name of the file containing the image.
+
+  \sa readPGM(), vpMemoryMappedFile
+*/
+void vpImageIo::mapPGM(vpImage<unsigned char> &I, vpMemoryMappedFile &file, const std::string &filename)
+{
+  unsigned int w = 0, h = 0;
+  size_t offset = vp_mapPNM(file, filename, "P5", 1, w, h);
+
+  I.initView(file.getData() + offset, h, w);
+}
+
 //--------------------------------------------------------------------------
 // PPM
 //--------------------------------------------------------------------------
@@ -804,11 +1194,14 @@ void vpImageIo::readPGM(vpImage<vpRGBa> &I, const std::string &filename)
 */
 void vpImageIo::readPPM(vpImage<unsigned char> &I, const std::string &filename)
 {
-  vpImage<vpRGBa> Itmp;
+  vpPNMReader reader(filename, "P6", 3);
 
-  vpImageIo::readPPM(Itmp, filename);
+  if ((reader.getHeight() != I.getHeight()) || (reader.getWidth() != I.getWidth())) {
+    I.resize(reader.getHeight(), reader.getWidth());
+  }
 
-  vpImageConvert::convert(Itmp, I);
+  std::vector<unsigned char> buffer;
+  vpImageConvert::RGBToGrey(reader.data(buffer), I.bitmap, I.getSize());
 }
 
 /*!
@@ -824,51 +1217,14 @@ void vpImageIo::readPPM(vpImage<unsigned char> &I, const std::string &filename)
 */
 void vpImageIo::readPPM(vpImage<vpRGBa> &I, const std::string &filename)
 {
-  unsigned int w = 0, h = 0, maxval = 0;
-  unsigned int w_max = 100000, h_max = 100000, maxval_max = 255;
-  std::string magic("P6");
-
-  std::ifstream fd(filename.c_str(), std::ios::binary);
+  vpPNMReader reader(filename, "P6", 3);
 
-  // Open the filename
-  if (!fd.is_open()) {
-    throw(vpImageException(vpImageException::ioError, "Cannot open file \"%s\"", filename.c_str()));
+  if ((reader.getHeight() != I.getHeight()) || (reader.getWidth() != I.getWidth())) {
+    I.resize(reader.getHeight(), reader.getWidth());
   }
 
-  vp_decodeHeaderPNM(filename, fd, magic, w, h, maxval);
-
-  if (w > w_max || h > h_max) {
-    fd.close();
-    throw(vpException(vpException::badValue, "Bad image size in \"%s\"", filename.c_str()));
-  }
-  if (maxval > maxval_max) {
-    fd.close();
-    throw(vpImageException(vpImageException::ioError, "Bad maxval in \"%s\"", filename.c_str()));
-  }
-
-  if ((h != I.getHeight()) || (w != I.getWidth())) {
-    I.resize(h, w);
-  }
-
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      unsigned char rgb[3];
-      fd.read((char *)&rgb, 3);
-
-      if (!fd) {
-        fd.close();
-        throw(vpImageException(vpImageException::ioError, "Read only %d of %d bytes in file \"%s\"",
-                               (i * I.getWidth() + j) * 3 + fd.gcount(), I.getSize() * 3, filename.c_str()));
-      }
-
-      I[i][j].R = rgb[0];
-      I[i][j].G = rgb[1];
-      I[i][j].B = rgb[2];
-      I[i][j].A = vpRGBa::alpha_default;
-    }
-  }
-
-  fd.close();
+  std::vector<unsigned char> buffer;
+  vpImageConvert::RGBToRGBa(reader.data(buffer), reinterpret_cast<unsigned char *>(I.bitmap), I.getSize());
 }
 
 /*!
@@ -946,18 +1302,19 @@ void vpImageIo::writePPM(const vpImage<vpRGBa> &I, const std::string &filename)
   Write the content of the image bitmap in the file which name is given by \e
   filename. This function writes a JPEG file.
 
+  The rows of the image are given to libjpeg without intermediate copy.
+
   \param I : Image to save as a JPEG file.
   \param filename : Name of the file containing the image.
+  \param quality : Quality in [0, 100]. Lower values give smaller files and
+  a faster encoding.
 */
-void vpImageIo::writeJPEG(const vpImage<unsigned char> &I, const std::string &filename)
+void vpImageIo::writeJPEG(const vpImage<unsigned char> &I, const std::string &filename, const int quality)
 {
   struct jpeg_compress_struct cinfo;
   struct jpeg_error_mgr jerr;
   FILE *file;
 
-  cinfo.err = jpeg_std_error(&jerr);
-  jpeg_create_compress(&cinfo);
-
   // Test the filename
   if (filename.empty()) {
     throw(vpImageException(vpImageException::ioError, "Cannot create JPEG file: filename empty"));
@@ -969,6 +1326,9 @@ void vpImageIo::writeJPEG(const vpImage<unsigned char> &I, const std::string &fi
     throw(vpImageException(vpImageException::ioError, "Cannot create JPEG file \"%s\"", filename.c_str()));
   }
 
+  cinfo.err = jpeg_std_error(&jerr);
+  jpeg_create_compress(&cinfo);
+
   unsigned int width = I.getWidth();
   unsigned int height = I.getHeight();
 
@@ -979,23 +1339,17 @@ void vpImageIo::writeJPEG(const vpImage<unsigned char> &I, const std::string &fi
   cinfo.input_components = 1;
   cinfo.in_color_space = JCS_GRAYSCALE;
   jpeg_set_defaults(&cinfo);
+  jpeg_set_quality(&cinfo, quality, TRUE);
 
   jpeg_start_compress(&cinfo, TRUE);
 
-  unsigned char *line;
-  line = new unsigned char[width];
-  unsigned char *input = (unsigned char *)I.bitmap;
   while (cinfo.next_scanline < cinfo.image_height) {
-    for (unsigned int i = 0; i < width; i++) {
-      line[i] = *(input);
-      input++;
-    }
-    jpeg_write_scanlines(&cinfo, &line, 1);
+    JSAMPROW row = (JSAMPROW)(I.bitmap + cinfo.next_scanline * width);
+    jpeg_write_scanlines(&cinfo, &row, 1);
   }
 
   jpeg_finish_compress(&cinfo);
   jpeg_destroy_compress(&cinfo);
-  delete[] line;
   fclose(file);
 }
 
@@ -1003,18 +1357,20 @@ void vpImageIo::writeJPEG(const vpImage<unsigned char> &I, const std::string &fi
   Write the content of the image bitmap in the file which name is given by \e
   filename. This function writes a JPEG file.
 
+  With libjpeg-turbo the rows of the image are given to the encoder without
+  intermediate copy, the alpha channel being skipped by the library.
+
   \param I : Image to save as a JPEG file.
   \param filename : Name of the file containing the image.
+  \param quality : Quality in [0, 100]. Lower values give smaller files and
+  a faster encoding.
 */
-void vpImageIo::writeJPEG(const vpImage<vpRGBa> &I, const std::string &filename)
+void vpImageIo::writeJPEG(const vpImage<vpRGBa> &I, const std::string &filename, const int quality)
 {
   struct jpeg_compress_struct cinfo;
   struct jpeg_error_mgr jerr;
   FILE *file;
 
-  cinfo.err = jpeg_std_error(&jerr);
-  jpeg_create_compress(&cinfo);
-
   // Test the filename
   if (filename.empty()) {
     throw(vpImageException(vpImageException::ioError, "Cannot create JPEG file: filename empty"));
@@ -1026,6 +1382,9 @@ void vpImageIo::writeJPEG(const vpImage<vpRGBa> &I, const std::string &filename)
     throw(vpImageException(vpImageException::ioError, "Cannot create JPEG file \"%s\"", filename.c_str()));
   }
 
+  cinfo.err = jpeg_std_error(&jerr);
+  jpeg_create_compress(&cinfo);
+
   unsigned int width = I.getWidth();
   unsigned int height = I.getHeight();
 
@@ -1033,31 +1392,34 @@ void vpImageIo::writeJPEG(const vpImage<vpRGBa> &I, const std::string &filename)
 
   cinfo.image_width = width;
   cinfo.image_height = height;
+#if defined(JCS_EXTENSIONS)
+  cinfo.input_components = 4;
+  cinfo.in_color_space = JCS_EXT_RGBX;
+#else
   cinfo.input_components = 3;
   cinfo.in_color_space = JCS_RGB;
+#endif
   jpeg_set_defaults(&cinfo);
+  jpeg_set_quality(&cinfo, quality, TRUE);
 
   jpeg_start_compress(&cinfo, TRUE);
 
-  unsigned char *line;
-  line = new unsigned char[3 * width];
-  unsigned char *input = (unsigned char *)I.bitmap;
+#if defined(JCS_EXTENSIONS)
   while (cinfo.next_scanline < cinfo.image_height) {
-    for (unsigned int i = 0; i < width; i++) {
-      line[i * 3] = *(input);
-      input++;
-      line[i * 3 + 1] = *(input);
-      input++;
-      line[i * 3 + 2] = *(input);
-      input++;
-      input++;
-    }
+    JSAMPROW row = (JSAMPROW)(I.bitmap + cinfo.next_scanline * width);
+    jpeg_write_scanlines(&cinfo, &row, 1);
+  }
+#else
+  unsigned char *line = new unsigned char[3 * width];
+  while (cinfo.next_scanline < cinfo.image_height) {
+    vpImageConvert::RGBaToRGB((unsigned char *)(I.bitmap + cinfo.next_scanline * width), line, width);
     jpeg_write_scanlines(&cinfo, &line, 1);
   }
+  delete[] line;
+#endif
 
   jpeg_finish_compress(&cinfo);
   jpeg_destroy_compress(&cinfo);
-  delete[] line;
   fclose(file);
 }
 
@@ -1069,6 +1431,9 @@ void vpImageIo::writeJPEG(const vpImage<vpRGBa> &I, const std::string &filename)
   filename, as in a black and white photograph. If necessary, the quantization
   formula used is \f$0,299 r + 0,587 g + 0,114 b\f$.
 
+  Gray level files are decoded directly in the rows of \e I, while color
+  files are converted row by row without intermediate color image.
+
   If the image has been already initialized, memory allocation is done
   only if the new image size is different, else we re-use the same
   memory space.
@@ -1083,9 +1448,6 @@ void vpImageIo::readJPEG(vpImage<unsigned char> &I, const std::string &filename)
   struct jpeg_error_mgr jerr;
   FILE *file;
 
-  cinfo.err = jpeg_std_error(&jerr);
-  jpeg_create_decompress(&cinfo);
-
   // Test the filename
   if (filename.empty()) {
     throw(vpImageException(vpImageException::ioError, "Cannot read JPEG image: filename empty"));
@@ -1097,6 +1459,9 @@ void vpImageIo::readJPEG(vpImage<unsigned char> &I, const std::string &filename)
     throw(vpImageException(vpImageException::ioError, "Cannot read JPEG file \"%s\"", filename.c_str()));
   }
 
+  cinfo.err = jpeg_std_error(&jerr);
+  jpeg_create_decompress(&cinfo);
+
   jpeg_stdio_src(&cinfo, file);
   jpeg_read_header(&cinfo, TRUE);
 
@@ -1108,29 +1473,20 @@ void vpImageIo::readJPEG(vpImage<unsigned char> &I, const std::string &filename)
 
   jpeg_start_decompress(&cinfo);
 
-  unsigned int rowbytes = cinfo.output_width * (unsigned int)(cinfo.output_components);
-  JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, rowbytes, 1);
-
   if (cinfo.out_color_space == JCS_RGB) {
-    vpImage<vpRGBa> Ic(height, width);
-    unsigned char *output = (unsigned char *)Ic.bitmap;
+    unsigned int rowbytes = cinfo.output_width * (unsigned int)(cinfo.output_components);
+    JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, rowbytes, 1);
     while (cinfo.output_scanline < cinfo.output_height) {
+      unsigned int row = cinfo.output_scanline;
       jpeg_read_scanlines(&cinfo, buffer, 1);
-      for (unsigned int i = 0; i < width; i++) {
-        *(output++) = buffer[0][i * 3];
-        *(output++) = buffer[0][i * 3 + 1];
-        *(output++) = buffer[0][i * 3 + 2];
-        *(output++) = vpRGBa::alpha_default;
-      }
+      vpImageConvert::RGBToGrey(buffer[0], I[row], width);
     }
-    vpImageConvert::convert(Ic, I);
   }
 
   else if (cinfo.out_color_space == JCS_GRAYSCALE) {
     while (cinfo.output_scanline < cinfo.output_height) {
-      unsigned int row = cinfo.output_scanline;
-      jpeg_read_scanlines(&cinfo, buffer, 1);
-      memcpy(I[row], buffer[0], rowbytes);
+      JSAMPROW row = I[cinfo.output_scanline];
+      jpeg_read_scanlines(&cinfo, &row, 1);
     }
   }
 
@@ -1154,6 +1510,8 @@ void vpImageIo::readJPEG(vpImage<unsigned char> &I, const std::string &filename)
   If the file corresponds to a grayscaled image, a conversion is done to deal
   with \e I which is a color image.
 
+  With libjpeg-turbo color files are decoded directly in the rows of \e I.
+
   \param I : Color image to set with the \e filename content.
   \param filename : Name of the file containing the image.
 */
@@ -1163,9 +1521,6 @@ void vpImageIo::readJPEG(vpImage<vpRGBa> &I, const std::string &filename)
   struct jpeg_error_mgr jerr;
   FILE *file;
 
-  cinfo.err = jpeg_std_error(&jerr);
-  jpeg_create_decompress(&cinfo);
-
   // Test the filename
   if (filename.empty()) {
     throw(vpImageException(vpImageException::ioError, "Cannot read JPEG image: filename empty"));
@@ -1177,6 +1532,9 @@ void vpImageIo::readJPEG(vpImage<vpRGBa> &I, const std::string &filename)
     throw(vpImageException(vpImageException::ioError, "Cannot read JPEG file \"%s\"", filename.c_str()));
   }
 
+  cinfo.err = jpeg_std_error(&jerr);
+  jpeg_create_decompress(&cinfo);
+
   jpeg_stdio_src(&cinfo, file);
 
   jpeg_read_header(&cinfo, TRUE);
@@ -1187,34 +1545,40 @@ void vpImageIo::readJPEG(vpImage<vpRGBa> &I, const std::string &filename)
   if ((width != I.getWidth()) || (height != I.getHeight()))
     I.resize(height, width);
 
+#if defined(JCS_ALPHA_EXTENSIONS)
+  // The alpha channel is set to 0xFF by libjpeg-turbo, that is vpRGBa::alpha_default
+  if (cinfo.out_color_space == JCS_RGB)
+    cinfo.out_color_space = JCS_EXT_RGBA;
+#endif
+
   jpeg_start_decompress(&cinfo);
 
   unsigned int rowbytes = cinfo.output_width * (unsigned int)(cinfo.output_components);
-  JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, rowbytes, 1);
 
+#if defined(JCS_ALPHA_EXTENSIONS)
+  if (cinfo.out_color_space == JCS_EXT_RGBA) {
+    while (cinfo.output_scanline < cinfo.output_height) {
+      JSAMPROW row = (JSAMPROW)I[cinfo.output_scanline];
+      jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+  } else
+#endif
   if (cinfo.out_color_space == JCS_RGB) {
-    unsigned char *output = (unsigned char *)I.bitmap;
+    JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, rowbytes, 1);
     while (cinfo.output_scanline < cinfo.output_height) {
+      unsigned int row = cinfo.output_scanline;
       jpeg_read_scanlines(&cinfo, buffer, 1);
-      for (unsigned int i = 0; i < width; i++) {
-        *(output++) = buffer[0][i * 3];
-        *(output++) = buffer[0][i * 3 + 1];
-        *(output++) = buffer[0][i * 3 + 2];
-        *(output++) = vpRGBa::alpha_default;
-      }
+      vpImageConvert::RGBToRGBa(buffer[0], (unsigned char *)I[row], width);
     }
   }
 
   else if (cinfo.out_color_space == JCS_GRAYSCALE) {
-    vpImage<unsigned char> Ig(height, width);
-
+    JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, rowbytes, 1);
     while (cinfo.output_scanline < cinfo.output_height) {
       unsigned int row = cinfo.output_scanline;
       jpeg_read_scanlines(&cinfo, buffer, 1);
-      memcpy(Ig[row], buffer[0], rowbytes);
+      vpImageConvert::GreyToRGBa(buffer[0], (unsigned char *)I[row], width);
     }
-
-    vpImageConvert::convert(Ig, I);
   }
 
   jpeg_finish_decompress(&cinfo);
@@ -1230,14 +1594,19 @@ void vpImageIo::readJPEG(vpImage<vpRGBa> &I, const std::string &filename)
 
   \param I : Image to save as a JPEG file.
   \param filename : Name of the file containing the image.
+  \param quality : Quality in [0, 100].
 */
-void vpImageIo::writeJPEG(const vpImage<unsigned char> &I, const std::string &filename)
+void vpImageIo::writeJPEG(const vpImage<unsigned char> &I, const std::string &filename, const int quality)
 {
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   cv::Mat Ip;
   vpImageConvert::convert(I, Ip);
-  cv::imwrite(filename.c_str(), Ip);
+  std::vector<int> params;
+  params.push_back(cv::IMWRITE_JPEG_QUALITY);
+  params.push_back(quality);
+  cv::imwrite(filename.c_str(), Ip, params);
 #else
+  (void)quality;
   IplImage *Ip = NULL;
   vpImageConvert::convert(I, Ip);
 
@@ -1253,14 +1622,19 @@ void vpImageIo::writeJPEG(const vpImage<unsigned char> &I, const std::string &fi
 
   \param I : Image to save as a JPEG file.
   \param filename : Name of the file containing the image.
+  \param quality : Quality in [0, 100].
 */
-void vpImageIo::writeJPEG(const vpImage<vpRGBa> &I, const std::string &filename)
+void vpImageIo::writeJPEG(const vpImage<vpRGBa> &I, const std::string &filename, const int quality)
 {
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   cv::Mat Ip;
   vpImageConvert::convert(I, Ip);
-  cv::imwrite(filename.c_str(), Ip);
+  std::vector<int> params;
+  params.push_back(cv::IMWRITE_JPEG_QUALITY);
+  params.push_back(quality);
+  cv::imwrite(filename.c_str(), Ip, params);
 #else
+  (void)quality;
   IplImage *Ip = NULL;
   vpImageConvert::convert(I, Ip);
 
@@ -1362,14 +1736,45 @@ void vpImageIo::readJPEG(vpImage<vpRGBa> &I, const std::string &filename)
 
 #if defined(VISP_HAVE_PNG)
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Set the filters and the zlib level corresponding to a compression preset
+void vp_setPNGCompression(png_structp png_ptr, vpImageIo::vpPNGCompression compression)
+{
+  switch (compression) {
+  case vpImageIo::PNG_COMPRESSION_FAST:
+    png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
+    png_set_compression_level(png_ptr, 1);
+    break;
+  case vpImageIo::PNG_COMPRESSION_FASTEST:
+    png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+    png_set_compression_level(png_ptr, 1);
+    break;
+  case vpImageIo::PNG_COMPRESSION_BEST:
+    png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_ALL_FILTERS);
+    png_set_compression_level(png_ptr, 9);
+    break;
+  case vpImageIo::PNG_COMPRESSION_DEFAULT:
+  default:
+    break;
+  }
+}
+}
+#endif
+
 /*!
   Write the content of the image bitmap in the file which name is given by \e
   filename. This function writes a PNG file.
 
+  The rows of the image are given to libpng without intermediate copy.
+
   \param I : Image to save as a PNG file.
   \param filename : Name of the file containing the image.
+  \param compression : Compression preset.
 */
-void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &filename)
+void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &filename,
+                         const vpPNGCompression compression)
 {
   FILE *file;
 
@@ -1428,30 +1833,18 @@ void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &fil
 
   png_set_IHDR(png_ptr, info_ptr, width, height, bit_depth, color_type, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE,
                PNG_FILTER_TYPE_BASE);
+  vp_setPNGCompression(png_ptr, compression);
 
   png_write_info(png_ptr, info_ptr);
 
   png_bytep *row_ptrs = new png_bytep[height];
   for (unsigned int i = 0; i < height; i++)
-    row_ptrs[i] = new png_byte[width];
-
-  unsigned char *input = (unsigned char *)I.bitmap;
-
-  for (unsigned int i = 0; i < height; i++) {
-    png_byte *row = row_ptrs[i];
-    for (unsigned int j = 0; j < width; j++) {
-      row[j] = *(input);
-      input++;
-    }
-  }
+    row_ptrs[i] = (png_bytep)(I.bitmap + i * width);
 
   png_write_image(png_ptr, row_ptrs);
 
   png_write_end(png_ptr, NULL);
 
-  for (unsigned int j = 0; j < height; j++)
-    delete[] row_ptrs[j];
-
   delete[] row_ptrs;
 
   png_destroy_write_struct(&png_ptr, &info_ptr);
@@ -1463,10 +1856,14 @@ void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &fil
   Write the content of the image bitmap in the file which name is given by \e
   filename. This function writes a PNG file.
 
+  The rows of the image are given to libpng without intermediate copy.
+
   \param I : Image to save as a PNG file.
   \param filename : Name of the file containing the image.
+  \param compression : Compression preset.
 */
-void vpImageIo::writePNG(const vpImage<vpRGBa> &I, const std::string &filename)
+void vpImageIo::writePNG(const vpImage<vpRGBa> &I, const std::string &filename,
+                         const vpPNGCompression compression)
 {
   FILE *file;
 
@@ -1525,36 +1922,21 @@ void vpImageIo::writePNG(const vpImage<vpRGBa> &I, const std::string &filename)
 
   png_set_IHDR(png_ptr, info_ptr, width, height, bit_depth, color_type, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE,
                PNG_FILTER_TYPE_BASE);
+  vp_setPNGCompression(png_ptr, compression);
 
   png_write_info(png_ptr, info_ptr);
 
+  // The alpha channel of the vpRGBa pixels is skipped by libpng
+  png_set_filler(png_ptr, 0, PNG_FILLER_AFTER);
+
   png_bytep *row_ptrs = new png_bytep[height];
   for (unsigned int i = 0; i < height; i++)
-    row_ptrs[i] = new png_byte[3 * width];
-
-  unsigned char *input = (unsigned char *)I.bitmap;
-  ;
-
-  for (unsigned int i = 0; i < height; i++) {
-    png_byte *row = row_ptrs[i];
-    for (unsigned int j = 0; j < width; j++) {
-      row[3 * j] = *(input);
-      input++;
-      row[3 * j + 1] = *(input);
-      input++;
-      row[3 * j + 2] = *(input);
-      input++;
-      input++;
-    }
-  }
+    row_ptrs[i] = (png_bytep)(I.bitmap + i * width);
 
   png_write_image(png_ptr, row_ptrs);
 
   png_write_end(png_ptr, NULL);
 
-  for (unsigned int j = 0; j < height; j++)
-    delete[] row_ptrs[j];
-
   delete[] row_ptrs;
 
   png_destroy_write_struct(&png_ptr, &info_ptr);
@@ -1681,57 +2063,44 @@ void vpImageIo::readPNG(vpImage<unsigned char> &I, const std::string &filename)
 
   png_bytep *rowPtrs = new png_bytep[height];
 
-  unsigned int stride = png_get_rowbytes(png_ptr, info_ptr);
-  unsigned char *data = new unsigned char[stride * height];
+  if (channels == 1) {
+    // Decode directly in the image
+    for (unsigned int i = 0; i < height; i++)
+      rowPtrs[i] = (png_bytep)I[i];
 
-  for (unsigned int i = 0; i < height; i++)
-    rowPtrs[i] = (png_bytep)data + (i * stride);
+    png_read_image(png_ptr, rowPtrs);
+  } else {
+    unsigned int stride = png_get_rowbytes(png_ptr, info_ptr);
+    unsigned char *data = new unsigned char[stride * height];
 
-  png_read_image(png_ptr, rowPtrs);
+    for (unsigned int i = 0; i < height; i++)
+      rowPtrs[i] = (png_bytep)data + (i * stride);
 
-  vpImage<vpRGBa> Ic(height, width);
-  unsigned char *output;
+    png_read_image(png_ptr, rowPtrs);
 
-  switch (channels) {
-  case 1:
-    output = (unsigned char *)I.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i];
-    }
-    break;
+    unsigned char *output;
 
-  case 2:
-    output = (unsigned char *)I.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i * 2];
-    }
-    break;
+    switch (channels) {
+    case 2:
+      output = (unsigned char *)I.bitmap;
+      for (unsigned int i = 0; i < width * height; i++) {
+        *(output++) = data[i * 2];
+      }
+      break;
 
-  case 3:
-    output = (unsigned char *)Ic.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i * 3];
-      *(output++) = data[i * 3 + 1];
-      *(output++) = data[i * 3 + 2];
-      *(output++) = vpRGBa::alpha_default;
-    }
-    vpImageConvert::convert(Ic, I);
-    break;
+    case 3:
+      vpImageConvert::RGBToGrey(data, I.bitmap, width * height);
+      break;
 
-  case 4:
-    output = (unsigned char *)Ic.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i * 4];
-      *(output++) = data[i * 4 + 1];
-      *(output++) = data[i * 4 + 2];
-      *(output++) = data[i * 4 + 3];
+    case 4:
+      vpImageConvert::RGBaToGrey(data, I.bitmap, width * height);
+      break;
     }
-    vpImageConvert::convert(Ic, I);
-    break;
+
+    delete[] data;
   }
 
   delete[](png_bytep) rowPtrs;
-  delete[] data;
   png_read_end(png_ptr, NULL);
   png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
   fclose(file);
@@ -1848,6 +2217,13 @@ void vpImageIo::readPNG(vpImage<vpRGBa> &I, const std::string &filename)
   else if (bit_depth < 8)
     png_set_packing(png_ptr);
 
+  /* expand gray level and RGB images to RGBA to decode directly in the
+   * vpRGBa pixels */
+  if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
+    png_set_gray_to_rgb(png_ptr);
+  if (color_type != PNG_COLOR_TYPE_RGB_ALPHA)
+    png_set_filler(png_ptr, vpRGBa::alpha_default, PNG_FILLER_AFTER);
+
   /* update info structure to apply transformations */
   png_read_update_info(png_ptr, info_ptr);
 
@@ -1856,59 +2232,20 @@ void vpImageIo::readPNG(vpImage<vpRGBa> &I, const std::string &filename)
   if ((width != I.getWidth()) || (height != I.getHeight()))
     I.resize(height, width);
 
-  png_bytep *rowPtrs = new png_bytep[height];
+  if (channels != 4) {
+    fclose(file);
+    png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
+    throw(vpImageException(vpImageException::ioError, "PNG read error"));
+  }
 
-  unsigned int stride = png_get_rowbytes(png_ptr, info_ptr);
-  unsigned char *data = new unsigned char[stride * height];
+  png_bytep *rowPtrs = new png_bytep[height];
 
   for (unsigned int i = 0; i < height; i++)
-    rowPtrs[i] = (png_bytep)data + (i * stride);
+    rowPtrs[i] = (png_bytep)I[i];
 
   png_read_image(png_ptr, rowPtrs);
 
-  vpImage<unsigned char> Ig(height, width);
-  unsigned char *output;
-
-  switch (channels) {
-  case 1:
-    output = (unsigned char *)Ig.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i];
-    }
-    vpImageConvert::convert(Ig, I);
-    break;
-
-  case 2:
-    output = (unsigned char *)Ig.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i * 2];
-    }
-    vpImageConvert::convert(Ig, I);
-    break;
-
-  case 3:
-    output = (unsigned char *)I.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i * 3];
-      *(output++) = data[i * 3 + 1];
-      *(output++) = data[i * 3 + 2];
-      *(output++) = vpRGBa::alpha_default;
-    }
-    break;
-
-  case 4:
-    output = (unsigned char *)I.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i * 4];
-      *(output++) = data[i * 4 + 1];
-      *(output++) = data[i * 4 + 2];
-      *(output++) = data[i * 4 + 3];
-    }
-    break;
-  }
-
   delete[](png_bytep) rowPtrs;
-  delete[] data;
   png_read_end(png_ptr, NULL);
   png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
   fclose(file);
@@ -1922,14 +2259,23 @@ void vpImageIo::readPNG(vpImage<vpRGBa> &I, const std::string &filename)
 
   \param I : Image to save as a PNG file.
   \param filename : Name of the file containing the image.
+  \param compression : Compression preset, mapped to the zlib level used by
+  OpenCV.
 */
-void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &filename)
+void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &filename,
+                         const vpPNGCompression compression)
 {
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   cv::Mat Ip;
   vpImageConvert::convert(I, Ip);
-  cv::imwrite(filename.c_str(), Ip);
+  std::vector<int> params;
+  if (compression != PNG_COMPRESSION_DEFAULT) {
+    params.push_back(cv::IMWRITE_PNG_COMPRESSION);
+    params.push_back(compression == PNG_COMPRESSION_BEST ? 9 : 1);
+  }
+  cv::imwrite(filename.c_str(), Ip, params);
 #else
+  (void)compression;
   IplImage *Ip = NULL;
   vpImageConvert::convert(I, Ip);
 
@@ -1945,14 +2291,23 @@ void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &fil
 
   \param I : Image to save as a PNG file.
   \param filename : Name of the file containing the image.
+  \param compression : Compression preset, mapped to the zlib level used by
+  OpenCV.
 */
-void vpImageIo::writePNG(const vpImage<vpRGBa> &I, const std::string &filename)
+void vpImageIo::writePNG(const vpImage<vpRGBa> &I, const std::string &filename,
+                         const vpPNGCompression compression)
 {
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   cv::Mat Ip;
   vpImageConvert::convert(I, Ip);
-  cv::imwrite(filename.c_str(), Ip);
+  std::vector<int> params;
+  if (compression != PNG_COMPRESSION_DEFAULT) {
+    params.push_back(cv::IMWRITE_PNG_COMPRESSION);
+    params.push_back(compression == PNG_COMPRESSION_BEST ? 9 : 1);
+  }
+  cv::imwrite(filename.c_str(), Ip, params);
 #else
+  (void)compression;
   IplImage *Ip = NULL;
   vpImageConvert::convert(I, Ip);
 
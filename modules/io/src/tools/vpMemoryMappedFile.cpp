@@ -0,0 +1,219 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Read-only memory mapping of a file.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpMemoryMappedFile.cpp
+  \brief Map a file in memory.
+*/
+
+#include <visp3/core/vpException.h>
+#include <visp3/io/vpMemoryMappedFile.h>
+
+#if defined(_WIN32)
+// Mute warning with winsock.h and winsock2.h
+#include <WinSock2.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*!
+  Default constructor. No file is mapped.
+*/
+vpMemoryMappedFile::vpMemoryMappedFile()
+  : m_filename(), m_data(NULL), m_size(0), m_isOpen(false)
+#if defined(_WIN32)
+    ,
+    m_file(NULL), m_mapping(NULL)
+#endif
+{
+}
+
+/*!
+  Map the file \e filename in memory.
+  \param filename : Name of the file to map.
+  \sa open()
+*/
+vpMemoryMappedFile::vpMemoryMappedFile(const std::string &filename)
+  : m_filename(), m_data(NULL), m_size(0), m_isOpen(false)
+#if defined(_WIN32)
+    ,
+    m_file(NULL), m_mapping(NULL)
+#endif
+{
+  open(filename);
+}
+
+/*!
+  Destructor that unmaps the file.
+*/
+vpMemoryMappedFile::~vpMemoryMappedFile() { close(); }
+
+/*!
+  Map the file \e filename in memory. If a file was already mapped it is
+  first unmapped. An empty file is opened with a NULL data pointer.
+
+  Only regular files can be mapped: pipes and devices like /dev/stdin have
+  to be read as a stream. See isMappable().
+
+  \param filename : Name of the file to map.
+
+  \exception vpException::ioError : If the file cannot be opened or mapped.
+*/
+void vpMemoryMappedFile::open(const std::string &filename)
+{
+  close();
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw(vpException(vpException::ioError, "Cannot open file \"%s\"", filename.c_str()));
+  }
+  if (GetFileType(file) != FILE_TYPE_DISK) {
+    CloseHandle(file);
+    throw(vpException(vpException::ioError, "Cannot map \"%s\" in memory: not a regular file", filename.c_str()));
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    throw(vpException(vpException::ioError, "Cannot get the size of file \"%s\"", filename.c_str()));
+  }
+  HANDLE mapping = NULL;
+  void *data = NULL;
+  if (size.QuadPart > 0) {
+    mapping = CreateFileMapping(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (mapping != NULL) {
+      data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    }
+    if (data == NULL) {
+      if (mapping != NULL) {
+        CloseHandle(mapping);
+      }
+      CloseHandle(file);
+      throw(vpException(vpException::ioError, "Cannot map file \"%s\" in memory", filename.c_str()));
+    }
+  }
+  m_file = file;
+  m_mapping = mapping;
+  m_size = (size_t)size.QuadPart;
+#else
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw(vpException(vpException::ioError, "Cannot open file \"%s\"", filename.c_str()));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw(vpException(vpException::ioError, "Cannot get the size of file \"%s\"", filename.c_str()));
+  }
+  if (!S_ISREG(st.st_mode)) {
+    ::close(fd);
+    throw(vpException(vpException::ioError, "Cannot map \"%s\" in memory: not a regular file", filename.c_str()));
+  }
+  void *data = NULL;
+  if (st.st_size > 0) {
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      ::close(fd);
+      throw(vpException(vpException::ioError, "Cannot map file \"%s\" in memory", filename.c_str()));
+    }
+  }
+  // The mapping remains valid once the descriptor is closed
+  ::close(fd);
+  m_size = (size_t)st.st_size;
+#endif
+
+  m_data = static_cast<unsigned char *>(data);
+  m_filename = filename;
+  m_isOpen = true;
+}
+
+/*!
+  Check if \e filename is a regular file that can be mapped in memory by
+  open(). Pipes, devices and missing files cannot.
+
+  \param filename : Name of the file to check.
+  \return true if the file can be mapped.
+*/
+bool vpMemoryMappedFile::isMappable(const std::string &filename)
+{
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  bool mappable = (GetFileType(file) == FILE_TYPE_DISK);
+  CloseHandle(file);
+  return mappable;
+#else
+  struct stat st;
+  return (stat(filename.c_str(), &st) == 0 && S_ISREG(st.st_mode));
+#endif
+}
+
+/*!
+  Unmap the file. Images that were built on top of the mapped memory must not
+  be accessed anymore.
+*/
+void vpMemoryMappedFile::close()
+{
+  if (!m_isOpen) {
+    return;
+  }
+#if defined(_WIN32)
+  if (m_data != NULL) {
+    UnmapViewOfFile(m_data);
+  }
+  if (m_mapping != NULL) {
+    CloseHandle((HANDLE)m_mapping);
+  }
+  CloseHandle((HANDLE)m_file);
+  m_file = NULL;
+  m_mapping = NULL;
+#else
+  if (m_data != NULL) {
+    munmap(m_data, m_size);
+  }
+#endif
+  m_data = NULL;
+  m_size = 0;
+  m_filename.clear();
+  m_isOpen = false;
+}
@@ -36,14 +36,261 @@
  *
  *****************************************************************************/
 
+
 #include <visp3/io/vpDiskGrabber.h>
 
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+#include <vector>
+
+#include <visp3/core/vpCondition.h>
+#include <visp3/core/vpThread.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*
+  Ring of images decoded in advance by background threads.
+
+  Each slot of the ring is assigned an image number by the caller thread.
+  The decoding threads pick the pending slots in the order they were
+  assigned, decode the image in the slot buffer and mark it as ready. The
+  caller waits for the slot holding the requested number, so the images are
+  returned in order whatever the number of decoding threads. The buffers of
+  the slots are exchanged with the caller images and reused from one image
+  to the next.
+*/
+class vpDiskGrabber::Impl
+{
+public:
+  Impl(unsigned int nb_threads, unsigned int buffer_size)
+    : m_mutex(), m_pending(), m_decoded(), m_threads(nb_threads, NULL), m_slots(buffer_size), m_stop(false), m_type(TYPE_UCHAR), m_step(0),
+      m_next(0), m_order(0), m_started(false)
+  {
+    for (size_t i = 0; i < m_threads.size(); i++)
+      m_threads[i] = new vpThread((vpThread::Fn)decodingFunction, (vpThread::Args)this);
+  }
+
+  ~Impl()
+  {
+    m_mutex.lock();
+    m_stop = true;
+    m_pending.notifyAll();
+    m_mutex.unlock();
+    for (size_t i = 0; i < m_threads.size(); i++)
+      delete m_threads[i]; // join
+  }
+
+  template <class Type> void acquire(vpImage<Type> &I, long number, long step, const vpDiskGrabber &grabber)
+  {
+    vpMutex::vpScopedLock lock(m_mutex);
+    vpImageType type = imageType(I);
+
+    Slot *slot = NULL;
+    if (m_started && type == m_type && step == m_step)
+      slot = find(number);
+    if (slot == NULL) {
+      restart(number, step, type, grabber);
+      slot = find(number);
+    }
+
+    while (slot->state != SLOT_READY && slot->state != SLOT_FAILED)
+      m_decoded.wait(m_mutex);
+
+    if (slot->state == SLOT_FAILED) {
+      bool imageError = slot->imageError;
+      int code = slot->errorCode;
+      std::string message = slot->errorMessage;
+      schedule(*slot, grabber);
+      if (imageError)
+        throw(vpImageException(code, message));
+      throw(vpException(code, message));
+    }
+
+    // Exchange the buffers but keep the display attached to the caller image
+    vpImage<Type> &Islot = slotImage(*slot, I);
+    vpDisplay *display = I.display;
+    swap(I, Islot);
+    Islot.display = I.display;
+    I.display = display;
+
+    schedule(*slot, grabber);
+  }
+
+private:
+  typedef enum { SLOT_EMPTY, SLOT_PENDING, SLOT_DECODING, SLOT_READY, SLOT_FAILED } vpSlotState;
+  typedef enum { TYPE_UCHAR, TYPE_RGBA, TYPE_FLOAT } vpImageType;
+
+  struct Slot {
+    Slot()
+      : number(0), state(SLOT_EMPTY), order(0), filename(), Iuchar(), Irgba(), Ifloat(), imageError(false),
+        errorCode(0), errorMessage()
+    {
+    }
+
+    long number;
+    vpSlotState state;
+    unsigned long order;
+    std::string filename;
+    vpImage<unsigned char> Iuchar;
+    vpImage<vpRGBa> Irgba;
+    vpImage<float> Ifloat;
+    bool imageError;
+    int errorCode;
+    std::string errorMessage;
+  };
+
+  static vpImageType imageType(const vpImage<unsigned char> &) { return TYPE_UCHAR; }
+  static vpImageType imageType(const vpImage<vpRGBa> &) { return TYPE_RGBA; }
+  static vpImageType imageType(const vpImage<float> &) { return TYPE_FLOAT; }
+  static vpImage<unsigned char> &slotImage(Slot &slot, const vpImage<unsigned char> &) { return slot.Iuchar; }
+  static vpImage<vpRGBa> &slotImage(Slot &slot, const vpImage<vpRGBa> &) { return slot.Irgba; }
+  static vpImage<float> &slotImage(Slot &slot, const vpImage<float> &) { return slot.Ifloat; }
+
+  static vpThread::Return decodingFunction(vpThread::Args args)
+  {
+    static_cast<Impl *>(args)->decode();
+    return 0;
+  }
+
+  // Must be called with the mutex locked
+  Slot *find(long number)
+  {
+    for (size_t i = 0; i < m_slots.size(); i++) {
+      if (m_slots[i].number == number && m_slots[i].state != SLOT_EMPTY)
+        return &m_slots[i];
+    }
+    return NULL;
+  }
+
+  // Assign the next image number to a slot. Must be called with the mutex
+  // locked.
+  void schedule(Slot &slot, const vpDiskGrabber &grabber)
+  {
+    if (m_next < 0) {
+      slot.state = SLOT_EMPTY;
+      return;
+    }
+    slot.number = m_next;
+    slot.filename = grabber.getImageName(m_next);
+    slot.order = m_order++;
+    slot.state = SLOT_PENDING;
+    m_next += m_step;
+    m_pending.notifyOne();
+  }
+
+  // Drop the prefetched images and restart from number. Must be called with
+  // the mutex locked.
+  void restart(long number, long step, vpImageType type, const vpDiskGrabber &grabber)
+  {
+    // Cancel the pending images and wait for the ones being decoded
+    for (size_t i = 0; i < m_slots.size(); i++) {
+      if (m_slots[i].state == SLOT_PENDING)
+        m_slots[i].state = SLOT_EMPTY;
+    }
+    for (;;) {
+      bool decoding = false;
+      for (size_t i = 0; i < m_slots.size(); i++) {
+        if (m_slots[i].state == SLOT_DECODING)
+          decoding = true;
+      }
+      if (!decoding)
+        break;
+      m_decoded.wait(m_mutex);
+    }
+
+    m_type = type;
+    m_step = step;
+    m_next = number;
+    m_started = true;
+    for (size_t i = 0; i < m_slots.size(); i++)
+      schedule(m_slots[i], grabber);
+  }
+
+  void decode();
+
+  vpMutex m_mutex;
+  vpCondition m_pending; //!< notified when a slot is pending or on stop
+  vpCondition m_decoded; //!< notified when a slot is decoded
+  std::vector<vpThread *> m_threads;
+  std::vector<Slot> m_slots;
+  bool m_stop;
+  vpImageType m_type;
+  long m_step;
+  long m_next;
+  unsigned long m_order;
+  bool m_started;
+};
+
+/*
+  Loop of the decoding threads.
+*/
+void vpDiskGrabber::Impl::decode()
+{
+  for (;;) {
+    m_mutex.lock();
+    Slot *slot = NULL;
+    while (!m_stop) {
+      for (size_t i = 0; i < m_slots.size(); i++) {
+        if (m_slots[i].state == SLOT_PENDING && (slot == NULL || m_slots[i].order < slot->order))
+          slot = &m_slots[i];
+      }
+      if (slot != NULL)
+        break;
+      m_pending.wait(m_mutex);
+    }
+    if (m_stop) {
+      m_mutex.unlock();
+      break;
+    }
+    slot->state = SLOT_DECODING;
+    std::string filename = slot->filename;
+    vpImageType type = m_type;
+    m_mutex.unlock();
+
+    // The slot cannot be reassigned while it is decoded
+    vpSlotState state = SLOT_READY;
+    bool imageError = false;
+    int errorCode = 0;
+    std::string errorMessage;
+    try {
+      if (type == TYPE_UCHAR)
+        vpImageIo::read(slot->Iuchar, filename);
+      else if (type == TYPE_RGBA)
+        vpImageIo::read(slot->Irgba, filename);
+      else
+        vpImageIo::readPFM(slot->Ifloat, filename);
+    } catch (vpImageException &e) {
+      state = SLOT_FAILED;
+      imageError = true;
+      errorCode = e.getCode();
+      errorMessage = e.getStringMessage();
+    } catch (vpException &e) {
+      state = SLOT_FAILED;
+      errorCode = e.getCode();
+      errorMessage = e.getStringMessage();
+    } catch (...) {
+      state = SLOT_FAILED;
+      errorCode = vpException::ioError;
+      errorMessage = "Cannot read image " + filename;
+    }
+
+    m_mutex.lock();
+    slot->state = state;
+    slot->imageError = imageError;
+    slot->errorCode = errorCode;
+    slot->errorMessage = errorMessage;
+    m_decoded.notifyAll();
+    m_mutex.unlock();
+  }
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+#endif
+
 /*!
   Elementary constructor.
 */
 vpDiskGrabber::vpDiskGrabber()
   : m_image_number(0), m_image_number_next(0), m_image_step(1), m_number_of_zero(0), m_directory("/tmp"),
-    m_base_name("I"), m_extension("pgm"), m_use_generic_name(false), m_generic_name("empty")
+    m_base_name("I"), m_extension("pgm"), m_use_generic_name(false), m_generic_name("empty"), m_prefetch_threads(0),
+    m_prefetch_size(0), m_impl(NULL)
 {
   init = false;
 }
@@ -53,7 +300,8 @@ vpDiskGrabber::vpDiskGrabber()
 */
 vpDiskGrabber::vpDiskGrabber(const std::string &generic_name)
   : m_image_number(0), m_image_number_next(0), m_image_step(1), m_number_of_zero(0), m_directory("/tmp"),
-    m_base_name("I"), m_extension("pgm"), m_use_generic_name(true), m_generic_name(generic_name)
+    m_base_name("I"), m_extension("pgm"), m_use_generic_name(true), m_generic_name(generic_name),
+    m_prefetch_threads(0), m_prefetch_size(0), m_impl(NULL)
 {
   init = false;
 }
@@ -72,7 +320,8 @@ vpDiskGrabber::vpDiskGrabber(const std::string &generic_name)
 vpDiskGrabber::vpDiskGrabber(const std::string &dir, const std::string &basename, long number, int step,
                              unsigned int noz, const std::string &ext)
   : m_image_number(number), m_image_number_next(number), m_image_step(step), m_number_of_zero(noz), m_directory(dir),
-    m_base_name(basename), m_extension(ext), m_use_generic_name(false), m_generic_name("empty")
+    m_base_name(basename), m_extension(ext), m_use_generic_name(false), m_generic_name("empty"),
+    m_prefetch_threads(0), m_prefetch_size(0), m_impl(NULL)
 {
   init = false;
 }
@@ -144,19 +393,14 @@ void vpDiskGrabber::open(vpImage<float> &I)
 void vpDiskGrabber::acquire(vpImage<unsigned char> &I)
 {
   m_image_number = m_image_number_next;
-  std::stringstream ss;
-
-  if (m_use_generic_name) {
-    char filename[FILENAME_MAX];
-    sprintf(filename, m_generic_name.c_str(), m_image_number);
-    ss << filename;
-  } else {
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << m_image_number << "."
-       << m_extension;
-  }
-
   m_image_number_next += m_image_step;
-  vpImageIo::read(I, ss.str());
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  if (m_impl != NULL)
+    m_impl->acquire(I, m_image_number, m_image_step, *this);
+  else
+#endif
+    vpImageIo::read(I, getImageName(m_image_number));
 
   width = I.getWidth();
   height = I.getHeight();
@@ -171,20 +415,14 @@ void vpDiskGrabber::acquire(vpImage<unsigned char> &I)
 void vpDiskGrabber::acquire(vpImage<vpRGBa> &I)
 {
   m_image_number = m_image_number_next;
-  std::stringstream ss;
-
-  if (m_use_generic_name) {
-    char filename[FILENAME_MAX];
-    sprintf(filename, m_generic_name.c_str(), m_image_number);
-    ss << filename;
-  } else {
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << m_image_number << "."
-       << m_extension;
-  }
-
   m_image_number_next += m_image_step;
 
-  vpImageIo::read(I, ss.str());
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  if (m_impl != NULL)
+    m_impl->acquire(I, m_image_number, m_image_step, *this);
+  else
+#endif
+    vpImageIo::read(I, getImageName(m_image_number));
 
   width = I.getWidth();
   height = I.getHeight();
@@ -199,19 +437,14 @@ void vpDiskGrabber::acquire(vpImage<vpRGBa> &I)
 void vpDiskGrabber::acquire(vpImage<float> &I)
 {
   m_image_number = m_image_number_next;
-  std::stringstream ss;
-  if (m_use_generic_name) {
-    char filename[FILENAME_MAX];
-    sprintf(filename, m_generic_name.c_str(), m_image_number);
-    ss << filename;
-  } else {
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << m_image_number << "."
-       << m_extension;
-  }
-
   m_image_number_next += m_image_step;
 
-  vpImageIo::readPFM(I, ss.str());
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  if (m_impl != NULL)
+    m_impl->acquire(I, m_image_number, m_image_step, *this);
+  else
+#endif
+    vpImageIo::readPFM(I, getImageName(m_image_number));
 
   width = I.getWidth();
   height = I.getHeight();
@@ -227,19 +460,14 @@ void vpDiskGrabber::acquire(vpImage<float> &I)
 void vpDiskGrabber::acquire(vpImage<unsigned char> &I, long img_number)
 {
   m_image_number = m_image_number_next;
-  std::stringstream ss;
-  if (m_use_generic_name) {
-    char filename[FILENAME_MAX];
-    sprintf(filename, m_generic_name.c_str(), m_image_number);
-    ss << filename;
-  } else {
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << img_number << "."
-       << m_extension;
-  }
-
   m_image_number_next += m_image_step;
 
-  vpImageIo::read(I, ss.str());
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  if (m_impl != NULL)
+    m_impl->acquire(I, img_number, m_image_step, *this);
+  else
+#endif
+    vpImageIo::read(I, getImageName(img_number));
 
   width = I.getWidth();
   height = I.getHeight();
@@ -255,19 +483,14 @@ void vpDiskGrabber::acquire(vpImage<unsigned char> &I, long img_number)
 void vpDiskGrabber::acquire(vpImage<vpRGBa> &I, long img_number)
 {
   m_image_number = m_image_number_next;
-  std::stringstream ss;
-  if (m_use_generic_name) {
-    char filename[FILENAME_MAX];
-    sprintf(filename, m_generic_name.c_str(), m_image_number);
-    ss << filename;
-  } else {
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << img_number << "."
-       << m_extension;
-  }
-
   m_image_number_next += m_image_step;
 
-  vpImageIo::read(I, ss.str());
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  if (m_impl != NULL)
+    m_impl->acquire(I, img_number, m_image_step, *this);
+  else
+#endif
+    vpImageIo::read(I, getImageName(img_number));
 
   width = I.getWidth();
   height = I.getHeight();
@@ -283,22 +506,34 @@ void vpDiskGrabber::acquire(vpImage<vpRGBa> &I, long img_number)
 void vpDiskGrabber::acquire(vpImage<float> &I, long img_number)
 {
   m_image_number = m_image_number_next;
+  m_image_number_next += m_image_step;
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  if (m_impl != NULL)
+    m_impl->acquire(I, img_number, m_image_step, *this);
+  else
+#endif
+    vpImageIo::readPFM(I, getImageName(img_number));
+
+  width = I.getWidth();
+  height = I.getHeight();
+}
+
+/*
+  Build the name of the image file with number \e number.
+*/
+std::string vpDiskGrabber::getImageName(long number) const
+{
   std::stringstream ss;
   if (m_use_generic_name) {
     char filename[FILENAME_MAX];
-    sprintf(filename, m_generic_name.c_str(), m_image_number);
+    sprintf(filename, m_generic_name.c_str(), number);
     ss << filename;
   } else {
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << img_number << "."
+    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << number << "."
        << m_extension;
   }
-
-  m_image_number_next += m_image_step;
-
-  vpImageIo::readPFM(I, ss.str());
-
-  width = I.getWidth();
-  height = I.getHeight();
+  return ss.str();
 }
 
 /*!
@@ -312,11 +547,14 @@ void vpDiskGrabber::close()
 }
 
 /*!
-  Destructor
-
-  In fact nothing to destroy...
+  Destructor. Stops the decoding threads if any.
  */
-vpDiskGrabber::~vpDiskGrabber() {}
+vpDiskGrabber::~vpDiskGrabber()
+{
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  delete m_impl;
+#endif
+}
 
 /*!
   Set the main directory name (ie location of the image sequence)
@@ -356,3 +594,39 @@ void vpDiskGrabber::setGenericName(const std::string &generic_name)
   m_generic_name = generic_name;
   m_use_generic_name = true;
 }
+
+/*!
+  Enable or disable the decoding of the images in advance.
+
+  When enabled, \e nb_threads background threads read the \e buffer_size
+  images that follow the current one considering the step. acquire() then
+  only waits for the requested image if it is not decoded yet. The images
+  are returned in the same order as without prefetching. Changing the image
+  number with setImageNumber(), the step or the type of the acquired images
+  drops the images decoded in advance.
+
+  Prefetching requires pthread or Windows threads; otherwise this function
+  has no effect.
+
+  \param nb_threads : Number of decoding threads. 0 disables prefetching.
+  \param buffer_size : Number of images decoded in advance (at least 1).
+*/
+void vpDiskGrabber::setPrefetch(unsigned int nb_threads, unsigned int buffer_size)
+{
+  if (buffer_size == 0)
+    buffer_size = 1;
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  if (m_impl != NULL && nb_threads == m_prefetch_threads && buffer_size == m_prefetch_size)
+    return;
+
+  delete m_impl;
+  m_impl = NULL;
+  if (nb_threads > 0)
+    m_impl = new Impl(nb_threads, buffer_size);
+  m_prefetch_threads = nb_threads;
+  m_prefetch_size = nb_threads > 0 ? buffer_size : 0;
+#else
+  (void)nb_threads;
+  (void)buffer_size;
+#endif
+}
@@ -0,0 +1,333 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Raw multi-frame image container.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpRawFrameFile.cpp
+  \brief Raw multi-frame image container that can be memory mapped.
+*/
+
+#include <string.h>
+
+#include <visp3/core/vpException.h>
+#include <visp3/io/vpRawFrameFile.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Layout of the 64 bytes header
+const char vp_raw_magic[8] = {'V', 'I', 'S', 'P', 'R', 'A', 'W', '1'};
+const uint32_t vp_raw_byte_order = 0x01020304;
+const uint32_t vp_raw_version = 1;
+const size_t vp_raw_header_size = 64;
+const size_t vp_raw_offset_byte_order = 8;
+const size_t vp_raw_offset_version = 12;
+const size_t vp_raw_offset_type = 16;
+const size_t vp_raw_offset_width = 20;
+const size_t vp_raw_offset_height = 24;
+const size_t vp_raw_offset_header_size = 28;
+const size_t vp_raw_offset_nb_frames = 32;
+
+uint32_t vp_raw_get(const unsigned char *header, size_t offset)
+{
+  uint32_t value;
+  memcpy(&value, header + offset, sizeof(value));
+  return value;
+}
+
+void vp_raw_set(unsigned char *header, size_t offset, uint32_t value)
+{
+  memcpy(header + offset, &value, sizeof(value));
+}
+}
+#endif
+
+/*!
+  Default constructor.
+*/
+vpRawFrameFile::vpRawFrameFile()
+  : m_filename(), m_pixelType(PIXEL_UCHAR), m_width(0), m_height(0), m_nbFrames(0), m_file(), m_writer()
+{
+}
+
+/*!
+  Destructor that closes the file.
+*/
+vpRawFrameFile::~vpRawFrameFile() { close(); }
+
+/*!
+  Close the file. When writing, the header is updated with the number of
+  frames. When reading, the file is unmapped: the images initialized by
+  getFrame() must not be accessed anymore.
+*/
+void vpRawFrameFile::close()
+{
+  if (m_writer.is_open()) {
+    writeHeader();
+    m_writer.close();
+  }
+  m_file.close();
+  m_filename.clear();
+  m_width = 0;
+  m_height = 0;
+  m_nbFrames = 0;
+}
+
+/*!
+  Create a file to store frames. If the file exists it is overwritten.
+
+  \param filename : Name of the file.
+  \param type : Type of the pixels.
+  \param width, height : Size of the frames.
+
+  \exception vpException::ioError : If the file cannot be created.
+*/
+void vpRawFrameFile::create(const std::string &filename, const vpPixelType type, const unsigned int width,
+                            const unsigned int height)
+{
+  close();
+
+  m_writer.open(filename.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+  if (!m_writer.is_open()) {
+    throw(vpException(vpException::ioError, "Cannot create raw frame file \"%s\"", filename.c_str()));
+  }
+  m_filename = filename;
+  m_pixelType = type;
+  m_width = width;
+  m_height = height;
+  m_nbFrames = 0;
+  writeHeader();
+}
+
+/*!
+  Open a file previously written with create() and write(). The file is
+  memory mapped: the frames are then accessed with getFrame().
+
+  \param filename : Name of the file.
+
+  \exception vpException::ioError : If the file cannot be opened, is not a
+  raw frame file, or is truncated.
+*/
+void vpRawFrameFile::open(const std::string &filename)
+{
+  close();
+
+  m_file.open(filename);
+  const unsigned char *header = m_file.getData();
+  if (m_file.getSize() < vp_raw_header_size || memcmp(header, vp_raw_magic, sizeof(vp_raw_magic)) != 0) {
+    m_file.close();
+    throw(vpException(vpException::ioError, "\"%s\" is not a raw frame file", filename.c_str()));
+  }
+  if (vp_raw_get(header, vp_raw_offset_byte_order) != vp_raw_byte_order) {
+    m_file.close();
+    throw(vpException(vpException::ioError, "Raw frame file \"%s\" was written with another byte order",
+                      filename.c_str()));
+  }
+  uint32_t version = vp_raw_get(header, vp_raw_offset_version);
+  uint32_t type = vp_raw_get(header, vp_raw_offset_type);
+  uint32_t header_size = vp_raw_get(header, vp_raw_offset_header_size);
+  if (version != vp_raw_version || type > PIXEL_RGBA || header_size != vp_raw_header_size) {
+    m_file.close();
+    throw(vpException(vpException::ioError, "Unsupported raw frame file \"%s\"", filename.c_str()));
+  }
+
+  m_pixelType = (vpPixelType)type;
+  m_width = vp_raw_get(header, vp_raw_offset_width);
+  m_height = vp_raw_get(header, vp_raw_offset_height);
+  m_nbFrames = vp_raw_get(header, vp_raw_offset_nb_frames);
+
+  size_t frame_size = getFrameSize();
+  if (frame_size > 0 && (m_file.getSize() - vp_raw_header_size) / frame_size < m_nbFrames) {
+    m_file.close();
+    m_nbFrames = 0;
+    throw(vpException(vpException::ioError, "Raw frame file \"%s\" is truncated", filename.c_str()));
+  }
+  m_filename = filename;
+}
+
+/*!
+  Return the size in bytes of a pixel of type \e type.
+*/
+size_t vpRawFrameFile::getPixelSize(const vpPixelType type)
+{
+  switch (type) {
+  case PIXEL_UCHAR:
+    return sizeof(unsigned char);
+  case PIXEL_UINT16:
+    return sizeof(uint16_t);
+  case PIXEL_FLOAT:
+    return sizeof(float);
+  case PIXEL_RGBA:
+    return sizeof(vpRGBa);
+  }
+  return 0;
+}
+
+/*!
+  Initialize \e I to point to the pixels of the frame \e index of the file
+  opened with open(). No pixel is copied.
+
+  \exception vpException::badValue : If the file does not contain unsigned
+  char frames or if \e index is out of range.
+*/
+void vpRawFrameFile::getFrame(vpImage<unsigned char> &I, const unsigned int index)
+{
+  I.initView(getFrameData(PIXEL_UCHAR, index), m_height, m_width);
+}
+
+/*!
+  Initialize \e I to point to the pixels of the frame \e index of the file
+  opened with open(). No pixel is copied.
+
+  \exception vpException::badValue : If the file does not contain uint16_t
+  frames or if \e index is out of range.
+*/
+void vpRawFrameFile::getFrame(vpImage<uint16_t> &I, const unsigned int index)
+{
+  I.initView(reinterpret_cast<uint16_t *>(getFrameData(PIXEL_UINT16, index)), m_height, m_width);
+}
+
+/*!
+  Initialize \e I to point to the pixels of the frame \e index of the file
+  opened with open(). No pixel is copied.
+
+  \exception vpException::badValue : If the file does not contain float
+  frames or if \e index is out of range.
+*/
+void vpRawFrameFile::getFrame(vpImage<float> &I, const unsigned int index)
+{
+  I.initView(reinterpret_cast<float *>(getFrameData(PIXEL_FLOAT, index)), m_height, m_width);
+}
+
+/*!
+  Initialize \e I to point to the pixels of the frame \e index of the file
+  opened with open(). No pixel is copied.
+
+  \exception vpException::badValue : If the file does not contain vpRGBa
+  frames or if \e index is out of range.
+*/
+void vpRawFrameFile::getFrame(vpImage<vpRGBa> &I, const unsigned int index)
+{
+  I.initView(reinterpret_cast<vpRGBa *>(getFrameData(PIXEL_RGBA, index)), m_height, m_width);
+}
+
+/*!
+  Append the image \e I at the end of the file opened with create().
+*/
+void vpRawFrameFile::write(const vpImage<unsigned char> &I)
+{
+  writeFrame(I.bitmap, PIXEL_UCHAR, I.getWidth(), I.getHeight());
+}
+
+/*!
+  Append the image \e I at the end of the file opened with create().
+*/
+void vpRawFrameFile::write(const vpImage<uint16_t> &I)
+{
+  writeFrame(reinterpret_cast<const unsigned char *>(I.bitmap), PIXEL_UINT16, I.getWidth(), I.getHeight());
+}
+
+/*!
+  Append the image \e I at the end of the file opened with create().
+*/
+void vpRawFrameFile::write(const vpImage<float> &I)
+{
+  writeFrame(reinterpret_cast<const unsigned char *>(I.bitmap), PIXEL_FLOAT, I.getWidth(), I.getHeight());
+}
+
+/*!
+  Append the image \e I at the end of the file opened with create().
+*/
+void vpRawFrameFile::write(const vpImage<vpRGBa> &I)
+{
+  writeFrame(reinterpret_cast<const unsigned char *>(I.bitmap), PIXEL_RGBA, I.getWidth(), I.getHeight());
+}
+
+unsigned char *vpRawFrameFile::getFrameData(const vpPixelType type, const unsigned int index)
+{
+  if (!m_file.isOpen()) {
+    throw(vpException(vpException::notInitialized, "No raw frame file is opened for reading"));
+  }
+  if (type != m_pixelType) {
+    throw(vpException(vpException::badValue, "Raw frame file \"%s\" contains another pixel type",
+                      m_filename.c_str()));
+  }
+  if (index >= m_nbFrames) {
+    throw(vpException(vpException::badValue, "Frame %u is out of range in raw frame file \"%s\" (%u frames)",
+                      index, m_filename.c_str(), m_nbFrames));
+  }
+  return m_file.getData() + vp_raw_header_size + index * getFrameSize();
+}
+
+void vpRawFrameFile::writeFrame(const unsigned char *bitmap, const vpPixelType type, const unsigned int width,
+                                const unsigned int height)
+{
+  if (!m_writer.is_open()) {
+    throw(vpException(vpException::notInitialized, "No raw frame file is created for writing"));
+  }
+  if (type != m_pixelType || width != m_width || height != m_height) {
+    throw(vpException(vpException::badValue, "Image %ux%u does not match the frames of raw frame file \"%s\"",
+                      width, height, m_filename.c_str()));
+  }
+
+  m_writer.seekp(0, std::ios::end);
+  m_writer.write(reinterpret_cast<const char *>(bitmap), (std::streamsize)getFrameSize());
+  if (!m_writer) {
+    throw(vpException(vpException::ioError, "Cannot write in raw frame file \"%s\"", m_filename.c_str()));
+  }
+  m_nbFrames++;
+  // Keep the header consistent so that the file can be read while recording
+  writeHeader();
+}
+
+void vpRawFrameFile::writeHeader()
+{
+  unsigned char header[vp_raw_header_size];
+  memset(header, 0, vp_raw_header_size);
+  memcpy(header, vp_raw_magic, sizeof(vp_raw_magic));
+  vp_raw_set(header, vp_raw_offset_byte_order, vp_raw_byte_order);
+  vp_raw_set(header, vp_raw_offset_version, vp_raw_version);
+  vp_raw_set(header, vp_raw_offset_type, (uint32_t)m_pixelType);
+  vp_raw_set(header, vp_raw_offset_width, m_width);
+  vp_raw_set(header, vp_raw_offset_height, m_height);
+  vp_raw_set(header, vp_raw_offset_header_size, (uint32_t)vp_raw_header_size);
+  vp_raw_set(header, vp_raw_offset_nb_frames, m_nbFrames);
+
+  m_writer.seekp(0, std::ios::beg);
+  m_writer.write(reinterpret_cast<const char *>(header), vp_raw_header_size);
+  m_writer.flush();
+  if (!m_writer) {
+    throw(vpException(vpException::ioError, "Cannot write in raw frame file \"%s\"", m_filename.c_str()));
+  }
+}
@@ -60,7 +60,8 @@ vpVideoReader::vpVideoReader()
     capture(), frame(),
 #endif
     formatType(FORMAT_UNKNOWN), initFileName(false), isOpen(false), frameCount(0), firstFrame(0), lastFrame(0),
-    firstFrameIndexIsSet(false), lastFrameIndexIsSet(false), frameStep(1), frameRate(0.)
+    firstFrameIndexIsSet(false), lastFrameIndexIsSet(false), frameStep(1), frameRate(0.), prefetchThreads(0),
+    prefetchSize(8)
 {
 }
 
@@ -136,6 +137,28 @@ sequence.
 */
 void vpVideoReader::setFileName(const std::string &filename) { setFileName(filename.c_str()); }
 
+/*!
+  Enable or disable the decoding of the images of a sequence in advance by
+  background threads. This has no effect on video files.
+
+  The frames are returned in the same order as without prefetching,
+  including when the frame step is negative. Getting a specific frame with
+  getFrame() drops the images decoded in advance.
+
+  \param nb_threads : Number of decoding threads. 0 disables prefetching.
+  \param buffer_size : Number of images decoded in advance.
+
+  \sa vpDiskGrabber::setPrefetch()
+*/
+void vpVideoReader::setPrefetch(unsigned int nb_threads, unsigned int buffer_size)
+{
+  prefetchThreads = nb_threads;
+  prefetchSize = buffer_size;
+  if (imSequence != NULL) {
+    imSequence->setPrefetch(prefetchThreads, prefetchSize);
+  }
+}
+
 /*!
   Open video stream and get first and last frame indexes.
 */
@@ -149,6 +172,9 @@ void vpVideoReader::getProperties()
     imSequence = new vpDiskGrabber;
     imSequence->setGenericName(fileName);
     imSequence->setStep(frameStep);
+    if (prefetchThreads > 0) {
+      imSequence->setPrefetch(prefetchThreads, prefetchSize);
+    }
     if (firstFrameIndexIsSet) {
       imSequence->setImageNumber(firstFrame);
     }
@@ -418,7 +444,7 @@ bool vpVideoReader::getFrame(vpImage<vpRGBa> &I, long frame_index)
       imSequence->acquire(I, frame_index);
       width = I.getWidth();
       height = I.getHeight();
-      frameCount = imSequence->getImageNumber();
+      frameCount = frame_index;
       imSequence->setImageNumber(frameCount); // to not increment vpDiskGrabber next image
       if (frameCount + frameStep > lastFrame) {
         imSequence->setImageNumber(frameCount);
@@ -488,7 +514,7 @@ bool vpVideoReader::getFrame(vpImage<unsigned char> &I, long frame_index)
       imSequence->acquire(I, frame_index);
       width = I.getWidth();
       height = I.getHeight();
-      frameCount = imSequence->getImageNumber();
+      frameCount = frame_index;
       imSequence->setImageNumber(frameCount); // to not increment vpDiskGrabber next image
       if (frameCount + frameStep > lastFrame) {
         imSequence->setImageNumber(frameCount);
@@ -49,6 +49,235 @@
 #include <opencv2/imgproc/imgproc.hpp>
 #endif
 
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+#include <algorithm>
+#include <deque>
+#include <string.h>
+#include <vector>
+
+#include <visp3/core/vpCondition.h>
+#include <visp3/core/vpThread.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*
+  Bounded queue of frames written by background threads.
+
+  The caller thread copies each frame in a buffer taken from a pool of
+  recycled buffers, so that no memory is allocated once every buffer has been
+  used. The encoding threads pop the frames in the order they were queued.
+  The mutex only protects the exchange of buffer indexes: the copies and the
+  encoding are done outside of it. The encoding threads sleep until a frame
+  is queued, and the caller until a buffer is released.
+*/
+class vpVideoWriter::Impl
+{
+public:
+  Impl(vpVideoWriter &writer, unsigned int nb_threads, unsigned int queue_size, vpQueuePolicy policy)
+    : m_writer(writer), m_mutex(), m_queued(), m_released(), m_threads(nb_threads, NULL), m_slots(queue_size), m_free(), m_queue(),
+      m_policy(policy), m_encoding(0), m_dropped(0), m_maxDepth(0), m_stop(false), m_failed(false),
+      m_imageError(false), m_errorCode(0), m_errorMessage()
+  {
+    for (size_t i = 0; i < m_slots.size(); i++)
+      m_free.push_back(i);
+    for (size_t i = 0; i < m_threads.size(); i++)
+      m_threads[i] = new vpThread((vpThread::Fn)encodingFunction, (vpThread::Args)this);
+  }
+
+  // The threads write the queued frames before exiting
+  ~Impl()
+  {
+    m_mutex.lock();
+    m_stop = true;
+    m_queued.notifyAll();
+    m_mutex.unlock();
+    for (size_t i = 0; i < m_threads.size(); i++)
+      delete m_threads[i]; // join
+  }
+
+  unsigned int getDroppedFrames()
+  {
+    vpMutex::vpScopedLock lock(m_mutex);
+    return m_dropped;
+  }
+
+  unsigned int getMaxQueueDepth()
+  {
+    vpMutex::vpScopedLock lock(m_mutex);
+    return m_maxDepth;
+  }
+
+  unsigned int getQueueDepth()
+  {
+    vpMutex::vpScopedLock lock(m_mutex);
+    return (unsigned int)m_queue.size() + m_encoding;
+  }
+
+  template <class Type> void push(const vpImage<Type> &I, unsigned int frame_index)
+  {
+    size_t index;
+    {
+      vpMutex::vpScopedLock lock(m_mutex);
+      throwError();
+      while (m_free.empty()) {
+        if (m_policy == QUEUE_DROP_NEWEST) {
+          m_dropped++;
+          return;
+        }
+        if (m_policy == QUEUE_DROP_OLDEST && !m_queue.empty()) {
+          m_free.push_back(m_queue.front());
+          m_queue.pop_front();
+          m_dropped++;
+        } else {
+          m_released.wait(m_mutex);
+        }
+      }
+      index = m_free.back();
+      m_free.pop_back();
+    }
+
+    // The buffer is reused when the size of the frames does not change
+    Slot &slot = m_slots[index];
+    vpImage<Type> &Islot = slotImage(slot, I);
+    Islot.resize(I.getHeight(), I.getWidth());
+    std::copy(I.bitmap, I.bitmap + I.getSize(), Islot.bitmap);
+    slot.frameIndex = frame_index;
+
+    vpMutex::vpScopedLock lock(m_mutex);
+    m_queue.push_back(index);
+    m_queued.notifyOne();
+    unsigned int depth = (unsigned int)m_queue.size() + m_encoding;
+    if (depth > m_maxDepth)
+      m_maxDepth = depth;
+  }
+
+  // Rethrow the first error met by the encoding threads. The mutex has to be
+  // locked.
+  void throwError()
+  {
+    if (!m_failed)
+      return;
+    m_failed = false;
+    if (m_imageError)
+      throw(vpImageException(m_errorCode, m_errorMessage));
+    throw(vpException(m_errorCode, m_errorMessage));
+  }
+
+  void throwPendingError()
+  {
+    vpMutex::vpScopedLock lock(m_mutex);
+    throwError();
+  }
+
+  // Wait until all the queued frames are written
+  void wait()
+  {
+    vpMutex::vpScopedLock lock(m_mutex);
+    while (!m_queue.empty() || m_encoding > 0)
+      m_released.wait(m_mutex);
+  }
+
+private:
+  struct Slot {
+    Slot() : Iuchar(), Irgba(), rgba(false), frameIndex(0) {}
+
+    vpImage<unsigned char> Iuchar;
+    vpImage<vpRGBa> Irgba;
+    bool rgba;
+    unsigned int frameIndex;
+  };
+
+  static vpImage<unsigned char> &slotImage(Slot &slot, const vpImage<unsigned char> &)
+  {
+    slot.rgba = false;
+    return slot.Iuchar;
+  }
+
+  static vpImage<vpRGBa> &slotImage(Slot &slot, const vpImage<vpRGBa> &)
+  {
+    slot.rgba = true;
+    return slot.Irgba;
+  }
+
+  static vpThread::Return encodingFunction(vpThread::Args args)
+  {
+    static_cast<Impl *>(args)->encode();
+    return 0;
+  }
+
+  void encode()
+  {
+    m_mutex.lock();
+    for (;;) {
+      if (m_queue.empty()) {
+        if (m_stop)
+          break;
+        m_queued.wait(m_mutex);
+        continue;
+      }
+      size_t index = m_queue.front();
+      m_queue.pop_front();
+      m_encoding++;
+      m_mutex.unlock();
+
+      // The slot cannot be reused while it is encoded
+      Slot &slot = m_slots[index];
+      bool failed = false, imageError = false;
+      int errorCode = 0;
+      std::string errorMessage;
+      try {
+        if (slot.rgba)
+          m_writer.writeFrame(slot.Irgba, slot.frameIndex);
+        else
+          m_writer.writeFrame(slot.Iuchar, slot.frameIndex);
+      } catch (vpImageException &e) {
+        failed = imageError = true;
+        errorCode = e.getCode();
+        errorMessage = e.getStringMessage();
+      } catch (vpException &e) {
+        failed = true;
+        errorCode = e.getCode();
+        errorMessage = e.getStringMessage();
+      } catch (...) {
+        failed = true;
+        errorCode = vpException::ioError;
+        errorMessage = "Cannot write frame";
+      }
+
+      m_mutex.lock();
+      if (failed && !m_failed) {
+        m_failed = true;
+        m_imageError = imageError;
+        m_errorCode = errorCode;
+        m_errorMessage = errorMessage;
+      }
+      m_encoding--;
+      m_free.push_back(index);
+      m_released.notifyAll();
+    }
+    m_mutex.unlock();
+  }
+
+  vpVideoWriter &m_writer;
+  vpMutex m_mutex;
+  vpCondition m_queued;   //!< notified when a frame is queued or on stop
+  vpCondition m_released; //!< notified when a frame is written
+  std::vector<vpThread *> m_threads;
+  std::vector<Slot> m_slots;
+  std::vector<size_t> m_free;
+  std::deque<size_t> m_queue;
+  vpQueuePolicy m_policy;
+  unsigned int m_encoding;
+  unsigned int m_dropped;
+  unsigned int m_maxDepth;
+  bool m_stop;
+  bool m_failed;
+  bool m_imageError;
+  int m_errorCode;
+  std::string m_errorMessage;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+#endif
+
 /*!
   Basic constructor.
 */
@@ -57,7 +286,9 @@ vpVideoWriter::vpVideoWriter()
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
     writer(), fourcc(0), framerate(0.),
 #endif
-    formatType(FORMAT_UNKNOWN), initFileName(false), isOpen(false), frameCount(0), firstFrame(0), width(0), height(0)
+    formatType(FORMAT_UNKNOWN), initFileName(false), isOpen(false), frameCount(0), firstFrame(0), width(0), height(0),
+    asyncThreads(0), queueSize(8), queuePolicy(QUEUE_BLOCK), jpegQuality(75),
+    pngCompression(vpImageIo::PNG_COMPRESSION_DEFAULT), droppedFrames(0), maxQueueDepth(0), impl(NULL)
 {
   initFileName = false;
   firstFrame = 0;
@@ -74,9 +305,15 @@ vpVideoWriter::vpVideoWriter()
 }
 
 /*!
-  Basic destructor.
+  Basic destructor. In asynchronous mode, waits until the queued frames are
+  written.
 */
-vpVideoWriter::~vpVideoWriter() {}
+vpVideoWriter::~vpVideoWriter()
+{
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  delete impl;
+#endif
+}
 
 /*!
   It enables to set the path and the name of the files which will be saved.
@@ -136,7 +373,7 @@ void vpVideoWriter::open(vpImage<vpRGBa> &I)
     throw(vpImageException(vpImageException::noFileNameError, "filename empty"));
   }
 
-  if (formatType == FORMAT_PGM || formatType == FORMAT_PPM || formatType == FORMAT_JPEG || formatType == FORMAT_PNG) {
+  if (isImageSequence()) {
     width = I.getWidth();
     height = I.getHeight();
   } else if (formatType == FORMAT_AVI || formatType == FORMAT_MPEG || formatType == FORMAT_MPEG4 ||
@@ -156,6 +393,8 @@ void vpVideoWriter::open(vpImage<vpRGBa> &I)
 
   frameCount = firstFrame;
 
+  startAsync();
+
   isOpen = true;
 }
 
@@ -171,7 +410,7 @@ void vpVideoWriter::open(vpImage<unsigned char> &I)
     throw(vpImageException(vpImageException::noFileNameError, "filename empty"));
   }
 
-  if (formatType == FORMAT_PGM || formatType == FORMAT_PPM || formatType == FORMAT_JPEG || formatType == FORMAT_PNG) {
+  if (isImageSequence()) {
     width = I.getWidth();
     height = I.getHeight();
   } else if (formatType == FORMAT_AVI || formatType == FORMAT_MPEG || formatType == FORMAT_MPEG4 ||
@@ -191,6 +430,8 @@ void vpVideoWriter::open(vpImage<unsigned char> &I)
 
   frameCount = firstFrame;
 
+  startAsync();
+
   isOpen = true;
 }
 
@@ -201,6 +442,12 @@ void vpVideoWriter::open(vpImage<unsigned char> &I)
   Each time this method is used, the frame counter is incremented and thus the
   file name change for the case of an image sequence.
 
+  In asynchronous mode (see setAsync()) the image is copied in the queue and
+  written later by an encoding thread. A frame dropped because the queue is
+  full still increments the frame counter, so that the index of each written
+  image matches the call to saveFrame(). An error met while writing a
+  previous frame is thrown by the next call.
+
   \param I : The image which has to be saved
 */
 void vpVideoWriter::saveFrame(vpImage<vpRGBa> &I)
@@ -210,19 +457,15 @@ void vpVideoWriter::saveFrame(vpImage<vpRGBa> &I)
     throw(vpException(vpException::notInitialized, "file not yet opened"));
   }
 
-  if (formatType == FORMAT_PGM || formatType == FORMAT_PPM || formatType == FORMAT_JPEG || formatType == FORMAT_PNG) {
-    char name[FILENAME_MAX];
-
-    sprintf(name, fileName, frameCount);
-
-    vpImageIo::write(I, name);
-  } else {
-#if VISP_HAVE_OPENCV_VERSION >= 0x020100
-    cv::Mat matFrame;
-    vpImageConvert::convert(I, matFrame);
-    writer << matFrame;
-#endif
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  if (impl != NULL) {
+    impl->push(I, frameCount);
+    frameCount++;
+    return;
   }
+#endif
+
+  writeFrame(I, frameCount);
 
   frameCount++;
 }
@@ -234,6 +477,12 @@ void vpVideoWriter::saveFrame(vpImage<vpRGBa> &I)
   Each time this method is used, the frame counter is incremented and thus the
   file name change for the case of an image sequence.
 
+  In asynchronous mode (see setAsync()) the image is copied in the queue and
+  written later by an encoding thread. A frame dropped because the queue is
+  full still increments the frame counter, so that the index of each written
+  image matches the call to saveFrame(). An error met while writing a
+  previous frame is thrown by the next call.
+
   \param I : The image which has to be saved
 */
 void vpVideoWriter::saveFrame(vpImage<unsigned char> &I)
@@ -243,12 +492,181 @@ void vpVideoWriter::saveFrame(vpImage<unsigned char> &I)
     throw(vpException(vpException::notInitialized, "file not yet opened"));
   }
 
-  if (formatType == FORMAT_PGM || formatType == FORMAT_PPM || formatType == FORMAT_JPEG || formatType == FORMAT_PNG) {
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  if (impl != NULL) {
+    impl->push(I, frameCount);
+    frameCount++;
+    return;
+  }
+#endif
+
+  writeFrame(I, frameCount);
+
+  frameCount++;
+}
+
+/*!
+  Deallocates parameters use to write the video or the image sequence.
+
+  In asynchronous mode, waits until all the queued frames are written and
+  stops the encoding threads. An error met while writing a frame is thrown
+  here if it was not already thrown by saveFrame().
+*/
+void vpVideoWriter::close()
+{
+  if (!isOpen) {
+    vpERROR_TRACE("The video has to be open first with the open method");
+    throw(vpException(vpException::notInitialized, "file not yet opened"));
+  }
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  if (impl != NULL) {
+    impl->wait();
+    droppedFrames = impl->getDroppedFrames();
+    maxQueueDepth = impl->getMaxQueueDepth();
+    Impl *async = impl;
+    impl = NULL;
+    try {
+      async->throwPendingError();
+    } catch (...) {
+      delete async;
+      throw;
+    }
+    delete async;
+  }
+#endif
+}
+
+/*!
+  Return the number of frames dropped by saveFrame() because the queue was
+  full. After close(), return the number of frames dropped during the
+  recording.
+
+  \sa setAsync()
+*/
+unsigned int vpVideoWriter::getDroppedFrames() const
+{
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  if (impl != NULL)
+    return impl->getDroppedFrames();
+#endif
+  return droppedFrames;
+}
+
+/*!
+  Return the largest number of frames that were waiting or being written at
+  the same time. A value close to the queue size means that the encoding
+  threads do not keep up with the frame rate.
+
+  \sa setAsync()
+*/
+unsigned int vpVideoWriter::getMaxQueueDepth() const
+{
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  if (impl != NULL)
+    return impl->getMaxQueueDepth();
+#endif
+  return maxQueueDepth;
+}
+
+/*!
+  Return the number of frames that are waiting or being written.
+
+  \sa setAsync()
+*/
+unsigned int vpVideoWriter::getQueueDepth() const
+{
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  if (impl != NULL)
+    return impl->getQueueDepth();
+#endif
+  return 0;
+}
+
+/*!
+  Write the frames in background threads. saveFrame() then only copies the
+  image in a bounded queue of recycled buffers.
+
+  This function has to be called before open(). A video file (AVI, MPEG...)
+  is always encoded by a single thread to keep the frame order, while the
+  images of a sequence are written by \e nb_threads threads.
+
+  \param nb_threads : Number of encoding threads. 0 to write the frames
+  synchronously in saveFrame(), which is the default.
+  \param queue_size : Number of frames that can wait to be written.
+  \param policy : Behavior of saveFrame() when the queue is full.
+
+  \note Without thread support (pthread or Windows threads) the frames are
+  always written synchronously.
+*/
+void vpVideoWriter::setAsync(const unsigned int nb_threads, const unsigned int queue_size,
+                             const vpQueuePolicy policy)
+{
+  asyncThreads = nb_threads;
+  queueSize = queue_size > 0 ? queue_size : 1;
+  queuePolicy = policy;
+}
+
+/*!
+  Set the compression used to write the images of a sequence.
+
+  \param jpeg_quality : Quality in [0, 100] of JPEG images. Default is 75.
+  \param png_compression : Compression preset of PNG images. Fast presets
+  reduce the encoding time at the price of larger files.
+*/
+void vpVideoWriter::setCompression(const int jpeg_quality, const vpImageIo::vpPNGCompression png_compression)
+{
+  jpegQuality = jpeg_quality;
+  pngCompression = png_compression;
+}
+
+// Indicate if the frames are written as separate image files
+bool vpVideoWriter::isImageSequence() const
+{
+  return (formatType == FORMAT_PGM || formatType == FORMAT_PPM || formatType == FORMAT_JPEG ||
+          formatType == FORMAT_PNG);
+}
+
+// Start the encoding threads if asynchronous writing is enabled
+void vpVideoWriter::startAsync()
+{
+  droppedFrames = 0;
+  maxQueueDepth = 0;
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  delete impl;
+  impl = NULL;
+  if (asyncThreads > 0)
+    impl = new Impl(*this, isImageSequence() ? asyncThreads : 1, queueSize, queuePolicy);
+#endif
+}
+
+// Write a frame. Called by saveFrame() or by the encoding threads.
+void vpVideoWriter::writeFrame(const vpImage<vpRGBa> &I, const unsigned int frame_index)
+{
+  if (isImageSequence()) {
+    char name[FILENAME_MAX];
+
+    sprintf(name, fileName, frame_index);
+
+    vpImageIo::write(I, name, jpegQuality, pngCompression);
+  } else {
+#if VISP_HAVE_OPENCV_VERSION >= 0x020100
+    cv::Mat matFrame;
+    vpImageConvert::convert(I, matFrame);
+    writer << matFrame;
+#endif
+  }
+}
+
+// Write a frame. Called by saveFrame() or by the encoding threads.
+void vpVideoWriter::writeFrame(const vpImage<unsigned char> &I, const unsigned int frame_index)
+{
+  if (isImageSequence()) {
     char name[FILENAME_MAX];
 
-    sprintf(name, fileName, frameCount);
+    sprintf(name, fileName, frame_index);
 
-    vpImageIo::write(I, name);
+    vpImageIo::write(I, name, jpegQuality, pngCompression);
   } else {
 #if VISP_HAVE_OPENCV_VERSION >= 0x030000
     cv::Mat matFrame, rgbMatFrame;
@@ -262,19 +680,6 @@ void vpVideoWriter::saveFrame(vpImage<unsigned char> &I)
     writer << rgbMatFrame;
 #endif
   }
-
-  frameCount++;
-}
-
-/*!
-  Deallocates parameters use to write the video or the image sequence.
-*/
-void vpVideoWriter::close()
-{
-  if (!isOpen) {
-    vpERROR_TRACE("The video has to be open first with the open method");
-    throw(vpException(vpException::notInitialized, "file not yet opened"));
-  }
 }
 
 /*!
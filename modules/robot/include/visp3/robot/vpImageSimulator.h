@@ -66,6 +66,14 @@
   be filled in. By default this functionality is not used because it consumes
   lot of time.
 
+  When the camera parameters have no distortion, the plane is rasterized row
+  by row using the homography between the image and the texture, the
+  bilinear interpolation is done in fixed point and the rows are rendered in
+  parallel if OpenMP is available. Several planes are rendered with depth
+  handling either by the static getImage() functions that take a list of
+  vpImageSimulator, or by sharing the same z-buffer between calls to the
+  getImage() functions that take a z-buffer.
+
   The  following example explain how to use the class.
 
   \code
@@ -302,6 +310,10 @@ private:
 
   void getRoi(const unsigned int &Iwidth, const unsigned int &Iheight, const vpCameraParameters &cam,
               const std::vector<vpPoint> &point, vpRect &rect);
+
+  template <class Type, class TextureType>
+  void render(vpImage<Type> &I, const vpImage<TextureType> &texture, const vpCameraParameters &cam,
+              vpMatrix *zBuffer);
 };
 
 #endif
@@ -84,6 +84,26 @@
   \warning This class uses threading capabilities. Thus on Unix-like
   platforms, the libpthread third-party library need to be
   installed. On Windows, we use the native threading capabilities.
+
+  By default the robot displacement is computed by a thread paced by the wall
+  clock. For batch simulations, setSynchronousMode() stops this thread and
+  lets the caller advance the simulation with step(). The simulated robot
+  then moves by the exact time given to step(), which makes the simulation
+  deterministic and allows to run it faster than real time:
+  \code
+  vpSimulatorViper850 robot(false);
+  robot.setSynchronousMode(true);
+  robot.setRobotState(vpRobot::STATE_VELOCITY_CONTROL);
+  for (unsigned int iter = 0; iter < 1000; iter++) {
+    // compute v from the current pose
+    robot.setVelocity(vpRobot::CAMERA_FRAME, v);
+    robot.step(0.01);
+  }
+  \endcode
+
+  When ViSP is built with c++11 support, the joint positions, joint
+  velocities and frame poses are exchanged with the thread through sequence
+  locks, so that reading the robot state never blocks.
 */
 class VISP_EXPORT vpRobotWireFrameSimulator : protected vpWireFrameSimulator, public vpRobotSimulator
 {
@@ -176,6 +196,22 @@ protected:
 
   bool verbose_;
 
+  /*! True when the robot displacement is computed by step() instead of the
+   * thread. */
+  bool synchronousMode;
+  /*! True while the thread computing the robot displacement is running. */
+  bool threadRunning;
+  /*! Simulated time in second accumulated by step(). */
+  double simulationTime;
+
+#if defined(VISP_HAVE_CPP11_COMPATIBILITY)
+  class vpSeqLock;
+  vpSeqLock *artCoordLock;
+  vpSeqLock *artVelLock;
+  vpSeqLock *velocityLock;
+  vpSeqLock *fMiLock;
+#endif
+
   // private:
   //#ifndef DOXYGEN_SHOULD_SKIP_THIS
   //    vpRobotWireFrameSimulator(const vpRobotWireFrameSimulator &)
@@ -247,6 +283,16 @@ public:
   void getInternalView(vpImage<unsigned char> &I);
 
   vpHomogeneousMatrix get_cMo();
+  /*!
+    Get the time in second the robot was moved by step() since the
+    synchronous mode was enabled.
+  */
+  double getSimulationTime() const { return simulationTime; }
+  /*!
+    Return true if the robot displacement is computed by step(); see
+    setSynchronousMode().
+  */
+  bool getSynchronousMode() const { return synchronousMode; }
   /*!
     Get the pose between the object and the fixed world frame.
 
@@ -348,6 +394,8 @@ public:
       this->delta_t_ = delta_t;
     }
   }
+  void setSynchronousMode(bool synchronous);
+
   /*! Set the parameter which enable or disable the singularity mangement */
   void setSingularityManagement(const bool sm) { singularityManagement = sm; }
 
@@ -362,6 +410,8 @@ public:
     \param fMo_ : The pose between the object and the fixed world frame.
   */
   void set_fMo(const vpHomogeneousMatrix &fMo_) { this->fMo = fMo_; }
+
+  void step(double dt);
   //@}
 
 protected:
@@ -388,9 +438,13 @@ protected:
 
   /* Robot functions */
   void init() { ; }
-  /*! Method lauched by the thread to compute the position of the robot in the
-   * articular frame. */
-  virtual void updateArticularPosition() = 0;
+  void initThreadResources();
+  void startThread();
+  void stopThread();
+  virtual void updateArticularPosition();
+  /*! Method used to move the robot in the articular frame during \e
+   * ellapsedTime seconds, update the frame poses and the external view. */
+  virtual void integrateArticularPosition(double ellapsedTime) = 0;
   /*! Method used to check if the robot reached a joint limit. */
   virtual int isInJointLimit() = 0;
   /*! Compute the articular velocity relative to the velocity in another
@@ -401,162 +455,20 @@ protected:
   void initDisplay() { ; }
   virtual void initArms() = 0;
 
-#if defined(_WIN32)
-  vpColVector get_artCoord() const
-  {
-#if defined(WINRT_8_1)
-    WaitForSingleObjectEx(mutex_artCoord, INFINITE, FALSE);
-#else // pure win32
-    WaitForSingleObject(mutex_artCoord, INFINITE);
-#endif
-    vpColVector artCoordTmp(6);
-    artCoordTmp = artCoord;
-    ReleaseMutex(mutex_artCoord);
-    return artCoordTmp;
-  }
-  void set_artCoord(const vpColVector &coord)
-  {
-#if defined(WINRT_8_1)
-    WaitForSingleObjectEx(mutex_artCoord, INFINITE, FALSE);
-#else // pure win32
-    WaitForSingleObject(mutex_artCoord, INFINITE);
-#endif
-    artCoord = coord;
-    ReleaseMutex(mutex_artCoord);
-  }
-
-  vpColVector get_artVel() const
-  {
-#if defined(WINRT_8_1)
-    WaitForSingleObjectEx(mutex_artVel, INFINITE, FALSE);
-#else // pure win32
-    WaitForSingleObject(mutex_artVel, INFINITE);
-#endif
-    vpColVector artVelTmp(artVel);
-    ReleaseMutex(mutex_artVel);
-    return artVelTmp;
-  }
-  void set_artVel(const vpColVector &vel)
-  {
-#if defined(WINRT_8_1)
-    WaitForSingleObjectEx(mutex_artVel, INFINITE, FALSE);
-#else // pure win32
-    WaitForSingleObject(mutex_artVel, INFINITE);
-#endif
-    artVel = vel;
-    ReleaseMutex(mutex_artVel);
-  }
-
-  vpColVector get_velocity()
-  {
-#if defined(WINRT_8_1)
-    WaitForSingleObjectEx(mutex_velocity, INFINITE, FALSE);
-#else // pure win32
-    WaitForSingleObject(mutex_velocity, INFINITE);
-#endif
-    vpColVector velocityTmp = velocity;
-    ReleaseMutex(mutex_velocity);
-    return velocityTmp;
-  }
-  void set_velocity(const vpColVector &vel)
-  {
-#if defined(WINRT_8_1)
-    WaitForSingleObjectEx(mutex_velocity, INFINITE, FALSE);
-#else // pure win32
-    WaitForSingleObject(mutex_velocity, INFINITE);
-#endif
-    velocity = vel;
-    ReleaseMutex(mutex_velocity);
-  }
-
-  void set_displayBusy(const bool &status)
-  {
-#if defined(WINRT_8_1)
-    WaitForSingleObjectEx(mutex_display, INFINITE, FALSE);
-#else // pure win32
-    WaitForSingleObject(mutex_display, INFINITE);
-#endif
-    displayBusy = status;
-    ReleaseMutex(mutex_display);
-  }
-  bool get_displayBusy()
-  {
-#if defined(WINRT_8_1)
-    WaitForSingleObjectEx(mutex_display, INFINITE, FALSE);
-#else // pure win32
-    WaitForSingleObject(mutex_display, INFINITE);
-#endif
-    bool status = displayBusy;
-    if (!displayBusy)
-      displayBusy = true;
-    ReleaseMutex(mutex_display);
-    return status;
-  }
+  vpColVector get_artCoord();
+  void set_artCoord(const vpColVector &coord);
 
-#elif defined(VISP_HAVE_PTHREAD)
-  vpColVector get_artCoord()
-  {
-    pthread_mutex_lock(&mutex_artCoord);
-    vpColVector artCoordTmp(6);
-    artCoordTmp = artCoord;
-    pthread_mutex_unlock(&mutex_artCoord);
-    return artCoordTmp;
-  }
-  void set_artCoord(const vpColVector &coord)
-  {
-    pthread_mutex_lock(&mutex_artCoord);
-    artCoord = coord;
-    pthread_mutex_unlock(&mutex_artCoord);
-  }
+  vpColVector get_artVel();
+  void set_artVel(const vpColVector &vel);
 
-  vpColVector get_artVel()
-  {
-    pthread_mutex_lock(&mutex_artVel);
-    vpColVector artVelTmp(artVel);
-    pthread_mutex_unlock(&mutex_artVel);
-    return artVelTmp;
-  }
-  void set_artVel(const vpColVector &vel)
-  {
-    pthread_mutex_lock(&mutex_artVel);
-    artVel = vel;
-    pthread_mutex_unlock(&mutex_artVel);
-  }
-
-  vpColVector get_velocity()
-  {
-    pthread_mutex_lock(&mutex_velocity);
-    vpColVector velocityTmp = velocity;
-    pthread_mutex_unlock(&mutex_velocity);
-    return velocityTmp;
-  }
-  void set_velocity(const vpColVector &vel)
-  {
-    pthread_mutex_lock(&mutex_velocity);
-    velocity = vel;
-    pthread_mutex_unlock(&mutex_velocity);
-  }
+  vpColVector get_velocity();
+  void set_velocity(const vpColVector &vel);
 
-  void set_displayBusy(const bool &status)
-  {
-    pthread_mutex_lock(&mutex_display);
-    displayBusy = status;
-    pthread_mutex_unlock(&mutex_display);
-  }
-  bool get_displayBusy()
-  {
-    pthread_mutex_lock(&mutex_display);
-    bool status = displayBusy;
-    if (!displayBusy)
-      displayBusy = true;
-    pthread_mutex_unlock(&mutex_display);
-    return status;
-  }
-#endif
+  void set_displayBusy(const bool &status);
+  bool get_displayBusy();
 
-  /*! Get a table of poses between the reference frame and the frames you used
-   * to compute the Denavit-Hartenberg representation */
-  virtual void get_fMi(vpHomogeneousMatrix *fMit) = 0;
+  virtual void get_fMi(vpHomogeneousMatrix *fMit);
+  void set_fMi(const vpHomogeneousMatrix *fMit);
   //@}
 };
 
@@ -277,30 +277,12 @@ protected:
   void findHighestPositioningSpeed(vpColVector &q);
   void getExternalImage(vpImage<vpRGBa> &I);
 
-  inline void get_fMi(vpHomogeneousMatrix *fMit)
-  {
-#if defined(_WIN32)
-#if defined(WINRT_8_1)
-    WaitForSingleObjectEx(mutex_fMi, INFINITE, FALSE);
-#else // pure win32
-    WaitForSingleObject(mutex_fMi, INFINITE);
-#endif
-    for (int i = 0; i < 8; i++)
-      fMit[i] = fMi[i];
-    ReleaseMutex(mutex_fMi);
-#elif defined(VISP_HAVE_PTHREAD)
-    pthread_mutex_lock(&mutex_fMi);
-    for (int i = 0; i < 8; i++)
-      fMit[i] = fMi[i];
-    pthread_mutex_unlock(&mutex_fMi);
-#endif
-  }
   void init();
   void initArms();
+  void integrateArticularPosition(double ellapsedTime);
   void initDisplay();
   int isInJointLimit(void);
   bool singularityTest(const vpColVector &q, vpMatrix &J);
-  void updateArticularPosition();
   //@}
 };
 
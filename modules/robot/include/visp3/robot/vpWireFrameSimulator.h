@@ -49,6 +49,7 @@
 #include <list>
 #include <stdio.h>
 #include <string>
+#include <vector>
 #include <visp3/core/vpConfig.h>
 
 #include <visp3/core/vpConfig.h>
@@ -150,6 +151,20 @@
     return 0;
   }
   \endcode
+
+  getInternalImage() and getExternalImage() draw the scene in overlay through
+  the display attached to the image. For offline rendering,
+  renderInternalImage() and renderExternalImage() rasterize the same views
+  directly in the image pixels without any display, and
+  renderInternalImages() and renderExternalImages() render a set of camera
+  poses at once, in parallel when OpenMP is available.
+
+  \code
+  std::vector<vpHomogeneousMatrix> cMo(100);
+  // ... fill the poses
+  std::vector<vpImage<unsigned char> > I(cMo.size(), vpImage<unsigned char>(480, 640, 255));
+  sim.renderInternalImages(I, cMo);
+  \endcode
 */
 
 class VISP_EXPORT vpWireFrameSimulator
@@ -444,6 +459,15 @@ public:
   void initScene(const vpSceneObject &obj, const std::list<vpImageSimulator> &imObj);
   void initScene(const char *obj, const std::list<vpImageSimulator> &imObj);
 
+  void renderExternalImage(vpImage<unsigned char> &I);
+  void renderExternalImage(vpImage<vpRGBa> &I);
+  void renderExternalImages(std::vector<vpImage<unsigned char> > &I, const std::vector<vpHomogeneousMatrix> &cMf);
+  void renderExternalImages(std::vector<vpImage<vpRGBa> > &I, const std::vector<vpHomogeneousMatrix> &cMf);
+  void renderInternalImage(vpImage<unsigned char> &I);
+  void renderInternalImage(vpImage<vpRGBa> &I);
+  void renderInternalImages(std::vector<vpImage<unsigned char> > &I, const std::vector<vpHomogeneousMatrix> &cMo);
+  void renderInternalImages(std::vector<vpImage<vpRGBa> > &I, const std::vector<vpHomogeneousMatrix> &cMo);
+
   /*!
       Set the color used to display the camera in the external view.
 
@@ -604,6 +628,13 @@ protected:
   vpImagePoint projectCameraTrajectory(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo,
                                        const vpHomogeneousMatrix &fMo, const vpHomogeneousMatrix &cMf);
   //@}
+
+private:
+  template <class Type>
+  void render(vpImage<Type> &I, const vpHomogeneousMatrix &pose, bool internal,
+              std::list<vpImageSimulator> &objects) const;
+  template <class Type>
+  void renderBatch(std::vector<vpImage<Type> > &I, const std::vector<vpHomogeneousMatrix> &poses, bool internal) const;
 };
 
 #endif
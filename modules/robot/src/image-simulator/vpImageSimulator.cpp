@@ -37,6 +37,9 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpMatrixException.h>
 #include <visp3/core/vpMeterPixelConversion.h>
@@ -181,6 +184,197 @@ vpImageSimulator &vpImageSimulator::operator=(const vpImageSimulator &sim)
   return *this;
 }
 
+namespace
+{
+// Conversion of a texture value into a value of the rendered image
+inline void convertPixel(const unsigned char &src, unsigned char &dst) { dst = src; }
+
+inline void convertPixel(const unsigned char &src, vpRGBa &dst)
+{
+  dst.R = src;
+  dst.G = src;
+  dst.B = src;
+  dst.A = vpRGBa::alpha_default;
+}
+
+inline void convertPixel(const vpRGBa &src, unsigned char &dst)
+{
+  dst = (unsigned char)(0.2126 * src.R + 0.7152 * src.G + 0.0722 * src.B);
+}
+
+inline void convertPixel(const vpRGBa &src, vpRGBa &dst) { dst = src; }
+
+// Bilinear interpolation with 8 bits weights
+inline unsigned char interpolate(unsigned char p00, unsigned char p01, unsigned char p10, unsigned char p11,
+                                 unsigned int wi, unsigned int wj)
+{
+  unsigned int top = p00 * (256 - wj) + p01 * wj;
+  unsigned int bottom = p10 * (256 - wj) + p11 * wj;
+  return (unsigned char)((top * (256 - wi) + bottom * wi + 32768) >> 16);
+}
+
+// Texture coordinates (fi, fj) are given in 24.8 fixed point
+inline void sampleBilinear(const vpImage<unsigned char> &texture, unsigned int fi, unsigned int fj,
+                           unsigned char &value)
+{
+  unsigned int i0 = fi >> 8, j0 = fj >> 8;
+  unsigned int i1 = (i0 + 1 < texture.getHeight()) ? i0 + 1 : i0;
+  unsigned int j1 = (j0 + 1 < texture.getWidth()) ? j0 + 1 : j0;
+  const unsigned char *r0 = texture[i0];
+  const unsigned char *r1 = texture[i1];
+  value = interpolate(r0[j0], r0[j1], r1[j0], r1[j1], fi & 0xff, fj & 0xff);
+}
+
+inline void sampleBilinear(const vpImage<vpRGBa> &texture, unsigned int fi, unsigned int fj, vpRGBa &value)
+{
+  unsigned int i0 = fi >> 8, j0 = fj >> 8;
+  unsigned int i1 = (i0 + 1 < texture.getHeight()) ? i0 + 1 : i0;
+  unsigned int j1 = (j0 + 1 < texture.getWidth()) ? j0 + 1 : j0;
+  const vpRGBa *r0 = texture[i0];
+  const vpRGBa *r1 = texture[i1];
+  unsigned int wi = fi & 0xff, wj = fj & 0xff;
+  value.R = interpolate(r0[j0].R, r0[j1].R, r1[j0].R, r1[j1].R, wi, wj);
+  value.G = interpolate(r0[j0].G, r0[j1].G, r1[j0].G, r1[j1].G, wi, wj);
+  value.B = interpolate(r0[j0].B, r0[j1].B, r1[j0].B, r1[j1].B, wi, wj);
+  value.A = vpRGBa::alpha_default;
+}
+
+// Restricts [kmin, kmax] to the values of k such as f0 + k * df > 0
+inline void restrictSpan(double f0, double df, double &kmin, double &kmax)
+{
+  if (df > 0) {
+    kmin = std::max(kmin, -f0 / df);
+  } else if (df < 0) {
+    kmax = std::min(kmax, -f0 / df);
+  } else if (f0 <= 0) {
+    kmax = -1;
+  }
+}
+}
+
+/*!
+  Renders the plane in the region of interest \e rect of the image.
+
+  Without distortion the texture coordinates of a pixel are obtained by a
+  homography. Along an image row the numerators and the denominator of this
+  homography are affine functions of the column index, so they are updated
+  incrementally. The part of the row where the plane is visible is first
+  computed from these functions, then only the pixels of this span are
+  visited. Bilinear interpolation is done in fixed point. Image rows are
+  rendered in parallel when OpenMP is available.
+
+  \param I : Image to update.
+  \param texture : Texture of the plane.
+  \param cam : Camera parameters, without distortion.
+  \param zBuffer : If not NULL, depth of the pixels of I. A pixel is only
+  updated if the plane is in front of the depth stored in the buffer, or if
+  this depth is negative. The buffer is then updated.
+*/
+template <class Type, class TextureType>
+void vpImageSimulator::render(vpImage<Type> &I, const vpImage<TextureType> &texture, const vpCameraParameters &cam,
+                              vpMatrix *zBuffer)
+{
+  const int top = (int)rect.getTop();
+  const int bottom = (int)rect.getBottom();
+  const int left = (int)rect.getLeft();
+  const int right = (int)rect.getRight();
+  if (right <= left || bottom <= top || texture.getSize() == 0) {
+    return;
+  }
+
+  const double px_inv = cam.get_px_inverse();
+  const double py_inv = cam.get_py_inverse();
+  const double u0 = cam.get_u0();
+  const double v0 = cam.get_v0();
+  const double nu2 = euclideanNorm_u * euclideanNorm_u;
+  const double nv2 = euclideanNorm_v * euclideanNorm_v;
+  const double nu2_inv = 1. / nu2;
+  const double nv2_inv = 1. / nv2;
+  const double *n = normal_Cam_optim;
+  const double *eu = vbase_u_optim;
+  const double *ev = vbase_v_optim;
+  const double ku = X0_2_optim[0] * eu[0] + X0_2_optim[1] * eu[1] + X0_2_optim[2] * eu[2];
+  const double kv = X0_2_optim[0] * ev[0] + X0_2_optim[1] * ev[1] + X0_2_optim[2] * ev[2];
+  const double d = distance;
+  const double texture_i = texture.getHeight() - 1.;
+  const double texture_j = texture.getWidth() - 1.;
+  const bool bilinear = (interp == BILINEAR_INTERPOLATION);
+  const int nb_cols = right - left;
+
+  // Affine variation along a row of the dot products between the ray
+  // (x, y, 1) and the plane normal and basis vectors
+  const double x_left = (left - u0) * px_inv;
+  const double dc = n[0] * px_inv;
+  const double da = eu[0] * px_inv;
+  const double db = ev[0] * px_inv;
+  // The intersection of the ray with the plane is at depth z = d / c, and its
+  // coordinates in the plane basis are u = U / (c * nu2), v = V / (c * nv2)
+  const double dU = d * da - ku * dc;
+  const double dV = d * db - kv * dc;
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = top; i < bottom; i++) {
+    const double y = (i - v0) * py_inv;
+    double c = n[0] * x_left + n[1] * y + n[2];
+    double a = eu[0] * x_left + eu[1] * y + eu[2];
+    double b = ev[0] * x_left + ev[1] * y + ev[2];
+    double U = d * a - ku * c;
+    double V = d * b - kv * c;
+
+    // Span of the row where 0 < u < 1, 0 < v < 1 and z > 0
+    double kmin = 0, kmax = nb_cols - 1;
+    restrictSpan(c, dc, kmin, kmax);
+    restrictSpan(U, dU, kmin, kmax);
+    restrictSpan(c * nu2 - U, dc * nu2 - dU, kmin, kmax);
+    restrictSpan(V, dV, kmin, kmax);
+    restrictSpan(c * nv2 - V, dc * nv2 - dV, kmin, kmax);
+    if (kmax < kmin) {
+      continue;
+    }
+    // The bounds are widened by one pixel, the test is done for each pixel
+    int kstart = std::max(0, (int)floor(kmin) - 1);
+    int kend = std::min(nb_cols - 1, (int)ceil(kmax) + 1);
+
+    c += kstart * dc;
+    U += kstart * dU;
+    V += kstart * dV;
+
+    Type *dst = I[(unsigned int)i] + left;
+    double *zrow = (zBuffer != NULL) ? (*zBuffer)[(unsigned int)i] + left : NULL;
+    for (int k = kstart; k <= kend; k++, c += dc, U += dU, V += dV) {
+      if (c <= 0) {
+        continue;
+      }
+      double c_inv = 1. / c;
+      double u = U * c_inv * nu2_inv;
+      double v = V * c_inv * nv2_inv;
+      if (!(u > 0 && v > 0 && u < 1. && v < 1.)) {
+        continue;
+      }
+
+      if (zrow != NULL) {
+        double z = d * c_inv;
+        if (!(z < zrow[k] || zrow[k] < 0)) {
+          continue;
+        }
+        zrow[k] = z;
+      }
+
+      double i2 = v * texture_i;
+      double j2 = u * texture_j;
+      if (bilinear) {
+        TextureType value;
+        sampleBilinear(texture, (unsigned int)(i2 * 256.), (unsigned int)(j2 * 256.), value);
+        convertPixel(value, dst[k]);
+      } else {
+        convertPixel(texture[(unsigned int)i2][(unsigned int)j2], dst[k]);
+      }
+    }
+  }
+}
+
 /*!
   Get the view of the virtual camera. Be careful, the image I is modified. The
   projected image is not added as an overlay! \param I : The image used to
@@ -213,30 +407,37 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, const vpCameraParamet
     double left = rect.getLeft();
     double right = rect.getRight();
 
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan = 0;
-          if (getPixel(ip, Ipixelplan)) {
-            *(bitmap + i * width + j) = Ipixelplan;
-            nb_point_dessine++;
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            unsigned char pixelgrey =
-                (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-            *(bitmap + i * width + j) = pixelgrey;
-            nb_point_dessine++;
+    if (cam.get_projModel() == vpCameraParameters::perspectiveProjWithoutDistortion) {
+      if (colorI == GRAY_SCALED)
+        render(I, Ig, cam, NULL);
+      else
+        render(I, Ic, cam, NULL);
+    } else {
+      unsigned char *bitmap = I.bitmap;
+      unsigned int width = I.getWidth();
+      vpImagePoint ip;
+      int nb_point_dessine = 0;
+
+      for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
+        for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
+          double x = 0, y = 0;
+          ip.set_ij(i, j);
+          vpPixelMeterConversion::convertPoint(cam, ip, x, y);
+          ip.set_ij(y, x);
+          if (colorI == GRAY_SCALED) {
+            unsigned char Ipixelplan = 0;
+            if (getPixel(ip, Ipixelplan)) {
+              *(bitmap + i * width + j) = Ipixelplan;
+              nb_point_dessine++;
+            }
+          } else if (colorI == COLORED) {
+            vpRGBa Ipixelplan;
+            if (getPixel(ip, Ipixelplan)) {
+              unsigned char pixelgrey =
+                  (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
+              *(bitmap + i * width + j) = pixelgrey;
+              nb_point_dessine++;
+            }
           }
         }
       }
@@ -274,21 +475,25 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, vpImage<unsigned char
     double left = rect.getLeft();
     double right = rect.getRight();
 
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        unsigned char Ipixelplan = 0;
-        if (getPixel(Isrc, ip, Ipixelplan)) {
-          *(bitmap + i * width + j) = Ipixelplan;
-          nb_point_dessine++;
+    if (cam.get_projModel() == vpCameraParameters::perspectiveProjWithoutDistortion) {
+      render(I, Isrc, cam, NULL);
+    } else {
+      unsigned char *bitmap = I.bitmap;
+      unsigned int width = I.getWidth();
+      vpImagePoint ip;
+      int nb_point_dessine = 0;
+
+      for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
+        for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
+          double x = 0, y = 0;
+          ip.set_ij(i, j);
+          vpPixelMeterConversion::convertPoint(cam, ip, x, y);
+          ip.set_ij(y, x);
+          unsigned char Ipixelplan = 0;
+          if (getPixel(Isrc, ip, Ipixelplan)) {
+            *(bitmap + i * width + j) = Ipixelplan;
+            nb_point_dessine++;
+          }
         }
       }
     }
@@ -335,35 +540,42 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, const vpCameraParamet
     double left = rect.getLeft();
     double right = rect.getRight();
 
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              *(bitmap + i * width + j) = Ipixelplan;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
+    if (cam.get_projModel() == vpCameraParameters::perspectiveProjWithoutDistortion) {
+      if (colorI == GRAY_SCALED)
+        render(I, Ig, cam, &zBuffer);
+      else
+        render(I, Ic, cam, &zBuffer);
+    } else {
+      unsigned char *bitmap = I.bitmap;
+      unsigned int width = I.getWidth();
+      vpImagePoint ip;
+      int nb_point_dessine = 0;
+
+      for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
+        for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
+          double x = 0, y = 0;
+          ip.set_ij(i, j);
+          vpPixelMeterConversion::convertPoint(cam, ip, x, y);
+          ip.set_ij(y, x);
+          if (colorI == GRAY_SCALED) {
+            unsigned char Ipixelplan;
+            if (getPixel(ip, Ipixelplan)) {
+              if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
+                *(bitmap + i * width + j) = Ipixelplan;
+                nb_point_dessine++;
+                zBuffer[i][j] = Xinter_optim[2];
+              }
             }
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              unsigned char pixelgrey =
-                  (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-              *(bitmap + i * width + j) = pixelgrey;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
+          } else if (colorI == COLORED) {
+            vpRGBa Ipixelplan;
+            if (getPixel(ip, Ipixelplan)) {
+              if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
+                unsigned char pixelgrey =
+                    (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
+                *(bitmap + i * width + j) = pixelgrey;
+                nb_point_dessine++;
+                zBuffer[i][j] = Xinter_optim[2];
+              }
             }
           }
         }
@@ -400,32 +612,39 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &ca
     double left = rect.getLeft();
     double right = rect.getRight();
 
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            vpRGBa pixelcolor;
-            pixelcolor.R = Ipixelplan;
-            pixelcolor.G = Ipixelplan;
-            pixelcolor.B = Ipixelplan;
-            *(bitmap + i * width + j) = pixelcolor;
-            nb_point_dessine++;
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            *(bitmap + i * width + j) = Ipixelplan;
-            nb_point_dessine++;
+    if (cam.get_projModel() == vpCameraParameters::perspectiveProjWithoutDistortion) {
+      if (colorI == GRAY_SCALED)
+        render(I, Ig, cam, NULL);
+      else
+        render(I, Ic, cam, NULL);
+    } else {
+      vpRGBa *bitmap = I.bitmap;
+      unsigned int width = I.getWidth();
+      vpImagePoint ip;
+      int nb_point_dessine = 0;
+
+      for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
+        for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
+          double x = 0, y = 0;
+          ip.set_ij(i, j);
+          vpPixelMeterConversion::convertPoint(cam, ip, x, y);
+          ip.set_ij(y, x);
+          if (colorI == GRAY_SCALED) {
+            unsigned char Ipixelplan;
+            if (getPixel(ip, Ipixelplan)) {
+              vpRGBa pixelcolor;
+              pixelcolor.R = Ipixelplan;
+              pixelcolor.G = Ipixelplan;
+              pixelcolor.B = Ipixelplan;
+              *(bitmap + i * width + j) = pixelcolor;
+              nb_point_dessine++;
+            }
+          } else if (colorI == COLORED) {
+            vpRGBa Ipixelplan;
+            if (getPixel(ip, Ipixelplan)) {
+              *(bitmap + i * width + j) = Ipixelplan;
+              nb_point_dessine++;
+            }
           }
         }
       }
@@ -463,21 +682,25 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, vpImage<vpRGBa> &Isrc, const
     double left = rect.getLeft();
     double right = rect.getRight();
 
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        vpRGBa Ipixelplan;
-        if (getPixel(Isrc, ip, Ipixelplan)) {
-          *(bitmap + i * width + j) = Ipixelplan;
-          nb_point_dessine++;
+    if (cam.get_projModel() == vpCameraParameters::perspectiveProjWithoutDistortion) {
+      render(I, Isrc, cam, NULL);
+    } else {
+      vpRGBa *bitmap = I.bitmap;
+      unsigned int width = I.getWidth();
+      vpImagePoint ip;
+      int nb_point_dessine = 0;
+
+      for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
+        for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
+          double x = 0, y = 0;
+          ip.set_ij(i, j);
+          vpPixelMeterConversion::convertPoint(cam, ip, x, y);
+          ip.set_ij(y, x);
+          vpRGBa Ipixelplan;
+          if (getPixel(Isrc, ip, Ipixelplan)) {
+            *(bitmap + i * width + j) = Ipixelplan;
+            nb_point_dessine++;
+          }
         }
       }
     }
@@ -523,37 +746,44 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &ca
     double left = rect.getLeft();
     double right = rect.getRight();
 
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              vpRGBa pixelcolor;
-              pixelcolor.R = Ipixelplan;
-              pixelcolor.G = Ipixelplan;
-              pixelcolor.B = Ipixelplan;
-              *(bitmap + i * width + j) = pixelcolor;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
+    if (cam.get_projModel() == vpCameraParameters::perspectiveProjWithoutDistortion) {
+      if (colorI == GRAY_SCALED)
+        render(I, Ig, cam, &zBuffer);
+      else
+        render(I, Ic, cam, &zBuffer);
+    } else {
+      vpRGBa *bitmap = I.bitmap;
+      unsigned int width = I.getWidth();
+      vpImagePoint ip;
+      int nb_point_dessine = 0;
+
+      for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
+        for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
+          double x = 0, y = 0;
+          ip.set_ij(i, j);
+          vpPixelMeterConversion::convertPoint(cam, ip, x, y);
+          ip.set_ij(y, x);
+          if (colorI == GRAY_SCALED) {
+            unsigned char Ipixelplan;
+            if (getPixel(ip, Ipixelplan)) {
+              if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
+                vpRGBa pixelcolor;
+                pixelcolor.R = Ipixelplan;
+                pixelcolor.G = Ipixelplan;
+                pixelcolor.B = Ipixelplan;
+                *(bitmap + i * width + j) = pixelcolor;
+                nb_point_dessine++;
+                zBuffer[i][j] = Xinter_optim[2];
+              }
             }
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              *(bitmap + i * width + j) = Ipixelplan;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
+          } else if (colorI == COLORED) {
+            vpRGBa Ipixelplan;
+            if (getPixel(ip, Ipixelplan)) {
+              if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
+                *(bitmap + i * width + j) = Ipixelplan;
+                nb_point_dessine++;
+                zBuffer[i][j] = Xinter_optim[2];
+              }
             }
           }
         }
@@ -688,10 +918,10 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, std::list<vpImageSimu
 
   unsigned int unvisible = 0;
   unsigned int indexSimu = 0;
-  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it, ++indexSimu) {
+  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it) {
     vpImageSimulator *sim = &(*it);
     if (sim->visible)
-      simList[indexSimu] = sim;
+      simList[indexSimu++] = sim;
     else
       unvisible++;
   }
@@ -718,6 +948,19 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, std::list<vpImageSimu
       rightFinal = simList[i]->rect.getRight();
   }
 
+  if (cam.get_projModel() == vpCameraParameters::perspectiveProjWithoutDistortion) {
+    // Each plane is rendered in its region of interest with a depth test
+    vpMatrix zBuffer(height, width, -1.);
+    for (unsigned int i = 0; i < nbsimList; i++) {
+      if (simList[i]->colorI == GRAY_SCALED)
+        simList[i]->render(I, simList[i]->Ig, cam, &zBuffer);
+      else
+        simList[i]->render(I, simList[i]->Ic, cam, &zBuffer);
+    }
+    delete[] simList;
+    return;
+  }
+
   double zmin = -1;
   int indice = -1;
   unsigned char *bitmap = I.bitmap;
@@ -726,6 +969,7 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, std::list<vpImageSimu
   for (unsigned int i = (unsigned int)topFinal; i < (unsigned int)bottomFinal; i++) {
     for (unsigned int j = (unsigned int)leftFinal; j < (unsigned int)rightFinal; j++) {
       zmin = -1;
+      indice = -1;
       double x = 0, y = 0;
       ip.set_ij(i, j);
       vpPixelMeterConversion::convertPoint(cam, ip, x, y);
@@ -885,10 +1129,10 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, std::list<vpImageSimulator>
 
   unsigned int unvisible = 0;
   unsigned int indexSimu = 0;
-  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it, ++indexSimu) {
+  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it) {
     vpImageSimulator *sim = &(*it);
     if (sim->visible)
-      simList[indexSimu] = sim;
+      simList[indexSimu++] = sim;
     else
       unvisible++;
   }
@@ -916,6 +1160,19 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, std::list<vpImageSimulator>
       rightFinal = simList[i]->rect.getRight();
   }
 
+  if (cam.get_projModel() == vpCameraParameters::perspectiveProjWithoutDistortion) {
+    // Each plane is rendered in its region of interest with a depth test
+    vpMatrix zBuffer(height, width, -1.);
+    for (unsigned int i = 0; i < nbsimList; i++) {
+      if (simList[i]->colorI == GRAY_SCALED)
+        simList[i]->render(I, simList[i]->Ig, cam, &zBuffer);
+      else
+        simList[i]->render(I, simList[i]->Ic, cam, &zBuffer);
+    }
+    delete[] simList;
+    return;
+  }
+
   double zmin = -1;
   int indice = -1;
   vpRGBa *bitmap = I.bitmap;
@@ -924,6 +1181,7 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, std::list<vpImageSimulator>
   for (unsigned int i = (unsigned int)topFinal; i < (unsigned int)bottomFinal; i++) {
     for (unsigned int j = (unsigned int)leftFinal; j < (unsigned int)rightFinal; j++) {
       zmin = -1;
+      indice = -1;
       double x = 0, y = 0;
       ip.set_ij(i, j);
       vpPixelMeterConversion::convertPoint(cam, ip, x, y);
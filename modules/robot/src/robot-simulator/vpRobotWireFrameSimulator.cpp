@@ -39,13 +39,91 @@
 #include <visp3/core/vpConfig.h>
 
 #if defined(VISP_HAVE_MODULE_GUI) && ((defined(_WIN32) && !defined(WINRT_8_0)) || defined(VISP_HAVE_PTHREAD))
+#include <visp3/robot/vpRobotException.h>
 #include <visp3/robot/vpRobotWireFrameSimulator.h>
 #include <visp3/robot/vpSimulatorViper850.h>
 
+#if defined(VISP_HAVE_CPP11_COMPATIBILITY)
+#include <atomic>
+#endif
+
 #include "../wireframe-simulator/vpBound.h"
 #include "../wireframe-simulator/vpScene.h"
 #include "../wireframe-simulator/vpVwstack.h"
 
+#if defined(VISP_HAVE_CPP11_COMPATIBILITY)
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*
+  Sequence lock holding a fixed capacity vector of doubles. Writers are
+  serialized by the mutex associated to the state. The sequence is odd while
+  a writer updates the values; readers never block and retry their copy until
+  they read an even sequence that did not change during the copy.
+*/
+class vpRobotWireFrameSimulator::vpSeqLock
+{
+public:
+  explicit vpSeqLock(unsigned int capacity) : m_sequence(0), m_size(0), m_capacity(capacity), m_values(NULL)
+  {
+    m_values = new std::atomic<double>[capacity];
+    for (unsigned int i = 0; i < capacity; i++)
+      m_values[i].store(0., std::memory_order_relaxed);
+  }
+  ~vpSeqLock() { delete[] m_values; }
+
+  unsigned int read(double *values) const
+  {
+    unsigned int seq0, seq1, size;
+    do {
+      seq0 = m_sequence.load(std::memory_order_acquire);
+      size = m_size.load(std::memory_order_relaxed);
+      for (unsigned int i = 0; i < size; i++)
+        values[i] = m_values[i].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      seq1 = m_sequence.load(std::memory_order_relaxed);
+    } while ((seq0 & 1) || seq0 != seq1);
+    return size;
+  }
+
+  void write(const double *values, unsigned int size)
+  {
+    if (size > m_capacity) {
+      throw vpRobotException(vpRobotException::lowLevelError, "Cannot store %d values in a state of capacity %d",
+                             size, m_capacity);
+    }
+    unsigned int seq = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_size.store(size, std::memory_order_relaxed);
+    for (unsigned int i = 0; i < size; i++)
+      m_values[i].store(values[i], std::memory_order_relaxed);
+    m_sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  vpColVector readVector() const
+  {
+    std::vector<double> values(m_capacity);
+    unsigned int size = read(&values[0]);
+    vpColVector v(size);
+    for (unsigned int i = 0; i < size; i++)
+      v[i] = values[i];
+    return v;
+  }
+
+  unsigned int capacity() const { return m_capacity; }
+
+private:
+  vpSeqLock(const vpSeqLock &);
+  vpSeqLock &operator=(const vpSeqLock &);
+
+  std::atomic<unsigned int> m_sequence;
+  std::atomic<unsigned int> m_size;
+  unsigned int m_capacity;
+  std::atomic<double> *m_values;
+};
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+#endif
+
 /*!
   Basic constructor
 */
@@ -62,8 +140,13 @@ vpRobotWireFrameSimulator::vpRobotWireFrameSimulator()
     display(),
 #endif
     displayType(MODEL_3D), displayAllowed(true), constantSamplingTimeMode(false), setVelocityCalled(false),
-    verbose_(false)
+    verbose_(false), synchronousMode(false), threadRunning(false), simulationTime(0)
+#if defined(VISP_HAVE_CPP11_COMPATIBILITY)
+    ,
+    artCoordLock(NULL), artVelLock(NULL), velocityLock(NULL), fMiLock(NULL)
+#endif
 {
+  initThreadResources();
   setSamplingTime(0.010);
   velocity.resize(6);
   I.resize(480, 640);
@@ -94,8 +177,13 @@ vpRobotWireFrameSimulator::vpRobotWireFrameSimulator(bool do_display)
     display(),
 #endif
     displayType(MODEL_3D), displayAllowed(do_display), constantSamplingTimeMode(false), setVelocityCalled(false),
-    verbose_(false)
+    verbose_(false), synchronousMode(false), threadRunning(false), simulationTime(0)
+#if defined(VISP_HAVE_CPP11_COMPATIBILITY)
+    ,
+    artCoordLock(NULL), artVelLock(NULL), velocityLock(NULL), fMiLock(NULL)
+#endif
 {
+  initThreadResources();
   setSamplingTime(0.010);
   velocity.resize(6);
   I.resize(480, 640);
@@ -113,7 +201,528 @@ vpRobotWireFrameSimulator::vpRobotWireFrameSimulator(bool do_display)
 /*!
   Basic destructor
 */
-vpRobotWireFrameSimulator::~vpRobotWireFrameSimulator() {}
+vpRobotWireFrameSimulator::~vpRobotWireFrameSimulator()
+{
+#if defined(_WIN32)
+  CloseHandle(mutex_fMi);
+  CloseHandle(mutex_artVel);
+  CloseHandle(mutex_artCoord);
+  CloseHandle(mutex_velocity);
+  CloseHandle(mutex_display);
+#elif defined(VISP_HAVE_PTHREAD)
+  pthread_attr_destroy(&attr);
+  pthread_mutex_destroy(&mutex_fMi);
+  pthread_mutex_destroy(&mutex_artVel);
+  pthread_mutex_destroy(&mutex_artCoord);
+  pthread_mutex_destroy(&mutex_velocity);
+  pthread_mutex_destroy(&mutex_display);
+#endif
+
+#if defined(VISP_HAVE_CPP11_COMPATIBILITY)
+  delete artCoordLock;
+  delete artVelLock;
+  delete velocityLock;
+  delete fMiLock;
+#endif
+}
+
+/*!
+  Create the mutexes and the states shared with the thread computing the
+  robot displacement.
+*/
+void vpRobotWireFrameSimulator::initThreadResources()
+{
+#if defined(_WIN32)
+#ifdef WINRT_8_1
+  mutex_fMi = CreateMutexEx(NULL, NULL, 0, NULL);
+  mutex_artVel = CreateMutexEx(NULL, NULL, 0, NULL);
+  mutex_artCoord = CreateMutexEx(NULL, NULL, 0, NULL);
+  mutex_velocity = CreateMutexEx(NULL, NULL, 0, NULL);
+  mutex_display = CreateMutexEx(NULL, NULL, 0, NULL);
+#else
+  mutex_fMi = CreateMutex(NULL, FALSE, NULL);
+  mutex_artVel = CreateMutex(NULL, FALSE, NULL);
+  mutex_artCoord = CreateMutex(NULL, FALSE, NULL);
+  mutex_velocity = CreateMutex(NULL, FALSE, NULL);
+  mutex_display = CreateMutex(NULL, FALSE, NULL);
+#endif
+#elif defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_init(&mutex_fMi, NULL);
+  pthread_mutex_init(&mutex_artVel, NULL);
+  pthread_mutex_init(&mutex_artCoord, NULL);
+  pthread_mutex_init(&mutex_velocity, NULL);
+  pthread_mutex_init(&mutex_display, NULL);
+
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+#endif
+
+#if defined(VISP_HAVE_CPP11_COMPATIBILITY)
+  artCoordLock = new vpSeqLock(6);
+  artVelLock = new vpSeqLock(6);
+  velocityLock = new vpSeqLock(6);
+  fMiLock = new vpSeqLock(12 * size_fMi);
+  vpColVector zero(6);
+  artCoordLock->write(zero.data, zero.size());
+  artVelLock->write(zero.data, zero.size());
+  velocityLock->write(zero.data, zero.size());
+  // Publish the identity poses the fMi table of the inherited classes is
+  // initialized with, so that get_fMi() is valid before the first set_fMi()
+  vpHomogeneousMatrix identity;
+  std::vector<double> values(12 * size_fMi);
+  for (unsigned int i = 0; i < size_fMi; i++) {
+    for (unsigned int j = 0; j < 12; j++)
+      values[12 * i + j] = identity.data[j];
+  }
+  fMiLock->write(&values[0], 12 * size_fMi);
+#endif
+}
+
+/*!
+  Launch the thread which moves the robot. It has to be called by the
+  constructor of the inherited classes, once the robot is initialized.
+*/
+void vpRobotWireFrameSimulator::startThread()
+{
+  if (threadRunning)
+    return;
+
+  robotStop = false;
+  tcur = vpTime::measureTimeMs();
+
+#if defined(_WIN32)
+  DWORD dwThreadIdArray;
+  hThread = CreateThread(NULL,              // default security attributes
+                         0,                 // use default stack size
+                         launcher,          // thread function name
+                         this,              // argument to thread function
+                         0,                 // use default creation flags
+                         &dwThreadIdArray); // returns the thread identifier
+#elif defined(VISP_HAVE_PTHREAD)
+  pthread_create(&thread, NULL, launcher, (void *)this);
+#endif
+  threadRunning = true;
+}
+
+/*!
+  Stop the thread which moves the robot and wait for its end. It has to be
+  called by the destructor of the inherited classes.
+*/
+void vpRobotWireFrameSimulator::stopThread()
+{
+  if (!threadRunning)
+    return;
+
+  robotStop = true;
+#if defined(_WIN32)
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(hThread, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(hThread, INFINITE);
+#endif
+  CloseHandle(hThread);
+#elif defined(VISP_HAVE_PTHREAD)
+  pthread_join(thread, NULL);
+#endif
+  threadRunning = false;
+}
+
+/*!
+  Enable or disable the synchronous mode.
+
+  In synchronous mode, the thread computing the robot displacement from the
+  wall clock is stopped. The robot only moves when step() is called, by the
+  time given to step(). setPosition() computes the whole positioning motion
+  before returning, and the timestamps returned by getPosition() and
+  getVelocity() are the simulated time; see getSimulationTime().
+
+  \param synchronous : true to enable the synchronous mode, false to restart
+  the thread.
+
+  \sa step()
+*/
+void vpRobotWireFrameSimulator::setSynchronousMode(bool synchronous)
+{
+  if (synchronous) {
+    stopThread();
+    simulationTime = 0;
+  } else {
+    startThread();
+  }
+  synchronousMode = synchronous;
+}
+
+/*!
+  Move the robot by applying the current velocity during \e dt seconds. The
+  joint limits are handled like in the threaded mode and the external view is
+  updated if it is displayed.
+
+  \param dt : Simulated time in second.
+
+  \exception vpRobotException::wrongStateError : If the synchronous mode is
+  not enabled; see setSynchronousMode().
+*/
+void vpRobotWireFrameSimulator::step(double dt)
+{
+  if (!synchronousMode) {
+    throw vpRobotException(vpRobotException::wrongStateError,
+                           "Cannot step the simulation while the robot is moved by its thread");
+  }
+  setVelocityCalled = false;
+  computeArticularVelocity();
+  integrateArticularPosition(dt);
+  simulationTime += dt;
+}
+
+/*!
+  Method lauched by the thread to compute the position of the robot in the
+  articular frame from the time ellapsed since the previous iteration.
+*/
+void vpRobotWireFrameSimulator::updateArticularPosition()
+{
+  double tcur_1 = tcur; // temporary variable used to store the last time
+                        // since the last command
+
+  while (!robotStop) {
+    // Get current time
+    tprev = tcur_1;
+    tcur = vpTime::measureTimeMs();
+
+    if (setVelocityCalled || !constantSamplingTimeMode) {
+      setVelocityCalled = false;
+      computeArticularVelocity();
+
+      double ellapsedTime = (tcur - tprev) * 1e-3;
+      if (constantSamplingTimeMode) {     // if we want a constant velocity, we
+                                          // force the ellapsed time to the given
+                                          // samplingTime
+        ellapsedTime = getSamplingTime(); // in second
+      }
+
+      integrateArticularPosition(ellapsedTime);
+
+      vpTime::wait(tcur, 1000 * getSamplingTime());
+      tcur_1 = tcur;
+    } else {
+      vpTime::wait(tcur, vpTime::getMinTimeForUsleepCall());
+    }
+  }
+}
+
+#if defined(VISP_HAVE_CPP11_COMPATIBILITY)
+vpColVector vpRobotWireFrameSimulator::get_artCoord() { return artCoordLock->readVector(); }
+void vpRobotWireFrameSimulator::set_artCoord(const vpColVector &coord)
+{
+#if defined(_WIN32)
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_artCoord, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_artCoord, INFINITE);
+#endif
+  artCoord = coord;
+  artCoordLock->write(coord.data, coord.size());
+  ReleaseMutex(mutex_artCoord);
+#elif defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_lock(&mutex_artCoord);
+  artCoord = coord;
+  artCoordLock->write(coord.data, coord.size());
+  pthread_mutex_unlock(&mutex_artCoord);
+#endif
+}
+
+vpColVector vpRobotWireFrameSimulator::get_artVel() { return artVelLock->readVector(); }
+void vpRobotWireFrameSimulator::set_artVel(const vpColVector &vel)
+{
+#if defined(_WIN32)
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_artVel, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_artVel, INFINITE);
+#endif
+  artVel = vel;
+  artVelLock->write(vel.data, vel.size());
+  ReleaseMutex(mutex_artVel);
+#elif defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_lock(&mutex_artVel);
+  artVel = vel;
+  artVelLock->write(vel.data, vel.size());
+  pthread_mutex_unlock(&mutex_artVel);
+#endif
+}
+
+vpColVector vpRobotWireFrameSimulator::get_velocity() { return velocityLock->readVector(); }
+void vpRobotWireFrameSimulator::set_velocity(const vpColVector &vel)
+{
+#if defined(_WIN32)
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_velocity, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_velocity, INFINITE);
+#endif
+  velocity = vel;
+  velocityLock->write(vel.data, vel.size());
+  ReleaseMutex(mutex_velocity);
+#elif defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_lock(&mutex_velocity);
+  velocity = vel;
+  velocityLock->write(vel.data, vel.size());
+  pthread_mutex_unlock(&mutex_velocity);
+#endif
+}
+
+/*!
+  Get a table of poses between the reference frame and the frames you used
+  to compute the Denavit-Hartenberg representation.
+
+  \param fMit : Table of size_fMi poses.
+*/
+void vpRobotWireFrameSimulator::get_fMi(vpHomogeneousMatrix *fMit)
+{
+  std::vector<double> values(fMiLock->capacity());
+  unsigned int size = fMiLock->read(&values[0]) / 12;
+  for (unsigned int i = 0; i < size; i++) {
+    for (unsigned int j = 0; j < 12; j++)
+      fMit[i].data[j] = values[12 * i + j];
+  }
+}
+
+/*!
+  Set the table of poses between the reference frame and the frames you used
+  to compute the Denavit-Hartenberg representation.
+
+  \param fMit : Table of size_fMi poses.
+*/
+void vpRobotWireFrameSimulator::set_fMi(const vpHomogeneousMatrix *fMit)
+{
+  std::vector<double> values(12 * size_fMi);
+  for (unsigned int i = 0; i < size_fMi; i++) {
+    for (unsigned int j = 0; j < 12; j++)
+      values[12 * i + j] = fMit[i].data[j];
+  }
+#if defined(_WIN32)
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_fMi, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_fMi, INFINITE);
+#endif
+  for (unsigned int i = 0; i < size_fMi; i++)
+    fMi[i] = fMit[i];
+  fMiLock->write(&values[0], 12 * size_fMi);
+  ReleaseMutex(mutex_fMi);
+#elif defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_lock(&mutex_fMi);
+  for (unsigned int i = 0; i < size_fMi; i++)
+    fMi[i] = fMit[i];
+  fMiLock->write(&values[0], 12 * size_fMi);
+  pthread_mutex_unlock(&mutex_fMi);
+#endif
+}
+
+#elif defined(_WIN32)
+vpColVector vpRobotWireFrameSimulator::get_artCoord()
+{
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_artCoord, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_artCoord, INFINITE);
+#endif
+  vpColVector artCoordTmp(6);
+  artCoordTmp = artCoord;
+  ReleaseMutex(mutex_artCoord);
+  return artCoordTmp;
+}
+void vpRobotWireFrameSimulator::set_artCoord(const vpColVector &coord)
+{
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_artCoord, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_artCoord, INFINITE);
+#endif
+  artCoord = coord;
+  ReleaseMutex(mutex_artCoord);
+}
+
+vpColVector vpRobotWireFrameSimulator::get_artVel()
+{
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_artVel, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_artVel, INFINITE);
+#endif
+  vpColVector artVelTmp(artVel);
+  ReleaseMutex(mutex_artVel);
+  return artVelTmp;
+}
+void vpRobotWireFrameSimulator::set_artVel(const vpColVector &vel)
+{
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_artVel, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_artVel, INFINITE);
+#endif
+  artVel = vel;
+  ReleaseMutex(mutex_artVel);
+}
+
+vpColVector vpRobotWireFrameSimulator::get_velocity()
+{
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_velocity, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_velocity, INFINITE);
+#endif
+  vpColVector velocityTmp = velocity;
+  ReleaseMutex(mutex_velocity);
+  return velocityTmp;
+}
+void vpRobotWireFrameSimulator::set_velocity(const vpColVector &vel)
+{
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_velocity, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_velocity, INFINITE);
+#endif
+  velocity = vel;
+  ReleaseMutex(mutex_velocity);
+}
+
+void vpRobotWireFrameSimulator::get_fMi(vpHomogeneousMatrix *fMit)
+{
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_fMi, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_fMi, INFINITE);
+#endif
+  for (unsigned int i = 0; i < size_fMi; i++)
+    fMit[i] = fMi[i];
+  ReleaseMutex(mutex_fMi);
+}
+void vpRobotWireFrameSimulator::set_fMi(const vpHomogeneousMatrix *fMit)
+{
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_fMi, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_fMi, INFINITE);
+#endif
+  for (unsigned int i = 0; i < size_fMi; i++)
+    fMi[i] = fMit[i];
+  ReleaseMutex(mutex_fMi);
+}
+
+#elif defined(VISP_HAVE_PTHREAD)
+vpColVector vpRobotWireFrameSimulator::get_artCoord()
+{
+  pthread_mutex_lock(&mutex_artCoord);
+  vpColVector artCoordTmp(6);
+  artCoordTmp = artCoord;
+  pthread_mutex_unlock(&mutex_artCoord);
+  return artCoordTmp;
+}
+void vpRobotWireFrameSimulator::set_artCoord(const vpColVector &coord)
+{
+  pthread_mutex_lock(&mutex_artCoord);
+  artCoord = coord;
+  pthread_mutex_unlock(&mutex_artCoord);
+}
+
+vpColVector vpRobotWireFrameSimulator::get_artVel()
+{
+  pthread_mutex_lock(&mutex_artVel);
+  vpColVector artVelTmp(artVel);
+  pthread_mutex_unlock(&mutex_artVel);
+  return artVelTmp;
+}
+void vpRobotWireFrameSimulator::set_artVel(const vpColVector &vel)
+{
+  pthread_mutex_lock(&mutex_artVel);
+  artVel = vel;
+  pthread_mutex_unlock(&mutex_artVel);
+}
+
+vpColVector vpRobotWireFrameSimulator::get_velocity()
+{
+  pthread_mutex_lock(&mutex_velocity);
+  vpColVector velocityTmp = velocity;
+  pthread_mutex_unlock(&mutex_velocity);
+  return velocityTmp;
+}
+void vpRobotWireFrameSimulator::set_velocity(const vpColVector &vel)
+{
+  pthread_mutex_lock(&mutex_velocity);
+  velocity = vel;
+  pthread_mutex_unlock(&mutex_velocity);
+}
+
+/*!
+  Get a table of poses between the reference frame and the frames you used
+  to compute the Denavit-Hartenberg representation.
+
+  \param fMit : Table of size_fMi poses.
+*/
+void vpRobotWireFrameSimulator::get_fMi(vpHomogeneousMatrix *fMit)
+{
+  pthread_mutex_lock(&mutex_fMi);
+  for (unsigned int i = 0; i < size_fMi; i++)
+    fMit[i] = fMi[i];
+  pthread_mutex_unlock(&mutex_fMi);
+}
+
+/*!
+  Set the table of poses between the reference frame and the frames you used
+  to compute the Denavit-Hartenberg representation.
+
+  \param fMit : Table of size_fMi poses.
+*/
+void vpRobotWireFrameSimulator::set_fMi(const vpHomogeneousMatrix *fMit)
+{
+  pthread_mutex_lock(&mutex_fMi);
+  for (unsigned int i = 0; i < size_fMi; i++)
+    fMi[i] = fMit[i];
+  pthread_mutex_unlock(&mutex_fMi);
+}
+#endif
+
+#if defined(_WIN32)
+void vpRobotWireFrameSimulator::set_displayBusy(const bool &status)
+{
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_display, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_display, INFINITE);
+#endif
+  displayBusy = status;
+  ReleaseMutex(mutex_display);
+}
+bool vpRobotWireFrameSimulator::get_displayBusy()
+{
+#if defined(WINRT_8_1)
+  WaitForSingleObjectEx(mutex_display, INFINITE, FALSE);
+#else // pure win32
+  WaitForSingleObject(mutex_display, INFINITE);
+#endif
+  bool status = displayBusy;
+  if (!displayBusy)
+    displayBusy = true;
+  ReleaseMutex(mutex_display);
+  return status;
+}
+#elif defined(VISP_HAVE_PTHREAD)
+void vpRobotWireFrameSimulator::set_displayBusy(const bool &status)
+{
+  pthread_mutex_lock(&mutex_display);
+  displayBusy = status;
+  pthread_mutex_unlock(&mutex_display);
+}
+bool vpRobotWireFrameSimulator::get_displayBusy()
+{
+  pthread_mutex_lock(&mutex_display);
+  bool status = displayBusy;
+  if (!displayBusy)
+    displayBusy = true;
+  pthread_mutex_unlock(&mutex_display);
+  return status;
+}
+#endif
 
 /*!
   Initialize the display. It enables to choose the type of scene which will be
@@ -66,44 +66,8 @@ vpSimulatorAfma6::vpSimulatorAfma6()
   init();
   initDisplay();
 
-  tcur = vpTime::measureTimeMs();
-
-#if defined(_WIN32)
-#ifdef WINRT_8_1
-  mutex_fMi = CreateMutexEx(NULL, NULL, 0, NULL);
-  mutex_artVel = CreateMutexEx(NULL, NULL, 0, NULL);
-  mutex_artCoord = CreateMutexEx(NULL, NULL, 0, NULL);
-  mutex_velocity = CreateMutexEx(NULL, NULL, 0, NULL);
-  mutex_display = CreateMutexEx(NULL, NULL, 0, NULL);
-#else
-  mutex_fMi = CreateMutex(NULL, FALSE, NULL);
-  mutex_artVel = CreateMutex(NULL, FALSE, NULL);
-  mutex_artCoord = CreateMutex(NULL, FALSE, NULL);
-  mutex_velocity = CreateMutex(NULL, FALSE, NULL);
-  mutex_display = CreateMutex(NULL, FALSE, NULL);
-#endif
-
-  DWORD dwThreadIdArray;
-  hThread = CreateThread(NULL,              // default security attributes
-                         0,                 // use default stack size
-                         launcher,          // thread function name
-                         this,              // argument to thread function
-                         0,                 // use default creation flags
-                         &dwThreadIdArray); // returns the thread identifier
-#elif defined(VISP_HAVE_PTHREAD)
-  pthread_mutex_init(&mutex_fMi, NULL);
-  pthread_mutex_init(&mutex_artVel, NULL);
-  pthread_mutex_init(&mutex_artCoord, NULL);
-  pthread_mutex_init(&mutex_velocity, NULL);
-  pthread_mutex_init(&mutex_display, NULL);
-
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  pthread_create(&thread, NULL, launcher, (void *)this);
-#endif
-
   compute_fMi();
+  startThread();
 }
 
 /*!
@@ -119,44 +83,8 @@ vpSimulatorAfma6::vpSimulatorAfma6(bool do_display)
   init();
   initDisplay();
 
-  tcur = vpTime::measureTimeMs();
-
-#if defined(_WIN32)
-#ifdef WINRT_8_1
-  mutex_fMi = CreateMutexEx(NULL, NULL, 0, NULL);
-  mutex_artVel = CreateMutexEx(NULL, NULL, 0, NULL);
-  mutex_artCoord = CreateMutexEx(NULL, NULL, 0, NULL);
-  mutex_velocity = CreateMutexEx(NULL, NULL, 0, NULL);
-  mutex_display = CreateMutexEx(NULL, NULL, 0, NULL);
-#else
-  mutex_fMi = CreateMutex(NULL, FALSE, NULL);
-  mutex_artVel = CreateMutex(NULL, FALSE, NULL);
-  mutex_artCoord = CreateMutex(NULL, FALSE, NULL);
-  mutex_velocity = CreateMutex(NULL, FALSE, NULL);
-  mutex_display = CreateMutex(NULL, FALSE, NULL);
-#endif
-
-  DWORD dwThreadIdArray;
-  hThread = CreateThread(NULL,              // default security attributes
-                         0,                 // use default stack size
-                         launcher,          // thread function name
-                         this,              // argument to thread function
-                         0,                 // use default creation flags
-                         &dwThreadIdArray); // returns the thread identifier
-#elif defined(VISP_HAVE_PTHREAD)
-  pthread_mutex_init(&mutex_fMi, NULL);
-  pthread_mutex_init(&mutex_artVel, NULL);
-  pthread_mutex_init(&mutex_artCoord, NULL);
-  pthread_mutex_init(&mutex_velocity, NULL);
-  pthread_mutex_init(&mutex_display, NULL);
-
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  pthread_create(&thread, NULL, launcher, (void *)this);
-#endif
-
   compute_fMi();
+  startThread();
 }
 
 /*!
@@ -164,29 +92,7 @@ vpSimulatorAfma6::vpSimulatorAfma6(bool do_display)
 */
 vpSimulatorAfma6::~vpSimulatorAfma6()
 {
-  robotStop = true;
-
-#if defined(_WIN32)
-#if defined(WINRT_8_1)
-  WaitForSingleObjectEx(hThread, INFINITE, FALSE);
-#else // pure win32
-  WaitForSingleObject(hThread, INFINITE);
-#endif
-  CloseHandle(hThread);
-  CloseHandle(mutex_fMi);
-  CloseHandle(mutex_artVel);
-  CloseHandle(mutex_artCoord);
-  CloseHandle(mutex_velocity);
-  CloseHandle(mutex_display);
-#elif defined(VISP_HAVE_PTHREAD)
-  pthread_attr_destroy(&attr);
-  pthread_join(thread, NULL);
-  pthread_mutex_destroy(&mutex_fMi);
-  pthread_mutex_destroy(&mutex_artVel);
-  pthread_mutex_destroy(&mutex_artCoord);
-  pthread_mutex_destroy(&mutex_velocity);
-  pthread_mutex_destroy(&mutex_display);
-#endif
+  stopThread();
 
   if (robotArms != NULL) {
     for (int i = 0; i < 6; i++)
@@ -242,8 +148,8 @@ void vpSimulatorAfma6::init()
   reposPos[2] = M_PI;
   reposPos[4] = M_PI / 2;
 
-  artCoord = zeroPos;
-  artVel = 0;
+  set_artCoord(zeroPos);
+  set_artVel(vpColVector(njoint, 0.));
 
   q_prev_getdis.resize(njoint);
   q_prev_getdis = 0;
@@ -495,126 +401,103 @@ void vpSimulatorAfma6::setCameraParameters(const vpCameraParameters &cam)
 }
 
 /*!
-  Method lauched by the thread to compute the position of the robot in the
-  articular frame.
+  Move the robot in the articular frame by applying the joint velocities
+  during \e ellapsedTime seconds, stopping at the joint limits, and update
+  the frame poses and the external view.
+
+  \param ellapsedTime : Time in second during which the joint velocities are
+  applied.
 */
-void vpSimulatorAfma6::updateArticularPosition()
+void vpSimulatorAfma6::integrateArticularPosition(double ellapsedTime)
 {
-  double tcur_1 = tcur; // temporary variable used to store the last time
-                        // since the last command
-
-  while (!robotStop) {
-    // Get current time
-    tprev = tcur_1;
-    tcur = vpTime::measureTimeMs();
-
-    if (setVelocityCalled || !constantSamplingTimeMode) {
-      setVelocityCalled = false;
-
-      computeArticularVelocity();
-
-      double ellapsedTime = (tcur - tprev) * 1e-3;
-      if (constantSamplingTimeMode) {     // if we want a constant velocity, we
-                                          // force the ellapsed time to the given
-                                          // samplingTime
-        ellapsedTime = getSamplingTime(); // in second
-      }
-
-      vpColVector articularCoordinates = get_artCoord();
-      vpColVector articularVelocities = get_artVel();
-
-      if (jointLimit) {
-        double art = articularCoordinates[jointLimitArt - 1] + ellapsedTime * articularVelocities[jointLimitArt - 1];
-        if (art <= _joint_min[jointLimitArt - 1] || art >= _joint_max[jointLimitArt - 1]) {
-          if (verbose_) {
-            std::cout << "Joint " << jointLimitArt - 1
-                      << " reaches a limit: " << vpMath::deg(_joint_min[jointLimitArt - 1]) << " < " << vpMath::deg(art)
-                      << " < " << vpMath::deg(_joint_max[jointLimitArt - 1]) << std::endl;
-          }
-
-          articularVelocities = 0.0;
-        } else
-          jointLimit = false;
+  vpColVector articularCoordinates = get_artCoord();
+  vpColVector articularVelocities = get_artVel();
+
+  if (jointLimit) {
+    double art = articularCoordinates[jointLimitArt - 1] + ellapsedTime * articularVelocities[jointLimitArt - 1];
+    if (art <= _joint_min[jointLimitArt - 1] || art >= _joint_max[jointLimitArt - 1]) {
+      if (verbose_) {
+        std::cout << "Joint " << jointLimitArt - 1
+                  << " reaches a limit: " << vpMath::deg(_joint_min[jointLimitArt - 1]) << " < " << vpMath::deg(art)
+                  << " < " << vpMath::deg(_joint_max[jointLimitArt - 1]) << std::endl;
       }
 
-      articularCoordinates[0] = articularCoordinates[0] + ellapsedTime * articularVelocities[0];
-      articularCoordinates[1] = articularCoordinates[1] + ellapsedTime * articularVelocities[1];
-      articularCoordinates[2] = articularCoordinates[2] + ellapsedTime * articularVelocities[2];
-      articularCoordinates[3] = articularCoordinates[3] + ellapsedTime * articularVelocities[3];
-      articularCoordinates[4] = articularCoordinates[4] + ellapsedTime * articularVelocities[4];
-      articularCoordinates[5] = articularCoordinates[5] + ellapsedTime * articularVelocities[5];
-
-      int jl = isInJointLimit();
+      articularVelocities = 0.0;
+    } else
+      jointLimit = false;
+  }
 
-      if (jl != 0 && jointLimit == false) {
-        if (jl < 0)
-          ellapsedTime = (_joint_min[(unsigned int)(-jl - 1)] - articularCoordinates[(unsigned int)(-jl - 1)]) /
-                         (articularVelocities[(unsigned int)(-jl - 1)]);
-        else
-          ellapsedTime = (_joint_max[(unsigned int)(jl - 1)] - articularCoordinates[(unsigned int)(jl - 1)]) /
-                         (articularVelocities[(unsigned int)(jl - 1)]);
+  articularCoordinates[0] = articularCoordinates[0] + ellapsedTime * articularVelocities[0];
+  articularCoordinates[1] = articularCoordinates[1] + ellapsedTime * articularVelocities[1];
+  articularCoordinates[2] = articularCoordinates[2] + ellapsedTime * articularVelocities[2];
+  articularCoordinates[3] = articularCoordinates[3] + ellapsedTime * articularVelocities[3];
+  articularCoordinates[4] = articularCoordinates[4] + ellapsedTime * articularVelocities[4];
+  articularCoordinates[5] = articularCoordinates[5] + ellapsedTime * articularVelocities[5];
 
-        for (unsigned int i = 0; i < 6; i++)
-          articularCoordinates[i] = articularCoordinates[i] + ellapsedTime * articularVelocities[i];
+  int jl = isInJointLimit();
 
-        jointLimit = true;
-        jointLimitArt = (unsigned int)fabs((double)jl);
-      }
+  if (jl != 0 && jointLimit == false) {
+    if (jl < 0)
+      ellapsedTime = (_joint_min[(unsigned int)(-jl - 1)] - articularCoordinates[(unsigned int)(-jl - 1)]) /
+                     (articularVelocities[(unsigned int)(-jl - 1)]);
+    else
+      ellapsedTime = (_joint_max[(unsigned int)(jl - 1)] - articularCoordinates[(unsigned int)(jl - 1)]) /
+                     (articularVelocities[(unsigned int)(jl - 1)]);
 
-      set_artCoord(articularCoordinates);
-      set_artVel(articularVelocities);
+    for (unsigned int i = 0; i < 6; i++)
+      articularCoordinates[i] = articularCoordinates[i] + ellapsedTime * articularVelocities[i];
 
-      compute_fMi();
+    jointLimit = true;
+    jointLimitArt = (unsigned int)fabs((double)jl);
+  }
 
-      if (displayAllowed) {
-        vpDisplay::display(I);
-        vpDisplay::displayFrame(I, getExternalCameraPosition(), cameraParam, 0.2, vpColor::none, thickness_);
-        vpDisplay::displayFrame(I, getExternalCameraPosition() * fMi[7], cameraParam, 0.1, vpColor::none, thickness_);
-      }
+  set_artCoord(articularCoordinates);
+  set_artVel(articularVelocities);
 
-      if (displayType == MODEL_3D && displayAllowed) {
-        while (get_displayBusy())
-          vpTime::wait(2);
-        vpSimulatorAfma6::getExternalImage(I);
-        set_displayBusy(false);
-      }
+  compute_fMi();
 
-      if (0 /*displayType == MODEL_DH && displayAllowed*/) {
-        vpHomogeneousMatrix fMit[8];
-        get_fMi(fMit);
+  if (displayAllowed) {
+    vpDisplay::display(I);
+    vpDisplay::displayFrame(I, getExternalCameraPosition(), cameraParam, 0.2, vpColor::none, thickness_);
+    vpDisplay::displayFrame(I, getExternalCameraPosition() * fMi[7], cameraParam, 0.1, vpColor::none, thickness_);
+  }
 
-        // vpDisplay::displayFrame(I,getExternalCameraPosition
-        // ()*fMi[6],cameraParam,0.2,vpColor::none);
+  if (displayType == MODEL_3D && displayAllowed) {
+    while (get_displayBusy())
+      vpTime::wait(2);
+    vpSimulatorAfma6::getExternalImage(I);
+    set_displayBusy(false);
+  }
 
-        vpImagePoint iP, iP_1;
-        vpPoint pt(0, 0, 0);
+  if (0 /*displayType == MODEL_DH && displayAllowed*/) {
+    vpHomogeneousMatrix fMit[8];
+    get_fMi(fMit);
 
-        pt.track(getExternalCameraPosition());
-        vpMeterPixelConversion::convertPoint(cameraParam, pt.get_x(), pt.get_y(), iP_1);
-        pt.track(getExternalCameraPosition() * fMit[0]);
-        vpMeterPixelConversion::convertPoint(cameraParam, pt.get_x(), pt.get_y(), iP);
-        vpDisplay::displayLine(I, iP_1, iP, vpColor::green, thickness_);
-        for (unsigned int k = 1; k < 7; k++) {
-          pt.track(getExternalCameraPosition() * fMit[k - 1]);
-          vpMeterPixelConversion::convertPoint(cameraParam, pt.get_x(), pt.get_y(), iP_1);
+    // vpDisplay::displayFrame(I,getExternalCameraPosition
+    // ()*fMi[6],cameraParam,0.2,vpColor::none);
 
-          pt.track(getExternalCameraPosition() * fMit[k]);
-          vpMeterPixelConversion::convertPoint(cameraParam, pt.get_x(), pt.get_y(), iP);
+    vpImagePoint iP, iP_1;
+    vpPoint pt(0, 0, 0);
 
-          vpDisplay::displayLine(I, iP_1, iP, vpColor::green, thickness_);
-        }
-        vpDisplay::displayCamera(I, getExternalCameraPosition() * fMit[7], cameraParam, 0.1, vpColor::green,
-                                 thickness_);
-      }
+    pt.track(getExternalCameraPosition());
+    vpMeterPixelConversion::convertPoint(cameraParam, pt.get_x(), pt.get_y(), iP_1);
+    pt.track(getExternalCameraPosition() * fMit[0]);
+    vpMeterPixelConversion::convertPoint(cameraParam, pt.get_x(), pt.get_y(), iP);
+    vpDisplay::displayLine(I, iP_1, iP, vpColor::green, thickness_);
+    for (unsigned int k = 1; k < 7; k++) {
+      pt.track(getExternalCameraPosition() * fMit[k - 1]);
+      vpMeterPixelConversion::convertPoint(cameraParam, pt.get_x(), pt.get_y(), iP_1);
 
-      vpDisplay::flush(I);
+      pt.track(getExternalCameraPosition() * fMit[k]);
+      vpMeterPixelConversion::convertPoint(cameraParam, pt.get_x(), pt.get_y(), iP);
 
-      vpTime::wait(tcur, 1000 * getSamplingTime());
-      tcur_1 = tcur;
-    } else {
-      vpTime::wait(tcur, vpTime::getMinTimeForUsleepCall());
+      vpDisplay::displayLine(I, iP_1, iP, vpColor::green, thickness_);
     }
+    vpDisplay::displayCamera(I, getExternalCameraPosition() * fMit[7], cameraParam, 0.1, vpColor::green,
+                             thickness_);
   }
+
+  vpDisplay::flush(I);
 }
 
 /*!
@@ -749,21 +632,7 @@ void vpSimulatorAfma6::compute_fMi()
   //   fMit[7] = fMit[6] * cMe;
   vpAfma6::get_fMc(q, fMit[7]);
 
-#if defined(_WIN32)
-#if defined(WINRT_8_1)
-  WaitForSingleObjectEx(mutex_fMi, INFINITE, FALSE);
-#else // pure win32
-  WaitForSingleObject(mutex_fMi, INFINITE);
-#endif
-  for (int i = 0; i < 8; i++)
-    fMi[i] = fMit[i];
-  ReleaseMutex(mutex_fMi);
-#elif defined(VISP_HAVE_PTHREAD)
-  pthread_mutex_lock(&mutex_fMi);
-  for (int i = 0; i < 8; i++)
-    fMi[i] = fMit[i];
-  pthread_mutex_unlock(&mutex_fMi);
-#endif
+  set_fMi(fMit);
 }
 
 /*!
@@ -1156,7 +1025,7 @@ void vpSimulatorAfma6::getVelocity(const vpRobot::vpControlFrameType frame, vpCo
 */
 void vpSimulatorAfma6::getVelocity(const vpRobot::vpControlFrameType frame, vpColVector &vel, double &timestamp)
 {
-  timestamp = vpTime::measureTimeSecond();
+  timestamp = synchronousMode ? simulationTime : vpTime::measureTimeSecond();
   getVelocity(frame, vel);
 }
 
@@ -1224,7 +1093,7 @@ vpColVector vpSimulatorAfma6::getVelocity(vpRobot::vpControlFrameType frame)
 */
 vpColVector vpSimulatorAfma6::getVelocity(vpRobot::vpControlFrameType frame, double &timestamp)
 {
-  timestamp = vpTime::measureTimeSecond();
+  timestamp = synchronousMode ? simulationTime : vpTime::measureTimeSecond();
   vpColVector vel(6);
   getVelocity(frame, vel);
 
@@ -1372,6 +1241,10 @@ void vpSimulatorAfma6::setPosition(const vpRobot::vpControlFrameType frame, cons
         vpERROR_TRACE("Positionning error.");
         throw vpRobotException(vpRobotException::positionOutOfRangeError, "Position out of range.");
       }
+      if (synchronousMode) {
+        integrateArticularPosition(getSamplingTime());
+        simulationTime += getSamplingTime();
+      }
     } while (errsqr > 1e-8 && nbSol > 0);
 
     break;
@@ -1392,6 +1265,10 @@ void vpSimulatorAfma6::setPosition(const vpRobot::vpControlFrameType frame, cons
         set_velocity(error);
         break;
       }
+      if (synchronousMode) {
+        integrateArticularPosition(getSamplingTime());
+        simulationTime += getSamplingTime();
+      }
     } while (errsqr > 1e-8);
     break;
   }
@@ -1429,6 +1306,10 @@ void vpSimulatorAfma6::setPosition(const vpRobot::vpControlFrameType frame, cons
         }
       } else
         vpERROR_TRACE("Positionning error. Position unreachable");
+      if (synchronousMode) {
+        integrateArticularPosition(getSamplingTime());
+        simulationTime += getSamplingTime();
+      }
     } while (errsqr > 1e-8 && nbSol > 0);
     break;
   }
@@ -1443,6 +1324,9 @@ void vpSimulatorAfma6::setPosition(const vpRobot::vpControlFrameType frame, cons
                                                             "END_EFFECTOR_FRAME not implemented.");
   }
   }
+
+  if (synchronousMode)
+    compute_fMi();
 }
 
 /*!
@@ -1709,7 +1593,7 @@ void vpSimulatorAfma6::getPosition(const vpRobot::vpControlFrameType frame, vpCo
  */
 void vpSimulatorAfma6::getPosition(const vpRobot::vpControlFrameType frame, vpColVector &q, double &timestamp)
 {
-  timestamp = vpTime::measureTimeSecond();
+  timestamp = synchronousMode ? simulationTime : vpTime::measureTimeSecond();
   getPosition(frame, q);
 }
 
@@ -1753,7 +1637,7 @@ void vpSimulatorAfma6::getPosition(const vpRobot::vpControlFrameType frame, vpPo
  */
 void vpSimulatorAfma6::getPosition(const vpRobot::vpControlFrameType frame, vpPoseVector &position, double &timestamp)
 {
-  timestamp = vpTime::measureTimeSecond();
+  timestamp = synchronousMode ? simulationTime : vpTime::measureTimeSecond();
   getPosition(frame, position);
 }
 
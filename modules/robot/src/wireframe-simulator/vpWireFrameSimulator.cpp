@@ -41,6 +41,8 @@
   \brief Implementation of a wire frame simulator.
 */
 
+#include <algorithm>
+#include <cstdlib>
 #include <fcntl.h>
 #include <stdio.h>
 #include <string.h>
@@ -66,12 +68,213 @@
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMath.h>
 #include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/core/vpPoint.h>
 
 extern Point2i *point2i;
 extern Point2i *listpoint2i;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Smallest depth of a point drawn by the headless renderer.
+const double vpWireFrameNearPlane = 1e-3;
+
+/*
+  A scene to render with the pose of its frame in the camera frame
+  (standard camera convention, without the internal rotz flip).
+*/
+struct vpWireFrameItem {
+  vpWireFrameItem(const Bound_scene &sc, const vpHomogeneousMatrix &M, const vpColor &c)
+    : scene(&sc), cMs(M), color(c)
+  {
+  }
+  const Bound_scene *scene;
+  vpHomogeneousMatrix cMs;
+  vpColor color;
+};
+
+/*
+  Vertices of a bound in homogeneous image coordinates (x, y, w), with
+  u = x / w and v = y / w. Stored as separate arrays so that the transform
+  is a single loop the compiler can vectorize.
+*/
+struct vpWireFrameBuffer {
+  std::vector<double> x, y, w;
+};
+
+inline void wireFrameValue(const vpColor &color, unsigned char &value)
+{
+  value = (unsigned char)(0.2126 * color.R + 0.7152 * color.G + 0.0722 * color.B);
+}
+
+inline void wireFrameValue(const vpColor &color, vpRGBa &value) { value = vpRGBa(color.R, color.G, color.B, color.A); }
+
+/*
+  Liang-Barsky clipping of the segment [P0, P1] given in homogeneous image
+  coordinates against w > near, 0 <= x <= umax w and 0 <= y <= vmax w. Each
+  constraint is linear in P so it is evaluated at both ends and the
+  parameter range [t0, t1] is shrunk accordingly.
+*/
+bool wireFrameClip(double &x0, double &y0, double &w0, double &x1, double &y1, double &w1, double umax, double vmax)
+{
+  const double f0[5] = {w0 - vpWireFrameNearPlane, x0, umax * w0 - x0, y0, vmax * w0 - y0};
+  const double f1[5] = {w1 - vpWireFrameNearPlane, x1, umax * w1 - x1, y1, vmax * w1 - y1};
+  double t0 = 0., t1 = 1.;
+
+  for (unsigned int k = 0; k < 5; k++) {
+    if (f0[k] < 0. && f1[k] < 0.)
+      return false;
+    if (f0[k] < 0.)
+      t0 = (std::max)(t0, f0[k] / (f0[k] - f1[k]));
+    else if (f1[k] < 0.)
+      t1 = (std::min)(t1, f0[k] / (f0[k] - f1[k]));
+    if (t0 > t1)
+      return false;
+  }
+
+  const double dx = x1 - x0, dy = y1 - y0, dw = w1 - w0;
+  if (t1 < 1.) {
+    x1 = x0 + t1 * dx;
+    y1 = y0 + t1 * dy;
+    w1 = w0 + t1 * dw;
+  }
+  if (t0 > 0.) {
+    x0 += t0 * dx;
+    y0 += t0 * dy;
+    w0 += t0 * dw;
+  }
+  return true;
+}
+
+template <class Type> inline void wireFramePlot(vpImage<Type> &I, int u, int v, const Type &value, int thickness)
+{
+  if (thickness <= 1) {
+    I[v][u] = value;
+    return;
+  }
+  const int offset = (thickness - 1) / 2;
+  const int imin = (std::max)(v - offset, 0), imax = (std::min)(v - offset + thickness, (int)I.getHeight());
+  const int jmin = (std::max)(u - offset, 0), jmax = (std::min)(u - offset + thickness, (int)I.getWidth());
+  for (int i = imin; i < imax; i++) {
+    Type *row = I[i];
+    for (int j = jmin; j < jmax; j++)
+      row[j] = value;
+  }
+}
+
+// Bresenham rasterization of a segment whose ends are inside the image.
+template <class Type>
+void wireFrameLine(vpImage<Type> &I, int u0, int v0, int u1, int v1, const Type &value, int thickness)
+{
+  const int du = std::abs(u1 - u0), dv = -std::abs(v1 - v0);
+  const int su = u0 < u1 ? 1 : -1, sv = v0 < v1 ? 1 : -1;
+  int err = du + dv;
+
+  for (;;) {
+    wireFramePlot(I, u0, v0, value, thickness);
+    if (u0 == u1 && v0 == v1)
+      break;
+    const int e2 = 2 * err;
+    if (e2 >= dv) {
+      err += dv;
+      u0 += su;
+    }
+    if (e2 <= du) {
+      err += du;
+      v0 += sv;
+    }
+  }
+}
+
+inline int wireFrameCoord(double x, double w, int max)
+{
+  int c = vpMath::round(x / w);
+  return c < 0 ? 0 : (c > max ? max : c);
+}
+
+/*
+  Render a scene in I. The vertices of every bound are first projected with
+  P = K [R t] in one pass; faces are then back-face culled using the sign of
+  det(P0, P1, Pn) which is the orientation of the projected contour when all
+  three points are in front of the camera, and every edge is clipped in
+  homogeneous coordinates before being rasterized.
+*/
+template <class Type>
+void wireFrameRender(vpImage<Type> &I, const vpWireFrameItem &item, const vpCameraParameters &cam, bool cull,
+                     int thickness, vpWireFrameBuffer &buffer)
+{
+  if (I.getWidth() == 0 || I.getHeight() == 0)
+    return;
+
+  const vpHomogeneousMatrix &M = item.cMs;
+  const double px = cam.get_px(), py = cam.get_py(), u0 = cam.get_u0(), v0 = cam.get_v0();
+  double P[3][4];
+  for (unsigned int j = 0; j < 4; j++) {
+    P[0][j] = px * M[0][j] + u0 * M[2][j];
+    P[1][j] = py * M[1][j] + v0 * M[2][j];
+    P[2][j] = M[2][j];
+  }
+  const int umax = (int)I.getWidth() - 1, vmax = (int)I.getHeight() - 1;
+  Type value;
+  wireFrameValue(item.color, value);
+
+  const Bound *bp = item.scene->bound.ptr;
+  const Bound *bend = bp + item.scene->bound.nbr;
+  for (; bp < bend; bp++) {
+    const Index n = bp->point.nbr;
+    if (n == 0)
+      continue;
+    buffer.x.resize(n);
+    buffer.y.resize(n);
+    buffer.w.resize(n);
+    const Point3f *pt = bp->point.ptr;
+    double *x = &buffer.x[0], *y = &buffer.y[0], *w = &buffer.w[0];
+    for (Index i = 0; i < n; i++) {
+      const double X = pt[i].x, Y = pt[i].y, Z = pt[i].z;
+      x[i] = P[0][0] * X + P[0][1] * Y + P[0][2] * Z + P[0][3];
+      y[i] = P[1][0] * X + P[1][1] * Y + P[1][2] * Z + P[1][3];
+      w[i] = P[2][0] * X + P[2][1] * Y + P[2][2] * Z + P[2][3];
+    }
+
+    const Face *fp = bp->face.ptr;
+    const Face *fend = fp + bp->face.nbr;
+    for (; fp < fend; fp++) {
+      const Index nbr = fp->vertex.nbr;
+      const Index *vp = fp->vertex.ptr;
+      if (nbr < 2)
+        continue;
+      if (cull && nbr > 2) {
+        const Index a = vp[0], b = vp[1], c = vp[nbr - 1];
+        const double det = x[a] * (y[b] * w[c] - w[b] * y[c]) - y[a] * (x[b] * w[c] - w[b] * x[c]) +
+                           w[a] * (x[b] * y[c] - y[b] * x[c]);
+        if (det > 0.)
+          continue;
+      }
+      const Index nedges = (nbr > 2) ? nbr : 1;
+      for (Index k = 0; k < nedges; k++) {
+        const Index i0 = vp[k], i1 = vp[(k + 1) % nbr];
+        double x0 = x[i0], y0 = y[i0], w0 = w[i0], x1 = x[i1], y1 = y[i1], w1 = w[i1];
+        if (wireFrameClip(x0, y0, w0, x1, y1, w1, umax, vmax))
+          wireFrameLine(I, wireFrameCoord(x0, w0, umax), wireFrameCoord(y0, w0, vmax), wireFrameCoord(x1, w1, umax),
+                        wireFrameCoord(y1, w1, vmax), value, thickness);
+      }
+    }
+  }
+}
+
+template <class Type>
+void wireFrameRender(vpImage<Type> &I, const std::vector<vpWireFrameItem> &items, const vpCameraParameters &cam,
+                     bool cull, unsigned int thickness)
+{
+  vpWireFrameBuffer buffer;
+  for (size_t i = 0; i < items.size(); i++)
+    wireFrameRender(I, items[i], cam, cull, (int)thickness, buffer);
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*
   Copy the scene corresponding to the registeresd parameters in the image.
 */
@@ -1249,6 +1452,186 @@ void vpWireFrameSimulator::getExternalImage(vpImage<unsigned char> &I, const vpH
     display_scene(w44c, camera, I, camColor);
 }
 
+/*!
+  Render the scene seen from \e pose in the image pixels. When \e internal is
+  true, \e pose is the camera to object pose of the main camera, otherwise it
+  is the pose of an external camera relative to the world frame.
+*/
+template <class Type>
+void vpWireFrameSimulator::render(vpImage<Type> &I, const vpHomogeneousMatrix &pose, bool internal,
+                                  std::list<vpImageSimulator> &objects) const
+{
+  vpCameraParameters cam = internal ? getInternalCameraParameters(I) : getExternalCameraParameters(I);
+  vpHomogeneousMatrix cMo_ = internal ? pose : pose * fMo;
+
+  if (displayImageSimulator) {
+    I = 255;
+    for (std::list<vpImageSimulator>::iterator it = objects.begin(); it != objects.end(); ++it) {
+      it->setCameraPosition(cMo_);
+      it->getImage(I, cam);
+    }
+  }
+
+  std::vector<vpWireFrameItem> items;
+  if (displayObject)
+    items.push_back(vpWireFrameItem(scene, cMo_, curColor));
+  if (internal) {
+    if (displayDesiredObject) {
+      if (desiredObject == D_TOOL)
+        items.push_back(vpWireFrameItem(desiredScene, rotz, vpColor::red));
+      else
+        items.push_back(vpWireFrameItem(desiredScene, rotz * cdMo, desColor));
+    }
+  } else if (displayCamera)
+    items.push_back(vpWireFrameItem(camera, pose * fMc, camColor));
+
+  wireFrameRender(I, items, cam, (*get_rfstack() & IS_BACK) != 0, thickness_);
+}
+
+/*!
+  Render one image per pose. Each view is independent so they are rendered
+  in parallel when OpenMP is available.
+*/
+template <class Type>
+void vpWireFrameSimulator::renderBatch(std::vector<vpImage<Type> > &I, const std::vector<vpHomogeneousMatrix> &poses,
+                                       bool internal) const
+{
+  if (!sceneInitialized)
+    throw(vpException(vpException::notInitialized, "The scene has to be initialized"));
+  if (I.size() != poses.size())
+    throw(vpException(vpException::dimensionError, "Cannot render %d poses in %d images", (int)poses.size(),
+                      (int)I.size()));
+
+  int size = (int)poses.size();
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = 0; i < size; i++) {
+    std::list<vpImageSimulator> objects;
+    if (displayImageSimulator)
+      objects = objectImage;
+    render(I[(size_t)i], poses[(size_t)i], internal, objects);
+  }
+}
+
+/*!
+  Render the internal view, ie the view of the main camera, directly in the
+  image pixels. Contrary to getInternalImage(), no display is needed.
+
+  The current and desired objects are drawn over the content of \e I, or
+  over the image simulator objects when they are displayed.
+
+  \param I : The image where the internal view is rendered.
+*/
+void vpWireFrameSimulator::renderInternalImage(vpImage<unsigned char> &I)
+{
+  if (!sceneInitialized)
+    throw(vpException(vpException::notInitialized, "The scene has to be initialized"));
+  render(I, rotz * cMo, true, objectImage);
+}
+
+/*!
+  Render the internal view, ie the view of the main camera, directly in the
+  image pixels. Contrary to getInternalImage(), no display is needed.
+
+  The current and desired objects are drawn over the content of \e I, or
+  over the image simulator objects when they are displayed.
+
+  \param I : The image where the internal view is rendered.
+*/
+void vpWireFrameSimulator::renderInternalImage(vpImage<vpRGBa> &I)
+{
+  if (!sceneInitialized)
+    throw(vpException(vpException::notInitialized, "The scene has to be initialized"));
+  render(I, rotz * cMo, true, objectImage);
+}
+
+/*!
+  Render the view of the main camera for several camera poses. The images are
+  rendered in parallel when OpenMP is available.
+
+  \param I : The images where the views are rendered. They must be allocated
+  and have the same size as \e cMo.
+  \param cMo : The poses between the camera and the object.
+*/
+void vpWireFrameSimulator::renderInternalImages(std::vector<vpImage<unsigned char> > &I,
+                                                const std::vector<vpHomogeneousMatrix> &cMo)
+{
+  renderBatch(I, cMo, true);
+}
+
+/*!
+  Render the view of the main camera for several camera poses. The images are
+  rendered in parallel when OpenMP is available.
+
+  \param I : The images where the views are rendered. They must be allocated
+  and have the same size as \e cMo.
+  \param cMo : The poses between the camera and the object.
+*/
+void vpWireFrameSimulator::renderInternalImages(std::vector<vpImage<vpRGBa> > &I,
+                                                const std::vector<vpHomogeneousMatrix> &cMo)
+{
+  renderBatch(I, cMo, true);
+}
+
+/*!
+  Render the external view set with setExternalCameraPosition() directly in
+  the image pixels. Contrary to getExternalImage(), no display is needed, the
+  view can not be moved with the mouse and the camera trajectory is not
+  drawn.
+
+  \param I : The image where the external view is rendered.
+*/
+void vpWireFrameSimulator::renderExternalImage(vpImage<unsigned char> &I)
+{
+  if (!sceneInitialized)
+    throw(vpException(vpException::notInitialized, "The scene has to be initialized"));
+  render(I, rotz * camMf, false, objectImage);
+}
+
+/*!
+  Render the external view set with setExternalCameraPosition() directly in
+  the image pixels. Contrary to getExternalImage(), no display is needed, the
+  view can not be moved with the mouse and the camera trajectory is not
+  drawn.
+
+  \param I : The image where the external view is rendered.
+*/
+void vpWireFrameSimulator::renderExternalImage(vpImage<vpRGBa> &I)
+{
+  if (!sceneInitialized)
+    throw(vpException(vpException::notInitialized, "The scene has to be initialized"));
+  render(I, rotz * camMf, false, objectImage);
+}
+
+/*!
+  Render the scene seen from several external cameras. The images are
+  rendered in parallel when OpenMP is available.
+
+  \param I : The images where the views are rendered. They must be allocated
+  and have the same size as \e cMf.
+  \param cMf : The poses between the external cameras and the world frame.
+*/
+void vpWireFrameSimulator::renderExternalImages(std::vector<vpImage<unsigned char> > &I,
+                                                const std::vector<vpHomogeneousMatrix> &cMf)
+{
+  renderBatch(I, cMf, false);
+}
+
+/*!
+  Render the scene seen from several external cameras. The images are
+  rendered in parallel when OpenMP is available.
+
+  \param I : The images where the views are rendered. They must be allocated
+  and have the same size as \e cMf.
+  \param cMf : The poses between the external cameras and the world frame.
+*/
+void vpWireFrameSimulator::renderExternalImages(std::vector<vpImage<vpRGBa> > &I,
+                                                const std::vector<vpHomogeneousMatrix> &cMf)
+{
+  renderBatch(I, cMf, false);
+}
+
 /*!
   Display a trajectory thanks to a list of homogeneous matrices which give the
   position of the camera relative to the object and the position of the object
@@ -0,0 +1,172 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the rendering of textured planes with vpImageSimulator.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageSimulator.cpp
+  \brief Compares the images rendered by vpImageSimulator without distortion
+  to the per pixel rendering obtained with a camera model that has distortion
+  parameters equal to zero.
+*/
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/robot/vpImageSimulator.h>
+
+#include <iostream>
+#include <list>
+#include <stdlib.h>
+
+namespace
+{
+void buildTexture(vpImage<vpRGBa> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = vpRGBa((unsigned char)(4 * i), (unsigned char)(255 - 3 * j),
+                       (unsigned char)(((i / 8 + j / 8) % 2) * 200));
+    }
+  }
+}
+
+void initSimulator(vpImageSimulator &sim, const vpImage<vpRGBa> &texture, double z)
+{
+  vpColVector X[4];
+  for (unsigned int i = 0; i < 4; i++)
+    X[i].resize(3);
+  double x[4] = {-0.1, 0.1, 0.1, -0.1};
+  double y[4] = {-0.1, -0.1, 0.1, 0.1};
+  for (unsigned int i = 0; i < 4; i++) {
+    X[i][0] = x[i];
+    X[i][1] = y[i];
+    X[i][2] = z;
+  }
+  sim.init(texture, X);
+}
+
+unsigned int diff(const unsigned char &a, const unsigned char &b) { return (unsigned int)std::abs((int)a - (int)b); }
+unsigned int diff(const vpRGBa &a, const vpRGBa &b)
+{
+  return std::max(diff(a.R, b.R), std::max(diff(a.G, b.G), diff(a.B, b.B)));
+}
+
+// Compares two images and returns false if too many pixels differ
+template <class Type> bool compare(const vpImage<Type> &I, const vpImage<Type> &I_ref, const std::string &name)
+{
+  unsigned int nb_diff = 0;
+  for (unsigned int k = 0; k < I.getSize(); k++) {
+    // Bilinear interpolation is done with 8 bits weights
+    if (diff(I.bitmap[k], I_ref.bitmap[k]) > 2)
+      nb_diff++;
+  }
+  std::cout << name << ": " << nb_diff << " different pixels" << std::endl;
+  // Differences are only allowed on the borders of the plane and of the texels
+  return nb_diff < I.getSize() / 100;
+}
+}
+
+int main()
+{
+  try {
+    vpImage<vpRGBa> texture(60, 80);
+    buildTexture(texture);
+
+    vpCameraParameters cam(600., 610., 160., 120.);
+    vpCameraParameters cam_ref;
+    cam_ref.initPersProjWithDistortion(600., 610., 160., 120., 0., 0.);
+
+    vpHomogeneousMatrix cMo(0.02, -0.01, 0.4, vpMath::rad(20), vpMath::rad(-30), vpMath::rad(10));
+
+    for (int interp = 0; interp < 2; interp++) {
+      std::string suffix = (interp == 0 ? " simple" : " bilinear");
+      vpImageSimulator sim(vpImageSimulator::COLORED);
+      initSimulator(sim, texture, 0.);
+      sim.setInterpolationType(interp == 0 ? vpImageSimulator::SIMPLE : vpImageSimulator::BILINEAR_INTERPOLATION);
+      sim.setCleanPreviousImage(true, vpColor::black);
+      sim.setCameraPosition(cMo);
+
+      vpImage<vpRGBa> Ic(240, 320), Ic_ref(240, 320);
+      sim.getImage(Ic, cam);
+      sim.getImage(Ic_ref, cam_ref);
+      if (!compare(Ic, Ic_ref, "color" + suffix))
+        return EXIT_FAILURE;
+      unsigned int nb_rendered = 0;
+      for (unsigned int k = 0; k < Ic.getSize(); k++) {
+        if (Ic.bitmap[k].R != 0 || Ic.bitmap[k].G != 0 || Ic.bitmap[k].B != 0)
+          nb_rendered++;
+      }
+      if (nb_rendered < Ic.getSize() / 10) {
+        std::cerr << "The plane is not rendered" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      vpImage<unsigned char> Ig(240, 320), Ig_ref(240, 320);
+      sim.getImage(Ig, cam);
+      sim.getImage(Ig_ref, cam_ref);
+      if (!compare(Ig, Ig_ref, "gray" + suffix))
+        return EXIT_FAILURE;
+    }
+
+    // Two planes at different depths
+    std::list<vpImageSimulator> list;
+    vpImageSimulator sim1, sim2;
+    initSimulator(sim1, texture, 0.);
+    initSimulator(sim2, texture, 0.);
+    sim1.setCameraPosition(cMo);
+    sim2.setCameraPosition(vpHomogeneousMatrix(0.05, 0.03, 0.3, 0, vpMath::rad(10), 0));
+    list.push_back(sim1);
+    list.push_back(sim2);
+
+    vpImage<vpRGBa> Il(240, 320, vpRGBa(0)), Il_ref(240, 320, vpRGBa(0));
+    vpImageSimulator::getImage(Il, list, cam);
+    vpImageSimulator::getImage(Il_ref, list, cam_ref);
+    if (!compare(Il, Il_ref, "list"))
+      return EXIT_FAILURE;
+
+    // Same scene with a shared z-buffer
+    vpImage<vpRGBa> Iz(240, 320, vpRGBa(0));
+    vpMatrix zBuffer(240, 320, -1.);
+    sim2.getImage(Iz, cam, zBuffer);
+    sim1.getImage(Iz, cam, zBuffer);
+    if (!compare(Iz, Il_ref, "z-buffer"))
+      return EXIT_FAILURE;
+
+    std::cout << "testImageSimulator is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
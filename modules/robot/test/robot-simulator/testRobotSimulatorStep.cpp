@@ -0,0 +1,177 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test the synchronous stepping mode of the robot simulators.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testRobotSimulatorStep.cpp
+  \brief Checks that the robot simulators moved by step() are deterministic
+  and integrate the joint velocities over the simulated time.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#include <iostream>
+#include <stdlib.h>
+
+#if defined(VISP_HAVE_MODULE_GUI) && ((defined(_WIN32) && !defined(WINRT_8_0)) || defined(VISP_HAVE_PTHREAD))
+
+#include <visp3/core/vpMath.h>
+#include <visp3/robot/vpRobotException.h>
+#include <visp3/robot/vpSimulatorAfma6.h>
+#include <visp3/robot/vpSimulatorViper850.h>
+
+namespace
+{
+// Apply a camera velocity depending on the iteration and return the final
+// joint positions
+template <class Robot> vpColVector simulate(unsigned int nb_iter)
+{
+  // The wireframe simulator relies on global data, so only one simulator
+  // can exist at a time
+  Robot robot(false);
+  robot.setSynchronousMode(true);
+  robot.setRobotState(vpRobot::STATE_VELOCITY_CONTROL);
+  vpColVector v(6);
+  for (unsigned int iter = 0; iter < nb_iter; iter++) {
+    double t = 0.01 * iter;
+    v[0] = 0.02 * cos(t);
+    v[1] = 0.01 * sin(2 * t);
+    v[2] = -0.01;
+    v[3] = vpMath::rad(2) * sin(t);
+    v[4] = 0;
+    v[5] = vpMath::rad(5);
+    robot.setVelocity(vpRobot::CAMERA_FRAME, v);
+    robot.step(0.01);
+  }
+  if (!vpMath::equal(robot.getSimulationTime(), 0.01 * nb_iter, 1e-9)) {
+    throw vpException(vpException::fatalError, "Wrong simulation time %f", robot.getSimulationTime());
+  }
+  vpColVector q;
+  robot.getPosition(vpRobot::ARTICULAR_FRAME, q);
+  return q;
+}
+
+template <class Robot> bool testRobot(const std::string &name)
+{
+  // Two simulations have to give exactly the same result
+  vpColVector q1 = simulate<Robot>(200);
+  vpColVector q2 = simulate<Robot>(200);
+  for (unsigned int i = 0; i < q1.size(); i++) {
+    if (q1[i] != q2[i]) {
+      std::cerr << name << ": simulations differ: " << q1.t() << " / " << q2.t() << std::endl;
+      return false;
+    }
+  }
+
+  Robot robot(false);
+  robot.setVerbose(false);
+
+  // step() is only allowed in synchronous mode
+  bool thrown = false;
+  try {
+    robot.step(0.01);
+  } catch (vpRobotException &e) {
+    thrown = (e.getCode() == vpRobotException::wrongStateError);
+  }
+  if (!thrown) {
+    std::cerr << name << ": step() should throw when the thread is running" << std::endl;
+    return false;
+  }
+  robot.setSynchronousMode(true);
+  robot.setRobotState(vpRobot::STATE_VELOCITY_CONTROL);
+
+  // A constant joint velocity is integrated over the simulated time
+  vpColVector q0, qdot(6), q;
+  robot.getPosition(vpRobot::ARTICULAR_FRAME, q0);
+  for (unsigned int i = 0; i < 6; i++)
+    qdot[i] = (i % 2 ? -1 : 1) * 0.001 * (i + 1);
+  robot.setVelocity(vpRobot::ARTICULAR_FRAME, qdot);
+  for (unsigned int iter = 0; iter < 100; iter++)
+    robot.step(0.005);
+  robot.getPosition(vpRobot::ARTICULAR_FRAME, q);
+  for (unsigned int i = 0; i < 6; i++) {
+    if (!vpMath::equal(q[i], q0[i] + 0.5 * qdot[i], 1e-9)) {
+      std::cerr << name << ": wrong joint " << i << " position " << q[i] << " instead of " << q0[i] + 0.5 * qdot[i]
+                << std::endl;
+      return false;
+    }
+  }
+
+  // setPosition() moves the robot without the thread
+  robot.setRobotState(vpRobot::STATE_POSITION_CONTROL);
+  robot.setPosition(vpRobot::ARTICULAR_FRAME, q0);
+  robot.getPosition(vpRobot::ARTICULAR_FRAME, q);
+  if ((q - q0).sumSquare() > 1e-18) {
+    std::cerr << name << ": setPosition() did not reach " << q0.t() << std::endl;
+    return false;
+  }
+  vpHomogeneousMatrix fMc;
+  robot.get_fMc(q0, fMc);
+  vpPoseVector p;
+  robot.getPosition(vpRobot::REFERENCE_FRAME, p);
+  if ((vpColVector(p) - vpColVector(vpPoseVector(fMc))).sumSquare() > 1e-18) {
+    std::cerr << name << ": the camera pose is not updated" << std::endl;
+    return false;
+  }
+
+  // Back to the threaded mode
+  robot.setSynchronousMode(false);
+  std::cout << name << " is ok" << std::endl;
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    if (!testRobot<vpSimulatorViper850>("vpSimulatorViper850"))
+      return EXIT_FAILURE;
+    if (!testRobot<vpSimulatorAfma6>("vpSimulatorAfma6"))
+      return EXIT_FAILURE;
+    std::cout << "testRobotSimulatorStep is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
+
+#else
+int main()
+{
+  std::cout << "The robot simulators need the gui module and threading capabilities" << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
@@ -0,0 +1,174 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test the headless rendering of the wireframe simulator.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testWireFrameSimulatorRender.cpp
+  \brief Checks that vpWireFrameSimulator renders its views directly in the
+  image pixels, with hidden faces removed, and that batched rendering gives
+  the same images as rendering the views one by one.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+
+#include <visp3/core/vpMath.h>
+#include <visp3/robot/vpWireFrameSimulator.h>
+
+namespace
+{
+unsigned int countPixels(const vpImage<unsigned char> &I)
+{
+  unsigned int n = 0;
+  for (unsigned int i = 0; i < I.getSize(); i++)
+    if (I.bitmap[i] != 255)
+      n++;
+  return n;
+}
+
+// Return true if a pixel of the 3x3 neighbourhood of (i, j) is drawn
+bool isDrawn(const vpImage<unsigned char> &I, int i, int j)
+{
+  for (int di = -1; di <= 1; di++)
+    for (int dj = -1; dj <= 1; dj++)
+      if (I[i + di][j + dj] != 255)
+        return true;
+  return false;
+}
+
+template <class Type> bool sameImages(const vpImage<Type> &I1, const vpImage<Type> &I2)
+{
+  for (unsigned int i = 0; i < I1.getSize(); i++)
+    if (!(I1.bitmap[i] == I2.bitmap[i]))
+      return false;
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    vpWireFrameSimulator sim;
+    sim.initScene(vpWireFrameSimulator::CUBE);
+    sim.setCurrentViewColor(vpColor::black);
+    sim.setCameraColor(vpColor::black);
+    vpCameraParameters cam(600, 600, 320, 240);
+    sim.setInternalCameraParameters(cam);
+    sim.setExternalCameraParameters(cam);
+    sim.setExternalCameraPosition(vpHomogeneousMatrix(0.1, 0, 1.5, vpMath::rad(10), vpMath::rad(-20), 0));
+
+    // Cube of 12.4 cm facing the camera: only the front face is visible
+    sim.setCameraPositionRelObj(vpHomogeneousMatrix(0, 0, 0.5, 0, 0, 0));
+    vpImage<unsigned char> I(480, 640, 255);
+    sim.renderInternalImage(I);
+    int u = vpMath::round(320 + 600 * 0.062 / 0.438), v = vpMath::round(240 + 600 * 0.062 / 0.438);
+    if (!isDrawn(I, v, u) || !isDrawn(I, 240, u) || !isDrawn(I, v, 320)) {
+      std::cerr << "The front face of the cube is not rendered" << std::endl;
+      return EXIT_FAILURE;
+    }
+    int u_back = vpMath::round(320 + 600 * 0.062 / 0.562);
+    if (isDrawn(I, 240, u_back) || isDrawn(I, 240, 320)) {
+      std::cerr << "Hidden faces of the cube are rendered" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Nothing is rendered when the object is behind the camera
+    sim.setCameraPositionRelObj(vpHomogeneousMatrix(0, 0, -0.5, 0, 0, 0));
+    I = 255;
+    sim.renderInternalImage(I);
+    if (countPixels(I) != 0) {
+      std::cerr << "An object behind the camera is rendered" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Partially visible object: edges are clipped at the image borders
+    sim.setCameraPositionRelObj(vpHomogeneousMatrix(0.1, 0.05, 0.15, vpMath::rad(10), vpMath::rad(30), 0));
+    I = 255;
+    sim.renderInternalImage(I);
+    if (countPixels(I) == 0) {
+      std::cerr << "The clipped cube is not rendered" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Batched rendering gives the same images as single views
+    std::vector<vpHomogeneousMatrix> cMo, cMf;
+    for (unsigned int k = 0; k < 8; k++) {
+      cMo.push_back(vpHomogeneousMatrix(0.02 * k - 0.08, 0.01 * k, 0.3 + 0.05 * k, vpMath::rad(3. * k),
+                                        vpMath::rad(-20. + 5. * k), vpMath::rad(15. * k)));
+      cMf.push_back(vpHomogeneousMatrix(0.05 * k, -0.02 * k, 1.5, vpMath::rad(-4. * k), vpMath::rad(6. * k), 0));
+    }
+    std::vector<vpImage<unsigned char> > Iint(cMo.size(), vpImage<unsigned char>(480, 640, 255));
+    std::vector<vpImage<vpRGBa> > Iext(cMf.size(), vpImage<vpRGBa>(480, 640, vpRGBa(255)));
+    sim.renderInternalImages(Iint, cMo);
+    sim.renderExternalImages(Iext, cMf);
+    for (size_t k = 0; k < cMf.size(); k++) {
+      vpImage<vpRGBa> Ek(480, 640, vpRGBa(255));
+      sim.setExternalCameraPosition(cMf[k]);
+      sim.renderExternalImage(Ek);
+      if (!sameImages(Ek, Iext[k])) {
+        std::cerr << "External view " << k << " differs from the batched rendering" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    for (size_t k = 0; k < cMo.size(); k++) {
+      vpImage<unsigned char> Ik(480, 640, 255);
+      sim.setCameraPositionRelObj(cMo[k]);
+      sim.renderInternalImage(Ik);
+      if (countPixels(Ik) == 0 || !sameImages(Ik, Iint[k])) {
+        std::cerr << "Internal view " << k << " differs from the batched rendering" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    bool thrown = false;
+    try {
+      Iint.pop_back();
+      sim.renderInternalImages(Iint, cMo);
+    } catch (vpException &e) {
+      thrown = (e.getCode() == vpException::dimensionError);
+    }
+    if (!thrown) {
+      std::cerr << "Rendering with a wrong number of images should throw" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "testWireFrameSimulatorRender is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
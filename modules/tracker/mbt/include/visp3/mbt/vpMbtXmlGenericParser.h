@@ -562,6 +562,9 @@ public:
 protected:
   void init();
 
+  virtual bool readCacheData(std::istream &is);
+  virtual bool writeCacheData(std::ostream &os) const;
+
   void read_camera(xmlDocPtr doc, xmlNodePtr node);
   void read_face(xmlDocPtr doc, xmlNodePtr node);
   void read_lod(xmlDocPtr doc, xmlNodePtr node);
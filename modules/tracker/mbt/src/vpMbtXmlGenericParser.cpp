@@ -154,6 +154,152 @@ void vpMbtXmlGenericParser::writeMainClass(xmlNodePtr /*node*/)
   throw vpException(vpException::notImplementedError, "Not implemented.");
 }
 
+/*!
+  Read the parameters from a cache entry written by writeCacheData().
+
+  \param is : Stream to read from.
+  \return true if the parameters were read and correspond to the parser type.
+  Otherwise the parameters are left unchanged.
+*/
+bool vpMbtXmlGenericParser::readCacheData(std::istream &is)
+{
+  // The values are read in local variables and only set once the whole entry
+  // is valid, so that an invalid entry leaves the parser unchanged
+  vpParserType parserType;
+  vpCameraParameters::vpCameraParametersProjType projModel;
+  double cam[6];
+  double angleAppear, angleDisappear, nearClipping, farClipping;
+  bool hasNearClipping, hasFarClipping, fovClipping, useLod;
+  double minLineLengthThreshold, minPolygonAreaThreshold;
+  unsigned int mask[3];
+  double ecm[4];
+  unsigned int kltMaskBorder, kltMaxFeatures, kltWinSize;
+  double kltQualityValue, kltMinDist, kltHarrisParam;
+  unsigned int kltBlockSize, kltPyramidLevels;
+  vpMbtFaceDepthNormal::vpFeatureEstimationType depthNormalFeatureEstimationMethod;
+  int depthNormalPclPlaneEstimationMethod, depthNormalPclPlaneEstimationRansacMaxIter;
+  double depthNormalPclPlaneEstimationRansacThreshold;
+  unsigned int depthNormalSamplingStepX, depthNormalSamplingStepY;
+  unsigned int depthDenseSamplingStepX, depthDenseSamplingStepY;
+  double projectionErrorSampleStep;
+  unsigned int projectionErrorKernelSize;
+  if (!readCacheValue(is, parserType) || parserType != m_parserType || !readCacheValue(is, projModel) ||
+      !readCacheValue(is, cam) || !readCacheValue(is, angleAppear) || !readCacheValue(is, angleDisappear) ||
+      !readCacheValue(is, hasNearClipping) || !readCacheValue(is, nearClipping) ||
+      !readCacheValue(is, hasFarClipping) || !readCacheValue(is, farClipping) || !readCacheValue(is, fovClipping) ||
+      !readCacheValue(is, useLod) || !readCacheValue(is, minLineLengthThreshold) ||
+      !readCacheValue(is, minPolygonAreaThreshold) || !readCacheValue(is, mask) || !readCacheValue(is, ecm) ||
+      !readCacheValue(is, kltMaskBorder) || !readCacheValue(is, kltMaxFeatures) || !readCacheValue(is, kltWinSize) ||
+      !readCacheValue(is, kltQualityValue) || !readCacheValue(is, kltMinDist) ||
+      !readCacheValue(is, kltHarrisParam) || !readCacheValue(is, kltBlockSize) ||
+      !readCacheValue(is, kltPyramidLevels) || !readCacheValue(is, depthNormalFeatureEstimationMethod) ||
+      !readCacheValue(is, depthNormalPclPlaneEstimationMethod) ||
+      !readCacheValue(is, depthNormalPclPlaneEstimationRansacMaxIter) ||
+      !readCacheValue(is, depthNormalPclPlaneEstimationRansacThreshold) ||
+      !readCacheValue(is, depthNormalSamplingStepX) || !readCacheValue(is, depthNormalSamplingStepY) ||
+      !readCacheValue(is, depthDenseSamplingStepX) || !readCacheValue(is, depthDenseSamplingStepY) ||
+      !readCacheValue(is, projectionErrorSampleStep) || !readCacheValue(is, projectionErrorKernelSize) ||
+      mask[1] == 0) {
+    return false;
+  }
+
+  if (projModel == vpCameraParameters::perspectiveProjWithDistortion) {
+    m_cam.initPersProjWithDistortion(cam[0], cam[1], cam[2], cam[3], cam[4], cam[5]);
+  } else {
+    m_cam.initPersProjWithoutDistortion(cam[0], cam[1], cam[2], cam[3]);
+  }
+  m_angleAppear = angleAppear;
+  m_angleDisappear = angleDisappear;
+  m_hasNearClipping = hasNearClipping;
+  m_nearClipping = nearClipping;
+  m_hasFarClipping = hasFarClipping;
+  m_farClipping = farClipping;
+  m_fovClipping = fovClipping;
+  m_useLod = useLod;
+  m_minLineLengthThreshold = minLineLengthThreshold;
+  m_minPolygonAreaThreshold = minPolygonAreaThreshold;
+
+  m_ecm.setMaskSize(mask[0]);
+  m_ecm.setMaskNumber(mask[1]);
+  m_ecm.setRange(mask[2]);
+  m_ecm.setThreshold(ecm[0]);
+  m_ecm.setMu1(ecm[1]);
+  m_ecm.setMu2(ecm[2]);
+  m_ecm.setSampleStep(ecm[3]);
+
+  m_kltMaskBorder = kltMaskBorder;
+  m_kltMaxFeatures = kltMaxFeatures;
+  m_kltWinSize = kltWinSize;
+  m_kltQualityValue = kltQualityValue;
+  m_kltMinDist = kltMinDist;
+  m_kltHarrisParam = kltHarrisParam;
+  m_kltBlockSize = kltBlockSize;
+  m_kltPyramidLevels = kltPyramidLevels;
+
+  m_depthNormalFeatureEstimationMethod = depthNormalFeatureEstimationMethod;
+  m_depthNormalPclPlaneEstimationMethod = depthNormalPclPlaneEstimationMethod;
+  m_depthNormalPclPlaneEstimationRansacMaxIter = depthNormalPclPlaneEstimationRansacMaxIter;
+  m_depthNormalPclPlaneEstimationRansacThreshold = depthNormalPclPlaneEstimationRansacThreshold;
+  m_depthNormalSamplingStepX = depthNormalSamplingStepX;
+  m_depthNormalSamplingStepY = depthNormalSamplingStepY;
+  m_depthDenseSamplingStepX = depthDenseSamplingStepX;
+  m_depthDenseSamplingStepY = depthDenseSamplingStepY;
+
+  m_projectionErrorMe.setSampleStep(projectionErrorSampleStep);
+  m_projectionErrorKernelSize = projectionErrorKernelSize;
+
+  return true;
+}
+
+/*!
+  Write the parameters that may be modified when parsing a file in a cache
+  entry.
+
+  \param os : Stream to write to.
+  \return true.
+*/
+bool vpMbtXmlGenericParser::writeCacheData(std::ostream &os) const
+{
+  double cam[6] = {m_cam.get_px(), m_cam.get_py(), m_cam.get_u0(), m_cam.get_v0(), m_cam.get_kud(), m_cam.get_kdu()};
+  unsigned int mask[3] = {m_ecm.getMaskSize(), m_ecm.getMaskNumber(), m_ecm.getRange()};
+  double ecm[4] = {m_ecm.getThreshold(), m_ecm.getMu1(), m_ecm.getMu2(), m_ecm.getSampleStep()};
+
+  writeCacheValue(os, m_parserType);
+  writeCacheValue(os, m_cam.get_projModel());
+  writeCacheValue(os, cam);
+  writeCacheValue(os, m_angleAppear);
+  writeCacheValue(os, m_angleDisappear);
+  writeCacheValue(os, m_hasNearClipping);
+  writeCacheValue(os, m_nearClipping);
+  writeCacheValue(os, m_hasFarClipping);
+  writeCacheValue(os, m_farClipping);
+  writeCacheValue(os, m_fovClipping);
+  writeCacheValue(os, m_useLod);
+  writeCacheValue(os, m_minLineLengthThreshold);
+  writeCacheValue(os, m_minPolygonAreaThreshold);
+  writeCacheValue(os, mask);
+  writeCacheValue(os, ecm);
+  writeCacheValue(os, m_kltMaskBorder);
+  writeCacheValue(os, m_kltMaxFeatures);
+  writeCacheValue(os, m_kltWinSize);
+  writeCacheValue(os, m_kltQualityValue);
+  writeCacheValue(os, m_kltMinDist);
+  writeCacheValue(os, m_kltHarrisParam);
+  writeCacheValue(os, m_kltBlockSize);
+  writeCacheValue(os, m_kltPyramidLevels);
+  writeCacheValue(os, m_depthNormalFeatureEstimationMethod);
+  writeCacheValue(os, m_depthNormalPclPlaneEstimationMethod);
+  writeCacheValue(os, m_depthNormalPclPlaneEstimationRansacMaxIter);
+  writeCacheValue(os, m_depthNormalPclPlaneEstimationRansacThreshold);
+  writeCacheValue(os, m_depthNormalSamplingStepX);
+  writeCacheValue(os, m_depthNormalSamplingStepY);
+  writeCacheValue(os, m_depthDenseSamplingStepX);
+  writeCacheValue(os, m_depthDenseSamplingStepY);
+  writeCacheValue(os, m_projectionErrorMe.getSampleStep());
+  writeCacheValue(os, m_projectionErrorKernelSize);
+  return true;
+}
+
 /*!
   Read the parameters of the class from the file given by its document pointer
   and by its root node.
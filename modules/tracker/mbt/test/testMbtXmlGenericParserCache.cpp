@@ -0,0 +1,121 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the cache entries of the model-based tracker xml parser.
+ *
+ *****************************************************************************/
+
+
+/*!
+  \example testMbtXmlGenericParserCache.cpp
+
+  \brief Test that the model-based tracker xml parser restores its
+  parameters from a cache entry, and keeps them unchanged when the entry is
+  truncated.
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_XML2)
+#include <visp3/core/vpMath.h>
+#include <visp3/mbt/vpMbtXmlGenericParser.h>
+
+namespace
+{
+// Give access to the cache entry serialization
+class vpCacheTestParser : public vpMbtXmlGenericParser
+{
+public:
+  vpCacheTestParser()
+    : vpMbtXmlGenericParser(
+          (vpMbtXmlGenericParser::vpParserType)(vpMbtXmlGenericParser::EDGE_PARSER | vpMbtXmlGenericParser::KLT_PARSER))
+  {
+  }
+
+  bool read(const std::string &data)
+  {
+    std::istringstream is(data);
+    return readCacheData(is);
+  }
+
+  std::string write() const
+  {
+    std::ostringstream os;
+    writeCacheData(os);
+    return os.str();
+  }
+};
+}
+
+int main()
+{
+  vpCacheTestParser p1;
+  p1.setAngleAppear(vpMath::rad(65));
+  p1.setCameraParameters(vpCameraParameters(600, 610, 320, 240));
+  p1.setKltMaxFeatures(4000);
+  p1.setDepthDenseSamplingStepX(5);
+  p1.setProjectionErrorKernelSize(3);
+  const std::string entry = p1.write();
+
+  vpCacheTestParser p2;
+  const std::string initial = p2.write();
+  if (initial == entry) {
+    std::cerr << "The two parsers should have different parameters" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Every truncated entry is rejected and leaves the parser unchanged
+  for (size_t size = 0; size < entry.size(); size++) {
+    if (p2.read(entry.substr(0, size)) || p2.write() != initial) {
+      std::cerr << "Entry truncated to " << size << " bytes modified the parser" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (!p2.read(entry) || p2.write() != entry) {
+    std::cerr << "The parameters are not restored from the cache entry" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testMbtXmlGenericParserCache is ok" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+#else
+int main()
+{
+  std::cout << "Xml parser requires libxml2." << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
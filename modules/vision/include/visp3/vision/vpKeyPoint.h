@@ -58,6 +58,7 @@
 #include <visp3/vision/vpPose.h>
 #ifdef VISP_HAVE_MODULE_IO
 #  include <visp3/io/vpImageIo.h>
+#  include <visp3/io/vpMemoryMappedFile.h>
 #endif
 #include <visp3/core/vpConvert.h>
 #include <visp3/core/vpCylinder.h>
@@ -650,8 +651,13 @@ public:
 
      \return : Matrix with descriptors values at each row for each train
      keypoints (or reference keypoints).
+
+     \note When the learning data were loaded from a binary file with
+     loadLearningData(), the descriptors are used in place in the memory
+     mapped file. A copy is then returned, that stays valid after the file is
+     unmapped.
    */
-  inline cv::Mat getTrainDescriptors() const { return m_trainDescriptors; }
+  cv::Mat getTrainDescriptors() const;
 
   void getTrainKeyPoints(std::vector<cv::KeyPoint> &keyPoints) const;
   void getTrainKeyPoints(std::vector<vpImagePoint> &keyPoints) const;
@@ -1060,15 +1066,62 @@ public:
   */
   inline void setUseAffineDetection(const bool useAffine) { m_useAffineDetection = useAffine; }
 
+  /*!
+    Set if the affine views that are not likely to be useful are skipped when
+    matching with multiple affine transformations (see
+    setUseAffineDetection()). Disabled by default.
+
+    After a successful pose estimation with matchPoint(const
+    vpImage<unsigned char> &, const vpCameraParameters &, vpHomogeneousMatrix
+    &, double &, double &, bool (*)(vpHomogeneousMatrix *), const vpRect &),
+    only the affine views that provided Ransac inliers and their neighbors
+    (close tilt and rotation) are simulated for the next image. All the views
+    are simulated again when the pose estimation fails.
+
+    \param useSelection : True to skip the views predicted useless by the
+    previous pose estimation, false to always simulate all the views.
+  */
+  inline void setUseAffineViewSelection(const bool useSelection)
+  {
+    m_useAffineViewSelection = useSelection;
+    m_affineViewInliers.clear();
+  }
+
+  /*!
+    Set if the persistent binary descriptor matcher is used instead of the
+    OpenCV matcher. By default, the OpenCV matcher is used.
+
+    It is only used for binary descriptors (e.g. ORB, BRISK, BRIEF) with the
+    "BruteForce-Hamming" matcher (exhaustive search) or the "FlannBased"
+    matcher (multi-probe LSH index). The train descriptors are packed and
+    indexed once, when the reference is built or loaded, and the matching is
+    done in parallel over the descriptors, also when the train keypoints are
+    matched to the query keypoints (see setUseMatchTrainToQuery()).
+
+    \param useBinaryMatcher : True to use the binary descriptor matcher when
+    possible, false to always use the OpenCV matcher.
+    \param mutualCheck : If true, only keep the matches whose query and train
+    descriptors are mutual nearest neighbors. With OpenCV 2.4, the mutual
+    check of the exhaustive search is also enabled by
+    setUseBruteForceCrossCheck() when knn is not used.
+  */
+  inline void setUseBinaryMatcher(const bool useBinaryMatcher, const bool mutualCheck = false)
+  {
+    m_useBinaryMatcher = useBinaryMatcher;
+    m_useBinaryMatcherMutualCheck = mutualCheck;
+  }
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
   /*!
     Set if cross check method must be used to eliminate some false matches
-    with a brute-force matching method.
+    with a brute-force matching method. It is also used by the exhaustive
+    search of the binary descriptor matcher, see setUseBinaryMatcher().
 
     \param useCrossCheck : True to use cross check, false otherwise
   */
   inline void setUseBruteForceCrossCheck(const bool useCrossCheck)
   {
+    m_useBruteForceCrossCheck = useCrossCheck;
     // Only available with BruteForce and with k=1 (i.e not used with a
     // ratioDistanceThreshold method)
     if (m_matcher != NULL && !m_useKnn && m_matcherName == "BruteForce") {
@@ -1119,6 +1172,66 @@ public:
   inline void setUseSingleMatchFilter(const bool singleMatchFilter) { m_useSingleMatchFilter = singleMatchFilter; }
 
 private:
+  /*
+   * Persistent matcher for binary descriptors compared with the Hamming
+   * distance. The train descriptors are packed contiguously once, and can
+   * be indexed with a multi-probe LSH. The search for the two nearest
+   * neighbors runs in parallel over the query descriptors.
+   */
+  class BinaryDescriptorMatcher
+  {
+  public:
+    //! Two nearest neighbors (index -1 if none) and their Hamming distances
+    struct Neighbors {
+      int idx[2];
+      int dist[2];
+    };
+
+    BinaryDescriptorMatcher();
+
+    void clear();
+    bool empty() const { return m_nbDescriptors == 0; }
+    int findNearestQuery(const int trainIdx) const;
+    bool isTrained(const bool useLsh) const { return m_nbDescriptors > 0 && m_useLsh == useLsh; }
+    void knnSearch(const cv::Mat &queryDescriptors, std::vector<Neighbors> &neighbors);
+    void knnSearchTrainToQuery(const cv::Mat &queryDescriptors, std::vector<Neighbors> &neighbors);
+    void train(const cv::Mat &trainDescriptors, const bool useLsh);
+
+  private:
+    void buildLsh();
+    void pack(const cv::Mat &descriptors, std::vector<unsigned char> &packed) const;
+
+    //! Number of bytes of a descriptor
+    int m_descriptorSize;
+    //! Train descriptors, m_stride bytes each
+    std::vector<unsigned char> m_descriptors;
+    //! Bit positions that make up the key of each LSH table
+    std::vector<int> m_lshBits;
+    //! Train descriptor indices of each LSH table, sorted by bucket
+    std::vector<int> m_lshIndices;
+    //! Number of bits of the LSH keys
+    int m_lshKeySize;
+    //! Number of LSH tables
+    int m_lshNbTables;
+    //! Offsets of the buckets in m_lshIndices, for each LSH table
+    std::vector<int> m_lshOffsets;
+    int m_nbDescriptors;
+    int m_nbQueryDescriptors;
+    //! Last query descriptors, packed as the train descriptors
+    std::vector<unsigned char> m_queryDescriptors;
+    //! Number of bytes between two packed descriptors, multiple of 16
+    int m_stride;
+    bool m_useLsh;
+  };
+
+  //! Number of Ransac inliers provided by each affine view for the last pose
+  //! estimation, empty if all the views have to be simulated
+  std::vector<int> m_affineViewInliers;
+  //! Index of the first query keypoint of each affine view, and number of
+  //! query keypoints
+  std::vector<size_t> m_affineViewOffsets;
+  //! Persistent matcher used for binary descriptors
+  BinaryDescriptorMatcher m_binaryMatcher;
   //! If true, compute covariance matrix if the user select the pose
   //! estimation method using ViSP
   bool m_computeCovariance;
@@ -1159,6 +1272,11 @@ private:
   //! List of k-nearest neighbors for each detected keypoints (if the method
   //! chosen is based upon on knn).
   std::vector<std::vector<cv::DMatch> > m_knnMatches;
+#ifdef VISP_HAVE_MODULE_IO
+  //! Learning file mapped in memory, shared by the train descriptors that
+  //! are used in place
+  cv::Ptr<vpMemoryMappedFile> m_learningFile;
+#endif
   //! Map descriptor enum type to string.
   std::map<vpFeatureDescriptorType, std::string> m_mapOfDescriptorNames;
   //! Map detector enum type to string.
@@ -1166,6 +1284,9 @@ private:
   //! Map of image id to know to which training image is related a training
   //! keypoints.
   std::map<int, int> m_mapOfImageId;
+  //! Path of the training images that are not yet read, see
+  //! loadTrainingImages().
+  std::map<int, std::string> m_mapOfImagePaths;
   //! Map of images to have access to the image buffer according to his image
   //! id.
   std::map<int, vpImage<unsigned char> > m_mapOfImages;
@@ -1234,6 +1355,13 @@ private:
   //! If true, use multiple affine transformations to cober the 6 affine
   //! parameters
   bool m_useAffineDetection;
+  //! If true, skip the affine views predicted useless by the last pose
+  //! estimation
+  bool m_useAffineViewSelection;
+  //! If true, use m_binaryMatcher for binary descriptors
+  bool m_useBinaryMatcher;
+  //! If true, m_binaryMatcher only keeps mutual nearest neighbors
+  bool m_useBinaryMatcherMutualCheck;
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
   //! If true, some false matches will be eliminate by keeping only pairs
   //! (i,j) such that for i-th query descriptor the j-th descriptor in the
@@ -1256,11 +1384,16 @@ private:
   //! matched to a single query keypoint
   bool m_useSingleMatchFilter;
 
-  void affineSkew(double tilt, double phi, cv::Mat &img, cv::Mat &mask, cv::Mat &Ai);
-
   double computePoseEstimationError(const std::vector<std::pair<cv::KeyPoint, cv::Point3f> > &matchKeyPoints,
                                     const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo_est);
 
+  void detectExtractAffine(const vpImage<unsigned char> &I, std::vector<cv::KeyPoint> &keyPoints, cv::Mat &descriptors,
+                           const bool useViewSelection);
+  void detectExtractAffineViews(const vpImage<unsigned char> &I, const std::vector<bool> &selectedViews,
+                                std::vector<std::vector<cv::KeyPoint> > &listOfKeypoints,
+                                std::vector<cv::Mat> &listOfDescriptors,
+                                std::vector<vpImage<unsigned char> > *listOfAffineI);
+
   void filterMatches();
 
   void init();
@@ -1272,6 +1405,20 @@ private:
 
   void initFeatureNames();
 
+  void loadLearningFile(const std::string &filename, const std::string &parent, const int startClassId,
+                        const int startImageId, const bool append);
+  void loadTrainingImages();
+
+  bool mappedTrainDescriptors() const;
+
+  void matchBinary(const cv::Mat &queryDescriptors, std::vector<cv::DMatch> &matches);
+
+  void trainMatcher();
+
+  void updateAffineViewSelection(const bool poseEstimated);
+
+  bool useBinaryMatcher() const;
+
   inline size_t myKeypointHash(const cv::KeyPoint &kp)
   {
     size_t _Val = 2166136261U, scale = 16777619U;
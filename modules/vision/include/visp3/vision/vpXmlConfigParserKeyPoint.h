@@ -269,6 +269,8 @@ private:
   void read_matcher(xmlDocPtr doc, xmlNodePtr node);
   virtual void readMainClass(xmlDocPtr doc, xmlNodePtr node);
   void read_ransac(xmlDocPtr doc, xmlNodePtr node);
+  virtual bool readCacheData(std::istream &is);
+  virtual bool writeCacheData(std::ostream &os) const;
   virtual void writeMainClass(xmlNodePtr){};
 };
 #endif // VISP_HAVE_XML2
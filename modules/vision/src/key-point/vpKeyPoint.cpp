@@ -38,8 +38,13 @@
 
 #include <iomanip>
 #include <limits>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpUniRand.h>
 #include <visp3/vision/vpKeyPoint.h>
 
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020101)
@@ -48,6 +53,16 @@
 #include <opencv2/calib3d/calib3d.hpp>
 #endif
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+
+#if defined __SSSE3__ || (defined _MSC_VER && _MSC_VER >= 1500)
+#include <tmmintrin.h>
+#define VISP_HAVE_SSSE3 1
+#endif
+#endif
+
 namespace
 {
 // Specific Type transformation functions
@@ -65,6 +80,381 @@ inline vpImagePoint matchRansacToVpImage(const std::pair<cv::KeyPoint, cv::Point
   return vpImagePoint(pair.first.pt.y, pair.first.pt.x);
 }
 
+/*
+  Hamming distance between two packed binary descriptors of stride bytes
+  (multiple of 16), 32 bits at a time.
+*/
+struct HammingDistance {
+  inline int operator()(const unsigned char *a, const unsigned char *b, const int stride) const
+  {
+    int dist = 0;
+    for (int i = 0; i < stride; i += 4) {
+      unsigned int v, w;
+      memcpy(&v, a + i, sizeof(v));
+      memcpy(&w, b + i, sizeof(w));
+      v ^= w;
+      v = v - ((v >> 1) & 0x55555555U);
+      v = (v & 0x33333333U) + ((v >> 2) & 0x33333333U);
+      dist += (int)((((v + (v >> 4)) & 0x0F0F0F0FU) * 0x01010101U) >> 24);
+    }
+    return dist;
+  }
+};
+
+#if VISP_HAVE_SSSE3
+/*
+  Same as HammingDistance, with a nibble lookup table popcount on 128 bits.
+*/
+struct HammingDistanceSSSE3 {
+  inline int operator()(const unsigned char *a, const unsigned char *b, const int stride) const
+  {
+    const __m128i lut = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m128i low_mask = _mm_set1_epi8(0x0f);
+    __m128i acc = _mm_setzero_si128();
+    for (int i = 0; i < stride; i += 16) {
+      const __m128i x =
+          _mm_xor_si128(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i)));
+      const __m128i cnt = _mm_add_epi8(_mm_shuffle_epi8(lut, _mm_and_si128(x, low_mask)),
+                                       _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(x, 4), low_mask)));
+      acc = _mm_add_epi64(acc, _mm_sad_epu8(cnt, _mm_setzero_si128()));
+    }
+    return _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(acc, acc));
+  }
+};
+#endif
+
+template <class Neighbors> inline void initNeighbors(Neighbors &n)
+{
+  n.idx[0] = n.idx[1] = -1;
+  n.dist[0] = n.dist[1] = std::numeric_limits<int>::max();
+}
+
+// Keep the two nearest neighbors, a candidate may be inserted several times
+template <class Neighbors> inline void insertNeighbor(Neighbors &n, const int idx, const int dist)
+{
+  if (dist < n.dist[0]) {
+    if (idx != n.idx[0]) {
+      n.idx[1] = n.idx[0];
+      n.dist[1] = n.dist[0];
+    }
+    n.idx[0] = idx;
+    n.dist[0] = dist;
+  } else if (dist < n.dist[1] && idx != n.idx[0]) {
+    n.idx[1] = idx;
+    n.dist[1] = dist;
+  }
+}
+
+/*
+  Exhaustive search of the two nearest train descriptors of each query
+  descriptor. Blocks of queries are processed in parallel, each one going
+  through the train descriptors by blocks that stay in cache.
+*/
+template <class Neighbors, class Distance>
+void bruteForceKnn(const unsigned char *query, const int nbQuery, const unsigned char *train, const int nbTrain,
+                   const int stride, const Distance &distance, Neighbors *neighbors)
+{
+  const int queryBlockSize = 32, trainBlockSize = 2048;
+  const int nbQueryBlocks = (nbQuery + queryBlockSize - 1) / queryBlockSize;
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int b = 0; b < nbQueryBlocks; b++) {
+    const int q_begin = b * queryBlockSize, q_end = (std::min)(nbQuery, q_begin + queryBlockSize);
+    for (int q = q_begin; q < q_end; q++) {
+      initNeighbors(neighbors[q]);
+    }
+    for (int t_begin = 0; t_begin < nbTrain; t_begin += trainBlockSize) {
+      const int t_end = (std::min)(nbTrain, t_begin + trainBlockSize);
+      for (int q = q_begin; q < q_end; q++) {
+        const unsigned char *q_desc = query + (size_t)q * (size_t)stride;
+        Neighbors &n = neighbors[q];
+        for (int t = t_begin; t < t_end; t++) {
+          insertNeighbor(n, t, distance(q_desc, train + (size_t)t * (size_t)stride, stride));
+        }
+      }
+    }
+  }
+}
+
+inline unsigned int lshKey(const unsigned char *descriptor, const int *bits, const int keySize)
+{
+  unsigned int key = 0;
+  for (int j = 0; j < keySize; j++) {
+    if (descriptor[bits[j] >> 3] & (1 << (bits[j] & 7))) {
+      key |= 1U << j;
+    }
+  }
+  return key;
+}
+
+/*
+  Approximate search of the two nearest train descriptors of each query
+  descriptor with a multi-probe LSH: in each table, the bucket of the query
+  key and the buckets whose key differs by one bit are visited.
+*/
+template <class Neighbors, class Distance>
+void lshKnn(const unsigned char *query, const int nbQuery, const unsigned char *train, const int nbTrain,
+            const int stride, const int *bits, const int keySize, const int nbTables, const int *offsets,
+            const int *indices, const Distance &distance, Neighbors *neighbors)
+{
+  const int nbBuckets = 1 << keySize;
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+  for (int q = 0; q < nbQuery; q++) {
+    const unsigned char *q_desc = query + (size_t)q * (size_t)stride;
+    Neighbors &n = neighbors[q];
+    initNeighbors(n);
+
+    for (int table = 0; table < nbTables; table++) {
+      const unsigned int key = lshKey(q_desc, bits + table * keySize, keySize);
+      const int *table_offsets = offsets + (size_t)table * (size_t)(nbBuckets + 1);
+      const int *table_indices = indices + (size_t)table * (size_t)nbTrain;
+      for (int probe = -1; probe < keySize; probe++) {
+        const unsigned int bucket = probe < 0 ? key : key ^ (1U << probe);
+        for (int j = table_offsets[bucket]; j < table_offsets[bucket + 1]; j++) {
+          const int t = table_indices[j];
+          insertNeighbor(n, t, distance(q_desc, train + (size_t)t * (size_t)stride, stride));
+        }
+      }
+    }
+
+    // Not enough candidates in the probed buckets
+    if (n.idx[0] < 0 || (n.idx[1] < 0 && nbTrain > 1)) {
+      for (int t = 0; t < nbTrain; t++) {
+        insertNeighbor(n, t, distance(q_desc, train + (size_t)t * (size_t)stride, stride));
+      }
+    }
+  }
+}
+
+template <class Distance>
+int nearestDescriptor(const unsigned char *descriptor, const unsigned char *set, const int nbDescriptors,
+                      const int stride, const Distance &distance)
+{
+  int best = -1, best_dist = std::numeric_limits<int>::max();
+  for (int i = 0; i < nbDescriptors; i++) {
+    int dist = distance(descriptor, set + (size_t)i * (size_t)stride, stride);
+    if (dist < best_dist) {
+      best = i;
+      best_dist = dist;
+    }
+  }
+  return best;
+}
+
+// Layout of the binary learning file: a 64 bytes header followed by the
+// keypoints, the 3D points, the path of the training images and the
+// descriptors, each section starting on a 64 bytes boundary. The values are
+// stored in the byte order of the host so that the file can be mapped.
+const char vp_kp_magic[8] = {'V', 'I', 'S', 'P', 'K', 'P', 'D', 'B'};
+const uint32_t vp_kp_byte_order = 0x01020304;
+const uint32_t vp_kp_version = 1;
+const size_t vp_kp_header_size = 64;
+const size_t vp_kp_offset_byte_order = 8;
+const size_t vp_kp_offset_version = 12;
+const size_t vp_kp_offset_header_size = 16;
+const size_t vp_kp_offset_nb_keypoints = 20;
+const size_t vp_kp_offset_descriptor_cols = 24;
+const size_t vp_kp_offset_descriptor_type = 28;
+const size_t vp_kp_offset_descriptor_step = 32;
+const size_t vp_kp_offset_have_3d = 36;
+const size_t vp_kp_offset_nb_images = 40;
+const size_t vp_kp_offset_images_size = 44;
+// u, v, size, angle, response, octave, class_id, image_id
+const size_t vp_kp_keypoint_size = 32;
+// oX, oY, oZ
+const size_t vp_kp_point_size = 12;
+
+inline size_t alignLearningOffset(const size_t offset, const size_t alignment)
+{
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+template <typename Type> inline Type getLearningValue(const unsigned char *data, const size_t offset)
+{
+  Type value;
+  memcpy(&value, data + offset, sizeof(value));
+  return value;
+}
+
+template <typename Type> inline void setLearningValue(unsigned char *data, const size_t offset, const Type value)
+{
+  memcpy(data + offset, &value, sizeof(value));
+}
+
+struct vpLearningFileLayout {
+  vpLearningFileLayout(const size_t nbKeyPoints, const bool have3DInfo, const size_t imagesSize,
+                       const size_t descriptorStep)
+    : keyPoints(vp_kp_header_size), points(0), images(0), descriptors(0), size(0)
+  {
+    points = alignLearningOffset(keyPoints + nbKeyPoints * vp_kp_keypoint_size, 64);
+    images = alignLearningOffset(points + (have3DInfo ? nbKeyPoints * vp_kp_point_size : 0), 64);
+    descriptors = alignLearningOffset(images + imagesSize, 64);
+    size = descriptors + nbKeyPoints * descriptorStep;
+  }
+
+  size_t keyPoints;
+  size_t points;
+  size_t images;
+  size_t descriptors;
+  size_t size;
+};
+
+bool isLearningFile(const std::string &filename)
+{
+  std::ifstream file(filename.c_str(), std::ifstream::binary);
+  char magic[sizeof(vp_kp_magic)];
+  file.read(magic, sizeof(magic));
+  return file.gcount() == (std::streamsize)sizeof(magic) && memcmp(magic, vp_kp_magic, sizeof(magic)) == 0;
+}
+
+// View simulated by the affine detection: rotation of phi degrees followed
+// by a tilt in the direction of x
+struct vpAffineView {
+  double tilt;
+  int phi;
+  int tiltIndex;
+  // Estimated cost of the simulation, only used to order the views
+  double cost;
+  // Index of the view in the lists of keypoints and descriptors
+  size_t index;
+};
+
+inline bool compareAffineViewCost(const vpAffineView &view1, const vpAffineView &view2)
+{
+  return view1.cost > view2.cost;
+}
+
+/*
+  List the (tilt, phi) pairs of the affine detection. See
+  http://www.ipol.im/pub/algo/my_affine_sift/ for the sampling.
+*/
+void computeAffineViews(const int width, const int height, std::vector<vpAffineView> &views)
+{
+  views.clear();
+  for (int tl = 1; tl < 6; tl++) {
+    double t = pow(2, 0.5 * tl);
+    for (int phi = 0; phi < 180; phi += (int)(72.0 / t)) {
+      // The rotated image is blurred with a kernel proportional to the tilt
+      // before being subsampled
+      double c = std::fabs(cos(phi * M_PI / 180.)), s = std::fabs(sin(phi * M_PI / 180.));
+      double area = (width * c + height * s) * (width * s + height * c);
+
+      vpAffineView view;
+      view.tilt = t;
+      view.phi = phi;
+      view.tiltIndex = tl;
+      view.cost = area * (1.0 + 0.8 * sqrt(t * t - 1)) + area / t;
+      view.index = views.size();
+      views.push_back(view);
+    }
+  }
+}
+
+/*
+  Return true if the views are close enough for the keypoints matched in one
+  view to be likely matched in the other one after a small motion: adjacent
+  tilts and rotations.
+*/
+bool areNeighborAffineViews(const vpAffineView &view1, const vpAffineView &view2)
+{
+  if (std::abs(view1.tiltIndex - view2.tiltIndex) > 1) {
+    return false;
+  }
+
+  int dphi = std::abs(view1.phi - view2.phi) % 180;
+  dphi = std::min(dphi, 180 - dphi);
+  return dphi <= std::max((int)(72.0 / view1.tilt), (int)(72.0 / view2.tilt));
+}
+
+// Buffers reused by a thread for all the views it simulates
+struct vpAffineBuffers {
+  std::vector<unsigned char> rotated;
+  std::vector<unsigned char> skewed;
+  std::vector<unsigned char> mask;
+};
+
+/*
+  Return a matrix that uses the memory of the buffer, grown if needed. OpenCV
+  functions write into such a matrix without allocation when they produce an
+  image of the same size.
+*/
+inline cv::Mat bufferHeader(std::vector<unsigned char> &buffer, const int rows, const int cols)
+{
+  if (buffer.size() < (size_t)rows * (size_t)cols) {
+    buffer.resize((size_t)rows * (size_t)cols);
+  }
+  return cv::Mat(rows, cols, CV_8UC1, buffer.empty() ? NULL : &buffer[0]);
+}
+
+/*
+  Apply an affine and skew transformation to an image.
+  img : Input image
+  fullMask : Image of the size of img filled with 255
+  buffers : Buffers that hold the transformed image and mask
+  timg : Image after the transformation
+  mask : Mask containing the location of the image pixels after the
+  transformation
+  Ai : Inverse affine matrix
+*/
+void affineSkew(double tilt, double phi, const cv::Mat &img, const cv::Mat &fullMask, vpAffineBuffers &buffers,
+                cv::Mat &timg, cv::Mat &mask, cv::Mat &Ai)
+{
+  int h = img.rows;
+  int w = img.cols;
+
+  cv::Mat A = cv::Mat::eye(2, 3, CV_32F);
+  cv::Mat rotated = img;
+
+  // if (phi != 0.0) {
+  if (std::fabs(phi) > std::numeric_limits<double>::epsilon()) {
+    phi *= M_PI / 180.;
+    double s = sin(phi);
+    double c = cos(phi);
+
+    A = (cv::Mat_<float>(2, 2) << c, -s, s, c);
+
+    cv::Mat corners = (cv::Mat_<float>(4, 2) << 0, 0, w, 0, w, h, 0, h);
+    cv::Mat tcorners = corners * A.t();
+    cv::Mat tcorners_x, tcorners_y;
+    tcorners.col(0).copyTo(tcorners_x);
+    tcorners.col(1).copyTo(tcorners_y);
+    std::vector<cv::Mat> channels;
+    channels.push_back(tcorners_x);
+    channels.push_back(tcorners_y);
+    cv::merge(channels, tcorners);
+
+    cv::Rect rect = cv::boundingRect(tcorners);
+    A = (cv::Mat_<float>(2, 3) << c, -s, -rect.x, s, c, -rect.y);
+
+    rotated = bufferHeader(buffers.rotated, rect.height, rect.width);
+    cv::warpAffine(img, rotated, A, rotated.size(), cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+  }
+  // if (tilt != 1.0) {
+  if (std::fabs(tilt - 1.0) > std::numeric_limits<double>::epsilon()) {
+    double s = 0.8 * sqrt(tilt * tilt - 1);
+    // Blur in place, except the input image
+    cv::Mat blurred = rotated.data == img.data ? bufferHeader(buffers.rotated, h, w) : rotated;
+    cv::GaussianBlur(rotated, blurred, cv::Size(0, 0), s, 0.01);
+    timg = bufferHeader(buffers.skewed, blurred.rows, cv::saturate_cast<int>(blurred.cols * (1.0 / tilt)));
+    cv::resize(blurred, timg, cv::Size(0, 0), 1.0 / tilt, 1.0, cv::INTER_NEAREST);
+    A.row(0) = A.row(0) / tilt;
+  } else {
+    timg = rotated;
+  }
+  // if (tilt != 1.0 || phi != 0.0) {
+  if (std::fabs(tilt - 1.0) > std::numeric_limits<double>::epsilon() ||
+      std::fabs(phi) > std::numeric_limits<double>::epsilon()) {
+    mask = bufferHeader(buffers.mask, timg.rows, timg.cols);
+    cv::warpAffine(fullMask, mask, A, timg.size(), cv::INTER_NEAREST);
+  } else {
+    mask = fullMask;
+  }
+  cv::invertAffineTransform(A, Ai);
+}
+
 }
 
 /*!
@@ -78,17 +468,23 @@ inline vpImagePoint matchRansacToVpImage(const std::pair<cv::KeyPoint, cv::Point
  */
 vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatureDescriptorType &descriptorType,
                        const std::string &matcherName, const vpFilterMatchingType &filterType)
-  : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
+  : m_affineViewInliers(), m_affineViewOffsets(), m_binaryMatcher(), m_computeCovariance(false), m_covarianceMatrix(),
+    m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(), m_detectors(),
     m_extractionTime(0.), m_extractorNames(), m_extractors(), m_filteredMatches(), m_filterType(filterType),
-    m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(), m_matcher(),
+    m_imageFormat(jpgImageFormat), m_knnMatches(),
+#ifdef VISP_HAVE_MODULE_IO
+    m_learningFile(),
+#endif
+    m_mapOfImageId(), m_mapOfImagePaths(), m_mapOfImages(), m_matcher(),
     m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85),
     m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100),
     m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
     m_ransacConsensusPercentage(20.0), m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(), m_ransacOutliers(),
     m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0),
     m_ransacThreshold(0.01), m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(), m_trainVpPoints(),
-    m_useAffineDetection(false),
+    m_useAffineDetection(false), m_useAffineViewSelection(false), m_useBinaryMatcher(false),
+    m_useBinaryMatcherMutualCheck(false),
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
     m_useBruteForceCrossCheck(true),
 #endif
@@ -114,17 +510,23 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
  */
 vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extractorName,
                        const std::string &matcherName, const vpFilterMatchingType &filterType)
-  : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
+  : m_affineViewInliers(), m_affineViewOffsets(), m_binaryMatcher(), m_computeCovariance(false), m_covarianceMatrix(),
+    m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(), m_detectors(),
     m_extractionTime(0.), m_extractorNames(), m_extractors(), m_filteredMatches(), m_filterType(filterType),
-    m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(), m_matcher(),
+    m_imageFormat(jpgImageFormat), m_knnMatches(),
+#ifdef VISP_HAVE_MODULE_IO
+    m_learningFile(),
+#endif
+    m_mapOfImageId(), m_mapOfImagePaths(), m_mapOfImages(), m_matcher(),
     m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85),
     m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100),
     m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
     m_ransacConsensusPercentage(20.0), m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(), m_ransacOutliers(),
     m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0),
     m_ransacThreshold(0.01), m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(), m_trainVpPoints(),
-    m_useAffineDetection(false),
+    m_useAffineDetection(false), m_useAffineViewSelection(false), m_useBinaryMatcher(false),
+    m_useBinaryMatcherMutualCheck(false),
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
     m_useBruteForceCrossCheck(true),
 #endif
@@ -150,16 +552,21 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
  */
 vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std::vector<std::string> &extractorNames,
                        const std::string &matcherName, const vpFilterMatchingType &filterType)
-  : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
+  : m_affineViewInliers(), m_affineViewOffsets(), m_binaryMatcher(), m_computeCovariance(false), m_covarianceMatrix(),
+    m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(detectorNames),
     m_detectors(), m_extractionTime(0.), m_extractorNames(extractorNames), m_extractors(), m_filteredMatches(),
-    m_filterType(filterType), m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
-    m_matcher(), m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0),
+    m_filterType(filterType), m_imageFormat(jpgImageFormat), m_knnMatches(),
+#ifdef VISP_HAVE_MODULE_IO
+    m_learningFile(),
+#endif
+    m_mapOfImageId(), m_mapOfImagePaths(), m_mapOfImages(), m_matcher(), m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0),
     m_matchingRatioThreshold(0.85), m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200),
     m_nbRansacMinInlierCount(100), m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(),
     m_queryFilteredKeyPoints(), m_queryKeyPoints(), m_ransacConsensusPercentage(20.0), m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(),
     m_ransacOutliers(), m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0), m_ransacThreshold(0.01),
     m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(), m_trainVpPoints(), m_useAffineDetection(false),
+    m_useAffineViewSelection(false), m_useBinaryMatcher(false), m_useBinaryMatcherMutualCheck(false),
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
     m_useBruteForceCrossCheck(true),
 #endif
@@ -170,63 +577,6 @@ vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std:
   init();
 }
 
-/*!
-   Apply an affine and skew transformation to an image.
-   \param tilt : Tilt value in the direction of x
-   \param phi : Rotation value
-   \param img : Modified image after the transformation
-   \param mask : Mask containing the location of the image pixels after the
-   transformation \param Ai : Inverse affine matrix
- */
-void vpKeyPoint::affineSkew(double tilt, double phi, cv::Mat &img, cv::Mat &mask, cv::Mat &Ai)
-{
-  int h = img.rows;
-  int w = img.cols;
-
-  mask = cv::Mat(h, w, CV_8UC1, cv::Scalar(255));
-
-  cv::Mat A = cv::Mat::eye(2, 3, CV_32F);
-
-  // if (phi != 0.0) {
-  if (std::fabs(phi) > std::numeric_limits<double>::epsilon()) {
-    phi *= M_PI / 180.;
-    double s = sin(phi);
-    double c = cos(phi);
-
-    A = (cv::Mat_<float>(2, 2) << c, -s, s, c);
-
-    cv::Mat corners = (cv::Mat_<float>(4, 2) << 0, 0, w, 0, w, h, 0, h);
-    cv::Mat tcorners = corners * A.t();
-    cv::Mat tcorners_x, tcorners_y;
-    tcorners.col(0).copyTo(tcorners_x);
-    tcorners.col(1).copyTo(tcorners_y);
-    std::vector<cv::Mat> channels;
-    channels.push_back(tcorners_x);
-    channels.push_back(tcorners_y);
-    cv::merge(channels, tcorners);
-
-    cv::Rect rect = cv::boundingRect(tcorners);
-    A = (cv::Mat_<float>(2, 3) << c, -s, -rect.x, s, c, -rect.y);
-
-    cv::warpAffine(img, img, A, cv::Size(rect.width, rect.height), cv::INTER_LINEAR, cv::BORDER_REPLICATE);
-  }
-  // if (tilt != 1.0) {
-  if (std::fabs(tilt - 1.0) > std::numeric_limits<double>::epsilon()) {
-    double s = 0.8 * sqrt(tilt * tilt - 1);
-    cv::GaussianBlur(img, img, cv::Size(0, 0), s, 0.01);
-    cv::resize(img, img, cv::Size(0, 0), 1.0 / tilt, 1.0, cv::INTER_NEAREST);
-    A.row(0) = A.row(0) / tilt;
-  }
-  // if (tilt != 1.0 || phi != 0.0) {
-  if (std::fabs(tilt - 1.0) > std::numeric_limits<double>::epsilon() ||
-      std::fabs(phi) > std::numeric_limits<double>::epsilon()) {
-    h = img.rows;
-    w = img.cols;
-    cv::warpAffine(mask, mask, A, cv::Size(w, h), cv::INTER_NEAREST);
-  }
-  cv::invertAffineTransform(A, Ai);
-}
-
 /*!
    Build the reference keypoints list.
 
@@ -264,33 +614,15 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const v
   // So as no 3D point list is passed, we dont need this variables
   m_trainPoints.clear();
   m_mapOfImageId.clear();
+  m_mapOfImagePaths.clear();
   m_mapOfImages.clear();
   m_currentImageId = 1;
 
+  // Never write the new descriptors in place in a memory mapped learning file
+  m_trainDescriptors.release();
   if (m_useAffineDetection) {
-    std::vector<std::vector<cv::KeyPoint> > listOfTrainKeyPoints;
-    std::vector<cv::Mat> listOfTrainDescriptors;
-
     // Detect keypoints and extract descriptors on multiple images
-    detectExtractAffine(I, listOfTrainKeyPoints, listOfTrainDescriptors);
-
-    // Flatten the different train lists
-    m_trainKeyPoints.clear();
-    for (std::vector<std::vector<cv::KeyPoint> >::const_iterator it = listOfTrainKeyPoints.begin();
-         it != listOfTrainKeyPoints.end(); ++it) {
-      m_trainKeyPoints.insert(m_trainKeyPoints.end(), it->begin(), it->end());
-    }
-
-    bool first = true;
-    for (std::vector<cv::Mat>::const_iterator it = listOfTrainDescriptors.begin(); it != listOfTrainDescriptors.end();
-         ++it) {
-      if (first) {
-        first = false;
-        it->copyTo(m_trainDescriptors);
-      } else {
-        m_trainDescriptors.push_back(*it);
-      }
-    }
+    detectExtractAffine(I, m_trainKeyPoints, m_trainDescriptors, false);
   } else {
     detect(I, m_trainKeyPoints, m_detectionTime, rectangle);
     extract(I, m_trainKeyPoints, m_trainDescriptors, m_extractionTime);
@@ -311,8 +643,7 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const v
   _reference_computed = true;
 
   // Add train descriptors in matcher object
-  m_matcher->clear();
-  m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  trainMatcher();
 
   return static_cast<unsigned int>(m_trainKeyPoints.size());
 }
@@ -381,6 +712,7 @@ void vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const std::vect
   if (!append) {
     m_currentImageId = 0;
     m_mapOfImageId.clear();
+    m_mapOfImagePaths.clear();
     m_mapOfImages.clear();
     this->m_trainKeyPoints.clear();
     this->m_trainPoints.clear();
@@ -409,6 +741,8 @@ void vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const std::vect
   // Append reference lists
   this->m_trainKeyPoints.insert(this->m_trainKeyPoints.end(), trainKeyPoints_tmp.begin(), trainKeyPoints_tmp.end());
   if (!append) {
+    // Never copy in place in a memory mapped learning file
+    this->m_trainDescriptors.release();
     trainDescriptors.copyTo(this->m_trainDescriptors);
   } else {
     this->m_trainDescriptors.push_back(trainDescriptors);
@@ -420,8 +754,7 @@ void vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const std::vect
   vpConvert::convertFromOpenCV(this->m_trainPoints, m_trainVpPoints);
 
   // Add train descriptors in matcher object
-  m_matcher->clear();
-  m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  trainMatcher();
 
   _reference_computed = true;
 }
@@ -1044,6 +1377,8 @@ void vpKeyPoint::createImageMatching(vpImage<unsigned char> &IRef, vpImage<unsig
  */
 void vpKeyPoint::createImageMatching(vpImage<unsigned char> &ICurrent, vpImage<unsigned char> &IMatching)
 {
+  loadTrainingImages();
+
   // Nb images in the training database + the current image we want to detect
   // the object
   unsigned int nbImg = (unsigned int)(m_mapOfImages.size() + 1);
@@ -1256,6 +1591,8 @@ void vpKeyPoint::displayMatching(const vpImage<unsigned char> &ICurrent, vpImage
                                  const std::vector<vpImagePoint> &ransacInliers, unsigned int crossSize,
                                  unsigned int lineThickness)
 {
+  loadTrainingImages();
+
   if (m_mapOfImages.empty() || m_mapOfImageId.empty()) {
     // No training images so return
     std::cerr << "There is no training image loaded !" << std::endl;
@@ -1702,6 +2039,22 @@ void vpKeyPoint::getQueryKeyPoints(std::vector<cv::KeyPoint> &keyPoints) const {
  */
 void vpKeyPoint::getQueryKeyPoints(std::vector<vpImagePoint> &keyPoints) const { keyPoints = currentImagePointsList; }
 
+/*!
+   Get the train descriptors matrix.
+
+   \return : Matrix with descriptors values at each row for each train
+   keypoints (or reference keypoints).
+ */
+cv::Mat vpKeyPoint::getTrainDescriptors() const
+{
+  // The memory mapped learning file is only kept by this object, do not
+  // return a matrix that references it
+  if (mappedTrainDescriptors()) {
+    return m_trainDescriptors.clone();
+  }
+  return m_trainDescriptors;
+}
+
 /*!
    Get the train keypoints list in OpenCV type.
 
@@ -2251,6 +2604,8 @@ void vpKeyPoint::insertImageMatching(const vpImage<unsigned char> &IRef, const v
  */
 void vpKeyPoint::insertImageMatching(const vpImage<unsigned char> &ICurrent, vpImage<unsigned char> &IMatching)
 {
+  loadTrainingImages();
+
   // Nb images in the training database + the current image we want to detect
   // the object
   int nbImg = (int)(m_mapOfImages.size() + 1);
@@ -2390,10 +2745,20 @@ void vpKeyPoint::loadConfigFile(const std::string &configFile)
 /*!
    Load learning data saved on disk.
 
+   A binary learning file written by saveLearningData() is memory mapped and
+   its descriptors are used in place, without any copy, unless they are
+   appended to other learning data. Binary files written by previous
+   versions of ViSP are still read value by value.
+
+   The training images are not read here but on first use, by
+   createImageMatching(), displayMatching(), insertImageMatching() or
+   saveLearningData().
+
    \param filename : Path of the learning file.
    \param binaryMode : If true, the learning file is in a binary mode,
    otherwise it is in XML mode. \param append : If true, concatenate the
-   learning data, otherwise reset the variables.
+   learning data, otherwise reset the variables. The learning data already
+   loaded are not read again.
  */
 void vpKeyPoint::loadLearningData(const std::string &filename, const bool binaryMode, const bool append)
 {
@@ -2403,6 +2768,7 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
     m_trainKeyPoints.clear();
     m_trainPoints.clear();
     m_mapOfImageId.clear();
+    m_mapOfImagePaths.clear();
     m_mapOfImages.clear();
   } else {
     // In append case, find the max index of keypoint class Id
@@ -2427,7 +2793,10 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
     parent += "/";
   }
 
-  if (binaryMode) {
+  if (binaryMode && isLearningFile(filename)) {
+    loadLearningFile(filename, parent, startClassId, startImageId, append);
+  } else if (binaryMode) {
+    // Learning file written before the memory mapped layout
     std::ifstream file(filename.c_str(), std::ifstream::binary);
     if (!file.is_open()) {
       throw vpException(vpException::ioError, "Cannot open the file.");
@@ -2463,16 +2832,11 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
       }
       path[length] = '\0';
 
-      vpImage<unsigned char> I;
 #ifdef VISP_HAVE_MODULE_IO
-      if (vpIoTools::isAbsolutePathname(std::string(path))) {
-        vpImageIo::read(I, path);
-      } else {
-        vpImageIo::read(I, parent + path);
-      }
-
-      // Add the image previously loaded only if VISP_HAVE_MODULE_IO
-      m_mapOfImages[id + startImageId] = I;
+      // The training image is read on first use, see loadTrainingImages()
+      m_mapOfImages[id + startImageId] = vpImage<unsigned char>();
+      m_mapOfImagePaths[id + startImageId] =
+          vpIoTools::isAbsolutePathname(std::string(path)) ? std::string(path) : parent + path;
 #endif
 
       // Delete path
@@ -2583,7 +2947,7 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
     }
 
     if (!append || m_trainDescriptors.empty()) {
-      trainDescriptorsTmp.copyTo(m_trainDescriptors);
+      m_trainDescriptors = trainDescriptorsTmp;
     } else {
       cv::vconcat(m_trainDescriptors, trainDescriptorsTmp, m_trainDescriptors);
     }
@@ -2637,18 +3001,12 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
             }
             xmlFree(image_id_property);
 
-            vpImage<unsigned char> I;
 #ifdef VISP_HAVE_MODULE_IO
             std::string path((char *)image_info_node->children->content);
-            // Read path to the training images
-            if (vpIoTools::isAbsolutePathname(std::string(path))) {
-              vpImageIo::read(I, path);
-            } else {
-              vpImageIo::read(I, parent + path);
-            }
-
-            // Add the image previously loaded only if VISP_HAVE_MODULE_IO
-            m_mapOfImages[id + startImageId] = I;
+            // The training image is read on first use, see
+            // loadTrainingImages()
+            m_mapOfImages[id + startImageId] = vpImage<unsigned char>();
+            m_mapOfImagePaths[id + startImageId] = vpIoTools::isAbsolutePathname(path) ? path : parent + path;
 #endif
           }
         }
@@ -2783,7 +3141,7 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
     }
 
     if (!append || m_trainDescriptors.empty()) {
-      trainDescriptorsTmp.copyTo(m_trainDescriptors);
+      m_trainDescriptors = trainDescriptorsTmp;
     } else {
       cv::vconcat(m_trainDescriptors, trainDescriptorsTmp, m_trainDescriptors);
     }
@@ -2806,8 +3164,7 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
   vpConvert::convertFromOpenCV(this->m_trainPoints, m_trainVpPoints);
 
   // Add train descriptors in matcher object
-  m_matcher->clear();
-  m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  trainMatcher();
 
   // Set _reference_computed to true as we load a learning file
   _reference_computed = true;
@@ -2817,27 +3174,176 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
 }
 
 /*!
-   Match keypoints based on distance between their descriptors.
+   Load a learning file written by saveLearningData() in binary mode. When
+   visp_io is available the file is memory mapped and, if the learning data
+   are not appended, the train descriptors are used in place.
 
-   \param trainDescriptors : Train descriptors (or reference descriptors).
-   \param queryDescriptors : Query descriptors.
-   \param matches : Output list of matches.
-   \param elapsedTime : Elapsed time.
+   \param filename : Path of the learning file.
+   \param parent : Directory of the learning file, ended by a slash, or an
+   empty string.
+   \param startClassId : Offset added to the class id of the keypoints.
+   \param startImageId : Offset added to the id of the training images.
+   \param append : If true, the descriptors are concatenated to the train
+   descriptors.
  */
-void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDescriptors,
-                       std::vector<cv::DMatch> &matches, double &elapsedTime)
+void vpKeyPoint::loadLearningFile(const std::string &filename, const std::string &parent, const int startClassId,
+                                  const int startImageId, const bool append)
 {
-  double t = vpTime::measureTimeMs();
+#ifdef VISP_HAVE_MODULE_IO
+  cv::Ptr<vpMemoryMappedFile> file(new vpMemoryMappedFile());
+  file->open(filename);
+  const unsigned char *data = file->getData();
+  const size_t size = file->getSize();
+#else
+  // Without visp_io the whole file is read at once
+  std::ifstream file(filename.c_str(), std::ifstream::binary);
+  if (!file.is_open()) {
+    throw vpException(vpException::ioError, "Cannot open the file.");
+  }
+  file.seekg(0, std::ifstream::end);
+  std::vector<unsigned char> buffer((size_t)file.tellg() + 1);
+  file.seekg(0, std::ifstream::beg);
+  file.read((char *)&buffer[0], (std::streamsize)buffer.size());
+  const unsigned char *data = &buffer[0];
+  const size_t size = (size_t)file.gcount();
+#endif
 
-  if (m_useKnn) {
-    m_knnMatches.clear();
+  if (size < vp_kp_header_size || memcmp(data, vp_kp_magic, sizeof(vp_kp_magic)) != 0) {
+    throw vpException(vpException::ioError, "\"%s\" is not a learning file", filename.c_str());
+  }
+  if (getLearningValue<uint32_t>(data, vp_kp_offset_byte_order) != vp_kp_byte_order) {
+    throw vpException(vpException::ioError, "Learning file \"%s\" was written with another byte order",
+                      filename.c_str());
+  }
+  if (getLearningValue<uint32_t>(data, vp_kp_offset_version) != vp_kp_version ||
+      getLearningValue<uint32_t>(data, vp_kp_offset_header_size) != vp_kp_header_size) {
+    throw vpException(vpException::ioError, "Unsupported learning file \"%s\"", filename.c_str());
+  }
 
-    if (m_useMatchTrainToQuery) {
-      std::vector<std::vector<cv::DMatch> > knnMatchesTmp;
+  const int nRows = (int)getLearningValue<uint32_t>(data, vp_kp_offset_nb_keypoints);
+  const int nCols = (int)getLearningValue<uint32_t>(data, vp_kp_offset_descriptor_cols);
+  const int descriptorType = getLearningValue<int>(data, vp_kp_offset_descriptor_type);
+  const size_t step = getLearningValue<uint32_t>(data, vp_kp_offset_descriptor_step);
+  const bool have3DInfo = getLearningValue<uint32_t>(data, vp_kp_offset_have_3d) != 0;
+  const int nbImgs = (int)getLearningValue<uint32_t>(data, vp_kp_offset_nb_images);
+  const size_t imagesSize = getLearningValue<uint32_t>(data, vp_kp_offset_images_size);
+  const vpLearningFileLayout layout((size_t)nRows, have3DInfo, imagesSize, step);
+
+  if (nRows < 0 || nCols < 0 || CV_MAT_CN(descriptorType) != 1 || CV_MAT_DEPTH(descriptorType) > CV_64F ||
+      step < (size_t)nCols * CV_ELEM_SIZE(descriptorType) || size < layout.size) {
+    throw vpException(vpException::ioError, "Learning file \"%s\" is truncated or corrupted", filename.c_str());
+  }
 
-      // Match train descriptors to query descriptors
-      cv::Ptr<cv::DescriptorMatcher> matcherTmp = m_matcher->clone(true);
-      matcherTmp->knnMatch(trainDescriptors, queryDescriptors, knnMatchesTmp, 2);
+  // Read info about training images
+#ifdef VISP_HAVE_MODULE_IO
+  size_t offset = layout.images;
+  for (int i = 0; i < nbImgs; i++) {
+    if (offset + 2 * sizeof(uint32_t) > layout.images + imagesSize) {
+      throw vpException(vpException::ioError, "Learning file \"%s\" is corrupted", filename.c_str());
+    }
+    int id = getLearningValue<int>(data, offset);
+    size_t length = getLearningValue<uint32_t>(data, offset + sizeof(uint32_t));
+    offset += 2 * sizeof(uint32_t);
+    if (offset + length > layout.images + imagesSize) {
+      throw vpException(vpException::ioError, "Learning file \"%s\" is corrupted", filename.c_str());
+    }
+    std::string path((const char *)data + offset, length);
+    offset = alignLearningOffset(offset + length, sizeof(uint32_t));
+
+    // The training image is read on first use, see loadTrainingImages()
+    m_mapOfImages[id + startImageId] = vpImage<unsigned char>();
+    m_mapOfImagePaths[id + startImageId] = vpIoTools::isAbsolutePathname(path) ? path : parent + path;
+  }
+#else
+  (void)parent;
+  (void)startImageId;
+  if (nbImgs > 0) {
+    std::cout << "Warning: The learning file contains image data that will "
+                 "not be loaded as visp_io module "
+                 "is not available !"
+              << std::endl;
+  }
+#endif
+
+  // Read the keypoints and the 3D points
+  m_trainKeyPoints.reserve(m_trainKeyPoints.size() + (size_t)nRows);
+  if (have3DInfo) {
+    m_trainPoints.reserve(m_trainPoints.size() + (size_t)nRows);
+  }
+
+  for (int i = 0; i < nRows; i++) {
+    const unsigned char *keyPointData = data + layout.keyPoints + (size_t)i * vp_kp_keypoint_size;
+    cv::KeyPoint keyPoint(
+        cv::Point2f(getLearningValue<float>(keyPointData, 0), getLearningValue<float>(keyPointData, 4)),
+        getLearningValue<float>(keyPointData, 8), getLearningValue<float>(keyPointData, 12),
+        getLearningValue<float>(keyPointData, 16), getLearningValue<int>(keyPointData, 20),
+        getLearningValue<int>(keyPointData, 24) + startClassId);
+    m_trainKeyPoints.push_back(keyPoint);
+
+#ifdef VISP_HAVE_MODULE_IO
+    // No training images if image_id == -1
+    int image_id = getLearningValue<int>(keyPointData, 28);
+    if (image_id != -1) {
+      m_mapOfImageId[keyPoint.class_id] = image_id + startImageId;
+    }
+#endif
+
+    if (have3DInfo) {
+      const unsigned char *pointData = data + layout.points + (size_t)i * vp_kp_point_size;
+      m_trainPoints.push_back(cv::Point3f(getLearningValue<float>(pointData, 0), getLearningValue<float>(pointData, 4),
+                                          getLearningValue<float>(pointData, 8)));
+    }
+  }
+
+  // Read the descriptors
+  cv::Mat trainDescriptorsTmp;
+  if (nRows > 0) {
+    trainDescriptorsTmp = cv::Mat(nRows, nCols, descriptorType, (void *)(data + layout.descriptors), step);
+  }
+
+  if (!append || m_trainDescriptors.empty()) {
+#ifdef VISP_HAVE_MODULE_IO
+    // The descriptors are used in place, the mapping is kept as long as they
+    // are the train descriptors
+    m_trainDescriptors = trainDescriptorsTmp;
+    m_learningFile = file;
+#else
+    trainDescriptorsTmp.copyTo(m_trainDescriptors);
+#endif
+  } else if (!trainDescriptorsTmp.empty()) {
+    cv::vconcat(m_trainDescriptors, trainDescriptorsTmp, m_trainDescriptors);
+  }
+}
+
+/*!
+   Match keypoints based on distance between their descriptors.
+
+   \param trainDescriptors : Train descriptors (or reference descriptors).
+   \param queryDescriptors : Query descriptors.
+   \param matches : Output list of matches.
+   \param elapsedTime : Elapsed time.
+ */
+void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDescriptors,
+                       std::vector<cv::DMatch> &matches, double &elapsedTime)
+{
+  double t = vpTime::measureTimeMs();
+
+  // The binary matcher is trained with m_trainDescriptors
+  if (useBinaryMatcher() && (!m_useMatchTrainToQuery || trainDescriptors.data == m_trainDescriptors.data)) {
+    matchBinary(queryDescriptors, matches);
+    elapsedTime = vpTime::measureTimeMs() - t;
+    return;
+  }
+
+  if (m_useKnn) {
+    m_knnMatches.clear();
+
+    if (m_useMatchTrainToQuery) {
+      std::vector<std::vector<cv::DMatch> > knnMatchesTmp;
+
+      // Match train descriptors to query descriptors
+      cv::Ptr<cv::DescriptorMatcher> matcherTmp = m_matcher->clone(true);
+      matcherTmp->knnMatch(trainDescriptors, queryDescriptors, knnMatchesTmp, 2);
 
       for (std::vector<std::vector<cv::DMatch> >::const_iterator it1 = knnMatchesTmp.begin();
            it1 != knnMatchesTmp.end(); ++it1) {
@@ -2922,29 +3428,8 @@ unsigned int vpKeyPoint::matchPoint(const vpImage<unsigned char> &I, const vpRec
   }
 
   if (m_useAffineDetection) {
-    std::vector<std::vector<cv::KeyPoint> > listOfQueryKeyPoints;
-    std::vector<cv::Mat> listOfQueryDescriptors;
-
     // Detect keypoints and extract descriptors on multiple images
-    detectExtractAffine(I, listOfQueryKeyPoints, listOfQueryDescriptors);
-
-    // Flatten the different train lists
-    m_queryKeyPoints.clear();
-    for (std::vector<std::vector<cv::KeyPoint> >::const_iterator it = listOfQueryKeyPoints.begin();
-         it != listOfQueryKeyPoints.end(); ++it) {
-      m_queryKeyPoints.insert(m_queryKeyPoints.end(), it->begin(), it->end());
-    }
-
-    bool first = true;
-    for (std::vector<cv::Mat>::const_iterator it = listOfQueryDescriptors.begin(); it != listOfQueryDescriptors.end();
-         ++it) {
-      if (first) {
-        first = false;
-        it->copyTo(m_queryDescriptors);
-      } else {
-        m_queryDescriptors.push_back(*it);
-      }
-    }
+    detectExtractAffine(I, m_queryKeyPoints, m_queryDescriptors, true);
   } else {
     detect(I, m_queryKeyPoints, m_detectionTime, rectangle);
     extract(I, m_queryKeyPoints, m_queryDescriptors, m_extractionTime);
@@ -3043,29 +3528,8 @@ bool vpKeyPoint::matchPoint(const vpImage<unsigned char> &I, const vpCameraParam
   }
 
   if (m_useAffineDetection) {
-    std::vector<std::vector<cv::KeyPoint> > listOfQueryKeyPoints;
-    std::vector<cv::Mat> listOfQueryDescriptors;
-
     // Detect keypoints and extract descriptors on multiple images
-    detectExtractAffine(I, listOfQueryKeyPoints, listOfQueryDescriptors);
-
-    // Flatten the different train lists
-    m_queryKeyPoints.clear();
-    for (std::vector<std::vector<cv::KeyPoint> >::const_iterator it = listOfQueryKeyPoints.begin();
-         it != listOfQueryKeyPoints.end(); ++it) {
-      m_queryKeyPoints.insert(m_queryKeyPoints.end(), it->begin(), it->end());
-    }
-
-    bool first = true;
-    for (std::vector<cv::Mat>::const_iterator it = listOfQueryDescriptors.begin(); it != listOfQueryDescriptors.end();
-         ++it) {
-      if (first) {
-        first = false;
-        it->copyTo(m_queryDescriptors);
-      } else {
-        m_queryDescriptors.push_back(*it);
-      }
-    }
+    detectExtractAffine(I, m_queryKeyPoints, m_queryDescriptors, true);
   } else {
     detect(I, m_queryKeyPoints, m_detectionTime, rectangle);
     extract(I, m_queryKeyPoints, m_queryDescriptors, m_extractionTime);
@@ -3163,6 +3627,10 @@ bool vpKeyPoint::matchPoint(const vpImage<unsigned char> &I, const vpCameraParam
     std::transform(m_matchRansacKeyPointsToPoints.begin(), m_matchRansacKeyPointsToPoints.end(),
                    m_ransacInliers.begin(), matchRansacToVpImage);
 
+    if (m_useAffineDetection) {
+      updateAffineViewSelection(res);
+    }
+
     elapsedTime += m_poseTime;
 
     return res;
@@ -3193,6 +3661,10 @@ bool vpKeyPoint::matchPoint(const vpImage<unsigned char> &I, const vpCameraParam
     std::transform(m_matchRansacKeyPointsToPoints.begin(), m_matchRansacKeyPointsToPoints.end(),
                    m_ransacInliers.begin(), matchRansacToVpImage);
 
+    if (m_useAffineDetection) {
+      updateAffineViewSelection(res);
+    }
+
     elapsedTime += m_poseTime;
 
     return res;
@@ -3403,7 +3875,12 @@ bool vpKeyPoint::matchPointAndDetect(const vpImage<unsigned char> &I, const vpCa
     See http://www.ipol.im/pub/algo/my_affine_sift/ for the details.
     See https://github.com/Itseez/opencv/blob/master/samples/python2/asift.py
    for the Python implementation by Itseez and Matt Sheckells for the current
-   implementation in C++. \param I : Input image \param listOfKeypoints : List
+   implementation in C++.
+
+   The views are simulated in parallel, the most expensive ones first, each
+   thread reusing the same buffers for all its views.
+
+   \param I : Input image \param listOfKeypoints : List
    of detected keypoints in the multiple images after affine transformations
     \param listOfDescriptors : Corresponding list of descriptors
     \param listOfAffineI : Optional parameter, list of images after affine
@@ -3414,130 +3891,200 @@ void vpKeyPoint::detectExtractAffine(const vpImage<unsigned char> &I,
                                      std::vector<cv::Mat> &listOfDescriptors,
                                      std::vector<vpImage<unsigned char> > *listOfAffineI)
 {
-#if 0
-  cv::Mat img;
-  vpImageConvert::convert(I, img);
-  listOfKeypoints.clear();
-  listOfDescriptors.clear();
-
-  for (int tl = 1; tl < 6; tl++) {
-    double t = pow(2, 0.5 * tl);
-    for (int phi = 0; phi < 180; phi += (int)(72.0 / t)) {
-      std::vector<cv::KeyPoint> keypoints;
-      cv::Mat descriptors;
-
-      cv::Mat timg, mask, Ai;
-      img.copyTo(timg);
-
-      affineSkew(t, phi, timg, mask, Ai);
+  detectExtractAffineViews(I, std::vector<bool>(), listOfKeypoints, listOfDescriptors, listOfAffineI);
+}
 
+/*!
+   Detect keypoints and extract descriptors on multiple affine
+   transformations of the image, and merge them in a single list.
 
-      if(listOfAffineI != NULL) {
-        cv::Mat img_disp;
-        bitwise_and(mask, timg, img_disp);
-        vpImage<unsigned char> tI;
-        vpImageConvert::convert(img_disp, tI);
-        listOfAffineI->push_back(tI);
+   \param I : Input image.
+   \param keyPoints : Keypoints of all the views, in the input image
+   coordinates.
+   \param descriptors : Corresponding descriptors.
+   \param useViewSelection : True for the query keypoints: the views that
+   are predicted useless by the last pose estimation are skipped if
+   setUseAffineViewSelection() is enabled.
+ */
+void vpKeyPoint::detectExtractAffine(const vpImage<unsigned char> &I, std::vector<cv::KeyPoint> &keyPoints,
+                                     cv::Mat &descriptors, const bool useViewSelection)
+{
+  std::vector<vpAffineView> views;
+  computeAffineViews((int)I.getWidth(), (int)I.getHeight(), views);
+
+  // Keep the views close to those that provided inliers to the last pose
+  std::vector<bool> selectedViews;
+  if (useViewSelection && m_useAffineViewSelection && m_affineViewInliers.size() == views.size()) {
+    selectedViews.resize(views.size(), false);
+    bool hasInliers = false;
+    for (size_t i = 0; i < views.size(); i++) {
+      if (m_affineViewInliers[i] > 0) {
+        hasInliers = true;
+        for (size_t j = 0; j < views.size(); j++) {
+          if (areNeighborAffineViews(views[i], views[j])) {
+            selectedViews[j] = true;
+          }
+        }
       }
-#if 0
-      cv::Mat img_disp;
-      cv::bitwise_and(mask, timg, img_disp);
-      cv::namedWindow( "Skew", cv::WINDOW_AUTOSIZE ); // Create a window for display.
-      cv::imshow( "Skew", img_disp );
-      cv::waitKey(0);
-#endif
+    }
 
-      for(std::map<std::string, cv::Ptr<cv::FeatureDetector> >::const_iterator it = m_detectors.begin();
-          it != m_detectors.end(); ++it) {
-        std::vector<cv::KeyPoint> kp;
-        it->second->detect(timg, kp, mask);
-        keypoints.insert(keypoints.end(), kp.begin(), kp.end());
-      }
+    if (!hasInliers) {
+      selectedViews.clear();
+    }
+  }
 
-      double elapsedTime;
-      extract(timg, keypoints, descriptors, elapsedTime);
+  std::vector<std::vector<cv::KeyPoint> > listOfKeypoints;
+  std::vector<cv::Mat> listOfDescriptors;
+  detectExtractAffineViews(I, selectedViews, listOfKeypoints, listOfDescriptors, NULL);
+
+  // Each view is copied at its offset in the merged lists, without
+  // synchronization
+  std::vector<size_t> offsets(listOfKeypoints.size() + 1, 0);
+  int descriptorCols = 0, descriptorType = CV_8U;
+  for (size_t i = 0; i < listOfKeypoints.size(); i++) {
+    offsets[i + 1] = offsets[i] + listOfKeypoints[i].size();
+    if (!listOfDescriptors[i].empty()) {
+      descriptorCols = listOfDescriptors[i].cols;
+      descriptorType = listOfDescriptors[i].type();
+    }
+  }
 
-      for(unsigned int i = 0; i < keypoints.size(); i++) {
-        cv::Point3f kpt(keypoints[i].pt.x, keypoints[i].pt.y, 1.f);
-        cv::Mat kpt_t = Ai * cv::Mat(kpt);
-        keypoints[i].pt.x = kpt_t.at<float>(0, 0);
-        keypoints[i].pt.y = kpt_t.at<float>(1, 0);
-      }
+  keyPoints.resize(offsets.back());
+  descriptors = offsets.back() > 0 ? cv::Mat((int)offsets.back(), descriptorCols, descriptorType) : cv::Mat();
 
-      listOfKeypoints.push_back(keypoints);
-      listOfDescriptors.push_back(descriptors);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = 0; i < (int)listOfKeypoints.size(); i++) {
+    if (!listOfKeypoints[(size_t)i].empty()) {
+      std::copy(listOfKeypoints[(size_t)i].begin(), listOfKeypoints[(size_t)i].end(),
+                keyPoints.begin() + (std::ptrdiff_t)offsets[(size_t)i]);
+      cv::Mat rows = descriptors.rowRange((int)offsets[(size_t)i], (int)offsets[(size_t)i + 1]);
+      listOfDescriptors[(size_t)i].copyTo(rows);
     }
   }
 
-#else
+  if (useViewSelection) {
+    m_affineViewOffsets = offsets;
+  }
+}
+
+/*!
+   Detect keypoints and extract descriptors on the selected affine
+   transformations of the image.
+
+   \param I : Input image.
+   \param selectedViews : Views to simulate, all the views if empty.
+   \param listOfKeypoints : Keypoints of each view, in the input image
+   coordinates, empty for the views that are not selected.
+   \param listOfDescriptors : Corresponding descriptors.
+   \param listOfAffineI : If not NULL, images after affine transformations.
+ */
+void vpKeyPoint::detectExtractAffineViews(const vpImage<unsigned char> &I, const std::vector<bool> &selectedViews,
+                                          std::vector<std::vector<cv::KeyPoint> > &listOfKeypoints,
+                                          std::vector<cv::Mat> &listOfDescriptors,
+                                          std::vector<vpImage<unsigned char> > *listOfAffineI)
+{
   cv::Mat img;
   vpImageConvert::convert(I, img);
+  const cv::Mat fullMask(img.rows, img.cols, CV_8UC1, cv::Scalar(255));
 
-  // Create a vector for storing the affine skew parameters
-  std::vector<std::pair<double, int> > listOfAffineParams;
-  for (int tl = 1; tl < 6; tl++) {
-    double t = pow(2, 0.5 * tl);
-    for (int phi = 0; phi < 180; phi += (int)(72.0 / t)) {
-      listOfAffineParams.push_back(std::pair<double, int>(t, phi));
+  std::vector<vpAffineView> views;
+  computeAffineViews(img.cols, img.rows, views);
+
+  // Most expensive views first so that the last views given to the threads
+  // are the shortest ones
+  std::vector<vpAffineView> sortedViews;
+  for (size_t i = 0; i < views.size(); i++) {
+    if (selectedViews.empty() || selectedViews[i]) {
+      sortedViews.push_back(views[i]);
     }
   }
+  std::stable_sort(sortedViews.begin(), sortedViews.end(), compareAffineViewCost);
 
-  listOfKeypoints.resize(listOfAffineParams.size());
-  listOfDescriptors.resize(listOfAffineParams.size());
+  listOfKeypoints.assign(views.size(), std::vector<cv::KeyPoint>());
+  listOfDescriptors.assign(views.size(), cv::Mat());
 
   if (listOfAffineI != NULL) {
-    listOfAffineI->resize(listOfAffineParams.size());
+    listOfAffineI->assign(views.size(), vpImage<unsigned char>());
   }
 
 #ifdef VISP_HAVE_OPENMP
-#pragma omp parallel for
+#pragma omp parallel
 #endif
-  for (int cpt = 0; cpt < static_cast<int>(listOfAffineParams.size()); cpt++) {
-    std::vector<cv::KeyPoint> keypoints;
-    cv::Mat descriptors;
+  {
+    vpAffineBuffers buffers;
 
-    cv::Mat timg, mask, Ai;
-    img.copyTo(timg);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+    for (int cpt = 0; cpt < static_cast<int>(sortedViews.size()); cpt++) {
+      const vpAffineView &view = sortedViews[(size_t)cpt];
+      std::vector<cv::KeyPoint> &keypoints = listOfKeypoints[view.index];
 
-    affineSkew(listOfAffineParams[(size_t)cpt].first, listOfAffineParams[(size_t)cpt].second, timg, mask, Ai);
+      cv::Mat timg, mask, Ai;
+      affineSkew(view.tilt, view.phi, img, fullMask, buffers, timg, mask, Ai);
 
-    if (listOfAffineI != NULL) {
-      cv::Mat img_disp;
-      bitwise_and(mask, timg, img_disp);
-      vpImage<unsigned char> tI;
-      vpImageConvert::convert(img_disp, tI);
-      (*listOfAffineI)[(size_t)cpt] = tI;
-    }
+      if (listOfAffineI != NULL) {
+        cv::Mat img_disp;
+        bitwise_and(mask, timg, img_disp);
+        vpImageConvert::convert(img_disp, (*listOfAffineI)[view.index]);
+      }
 
-#if 0
-    cv::Mat img_disp;
-    cv::bitwise_and(mask, timg, img_disp);
-    cv::namedWindow( "Skew", cv::WINDOW_AUTOSIZE ); // Create a window for display.
-    cv::imshow( "Skew", img_disp );
-    cv::waitKey(0);
-#endif
+      for (std::map<std::string, cv::Ptr<cv::FeatureDetector> >::const_iterator it = m_detectors.begin();
+           it != m_detectors.end(); ++it) {
+        std::vector<cv::KeyPoint> kp;
+        it->second->detect(timg, kp, mask);
+        keypoints.insert(keypoints.end(), kp.begin(), kp.end());
+      }
 
-    for (std::map<std::string, cv::Ptr<cv::FeatureDetector> >::const_iterator it = m_detectors.begin();
-         it != m_detectors.end(); ++it) {
-      std::vector<cv::KeyPoint> kp;
-      it->second->detect(timg, kp, mask);
-      keypoints.insert(keypoints.end(), kp.begin(), kp.end());
+      double elapsedTime;
+      extract(timg, keypoints, listOfDescriptors[view.index], elapsedTime);
+
+      // Back to the input image coordinates
+      const float a00 = Ai.at<float>(0, 0), a01 = Ai.at<float>(0, 1), a02 = Ai.at<float>(0, 2);
+      const float a10 = Ai.at<float>(1, 0), a11 = Ai.at<float>(1, 1), a12 = Ai.at<float>(1, 2);
+      for (size_t i = 0; i < keypoints.size(); i++) {
+        const float u = keypoints[i].pt.x, v = keypoints[i].pt.y;
+        keypoints[i].pt.x = a00 * u + a01 * v + a02;
+        keypoints[i].pt.y = a10 * u + a11 * v + a12;
+      }
     }
+  }
+}
 
-    double elapsedTime;
-    extract(timg, keypoints, descriptors, elapsedTime);
+/*!
+   Count the Ransac inliers of the last pose estimation provided by each
+   affine view, to select the views to simulate for the next image when
+   setUseAffineViewSelection() is enabled.
 
-    for (size_t i = 0; i < keypoints.size(); i++) {
-      cv::Point3f kpt(keypoints[i].pt.x, keypoints[i].pt.y, 1.f);
-      cv::Mat kpt_t = Ai * cv::Mat(kpt);
-      keypoints[i].pt.x = kpt_t.at<float>(0, 0);
-      keypoints[i].pt.y = kpt_t.at<float>(1, 0);
+   \param poseEstimated : True if the pose estimation succeeded.
+ */
+void vpKeyPoint::updateAffineViewSelection(const bool poseEstimated)
+{
+  m_affineViewInliers.clear();
+  if (!m_useAffineViewSelection || !poseEstimated || m_affineViewOffsets.empty()) {
+    return;
+  }
+
+  // Find the view of the inliers from the hash of the query keypoints
+  std::map<size_t, int> mapOfKeypointHashes;
+  const int nbViews = (int)m_affineViewOffsets.size() - 1;
+  for (int view = 0; view < nbViews; view++) {
+    size_t end = std::min(m_affineViewOffsets[(size_t)view + 1], m_queryKeyPoints.size());
+    for (size_t i = m_affineViewOffsets[(size_t)view]; i < end; i++) {
+      mapOfKeypointHashes[myKeypointHash(m_queryKeyPoints[i])] = view;
     }
+  }
 
-    listOfKeypoints[(size_t)cpt] = keypoints;
-    listOfDescriptors[(size_t)cpt] = descriptors;
+  m_affineViewInliers.resize((size_t)nbViews, 0);
+  for (std::vector<std::pair<cv::KeyPoint, cv::Point3f> >::const_iterator it = m_matchRansacKeyPointsToPoints.begin();
+       it != m_matchRansacKeyPointsToPoints.end(); ++it) {
+    std::map<size_t, int>::const_iterator it_view = mapOfKeypointHashes.find(myKeypointHash(it->first));
+    if (it_view != mapOfKeypointHashes.end()) {
+      m_affineViewInliers[(size_t)it_view->second]++;
+    }
   }
-#endif
 }
 
 /*!
@@ -3551,6 +4098,9 @@ void vpKeyPoint::reset()
   matchedReferencePoints.clear();
   _reference_computed = false;
 
+  m_affineViewInliers.clear();
+  m_affineViewOffsets.clear();
+  m_binaryMatcher.clear();
   m_computeCovariance = false;
   m_covarianceMatrix = vpMatrix();
   m_currentImageId = 0;
@@ -3567,7 +4117,11 @@ void vpKeyPoint::reset()
   m_filterType = ratioDistanceThreshold;
   m_imageFormat = jpgImageFormat;
   m_knnMatches.clear();
+#ifdef VISP_HAVE_MODULE_IO
+  m_learningFile = cv::Ptr<vpMemoryMappedFile>();
+#endif
   m_mapOfImageId.clear();
+  m_mapOfImagePaths.clear();
   m_mapOfImages.clear();
   m_matcher = cv::Ptr<cv::DescriptorMatcher>();
   m_matcherName = "BruteForce-Hamming";
@@ -3596,6 +4150,9 @@ void vpKeyPoint::reset()
   m_trainPoints.clear();
   m_trainVpPoints.clear();
   m_useAffineDetection = false;
+  m_useAffineViewSelection = false;
+  m_useBinaryMatcher = false;
+  m_useBinaryMatcherMutualCheck = false;
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
   m_useBruteForceCrossCheck = true;
 #endif
@@ -3614,6 +4171,10 @@ void vpKeyPoint::reset()
 /*!
    Save the learning data in a file in XML or binary mode.
 
+   In binary mode, the values are written in the byte order of the host with
+   each section aligned on 64 bytes, so that loadLearningData() can map the
+   file in memory and use the descriptors in place.
+
    \param filename : Path of the save file
    \param binaryMode : If true, the data are saved in binary mode, otherwise
    in XML mode \param saveTrainingImages : If true, save also the training
@@ -3629,6 +4190,8 @@ void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode,
   std::map<int, std::string> mapOfImgPath;
   if (saveTrainingImages) {
 #ifdef VISP_HAVE_MODULE_IO
+    loadTrainingImages();
+
     // Save the training image files in the same directory
     unsigned int cpt = 0;
 
@@ -3681,142 +4244,110 @@ void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode,
   }
 
   if (binaryMode) {
-    // Save the learning data into little endian binary file.
-    std::ofstream file(filename.c_str(), std::ofstream::binary);
-    if (!file.is_open()) {
-      throw vpException(vpException::ioError, "Cannot create the file.");
+    // Save the learning data with the layout described at the beginning of
+    // this file, so that loadLearningData() maps them in memory
+
+    // The descriptors may be read from a learning file mapped in memory,
+    // possibly the one that is saved: copy them and unmap the file first
+    if (mappedTrainDescriptors()) {
+      m_trainDescriptors = m_trainDescriptors.clone();
+      trainMatcher();
     }
 
-    // Write info about training images
-    int nbImgs = (int)mapOfImgPath.size();
-    vpIoTools::writeBinaryValueLE(file, nbImgs);
-
-#ifdef VISP_HAVE_MODULE_IO
-    for (std::map<int, std::string>::const_iterator it = mapOfImgPath.begin(); it != mapOfImgPath.end(); ++it) {
-      // Write image_id
-      int id = it->first;
-      vpIoTools::writeBinaryValueLE(file, id);
-
-      // Write image path
-      std::string path = it->second;
-      int length = (int)path.length();
-      vpIoTools::writeBinaryValueLE(file, length);
-
-      for (int cpt = 0; cpt < length; cpt++) {
-        file.write((char *)(&path[(size_t)cpt]), sizeof(path[(size_t)cpt]));
-      }
+    // Write a temporary file renamed once complete, so that a failure
+    // never leaves a truncated learning file
+    const std::string tmp_filename = filename + ".tmp";
+    std::ofstream file(tmp_filename.c_str(), std::ofstream::binary);
+    if (!file.is_open()) {
+      throw vpException(vpException::ioError, "Cannot create the file.");
     }
-#endif
-
-    // Write if we have 3D point information
-    int have3DInfoInt = have3DInfo ? 1 : 0;
-    vpIoTools::writeBinaryValueLE(file, have3DInfoInt);
 
     int nRows = m_trainDescriptors.rows, nCols = m_trainDescriptors.cols;
     int descriptorType = m_trainDescriptors.type();
+    if (CV_MAT_CN(descriptorType) != 1 || CV_MAT_DEPTH(descriptorType) > CV_64F) {
+      throw vpException(vpException::fatalError, "Problem with the data type of descriptors !");
+    }
+    if ((size_t)nRows != m_trainKeyPoints.size()) {
+      throw vpException(vpException::fatalError, "List of keypoints and train descriptors have different size !");
+    }
+    const size_t step = (size_t)nCols * CV_ELEM_SIZE(descriptorType);
 
-    // Write the number of descriptors
-    vpIoTools::writeBinaryValueLE(file, nRows);
-
-    // Write the size of the descriptor
-    vpIoTools::writeBinaryValueLE(file, nCols);
-
-    // Write the type of the descriptor
-    vpIoTools::writeBinaryValueLE(file, descriptorType);
-
-    for (int i = 0; i < nRows; i++) {
-      unsigned int i_ = (unsigned int)i;
-      // Write u
-      float u = m_trainKeyPoints[i_].pt.x;
-      vpIoTools::writeBinaryValueLE(file, u);
-
-      // Write v
-      float v = m_trainKeyPoints[i_].pt.y;
-      vpIoTools::writeBinaryValueLE(file, v);
-
-      // Write size
-      float size = m_trainKeyPoints[i_].size;
-      vpIoTools::writeBinaryValueLE(file, size);
-
-      // Write angle
-      float angle = m_trainKeyPoints[i_].angle;
-      vpIoTools::writeBinaryValueLE(file, angle);
-
-      // Write response
-      float response = m_trainKeyPoints[i_].response;
-      vpIoTools::writeBinaryValueLE(file, response);
-
-      // Write octave
-      int octave = m_trainKeyPoints[i_].octave;
-      vpIoTools::writeBinaryValueLE(file, octave);
-
-      // Write class_id
-      int class_id = m_trainKeyPoints[i_].class_id;
-      vpIoTools::writeBinaryValueLE(file, class_id);
+    // Path of the training images: id, length and characters of the path,
+    // padded to 4 bytes
+    std::vector<unsigned char> images;
+    for (std::map<int, std::string>::const_iterator it = mapOfImgPath.begin(); it != mapOfImgPath.end(); ++it) {
+      size_t offset = images.size();
+      images.resize(alignLearningOffset(offset + 2 * sizeof(uint32_t) + it->second.length(), sizeof(uint32_t)), 0);
+      setLearningValue<int>(&images[0], offset, it->first);
+      setLearningValue<uint32_t>(&images[0], offset + sizeof(uint32_t), (uint32_t)it->second.length());
+      memcpy(&images[offset + 2 * sizeof(uint32_t)], it->second.c_str(), it->second.length());
+    }
 
-// Write image_id
+    const vpLearningFileLayout layout((size_t)nRows, have3DInfo, images.size(), step);
+    std::vector<unsigned char> buffer(layout.descriptors, 0);
+
+    // Write the header
+    memcpy(&buffer[0], vp_kp_magic, sizeof(vp_kp_magic));
+    setLearningValue<uint32_t>(&buffer[0], vp_kp_offset_byte_order, vp_kp_byte_order);
+    setLearningValue<uint32_t>(&buffer[0], vp_kp_offset_version, vp_kp_version);
+    setLearningValue<uint32_t>(&buffer[0], vp_kp_offset_header_size, (uint32_t)vp_kp_header_size);
+    setLearningValue<uint32_t>(&buffer[0], vp_kp_offset_nb_keypoints, (uint32_t)nRows);
+    setLearningValue<uint32_t>(&buffer[0], vp_kp_offset_descriptor_cols, (uint32_t)nCols);
+    setLearningValue<int>(&buffer[0], vp_kp_offset_descriptor_type, descriptorType);
+    setLearningValue<uint32_t>(&buffer[0], vp_kp_offset_descriptor_step, (uint32_t)step);
+    setLearningValue<uint32_t>(&buffer[0], vp_kp_offset_have_3d, have3DInfo ? 1 : 0);
+    setLearningValue<uint32_t>(&buffer[0], vp_kp_offset_nb_images, (uint32_t)mapOfImgPath.size());
+    setLearningValue<uint32_t>(&buffer[0], vp_kp_offset_images_size, (uint32_t)images.size());
+
+    for (size_t i = 0; i < (size_t)nRows; i++) {
+      // Write u, v, size, angle, response, octave, class_id and image_id
+      unsigned char *keyPointData = &buffer[layout.keyPoints + i * vp_kp_keypoint_size];
+      setLearningValue<float>(keyPointData, 0, m_trainKeyPoints[i].pt.x);
+      setLearningValue<float>(keyPointData, 4, m_trainKeyPoints[i].pt.y);
+      setLearningValue<float>(keyPointData, 8, m_trainKeyPoints[i].size);
+      setLearningValue<float>(keyPointData, 12, m_trainKeyPoints[i].angle);
+      setLearningValue<float>(keyPointData, 16, m_trainKeyPoints[i].response);
+      setLearningValue<int>(keyPointData, 20, m_trainKeyPoints[i].octave);
+      setLearningValue<int>(keyPointData, 24, m_trainKeyPoints[i].class_id);
 #ifdef VISP_HAVE_MODULE_IO
-      std::map<int, int>::const_iterator it_findImgId = m_mapOfImageId.find(m_trainKeyPoints[i_].class_id);
+      std::map<int, int>::const_iterator it_findImgId = m_mapOfImageId.find(m_trainKeyPoints[i].class_id);
       int image_id = (saveTrainingImages && it_findImgId != m_mapOfImageId.end()) ? it_findImgId->second : -1;
-      vpIoTools::writeBinaryValueLE(file, image_id);
 #else
       int image_id = -1;
-      //      file.write((char *)(&image_id), sizeof(image_id));
-      vpIoTools::writeBinaryValueLE(file, image_id);
 #endif
+      setLearningValue<int>(keyPointData, 28, image_id);
 
       if (have3DInfo) {
-        float oX = m_trainPoints[i_].x, oY = m_trainPoints[i_].y, oZ = m_trainPoints[i_].z;
-        // Write oX
-        vpIoTools::writeBinaryValueLE(file, oX);
-
-        // Write oY
-        vpIoTools::writeBinaryValueLE(file, oY);
-
-        // Write oZ
-        vpIoTools::writeBinaryValueLE(file, oZ);
+        // Write oX, oY, oZ
+        unsigned char *pointData = &buffer[layout.points + i * vp_kp_point_size];
+        setLearningValue<float>(pointData, 0, m_trainPoints[i].x);
+        setLearningValue<float>(pointData, 4, m_trainPoints[i].y);
+        setLearningValue<float>(pointData, 8, m_trainPoints[i].z);
       }
+    }
 
-      for (int j = 0; j < nCols; j++) {
-        // Write the descriptor value
-        switch (descriptorType) {
-        case CV_8U:
-          file.write((char *)(&m_trainDescriptors.at<unsigned char>(i, j)),
-                     sizeof(m_trainDescriptors.at<unsigned char>(i, j)));
-          break;
-
-        case CV_8S:
-          file.write((char *)(&m_trainDescriptors.at<char>(i, j)), sizeof(m_trainDescriptors.at<char>(i, j)));
-          break;
-
-        case CV_16U:
-          vpIoTools::writeBinaryValueLE(file, m_trainDescriptors.at<unsigned short int>(i, j));
-          break;
-
-        case CV_16S:
-          vpIoTools::writeBinaryValueLE(file, m_trainDescriptors.at<short int>(i, j));
-          break;
-
-        case CV_32S:
-          vpIoTools::writeBinaryValueLE(file, m_trainDescriptors.at<int>(i, j));
-          break;
-
-        case CV_32F:
-          vpIoTools::writeBinaryValueLE(file, m_trainDescriptors.at<float>(i, j));
-          break;
-
-        case CV_64F:
-          vpIoTools::writeBinaryValueLE(file, m_trainDescriptors.at<double>(i, j));
-          break;
+    if (!images.empty()) {
+      memcpy(&buffer[layout.images], &images[0], images.size());
+    }
+    file.write((const char *)&buffer[0], (std::streamsize)buffer.size());
 
-        default:
-          throw vpException(vpException::fatalError, "Problem with the data type of descriptors !");
-          break;
-        }
-      }
+    // Write the descriptors
+    for (int i = 0; i < nRows; i++) {
+      file.write((const char *)m_trainDescriptors.ptr(i), (std::streamsize)step);
     }
 
     file.close();
+    if (file.fail()) {
+      remove(tmp_filename.c_str());
+      throw vpException(vpException::ioError, "Cannot write the learning file \"%s\"", filename.c_str());
+    }
+
+    // rename() does not replace an existing file on Windows
+    if (!vpIoTools::rename(tmp_filename, filename) &&
+        (remove(filename.c_str()) != 0 || !vpIoTools::rename(tmp_filename, filename))) {
+      remove(tmp_filename.c_str());
+      throw vpException(vpException::ioError, "Cannot write the learning file \"%s\"", filename.c_str());
+    }
   } else {
 #ifdef VISP_HAVE_XML2
     xmlDocPtr doc = NULL;
@@ -4007,6 +4538,380 @@ void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode,
   }
 }
 
+/*!
+   Train the OpenCV matcher and, if it is used, the binary descriptor matcher
+   with the train descriptors.
+ */
+void vpKeyPoint::trainMatcher()
+{
+  // Add train descriptors in matcher object
+  m_matcher->clear();
+  m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+
+  // Pack and index the train descriptors once for all the matchings
+  m_binaryMatcher.clear();
+  if (useBinaryMatcher()) {
+    m_binaryMatcher.train(m_trainDescriptors, m_matcherName == "FlannBased");
+  }
+
+  // Unmap the learning file once the train descriptors are no longer used in
+  // place. The matchers above no longer reference it.
+  if (!mappedTrainDescriptors()) {
+#ifdef VISP_HAVE_MODULE_IO
+    m_learningFile = cv::Ptr<vpMemoryMappedFile>();
+#endif
+  }
+}
+
+/*!
+   Return true if the train descriptors are used in place in the memory
+   mapped learning file.
+ */
+bool vpKeyPoint::mappedTrainDescriptors() const
+{
+#ifdef VISP_HAVE_MODULE_IO
+  return !m_learningFile.empty() && !m_trainDescriptors.empty() &&
+         m_trainDescriptors.data >= m_learningFile->getData() &&
+         m_trainDescriptors.data < m_learningFile->getData() + m_learningFile->getSize();
+#else
+  return false;
+#endif
+}
+
+/*!
+   Read the training images whose reading was deferred by loadLearningData().
+ */
+void vpKeyPoint::loadTrainingImages()
+{
+#ifdef VISP_HAVE_MODULE_IO
+  while (!m_mapOfImagePaths.empty()) {
+    std::map<int, std::string>::iterator it = m_mapOfImagePaths.begin();
+    vpImageIo::read(m_mapOfImages[it->first], it->second);
+    m_mapOfImagePaths.erase(it);
+  }
+#endif
+}
+
+/*!
+   Return true if the binary descriptor matcher can be used in place of the
+   OpenCV matcher.
+ */
+bool vpKeyPoint::useBinaryMatcher() const
+{
+  return m_useBinaryMatcher && !m_trainDescriptors.empty() && m_trainDescriptors.type() == CV_8U &&
+         (m_matcherName == "BruteForce-Hamming" || m_matcherName == "FlannBased");
+}
+
+/*!
+   Match the query descriptors with the binary descriptor matcher. The ratio
+   test of the ratioDistanceThreshold filtering method and the mutual check
+   are done during the matching, the matches that fail them are removed. With
+   OpenCV 2.4, the brute-force cross check also enables the mutual check of
+   the exhaustive search.
+
+   \param queryDescriptors : Query descriptors.
+   \param matches : Output list of matches.
+ */
+void vpKeyPoint::matchBinary(const cv::Mat &queryDescriptors, std::vector<cv::DMatch> &matches)
+{
+  bool useLsh = m_matcherName == "FlannBased";
+  if (!m_binaryMatcher.isTrained(useLsh)) {
+    m_binaryMatcher.train(m_trainDescriptors, useLsh);
+  }
+
+  bool mutualCheck = m_useBinaryMatcherMutualCheck;
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
+  // The cross check of the brute-force matcher keeps the mutual nearest
+  // neighbors, it is only used when knn is disabled
+  mutualCheck = mutualCheck || (m_useBruteForceCrossCheck && !m_useKnn && !useLsh);
+#endif
+
+  std::vector<BinaryDescriptorMatcher::Neighbors> neighbors, mutualNeighbors;
+  if (m_useMatchTrainToQuery) {
+    m_binaryMatcher.knnSearchTrainToQuery(queryDescriptors, neighbors);
+    if (mutualCheck) {
+      m_binaryMatcher.knnSearch(queryDescriptors, mutualNeighbors);
+    }
+  } else {
+    m_binaryMatcher.knnSearch(queryDescriptors, neighbors);
+  }
+
+  const bool ratioTest = m_useKnn && m_filterType == ratioDistanceThreshold;
+  const int nbNeighbors = (int)neighbors.size();
+  std::vector<unsigned char> valid((size_t)nbNeighbors, 0);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+  for (int i = 0; i < nbNeighbors; i++) {
+    const BinaryDescriptorMatcher::Neighbors &n = neighbors[(size_t)i];
+    if (n.idx[0] < 0) {
+      continue;
+    }
+    if (ratioTest) {
+      // Same test as in filterMatches()
+      if (n.idx[1] < 0) {
+        continue;
+      }
+      float ratio = (float)n.dist[0] / (float)n.dist[1];
+      if (!(ratio < m_matchingRatioThreshold)) {
+        continue;
+      }
+    }
+    if (mutualCheck) {
+      int nearest = m_useMatchTrainToQuery ? mutualNeighbors[(size_t)n.idx[0]].idx[0]
+                                           : m_binaryMatcher.findNearestQuery(n.idx[0]);
+      if (nearest != i) {
+        continue;
+      }
+    }
+    valid[(size_t)i] = 1;
+  }
+
+  // The neighbors of a train descriptor are query descriptors when matching
+  // train to query
+  if (m_useKnn) {
+    m_knnMatches.clear();
+    for (int i = 0; i < nbNeighbors; i++) {
+      if (valid[(size_t)i]) {
+        const BinaryDescriptorMatcher::Neighbors &n = neighbors[(size_t)i];
+        std::vector<cv::DMatch> knn;
+        for (int k = 0; k < 2 && n.idx[k] >= 0; k++) {
+          knn.push_back(m_useMatchTrainToQuery ? cv::DMatch(n.idx[k], i, (float)n.dist[k])
+                                               : cv::DMatch(i, n.idx[k], (float)n.dist[k]));
+        }
+        m_knnMatches.push_back(knn);
+      }
+    }
+    matches.resize(m_knnMatches.size());
+    std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
+  } else {
+    matches.clear();
+    for (int i = 0; i < nbNeighbors; i++) {
+      if (valid[(size_t)i]) {
+        const BinaryDescriptorMatcher::Neighbors &n = neighbors[(size_t)i];
+        matches.push_back(m_useMatchTrainToQuery ? cv::DMatch(n.idx[0], i, (float)n.dist[0])
+                                                 : cv::DMatch(i, n.idx[0], (float)n.dist[0]));
+      }
+    }
+  }
+}
+
+vpKeyPoint::BinaryDescriptorMatcher::BinaryDescriptorMatcher()
+  : m_descriptorSize(0), m_descriptors(), m_lshBits(), m_lshIndices(), m_lshKeySize(0), m_lshNbTables(0),
+    m_lshOffsets(), m_nbDescriptors(0), m_nbQueryDescriptors(0), m_queryDescriptors(), m_stride(0), m_useLsh(false)
+{
+}
+
+/*!
+   Release the train descriptors and the LSH index.
+ */
+void vpKeyPoint::BinaryDescriptorMatcher::clear()
+{
+  m_descriptorSize = 0;
+  std::vector<unsigned char>().swap(m_descriptors);
+  std::vector<int>().swap(m_lshBits);
+  std::vector<int>().swap(m_lshIndices);
+  m_lshKeySize = 0;
+  m_lshNbTables = 0;
+  std::vector<int>().swap(m_lshOffsets);
+  m_nbDescriptors = 0;
+  m_nbQueryDescriptors = 0;
+  m_queryDescriptors.clear();
+  m_stride = 0;
+  m_useLsh = false;
+}
+
+/*!
+   Pack the train descriptors, and build the LSH index if \e useLsh is true.
+ */
+void vpKeyPoint::BinaryDescriptorMatcher::train(const cv::Mat &trainDescriptors, const bool useLsh)
+{
+  clear();
+  if (trainDescriptors.empty()) {
+    return;
+  }
+  if (trainDescriptors.type() != CV_8U) {
+    throw vpException(vpException::badValue, "Binary descriptors (CV_8U) are required.");
+  }
+
+  m_descriptorSize = trainDescriptors.cols;
+  m_stride = ((m_descriptorSize + 15) / 16) * 16;
+  m_nbDescriptors = trainDescriptors.rows;
+  pack(trainDescriptors, m_descriptors);
+
+  m_useLsh = useLsh;
+  if (m_useLsh) {
+    buildLsh();
+  }
+}
+
+/*!
+   Copy the descriptors in a contiguous buffer, each one padded with zeros
+   to m_stride bytes.
+ */
+void vpKeyPoint::BinaryDescriptorMatcher::pack(const cv::Mat &descriptors, std::vector<unsigned char> &packed) const
+{
+  packed.assign((size_t)descriptors.rows * (size_t)m_stride, 0);
+  for (int i = 0; i < descriptors.rows; i++) {
+    memcpy(&packed[(size_t)i * (size_t)m_stride], descriptors.ptr<unsigned char>(i), (size_t)m_descriptorSize);
+  }
+}
+
+/*!
+   Build the LSH tables. Each one hashes the descriptors with a key made of
+   randomly chosen bits, and stores the descriptor indices sorted by key,
+   with the offset of each bucket.
+ */
+void vpKeyPoint::BinaryDescriptorMatcher::buildLsh()
+{
+  // A few descriptors per bucket
+  int log2 = 0;
+  while ((1 << (log2 + 1)) <= m_nbDescriptors && log2 < 30) {
+    log2++;
+  }
+  m_lshKeySize = (std::min)(8 * m_descriptorSize, (std::max)(8, (std::min)(16, log2 - 1)));
+  m_lshNbTables = 12;
+
+  const int nbBits = 8 * m_descriptorSize;
+  vpUniRand rng(42);
+  m_lshBits.resize((size_t)(m_lshNbTables * m_lshKeySize));
+  for (int table = 0; table < m_lshNbTables; table++) {
+    int *bits = &m_lshBits[(size_t)(table * m_lshKeySize)];
+    for (int j = 0; j < m_lshKeySize; j++) {
+      bool unique;
+      do {
+        bits[j] = (std::min)(nbBits - 1, (int)(rng() * nbBits));
+        unique = std::find(bits, bits + j, bits[j]) == bits + j;
+      } while (!unique);
+    }
+  }
+
+  const int nbBuckets = 1 << m_lshKeySize;
+  m_lshOffsets.assign((size_t)m_lshNbTables * (size_t)(nbBuckets + 1), 0);
+  m_lshIndices.resize((size_t)m_lshNbTables * (size_t)m_nbDescriptors);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int table = 0; table < m_lshNbTables; table++) {
+    const int *bits = &m_lshBits[(size_t)(table * m_lshKeySize)];
+    int *offsets = &m_lshOffsets[(size_t)table * (size_t)(nbBuckets + 1)];
+    int *indices = &m_lshIndices[(size_t)table * (size_t)m_nbDescriptors];
+
+    // Counting sort of the descriptors by key
+    std::vector<unsigned int> keys((size_t)m_nbDescriptors);
+    for (int i = 0; i < m_nbDescriptors; i++) {
+      keys[(size_t)i] = lshKey(&m_descriptors[(size_t)i * (size_t)m_stride], bits, m_lshKeySize);
+      offsets[keys[(size_t)i] + 1]++;
+    }
+    for (int b = 0; b < nbBuckets; b++) {
+      offsets[b + 1] += offsets[b];
+    }
+    std::vector<int> next(offsets, offsets + nbBuckets);
+    for (int i = 0; i < m_nbDescriptors; i++) {
+      indices[next[keys[(size_t)i]]++] = i;
+    }
+  }
+}
+
+/*!
+   Search the two nearest train descriptors of each query descriptor.
+
+   \param queryDescriptors : Query descriptors, of the same size as the train
+   descriptors.
+   \param neighbors : Nearest train descriptors, for each query descriptor.
+ */
+void vpKeyPoint::BinaryDescriptorMatcher::knnSearch(const cv::Mat &queryDescriptors, std::vector<Neighbors> &neighbors)
+{
+  if (!queryDescriptors.empty() && (queryDescriptors.type() != CV_8U || queryDescriptors.cols != m_descriptorSize)) {
+    throw vpException(vpException::badValue, "Query and train descriptors must have the same type and size.");
+  }
+
+  Neighbors none;
+  initNeighbors(none);
+  m_nbQueryDescriptors = queryDescriptors.rows;
+  pack(queryDescriptors, m_queryDescriptors);
+  neighbors.assign((size_t)m_nbQueryDescriptors, none);
+  if (m_nbQueryDescriptors == 0 || m_nbDescriptors == 0) {
+    return;
+  }
+
+  const unsigned char *query = &m_queryDescriptors[0], *train = &m_descriptors[0];
+  if (m_useLsh) {
+#if VISP_HAVE_SSSE3
+    if (vpCPUFeatures::checkSSSE3()) {
+      lshKnn(query, m_nbQueryDescriptors, train, m_nbDescriptors, m_stride, &m_lshBits[0], m_lshKeySize,
+             m_lshNbTables, &m_lshOffsets[0], &m_lshIndices[0], HammingDistanceSSSE3(), &neighbors[0]);
+      return;
+    }
+#endif
+    lshKnn(query, m_nbQueryDescriptors, train, m_nbDescriptors, m_stride, &m_lshBits[0], m_lshKeySize,
+           m_lshNbTables, &m_lshOffsets[0], &m_lshIndices[0], HammingDistance(), &neighbors[0]);
+  } else {
+#if VISP_HAVE_SSSE3
+    if (vpCPUFeatures::checkSSSE3()) {
+      bruteForceKnn(query, m_nbQueryDescriptors, train, m_nbDescriptors, m_stride, HammingDistanceSSSE3(),
+                    &neighbors[0]);
+      return;
+    }
+#endif
+    bruteForceKnn(query, m_nbQueryDescriptors, train, m_nbDescriptors, m_stride, HammingDistance(), &neighbors[0]);
+  }
+}
+
+/*!
+   Search the two nearest query descriptors of each train descriptor. As the
+   query descriptors change at each frame, the search is exhaustive.
+
+   \param queryDescriptors : Query descriptors, of the same size as the train
+   descriptors.
+   \param neighbors : Nearest query descriptors, for each train descriptor.
+ */
+void vpKeyPoint::BinaryDescriptorMatcher::knnSearchTrainToQuery(const cv::Mat &queryDescriptors,
+                                                                std::vector<Neighbors> &neighbors)
+{
+  if (!queryDescriptors.empty() && (queryDescriptors.type() != CV_8U || queryDescriptors.cols != m_descriptorSize)) {
+    throw vpException(vpException::badValue, "Query and train descriptors must have the same type and size.");
+  }
+
+  Neighbors none;
+  initNeighbors(none);
+  m_nbQueryDescriptors = queryDescriptors.rows;
+  pack(queryDescriptors, m_queryDescriptors);
+  neighbors.assign((size_t)m_nbDescriptors, none);
+  if (m_nbQueryDescriptors == 0 || m_nbDescriptors == 0) {
+    return;
+  }
+
+  const unsigned char *query = &m_queryDescriptors[0], *train = &m_descriptors[0];
+#if VISP_HAVE_SSSE3
+  if (vpCPUFeatures::checkSSSE3()) {
+    bruteForceKnn(train, m_nbDescriptors, query, m_nbQueryDescriptors, m_stride, HammingDistanceSSSE3(),
+                  &neighbors[0]);
+    return;
+  }
+#endif
+  bruteForceKnn(train, m_nbDescriptors, query, m_nbQueryDescriptors, m_stride, HammingDistance(), &neighbors[0]);
+}
+
+/*!
+   Return the index of the nearest query descriptor, among the ones of the
+   last search, of a train descriptor.
+ */
+int vpKeyPoint::BinaryDescriptorMatcher::findNearestQuery(const int trainIdx) const
+{
+  if (trainIdx < 0 || trainIdx >= m_nbDescriptors || m_nbQueryDescriptors == 0) {
+    return -1;
+  }
+
+  const unsigned char *train = &m_descriptors[(size_t)trainIdx * (size_t)m_stride];
+#if VISP_HAVE_SSSE3
+  if (vpCPUFeatures::checkSSSE3()) {
+    return nearestDescriptor(train, &m_queryDescriptors[0], m_nbQueryDescriptors, m_stride, HammingDistanceSSSE3());
+  }
+#endif
+  return nearestDescriptor(train, &m_queryDescriptors[0], m_nbQueryDescriptors, m_stride, HammingDistance());
+}
+
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000)
 // From OpenCV 2.4.11 source code.
 struct KeypointResponseGreaterThanThreshold {
@@ -419,6 +419,71 @@ void vpXmlConfigParserKeyPoint::read_ransac(xmlDocPtr doc, xmlNodePtr node)
     std::cout << "ransac: consensus percentage: " << m_ransacConsensusPercentage << std::endl;
 }
 
+
+/*!
+  Read the configuration values from a cache entry.
+
+  \param is : Stream to read from.
+  \return true if the values were read. Otherwise the values are left
+  unchanged.
+*/
+bool vpXmlConfigParserKeyPoint::readCacheData(std::istream &is)
+{
+  std::string detectorName, extractorName, matcherName;
+  double matchingFactorThreshold, matchingRatioThreshold;
+  vpMatchingMethodEnum matchingMethod;
+  int nbRansacIterations, nbRansacMinInlierCount;
+  double ransacConsensusPercentage, ransacReprojectionError, ransacThreshold;
+  bool useRansacConsensusPercentage, useRansacVVS;
+  if (!readCacheValue(is, detectorName) || !readCacheValue(is, extractorName) || !readCacheValue(is, matcherName) ||
+      !readCacheValue(is, matchingFactorThreshold) || !readCacheValue(is, matchingMethod) ||
+      !readCacheValue(is, matchingRatioThreshold) || !readCacheValue(is, nbRansacIterations) ||
+      !readCacheValue(is, nbRansacMinInlierCount) || !readCacheValue(is, ransacConsensusPercentage) ||
+      !readCacheValue(is, ransacReprojectionError) || !readCacheValue(is, ransacThreshold) ||
+      !readCacheValue(is, useRansacConsensusPercentage) || !readCacheValue(is, useRansacVVS)) {
+    return false;
+  }
+
+  m_detectorName = detectorName;
+  m_extractorName = extractorName;
+  m_matcherName = matcherName;
+  m_matchingFactorThreshold = matchingFactorThreshold;
+  m_matchingMethod = matchingMethod;
+  m_matchingRatioThreshold = matchingRatioThreshold;
+  m_nbRansacIterations = nbRansacIterations;
+  m_nbRansacMinInlierCount = nbRansacMinInlierCount;
+  m_ransacConsensusPercentage = ransacConsensusPercentage;
+  m_ransacReprojectionError = ransacReprojectionError;
+  m_ransacThreshold = ransacThreshold;
+  m_useRansacConsensusPercentage = useRansacConsensusPercentage;
+  m_useRansacVVS = useRansacVVS;
+  return true;
+}
+
+/*!
+  Write the configuration values in a cache entry.
+
+  \param os : Stream to write to.
+  \return true.
+*/
+bool vpXmlConfigParserKeyPoint::writeCacheData(std::ostream &os) const
+{
+  writeCacheValue(os, m_detectorName);
+  writeCacheValue(os, m_extractorName);
+  writeCacheValue(os, m_matcherName);
+  writeCacheValue(os, m_matchingFactorThreshold);
+  writeCacheValue(os, m_matchingMethod);
+  writeCacheValue(os, m_matchingRatioThreshold);
+  writeCacheValue(os, m_nbRansacIterations);
+  writeCacheValue(os, m_nbRansacMinInlierCount);
+  writeCacheValue(os, m_ransacConsensusPercentage);
+  writeCacheValue(os, m_ransacReprojectionError);
+  writeCacheValue(os, m_ransacThreshold);
+  writeCacheValue(os, m_useRansacConsensusPercentage);
+  writeCacheValue(os, m_useRansacVVS);
+  return true;
+}
+
 #elif !defined(VISP_BUILD_SHARED_LIBS)
 // Work arround to avoid warning:
 // libvisp_vision.a(vpXmlConfigParserKeyPoint.cpp.o) has no symbols
@@ -388,6 +388,18 @@ int main(int argc, const char **argv)
                                                    "binary with train images saved !");
       }
 
+      // The descriptors stay valid once the learning file is unmapped
+      {
+        vpKeyPoint read_keypoint_tmp;
+        read_keypoint_tmp.loadLearningData(filename, true);
+        trainDescriptors_read = read_keypoint_tmp.getTrainDescriptors();
+        read_keypoint_tmp.reset();
+      }
+      if (!compareDescriptors(trainDescriptors, trainDescriptors_read)) {
+        throw vpException(vpException::fatalError, "Problem with trainDescriptors after the learning file "
+                                                   "saved in binary is unmapped !");
+      }
+
       // Save in binary with no training images
       filename = vpIoTools::createFilePath(opath, "bin_without_img");
       vpIoTools::makeDirectory(filename);
@@ -419,6 +431,39 @@ int main(int argc, const char **argv)
                                                    "binary without train images !");
       }
 
+      // Test if append is ok
+      read_keypoint2.loadLearningData(filename, true, true);
+      trainKeyPoints_read.clear();
+      read_keypoint2.getTrainKeyPoints(trainKeyPoints_read);
+      trainDescriptors_read = read_keypoint2.getTrainDescriptors();
+
+      if (trainKeyPoints_read.size() != 2 * trainKeyPoints.size() ||
+          trainDescriptors_read.rows != 2 * trainDescriptors.rows ||
+          !compareDescriptors(trainDescriptors,
+                              trainDescriptors_read.rowRange(trainDescriptors.rows, trainDescriptors_read.rows))) {
+        throw vpException(vpException::fatalError, "Problem when appending a learning file saved in binary !");
+      }
+
+      // Test if saving back to the learning file that is read is ok
+      {
+        vpKeyPoint read_keypoint_same;
+        read_keypoint_same.loadLearningData(filename, true);
+        read_keypoint_same.saveLearningData(filename, true, false);
+        if (!compareDescriptors(trainDescriptors, read_keypoint_same.getTrainDescriptors())) {
+          throw vpException(vpException::fatalError, "Problem with trainDescriptors after saving a learning file "
+                                                     "saved in binary to the same path !");
+        }
+      }
+      vpKeyPoint read_keypoint_same;
+      read_keypoint_same.loadLearningData(filename, true);
+      trainKeyPoints_read.clear();
+      read_keypoint_same.getTrainKeyPoints(trainKeyPoints_read);
+      if (!compareKeyPoints(trainKeyPoints, trainKeyPoints_read) ||
+          !compareDescriptors(trainDescriptors, read_keypoint_same.getTrainDescriptors())) {
+        throw vpException(vpException::fatalError, "Problem when reading a learning file saved in binary to the "
+                                                   "path it was read from !");
+      }
+
 #if defined(VISP_HAVE_XML2)
       // Save in xml with training images
       filename = vpIoTools::createFilePath(opath, "xml_with_img");
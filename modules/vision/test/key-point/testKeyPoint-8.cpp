@@ -0,0 +1,200 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the binary descriptor matcher of vpKeyPoint against cv::BFMatcher.
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020301)
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpKeyPoint.h>
+
+namespace
+{
+// Textured scene made of random rectangles, shifted by (di, dj)
+void buildScene(vpImage<unsigned char> &I, int di, int dj)
+{
+  I.resize(480, 640, 127);
+  vpUniRand rand(42);
+  for (int n = 0; n < 150; n++) {
+    int top = (int)(rand() * 460) + di, left = (int)(rand() * 620) + dj;
+    int height = 8 + (int)(rand() * 60), width = 8 + (int)(rand() * 60);
+    unsigned char value = (unsigned char)(rand() * 255);
+    for (int i = (std::max)(0, top); i < (std::min)((int)I.getHeight(), top + height); i++) {
+      for (int j = (std::max)(0, left); j < (std::min)((int)I.getWidth(), left + width); j++) {
+        I[i][j] = value;
+      }
+    }
+  }
+}
+
+// The matches must have the same query descriptors and distances as the
+// reference ones. The train indexes may differ for descriptors at the same
+// distance.
+bool sameMatches(const std::vector<cv::DMatch> &matches, const std::vector<cv::DMatch> &ref)
+{
+  if (matches.size() != ref.size()) {
+    std::cerr << matches.size() << " matches instead of " << ref.size() << std::endl;
+    return false;
+  }
+  for (size_t i = 0; i < ref.size(); i++) {
+    if (matches[i].queryIdx != ref[i].queryIdx || matches[i].distance != ref[i].distance) {
+      std::cerr << "Match " << i << ": (" << matches[i].queryIdx << ", " << matches[i].distance << ") instead of ("
+                << ref[i].queryIdx << ", " << ref[i].distance << ")" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+/*!
+  \example testKeyPoint-8.cpp
+
+  \brief Test that the binary descriptor matcher of vpKeyPoint gives the same
+  matches as cv::BFMatcher with the Hamming distance.
+*/
+int main()
+{
+  try {
+    vpImage<unsigned char> Iref, Icur;
+    buildScene(Iref, 0, 0);
+    buildScene(Icur, 3, 5);
+
+    vpKeyPoint keypoints("ORB", "ORB", "BruteForce-Hamming", vpKeyPoint::noFilterMatching);
+    keypoints.setUseBinaryMatcher(true);
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
+    keypoints.setUseBruteForceCrossCheck(false);
+#endif
+    keypoints.buildReference(Iref);
+    cv::Mat trainDescriptors = keypoints.getTrainDescriptors();
+
+    std::vector<cv::KeyPoint> queryKeyPoints;
+    cv::Mat queryDescriptors;
+    double elapsedTime;
+    keypoints.detect(Icur, queryKeyPoints, elapsedTime);
+    keypoints.extract(Icur, queryKeyPoints, queryDescriptors, elapsedTime);
+    std::cout << trainDescriptors.rows << " train and " << queryDescriptors.rows << " query descriptors" << std::endl;
+    if (trainDescriptors.rows <= 100 || queryDescriptors.rows <= 100) {
+      std::cerr << "Not enough keypoints are detected" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    cv::BFMatcher bf(cv::NORM_HAMMING);
+    std::vector<cv::DMatch> matches, ref;
+
+    // Nearest neighbor of each query descriptor
+    keypoints.match(trainDescriptors, queryDescriptors, matches, elapsedTime);
+    bf.match(queryDescriptors, trainDescriptors, ref);
+    if (!sameMatches(matches, ref)) {
+      std::cerr << "Wrong nearest neighbors" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Nearest neighbor of each train descriptor
+    keypoints.setUseMatchTrainToQuery(true);
+    keypoints.match(trainDescriptors, queryDescriptors, matches, elapsedTime);
+    bf.match(trainDescriptors, queryDescriptors, ref);
+    std::vector<cv::DMatch> swapped(matches.size());
+    for (size_t i = 0; i < matches.size(); i++) {
+      swapped[i] = cv::DMatch(matches[i].trainIdx, matches[i].queryIdx, matches[i].distance);
+    }
+    if (!sameMatches(swapped, ref)) {
+      std::cerr << "Wrong train to query nearest neighbors" << std::endl;
+      return EXIT_FAILURE;
+    }
+    keypoints.setUseMatchTrainToQuery(false);
+
+    // Ratio test on the two nearest neighbors
+    keypoints.setFilterMatchingType(vpKeyPoint::ratioDistanceThreshold);
+    keypoints.setMatchingRatioThreshold(0.8);
+    keypoints.match(trainDescriptors, queryDescriptors, matches, elapsedTime);
+    std::vector<std::vector<cv::DMatch> > knnRef;
+    bf.knnMatch(queryDescriptors, trainDescriptors, knnRef, 2);
+    ref.clear();
+    for (size_t i = 0; i < knnRef.size(); i++) {
+      if (knnRef[i].size() == 2 && knnRef[i][0].distance / knnRef[i][1].distance < 0.8f) {
+        ref.push_back(knnRef[i][0]);
+      }
+    }
+    if (ref.empty() || !sameMatches(matches, ref)) {
+      std::cerr << "Wrong matches after the ratio test" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Mutual nearest neighbors, compared to the cross check of cv::BFMatcher
+    keypoints.setFilterMatchingType(vpKeyPoint::noFilterMatching);
+    keypoints.setUseBinaryMatcher(true, true);
+    keypoints.match(trainDescriptors, queryDescriptors, matches, elapsedTime);
+    cv::BFMatcher bfCrossCheck(cv::NORM_HAMMING, true);
+    bfCrossCheck.match(queryDescriptors, trainDescriptors, ref);
+    if (ref.empty() || !sameMatches(matches, ref)) {
+      std::cerr << "Wrong matches after the mutual check" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The OpenCV matcher is used by default
+    vpKeyPoint keypointsOpenCV("ORB", "ORB", "BruteForce-Hamming", vpKeyPoint::noFilterMatching);
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
+    keypointsOpenCV.setUseBruteForceCrossCheck(false);
+#endif
+    keypointsOpenCV.buildReference(Iref);
+    keypointsOpenCV.match(trainDescriptors, queryDescriptors, matches, elapsedTime);
+    bf.match(queryDescriptors, trainDescriptors, ref);
+    if (!sameMatches(matches, ref)) {
+      std::cerr << "Wrong matches with the default OpenCV matcher" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } catch (const vpException &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testKeyPoint-8 is ok !" << std::endl;
+  return EXIT_SUCCESS;
+}
+#else
+int main()
+{
+  std::cerr << "You need OpenCV library." << std::endl;
+
+  return 0;
+}
+
+#endif
@@ -0,0 +1,393 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test the parallel affine detection of vpKeyPoint against a sequential
+ * computation of the affine views, and the selection of the affine views
+ * from the last pose.
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020301)
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpKeyPoint.h>
+
+namespace
+{
+// Textured scene made of random rectangles
+void buildScene(vpImage<unsigned char> &I)
+{
+  I.resize(240, 320, 127);
+  vpUniRand rand(42);
+  for (int n = 0; n < 80; n++) {
+    int top = (int)(rand() * 230), left = (int)(rand() * 310);
+    int height = 6 + (int)(rand() * 40), width = 6 + (int)(rand() * 40);
+    unsigned char value = (unsigned char)(rand() * 255);
+    for (int i = top; i < (std::min)((int)I.getHeight(), top + height); i++) {
+      for (int j = left; j < (std::min)((int)I.getWidth(), left + width); j++) {
+        I[i][j] = value;
+      }
+    }
+  }
+}
+
+// Sequential affine transformation of an image, with a new image and mask
+// for each view
+void affineSkew(double tilt, double phi, cv::Mat &img, cv::Mat &mask, cv::Mat &Ai)
+{
+  int h = img.rows;
+  int w = img.cols;
+
+  mask = cv::Mat(h, w, CV_8UC1, cv::Scalar(255));
+
+  cv::Mat A = cv::Mat::eye(2, 3, CV_32F);
+
+  if (std::fabs(phi) > std::numeric_limits<double>::epsilon()) {
+    phi *= M_PI / 180.;
+    double s = sin(phi);
+    double c = cos(phi);
+
+    A = (cv::Mat_<float>(2, 2) << c, -s, s, c);
+
+    cv::Mat corners = (cv::Mat_<float>(4, 2) << 0, 0, w, 0, w, h, 0, h);
+    cv::Mat tcorners = corners * A.t();
+    cv::Mat tcorners_x, tcorners_y;
+    tcorners.col(0).copyTo(tcorners_x);
+    tcorners.col(1).copyTo(tcorners_y);
+    std::vector<cv::Mat> channels;
+    channels.push_back(tcorners_x);
+    channels.push_back(tcorners_y);
+    cv::merge(channels, tcorners);
+
+    cv::Rect rect = cv::boundingRect(tcorners);
+    A = (cv::Mat_<float>(2, 3) << c, -s, -rect.x, s, c, -rect.y);
+
+    cv::warpAffine(img, img, A, cv::Size(rect.width, rect.height), cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+  }
+  if (std::fabs(tilt - 1.0) > std::numeric_limits<double>::epsilon()) {
+    double s = 0.8 * sqrt(tilt * tilt - 1);
+    cv::GaussianBlur(img, img, cv::Size(0, 0), s, 0.01);
+    cv::resize(img, img, cv::Size(0, 0), 1.0 / tilt, 1.0, cv::INTER_NEAREST);
+    A.row(0) = A.row(0) / tilt;
+  }
+  if (std::fabs(tilt - 1.0) > std::numeric_limits<double>::epsilon() ||
+      std::fabs(phi) > std::numeric_limits<double>::epsilon()) {
+    cv::warpAffine(mask, mask, A, cv::Size(img.cols, img.rows), cv::INTER_NEAREST);
+  }
+  cv::invertAffineTransform(A, Ai);
+}
+
+// Keypoints and descriptors of each affine view, computed one view after the
+// other
+void detectExtractAffineSequential(vpKeyPoint &keypoints, const vpImage<unsigned char> &I,
+                                   std::vector<std::vector<cv::KeyPoint> > &listOfKeypoints,
+                                   std::vector<cv::Mat> &listOfDescriptors)
+{
+  cv::Mat img;
+  vpImageConvert::convert(I, img);
+  listOfKeypoints.clear();
+  listOfDescriptors.clear();
+
+  for (int tl = 1; tl < 6; tl++) {
+    double t = pow(2, 0.5 * tl);
+    for (int phi = 0; phi < 180; phi += (int)(72.0 / t)) {
+      std::vector<cv::KeyPoint> kps;
+      cv::Mat descriptors;
+
+      cv::Mat timg, mask, Ai;
+      img.copyTo(timg);
+      affineSkew(t, phi, timg, mask, Ai);
+
+      keypoints.detect(timg, kps, mask);
+      keypoints.extract(timg, kps, descriptors);
+
+      for (size_t i = 0; i < kps.size(); i++) {
+        cv::Point3f kpt(kps[i].pt.x, kps[i].pt.y, 1.f);
+        cv::Mat kpt_t = Ai * cv::Mat(kpt);
+        kps[i].pt.x = kpt_t.at<float>(0, 0);
+        kps[i].pt.y = kpt_t.at<float>(1, 0);
+      }
+
+      listOfKeypoints.push_back(kps);
+      listOfDescriptors.push_back(descriptors);
+    }
+  }
+}
+
+// Keypoints are mapped back to the image with float coefficients instead of
+// a matrix product, so the coordinates may differ by a few ulps
+bool sameKeyPoints(const std::vector<cv::KeyPoint> &kps, const std::vector<cv::KeyPoint> &ref)
+{
+  if (kps.size() != ref.size()) {
+    std::cerr << kps.size() << " keypoints instead of " << ref.size() << std::endl;
+    return false;
+  }
+  for (size_t i = 0; i < ref.size(); i++) {
+    if (std::fabs(kps[i].pt.x - ref[i].pt.x) > 1e-3f || std::fabs(kps[i].pt.y - ref[i].pt.y) > 1e-3f ||
+        !vpMath::equal(kps[i].size, ref[i].size, std::numeric_limits<float>::epsilon()) ||
+        !vpMath::equal(kps[i].angle, ref[i].angle, std::numeric_limits<float>::epsilon()) ||
+        kps[i].octave != ref[i].octave) {
+      std::cerr << "Keypoint " << i << ": (" << kps[i].pt.x << ", " << kps[i].pt.y << ") instead of ("
+                << ref[i].pt.x << ", " << ref[i].pt.y << ")" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool sameDescriptors(const cv::Mat &descriptors, const cv::Mat &ref)
+{
+  if (descriptors.rows != ref.rows || descriptors.cols != ref.cols || descriptors.type() != ref.type()) {
+    std::cerr << descriptors.rows << "x" << descriptors.cols << " descriptors instead of " << ref.rows << "x"
+              << ref.cols << std::endl;
+    return false;
+  }
+  return ref.empty() || cv::norm(descriptors, ref, cv::NORM_L1) == 0.0;
+}
+
+// Descriptors of the selected views merged in the order of the views, all
+// the views if the selection is empty
+cv::Mat mergeDescriptors(const std::vector<cv::Mat> &listOfDescriptors, const std::vector<bool> &selectedViews)
+{
+  cv::Mat descriptors;
+  for (size_t i = 0; i < listOfDescriptors.size(); i++) {
+    if ((selectedViews.empty() || selectedViews[i]) && !listOfDescriptors[i].empty()) {
+      descriptors.push_back(listOfDescriptors[i]);
+    }
+  }
+  return descriptors;
+}
+
+// Views that should be simulated after a pose: the views where the inliers
+// were detected and the views with an adjacent tilt and a close rotation
+std::vector<bool> selectAffineViews(const std::vector<std::vector<cv::KeyPoint> > &listOfKeypoints,
+                                    const std::vector<vpImagePoint> &inliers)
+{
+  std::vector<int> tiltIndexes, phis;
+  std::vector<double> tilts;
+  for (int tl = 1; tl < 6; tl++) {
+    double t = pow(2, 0.5 * tl);
+    for (int phi = 0; phi < 180; phi += (int)(72.0 / t)) {
+      tiltIndexes.push_back(tl);
+      tilts.push_back(t);
+      phis.push_back(phi);
+    }
+  }
+
+  std::vector<bool> inlierViews(listOfKeypoints.size(), false);
+  for (size_t k = 0; k < inliers.size(); k++) {
+    int view = -1;
+    for (size_t i = 0; i < listOfKeypoints.size(); i++) {
+      for (size_t j = 0; j < listOfKeypoints[i].size(); j++) {
+        if (std::fabs(listOfKeypoints[i][j].pt.x - inliers[k].get_u()) < 1e-3 &&
+            std::fabs(listOfKeypoints[i][j].pt.y - inliers[k].get_v()) < 1e-3) {
+          view = (int)i;
+        }
+      }
+    }
+    if (view >= 0) {
+      inlierViews[(size_t)view] = true;
+    }
+  }
+
+  std::vector<bool> selectedViews(listOfKeypoints.size(), false);
+  for (size_t i = 0; i < inlierViews.size(); i++) {
+    if (inlierViews[i]) {
+      for (size_t j = 0; j < selectedViews.size(); j++) {
+        int dphi = std::abs(phis[i] - phis[j]) % 180;
+        dphi = (std::min)(dphi, 180 - dphi);
+        if (std::abs(tiltIndexes[i] - tiltIndexes[j]) <= 1 &&
+            dphi <= (std::max)((int)(72.0 / tilts[i]), (int)(72.0 / tilts[j]))) {
+          selectedViews[j] = true;
+        }
+      }
+    }
+  }
+  return selectedViews;
+}
+}
+
+/*!
+  \example testKeyPoint-9.cpp
+
+  \brief Test that the affine detection of vpKeyPoint, where the views are
+  simulated in parallel with reused buffers, gives the same keypoints and
+  descriptors as a sequential computation of the views, and that
+  matchPoint() only simulates the views selected by the last pose when
+  setUseAffineViewSelection() is enabled.
+*/
+int main()
+{
+  try {
+    vpImage<unsigned char> I;
+    buildScene(I);
+
+    vpKeyPoint keypoints("ORB", "ORB", "BruteForce-Hamming");
+
+    std::vector<std::vector<cv::KeyPoint> > listOfKeypoints, listOfKeypointsRef;
+    std::vector<cv::Mat> listOfDescriptors, listOfDescriptorsRef;
+    keypoints.detectExtractAffine(I, listOfKeypoints, listOfDescriptors);
+    detectExtractAffineSequential(keypoints, I, listOfKeypointsRef, listOfDescriptorsRef);
+
+    if (listOfKeypoints.size() != listOfKeypointsRef.size() ||
+        listOfDescriptors.size() != listOfDescriptorsRef.size()) {
+      std::cerr << listOfKeypoints.size() << " affine views instead of " << listOfKeypointsRef.size() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Each view, in the order of the views
+    size_t nbKeyPoints = 0;
+    for (size_t i = 0; i < listOfKeypointsRef.size(); i++) {
+      if (!sameKeyPoints(listOfKeypoints[i], listOfKeypointsRef[i]) ||
+          !sameDescriptors(listOfDescriptors[i], listOfDescriptorsRef[i])) {
+        std::cerr << "Affine view " << i << " differs from the sequential computation" << std::endl;
+        return EXIT_FAILURE;
+      }
+      nbKeyPoints += listOfKeypointsRef[i].size();
+    }
+    std::cout << nbKeyPoints << " keypoints in " << listOfKeypointsRef.size() << " affine views" << std::endl;
+    if (nbKeyPoints <= 100) {
+      std::cerr << "Not enough keypoints are detected" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The reference built with the affine detection merges the views in
+    // their order
+    std::vector<cv::KeyPoint> mergedKeypointsRef;
+    for (size_t i = 0; i < listOfKeypointsRef.size(); i++) {
+      mergedKeypointsRef.insert(mergedKeypointsRef.end(), listOfKeypointsRef[i].begin(), listOfKeypointsRef[i].end());
+    }
+
+    keypoints.setUseAffineDetection(true);
+    keypoints.buildReference(I);
+    std::vector<cv::KeyPoint> mergedKeypoints;
+    keypoints.getTrainKeyPoints(mergedKeypoints);
+    if (!sameKeyPoints(mergedKeypoints, mergedKeypointsRef) ||
+        !sameDescriptors(keypoints.getTrainDescriptors(), mergeDescriptors(listOfDescriptorsRef, std::vector<bool>()))) {
+      std::cerr << "The reference does not merge the affine views in their order" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The scene is a plane in front of the camera. The 3D reference only
+    // contains the keypoints of the first affine view, so that the inliers
+    // of the pose come from a few views.
+    vpCameraParameters cam(300.0, 300.0, 160.0, 120.0);
+    std::vector<cv::Point3f> points3f;
+    for (size_t i = 0; i < listOfKeypoints[0].size(); i++) {
+      double x = 0.0, y = 0.0;
+      vpPixelMeterConversion::convertPoint(cam, listOfKeypoints[0][i].pt.x, listOfKeypoints[0][i].pt.y, x, y);
+      points3f.push_back(cv::Point3f((float)x, (float)y, 1.f));
+    }
+
+    vpKeyPoint tracker("ORB", "ORB", "BruteForce-Hamming");
+    tracker.setUseAffineDetection(true);
+    tracker.setUseAffineViewSelection(true);
+    tracker.setRansacMinInlierCount(10);
+    tracker.buildReference(I, listOfKeypoints[0], listOfDescriptors[0], points3f);
+
+    const cv::Mat allDescriptors = mergeDescriptors(listOfDescriptors, std::vector<bool>());
+    vpHomogeneousMatrix cMo;
+    double error = 0.0, elapsedTime = 0.0;
+
+    // Without a previous pose, all the views are simulated
+    if (!tracker.matchPoint(I, cam, cMo, error, elapsedTime)) {
+      std::cerr << "The pose of the first image is not estimated" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!sameDescriptors(tracker.getQueryDescriptors(), allDescriptors)) {
+      std::cerr << "All the affine views are not simulated for the first image" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::vector<bool> selectedViews = selectAffineViews(listOfKeypoints, tracker.getRansacInliers());
+    size_t nbSelectedViews = (size_t)std::count(selectedViews.begin(), selectedViews.end(), true);
+    if (nbSelectedViews == 0 || nbSelectedViews == selectedViews.size()) {
+      std::cerr << nbSelectedViews << " affine views selected by the inliers of the first pose" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // After a pose, only the views of the inliers and their neighbors are
+    // simulated
+    if (!tracker.matchPoint(I, cam, cMo, error, elapsedTime)) {
+      std::cerr << "The pose of the second image is not estimated" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!sameDescriptors(tracker.getQueryDescriptors(), mergeDescriptors(listOfDescriptors, selectedViews))) {
+      std::cerr << "The second image does not simulate the " << nbSelectedViews << " selected affine views"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << nbSelectedViews << " affine views simulated after a pose" << std::endl;
+
+    // A failed pose, here on an image without keypoints, restores all the
+    // views
+    vpImage<unsigned char> I_uniform(I.getHeight(), I.getWidth(), 127);
+    if (tracker.matchPoint(I_uniform, cam, cMo, error, elapsedTime)) {
+      std::cerr << "A pose is estimated in a uniform image" << std::endl;
+      return EXIT_FAILURE;
+    }
+    tracker.matchPoint(I, cam, cMo, error, elapsedTime);
+    if (!sameDescriptors(tracker.getQueryDescriptors(), allDescriptors)) {
+      std::cerr << "All the affine views are not simulated after a failed pose" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } catch (const vpException &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testKeyPoint-9 is ok !" << std::endl;
+  return EXIT_SUCCESS;
+}
+#else
+int main()
+{
+  std::cerr << "You need OpenCV library." << std::endl;
+
+  return 0;
+}
+
+#endif
@@ -117,15 +117,21 @@ public:
   virtual void init() = 0;
 
   virtual vpColVector error(const vpBasicFeature &s_star, const unsigned int select = FEATURE_ALL);
+  virtual void fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                         const unsigned int select = FEATURE_ALL);
+  virtual void fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select = FEATURE_ALL);
+  virtual void fill_s(vpColVector &s_vector, const unsigned int offset, const unsigned int select = FEATURE_ALL) const;
 
   // Get the feature vector.
-  vpColVector get_s(unsigned int select = FEATURE_ALL) const;
+  virtual vpColVector get_s(unsigned int select = FEATURE_ALL) const;
   vpBasicFeatureDeallocatorType getDeallocate() { return deallocate; }
 
   // Get the feature vector dimension.
-  unsigned int getDimension(const unsigned int select = FEATURE_ALL) const;
+  virtual unsigned int getDimension(const unsigned int select = FEATURE_ALL) const;
   //! Compute the interaction matrix from a subset of the possible features.
   virtual vpMatrix interaction(const unsigned int select = FEATURE_ALL) = 0;
+  virtual void interactionNormalEquations(const vpColVector &e, const unsigned int offset, vpMatrix &LtL,
+                                          vpColVector &Lte, const unsigned int select = FEATURE_ALL);
   //! Return element \e i in the state vector  (usage : x = s[i] )
   virtual inline double operator[](const unsigned int i) const { return s[i]; }
   vpBasicFeature &operator=(const vpBasicFeature &f);
@@ -142,6 +148,9 @@ public:
   static unsigned int selectAll() { return FEATURE_ALL; }
 
 protected:
+  void checkFillDimension(unsigned int size, const unsigned int offset, const unsigned int select) const;
+  void fillSelectedError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                         const unsigned int select) const;
   void resetFlags();
 
 protected:
@@ -67,8 +67,10 @@
 // visual feature
 #include <visp3/visual_features/vpFeatureEllipse.h>
 #include <visp3/visual_features/vpFeatureLine.h>
+#include <visp3/visual_features/vpFeatureLineSet.h>
 #include <visp3/visual_features/vpFeaturePoint.h>
 #include <visp3/visual_features/vpFeaturePoint3D.h>
+#include <visp3/visual_features/vpFeaturePointSet.h>
 #include <visp3/visual_features/vpFeaturePointPolar.h>
 #include <visp3/visual_features/vpFeatureSegment.h>
 #include <visp3/visual_features/vpFeatureThetaU.h>
@@ -120,6 +122,10 @@ public:
   static void create(vpFeaturePointPolar &s, const vpCameraParameters &goodCam, const vpCameraParameters &wrongCam,
                      const vpPoint &p);
 
+  // create vpFeaturePointSet feature
+  static void create(vpFeaturePointSet &s, const std::vector<vpPoint> &p);
+  static void create(vpFeaturePointSet &s, const vpCameraParameters &cam, const std::vector<vpImagePoint> &ip);
+
   // create vpFeaturePoint3D feature
   static void create(vpFeaturePoint3D &s, const vpPoint &p);
 
@@ -131,6 +137,9 @@ public:
   static void create(vpFeatureLine &s, const vpCameraParameters &cam, const vpMeLine &mel);
 #endif
 
+  // create vpFeatureLineSet feature
+  static void create(vpFeatureLineSet &s, const std::vector<vpLine> &l);
+
   //! create vpFeatureEllipse feature
   static void create(vpFeatureEllipse &s, const vpCircle &c);
   static void create(vpFeatureEllipse &s, const vpSphere &sphere);
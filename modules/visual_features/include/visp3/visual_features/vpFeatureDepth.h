@@ -188,6 +188,9 @@ public:
                unsigned int thickness = 1) const;
   vpFeatureDepth *duplicate() const;
   vpColVector error(const vpBasicFeature &s_star, const unsigned int select = FEATURE_ALL);
+  void fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                 const unsigned int select = FEATURE_ALL);
+  void fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select = FEATURE_ALL);
 
   double get_x() const;
 
@@ -0,0 +1,121 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Set of depth visual features.
+ *
+ *****************************************************************************/
+
+#ifndef vpFeatureDepthSet_H
+#define vpFeatureDepthSet_H
+
+/*!
+  \file vpFeatureDepthSet.h
+  \brief Class that defines a set of depth visual features
+*/
+
+#include <vector>
+
+#include <visp3/core/vpMatrix.h>
+#include <visp3/visual_features/vpBasicFeature.h>
+
+/*!
+  \class vpFeatureDepthSet
+  \ingroup group_visual_features
+  \brief Class that defines a set of \f$ N \f$ depth visual features.
+
+  Each feature is \f$ s_i = \log(Z_i / Z_i^*) \f$ where \f$ Z_i \f$ and \f$
+  Z_i^* \f$ are the current and desired depths of point \e i, as in
+  vpFeatureDepth. The coordinates \f$ (x_i, y_i) \f$ of the points in the
+  image plane and their depth \f$ Z_i \f$ are needed to compute the
+  interaction matrix. They are stored in contiguous arrays and the
+  interaction matrix and the error of the whole set are computed in a single
+  loop, so that the set can be added to a vpServo task as one feature.
+
+  Since the desired feature is usually zero, the set is generally added to
+  the task with vpServo::addFeature(vpBasicFeature &, unsigned int) that
+  builds a null desired feature with the same number of points.
+*/
+class VISP_EXPORT vpFeatureDepthSet : public vpBasicFeature
+{
+protected:
+  //! Number of points
+  unsigned int m_nbPoints;
+  //! Coordinates of the points in the image plane
+  std::vector<double> m_x;
+  std::vector<double> m_y;
+  //! Depth of the points
+  std::vector<double> m_Z;
+
+public:
+  vpFeatureDepthSet();
+  explicit vpFeatureDepthSet(unsigned int n);
+  //! Destructor.
+  virtual ~vpFeatureDepthSet() {}
+
+  void buildFrom(const std::vector<double> &x, const std::vector<double> &y, const std::vector<double> &Z,
+                 const std::vector<double> &LogZoverZstar);
+
+  void display(const vpCameraParameters &cam, const vpImage<unsigned char> &I, const vpColor &color = vpColor::green,
+               unsigned int thickness = 1) const;
+  void display(const vpCameraParameters &cam, const vpImage<vpRGBa> &I, const vpColor &color = vpColor::green,
+               unsigned int thickness = 1) const;
+
+  vpFeatureDepthSet *duplicate() const;
+
+  vpColVector error(const vpBasicFeature &s_star, const unsigned int select = FEATURE_ALL);
+  void fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                 const unsigned int select = FEATURE_ALL);
+  void fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select = FEATURE_ALL);
+  void fill_s(vpColVector &s_vector, const unsigned int offset, const unsigned int select = FEATURE_ALL) const;
+
+  unsigned int getDimension(const unsigned int select = FEATURE_ALL) const;
+  //! Return \f$ \log(Z_i / Z_i^*) \f$ for point \e i.
+  double get_LogZoverZstar(unsigned int i) const { return s[i]; }
+  //! Return the number of points.
+  unsigned int getNumberOfPoints() const { return m_nbPoints; }
+  vpColVector get_s(unsigned int select = FEATURE_ALL) const;
+  //! Return the \f$ x \f$ coordinate of point \e i.
+  double get_x(unsigned int i) const { return m_x[i]; }
+  //! Return the \f$ y \f$ coordinate of point \e i.
+  double get_y(unsigned int i) const { return m_y[i]; }
+  //! Return the depth of point \e i.
+  double get_Z(unsigned int i) const { return m_Z[i]; }
+
+  void init();
+  void init(unsigned int n);
+  vpMatrix interaction(const unsigned int select = FEATURE_ALL);
+
+  void print(const unsigned int select = FEATURE_ALL) const;
+
+  void set_xyZLogZoverZstar(unsigned int i, double x, double y, double Z, double LogZoverZstar);
+};
+
+#endif
@@ -220,6 +220,9 @@ public:
   vpFeatureLine *duplicate() const;
 
   vpColVector error(const vpBasicFeature &s_star, const unsigned int select = FEATURE_ALL);
+  void fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                 const unsigned int select = FEATURE_ALL);
+  void fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select = FEATURE_ALL);
   // vpColVector error(const int select = FEATURE_ALL)  ;
 
   /*!
@@ -0,0 +1,126 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Set of 2D line visual features.
+ *
+ *****************************************************************************/
+
+#ifndef vpFeatureLineSet_H
+#define vpFeatureLineSet_H
+
+/*!
+  \file vpFeatureLineSet.h
+  \brief Class that defines a set of 2D line visual features
+*/
+
+#include <vector>
+
+#include <visp3/core/vpMatrix.h>
+#include <visp3/visual_features/vpBasicFeature.h>
+
+/*!
+  \class vpFeatureLineSet
+  \ingroup group_visual_features
+  \brief Class that defines a set of \f$ N \f$ 2D line visual features.
+
+  Each line is described by the \f$ (\rho_i, \theta_i) \f$ parameters of
+  its equation in the image plane \f$ x \cos(\theta_i) + y \sin(\theta_i) -
+  \rho_i = 0 \f$ and by the equation \f$ A_i X + B_i Y + C_i Z + D_i = 0 \f$
+  of a plane containing the 3D line, as in vpFeatureLine. The parameters are
+  stored in contiguous arrays and the interaction matrix and the error of the
+  whole set are computed in a single loop, so that the set can be added to a
+  vpServo task as one feature.
+
+  The feature vector is ordered by parameter:
+  \f[ {\bf s} = (\rho_0, \ldots, \rho_{N-1}, \theta_0, \ldots, \theta_{N-1}) \f]
+  and the rows of the interaction matrix follow the same order. selectRho()
+  and selectTheta() select respectively the \f$ \rho \f$ and the \f$ \theta
+  \f$ parameters of all the lines.
+
+  \sa vpFeatureBuilder::create(vpFeatureLineSet &, const std::vector<vpLine> &)
+*/
+class VISP_EXPORT vpFeatureLineSet : public vpBasicFeature
+{
+protected:
+  //! Number of lines
+  unsigned int m_nbLines;
+  //! Equations of the planes containing the lines
+  std::vector<double> m_A;
+  std::vector<double> m_B;
+  std::vector<double> m_C;
+  std::vector<double> m_D;
+
+public:
+  vpFeatureLineSet();
+  explicit vpFeatureLineSet(unsigned int n);
+  //! Destructor.
+  virtual ~vpFeatureLineSet() {}
+
+  void buildFrom(const std::vector<double> &rho, const std::vector<double> &theta, const std::vector<double> &A,
+                 const std::vector<double> &B, const std::vector<double> &C, const std::vector<double> &D);
+
+  void display(const vpCameraParameters &cam, const vpImage<unsigned char> &I, const vpColor &color = vpColor::green,
+               unsigned int thickness = 1) const;
+  void display(const vpCameraParameters &cam, const vpImage<vpRGBa> &I, const vpColor &color = vpColor::green,
+               unsigned int thickness = 1) const;
+
+  vpFeatureLineSet *duplicate() const;
+
+  vpColVector error(const vpBasicFeature &s_star, const unsigned int select = FEATURE_ALL);
+  void fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                 const unsigned int select = FEATURE_ALL);
+  void fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select = FEATURE_ALL);
+  void fill_s(vpColVector &s_vector, const unsigned int offset, const unsigned int select = FEATURE_ALL) const;
+
+  unsigned int getDimension(const unsigned int select = FEATURE_ALL) const;
+  //! Return the number of lines.
+  unsigned int getNumberOfLines() const { return m_nbLines; }
+  //! Return the \f$ \rho \f$ parameter of line \e i.
+  double getRho(unsigned int i) const { return s[i]; }
+  //! Return the \f$ \theta \f$ parameter of line \e i.
+  double getTheta(unsigned int i) const { return s[m_nbLines + i]; }
+  vpColVector get_s(unsigned int select = FEATURE_ALL) const;
+
+  void init();
+  void init(unsigned int n);
+  vpMatrix interaction(const unsigned int select = FEATURE_ALL);
+
+  void print(const unsigned int select = FEATURE_ALL) const;
+
+  void setABCD(unsigned int i, double A, double B, double C, double D);
+  void setRhoTheta(unsigned int i, double rho, double theta);
+
+  // feature selection
+  static unsigned int selectRho();
+  static unsigned int selectTheta();
+};
+
+#endif
@@ -39,6 +39,8 @@
 #ifndef vpFeatureLuminance_h
 #define vpFeatureLuminance_h
 
+#include <vector>
+
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpMatrix.h>
 #include <visp3/visual_features/vpBasicFeature.h>
@@ -74,6 +76,33 @@ public:
   \brief Class that defines the image luminance visual feature
 
   For more details see \cite Collewet08c.
+
+  By default all the pixels of the image except a border of 10 pixels are
+  considered. To reduce the size of the feature, only a subset of the
+  pixels could be selected:
+  - setSubsampling() keeps one pixel out of \e step along the rows and the
+    columns,
+  - setGradientThreshold() keeps only the pixels with a gradient magnitude
+    above a threshold,
+  - setPyramidLevel() builds the feature from a lower resolution image of the
+    Gaussian pyramid; this allows a coarse-to-fine control scheme.
+
+  The selection is done the first time buildFrom() is called. Since the
+  current and desired features have to share the same pixels, the selection
+  of one feature can be copied to the other using setPixelSelection():
+  \code
+  vpFeatureLuminance sId;
+  sId.init(Id.getHeight(), Id.getWidth(), Z);
+  sId.setCameraParameters(cam);
+  sId.setGradientThreshold(10);
+  sId.buildFrom(Id); // Select the pixels with a gradient magnitude > 10
+
+  vpFeatureLuminance sI;
+  sI.init(I.getHeight(), I.getWidth(), Z);
+  sI.setCameraParameters(cam);
+  sI.setPixelSelection(sId); // Use the same pixels than the desired feature
+  sI.buildFrom(I);
+  \endcode
 */
 
 class VISP_EXPORT vpFeatureLuminance : public vpBasicFeature
@@ -90,10 +119,37 @@ protected:
   //! Border size.
   unsigned int bord;
 
-  //! Store the image (as a vector with intensity and gradient I, Ix, Iy)
+  /*!
+    \deprecated Not used anymore since the luminance and gradients of the
+    selected pixels are stored in m_x, m_y, m_Ix and m_Iy. Kept for
+    compatibility with derived classes, it is always NULL.
+  */
   vpLuminance *pixInfo;
   int firstTimeIn;
 
+  //! Index of the selected pixels in the image used to build the feature
+  std::vector<unsigned int> m_index;
+  //! Coordinates in meter of the selected pixels
+  std::vector<double> m_x;
+  std::vector<double> m_y;
+  //! Gradient of the selected pixels, multiplied by the focal length
+  std::vector<double> m_Ix;
+  std::vector<double> m_Iy;
+  //! Width of the image used to select the pixels
+  unsigned int m_width;
+  //! Height of the image used to select the pixels
+  unsigned int m_height;
+  //! True if all the pixels except the border are selected
+  bool m_dense;
+  //! Subsampling step along the rows and the columns
+  unsigned int m_step;
+  //! Minimal gradient magnitude of the selected pixels
+  double m_gradThreshold;
+  //! Level of the Gaussian pyramid used to build the feature
+  unsigned int m_pyramidLevel;
+  //! Buffers used to compute the Gaussian pyramid
+  vpImage<unsigned char> m_Ipyr[2];
+
 public:
   vpFeatureLuminance();
   vpFeatureLuminance(const vpFeatureLuminance &f);
@@ -111,23 +167,54 @@ public:
 
   vpColVector error(const vpBasicFeature &s_star, const unsigned int select = FEATURE_ALL);
   void error(const vpBasicFeature &s_star, vpColVector &e);
+  void fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                 const unsigned int select = FEATURE_ALL);
+  void fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select = FEATURE_ALL);
   //! Compute the error between a visual features and zero
   vpColVector error(const unsigned int select = FEATURE_ALL);
 
+  /*!
+    Return the minimal gradient magnitude of the selected pixels.
+    \sa setGradientThreshold()
+  */
+  double getGradientThreshold() const { return m_gradThreshold; }
+  //! Return the number of selected pixels, whatever the selection.
+  unsigned int getDimension(const unsigned int /* select */ = FEATURE_ALL) const { return dim_s; }
+  /*!
+    Return the level of the Gaussian pyramid used to build the feature.
+    \sa setPyramidLevel()
+  */
+  unsigned int getPyramidLevel() const { return m_pyramidLevel; }
+  /*!
+    Return the subsampling step.
+    \sa setSubsampling()
+  */
+  unsigned int getSubsampling() const { return m_step; }
   double get_Z() const;
 
   void init();
   void init(unsigned int _nbr, unsigned int _nbc, double _Z);
   vpMatrix interaction(const unsigned int select = FEATURE_ALL);
   void interaction(vpMatrix &L);
+  void interactionNormalEquations(const vpColVector &e, const unsigned int offset, vpMatrix &LtL, vpColVector &Lte,
+                                  const unsigned int select = FEATURE_ALL);
 
   vpFeatureLuminance &operator=(const vpFeatureLuminance &f);
 
   void print(const unsigned int select = FEATURE_ALL) const;
 
   void setCameraParameters(vpCameraParameters &_cam);
+  void setGradientThreshold(double threshold);
+  void setPixelSelection(const vpFeatureLuminance &f);
+  void setPyramidLevel(unsigned int level);
+  void setSubsampling(unsigned int step);
   void set_Z(const double Z);
 
+protected:
+  void computeGradients(const vpImage<unsigned char> &I);
+  vpCameraParameters getLevelCameraParameters() const;
+  void selectPixels(const vpImage<unsigned char> &I, unsigned int rows, unsigned int cols);
+
 public:
   vpCameraParameters cam;
 };
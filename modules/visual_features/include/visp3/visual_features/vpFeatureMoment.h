@@ -219,7 +219,8 @@ public:
   void display(const vpCameraParameters &cam, const vpImage<vpRGBa> &I, const vpColor &color = vpColor::green,
                unsigned int thickness = 1) const;
 
-  int getDimension(unsigned int select = FEATURE_ALL) const;
+  unsigned int getDimension(unsigned int select = FEATURE_ALL) const;
+  virtual void getDependencies(std::vector<const char *> &names) const;
   void init(void);
   vpMatrix interaction(const unsigned int select = FEATURE_ALL);
   void linkTo(vpFeatureMomentDatabase &featureMoments);
@@ -240,6 +241,7 @@ public:
 
   //@}
   friend VISP_EXPORT std::ostream &operator<<(std::ostream &os, const vpFeatureMoment &featM);
+  friend class vpFeatureMomentDatabase;
 };
 
 /*!
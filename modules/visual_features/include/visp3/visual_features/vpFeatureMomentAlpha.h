@@ -104,6 +104,7 @@ public:
     feature name
     */
   const char *name() const { return "vpFeatureMomentAlpha"; }
+  void getDependencies(std::vector<const char *> &names) const;
 };
 #else
 class vpMomentDatabase;
@@ -107,6 +107,7 @@ public:
     feature name
     */
   const char *name() const { return "vpFeatureMomentAreaNormalized"; }
+  void getDependencies(std::vector<const char *> &names) const;
 };
 
 #else
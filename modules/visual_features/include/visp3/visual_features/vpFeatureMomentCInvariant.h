@@ -119,6 +119,7 @@ public:
     feature name
     */
   const char *name() const { return "vpFeatureMomentCInvariant"; }
+  void getDependencies(std::vector<const char *> &names) const;
 
   /*!
     Shortcut selector for \f$C_1\f$.
@@ -260,6 +261,7 @@ public:
     feature name
     */
   const char *name() const { return "vpFeatureMomentCInvariant"; }
+  void getDependencies(std::vector<const char *> &names) const;
 
   /*!
     Shortcut selector for \f$C_1\f$.
@@ -113,6 +113,7 @@ public:
     feature name
     */
   const char *name() const { return "vpFeatureMomentCentered"; }
+  void getDependencies(std::vector<const char *> &names) const;
 
   friend VISP_EXPORT std::ostream &operator<<(std::ostream &os, const vpFeatureMomentCentered &v);
 };
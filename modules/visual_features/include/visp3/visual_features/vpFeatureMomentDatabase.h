@@ -47,6 +47,7 @@
 #include <cstring>
 #include <iostream>
 #include <map>
+#include <vector>
 #include <visp3/core/vpConfig.h>
 
 class vpFeatureMoment;
@@ -154,6 +155,13 @@ int main()
   return 0;
 }
 \endcode
+
+  The dependencies declared by the features (see
+vpFeatureMoment::getDependencies()) are resolved once into an ordered list of
+features. vpFeatureMomentDatabase::updateAll() then runs a single linear pass
+over this list and only updates the features for which the plane
+coefficients, the moments (see vpMomentDatabase::getRevision()) or one of the
+features they depend on have changed.
 */
 class VISP_EXPORT vpFeatureMomentDatabase
 {
@@ -163,20 +171,47 @@ private:
     char *operator=(const char *) { return NULL; } // Only to avoid a warning under Visual with /Wall flag
   };
   std::map<const char *, vpFeatureMoment *, cmp_str> featureMomentsDataBase;
+  //! Features in the order they were linked to the database
+  std::vector<vpFeatureMoment *> linkOrder;
+  //! Features sorted such as each feature comes after its dependencies
+  std::vector<vpFeatureMoment *> updateOrder;
+  //! Dependencies of updateOrder[i], as indexes in updateOrder, are in
+  //! dependencies[dependencyStart[i]] to dependencies[dependencyStart[i+1]-1]
+  std::vector<unsigned int> dependencyStart;
+  std::vector<unsigned int> dependencies;
+  //! Revision of the moment database used for the last update of each feature
+  std::vector<unsigned long> momentsRevision;
+  //! 1 if the feature was never updated by updateAll() or was invalidated
+  std::vector<char> outdated;
+  //! 1 if the feature was updated during the current pass
+  std::vector<char> updated;
+  bool compiled;
+
   void add(vpFeatureMoment &featureMoment, char *name);
+  void compileNode(unsigned int index, std::vector<int> &state);
 
 public:
   /*!
     Default constructor.
   */
-  vpFeatureMomentDatabase() : featureMomentsDataBase() {}
+  vpFeatureMomentDatabase()
+    : featureMomentsDataBase(), linkOrder(), updateOrder(), dependencyStart(), dependencies(), momentsRevision(),
+      outdated(), updated(), compiled(false)
+  {
+  }
   /*!
     Virtual destructor that does nothing.
   */
   virtual ~vpFeatureMomentDatabase() {}
-  virtual void updateAll(double A = 0.0, double B = 0.0, double C = 1.0);
 
+  void compile();
   vpFeatureMoment &get(const char *type, bool &found);
+  /*!
+    Features of the database sorted in update order. Updated by compile().
+  */
+  const std::vector<vpFeatureMoment *> &getUpdateOrder() const { return updateOrder; }
+  void invalidate();
+  virtual void updateAll(double A = 0.0, double B = 0.0, double C = 1.0);
 
   // friend VISP_EXPORT std::ostream & operator<<(std::ostream& os, const
   // vpFeatureMomentDatabase& m);
@@ -174,6 +174,7 @@ public:
     Feature name.
     */
   const char *name() const { return "vpFeatureMomentGravityCenter"; }
+  void getDependencies(std::vector<const char *> &names) const;
 
   /*!
     Shortcut selector for \f$x_g\f$.
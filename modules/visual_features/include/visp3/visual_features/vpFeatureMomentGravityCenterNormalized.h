@@ -116,6 +116,7 @@ public:
       feature name
     */
   const char *name() const { return "vpFeatureMomentGravityCenterNormalized"; }
+  void getDependencies(std::vector<const char *> &names) const;
 
   /*!
     Shortcut selector for \f$x_n\f$.
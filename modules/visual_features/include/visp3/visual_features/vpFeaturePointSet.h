@@ -0,0 +1,152 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Set of 2D point visual features.
+ *
+ *****************************************************************************/
+
+#ifndef vpFeaturePointSet_H
+#define vpFeaturePointSet_H
+
+/*!
+  \file vpFeaturePointSet.h
+  \brief Class that defines a set of 2D point visual features
+*/
+
+#include <vector>
+
+#include <visp3/core/vpMatrix.h>
+#include <visp3/visual_features/vpBasicFeature.h>
+
+/*!
+  \class vpFeaturePointSet
+  \ingroup group_visual_features
+  \brief Class that defines a set of \f$ N \f$ 2D point visual features.
+
+  The feature gathers the cartesian coordinates \f$ (x_i, y_i) \f$ of \f$ N
+  \f$ points given in meter in the image plane, together with their depth \f$
+  Z_i \f$ needed to compute the interaction matrix. It is equivalent to \f$ N
+  \f$ vpFeaturePoint added to a vpServo task, but the coordinates are stored
+  in contiguous arrays and the interaction matrix and the error of the whole
+  set are computed in a single loop. This avoids one vpBasicFeature, one
+  virtual call and several small matrices per point when servoing on a large
+  number of points.
+
+  The feature vector is ordered by coordinate:
+  \f[ {\bf s} = (x_0, \ldots, x_{N-1}, y_0, \ldots, y_{N-1}) \f]
+  and the rows of the interaction matrix follow the same order. selectX() and
+  selectY() select respectively the \f$ x \f$ and the \f$ y \f$ coordinates
+  of all the points.
+
+  \code
+#include <visp3/visual_features/vpFeaturePointSet.h>
+#include <visp3/vs/vpServo.h>
+
+int main()
+{
+  unsigned int n = 100;
+  vpFeaturePointSet s(n), sd(n);
+  for (unsigned int i = 0; i < n; i++) {
+    double xd = 0, yd = 0, Zd = 1; // You have to compute the desired values
+    sd.set_xyZ(i, xd, yd, Zd);
+  }
+
+  vpServo task;
+  task.setServo(vpServo::EYEINHAND_CAMERA);
+  task.setInteractionMatrixType(vpServo::CURRENT);
+  task.addFeature(s, sd); // The N points are one feature of the task
+
+  for ( ; ; ) {
+    for (unsigned int i = 0; i < n; i++) {
+      double x = 0, y = 0, Z = 1; // You have to compute the current values
+      s.set_xyZ(i, x, y, Z);
+    }
+    vpColVector v = task.computeControlLaw();
+  }
+}
+  \endcode
+
+  \sa vpFeatureBuilder::create(vpFeaturePointSet &, const std::vector<vpPoint> &)
+*/
+class VISP_EXPORT vpFeaturePointSet : public vpBasicFeature
+{
+protected:
+  //! Number of points
+  unsigned int m_nbPoints;
+  //! Depth of the points (required to compute the interaction matrix)
+  std::vector<double> m_Z;
+
+public:
+  vpFeaturePointSet();
+  explicit vpFeaturePointSet(unsigned int n);
+  //! Destructor.
+  virtual ~vpFeaturePointSet() {}
+
+  void buildFrom(const std::vector<double> &x, const std::vector<double> &y, const std::vector<double> &Z);
+
+  void display(const vpCameraParameters &cam, const vpImage<unsigned char> &I, const vpColor &color = vpColor::green,
+               unsigned int thickness = 1) const;
+  void display(const vpCameraParameters &cam, const vpImage<vpRGBa> &I, const vpColor &color = vpColor::green,
+               unsigned int thickness = 1) const;
+
+  vpFeaturePointSet *duplicate() const;
+
+  vpColVector error(const vpBasicFeature &s_star, const unsigned int select = FEATURE_ALL);
+  void fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                 const unsigned int select = FEATURE_ALL);
+  void fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select = FEATURE_ALL);
+  void fill_s(vpColVector &s_vector, const unsigned int offset, const unsigned int select = FEATURE_ALL) const;
+
+  unsigned int getDimension(const unsigned int select = FEATURE_ALL) const;
+  //! Return the number of points.
+  unsigned int getNumberOfPoints() const { return m_nbPoints; }
+  vpColVector get_s(unsigned int select = FEATURE_ALL) const;
+  //! Return the \f$ x \f$ coordinate of point \e i.
+  double get_x(unsigned int i) const { return s[i]; }
+  //! Return the \f$ y \f$ coordinate of point \e i.
+  double get_y(unsigned int i) const { return s[m_nbPoints + i]; }
+  //! Return the depth of point \e i.
+  double get_Z(unsigned int i) const { return m_Z[i]; }
+
+  void init();
+  void init(unsigned int n);
+  vpMatrix interaction(const unsigned int select = FEATURE_ALL);
+
+  void print(const unsigned int select = FEATURE_ALL) const;
+
+  void set_xyZ(unsigned int i, double x, double y, double Z);
+
+  // feature selection
+  static unsigned int selectX();
+  static unsigned int selectY();
+};
+
+#endif
@@ -92,6 +92,9 @@ public:
   //! compute the error between two visual features from a subset
   //! a the possible features
   vpColVector error(const vpBasicFeature &s_star, const unsigned int select = FEATURE_ALL);
+  void fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                 const unsigned int select = FEATURE_ALL);
+  void fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select = FEATURE_ALL);
   //! compute the error between a visual features and zero
   vpColVector error(const unsigned int select = FEATURE_ALL);
 
@@ -198,6 +198,9 @@ public:
   vpColVector error(const vpBasicFeature &s_star, const unsigned int select = FEATURE_ALL);
 
   vpColVector error(const unsigned int select = FEATURE_ALL);
+  void fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                 const unsigned int select = FEATURE_ALL);
+  void fillInteraction(vpMatrix &Ls, const unsigned int offset, const unsigned int select = FEATURE_ALL);
 
   vpMatrix getInteractionMatrix() const { return L; }
   void get_s(vpColVector &s) const;
@@ -220,6 +223,9 @@ public:
 private:
   typedef enum { errorNotInitalized, errorInitialized, errorHasToBeUpdated } vpGenericFeatureErrorType;
 
+  void fillGenericError(const vpBasicFeature *s_star, vpColVector &e, const unsigned int offset,
+                        const unsigned int select);
+
   vpMatrix L;
   vpColVector err;
   vpGenericFeatureErrorType errorStatus;
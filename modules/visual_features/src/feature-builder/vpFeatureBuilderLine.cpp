@@ -255,3 +255,27 @@ void vpFeatureBuilder::create(vpFeatureLine &s, const vpCameraParameters &cam, c
   }
 }
 #endif //#ifdef VISP_HAVE_MODULE_ME
+
+/*!
+  Initialize a set of line features from lines projected in the image plane,
+  as create(vpFeatureLine &, const vpLine &) does for a single line: for each
+  line, the plane with the biggest D parameter is kept. The set is resized to
+  the number of lines.
+
+  \param s : Visual feature to initialize.
+  \param l : The lines, projected in the image plane.
+*/
+void vpFeatureBuilder::create(vpFeatureLineSet &s, const std::vector<vpLine> &l)
+{
+  if (l.size() != s.getNumberOfLines())
+    s.init((unsigned int)l.size());
+
+  for (unsigned int i = 0; i < (unsigned int)l.size(); i++) {
+    const vpLine &t = l[i];
+    s.setRhoTheta(i, t.getRho(), t.getTheta());
+    if (fabs(t.cP[3]) > fabs(t.cP[7])) // |D1| > |D2|
+      s.setABCD(i, t.cP[0], t.cP[1], t.cP[2], t.cP[3]);
+    else
+      s.setABCD(i, t.cP[4], t.cP[5], t.cP[6], t.cP[7]);
+  }
+}
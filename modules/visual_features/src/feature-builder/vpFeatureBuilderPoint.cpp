@@ -319,3 +319,47 @@ void vpFeatureBuilder::create(vpFeaturePoint &s, const vpCameraParameters &goodC
     throw;
   }
 }
+
+/*!
+  Initialize a set of point features from the 2D coordinates \f$ (x,y) \f$
+  and the depth \f$ Z \f$ of the points, as
+  create(vpFeaturePoint &, const vpPoint &) does for a single point. The set
+  is resized to the number of points.
+
+  \param s : Visual feature to initialize.
+  \param p : The points, projected in the image plane.
+
+  \exception vpFeatureException::badInitializationError : If a point is
+  behind the camera or has a null depth.
+*/
+void vpFeatureBuilder::create(vpFeaturePointSet &s, const std::vector<vpPoint> &p)
+{
+  if (p.size() != s.getNumberOfPoints())
+    s.init((unsigned int)p.size());
+
+  for (unsigned int i = 0; i < (unsigned int)p.size(); i++)
+    s.set_xyZ(i, p[i].get_x(), p[i].get_y(), p[i].cP[2] / p[i].cP[3]);
+}
+
+/*!
+  Initialize the 2D coordinates \f$ (x,y) \f$ of a set of point features
+  from pixel coordinates. The depths of the points are kept unchanged, they
+  have to be set afterwards with vpFeaturePointSet::set_xyZ() if they are not
+  already known. If the number of points changes, the set is resized and the
+  depths are reset to 1.
+
+  \param s : Visual feature to initialize.
+  \param cam : Camera parameters used to convert pixels into meters.
+  \param ip : The points in the image, in pixels.
+*/
+void vpFeatureBuilder::create(vpFeaturePointSet &s, const vpCameraParameters &cam, const std::vector<vpImagePoint> &ip)
+{
+  if (ip.size() != s.getNumberOfPoints())
+    s.init((unsigned int)ip.size());
+
+  for (unsigned int i = 0; i < (unsigned int)ip.size(); i++) {
+    double x = 0, y = 0;
+    vpPixelMeterConversion::convertPoint(cam, ip[i], x, y);
+    s.set_xyZ(i, x, y, s.get_Z(i));
+  }
+}
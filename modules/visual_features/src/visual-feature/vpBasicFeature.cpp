@@ -37,6 +37,7 @@
  *
  *****************************************************************************/
 
+#include <visp3/core/vpException.h>
 #include <visp3/visual_features/vpBasicFeature.h>
 
 const unsigned int vpBasicFeature::FEATURE_LINE[32] = {
@@ -113,17 +114,16 @@ unsigned int vpBasicFeature::getDimension(unsigned int select) const
 //! Get the feature vector  \f$\bf s\f$.
 vpColVector vpBasicFeature::get_s(const unsigned int select) const
 {
-  vpColVector state(0), stateLine(1);
   // if s is higher than the possible selections (photometry), send back the
   // whole vector
   if (dim_s > 31)
     return s;
 
+  vpColVector state(vpBasicFeature::getDimension(select));
+  unsigned int row = 0;
   for (unsigned int i = 0; i < dim_s; ++i) {
-    if (FEATURE_LINE[i] & select) {
-      stateLine[0] = s[i];
-      state.stack(stateLine);
-    }
+    if (FEATURE_LINE[i] & select)
+      state[row++] = s[i];
   }
   return state;
 }
@@ -150,22 +150,193 @@ void vpBasicFeature::setFlags()
 //! possible features.
 vpColVector vpBasicFeature::error(const vpBasicFeature &s_star, const unsigned int select)
 {
-  vpColVector e(0), eLine(1);
-  if (dim_s <= 31) {
-    for (unsigned int i = 0; i < dim_s; ++i) {
-      if (FEATURE_LINE[i] & select) {
-        eLine[0] = s[i] - s_star[i];
-        e.stack(eLine);
-        // std::cout << "dim_s <= 31"<<std::endl;
+  vpColVector e(vpBasicFeature::getDimension(select));
+  fillSelectedError(s_star, e, 0, select);
+  return e;
+}
+
+/*!
+  Write the error \f$ (s-s^*)\f$ between two visual features in the rows of
+  \e e starting at \e offset, without allocating a temporary vector. This is
+  the method used by vpServo to build the task error.
+
+  This default implementation copies the vector returned by error(). The
+  built-in features override it to write directly in \e e.
+
+  \param s_star : Desired visual feature.
+  \param e : Error vector with at least \e offset + getDimension(select) rows.
+  \param offset : Index of the first row of \e e related to this feature.
+  \param select : Subset of the feature to consider.
+
+  \exception vpException::dimensionError : If \e e is too small. Also if the
+  size of the vector returned by error() differs from getDimension(select):
+  \e e is then resized to end with this vector written at \e offset, so that
+  the caller can stack the following features without computing this error
+  again.
+*/
+void vpBasicFeature::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                               const unsigned int select)
+{
+  vpColVector ef = error(s_star, select);
+  const bool sizeMismatch = (ef.getRows() != getDimension(select));
+  if (sizeMismatch) {
+    e.resize(offset + ef.getRows(), false);
+  } else if (offset + ef.getRows() > e.getRows()) {
+    throw(vpException(vpException::dimensionError, "Error vector too small to store the feature error"));
+  }
+  for (unsigned int i = 0; i < ef.getRows(); i++)
+    e[offset + i] = ef[i];
+
+  if (sizeMismatch) {
+    throw(vpException(vpException::dimensionError, "Feature error has %d rows instead of %d", ef.getRows(),
+                      getDimension(select)));
+  }
+}
+
+/*!
+  Write the interaction matrix of a subset of the feature in the rows of \e L
+  starting at \e offset, without allocating a temporary matrix. This is the
+  method used by vpServo to build the task interaction matrix.
+
+  This default implementation copies the matrix returned by interaction().
+  The built-in features override it to write directly in \e L.
+
+  \param L : Interaction matrix with 6 columns and at least \e offset +
+  getDimension(select) rows.
+  \param offset : Index of the first row of \e L related to this feature.
+  \param select : Subset of the feature to consider.
+
+  \exception vpException::dimensionError : If \e L is too small or has not
+  the number of columns of the matrix returned by interaction(). Also if the
+  number of rows of this matrix differs from getDimension(select): \e L is
+  then resized to end with this matrix written at \e offset, so that the
+  caller can stack the following features without computing this matrix
+  again.
+*/
+void vpBasicFeature::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  vpMatrix Lf = interaction(select);
+  if (Lf.getRows() > 0 && Lf.getCols() != L.getCols()) {
+    throw(vpException(vpException::dimensionError, "Feature interaction matrix has %d columns instead of %d",
+                      Lf.getCols(), L.getCols()));
+  }
+  const bool sizeMismatch = (Lf.getRows() != getDimension(select));
+  if (sizeMismatch) {
+    L.resize(offset + Lf.getRows(), L.getCols(), false);
+  } else if (offset + Lf.getRows() > L.getRows()) {
+    throw(vpException(vpException::dimensionError, "Interaction matrix too small to store the feature one"));
+  }
+  for (unsigned int i = 0; i < Lf.getRows(); i++)
+    for (unsigned int j = 0; j < Lf.getCols(); j++)
+      L[offset + i][j] = Lf[i][j];
+
+  if (sizeMismatch) {
+    throw(vpException(vpException::dimensionError, "Feature interaction matrix has %d rows instead of %d",
+                      Lf.getRows(), getDimension(select)));
+  }
+}
+
+/*!
+  Write the selected subset of the feature vector in the rows of \e s_vector
+  starting at \e offset. Features that override get_s() also override this
+  method.
+
+  \param s_vector : Vector with at least \e offset + getDimension(select)
+  rows.
+  \param offset : Index of the first row of \e s_vector related to this
+  feature.
+  \param select : Subset of the feature to consider.
+
+  \exception vpException::dimensionError : If \e s_vector is too small.
+*/
+void vpBasicFeature::fill_s(vpColVector &s_vector, const unsigned int offset, const unsigned int select) const
+{
+  if (offset + vpBasicFeature::getDimension(select) > s_vector.getRows()) {
+    throw(vpException(vpException::dimensionError, "Vector too small to store the feature"));
+  }
+  unsigned int row = offset;
+  for (unsigned int i = 0; i < dim_s; ++i) {
+    if (dim_s > 31 || (FEATURE_LINE[i] & select))
+      s_vector[row++] = s[i];
+  }
+}
+
+/*
+  Check that a vector or a matrix with size rows can store the selected
+  subset of the feature starting at offset.
+*/
+void vpBasicFeature::checkFillDimension(unsigned int size, const unsigned int offset, const unsigned int select) const
+{
+  if (offset + getDimension(select) > size) {
+    throw(vpException(vpException::dimensionError, "Cannot store %d feature rows from row %d in %d rows",
+                      getDimension(select), offset, size));
+  }
+}
+
+/*
+  Write the difference s - s* of the selected rows of the feature starting at
+  offset. All the rows are used when the feature dimension is higher than 31.
+*/
+void vpBasicFeature::fillSelectedError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                                       const unsigned int select) const
+{
+  if (offset + vpBasicFeature::getDimension(select) > e.getRows()) {
+    throw(vpException(vpException::dimensionError, "Error vector too small to store the feature error"));
+  }
+  unsigned int row = offset;
+  for (unsigned int i = 0; i < dim_s; ++i) {
+    if (dim_s > 31 || (FEATURE_LINE[i] & select))
+      e[row++] = s[i] - s_star[i];
+  }
+}
+
+/*!
+  Accumulate the normal equations \f${\bf L}^\top {\bf L}\f$ and \f${\bf
+  L}^\top {\bf e}\f$ related to this feature, where \f$\bf L\f$ is the
+  interaction matrix of the selected subset of the feature.
+
+  This default implementation builds the interaction matrix with interaction()
+  and multiplies it by its transpose. Features with a large dimension (like
+  vpFeatureLuminance) override it to accumulate the \f$6 \times 6\f$ terms
+  row by row without building \f$\bf L\f$.
+
+  \param e : Error vector of the whole task. The rows corresponding to this
+  feature start at index \e offset.
+  \param offset : Index of the first row of \e e related to this feature.
+  \param LtL : \f$6 \times 6\f$ matrix updated with \f${\bf L}^\top {\bf L}\f$.
+  \param Lte : 6-dimension vector updated with \f${\bf L}^\top {\bf e}\f$.
+  \param select : Subset of the feature to consider.
+*/
+void vpBasicFeature::interactionNormalEquations(const vpColVector &e, const unsigned int offset, vpMatrix &LtL,
+                                                vpColVector &Lte, const unsigned int select)
+{
+  vpMatrix L = interaction(select);
+  unsigned int nrows = L.getRows();
+  unsigned int ncols = L.getCols();
+
+  if (offset + nrows > e.getRows()) {
+    throw(vpException(vpException::dimensionError, "Error vector too small to compute the normal equations"));
+  }
+  if (LtL.getRows() != ncols || LtL.getCols() != ncols || Lte.getRows() != ncols) {
+    throw(vpException(vpException::dimensionError, "Bad normal equations dimension"));
+  }
+
+  for (unsigned int k = 0; k < nrows; k++) {
+    const double *Lk = L[k];
+    double ek = e[offset + k];
+    for (unsigned int i = 0; i < ncols; i++) {
+      for (unsigned int j = i; j < ncols; j++) {
+        LtL[i][j] += Lk[i] * Lk[j];
       }
+      Lte[i] += Lk[i] * ek;
+    }
+  }
+  // Fill the lower part of the symmetric matrix
+  for (unsigned int i = 1; i < ncols; i++) {
+    for (unsigned int j = 0; j < i; j++) {
+      LtL[i][j] = LtL[j][i];
     }
-  } else {
-    e.resize(dim_s);
-    vpColVector sd = s_star.get_s();
-    e = s - sd;
   }
-
-  return e;
 }
 
 /*
@@ -219,7 +219,20 @@ void vpFeatureDepth::set_xyZLogZoverZstar(const double x_, const double y_, cons
 */
 vpMatrix vpFeatureDepth::interaction(const unsigned int select)
 {
-  vpMatrix L;
+  vpMatrix L(getDimension(select), 6);
+  fillInteraction(L, 0, select);
+  return L;
+}
+
+/*!
+  Write the interaction matrix of the selected subset of the feature in the
+  rows of \e L starting at \e offset, without temporary matrix. See
+  interaction() for the selection.
+*/
+void vpFeatureDepth::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  checkFillDimension(L.getRows(), offset, select);
+  unsigned int row = offset;
 
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
@@ -245,8 +258,6 @@ vpMatrix vpFeatureDepth::interaction(const unsigned int select)
     resetFlags();
   }
 
-  L.resize(1, 6);
-
   double x_ = get_x();
   double y_ = get_y();
   double Z_ = get_Z();
@@ -266,16 +277,14 @@ vpMatrix vpFeatureDepth::interaction(const unsigned int select)
   }
 
   if (FEATURE_ALL & select) {
-    L = 0;
-    L[0][0] = 0;
-    L[0][1] = 0;
-    L[0][2] = -1 / Z_;
-    L[0][3] = -y_;
-    L[0][4] = x_;
-    L[0][5] = 0;
+    double *Lz = L[row];
+    Lz[0] = 0;
+    Lz[1] = 0;
+    Lz[2] = -1 / Z_;
+    Lz[3] = -y_;
+    Lz[4] = x_;
+    Lz[5] = 0;
   }
-
-  return L;
 }
 
 /*!
@@ -316,18 +325,26 @@ vpMatrix vpFeatureDepth::interaction(const unsigned int select)
 */
 vpColVector vpFeatureDepth::error(const vpBasicFeature &s_star, const unsigned int select)
 {
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
+  return e;
+}
 
-  if (fabs(s_star.get_s().sumSquare()) > 1e-6) {
-    vpERROR_TRACE("s* should be zero ! ");
+/*!
+  Write the error \f$ (s-s^*)\f$ of the selected subset of the feature in
+  the rows of \e e starting at \e offset, without temporary vector. See
+  error() for the selection.
+*/
+void vpFeatureDepth::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                               const unsigned int select)
+{
+  if (fabs(s_star[0]) > 1e-3) {
     throw(vpFeatureException(vpFeatureException::badInitializationError, "s* should be zero !"));
   }
-
-  vpColVector e(1);
+  checkFillDimension(e.getRows(), offset, select);
   if (FEATURE_ALL & select) {
-    e[0] = s[0];
+    e[offset] = s[0];
   }
-
-  return e;
 }
 
 /*!
@@ -0,0 +1,304 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Set of depth visual features.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpFeatureDepthSet.cpp
+  \brief Class that defines a set of depth visual features
+*/
+
+#include <cmath>
+#include <iostream>
+
+#include <visp3/core/vpFeatureDisplay.h>
+#include <visp3/visual_features/vpFeatureDepthSet.h>
+#include <visp3/visual_features/vpFeatureException.h>
+
+namespace
+{
+void checkDepth(double Z)
+{
+  if (Z < 0) {
+    throw(vpFeatureException(vpFeatureException::badInitializationError, "Point is behind the camera"));
+  }
+  if (fabs(Z) < 1e-6) {
+    throw(vpFeatureException(vpFeatureException::badInitializationError, "Point Z coordinates is null"));
+  }
+}
+}
+
+/*!
+  Default constructor that builds an empty set.
+*/
+vpFeatureDepthSet::vpFeatureDepthSet() : m_nbPoints(0), m_x(), m_y(), m_Z() { init(); }
+
+/*!
+  Build a set of \e n points at \f$ x = y = 0 \f$ and \f$ Z = 1 \f$ with a
+  null feature \f$ \log(Z / Z^*) = 0 \f$.
+
+  \param n : Number of points.
+*/
+vpFeatureDepthSet::vpFeatureDepthSet(unsigned int n) : m_nbPoints(n), m_x(), m_y(), m_Z() { init(); }
+
+/*!
+  Reset the features to zero and the points to \f$ x = y = 0 \f$, \f$ Z = 1
+  \f$. The number of points is kept.
+*/
+void vpFeatureDepthSet::init()
+{
+  dim_s = m_nbPoints;
+  nbParameters = 0;
+  s.resize(dim_s);
+  s = 0;
+  m_x.assign(m_nbPoints, 0.);
+  m_y.assign(m_nbPoints, 0.);
+  m_Z.assign(m_nbPoints, 1.);
+}
+
+/*!
+  Resize the set to \e n points and reset the features.
+
+  \param n : Number of points.
+*/
+void vpFeatureDepthSet::init(unsigned int n)
+{
+  m_nbPoints = n;
+  init();
+}
+
+/*!
+  Set the parameters of point \e i.
+
+  \param i : Index of the point.
+  \param x, y : Coordinates of the point in the image plane, in meter.
+  \param Z : Depth of the point in the camera frame.
+  \param LogZoverZstar : Feature \f$ \log(Z / Z^*) \f$.
+*/
+void vpFeatureDepthSet::set_xyZLogZoverZstar(unsigned int i, double x, double y, double Z, double LogZoverZstar)
+{
+  if (i >= m_nbPoints) {
+    throw(vpFeatureException(vpFeatureException::badInitializationError, "Point index %d out of range [0, %d[", i,
+                             m_nbPoints));
+  }
+  checkDepth(Z);
+  m_x[i] = x;
+  m_y[i] = y;
+  m_Z[i] = Z;
+  s[i] = LogZoverZstar;
+}
+
+/*!
+  Build the set from the parameters of the points. The set is resized to the
+  number of points.
+
+  \param x, y : Coordinates of the points in the image plane, in meter.
+  \param Z : Depth of the points in the camera frame.
+  \param LogZoverZstar : Features \f$ \log(Z_i / Z_i^*) \f$.
+
+  \exception vpFeatureException::badInitializationError : If the vectors do
+  not have the same size or if a depth is not strictly positive.
+*/
+void vpFeatureDepthSet::buildFrom(const std::vector<double> &x, const std::vector<double> &y,
+                                  const std::vector<double> &Z, const std::vector<double> &LogZoverZstar)
+{
+  size_t n = x.size();
+  if (y.size() != n || Z.size() != n || LogZoverZstar.size() != n) {
+    throw(vpFeatureException(vpFeatureException::badInitializationError,
+                             "Depth feature vectors do not have the same size"));
+  }
+  for (size_t i = 0; i < n; i++) {
+    checkDepth(Z[i]);
+  }
+  if (n != m_nbPoints) {
+    init((unsigned int)n);
+  }
+  m_x = x;
+  m_y = y;
+  m_Z = Z;
+  for (unsigned int i = 0; i < m_nbPoints; i++) {
+    s[i] = LogZoverZstar[i];
+  }
+}
+
+/*!
+  Return the dimension of the feature vector, that is the number of points
+  unless \e select is null.
+*/
+unsigned int vpFeatureDepthSet::getDimension(const unsigned int select) const
+{
+  return (FEATURE_ALL & select) ? m_nbPoints : 0;
+}
+
+/*!
+  Return the feature vector \f$ (\log(Z_0 / Z_0^*), \ldots, \log(Z_{N-1} /
+  Z_{N-1}^*)) \f$.
+*/
+vpColVector vpFeatureDepthSet::get_s(unsigned int select) const
+{
+  if (FEATURE_ALL & select)
+    return s;
+  return vpColVector();
+}
+
+/*!
+  Write the feature vector in the rows of \e s_vector starting at \e offset.
+*/
+void vpFeatureDepthSet::fill_s(vpColVector &s_vector, const unsigned int offset, const unsigned int select) const
+{
+  checkFillDimension(s_vector.getRows(), offset, select);
+  if (FEATURE_ALL & select)
+    for (unsigned int i = 0; i < m_nbPoints; i++)
+      s_vector[offset + i] = s[i];
+}
+
+/*!
+  Compute and return the \f$ N \times 6 \f$ interaction matrix of the set.
+  The row related to point \e i is the one of vpFeatureDepth:
+
+  \f[ L_i = \left[\begin{array}{cccccc}
+  0 & 0 & -1/Z_i & -y_i & x_i & 0 \end{array}\right] \f]
+*/
+vpMatrix vpFeatureDepthSet::interaction(const unsigned int select)
+{
+  vpMatrix L(getDimension(select), 6);
+  fillInteraction(L, 0, select);
+  return L;
+}
+
+/*!
+  Write the interaction matrix of the selected parameters in the rows of \e L
+  starting at \e offset. See interaction() for the row layout.
+*/
+void vpFeatureDepthSet::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  checkFillDimension(L.getRows(), offset, select);
+  if (getDimension(select) == 0)
+    return;
+
+  for (unsigned int i = 0; i < m_nbPoints; i++) {
+    double *Lk = L[offset + i];
+    Lk[0] = 0.;
+    Lk[1] = 0.;
+    Lk[2] = -1. / m_Z[i];
+    Lk[3] = -m_y[i];
+    Lk[4] = m_x[i];
+    Lk[5] = 0.;
+  }
+}
+
+/*!
+  Compute the error \f$ (s-s^*)\f$ between the current and the desired sets.
+  The desired features are usually null, the error is then equal to the
+  current features.
+
+  \param s_star : Desired visual feature, with the same number of points.
+  \param select : Not used unless null.
+
+  \exception vpException::dimensionError : If the two sets do not have the
+  same number of points.
+*/
+vpColVector vpFeatureDepthSet::error(const vpBasicFeature &s_star, const unsigned int select)
+{
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
+  return e;
+}
+
+/*!
+  Write the error of the selected parameters in the rows of \e e starting at
+  \e offset. See error() for the details.
+*/
+void vpFeatureDepthSet::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                                  const unsigned int select)
+{
+  const vpFeatureDepthSet *set_star = dynamic_cast<const vpFeatureDepthSet *>(&s_star);
+  if (set_star == NULL || set_star->m_nbPoints != m_nbPoints) {
+    throw(vpException(vpException::dimensionError, "Current and desired depth sets do not have the same size"));
+  }
+
+  checkFillDimension(e.getRows(), offset, select);
+  const unsigned int dim = getDimension(select);
+  for (unsigned int i = 0; i < dim; i++)
+    e[offset + i] = s[i] - set_star->s[i];
+}
+
+/*!
+  Print to stdout the parameters of the points.
+*/
+void vpFeatureDepthSet::print(const unsigned int /* select */) const
+{
+  std::cout << "Depth set: " << m_nbPoints << " points" << std::endl;
+  for (unsigned int i = 0; i < m_nbPoints; i++) {
+    std::cout << "  x=" << m_x[i] << " y=" << m_y[i] << " Z=" << m_Z[i] << " log(Z/Z*)=" << s[i] << std::endl;
+  }
+}
+
+/*!
+  Create an object with the same type and the same number of points.
+*/
+vpFeatureDepthSet *vpFeatureDepthSet::duplicate() const
+{
+  vpFeatureDepthSet *feature = new vpFeatureDepthSet(m_nbPoints);
+  return feature;
+}
+
+/*!
+  Display the points.
+
+  \param cam : Camera parameters.
+  \param I : Image.
+  \param color : Color to use for the display.
+  \param thickness : Thickness of the feature representation.
+*/
+void vpFeatureDepthSet::display(const vpCameraParameters &cam, const vpImage<unsigned char> &I, const vpColor &color,
+                                unsigned int thickness) const
+{
+  for (unsigned int i = 0; i < m_nbPoints; i++)
+    vpFeatureDisplay::displayPoint(m_x[i], m_y[i], cam, I, color, thickness);
+}
+
+/*!
+  Display the points.
+
+  \param cam : Camera parameters.
+  \param I : Color image.
+  \param color : Color to use for the display.
+  \param thickness : Thickness of the feature representation.
+*/
+void vpFeatureDepthSet::display(const vpCameraParameters &cam, const vpImage<vpRGBa> &I, const vpColor &color,
+                                unsigned int thickness) const
+{
+  for (unsigned int i = 0; i < m_nbPoints; i++)
+    vpFeatureDisplay::displayPoint(m_x[i], m_y[i], cam, I, color, thickness);
+}
@@ -92,9 +92,20 @@ vpFeatureEllipse::vpFeatureEllipse() : A(0), B(0), C(0) { init(); }
 //! compute the interaction matrix from a subset a the possible features
 vpMatrix vpFeatureEllipse::interaction(const unsigned int select)
 {
-  vpMatrix L;
+  vpMatrix L(getDimension(select), 6);
+  fillInteraction(L, 0, select);
+  return L;
+}
 
-  L.resize(0, 6);
+/*!
+  Write the interaction matrix of the selected subset of the feature in the
+  rows of \e L starting at \e offset, without temporary matrix. See
+  interaction() for the selection.
+*/
+void vpFeatureEllipse::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  checkFillDimension(L.getRows(), offset, select);
+  unsigned int row = offset;
 
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
@@ -150,123 +161,76 @@ vpMatrix vpFeatureEllipse::interaction(const unsigned int select)
   double Z = 1 / (A * xc + B * yc + C);
 
   if (vpFeatureEllipse::selectX() & select) {
-    vpMatrix H(1, 6);
-    H = 0;
-
-    H[0][0] = -1 / Z;
-    H[0][1] = 0;
-    H[0][2] = xc / Z + A * mu20 + B * mu11;
-    H[0][3] = xc * yc + mu11;
-    H[0][4] = -1 - vpMath::sqr(xc) - mu20;
-    H[0][5] = yc;
-
-    L = vpMatrix::stack(L, H);
+    double *H = L[row++];
+    H[0] = -1 / Z;
+    H[1] = 0;
+    H[2] = xc / Z + A * mu20 + B * mu11;
+    H[3] = xc * yc + mu11;
+    H[4] = -1 - vpMath::sqr(xc) - mu20;
+    H[5] = yc;
   }
 
   if (vpFeatureEllipse::selectY() & select) {
-    vpMatrix H(1, 6);
-    H = 0;
-
-    H[0][0] = 0;
-    H[0][1] = -1 / Z;
-    H[0][2] = yc / Z + A * mu11 + B * mu02;
-    H[0][3] = 1 + vpMath::sqr(yc) + mu02;
-    H[0][4] = -xc * yc - mu11;
-    H[0][5] = -xc;
-
-    L = vpMatrix::stack(L, H);
+    double *H = L[row++];
+    H[0] = 0;
+    H[1] = -1 / Z;
+    H[2] = yc / Z + A * mu11 + B * mu02;
+    H[3] = 1 + vpMath::sqr(yc) + mu02;
+    H[4] = -xc * yc - mu11;
+    H[5] = -xc;
   }
 
   if (vpFeatureEllipse::selectMu20() & select) {
-    vpMatrix H(1, 6);
-    H = 0;
-
-    H[0][0] = -2 * (A * mu20 + B * mu11);
-    H[0][1] = 0;
-    H[0][2] = 2 * ((1 / Z + A * xc) * mu20 + B * xc * mu11);
-    H[0][3] = 2 * (yc * mu20 + xc * mu11);
-    H[0][4] = -4 * mu20 * xc;
-    H[0][5] = 2 * mu11;
-
-    L = vpMatrix::stack(L, H);
+    double *H = L[row++];
+    H[0] = -2 * (A * mu20 + B * mu11);
+    H[1] = 0;
+    H[2] = 2 * ((1 / Z + A * xc) * mu20 + B * xc * mu11);
+    H[3] = 2 * (yc * mu20 + xc * mu11);
+    H[4] = -4 * mu20 * xc;
+    H[5] = 2 * mu11;
   }
 
   if (vpFeatureEllipse::selectMu11() & select) {
-    vpMatrix H(1, 6);
-    H = 0;
-
-    H[0][0] = -A * mu11 - B * mu02;
-    H[0][1] = -A * mu20 - B * mu11;
-    H[0][2] = A * yc * mu20 + (3 / Z - C) * mu11 + B * xc * mu02;
-    H[0][3] = 3 * yc * mu11 + xc * mu02;
-    H[0][4] = -yc * mu20 - 3 * xc * mu11;
-    H[0][5] = mu02 - mu20;
-
-    L = vpMatrix::stack(L, H);
+    double *H = L[row++];
+    H[0] = -A * mu11 - B * mu02;
+    H[1] = -A * mu20 - B * mu11;
+    H[2] = A * yc * mu20 + (3 / Z - C) * mu11 + B * xc * mu02;
+    H[3] = 3 * yc * mu11 + xc * mu02;
+    H[4] = -yc * mu20 - 3 * xc * mu11;
+    H[5] = mu02 - mu20;
   }
 
   if (vpFeatureEllipse::selectMu02() & select) {
-    vpMatrix H(1, 6);
-    H = 0;
-
-    H[0][0] = 0;
-    H[0][1] = -2 * (A * mu11 + B * mu02);
-    H[0][2] = 2 * ((1 / Z + B * yc) * mu02 + A * yc * mu11);
-    H[0][3] = 4 * yc * mu02;
-    H[0][4] = -2 * (yc * mu11 + xc * mu02);
-    H[0][5] = -2 * mu11;
-    L = vpMatrix::stack(L, H);
+    double *H = L[row++];
+    H[0] = 0;
+    H[1] = -2 * (A * mu11 + B * mu02);
+    H[2] = 2 * ((1 / Z + B * yc) * mu02 + A * yc * mu11);
+    H[3] = 4 * yc * mu02;
+    H[4] = -2 * (yc * mu11 + xc * mu02);
+    H[5] = -2 * mu11;
   }
-
-  return L;
 }
 
 //! compute the error between two visual features from a subset
 //! a the possible features
 vpColVector vpFeatureEllipse::error(const vpBasicFeature &s_star, const unsigned int select)
 {
-  vpColVector e(0);
-
-  try {
-    if (vpFeatureEllipse::selectX() & select) {
-      vpColVector ex(1);
-      ex[0] = s[0] - s_star[0];
-
-      e = vpColVector::stack(e, ex);
-    }
-
-    if (vpFeatureEllipse::selectY() & select) {
-      vpColVector ey(1);
-      ey[0] = s[1] - s_star[1];
-      e = vpColVector::stack(e, ey);
-    }
-
-    if (vpFeatureEllipse::selectMu20() & select) {
-      vpColVector ex(1);
-      ex[0] = s[2] - s_star[2];
-
-      e = vpColVector::stack(e, ex);
-    }
-
-    if (vpFeatureEllipse::selectMu11() & select) {
-      vpColVector ey(1);
-      ey[0] = s[3] - s_star[3];
-      e = vpColVector::stack(e, ey);
-    }
-
-    if (vpFeatureEllipse::selectMu02() & select) {
-      vpColVector ey(1);
-      ey[0] = s[4] - s_star[4];
-      e = vpColVector::stack(e, ey);
-    }
-
-  } catch (...) {
-    throw;
-  }
-
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
   return e;
 }
 
+/*!
+  Write the error \f$ (s-s^*)\f$ of the selected subset of the feature in
+  the rows of \e e starting at \e offset, without temporary vector. See
+  error() for the selection.
+*/
+void vpFeatureEllipse::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                                 const unsigned int select)
+{
+  fillSelectedError(s_star, e, offset, select);
+}
+
 void vpFeatureEllipse::print(const unsigned int select) const
 {
 
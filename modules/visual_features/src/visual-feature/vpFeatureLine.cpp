@@ -197,7 +197,20 @@ void vpFeatureLine::setABCD(const double A_, const double B_, const double C_, c
 */
 vpMatrix vpFeatureLine::interaction(const unsigned int select)
 {
-  vpMatrix L;
+  vpMatrix L(getDimension(select), 6);
+  fillInteraction(L, 0, select);
+  return L;
+}
+
+/*!
+  Write the interaction matrix of the selected subset of the feature in the
+  rows of \e L starting at \e offset, without temporary matrix. See
+  interaction() for the selection.
+*/
+void vpFeatureLine::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  checkFillDimension(L.getRows(), offset, select);
+  unsigned int row = offset;
 
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
@@ -250,31 +263,25 @@ vpMatrix vpFeatureLine::interaction(const unsigned int select)
   double lambda_rho = (C + rho * A * co + rho * B * si) / D;
 
   if (vpFeatureLine::selectRho() & select) {
-    vpMatrix Lrho(1, 6);
-
-    Lrho[0][0] = co * lambda_rho;
-    Lrho[0][1] = si * lambda_rho;
-    Lrho[0][2] = -rho * lambda_rho;
-    Lrho[0][3] = si * (1.0 + rho * rho);
-    Lrho[0][4] = -co * (1.0 + rho * rho);
-    Lrho[0][5] = 0.0;
-
-    L.stack(Lrho);
+    double *Lrho = L[row++];
+    Lrho[0] = co * lambda_rho;
+    Lrho[1] = si * lambda_rho;
+    Lrho[2] = -rho * lambda_rho;
+    Lrho[3] = si * (1.0 + rho * rho);
+    Lrho[4] = -co * (1.0 + rho * rho);
+    Lrho[5] = 0.0;
   }
 
   if (vpFeatureLine::selectTheta() & select) {
-    vpMatrix Ltheta(1, 6);
+    double *Ltheta = L[row++];
+    Ltheta[0] = co * lambda_theta;
+    Ltheta[1] = si * lambda_theta;
+    Ltheta[2] = -rho * lambda_theta;
+    Ltheta[3] = -rho * co;
+    Ltheta[4] = -rho * si;
+    Ltheta[5] = -1.0;
 
-    Ltheta[0][0] = co * lambda_theta;
-    Ltheta[0][1] = si * lambda_theta;
-    Ltheta[0][2] = -rho * lambda_theta;
-    Ltheta[0][3] = -rho * co;
-    Ltheta[0][4] = -rho * si;
-    Ltheta[0][5] = -1.0;
-
-    L.stack(Ltheta);
   }
-  return L;
 }
 
 /*!
@@ -317,33 +324,32 @@ vpMatrix vpFeatureLine::interaction(const unsigned int select)
 */
 vpColVector vpFeatureLine::error(const vpBasicFeature &s_star, const unsigned int select)
 {
-  vpColVector e(0);
-
-  try {
-    if (vpFeatureLine::selectRho() & select) {
-      vpColVector erho(1);
-      erho[0] = s[0] - s_star[0];
-
-      e = vpColVector::stack(e, erho);
-    }
-
-    if (vpFeatureLine::selectTheta() & select) {
-
-      double err = s[1] - s_star[1];
-      while (err < -M_PI)
-        err += 2 * M_PI;
-      while (err > M_PI)
-        err -= 2 * M_PI;
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
+  return e;
+}
 
-      vpColVector etheta(1);
-      etheta[0] = err;
-      e = vpColVector::stack(e, etheta);
-    }
-  } catch (...) {
-    throw;
+/*!
+  Write the error \f$ (s-s^*)\f$ of the selected subset of the feature in
+  the rows of \e e starting at \e offset, without temporary vector. See
+  error() for the selection.
+*/
+void vpFeatureLine::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                              const unsigned int select)
+{
+  checkFillDimension(e.getRows(), offset, select);
+  unsigned int row = offset;
+  if (vpFeatureLine::selectRho() & select) {
+    e[row++] = s[0] - s_star[0];
+  }
+  if (vpFeatureLine::selectTheta() & select) {
+    double err = s[1] - s_star[1];
+    while (err < -M_PI)
+      err += 2 * M_PI;
+    while (err > M_PI)
+      err -= 2 * M_PI;
+    e[row++] = err;
   }
-
-  return e;
 }
 
 /*!
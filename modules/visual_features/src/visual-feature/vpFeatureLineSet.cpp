@@ -0,0 +1,391 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Set of 2D line visual features.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpFeatureLineSet.cpp
+  \brief Class that defines a set of 2D line visual features
+*/
+
+#include <cmath>
+#include <iostream>
+
+#include <visp3/core/vpFeatureDisplay.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/visual_features/vpFeatureException.h>
+#include <visp3/visual_features/vpFeatureLineSet.h>
+
+/*!
+  Default constructor that builds an empty set of lines.
+*/
+vpFeatureLineSet::vpFeatureLineSet() : m_nbLines(0), m_A(), m_B(), m_C(), m_D() { init(); }
+
+/*!
+  Build a set of \e n lines with \f$ \rho = \theta = 0 \f$ contained in the
+  plane \f$ Z = 1 \f$.
+
+  \param n : Number of lines.
+*/
+vpFeatureLineSet::vpFeatureLineSet(unsigned int n) : m_nbLines(n), m_A(), m_B(), m_C(), m_D() { init(); }
+
+/*!
+  Reset the parameters of the lines to \f$ \rho = \theta = 0 \f$ and their
+  plane to \f$ Z = 1 \f$. The number of lines is kept.
+*/
+void vpFeatureLineSet::init()
+{
+  dim_s = 2 * m_nbLines;
+  nbParameters = 0;
+  s.resize(dim_s);
+  s = 0;
+  m_A.assign(m_nbLines, 0.);
+  m_B.assign(m_nbLines, 0.);
+  m_C.assign(m_nbLines, 1.);
+  m_D.assign(m_nbLines, -1.);
+}
+
+/*!
+  Resize the set to \e n lines and reset their parameters.
+
+  \param n : Number of lines.
+*/
+void vpFeatureLineSet::init(unsigned int n)
+{
+  m_nbLines = n;
+  init();
+}
+
+/*!
+  Set the \f$ \rho \f$ and \f$ \theta \f$ parameters of the line \e i.
+
+  \param i : Index of the line.
+  \param rho, theta : Parameters of the line equation \f$ x \cos(\theta) + y
+  \sin(\theta) - \rho = 0 \f$.
+*/
+void vpFeatureLineSet::setRhoTheta(unsigned int i, double rho, double theta)
+{
+  if (i >= m_nbLines) {
+    throw(vpFeatureException(vpFeatureException::badInitializationError, "Line index %d out of range [0, %d[", i,
+                             m_nbLines));
+  }
+  s[i] = rho;
+  s[m_nbLines + i] = theta;
+}
+
+/*!
+  Set the equation \f$ A X + B Y + C Z + D = 0 \f$ of a plane containing the
+  line \e i.
+
+  \param i : Index of the line.
+  \param A, B, C, D : Parameters of the plane equation. \e D must not be null.
+*/
+void vpFeatureLineSet::setABCD(unsigned int i, double A, double B, double C, double D)
+{
+  if (i >= m_nbLines) {
+    throw(vpFeatureException(vpFeatureException::badInitializationError, "Line index %d out of range [0, %d[", i,
+                             m_nbLines));
+  }
+  if (fabs(D) < 1e-6) {
+    throw(vpFeatureException(vpFeatureException::badInitializationError, "Incorrect plane coordinates D is null"));
+  }
+  m_A[i] = A;
+  m_B[i] = B;
+  m_C[i] = C;
+  m_D[i] = D;
+}
+
+/*!
+  Build the set from the parameters of the lines. The set is resized to the
+  number of lines.
+
+  \param rho, theta : Parameters of the lines in the image plane.
+  \param A, B, C, D : Equations of planes containing the lines.
+
+  \exception vpFeatureException::badInitializationError : If the vectors do
+  not have the same size or if a \e D parameter is null.
+*/
+void vpFeatureLineSet::buildFrom(const std::vector<double> &rho, const std::vector<double> &theta,
+                                 const std::vector<double> &A, const std::vector<double> &B,
+                                 const std::vector<double> &C, const std::vector<double> &D)
+{
+  size_t n = rho.size();
+  if (theta.size() != n || A.size() != n || B.size() != n || C.size() != n || D.size() != n) {
+    throw(vpFeatureException(vpFeatureException::badInitializationError,
+                             "Line parameters vectors do not have the same size"));
+  }
+  for (size_t i = 0; i < n; i++) {
+    if (fabs(D[i]) < 1e-6) {
+      throw(vpFeatureException(vpFeatureException::badInitializationError, "Incorrect plane coordinates D is null"));
+    }
+  }
+  if (n != m_nbLines) {
+    init((unsigned int)n);
+  }
+  for (unsigned int i = 0; i < m_nbLines; i++) {
+    s[i] = rho[i];
+    s[m_nbLines + i] = theta[i];
+  }
+  m_A = A;
+  m_B = B;
+  m_C = C;
+  m_D = D;
+}
+
+/*!
+  Return the dimension of the feature vector.
+
+  \param select : selectRho(), selectTheta() or both. Each selected parameter
+  contributes \f$ N \f$ rows.
+*/
+unsigned int vpFeatureLineSet::getDimension(const unsigned int select) const
+{
+  unsigned int dim = 0;
+  if (selectRho() & select)
+    dim += m_nbLines;
+  if (selectTheta() & select)
+    dim += m_nbLines;
+  return dim;
+}
+
+/*!
+  Return the feature vector, that is the \f$ \rho \f$ parameters of the lines
+  followed by their \f$ \theta \f$ parameters if both are selected.
+
+  \param select : selectRho(), selectTheta() or both.
+*/
+vpColVector vpFeatureLineSet::get_s(unsigned int select) const
+{
+  vpColVector state(getDimension(select));
+  fill_s(state, 0, select);
+  return state;
+}
+
+/*!
+  Write the selected parameters in the rows of \e s_vector starting at \e
+  offset, in the same order as get_s().
+*/
+void vpFeatureLineSet::fill_s(vpColVector &s_vector, const unsigned int offset, const unsigned int select) const
+{
+  checkFillDimension(s_vector.getRows(), offset, select);
+  unsigned int k = offset;
+  if (selectRho() & select)
+    for (unsigned int i = 0; i < m_nbLines; i++)
+      s_vector[k++] = s[i];
+  if (selectTheta() & select)
+    for (unsigned int i = 0; i < m_nbLines; i++)
+      s_vector[k++] = s[m_nbLines + i];
+}
+
+/*!
+  Compute and return the interaction matrix of the selected parameters of
+  the lines. The rows related to line \e i are the ones of vpFeatureLine:
+
+  \f[ L_{\rho_i} = \left[\begin{array}{cccccc}
+  \lambda_{\rho}c & \lambda_{\rho}s & -\lambda_{\rho}\rho
+  & (1+\rho^2)s & -(1+\rho^2)c & 0 \end{array}\right] \f]
+  \f[ L_{\theta_i} = \left[\begin{array}{cccccc}
+  \lambda_{\theta}c & \lambda_{\theta}s & -\lambda_{\theta}\rho & -\rho c &
+  -\rho s & -1 \end{array}\right] \f]
+
+  with \f$ c = \cos(\theta_i) \f$, \f$ s = \sin(\theta_i) \f$, \f$
+  \lambda_{\rho} = (A_i \rho_i c + B_i \rho_i s + C_i) / D_i \f$ and \f$
+  \lambda_{\theta} = (A_i s - B_i c) / D_i \f$.
+
+  The \f$ L_{\rho_i} \f$ rows come first, followed by the \f$ L_{\theta_i}
+  \f$ rows.
+
+  \param select : selectRho(), selectTheta() or both.
+  \return The \f$ N \times 6 \f$ or \f$ 2N \times 6 \f$ interaction matrix.
+*/
+vpMatrix vpFeatureLineSet::interaction(const unsigned int select)
+{
+  vpMatrix L(getDimension(select), 6);
+  fillInteraction(L, 0, select);
+  return L;
+}
+
+/*!
+  Write the interaction matrix of the selected parameters in the rows of \e L
+  starting at \e offset. See interaction() for the row layout.
+*/
+void vpFeatureLineSet::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  checkFillDimension(L.getRows(), offset, select);
+  const double *rho = s.data;
+  const double *theta = s.data + m_nbLines;
+  unsigned int krho = offset;
+  unsigned int ktheta = (selectRho() & select) ? offset + m_nbLines : offset;
+
+  for (unsigned int i = 0; i < m_nbLines; i++) {
+    double co = cos(theta[i]);
+    double si = sin(theta[i]);
+    double r = rho[i];
+    double invD = 1. / m_D[i];
+
+    if (selectRho() & select) {
+      double lambda_rho = (m_C[i] + r * m_A[i] * co + r * m_B[i] * si) * invD;
+      double *Lk = L[krho++];
+      Lk[0] = co * lambda_rho;
+      Lk[1] = si * lambda_rho;
+      Lk[2] = -r * lambda_rho;
+      Lk[3] = si * (1. + r * r);
+      Lk[4] = -co * (1. + r * r);
+      Lk[5] = 0.;
+    }
+    if (selectTheta() & select) {
+      double lambda_theta = (m_A[i] * si - m_B[i] * co) * invD;
+      double *Lk = L[ktheta++];
+      Lk[0] = co * lambda_theta;
+      Lk[1] = si * lambda_theta;
+      Lk[2] = -r * lambda_theta;
+      Lk[3] = -r * co;
+      Lk[4] = -r * si;
+      Lk[5] = -1.;
+    }
+  }
+}
+
+/*!
+  Compute the error \f$ (s-s^*)\f$ between the current and the desired sets
+  of lines. As in vpFeatureLine, the \f$ \theta \f$ errors are wrapped in \f$
+  [-\pi, \pi] \f$.
+
+  \param s_star : Desired visual feature, with the same number of lines.
+  \param select : selectRho(), selectTheta() or both.
+
+  \exception vpException::dimensionError : If the two sets do not have the
+  same number of lines.
+*/
+vpColVector vpFeatureLineSet::error(const vpBasicFeature &s_star, const unsigned int select)
+{
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
+  return e;
+}
+
+/*!
+  Write the error of the selected parameters in the rows of \e e starting at
+  \e offset. See error() for the details.
+*/
+void vpFeatureLineSet::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                                 const unsigned int select)
+{
+  const vpFeatureLineSet *set_star = dynamic_cast<const vpFeatureLineSet *>(&s_star);
+  if (set_star == NULL || set_star->m_nbLines != m_nbLines) {
+    throw(vpException(vpException::dimensionError, "Current and desired line sets do not have the same size"));
+  }
+
+  checkFillDimension(e.getRows(), offset, select);
+  unsigned int k = offset;
+  if (selectRho() & select)
+    for (unsigned int i = 0; i < m_nbLines; i++)
+      e[k++] = s[i] - set_star->s[i];
+  if (selectTheta() & select) {
+    for (unsigned int i = m_nbLines; i < dim_s; i++) {
+      double err = s[i] - set_star->s[i];
+      while (err < -M_PI)
+        err += 2 * M_PI;
+      while (err > M_PI)
+        err -= 2 * M_PI;
+      e[k++] = err;
+    }
+  }
+}
+
+/*!
+  Print to stdout the parameters of the lines.
+
+  \param select : selectRho(), selectTheta() or both.
+*/
+void vpFeatureLineSet::print(const unsigned int select) const
+{
+  std::cout << "Line set: " << m_nbLines << " lines" << std::endl;
+  for (unsigned int i = 0; i < m_nbLines; i++) {
+    std::cout << "  " << m_A[i] << "X+" << m_B[i] << "Y+" << m_C[i] << "Z+" << m_D[i] << "=0";
+    if (selectRho() & select)
+      std::cout << " rho=" << getRho(i);
+    if (selectTheta() & select)
+      std::cout << " theta=" << getTheta(i);
+    std::cout << std::endl;
+  }
+}
+
+/*!
+  Create an object with the same type and the same number of lines.
+*/
+vpFeatureLineSet *vpFeatureLineSet::duplicate() const
+{
+  vpFeatureLineSet *feature = new vpFeatureLineSet(m_nbLines);
+  return feature;
+}
+
+/*!
+  Display the lines.
+
+  \param cam : Camera parameters.
+  \param I : Image.
+  \param color : Color to use for the display.
+  \param thickness : Thickness of the feature representation.
+*/
+void vpFeatureLineSet::display(const vpCameraParameters &cam, const vpImage<unsigned char> &I, const vpColor &color,
+                               unsigned int thickness) const
+{
+  for (unsigned int i = 0; i < m_nbLines; i++)
+    vpFeatureDisplay::displayLine(getRho(i), getTheta(i), cam, I, color, thickness);
+}
+
+/*!
+  Display the lines.
+
+  \param cam : Camera parameters.
+  \param I : Color image.
+  \param color : Color to use for the display.
+  \param thickness : Thickness of the feature representation.
+*/
+void vpFeatureLineSet::display(const vpCameraParameters &cam, const vpImage<vpRGBa> &I, const vpColor &color,
+                               unsigned int thickness) const
+{
+  for (unsigned int i = 0; i < m_nbLines; i++)
+    vpFeatureDisplay::displayLine(getRho(i), getTheta(i), cam, I, color, thickness);
+}
+
+/*!
+  Function used to select the \f$ \rho \f$ parameters of all the lines.
+*/
+unsigned int vpFeatureLineSet::selectRho() { return FEATURE_LINE[0]; }
+
+/*!
+  Function used to select the \f$ \theta \f$ parameters of all the lines.
+*/
+unsigned int vpFeatureLineSet::selectTheta() { return FEATURE_LINE[1]; }
@@ -36,6 +36,7 @@
  *
  *****************************************************************************/
 
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpHomogeneousMatrix.h>
@@ -46,6 +47,11 @@
 
 #include <visp3/visual_features/vpFeatureLuminance.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
 /*!
   \file vpFeatureLuminance.cpp
   \brief Class that defines the image luminance visual feature
@@ -53,6 +59,58 @@
   For more details see \cite Collewet08c.
 */
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/*
+  Apply the derivative filter used in vpImageFilter::derivativeFilterX() and
+  vpImageFilter::derivativeFilterY() on n consecutive pixels:
+  d[j] = scale * (2047 (p1[j]-m1[j]) + 913 (p2[j]-m2[j]) + 112 (p3[j]-m3[j]))
+  where p<k> and m<k> point to the pixels at a distance k after and before.
+*/
+void derivativeFilter(const unsigned char *p1, const unsigned char *m1, const unsigned char *p2,
+                      const unsigned char *m2, const unsigned char *p3, const unsigned char *m3, unsigned int n,
+                      double scale, double *d, bool useSSE2)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  if (useSSE2 && n >= 8) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i c12 = _mm_set_epi16(913, 2047, 913, 2047, 913, 2047, 913, 2047);
+    const __m128i c3 = _mm_set_epi16(0, 112, 0, 112, 0, 112, 0, 112);
+    const __m128d s = _mm_set1_pd(scale);
+
+    for (; j <= n - 8; j += 8) {
+      __m128i d1 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(p1 + j)), zero),
+                                 _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(m1 + j)), zero));
+      __m128i d2 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(p2 + j)), zero),
+                                 _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(m2 + j)), zero));
+      __m128i d3 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(p3 + j)), zero),
+                                 _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(m3 + j)), zero));
+
+      __m128i lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(d1, d2), c12),
+                                 _mm_madd_epi16(_mm_unpacklo_epi16(d3, zero), c3));
+      __m128i hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(d1, d2), c12),
+                                 _mm_madd_epi16(_mm_unpackhi_epi16(d3, zero), c3));
+
+      _mm_storeu_pd(d + j, _mm_mul_pd(_mm_cvtepi32_pd(lo), s));
+      _mm_storeu_pd(d + j + 2, _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(lo, 8)), s));
+      _mm_storeu_pd(d + j + 4, _mm_mul_pd(_mm_cvtepi32_pd(hi), s));
+      _mm_storeu_pd(d + j + 6, _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(hi, 8)), s));
+    }
+  }
+#else
+  (void)useSSE2;
+#endif
+
+  for (; j < n; j++) {
+    d[j] = scale * (2047 * ((int)p1[j] - (int)m1[j]) + 913 * ((int)p2[j] - (int)m2[j]) +
+                    112 * ((int)p3[j] - (int)m3[j]));
+  }
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
   Initialize the memory space requested for vpFeatureLuminance visual feature.
 */
@@ -83,14 +141,16 @@ void vpFeatureLuminance::init(unsigned int _nbr, unsigned int _nbc, double _Z)
   }
 
   // number of feature = nb column x nb lines in the images
+  // this value is updated when the pixels are selected in buildFrom()
   dim_s = (nbr - 2 * bord) * (nbc - 2 * bord);
 
   s.resize(dim_s);
 
-  if (pixInfo != NULL)
-    delete[] pixInfo;
-
-  pixInfo = new vpLuminance[dim_s];
+  m_index.clear();
+  m_x.clear();
+  m_y.clear();
+  m_Ix.clear();
+  m_Iy.clear();
 
   Z = _Z;
 }
@@ -98,7 +158,9 @@ void vpFeatureLuminance::init(unsigned int _nbr, unsigned int _nbc, double _Z)
 /*!
   Default constructor that build a visual feature.
 */
-vpFeatureLuminance::vpFeatureLuminance() : Z(1), nbr(0), nbc(0), bord(10), pixInfo(NULL), firstTimeIn(0), cam()
+vpFeatureLuminance::vpFeatureLuminance()
+  : Z(1), nbr(0), nbc(0), bord(10), pixInfo(NULL), firstTimeIn(0), m_index(), m_x(), m_y(), m_Ix(), m_Iy(),
+    m_width(0), m_height(0), m_dense(true), m_step(1), m_gradThreshold(0.), m_pyramidLevel(0), cam()
 {
   nbParameters = 1;
   dim_s = 0;
@@ -111,7 +173,8 @@ vpFeatureLuminance::vpFeatureLuminance() : Z(1), nbr(0), nbc(0), bord(10), pixIn
  Copy constructor.
  */
 vpFeatureLuminance::vpFeatureLuminance(const vpFeatureLuminance &f)
-  : vpBasicFeature(f), Z(1), nbr(0), nbc(0), bord(10), pixInfo(NULL), firstTimeIn(0), cam()
+  : vpBasicFeature(f), Z(1), nbr(0), nbc(0), bord(10), pixInfo(NULL), firstTimeIn(0), m_index(), m_x(), m_y(),
+    m_Ix(), m_Iy(), m_width(0), m_height(0), m_dense(true), m_step(1), m_gradThreshold(0.), m_pyramidLevel(0), cam()
 {
   *this = f;
 }
@@ -127,11 +190,17 @@ vpFeatureLuminance &vpFeatureLuminance::operator=(const vpFeatureLuminance &f)
   bord = f.bord;
   firstTimeIn = f.firstTimeIn;
   cam = f.cam;
-  if (pixInfo)
-    delete[] pixInfo;
-  pixInfo = new vpLuminance[dim_s];
-  for (unsigned int i = 0; i < dim_s; i++)
-    pixInfo[i] = f.pixInfo[i];
+  m_index = f.m_index;
+  m_x = f.m_x;
+  m_y = f.m_y;
+  m_Ix = f.m_Ix;
+  m_Iy = f.m_Iy;
+  m_width = f.m_width;
+  m_height = f.m_height;
+  m_dense = f.m_dense;
+  m_step = f.m_step;
+  m_gradThreshold = f.m_gradThreshold;
+  m_pyramidLevel = f.m_pyramidLevel;
   return (*this);
 }
 
@@ -167,55 +236,243 @@ double vpFeatureLuminance::get_Z() const { return Z; }
 void vpFeatureLuminance::setCameraParameters(vpCameraParameters &_cam) { cam = _cam; }
 
 /*!
+  Keep only one pixel out of \e step along the rows and the columns of the
+  image. The selection is done at the next call of buildFrom().
 
-  Build a luminance feature directly from the image
+  \param step : Subsampling step. Default value 1 means that all the pixels
+  are considered.
+
+  \sa setPixelSelection()
 */
+void vpFeatureLuminance::setSubsampling(unsigned int step)
+{
+  if (step == 0) {
+    throw vpException(vpException::badValue, "Subsampling step should be greater than 0");
+  }
+  m_step = step;
+  firstTimeIn = 0;
+}
 
-void vpFeatureLuminance::buildFrom(vpImage<unsigned char> &I)
+/*!
+  Keep only the pixels with an informative gradient. The selection is done
+  at the next call of buildFrom().
+
+  \param threshold : Minimal gradient magnitude in grey level per pixel of
+  the selected pixels. A null value means that the gradient is not used to
+  select the pixels.
+
+  \sa setPixelSelection()
+*/
+void vpFeatureLuminance::setGradientThreshold(double threshold)
+{
+  m_gradThreshold = threshold;
+  firstTimeIn = 0;
+}
+
+/*!
+  Build the feature from the image at a given level of the Gaussian pyramid.
+  At level \e l the image is \f$2^l\f$ times smaller than the one given to
+  buildFrom(). Each level is obtained using vpImageFilter::getGaussPyramidal()
+  and the camera parameters are scaled accordingly.
+
+  Starting the servo at a coarse level and moving to level 0 when the error
+  decreases allows to enlarge the convergence domain while reducing the
+  cost of the first iterations. Since the pixels are selected again at the
+  next call of buildFrom(), the level of the current and desired features
+  should be changed together, and the desired feature built again.
+
+  \param level : Pyramid level. 0 means the full resolution image.
+*/
+void vpFeatureLuminance::setPyramidLevel(unsigned int level)
 {
-  unsigned int l = 0;
-  double Ix, Iy;
+  m_pyramidLevel = level;
+  firstTimeIn = 0;
+}
 
-  double px = cam.get_px();
-  double py = cam.get_py();
+/*!
+  Use the same pixels than an other feature. This allows to share between
+  the current and desired features the pixels selected using
+  setSubsampling(), setGradientThreshold() or setPyramidLevel().
 
-  if (firstTimeIn == 0) {
-    firstTimeIn = 1;
-    l = 0;
-    for (unsigned int i = bord; i < nbr - bord; i++) {
-      //   cout << i << endl ;
-      for (unsigned int j = bord; j < nbc - bord; j++) {
-        double x = 0, y = 0;
-        vpPixelMeterConversion::convertPoint(cam, j, i, x, y);
+  \param f : Feature that was already built using buildFrom().
+*/
+void vpFeatureLuminance::setPixelSelection(const vpFeatureLuminance &f)
+{
+  if (f.firstTimeIn == 0) {
+    throw vpException(vpException::notInitialized, "Feature used for the pixel selection is not built");
+  }
 
-        pixInfo[l].x = x;
-        pixInfo[l].y = y;
+  bord = f.bord;
+  m_step = f.m_step;
+  m_gradThreshold = f.m_gradThreshold;
+  m_pyramidLevel = f.m_pyramidLevel;
+  m_index = f.m_index;
+  m_x = f.m_x;
+  m_y = f.m_y;
+  m_width = f.m_width;
+  m_height = f.m_height;
+  m_dense = f.m_dense;
+
+  dim_s = (unsigned int)m_index.size();
+  s.resize(dim_s);
+  m_Ix.resize(dim_s);
+  m_Iy.resize(dim_s);
 
-        pixInfo[l].Z = Z;
+  firstTimeIn = 1;
+}
 
-        l++;
+/*!
+  Return the camera parameters corresponding to the pyramid level.
+*/
+vpCameraParameters vpFeatureLuminance::getLevelCameraParameters() const
+{
+  if (m_pyramidLevel == 0) {
+    return cam;
+  }
+
+  double scale = 1. / (double)(1 << m_pyramidLevel);
+  vpCameraParameters cam_level;
+  if (cam.get_projModel() == vpCameraParameters::perspectiveProjWithDistortion) {
+    cam_level.initPersProjWithDistortion(cam.get_px() * scale, cam.get_py() * scale, cam.get_u0() * scale,
+                                         cam.get_v0() * scale, cam.get_kud(), cam.get_kdu());
+  } else {
+    cam_level.initPersProjWithoutDistortion(cam.get_px() * scale, cam.get_py() * scale, cam.get_u0() * scale,
+                                            cam.get_v0() * scale);
+  }
+  return cam_level;
+}
+
+/*!
+  Select the pixels used to build the feature and compute their coordinates
+  in meter.
+
+  \param I : Image at the pyramid level.
+  \param rows, cols : Number of rows and columns of the image to consider.
+*/
+void vpFeatureLuminance::selectPixels(const vpImage<unsigned char> &I, unsigned int rows, unsigned int cols)
+{
+  if ((rows < 2 * bord + 1) || (cols < 2 * bord + 1)) {
+    throw vpException(vpException::dimensionError, "border is too important compared to number of row or column.");
+  }
+
+  vpCameraParameters cam_level = getLevelCameraParameters();
+  double threshold2 = m_gradThreshold * m_gradThreshold;
+
+  m_index.clear();
+  m_x.clear();
+  m_y.clear();
+  m_width = cols;
+  m_height = rows;
+
+  for (unsigned int i = bord; i < rows - bord; i += m_step) {
+    for (unsigned int j = bord; j < cols - bord; j += m_step) {
+      if (m_gradThreshold > 0.) {
+        double gx = vpImageFilter::derivativeFilterX(I, i, j);
+        double gy = vpImageFilter::derivativeFilterY(I, i, j);
+        if (gx * gx + gy * gy < threshold2) {
+          continue;
+        }
       }
+      double x = 0, y = 0;
+      vpPixelMeterConversion::convertPoint(cam_level, j, i, x, y);
+
+      m_index.push_back(i * cols + j);
+      m_x.push_back(x);
+      m_y.push_back(y);
     }
   }
 
-  l = 0;
-  for (unsigned int i = bord; i < nbr - bord; i++) {
-    //   cout << i << endl ;
-    for (unsigned int j = bord; j < nbc - bord; j++) {
-      // cout << dim_s <<" " <<l <<"  " <<i << "  " << j <<endl ;
-      Ix = px * vpImageFilter::derivativeFilterX(I, i, j);
-      Iy = py * vpImageFilter::derivativeFilterY(I, i, j);
+  m_dense = (m_step == 1 && m_gradThreshold <= 0.);
 
-      // Calcul de Z
+  dim_s = (unsigned int)m_index.size();
+  s.resize(dim_s);
+  m_Ix.resize(dim_s);
+  m_Iy.resize(dim_s);
+}
 
-      pixInfo[l].I = I[i][j];
+/*!
+  Update the intensity and the gradient of the selected pixels.
+
+  When all the pixels are selected, the gradient is computed row by row
+  using SSE2 instructions if available, and the rows are shared between the
+  threads when OpenMP is enabled. Otherwise the gradient is only computed at
+  the selected pixels.
+*/
+void vpFeatureLuminance::computeGradients(const vpImage<unsigned char> &I)
+{
+  vpCameraParameters cam_level = getLevelCameraParameters();
+  double scale_x = cam_level.get_px() / 8418.0;
+  double scale_y = cam_level.get_py() / 8418.0;
+
+  if (m_dense) {
+    bool checkSSE2 = vpCPUFeatures::checkSSE2();
+    unsigned int w = m_width - 2 * bord;
+    int nrows = (int)(dim_s / w);
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int r = 0; r < nrows; r++) {
+      unsigned int i = (unsigned int)r + bord;
+      unsigned int l = (unsigned int)r * w;
+      const unsigned char *row = I[i] + bord;
+
+      derivativeFilter(row + 1, row - 1, row + 2, row - 2, row + 3, row - 3, w, scale_x, &m_Ix[l], checkSSE2);
+      derivativeFilter(I[i + 1] + bord, I[i - 1] + bord, I[i + 2] + bord, I[i - 2] + bord, I[i + 3] + bord,
+                       I[i - 3] + bord, w, scale_y, &m_Iy[l], checkSSE2);
+      for (unsigned int j = 0; j < w; j++) {
+        s[l + j] = row[j];
+      }
+    }
+  } else {
+    for (unsigned int l = 0; l < dim_s; l++) {
+      unsigned int i = m_index[l] / m_width;
+      unsigned int j = m_index[l] % m_width;
+
+      m_Ix[l] = scale_x * (2047 * ((int)I[i][j + 1] - (int)I[i][j - 1]) + 913 * ((int)I[i][j + 2] - (int)I[i][j - 2]) +
+                           112 * ((int)I[i][j + 3] - (int)I[i][j - 3]));
+      m_Iy[l] = scale_y * (2047 * ((int)I[i + 1][j] - (int)I[i - 1][j]) + 913 * ((int)I[i + 2][j] - (int)I[i - 2][j]) +
+                           112 * ((int)I[i + 3][j] - (int)I[i - 3][j]));
       s[l] = I[i][j];
-      pixInfo[l].Ix = Ix;
-      pixInfo[l].Iy = Iy;
+    }
+  }
+}
 
-      l++;
+/*!
+
+  Build a luminance feature directly from the image.
+
+  The first time this function is called, the pixels used as feature are
+  selected (see setSubsampling(), setGradientThreshold() and
+  setPyramidLevel()) unless they were given by setPixelSelection().
+*/
+void vpFeatureLuminance::buildFrom(vpImage<unsigned char> &I)
+{
+  const vpImage<unsigned char> *I_level = &I;
+  unsigned int rows = nbr;
+  unsigned int cols = nbc;
+
+  if (m_pyramidLevel > 0) {
+    for (unsigned int l = 0; l < m_pyramidLevel; l++) {
+      vpImageFilter::getGaussPyramidal(*I_level, m_Ipyr[l % 2]);
+      I_level = &m_Ipyr[l % 2];
     }
+    rows = I_level->getHeight();
+    cols = I_level->getWidth();
+  }
+
+  if (I_level->getHeight() < rows || I_level->getWidth() < cols) {
+    throw vpException(vpException::dimensionError, "Image is smaller than the luminance feature");
   }
+
+  if (firstTimeIn == 0) {
+    selectPixels(*I_level, rows, cols);
+    firstTimeIn = 1;
+  } else if (rows != m_height || cols != m_width) {
+    throw vpException(vpException::dimensionError, "Image size differs from the one used to select the pixels");
+  }
+
+  computeGradients(*I_level);
 }
 
 /*!
@@ -225,24 +482,41 @@ void vpFeatureLuminance::buildFrom(vpImage<unsigned char> &I)
 */
 void vpFeatureLuminance::interaction(vpMatrix &L)
 {
-  L.resize(dim_s, 6);
+  L.resize(dim_s, 6, false);
+  fillInteraction(L, 0);
+}
 
-  for (unsigned int m = 0; m < L.getRows(); m++) {
-    double Ix = pixInfo[m].Ix;
-    double Iy = pixInfo[m].Iy;
+/*!
+  Write the interaction matrix \f$ L_I \f$ in the rows of \e L starting at
+  \e offset, one row per pixel.
 
-    double x = pixInfo[m].x;
-    double y = pixInfo[m].y;
-    double Zinv = 1 / pixInfo[m].Z;
+  \param L : Matrix with 6 columns and at least \e offset + getDimension()
+  rows.
+  \param offset : Index of the first row of \e L related to this feature.
+  \param select : Not used.
+*/
+void vpFeatureLuminance::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int /* select */)
+{
+  if (offset + dim_s > L.getRows() || L.getCols() != 6) {
+    throw(vpException(vpException::dimensionError, "Interaction matrix too small to store the luminance feature"));
+  }
 
-    {
-      L[m][0] = Ix * Zinv;
-      L[m][1] = Iy * Zinv;
-      L[m][2] = -(x * Ix + y * Iy) * Zinv;
-      L[m][3] = -Ix * x * y - (1 + y * y) * Iy;
-      L[m][4] = (1 + x * x) * Ix + Iy * x * y;
-      L[m][5] = Iy * x - Ix * y;
-    }
+  double Zinv = 1 / Z;
+
+  for (unsigned int m = 0; m < dim_s; m++) {
+    double Ix = m_Ix[m];
+    double Iy = m_Iy[m];
+
+    double x = m_x[m];
+    double y = m_y[m];
+
+    double *Lm = L[offset + m];
+    Lm[0] = Ix * Zinv;
+    Lm[1] = Iy * Zinv;
+    Lm[2] = -(x * Ix + y * Iy) * Zinv;
+    Lm[3] = -Ix * x * y - (1 + y * y) * Iy;
+    Lm[4] = (1 + x * x) * Ix + Iy * x * y;
+    Lm[5] = Iy * x - Ix * y;
   }
 }
 
@@ -258,6 +532,100 @@ vpMatrix vpFeatureLuminance::interaction(const unsigned int /* select */)
   return L;
 }
 
+/*!
+  Accumulate \f$ L_I^\top L_I \f$ and \f$ L_I^\top {\bf e} \f$ without
+  building the interaction matrix \f$ L_I \f$. Each pixel contributes one
+  row that is computed on the fly and directly added to the \f$6 \times 6\f$
+  normal equations. When OpenMP is available, the pixels are shared between
+  the threads that each accumulate their own partial sums.
+
+  \param e : Error vector of the whole task. The rows corresponding to the
+  luminance feature start at index \e offset.
+  \param offset : Index of the first row of \e e related to this feature.
+  \param LtL : \f$6 \times 6\f$ matrix updated with \f$ L_I^\top L_I \f$.
+  \param Lte : 6-dimension vector updated with \f$ L_I^\top {\bf e} \f$.
+  \param select : Not used.
+*/
+void vpFeatureLuminance::interactionNormalEquations(const vpColVector &e, const unsigned int offset, vpMatrix &LtL,
+                                                    vpColVector &Lte, const unsigned int /* select */)
+{
+  if (offset + dim_s > e.getRows()) {
+    throw(vpException(vpException::dimensionError, "Error vector too small to compute the normal equations"));
+  }
+  if (LtL.getRows() != 6 || LtL.getCols() != 6 || Lte.getRows() != 6) {
+    throw(vpException(vpException::dimensionError, "Bad normal equations dimension"));
+  }
+
+  // Upper triangular part of LtL (21 values) followed by Lte (6 values)
+  double sum[27];
+  for (unsigned int k = 0; k < 27; k++)
+    sum[k] = 0.;
+
+  const double *err = e.data + offset;
+  int npix = (int)dim_s;
+  double Zinv = 1 / Z;
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    double partial[27];
+    for (unsigned int k = 0; k < 27; k++)
+      partial[k] = 0.;
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for nowait
+#endif
+    for (int m = 0; m < npix; m++) {
+      double Ix = m_Ix[m];
+      double Iy = m_Iy[m];
+
+      double x = m_x[m];
+      double y = m_y[m];
+
+      double Lm[6];
+      Lm[0] = Ix * Zinv;
+      Lm[1] = Iy * Zinv;
+      Lm[2] = -(x * Ix + y * Iy) * Zinv;
+      Lm[3] = -Ix * x * y - (1 + y * y) * Iy;
+      Lm[4] = (1 + x * x) * Ix + Iy * x * y;
+      Lm[5] = Iy * x - Ix * y;
+
+      double em = err[m];
+      unsigned int k = 0;
+      for (unsigned int i = 0; i < 6; i++) {
+        for (unsigned int j = i; j < 6; j++) {
+          partial[k++] += Lm[i] * Lm[j];
+        }
+      }
+      for (unsigned int i = 0; i < 6; i++) {
+        partial[k++] += Lm[i] * em;
+      }
+    }
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp critical
+#endif
+    {
+      for (unsigned int k = 0; k < 27; k++)
+        sum[k] += partial[k];
+    }
+  }
+
+  unsigned int k = 0;
+  for (unsigned int i = 0; i < 6; i++) {
+    for (unsigned int j = i; j < 6; j++) {
+      LtL[i][j] += sum[k];
+      if (i != j)
+        LtL[j][i] += sum[k];
+      k++;
+    }
+  }
+  for (unsigned int i = 0; i < 6; i++) {
+    Lte[i] += sum[k++];
+  }
+}
+
 /*!
   Compute the error \f$ (I-I^*)\f$ between the current and the desired
 
@@ -267,10 +635,32 @@ vpMatrix vpFeatureLuminance::interaction(const unsigned int /* select */)
 */
 void vpFeatureLuminance::error(const vpBasicFeature &s_star, vpColVector &e)
 {
-  e.resize(dim_s);
+  e.resize(dim_s, false);
+  fillError(s_star, e, 0);
+}
+
+/*!
+  Write the error \f$ I - I^* \f$ in the rows of \e e starting at \e
+  offset.
+
+  \param s_star : Desired luminance feature.
+  \param e : Vector with at least \e offset + getDimension() rows.
+  \param offset : Index of the first row of \e e related to this feature.
+  \param select : Not used.
+*/
+void vpFeatureLuminance::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                                   const unsigned int /* select */)
+{
+  const vpFeatureLuminance *lum_star = dynamic_cast<const vpFeatureLuminance *>(&s_star);
+  if (lum_star != NULL && lum_star->dim_s != dim_s) {
+    throw vpException(vpException::dimensionError, "Current and desired luminance features do not have the same size");
+  }
+  if (offset + dim_s > e.getRows()) {
+    throw(vpException(vpException::dimensionError, "Error vector too small to store the luminance feature"));
+  }
 
   for (unsigned int i = 0; i < dim_s; i++) {
-    e[i] = s[i] - s_star[i];
+    e[offset + i] = s[i] - s_star[i];
   }
 }
 
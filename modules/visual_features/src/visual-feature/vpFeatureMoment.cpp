@@ -82,9 +82,9 @@ void vpFeatureMoment::init()
 /*!
   Feature's dimension according to selection.
 */
-int vpFeatureMoment::getDimension(unsigned int select) const
+unsigned int vpFeatureMoment::getDimension(unsigned int select) const
 {
-  int dim = 0;
+  unsigned int dim = 0;
 
   for (unsigned int i = 0; i < dim_s; ++i)
     if (vpBasicFeature::FEATURE_LINE[i] & select)
@@ -166,7 +166,8 @@ void vpFeatureMoment::update(double A_, double B_, double C_)
   if (this->moment != NULL) {
     dim_s = (unsigned int)this->moment->get().size();
 
-    s.resize(dim_s);
+    if (s.getRows() != dim_s)
+      s.resize(dim_s);
 
     for (unsigned int i = 0; i < dim_s; i++)
       s[i] = this->moment->get()[i];
@@ -255,6 +256,18 @@ void vpFeatureMoment::linkTo(vpFeatureMomentDatabase &featureMoments)
 
 void vpFeatureMoment::compute_interaction() {}
 
+/*!
+  Appends to \e names the names of the features that must be updated before
+  this feature. They are used by vpFeatureMomentDatabase::updateAll() to order
+  the updates. The default implementation declares no dependency.
+  Types inheriting from vpFeatureMoment that access other features of the
+  database should implement this function.
+
+  \param names : Names of the features this feature depends on, as returned
+  by vpFeatureMoment::name().
+*/
+void vpFeatureMoment::getDependencies(std::vector<const char *> &names) const { (void)names; }
+
 vpFeatureMoment::~vpFeatureMoment() {}
 
 VISP_EXPORT std::ostream &operator<<(std::ostream &os, const vpFeatureMoment &featM)
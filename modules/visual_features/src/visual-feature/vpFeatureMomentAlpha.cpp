@@ -82,6 +82,16 @@ void vpFeatureMomentAlpha::compute_interaction()
                     momentCentered.get(1, 1) * featureMomentCentered.interaction(0, 2));
 }
 
+/*!
+  Appends the names of the features whose interaction matrices are combined
+  to compute this feature: vpFeatureMomentCentered.
+  \param names : Names of the features this feature depends on.
+*/
+void vpFeatureMomentAlpha::getDependencies(std::vector<const char *> &names) const
+{
+  names.push_back("vpFeatureMomentCentered");
+}
+
 #else
 
 /*!
@@ -166,7 +176,7 @@ void vpFeatureMomentAlpha::compute_interaction()
 
 vpColVector vpFeatureMomentAlpha::error(const vpBasicFeature &s_star, const unsigned int /* select */)
 {
-  vpColVector e(0);
+  vpColVector e(1);
   double err = s[0] - s_star[0];
 
   if (err < -M_PI)
@@ -174,10 +184,7 @@ vpColVector vpFeatureMomentAlpha::error(const vpBasicFeature &s_star, const unsi
   if (err > M_PI)
     err -= 2 * M_PI;
 
-  vpColVector ecv(1);
-  ecv[0] = err;
-  e = vpColVector::stack(e, ecv);
-
+  e[0] = err;
   return e;
 }
 #endif
@@ -102,6 +102,17 @@ void vpFeatureMomentAreaNormalized::compute_interaction()
   interaction_matrices[0] = normalized_multiplier * La;
 }
 
+/*!
+  Appends the names of the features whose interaction matrices are combined
+  to compute this feature: vpFeatureMomentCentered and vpFeatureMomentBasic.
+  \param names : Names of the features this feature depends on.
+*/
+void vpFeatureMomentAreaNormalized::getDependencies(std::vector<const char *> &names) const
+{
+  names.push_back("vpFeatureMomentCentered");
+  names.push_back("vpFeatureMomentBasic");
+}
+
 #else
 
 #include <limits>
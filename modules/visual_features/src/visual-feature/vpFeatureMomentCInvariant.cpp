@@ -410,6 +410,17 @@ void vpFeatureMomentCInvariant::compute_interaction()
       (I2 / (I3 * I3 * I3)) * La + (a / (I3 * I3 * I3)) * LI2 - (3 * a * I2 / (I3 * I3 * I3 * I3)) * LI3;
 }
 
+/*!
+  Appends the names of the features whose interaction matrices are combined
+  to compute this feature: vpFeatureMomentCentered and vpFeatureMomentBasic.
+  \param names : Names of the features this feature depends on.
+*/
+void vpFeatureMomentCInvariant::getDependencies(std::vector<const char *> &names) const
+{
+  names.push_back("vpFeatureMomentCentered");
+  names.push_back("vpFeatureMomentBasic");
+}
+
 #else
 #include <visp3/core/vpMomentCInvariant.h>
 #include <visp3/core/vpMomentCentered.h>
@@ -681,6 +692,17 @@ void vpFeatureMomentCInvariant::compute_interaction()
   */
 }
 
+/*!
+  Appends the names of the features whose interaction matrices are used
+  to compute this feature: vpFeatureMomentCentered and vpFeatureMomentBasic.
+  \param names : Names of the features this feature depends on.
+*/
+void vpFeatureMomentCInvariant::getDependencies(std::vector<const char *> &names) const
+{
+  names.push_back("vpFeatureMomentCentered");
+  names.push_back("vpFeatureMomentBasic");
+}
+
 /*!
   Print out all invariants that were computed
   There are 15 of them, as in [Point-based and region based.ITRO05]
@@ -321,6 +321,24 @@ void vpFeatureMomentCentered::compute_interaction()
 #endif // #ifdef VISP_MOMENTS_COMBINE_MATRICES
 }
 
+/*!
+  Appends the names of the features whose interaction matrices are combined
+  to compute the interaction matrices of the centered moments:
+  vpFeatureMomentGravityCenter and vpFeatureMomentBasic. There is no
+  dependency when ViSP is built without the VISP_MOMENTS_COMBINE_MATRICES
+  option.
+  \param names : Names of the features this feature depends on.
+*/
+void vpFeatureMomentCentered::getDependencies(std::vector<const char *> &names) const
+{
+#ifdef VISP_MOMENTS_COMBINE_MATRICES
+  names.push_back("vpFeatureMomentGravityCenter");
+  names.push_back("vpFeatureMomentBasic");
+#else
+  (void)names;
+#endif
+}
+
 /*!
   \relates vpFeatureMomentCentered
   Print all the interaction matrices of visual features
@@ -73,12 +73,5 @@ vpFeatureMomentCommon::vpFeatureMomentCommon(vpMomentDatabase &moments, double A
 */
 void vpFeatureMomentCommon::updateAll(double A, double B, double C)
 {
-  featureMomentBasic.update(A, B, C);
-  featureGravity.update(A, B, C);
-  featureCentered.update(A, B, C);
-  featureAn.update(A, B, C);
-  featureGravityNormalized.update(A, B, C);
-  featureCInvariant.update(A, B, C);
-  featureAlpha.update(A, B, C);
-  feature_moment_area.update(A, B, C);
+  vpFeatureMomentDatabase::updateAll(A, B, C);
 }
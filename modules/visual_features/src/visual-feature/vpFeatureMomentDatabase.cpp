@@ -39,6 +39,8 @@
 #include <iostream>
 #include <typeinfo>
 #include <visp3/core/vpConfig.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpMomentDatabase.h>
 #include <visp3/visual_features/vpFeatureMoment.h>
 #include <visp3/visual_features/vpFeatureMomentDatabase.h>
 
@@ -50,9 +52,108 @@
 */
 void vpFeatureMomentDatabase::add(vpFeatureMoment &featureMoment, char *name)
 {
-  featureMomentsDataBase.insert(std::pair<const char *, vpFeatureMoment *>((const char *)name, &featureMoment));
+  if (featureMomentsDataBase.insert(std::pair<const char *, vpFeatureMoment *>((const char *)name, &featureMoment))
+          .second) {
+    linkOrder.push_back(&featureMoment);
+    compiled = false;
+  }
+}
+
+/*!
+  Resolves the dependencies between the features of the database (see
+  vpFeatureMoment::getDependencies()) and sorts them such as each feature is
+  updated after the features it depends on. Features without dependencies
+  between them keep the order in which they were linked to the database.
+  Dependencies that are not in the database are ignored.
+
+  This function is called by updateAll() when a feature was linked to the
+  database since the last call.
+
+  \exception vpException::badValue : If there is a cyclic dependency between
+  the features.
+*/
+void vpFeatureMomentDatabase::compile()
+{
+  updateOrder.clear();
+  updateOrder.reserve(linkOrder.size());
+
+  // 0: not visited, 1: being visited, 2: sorted
+  std::vector<int> state(linkOrder.size(), 0);
+  for (unsigned int i = 0; i < linkOrder.size(); i++) {
+    compileNode(i, state);
+  }
+
+  // Dependencies as indexes in the update order
+  dependencyStart.assign(1, 0);
+  dependencies.clear();
+  std::vector<const char *> names;
+  for (unsigned int i = 0; i < updateOrder.size(); i++) {
+    names.clear();
+    updateOrder[i]->getDependencies(names);
+    for (size_t k = 0; k < names.size(); k++) {
+      std::map<const char *, vpFeatureMoment *, vpFeatureMomentDatabase::cmp_str>::const_iterator it =
+          featureMomentsDataBase.find(names[k]);
+      if (it == featureMomentsDataBase.end()) {
+        continue;
+      }
+      for (unsigned int j = 0; j < i; j++) {
+        if (updateOrder[j] == it->second) {
+          dependencies.push_back(j);
+          break;
+        }
+      }
+    }
+    dependencyStart.push_back((unsigned int)dependencies.size());
+  }
+
+  momentsRevision.assign(updateOrder.size(), 0);
+  outdated.assign(updateOrder.size(), 1);
+  updated.assign(updateOrder.size(), 0);
+  compiled = true;
+}
+
+/*!
+  Depth-first traversal used by compile() to add a feature after its
+  dependencies.
+*/
+void vpFeatureMomentDatabase::compileNode(unsigned int index, std::vector<int> &state)
+{
+  if (state[index] == 2) {
+    return;
+  }
+  if (state[index] == 1) {
+    throw vpException(vpException::badValue, "Cyclic dependency involving %s in the feature moment database",
+                      linkOrder[index]->name());
+  }
+  state[index] = 1;
+
+  std::vector<const char *> names;
+  linkOrder[index]->getDependencies(names);
+  for (size_t i = 0; i < names.size(); i++) {
+    std::map<const char *, vpFeatureMoment *, vpFeatureMomentDatabase::cmp_str>::const_iterator it =
+        featureMomentsDataBase.find(names[i]);
+    if (it == featureMomentsDataBase.end()) {
+      continue;
+    }
+    for (unsigned int j = 0; j < linkOrder.size(); j++) {
+      if (linkOrder[j] == it->second) {
+        compileNode(j, state);
+        break;
+      }
+    }
+  }
+
+  state[index] = 2;
+  updateOrder.push_back(linkOrder[index]);
 }
 
+/*!
+  Forces the next call to updateAll() to update all the features, for
+  example when the moments were computed outside of vpMomentDatabase::updateAll()
+  or vpMomentDatabase::computeAll().
+*/
+void vpFeatureMomentDatabase::invalidate() { outdated.assign(outdated.size(), 1); }
+
 /*!
   Retrieves a moment feature from the database
   \param type : the name of the feature, the one specified when using add
@@ -71,7 +172,14 @@ vpFeatureMoment &vpFeatureMomentDatabase::get(const char *type, bool &found)
 }
 
 /*!
-  Update all moment features in the database with plane coefficients
+  Update all moment features in the database with plane coefficients.
+
+  The features are updated in dependency order (see compile()). A feature is
+  updated only if the plane coefficients differ from the ones it was last
+  updated with, if its moment database was updated or computed again (see
+  vpMomentDatabase::getRevision()), or if one of the features it depends on
+  was updated.
+
   \param A : first plane coefficient for a plane equation of the following
   type Ax+By+C=1/Z \param B : second plane coefficient for a plane equation of
   the following type Ax+By+C=1/Z \param C : third plane coefficient for a
@@ -79,23 +187,27 @@ vpFeatureMoment &vpFeatureMomentDatabase::get(const char *type, bool &found)
 */
 void vpFeatureMomentDatabase::updateAll(double A, double B, double C)
 {
-  std::map<const char *, vpFeatureMoment *, vpFeatureMomentDatabase::cmp_str>::const_iterator itr;
-#ifdef VISP_HAVE_OPENMP
-  std::vector<vpFeatureMoment *> values;
-  values.reserve(featureMomentsDataBase.size());
-  for (itr = featureMomentsDataBase.begin(); itr != featureMomentsDataBase.end(); ++itr) {
-    values.push_back((*itr).second);
-  }
-#pragma omp parallel for shared(A, B, C)
-  for (int i = 0; i < (int)values.size(); i++) {
-    unsigned int i_ = static_cast<unsigned int>(i);
-    values[i_]->update(A, B, C);
+  if (!compiled) {
+    compile();
   }
-#else
-  for (itr = featureMomentsDataBase.begin(); itr != featureMomentsDataBase.end(); ++itr) {
-    (*itr).second->update(A, B, C);
+
+  for (unsigned int i = 0; i < updateOrder.size(); i++) {
+    vpFeatureMoment *feature = updateOrder[i];
+    unsigned long revision = feature->moments.getRevision();
+    bool changed = outdated[i] || momentsRevision[i] != revision || feature->A != A || feature->B != B ||
+                   feature->C != C;
+    for (unsigned int k = dependencyStart[i]; k < dependencyStart[i + 1] && !changed; k++) {
+      changed = (updated[dependencies[k]] != 0);
+    }
+
+    updated[i] = changed ? 1 : 0;
+    if (changed) {
+      outdated[i] = 1;
+      feature->update(A, B, C);
+      momentsRevision[i] = revision;
+      outdated[i] = 0;
+    }
   }
-#endif
 }
 
 /*
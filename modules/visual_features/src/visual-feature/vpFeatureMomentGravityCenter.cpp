@@ -78,6 +78,16 @@ void vpFeatureMomentGravityCenter::compute_interaction()
       momentObject.get(0, 1) * pow(momentObject.get(0, 0), -0.2e1) * featureMomentBasic.interaction(0, 0);
 }
 
+/*!
+  Appends the names of the features whose interaction matrices are combined
+  to compute this feature: vpFeatureMomentBasic.
+  \param names : Names of the features this feature depends on.
+*/
+void vpFeatureMomentGravityCenter::getDependencies(std::vector<const char *> &names) const
+{
+  names.push_back("vpFeatureMomentBasic");
+}
+
 #else
 
 #include <limits>
@@ -97,6 +97,18 @@ void vpFeatureMomentGravityCenterNormalized::compute_interaction()
                             momentSurfaceNormalized.get()[0] * featureMomentGravity.interaction(2);
 }
 
+/*!
+  Appends the names of the features whose interaction matrices are combined
+  to compute this feature: vpFeatureMomentGravityCenter and
+  vpFeatureMomentAreaNormalized.
+  \param names : Names of the features this feature depends on.
+*/
+void vpFeatureMomentGravityCenterNormalized::getDependencies(std::vector<const char *> &names) const
+{
+  names.push_back("vpFeatureMomentGravityCenter");
+  names.push_back("vpFeatureMomentAreaNormalized");
+}
+
 #else
 
 #include <limits>
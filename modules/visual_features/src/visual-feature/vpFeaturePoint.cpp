@@ -214,9 +214,20 @@ void vpFeaturePoint::set_xyZ(const double x_, const double y_, const double Z_)
 */
 vpMatrix vpFeaturePoint::interaction(const unsigned int select)
 {
-  vpMatrix L;
+  vpMatrix L(getDimension(select), 6);
+  fillInteraction(L, 0, select);
+  return L;
+}
 
-  L.resize(0, 6);
+/*!
+  Write the interaction matrix of the selected subset of the feature in the
+  rows of \e L starting at \e offset, without temporary matrix. See
+  interaction() for the selection.
+*/
+void vpFeaturePoint::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  checkFillDimension(L.getRows(), offset, select);
+  unsigned int row = offset;
 
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
@@ -261,33 +272,25 @@ vpMatrix vpFeaturePoint::interaction(const unsigned int select)
   }
 
   if (vpFeaturePoint::selectX() & select) {
-    vpMatrix Lx(1, 6);
-    Lx = 0;
-
-    Lx[0][0] = -1 / Z_;
-    Lx[0][1] = 0;
-    Lx[0][2] = x_ / Z_;
-    Lx[0][3] = x_ * y_;
-    Lx[0][4] = -(1 + x_ * x_);
-    Lx[0][5] = y_;
-
-    L = vpMatrix::stack(L, Lx);
+    double *Lx = L[row++];
+    Lx[0] = -1 / Z_;
+    Lx[1] = 0;
+    Lx[2] = x_ / Z_;
+    Lx[3] = x_ * y_;
+    Lx[4] = -(1 + x_ * x_);
+    Lx[5] = y_;
   }
 
   if (vpFeaturePoint::selectY() & select) {
-    vpMatrix Ly(1, 6);
-    Ly = 0;
-
-    Ly[0][0] = 0;
-    Ly[0][1] = -1 / Z_;
-    Ly[0][2] = y_ / Z_;
-    Ly[0][3] = 1 + y_ * y_;
-    Ly[0][4] = -x_ * y_;
-    Ly[0][5] = -x_;
+    double *Ly = L[row++];
+    Ly[0] = 0;
+    Ly[1] = -1 / Z_;
+    Ly[2] = y_ / Z_;
+    Ly[3] = 1 + y_ * y_;
+    Ly[4] = -x_ * y_;
+    Ly[5] = -x_;
 
-    L = vpMatrix::stack(L, Ly);
   }
-  return L;
 }
 
 /*!
@@ -328,28 +331,22 @@ vpMatrix vpFeaturePoint::interaction(const unsigned int select)
 */
 vpColVector vpFeaturePoint::error(const vpBasicFeature &s_star, const unsigned int select)
 {
-  vpColVector e(0);
-
-  try {
-    if (vpFeaturePoint::selectX() & select) {
-      vpColVector ex(1);
-      ex[0] = s[0] - s_star[0];
-
-      e = vpColVector::stack(e, ex);
-    }
-
-    if (vpFeaturePoint::selectY() & select) {
-      vpColVector ey(1);
-      ey[0] = s[1] - s_star[1];
-      e = vpColVector::stack(e, ey);
-    }
-  } catch (...) {
-    throw;
-  }
-
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
   return e;
 }
 
+/*!
+  Write the error \f$ (s-s^*)\f$ of the selected subset of the feature in
+  the rows of \e e starting at \e offset, without temporary vector. See
+  error() for the selection.
+*/
+void vpFeaturePoint::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                               const unsigned int select)
+{
+  fillSelectedError(s_star, e, offset, select);
+}
+
 /*!
   Print to stdout the values of the current visual feature \f$ s \f$.
 
@@ -229,9 +229,20 @@ double vpFeaturePoint3D::get_Z() const { return s[2]; }
 */
 vpMatrix vpFeaturePoint3D::interaction(const unsigned int select)
 {
-  vpMatrix L;
+  vpMatrix L(getDimension(select), 6);
+  fillInteraction(L, 0, select);
+  return L;
+}
 
-  L.resize(0, 6);
+/*!
+  Write the interaction matrix of the selected subset of the feature in the
+  rows of \e L starting at \e offset, without temporary matrix. See
+  interaction() for the selection.
+*/
+void vpFeaturePoint3D::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  checkFillDimension(L.getRows(), offset, select);
+  unsigned int row = offset;
 
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
@@ -262,46 +273,34 @@ vpMatrix vpFeaturePoint3D::interaction(const unsigned int select)
   double Z = get_Z();
 
   if (vpFeaturePoint3D::selectX() & select) {
-    vpMatrix Lx(1, 6);
-    Lx = 0;
-
-    Lx[0][0] = -1;
-    Lx[0][1] = 0;
-    Lx[0][2] = 0;
-    Lx[0][3] = 0;
-    Lx[0][4] = -Z;
-    Lx[0][5] = Y;
-
-    L = vpMatrix::stack(L, Lx);
+    double *Lx = L[row++];
+    Lx[0] = -1;
+    Lx[1] = 0;
+    Lx[2] = 0;
+    Lx[3] = 0;
+    Lx[4] = -Z;
+    Lx[5] = Y;
   }
 
   if (vpFeaturePoint3D::selectY() & select) {
-    vpMatrix Ly(1, 6);
-    Ly = 0;
-
-    Ly[0][0] = 0;
-    Ly[0][1] = -1;
-    Ly[0][2] = 0;
-    Ly[0][3] = Z;
-    Ly[0][4] = 0;
-    Ly[0][5] = -X;
-
-    L = vpMatrix::stack(L, Ly);
+    double *Ly = L[row++];
+    Ly[0] = 0;
+    Ly[1] = -1;
+    Ly[2] = 0;
+    Ly[3] = Z;
+    Ly[4] = 0;
+    Ly[5] = -X;
   }
   if (vpFeaturePoint3D::selectZ() & select) {
-    vpMatrix Lz(1, 6);
-    Lz = 0;
-
-    Lz[0][0] = 0;
-    Lz[0][1] = 0;
-    Lz[0][2] = -1;
-    Lz[0][3] = -Y;
-    Lz[0][4] = X;
-    Lz[0][5] = 0;
+    double *Lz = L[row++];
+    Lz[0] = 0;
+    Lz[1] = 0;
+    Lz[2] = -1;
+    Lz[3] = -Y;
+    Lz[4] = X;
+    Lz[5] = 0;
 
-    L = vpMatrix::stack(L, Lz);
   }
-  return L;
 }
 
 /*!
@@ -357,34 +356,22 @@ vpMatrix vpFeaturePoint3D::interaction(const unsigned int select)
 */
 vpColVector vpFeaturePoint3D::error(const vpBasicFeature &s_star, const unsigned int select)
 {
-  vpColVector e(0);
-
-  try {
-    if (vpFeaturePoint3D::selectX() & select) {
-      vpColVector ex(1);
-      ex[0] = s[0] - s_star[0];
-
-      e = vpColVector::stack(e, ex);
-    }
-
-    if (vpFeaturePoint3D::selectY() & select) {
-      vpColVector ey(1);
-      ey[0] = s[1] - s_star[1];
-      e = vpColVector::stack(e, ey);
-    }
-
-    if (vpFeaturePoint3D::selectZ() & select) {
-      vpColVector ez(1);
-      ez[0] = s[2] - s_star[2];
-      e = vpColVector::stack(e, ez);
-    }
-  } catch (...) {
-    throw;
-  }
-
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
   return e;
 }
 
+/*!
+  Write the error \f$ (s-s^*)\f$ of the selected subset of the feature in
+  the rows of \e e starting at \e offset, without temporary vector. See
+  error() for the selection.
+*/
+void vpFeaturePoint3D::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                                 const unsigned int select)
+{
+  fillSelectedError(s_star, e, offset, select);
+}
+
 /*!
 
   Build a 3D point visual feature from the camera frame coordinates
@@ -247,9 +247,20 @@ double vpFeaturePointPolar::get_Z() const { return this->Z; }
 */
 vpMatrix vpFeaturePointPolar::interaction(const unsigned int select)
 {
-  vpMatrix L;
+  vpMatrix L(getDimension(select), 6);
+  fillInteraction(L, 0, select);
+  return L;
+}
 
-  L.resize(0, 6);
+/*!
+  Write the interaction matrix of the selected subset of the feature in the
+  rows of \e L starting at \e offset, without temporary matrix. See
+  interaction() for the selection.
+*/
+void vpFeaturePointPolar::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  checkFillDimension(L.getRows(), offset, select);
+  unsigned int row = offset;
 
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
@@ -306,38 +317,30 @@ vpMatrix vpFeaturePointPolar::interaction(const unsigned int select)
   }
 
   if (vpFeaturePointPolar::selectRho() & select) {
-    vpMatrix Lrho(1, 6);
-    Lrho = 0;
-
-    Lrho[0][0] = -c_ / Z_;
-    Lrho[0][1] = -s_ / Z_;
-    Lrho[0][2] = rho / Z_;
-    Lrho[0][3] = (1 + rho2) * s_;
-    Lrho[0][4] = -(1 + rho2) * c_;
-    Lrho[0][5] = 0;
+    double *Lrho = L[row++];
+    Lrho[0] = -c_ / Z_;
+    Lrho[1] = -s_ / Z_;
+    Lrho[2] = rho / Z_;
+    Lrho[3] = (1 + rho2) * s_;
+    Lrho[4] = -(1 + rho2) * c_;
+    Lrho[5] = 0;
 
     //     printf("Lrho: rho %f theta %f Z %f\n", rho, theta, Z);
     //     std::cout << "Lrho: " << Lrho << std::endl;
-
-    L = vpMatrix::stack(L, Lrho);
   }
 
   if (vpFeaturePointPolar::selectTheta() & select) {
-    vpMatrix Ltheta(1, 6);
-    Ltheta = 0;
-
-    Ltheta[0][0] = s_ / (rho * Z_);
-    Ltheta[0][1] = -c_ / (rho * Z_);
-    Ltheta[0][2] = 0;
-    Ltheta[0][3] = c_ / rho;
-    Ltheta[0][4] = s_ / rho;
-    Ltheta[0][5] = -1;
+    double *Ltheta = L[row++];
+    Ltheta[0] = s_ / (rho * Z_);
+    Ltheta[1] = -c_ / (rho * Z_);
+    Ltheta[2] = 0;
+    Ltheta[3] = c_ / rho;
+    Ltheta[4] = s_ / rho;
+    Ltheta[5] = -1;
 
     //     printf("Ltheta: rho %f theta %f Z %f\n", rho, theta, Z);
     //     std::cout << "Ltheta: " << Ltheta << std::endl;
-    L = vpMatrix::stack(L, Ltheta);
   }
-  return L;
 }
 
 /*!
@@ -384,38 +387,32 @@ vpMatrix vpFeaturePointPolar::interaction(const unsigned int select)
 */
 vpColVector vpFeaturePointPolar::error(const vpBasicFeature &s_star, const unsigned int select)
 {
-  vpColVector e(0);
-
-  try {
-    if (vpFeaturePointPolar::selectRho() & select) {
-      vpColVector erho(1);
-      erho[0] = s[0] - s_star[0];
-
-      e = vpColVector::stack(e, erho);
-    }
-
-    if (vpFeaturePointPolar::selectTheta() & select) {
-
-      //      printf("err: %f - %f = %f\n", s[1], s_star[1], s[1] -
-      //      s_star[1]);
-      double err = s[1] - s_star[1];
-
-      //      printf("Error: %f ", err );
-      while (err < -M_PI)
-        err += 2 * M_PI;
-      while (err > M_PI)
-        err -= 2 * M_PI;
-      //     printf(" modif %f \n", err );
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
+  return e;
+}
 
-      vpColVector etheta(1);
-      etheta[0] = err;
-      e = vpColVector::stack(e, etheta);
-    }
-  } catch (...) {
-    throw;
+/*!
+  Write the error \f$ (s-s^*)\f$ of the selected subset of the feature in
+  the rows of \e e starting at \e offset, without temporary vector. See
+  error() for the selection.
+*/
+void vpFeaturePointPolar::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                                    const unsigned int select)
+{
+  checkFillDimension(e.getRows(), offset, select);
+  unsigned int row = offset;
+  if (vpFeaturePointPolar::selectRho() & select) {
+    e[row++] = s[0] - s_star[0];
+  }
+  if (vpFeaturePointPolar::selectTheta() & select) {
+    double err = s[1] - s_star[1];
+    while (err < -M_PI)
+      err += 2 * M_PI;
+    while (err > M_PI)
+      err -= 2 * M_PI;
+    e[row++] = err;
   }
-
-  return e;
 }
 
 /*!
@@ -0,0 +1,366 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Set of 2D point visual features.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpFeaturePointSet.cpp
+  \brief Class that defines a set of 2D point visual features
+*/
+
+#include <cmath>
+#include <iostream>
+
+#include <visp3/core/vpFeatureDisplay.h>
+#include <visp3/visual_features/vpFeatureException.h>
+#include <visp3/visual_features/vpFeaturePointSet.h>
+
+namespace
+{
+void checkDepth(double Z)
+{
+  if (Z < 0) {
+    throw(vpFeatureException(vpFeatureException::badInitializationError, "Point is behind the camera"));
+  }
+  if (fabs(Z) < 1e-6) {
+    throw(vpFeatureException(vpFeatureException::badInitializationError, "Point Z coordinates is null"));
+  }
+}
+}
+
+/*!
+  Default constructor that builds an empty set of points.
+*/
+vpFeaturePointSet::vpFeaturePointSet() : m_nbPoints(0), m_Z() { init(); }
+
+/*!
+  Build a set of \e n points with \f$ x = y = 0 \f$ and \f$ Z = 1 \f$.
+
+  \param n : Number of points.
+*/
+vpFeaturePointSet::vpFeaturePointSet(unsigned int n) : m_nbPoints(n), m_Z() { init(); }
+
+/*!
+  Reset the coordinates of the points to \f$ x = y = 0 \f$ and the depth to
+  \f$ Z = 1 \f$. The number of points is kept.
+*/
+void vpFeaturePointSet::init()
+{
+  dim_s = 2 * m_nbPoints;
+  nbParameters = 0;
+  s.resize(dim_s);
+  s = 0;
+  m_Z.assign(m_nbPoints, 1.);
+}
+
+/*!
+  Resize the set to \e n points and reset their coordinates.
+
+  \param n : Number of points.
+*/
+void vpFeaturePointSet::init(unsigned int n)
+{
+  m_nbPoints = n;
+  init();
+}
+
+/*!
+  Set the coordinates of the point \e i.
+
+  \param i : Index of the point.
+  \param x, y : Coordinates of the point in the image plane, in meter.
+  \param Z : Depth of the point in the camera frame.
+
+  \exception vpFeatureException::badInitializationError : If \e Z is not
+  strictly positive.
+*/
+void vpFeaturePointSet::set_xyZ(unsigned int i, double x, double y, double Z)
+{
+  if (i >= m_nbPoints) {
+    throw(vpFeatureException(vpFeatureException::badInitializationError, "Point index %d out of range [0, %d[", i,
+                             m_nbPoints));
+  }
+  checkDepth(Z);
+  s[i] = x;
+  s[m_nbPoints + i] = y;
+  m_Z[i] = Z;
+}
+
+/*!
+  Build the set from the coordinates of the points. The set is resized to the
+  number of points.
+
+  \param x, y : Coordinates of the points in the image plane, in meter.
+  \param Z : Depth of the points in the camera frame.
+
+  \exception vpFeatureException::badInitializationError : If the vectors do
+  not have the same size or if a depth is not strictly positive.
+*/
+void vpFeaturePointSet::buildFrom(const std::vector<double> &x, const std::vector<double> &y,
+                                  const std::vector<double> &Z)
+{
+  if (y.size() != x.size() || Z.size() != x.size()) {
+    throw(vpFeatureException(vpFeatureException::badInitializationError,
+                             "Point coordinates vectors do not have the same size"));
+  }
+  for (size_t i = 0; i < Z.size(); i++) {
+    checkDepth(Z[i]);
+  }
+  if (x.size() != m_nbPoints) {
+    init((unsigned int)x.size());
+  }
+  for (unsigned int i = 0; i < m_nbPoints; i++) {
+    s[i] = x[i];
+    s[m_nbPoints + i] = y[i];
+  }
+  m_Z = Z;
+}
+
+/*!
+  Return the dimension of the feature vector.
+
+  \param select : selectX(), selectY() or both. Each selected coordinate
+  contributes \f$ N \f$ rows.
+*/
+unsigned int vpFeaturePointSet::getDimension(const unsigned int select) const
+{
+  unsigned int dim = 0;
+  if (selectX() & select)
+    dim += m_nbPoints;
+  if (selectY() & select)
+    dim += m_nbPoints;
+  return dim;
+}
+
+/*!
+  Return the feature vector, that is the \f$ x \f$ coordinates of the points
+  followed by their \f$ y \f$ coordinates if both are selected.
+
+  \param select : selectX(), selectY() or both.
+*/
+vpColVector vpFeaturePointSet::get_s(unsigned int select) const
+{
+  vpColVector state(getDimension(select));
+  fill_s(state, 0, select);
+  return state;
+}
+
+/*!
+  Write the selected parameters in the rows of \e s_vector starting at \e
+  offset, in the same order as get_s().
+*/
+void vpFeaturePointSet::fill_s(vpColVector &s_vector, const unsigned int offset, const unsigned int select) const
+{
+  checkFillDimension(s_vector.getRows(), offset, select);
+  unsigned int k = offset;
+  if (selectX() & select)
+    for (unsigned int i = 0; i < m_nbPoints; i++)
+      s_vector[k++] = s[i];
+  if (selectY() & select)
+    for (unsigned int i = 0; i < m_nbPoints; i++)
+      s_vector[k++] = s[m_nbPoints + i];
+}
+
+/*!
+  Compute and return the interaction matrix of the selected coordinates of
+  the points. The rows related to point \e i are the ones of vpFeaturePoint:
+
+  \f[ L_{x_i} = \left[\begin{array}{cccccc}
+  -1/Z_i & 0 & x_i/Z_i & x_i y_i & -(1+x_i^2) & y_i \end{array}\right] \f]
+  \f[ L_{y_i} = \left[\begin{array}{cccccc}
+  0 & -1/Z_i & y_i/Z_i & 1+y_i^2 & -x_i y_i & -x_i \end{array}\right] \f]
+
+  The \f$ L_{x_i} \f$ rows come first, followed by the \f$ L_{y_i} \f$ rows.
+
+  \param select : selectX(), selectY() or both.
+  \return The \f$ N \times 6 \f$ or \f$ 2N \times 6 \f$ interaction matrix.
+*/
+vpMatrix vpFeaturePointSet::interaction(const unsigned int select)
+{
+  vpMatrix L(getDimension(select), 6);
+  fillInteraction(L, 0, select);
+  return L;
+}
+
+/*!
+  Write the interaction matrix of the selected parameters in the rows of \e L
+  starting at \e offset. See interaction() for the row layout.
+*/
+void vpFeaturePointSet::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  checkFillDimension(L.getRows(), offset, select);
+  const double *x = s.data;
+  const double *y = s.data + m_nbPoints;
+  unsigned int k = offset;
+
+  if (selectX() & select) {
+    for (unsigned int i = 0; i < m_nbPoints; i++, k++) {
+      double *Lk = L[k];
+      double invZ = 1. / m_Z[i];
+      Lk[0] = -invZ;
+      Lk[1] = 0.;
+      Lk[2] = x[i] * invZ;
+      Lk[3] = x[i] * y[i];
+      Lk[4] = -(1. + x[i] * x[i]);
+      Lk[5] = y[i];
+    }
+  }
+  if (selectY() & select) {
+    for (unsigned int i = 0; i < m_nbPoints; i++, k++) {
+      double *Lk = L[k];
+      double invZ = 1. / m_Z[i];
+      Lk[0] = 0.;
+      Lk[1] = -invZ;
+      Lk[2] = y[i] * invZ;
+      Lk[3] = 1. + y[i] * y[i];
+      Lk[4] = -x[i] * y[i];
+      Lk[5] = -x[i];
+    }
+  }
+}
+
+/*!
+  Compute the error \f$ (s-s^*)\f$ between the current and the desired
+  sets of points.
+
+  \param s_star : Desired visual feature, with the same number of points.
+  \param select : selectX(), selectY() or both.
+
+  \exception vpException::dimensionError : If the two sets do not have the
+  same number of points.
+*/
+vpColVector vpFeaturePointSet::error(const vpBasicFeature &s_star, const unsigned int select)
+{
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
+  return e;
+}
+
+/*!
+  Write the error of the selected parameters in the rows of \e e starting at
+  \e offset. See error() for the details.
+*/
+void vpFeaturePointSet::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                                  const unsigned int select)
+{
+  const vpFeaturePointSet *set_star = dynamic_cast<const vpFeaturePointSet *>(&s_star);
+  if (set_star == NULL || set_star->m_nbPoints != m_nbPoints) {
+    throw(vpException(vpException::dimensionError, "Current and desired point sets do not have the same size"));
+  }
+
+  checkFillDimension(e.getRows(), offset, select);
+  unsigned int k = offset;
+  if (selectX() & select)
+    for (unsigned int i = 0; i < m_nbPoints; i++)
+      e[k++] = s[i] - set_star->s[i];
+  if (selectY() & select)
+    for (unsigned int i = m_nbPoints; i < dim_s; i++)
+      e[k++] = s[i] - set_star->s[i];
+}
+
+/*!
+  Print to stdout the coordinates of the points.
+
+  \param select : selectX(), selectY() or both.
+*/
+void vpFeaturePointSet::print(const unsigned int select) const
+{
+  std::cout << "Point set: " << m_nbPoints << " points" << std::endl;
+  for (unsigned int i = 0; i < m_nbPoints; i++) {
+    std::cout << "  Z=" << m_Z[i];
+    if (selectX() & select)
+      std::cout << " x=" << get_x(i);
+    if (selectY() & select)
+      std::cout << " y=" << get_y(i);
+    std::cout << std::endl;
+  }
+}
+
+/*!
+  Create an object with the same type and the same number of points.
+*/
+vpFeaturePointSet *vpFeaturePointSet::duplicate() const
+{
+  vpFeaturePointSet *feature = new vpFeaturePointSet(m_nbPoints);
+  return feature;
+}
+
+/*!
+  Display the points.
+
+  \param cam : Camera parameters.
+  \param I : Image.
+  \param color : Color to use for the display.
+  \param thickness : Thickness of the feature representation.
+*/
+void vpFeaturePointSet::display(const vpCameraParameters &cam, const vpImage<unsigned char> &I, const vpColor &color,
+                                unsigned int thickness) const
+{
+  for (unsigned int i = 0; i < m_nbPoints; i++)
+    vpFeatureDisplay::displayPoint(get_x(i), get_y(i), cam, I, color, thickness);
+}
+
+/*!
+  Display the points.
+
+  \param cam : Camera parameters.
+  \param I : Color image.
+  \param color : Color to use for the display.
+  \param thickness : Thickness of the feature representation.
+*/
+void vpFeaturePointSet::display(const vpCameraParameters &cam, const vpImage<vpRGBa> &I, const vpColor &color,
+                                unsigned int thickness) const
+{
+  for (unsigned int i = 0; i < m_nbPoints; i++)
+    vpFeatureDisplay::displayPoint(get_x(i), get_y(i), cam, I, color, thickness);
+}
+
+/*!
+  Function used to select the \f$ x \f$ coordinates of all the points.
+
+  \code
+  vpFeaturePointSet s(10);
+  vpMatrix L_x = s.interaction(vpFeaturePointSet::selectX()); // 10 x 6 matrix
+  \endcode
+*/
+unsigned int vpFeaturePointSet::selectX() { return FEATURE_LINE[0]; }
+
+/*!
+  Function used to select the \f$ y \f$ coordinates of all the points.
+
+  \code
+  vpFeaturePointSet s(10);
+  vpMatrix L_y = s.interaction(vpFeaturePointSet::selectY()); // 10 x 6 matrix
+  \endcode
+*/
+unsigned int vpFeaturePointSet::selectY() { return FEATURE_LINE[1]; }
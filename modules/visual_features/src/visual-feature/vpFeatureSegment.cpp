@@ -187,9 +187,20 @@ previous code to consider as visual feature \f$s = (l, \alpha)\f$.
 */
 vpMatrix vpFeatureSegment::interaction(const unsigned int select)
 {
+  vpMatrix L(getDimension(select), 6);
+  fillInteraction(L, 0, select);
+  return L;
+}
 
-  vpMatrix L;
-  L.resize(0, 6);
+/*!
+  Write the interaction matrix of the selected subset of the feature in the
+  rows of \e L starting at \e offset, without temporary matrix. See
+  interaction() for the selection.
+*/
+void vpFeatureSegment::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  checkFillDimension(L.getRows(), offset, select);
+  unsigned int row = offset;
 
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
@@ -244,95 +255,85 @@ vpMatrix vpFeatureSegment::interaction(const unsigned int select)
     double lns = sin_a_ * ln;
 
     if (vpFeatureSegment::selectXc() & select) {
-      vpMatrix Lxn(1, 6);
-      Lxn[0][0] = -Zn_inv + lambda * xn * cos_a_;
-      Lxn[0][1] = lambda * xn * sin_a_;
-      Lxn[0][2] = lambda1 * (xn * xnalpha - cos_a_ / 4.);
-      Lxn[0][3] = sin_a_ * cos_a_ / 4 / ln - xn * xnalpha * sin_a_ / ln;
-      Lxn[0][4] = -ln * (1. + lc * lc / 4.) + xn * xnalpha * cos_a_ / ln;
-      Lxn[0][5] = yn;
-      L = vpMatrix::stack(L, Lxn);
+      double *Lxn = L[row++];
+      Lxn[0] = -Zn_inv + lambda * xn * cos_a_;
+      Lxn[1] = lambda * xn * sin_a_;
+      Lxn[2] = lambda1 * (xn * xnalpha - cos_a_ / 4.);
+      Lxn[3] = sin_a_ * cos_a_ / 4 / ln - xn * xnalpha * sin_a_ / ln;
+      Lxn[4] = -ln * (1. + lc * lc / 4.) + xn * xnalpha * cos_a_ / ln;
+      Lxn[5] = yn;
     }
 
     if (vpFeatureSegment::selectYc() & select) {
-      vpMatrix Lyn(1, 6);
-      Lyn[0][0] = lambda * yn * cos_a_;
-      Lyn[0][1] = -Zn_inv + lambda * yn * sin_a_;
-      Lyn[0][2] = lambda1 * (yn * xnalpha - sin_a_ / 4.);
-      Lyn[0][3] = ln * (1 + ls * ls / 4.) - yn * xnalpha * sin_a_ / ln;
-      Lyn[0][4] = -sin_a_ * cos_a_ / 4 / ln + yn * xnalpha * cos_a_ / ln;
-      Lyn[0][5] = -xn;
-      L = vpMatrix::stack(L, Lyn);
+      double *Lyn = L[row++];
+      Lyn[0] = lambda * yn * cos_a_;
+      Lyn[1] = -Zn_inv + lambda * yn * sin_a_;
+      Lyn[2] = lambda1 * (yn * xnalpha - sin_a_ / 4.);
+      Lyn[3] = ln * (1 + ls * ls / 4.) - yn * xnalpha * sin_a_ / ln;
+      Lyn[4] = -sin_a_ * cos_a_ / 4 / ln + yn * xnalpha * cos_a_ / ln;
+      Lyn[5] = -xn;
     }
 
     if (vpFeatureSegment::selectL() & select) {
-      vpMatrix Lln(1, 6);
-      Lln[0][0] = lambda * lnc;
-      Lln[0][1] = lambda * lns;
-      Lln[0][2] = -(Zn_inv + lambda * xnalpha);
-      Lln[0][3] = -yn - xnalpha * sin_a_;
-      Lln[0][4] = xn + xnalpha * cos_a_;
-      Lln[0][5] = 0;
-      L = vpMatrix::stack(L, Lln);
+      double *Lln = L[row++];
+      Lln[0] = lambda * lnc;
+      Lln[1] = lambda * lns;
+      Lln[2] = -(Zn_inv + lambda * xnalpha);
+      Lln[3] = -yn - xnalpha * sin_a_;
+      Lln[4] = xn + xnalpha * cos_a_;
+      Lln[5] = 0;
     }
     if (vpFeatureSegment::selectAlpha() & select) {
       // We recall that xc_ contains xc/l, yc_ contains yc/l and l_ contains
       // 1/l
-      vpMatrix Lalpha(1, 6);
-      Lalpha[0][0] = -lambda1 * sin_a_ * l_;
-      Lalpha[0][1] = lambda1 * cos_a_ * l_;
-      Lalpha[0][2] = lambda1 * (xc_ * sin_a_ - yc_ * cos_a_);
-      Lalpha[0][3] = (-xc_ * sin_a_ * sin_a_ + yc_ * cos_a_ * sin_a_) / l_;
-      Lalpha[0][4] = (xc_ * cos_a_ * sin_a_ - yc_ * cos_a_ * cos_a_) / l_;
-      Lalpha[0][5] = -1;
-      L = vpMatrix::stack(L, Lalpha);
+      double *Lalpha = L[row++];
+      Lalpha[0] = -lambda1 * sin_a_ * l_;
+      Lalpha[1] = lambda1 * cos_a_ * l_;
+      Lalpha[2] = lambda1 * (xc_ * sin_a_ - yc_ * cos_a_);
+      Lalpha[3] = (-xc_ * sin_a_ * sin_a_ + yc_ * cos_a_ * sin_a_) / l_;
+      Lalpha[4] = (xc_ * cos_a_ * sin_a_ - yc_ * cos_a_ * cos_a_) / l_;
+      Lalpha[5] = -1;
     }
   } else {
     if (vpFeatureSegment::selectXc() & select) {
-      vpMatrix Lxc(1, 6);
-      Lxc[0][0] = -lambda2;
-      Lxc[0][1] = 0.;
-      Lxc[0][2] = lambda2 * xc_ - lambda1 * l_ * cos_a_ / 4.;
-      Lxc[0][3] = xc_ * yc_ + l_ * l_ * cos_a_ * sin_a_ / 4.;
-      Lxc[0][4] = -(1 + xc_ * xc_ + l_ * l_ * cos_a_ * cos_a_ / 4.);
-      Lxc[0][5] = yc_;
-      L = vpMatrix::stack(L, Lxc);
+      double *Lxc = L[row++];
+      Lxc[0] = -lambda2;
+      Lxc[1] = 0.;
+      Lxc[2] = lambda2 * xc_ - lambda1 * l_ * cos_a_ / 4.;
+      Lxc[3] = xc_ * yc_ + l_ * l_ * cos_a_ * sin_a_ / 4.;
+      Lxc[4] = -(1 + xc_ * xc_ + l_ * l_ * cos_a_ * cos_a_ / 4.);
+      Lxc[5] = yc_;
     }
 
     if (vpFeatureSegment::selectYc() & select) {
-      vpMatrix Lyc(1, 6);
-      Lyc[0][0] = 0.;
-      Lyc[0][1] = -lambda2;
-      Lyc[0][2] = lambda2 * yc_ - lambda1 * l_ * sin_a_ / 4.;
-      Lyc[0][3] = 1 + yc_ * yc_ + l_ * l_ * sin_a_ * sin_a_ / 4.;
-      Lyc[0][4] = -xc_ * yc_ - l_ * l_ * cos_a_ * sin_a_ / 4.;
-      Lyc[0][5] = -xc_;
-      L = vpMatrix::stack(L, Lyc);
+      double *Lyc = L[row++];
+      Lyc[0] = 0.;
+      Lyc[1] = -lambda2;
+      Lyc[2] = lambda2 * yc_ - lambda1 * l_ * sin_a_ / 4.;
+      Lyc[3] = 1 + yc_ * yc_ + l_ * l_ * sin_a_ * sin_a_ / 4.;
+      Lyc[4] = -xc_ * yc_ - l_ * l_ * cos_a_ * sin_a_ / 4.;
+      Lyc[5] = -xc_;
     }
 
     if (vpFeatureSegment::selectL() & select) {
-      vpMatrix Ll(1, 6);
-      Ll[0][0] = lambda1 * cos_a_;
-      Ll[0][1] = lambda1 * sin_a_;
-      Ll[0][2] = lambda2 * l_ - lambda1 * (xc_ * cos_a_ + yc_ * sin_a_);
-      Ll[0][3] = l_ * (xc_ * cos_a_ * sin_a_ + yc_ * (1 + sin_a_ * sin_a_));
-      Ll[0][4] = -l_ * (xc_ * (1 + cos_a_ * cos_a_) + yc_ * cos_a_ * sin_a_);
-      Ll[0][5] = 0;
-      L = vpMatrix::stack(L, Ll);
+      double *Ll = L[row++];
+      Ll[0] = lambda1 * cos_a_;
+      Ll[1] = lambda1 * sin_a_;
+      Ll[2] = lambda2 * l_ - lambda1 * (xc_ * cos_a_ + yc_ * sin_a_);
+      Ll[3] = l_ * (xc_ * cos_a_ * sin_a_ + yc_ * (1 + sin_a_ * sin_a_));
+      Ll[4] = -l_ * (xc_ * (1 + cos_a_ * cos_a_) + yc_ * cos_a_ * sin_a_);
+      Ll[5] = 0;
     }
     if (vpFeatureSegment::selectAlpha() & select) {
-      vpMatrix Lalpha(1, 6);
-      Lalpha[0][0] = -lambda1 * sin_a_ / l_;
-      Lalpha[0][1] = lambda1 * cos_a_ / l_;
-      Lalpha[0][2] = lambda1 * (xc_ * sin_a_ - yc_ * cos_a_) / l_;
-      Lalpha[0][3] = -xc_ * sin_a_ * sin_a_ + yc_ * cos_a_ * sin_a_;
-      Lalpha[0][4] = xc_ * cos_a_ * sin_a_ - yc_ * cos_a_ * cos_a_;
-      Lalpha[0][5] = -1;
-      L = vpMatrix::stack(L, Lalpha);
+      double *Lalpha = L[row++];
+      Lalpha[0] = -lambda1 * sin_a_ / l_;
+      Lalpha[1] = lambda1 * cos_a_ / l_;
+      Lalpha[2] = lambda1 * (xc_ * sin_a_ - yc_ * cos_a_) / l_;
+      Lalpha[3] = -xc_ * sin_a_ * sin_a_ + yc_ * cos_a_ * sin_a_;
+      Lalpha[4] = xc_ * cos_a_ * sin_a_ - yc_ * cos_a_ * cos_a_;
+      Lalpha[5] = -1;
     }
   }
-
-  return L;
 }
 
 /*!
@@ -362,36 +363,38 @@ vpMatrix vpFeatureSegment::interaction(const unsigned int select)
 */
 vpColVector vpFeatureSegment::error(const vpBasicFeature &s_star, const unsigned int select)
 {
-  vpColVector e(0);
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
+  return e;
+}
 
+/*!
+  Write the error \f$ (s-s^*)\f$ of the selected subset of the feature in
+  the rows of \e e starting at \e offset, without temporary vector. See
+  error() for the selection.
+*/
+void vpFeatureSegment::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                                 const unsigned int select)
+{
+  checkFillDimension(e.getRows(), offset, select);
+  unsigned int row = offset;
   if (vpFeatureSegment::selectXc() & select) {
-    vpColVector exc(1);
-    exc[0] = xc_ - s_star[0];
-    e = vpColVector::stack(e, exc);
+    e[row++] = xc_ - s_star[0];
   }
-
   if (vpFeatureSegment::selectYc() & select) {
-    vpColVector eyc(1);
-    eyc[0] = yc_ - s_star[1];
-    e = vpColVector::stack(e, eyc);
+    e[row++] = yc_ - s_star[1];
   }
-
   if (vpFeatureSegment::selectL() & select) {
-    vpColVector eL(1);
-    eL[0] = l_ - s_star[2];
-    e = vpColVector::stack(e, eL);
+    e[row++] = l_ - s_star[2];
   }
-
   if (vpFeatureSegment::selectAlpha() & select) {
-    vpColVector eAlpha(1);
-    eAlpha[0] = alpha_ - s_star[3];
-    while (eAlpha[0] < -M_PI)
-      eAlpha[0] += 2 * M_PI;
-    while (eAlpha[0] > M_PI)
-      eAlpha[0] -= 2 * M_PI;
-    e = vpColVector::stack(e, eAlpha);
+    double eAlpha = alpha_ - s_star[3];
+    while (eAlpha < -M_PI)
+      eAlpha += 2 * M_PI;
+    while (eAlpha > M_PI)
+      eAlpha -= 2 * M_PI;
+    e[row++] = eAlpha;
   }
-  return e;
 }
 
 /*!
@@ -407,9 +407,20 @@ double vpFeatureThetaU::get_TUz() const { return s[2]; }
 */
 vpMatrix vpFeatureThetaU::interaction(const unsigned int select)
 {
+  vpMatrix L(getDimension(select), 6);
+  fillInteraction(L, 0, select);
+  return L;
+}
 
-  vpMatrix L;
-  L.resize(0, 6);
+/*!
+  Write the interaction matrix of the selected subset of the feature in the
+  rows of \e L starting at \e offset, without temporary matrix. See
+  interaction() for the selection.
+*/
+void vpFeatureThetaU::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  checkFillDimension(L.getRows(), offset, select);
+  unsigned int row = offset;
 
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
@@ -436,71 +447,60 @@ vpMatrix vpFeatureThetaU::interaction(const unsigned int select)
   }
 
   // Lw computed using Lw = [theta/2 u]_x +/- (I + alpha [u]_x [u]_x)
-  vpColVector u(3);
-  for (unsigned int i = 0; i < 3; i++) {
-    u[i] = s[i] / 2.0;
-  }
-
-  vpMatrix Lw(3, 3);
-  Lw = vpColVector::skew(u); /* [theta/2  u]_x */
-
-  vpMatrix U2(3, 3);
-  U2.eye();
-
-  double theta = sqrt(s.sumSquare());
+  // [u]_x [u]_x = u u^T - I since u is a unit vector
+  double theta = sqrt(s[0] * s[0] + s[1] * s[1] + s[2] * s[2]);
+  double alpha = 0;
+  double u[3] = {0, 0, 0};
   if (theta >= 1e-6) {
+    alpha = 1 - vpMath::sinc(theta) / vpMath::sqr(vpMath::sinc(theta / 2.0));
     for (unsigned int i = 0; i < 3; i++)
       u[i] = s[i] / theta;
-
-    vpMatrix skew_u;
-    skew_u = vpColVector::skew(u);
-    U2 += (1 - vpMath::sinc(theta) / vpMath::sqr(vpMath::sinc(theta / 2.0))) * skew_u * skew_u;
   }
+  double sign = (rotation == cdRc) ? 1. : -1.;
 
-  if (rotation == cdRc) {
-    Lw += U2;
-  } else {
-    Lw -= U2;
+  double Lw[3][3];
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++) {
+      double U2 = alpha * u[i] * u[j] + ((i == j) ? 1 - alpha : 0.);
+      Lw[i][j] = sign * U2;
+    }
   }
+  /* [theta/2  u]_x */
+  Lw[0][1] -= s[2] / 2.0;
+  Lw[0][2] += s[1] / 2.0;
+  Lw[1][0] += s[2] / 2.0;
+  Lw[1][2] -= s[0] / 2.0;
+  Lw[2][0] -= s[1] / 2.0;
+  Lw[2][1] += s[0] / 2.0;
 
   // This version is a simplification
   if (vpFeatureThetaU::selectTUx() & select) {
-    vpMatrix Lx(1, 6);
-
-    Lx[0][0] = 0;
-    Lx[0][1] = 0;
-    Lx[0][2] = 0;
+    double *Lx = L[row++];
+    Lx[0] = 0;
+    Lx[1] = 0;
+    Lx[2] = 0;
     for (int i = 0; i < 3; i++)
-      Lx[0][i + 3] = Lw[0][i];
-
-    L = vpMatrix::stack(L, Lx);
+      Lx[i + 3] = Lw[0][i];
   }
 
   if (vpFeatureThetaU::selectTUy() & select) {
-    vpMatrix Ly(1, 6);
-
-    Ly[0][0] = 0;
-    Ly[0][1] = 0;
-    Ly[0][2] = 0;
+    double *Ly = L[row++];
+    Ly[0] = 0;
+    Ly[1] = 0;
+    Ly[2] = 0;
     for (int i = 0; i < 3; i++)
-      Ly[0][i + 3] = Lw[1][i];
-
-    L = vpMatrix::stack(L, Ly);
+      Ly[i + 3] = Lw[1][i];
   }
 
   if (vpFeatureThetaU::selectTUz() & select) {
-    vpMatrix Lz(1, 6);
-
-    Lz[0][0] = 0;
-    Lz[0][1] = 0;
-    Lz[0][2] = 0;
+    double *Lz = L[row++];
+    Lz[0] = 0;
+    Lz[1] = 0;
+    Lz[2] = 0;
     for (int i = 0; i < 3; i++)
-      Lz[0][i + 3] = Lw[2][i];
+      Lz[i + 3] = Lw[2][i];
 
-    L = vpMatrix::stack(L, Lz);
   }
-
-  return L;
 }
 
 /*!
@@ -566,32 +566,33 @@ vpMatrix vpFeatureThetaU::interaction(const unsigned int select)
 */
 vpColVector vpFeatureThetaU::error(const vpBasicFeature &s_star, const unsigned int select)
 {
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
+  return e;
+}
 
-  if (fabs(s_star.get_s().sumSquare()) > 1e-6) {
-    vpERROR_TRACE("s* should be zero ! ");
+/*!
+  Write the error \f$ (s-s^*)\f$ of the selected subset of the feature in
+  the rows of \e e starting at \e offset, without temporary vector. See
+  error() for the selection.
+*/
+void vpFeatureThetaU::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                                const unsigned int select)
+{
+  if (s_star[0] * s_star[0] + s_star[1] * s_star[1] + s_star[2] * s_star[2] > 1e-6) {
     throw(vpFeatureException(vpFeatureException::badInitializationError, "s* should be zero !"));
   }
-
-  vpColVector e(0);
-
+  checkFillDimension(e.getRows(), offset, select);
+  unsigned int row = offset;
   if (vpFeatureThetaU::selectTUx() & select) {
-    vpColVector ex(1);
-    ex[0] = s[0];
-    e = vpColVector::stack(e, ex);
+    e[row++] = s[0];
   }
-
   if (vpFeatureThetaU::selectTUy() & select) {
-    vpColVector ey(1);
-    ey[0] = s[1];
-    e = vpColVector::stack(e, ey);
+    e[row++] = s[1];
   }
-
   if (vpFeatureThetaU::selectTUz() & select) {
-    vpColVector ez(1);
-    ez[0] = s[2];
-    e = vpColVector::stack(e, ez);
+    e[row++] = s[2];
   }
-  return e;
 }
 
 /*!
@@ -301,9 +301,20 @@ double vpFeatureTranslation::get_Tz() const { return s[2]; }
 */
 vpMatrix vpFeatureTranslation::interaction(const unsigned int select)
 {
+  vpMatrix L(getDimension(select), 6);
+  fillInteraction(L, 0, select);
+  return L;
+}
 
-  vpMatrix L;
-  L.resize(0, 6);
+/*!
+  Write the interaction matrix of the selected subset of the feature in the
+  rows of \e L starting at \e offset, without temporary matrix. See
+  interaction() for the selection.
+*/
+void vpFeatureTranslation::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  checkFillDimension(L.getRows(), offset, select);
+  unsigned int row = offset;
 
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
@@ -324,120 +335,97 @@ vpMatrix vpFeatureTranslation::interaction(const unsigned int select)
   if (translation == cdMc) {
     // This version is a simplification
     if (vpFeatureTranslation::selectTx() & select) {
-      vpMatrix Lx(1, 6);
-
+      double *Lx = L[row++];
       for (int i = 0; i < 3; i++)
-        Lx[0][i] = f2Mf1[0][i];
-      Lx[0][3] = 0;
-      Lx[0][4] = 0;
-      Lx[0][5] = 0;
-
-      L = vpMatrix::stack(L, Lx);
+        Lx[i] = f2Mf1[0][i];
+      Lx[3] = 0;
+      Lx[4] = 0;
+      Lx[5] = 0;
     }
 
     if (vpFeatureTranslation::selectTy() & select) {
-      vpMatrix Ly(1, 6);
-
+      double *Ly = L[row++];
       for (int i = 0; i < 3; i++)
-        Ly[0][i] = f2Mf1[1][i];
-      Ly[0][3] = 0;
-      Ly[0][4] = 0;
-      Ly[0][5] = 0;
-
-      L = vpMatrix::stack(L, Ly);
+        Ly[i] = f2Mf1[1][i];
+      Ly[3] = 0;
+      Ly[4] = 0;
+      Ly[5] = 0;
     }
 
     if (vpFeatureTranslation::selectTz() & select) {
-      vpMatrix Lz(1, 6);
-
+      double *Lz = L[row++];
       for (int i = 0; i < 3; i++)
-        Lz[0][i] = f2Mf1[2][i];
-      Lz[0][3] = 0;
-      Lz[0][4] = 0;
-      Lz[0][5] = 0;
-
-      L = vpMatrix::stack(L, Lz);
+        Lz[i] = f2Mf1[2][i];
+      Lz[3] = 0;
+      Lz[4] = 0;
+      Lz[5] = 0;
     }
   }
   if (translation == cMcd) {
     // This version is a simplification
     if (vpFeatureTranslation::selectTx() & select) {
-      vpMatrix Lx(1, 6);
-      Lx[0][0] = -1;
-      Lx[0][1] = 0;
-      Lx[0][2] = 0;
-      Lx[0][3] = 0;
-      Lx[0][4] = -s[2];
-      Lx[0][5] = s[1];
-
-      L = vpMatrix::stack(L, Lx);
+      double *Lx = L[row++];
+      Lx[0] = -1;
+      Lx[1] = 0;
+      Lx[2] = 0;
+      Lx[3] = 0;
+      Lx[4] = -s[2];
+      Lx[5] = s[1];
     }
 
     if (vpFeatureTranslation::selectTy() & select) {
-      vpMatrix Ly(1, 6);
-      Ly[0][0] = 0;
-      Ly[0][1] = -1;
-      Ly[0][2] = 0;
-      Ly[0][3] = s[2];
-      Ly[0][4] = 0;
-      Ly[0][5] = -s[0];
-
-      L = vpMatrix::stack(L, Ly);
+      double *Ly = L[row++];
+      Ly[0] = 0;
+      Ly[1] = -1;
+      Ly[2] = 0;
+      Ly[3] = s[2];
+      Ly[4] = 0;
+      Ly[5] = -s[0];
     }
 
     if (vpFeatureTranslation::selectTz() & select) {
-      vpMatrix Lz(1, 6);
-      Lz[0][0] = 0;
-      Lz[0][1] = 0;
-      Lz[0][2] = -1;
-      Lz[0][3] = -s[1];
-      Lz[0][4] = s[0];
-      Lz[0][5] = 0;
-
-      L = vpMatrix::stack(L, Lz);
+      double *Lz = L[row++];
+      Lz[0] = 0;
+      Lz[1] = 0;
+      Lz[2] = -1;
+      Lz[3] = -s[1];
+      Lz[4] = s[0];
+      Lz[5] = 0;
     }
   }
 
   if (translation == cMo) {
     // This version is a simplification
     if (vpFeatureTranslation::selectTx() & select) {
-      vpMatrix Lx(1, 6);
-      Lx[0][0] = -1;
-      Lx[0][1] = 0;
-      Lx[0][2] = 0;
-      Lx[0][3] = 0;
-      Lx[0][4] = -s[2];
-      Lx[0][5] = s[1];
-
-      L = vpMatrix::stack(L, Lx);
+      double *Lx = L[row++];
+      Lx[0] = -1;
+      Lx[1] = 0;
+      Lx[2] = 0;
+      Lx[3] = 0;
+      Lx[4] = -s[2];
+      Lx[5] = s[1];
     }
 
     if (vpFeatureTranslation::selectTy() & select) {
-      vpMatrix Ly(1, 6);
-      Ly[0][0] = 0;
-      Ly[0][1] = -1;
-      Ly[0][2] = 0;
-      Ly[0][3] = s[2];
-      Ly[0][4] = 0;
-      Ly[0][5] = -s[0];
-
-      L = vpMatrix::stack(L, Ly);
+      double *Ly = L[row++];
+      Ly[0] = 0;
+      Ly[1] = -1;
+      Ly[2] = 0;
+      Ly[3] = s[2];
+      Ly[4] = 0;
+      Ly[5] = -s[0];
     }
 
     if (vpFeatureTranslation::selectTz() & select) {
-      vpMatrix Lz(1, 6);
-      Lz[0][0] = 0;
-      Lz[0][1] = 0;
-      Lz[0][2] = -1;
-      Lz[0][3] = -s[1];
-      Lz[0][4] = s[0];
-      Lz[0][5] = 0;
-
-      L = vpMatrix::stack(L, Lz);
+      double *Lz = L[row++];
+      Lz[0] = 0;
+      Lz[1] = 0;
+      Lz[2] = -1;
+      Lz[3] = -s[1];
+      Lz[4] = s[0];
+      Lz[5] = 0;
     }
   }
-
-  return L;
 }
 
 /*!
@@ -508,34 +496,25 @@ vpMatrix vpFeatureTranslation::interaction(const unsigned int select)
 */
 vpColVector vpFeatureTranslation::error(const vpBasicFeature &s_star, const unsigned int select)
 {
-  vpColVector e(0);
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
+  return e;
+}
 
+/*!
+  Write the error \f$ (s-s^*)\f$ of the selected subset of the feature in
+  the rows of \e e starting at \e offset, without temporary vector. See
+  error() for the selection.
+*/
+void vpFeatureTranslation::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                                     const unsigned int select)
+{
   if (translation == cdMc || translation == cMcd) {
-    if (s_star.get_s().sumSquare() > 1e-6) {
-      vpERROR_TRACE("s* should be zero ! ");
+    if (s_star[0] * s_star[0] + s_star[1] * s_star[1] + s_star[2] * s_star[2] > 1e-6) {
       throw(vpFeatureException(vpFeatureException::badInitializationError, "s* should be zero !"));
     }
   }
-
-  if (vpFeatureTranslation::selectTx() & select) {
-    vpColVector ex(1);
-    ex[0] = s[0] - s_star[0];
-    e = vpColVector::stack(e, ex);
-  }
-
-  if (vpFeatureTranslation::selectTy() & select) {
-    vpColVector ey(1);
-    ey[0] = s[1] - s_star[1];
-    e = vpColVector::stack(e, ey);
-  }
-
-  if (vpFeatureTranslation::selectTz() & select) {
-    vpColVector ez(1);
-    ez[0] = s[2] - s_star[2];
-    e = vpColVector::stack(e, ez);
-  }
-
-  return e;
+  fillSelectedError(s_star, e, offset, select);
 }
 
 /*!
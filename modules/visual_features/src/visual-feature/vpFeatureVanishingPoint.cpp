@@ -101,9 +101,20 @@ void vpFeatureVanishingPoint::set_xy(const double _x, const double _y)
 //! compute the interaction matrix from a subset of the possible features
 vpMatrix vpFeatureVanishingPoint::interaction(const unsigned int select)
 {
-  vpMatrix L;
+  vpMatrix L(getDimension(select), 6);
+  fillInteraction(L, 0, select);
+  return L;
+}
 
-  L.resize(0, 6);
+/*!
+  Write the interaction matrix of the selected subset of the feature in the
+  rows of \e L starting at \e offset, without temporary matrix. See
+  interaction() for the selection.
+*/
+void vpFeatureVanishingPoint::fillInteraction(vpMatrix &L, const unsigned int offset, const unsigned int select)
+{
+  checkFillDimension(L.getRows(), offset, select);
+  unsigned int row = offset;
 
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
@@ -129,33 +140,25 @@ vpMatrix vpFeatureVanishingPoint::interaction(const unsigned int select)
   double y = get_y();
 
   if (vpFeatureVanishingPoint::selectX() & select) {
-    vpMatrix Lx(1, 6);
-    Lx = 0;
-
-    Lx[0][0] = 0.;
-    Lx[0][1] = 0.;
-    Lx[0][2] = 0.;
-    Lx[0][3] = x * y;
-    Lx[0][4] = -(1 + x * x);
-    Lx[0][5] = y;
-
-    L = vpMatrix::stack(L, Lx);
+    double *Lx = L[row++];
+    Lx[0] = 0.;
+    Lx[1] = 0.;
+    Lx[2] = 0.;
+    Lx[3] = x * y;
+    Lx[4] = -(1 + x * x);
+    Lx[5] = y;
   }
 
   if (vpFeatureVanishingPoint::selectY() & select) {
-    vpMatrix Ly(1, 6);
-    Ly = 0;
-
-    Ly[0][0] = 0;
-    Ly[0][1] = 0.;
-    Ly[0][2] = 0.;
-    Ly[0][3] = 1 + y * y;
-    Ly[0][4] = -x * y;
-    Ly[0][5] = -x;
+    double *Ly = L[row++];
+    Ly[0] = 0;
+    Ly[1] = 0.;
+    Ly[2] = 0.;
+    Ly[3] = 1 + y * y;
+    Ly[4] = -x * y;
+    Ly[5] = -x;
 
-    L = vpMatrix::stack(L, Ly);
   }
-  return L;
 }
 
 /*! compute the error between two visual features from a subset of the
@@ -163,27 +166,22 @@ vpMatrix vpFeatureVanishingPoint::interaction(const unsigned int select)
  */
 vpColVector vpFeatureVanishingPoint::error(const vpBasicFeature &s_star, const unsigned int select)
 {
-  vpColVector e(0);
-
-  try {
-    if (vpFeatureVanishingPoint::selectX() & select) {
-      vpColVector ex(1);
-      ex[0] = s[0] - s_star[0];
-
-      e = vpColVector::stack(e, ex);
-    }
-
-    if (vpFeatureVanishingPoint::selectY() & select) {
-      vpColVector ey(1);
-      ey[0] = s[1] - s_star[1];
-      e = vpColVector::stack(e, ey);
-    }
-  } catch (...) {
-    throw;
-  }
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
   return e;
 }
 
+/*!
+  Write the error \f$ (s-s^*)\f$ of the selected subset of the feature in
+  the rows of \e e starting at \e offset, without temporary vector. See
+  error() for the selection.
+*/
+void vpFeatureVanishingPoint::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                                        const unsigned int select)
+{
+  fillSelectedError(s_star, e, offset, select);
+}
+
 void vpFeatureVanishingPoint::print(const unsigned int select) const
 {
 
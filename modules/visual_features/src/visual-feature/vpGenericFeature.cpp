@@ -168,47 +168,27 @@ void vpGenericFeature::setError(const vpColVector &error_vector)
 */
 vpColVector vpGenericFeature::error(const vpBasicFeature &s_star, const unsigned int select)
 {
-  if (s_star.get_s().getRows() != dim_s) {
+  vpColVector e(getDimension(select));
+  fillError(s_star, e, 0, select);
+  return e;
+}
+
+/*!
+  Write the error of the selected subset of the feature in the rows of \e e
+  starting at \e offset, without temporary vector. The error is the one
+  given with setError() if any, otherwise \f$ (s-s^*)\f$. See
+  error(const vpBasicFeature &, const unsigned int) for the selection.
+*/
+void vpGenericFeature::fillError(const vpBasicFeature &s_star, vpColVector &e, const unsigned int offset,
+                                 const unsigned int select)
+{
+  if (s_star.getDimension() != dim_s) {
     vpERROR_TRACE("size mismatch between s* dimension "
                   "and feature dimension");
     throw(vpFeatureException(vpFeatureException::sizeMismatchError, "size mismatch between s* dimension "
                                                                     "and feature dimension"));
   }
-
-  vpColVector e(0);
-
-  try {
-    if (errorStatus == errorHasToBeUpdated) {
-      vpERROR_TRACE("Error has no been updated since last iteration"
-                    "you should have used vpGenericFeature::setError"
-                    "in you visual servoing loop");
-      throw(vpFeatureException(vpFeatureException::badErrorVectorError,
-                               "Error has no been updated since last iteration"));
-    } else if (errorStatus == errorInitialized) {
-      vpDEBUG_TRACE(25, "Error init: e=e.");
-      errorStatus = errorHasToBeUpdated;
-      for (unsigned int i = 0; i < dim_s; i++)
-        if (FEATURE_LINE[i] & select) {
-          vpColVector ex(1);
-          ex[i] = err[i];
-
-          e = vpColVector::stack(e, ex);
-        }
-    } else {
-      vpDEBUG_TRACE(25, "Error not init: e=s-s*.");
-
-      for (unsigned int i = 0; i < dim_s; i++)
-        if (FEATURE_LINE[i] & select) {
-          vpColVector ex(1);
-          ex[0] = s[i] - s_star[i];
-
-          e = vpColVector::stack(e, ex);
-        }
-    }
-  } catch (...) {
-    throw;
-  }
-  return e;
+  fillGenericError(&s_star, e, offset, select);
 }
 
 /*!
@@ -253,39 +233,42 @@ vpColVector vpGenericFeature::error(const vpBasicFeature &s_star, const unsigned
 */
 vpColVector vpGenericFeature::error(const unsigned int select)
 {
-  vpColVector e(0);
-
-  try {
-    if (errorStatus == errorHasToBeUpdated) {
-      vpERROR_TRACE("Error has no been updated since last iteration"
-                    "you should have used vpGenericFeature::setError"
-                    "in you visual servoing loop");
-      throw(vpFeatureException(vpFeatureException::badErrorVectorError,
-                               "Error has no been updated since last iteration"));
-    } else if (errorStatus == errorInitialized) {
-      errorStatus = errorHasToBeUpdated;
-      for (unsigned int i = 0; i < dim_s; i++)
-        if (FEATURE_LINE[i] & select) {
-          vpColVector ex(1);
-          ex[i] = err[i];
-
-          e = vpColVector::stack(e, ex);
-        }
-    } else {
-
-      for (unsigned int i = 0; i < dim_s; i++)
-        if (FEATURE_LINE[i] & select) {
-          vpColVector ex(1);
-          ex[i] = s[i];
-
-          e = vpColVector::stack(e, ex);
-        }
-    }
-  } catch (...) {
-    throw;
+  vpColVector e(getDimension(select));
+  fillGenericError(NULL, e, 0, select);
+  return e;
+}
+
+/*
+  Write the error of the selected rows starting at offset. The desired
+  feature is considered as null when s_star is NULL.
+*/
+void vpGenericFeature::fillGenericError(const vpBasicFeature *s_star, vpColVector &e, const unsigned int offset,
+                                        const unsigned int select)
+{
+  checkFillDimension(e.getRows(), offset, select);
+  if (errorStatus == errorHasToBeUpdated) {
+    vpERROR_TRACE("Error has no been updated since last iteration"
+                  "you should have used vpGenericFeature::setError"
+                  "in you visual servoing loop");
+    throw(vpFeatureException(vpFeatureException::badErrorVectorError,
+                             "Error has no been updated since last iteration"));
   }
 
-  return e;
+  bool useErr = (errorStatus == errorInitialized);
+  if (useErr)
+    errorStatus = errorHasToBeUpdated;
+
+  unsigned int row = offset;
+  for (unsigned int i = 0; i < dim_s; i++) {
+    if (dim_s > 31 || (FEATURE_LINE[i] & select)) {
+      if (useErr)
+        e[row++] = err[i];
+      else if (s_star)
+        e[row++] = s[i] - (*s_star)[i];
+      else
+        e[row++] = s[i];
+    }
+  }
 }
 
 /*!
@@ -339,6 +322,19 @@ vpColVector vpGenericFeature::error(const unsigned int select)
   \endcode
 */
 vpMatrix vpGenericFeature::interaction(const unsigned int select)
+{
+  vpMatrix Ls(getDimension(select), 6);
+  fillInteraction(Ls, 0, select);
+  return Ls;
+}
+
+/*!
+  Write the rows of the interaction matrix given with setInteractionMatrix()
+  that correspond to the selected subset of the feature in the rows of \e Ls
+  starting at \e offset, without temporary matrix. See interaction() for the
+  selection.
+*/
+void vpGenericFeature::fillInteraction(vpMatrix &Ls, const unsigned int offset, const unsigned int select)
 {
   if (L.getRows() == 0) {
     std::cout << "interaction matrix " << L << std::endl;
@@ -350,23 +346,16 @@ vpMatrix vpGenericFeature::interaction(const unsigned int select)
     throw(vpFeatureException(vpFeatureException::notInitializedError, "size mismatch between s* dimension "
                                                                       "and feature dimension"));
   }
-
-  vpMatrix Ls;
-
-  Ls.resize(0, 6);
-
-  for (unsigned int i = 0; i < dim_s; i++)
-    if (FEATURE_LINE[i] & select) {
-      vpMatrix Lx(1, 6);
-      Lx = 0;
-
-      for (int j = 0; j < 6; j++)
-        Lx[0][j] = L[i][j];
-
-      Ls = vpMatrix::stack(Ls, Lx);
+  checkFillDimension(Ls.getRows(), offset, select);
+
+  unsigned int row = offset;
+  for (unsigned int i = 0; i < dim_s; i++) {
+    if (dim_s > 31 || (FEATURE_LINE[i] & select)) {
+      double *Lrow = Ls[row++];
+      for (unsigned int j = 0; j < 6; j++)
+        Lrow[j] = L[i][j];
     }
-
-  return Ls;
+  }
 }
 
 /*!
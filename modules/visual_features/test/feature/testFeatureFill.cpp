@@ -0,0 +1,248 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compare the in-place filling of the features to interaction() and error().
+ *
+ *****************************************************************************/
+
+/*!
+  \example testFeatureFill.cpp
+  \brief Checks that vpBasicFeature::fillInteraction(), fillError() and
+  fill_s() write at the requested offset the same rows as interaction(),
+  error() and get_s() for all the selections of the built-in features.
+*/
+
+#include <cmath>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/visual_features/vpFeatureDepth.h>
+#include <visp3/visual_features/vpFeatureEllipse.h>
+#include <visp3/visual_features/vpFeatureLine.h>
+#include <visp3/visual_features/vpFeaturePoint.h>
+#include <visp3/visual_features/vpFeaturePoint3D.h>
+#include <visp3/visual_features/vpFeaturePointPolar.h>
+#include <visp3/visual_features/vpFeaturePointSet.h>
+#include <visp3/visual_features/vpFeatureSegment.h>
+#include <visp3/visual_features/vpFeatureThetaU.h>
+#include <visp3/visual_features/vpFeatureTranslation.h>
+#include <visp3/visual_features/vpFeatureVanishingPoint.h>
+#include <visp3/visual_features/vpGenericFeature.h>
+
+namespace
+{
+const unsigned int offset = 3;
+const double sentinel = 1234.5;
+
+bool equal(double a, double b) { return std::fabs(a - b) <= 1e-12 * std::max(1., std::fabs(b)); }
+
+// Check that the rows outside [offset, offset+dim[ were not modified
+bool untouched(const vpMatrix &M, unsigned int dim)
+{
+  for (unsigned int i = 0; i < M.getRows(); i++) {
+    if (i >= offset && i < offset + dim)
+      continue;
+    for (unsigned int j = 0; j < M.getCols(); j++)
+      if (M[i][j] != sentinel)
+        return false;
+  }
+  return true;
+}
+
+bool checkSelection(vpBasicFeature &s, vpBasicFeature &s_star, unsigned int select, const std::string &name)
+{
+  vpMatrix L = s.interaction(select);
+  vpColVector e = s.error(s_star, select);
+  vpColVector state = s.get_s(select);
+  unsigned int dim = s.getDimension(select);
+
+  if (L.getRows() != dim || e.getRows() != dim || state.getRows() != dim) {
+    std::cerr << name << ": inconsistent dimension for selection " << select << std::endl;
+    return false;
+  }
+
+  vpMatrix L_fill(dim + offset + 2, 6);
+  vpColVector e_fill(dim + offset + 2), s_fill(dim + offset + 2);
+  L_fill = sentinel;
+  e_fill = sentinel;
+  s_fill = sentinel;
+  s.fillInteraction(L_fill, offset, select);
+  s.fillError(s_star, e_fill, offset, select);
+  s.fill_s(s_fill, offset, select);
+
+  if (!untouched(L_fill, dim) || !untouched(e_fill, dim) || !untouched(s_fill, dim)) {
+    std::cerr << name << ": rows outside the feature were modified for selection " << select << std::endl;
+    return false;
+  }
+  for (unsigned int i = 0; i < dim; i++) {
+    for (unsigned int j = 0; j < 6; j++) {
+      if (!equal(L_fill[offset + i][j], L[i][j])) {
+        std::cerr << name << ": interaction matrices differ at (" << i << ", " << j << ") for selection " << select
+                  << std::endl;
+        return false;
+      }
+    }
+    if (!equal(e_fill[offset + i], e[i]) || !equal(s_fill[offset + i], state[i])) {
+      std::cerr << name << ": error or feature vectors differ at " << i << " for selection " << select << std::endl;
+      return false;
+    }
+  }
+
+  // A matrix that is too small is rejected
+  if (dim > 0) {
+    vpMatrix L_small(dim + offset - 1, 6);
+    bool thrown = false;
+    try {
+      s.fillInteraction(L_small, offset, select);
+    } catch (const vpException &) {
+      thrown = true;
+    }
+    if (!thrown) {
+      std::cerr << name << ": a too small interaction matrix was not rejected" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Test all the selections of the first n elements of the feature
+bool check(vpBasicFeature &s, vpBasicFeature &s_star, unsigned int n, const std::string &name)
+{
+  if (!checkSelection(s, s_star, vpBasicFeature::FEATURE_ALL, name))
+    return false;
+  for (unsigned int select = 1; select < (1u << n); select++) {
+    if (!checkSelection(s, s_star, select, name))
+      return false;
+  }
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    vpFeaturePoint p, p_d;
+    p.buildFrom(0.1, -0.2, 0.8);
+    p_d.buildFrom(-0.05, 0.1, 0.5);
+    if (!check(p, p_d, 2, "vpFeaturePoint"))
+      return EXIT_FAILURE;
+
+    vpFeaturePoint3D p3, p3_d;
+    p3.buildFrom(0.1, -0.2, 0.8);
+    p3_d.buildFrom(0., 0.1, 0.5);
+    if (!check(p3, p3_d, 3, "vpFeaturePoint3D"))
+      return EXIT_FAILURE;
+
+    vpFeatureLine l, l_d;
+    l.buildFrom(0.2, vpMath::rad(170), 0.1, -0.3, 0.9, -1.2);
+    l_d.buildFrom(0.1, vpMath::rad(-175), 0., 0., 1., -0.5);
+    if (!check(l, l_d, 2, "vpFeatureLine"))
+      return EXIT_FAILURE;
+
+    vpFeatureEllipse el, el_d;
+    el.buildFrom(0.1, 0.05, 0.01, 0.002, 0.02, 0.1, -0.2, 1.5);
+    el_d.buildFrom(0., 0., 0.02, 0., 0.02, 0., 0., 2.);
+    if (!check(el, el_d, 5, "vpFeatureEllipse"))
+      return EXIT_FAILURE;
+
+    vpFeaturePointPolar pp, pp_d;
+    pp.buildFrom(0.3, vpMath::rad(175), 0.7);
+    pp_d.buildFrom(0.2, vpMath::rad(-170), 0.5);
+    if (!check(pp, pp_d, 2, "vpFeaturePointPolar"))
+      return EXIT_FAILURE;
+
+    vpFeatureSegment seg, seg_d;
+    seg.buildFrom(-0.1, 0.05, 0.8, 0.2, -0.1, 0.9);
+    seg_d.buildFrom(-0.1, 0., 0.5, 0.1, 0., 0.5);
+    if (!check(seg, seg_d, 4, "vpFeatureSegment"))
+      return EXIT_FAILURE;
+
+    vpFeatureVanishingPoint vp, vp_d;
+    vp.buildFrom(0.3, -0.1);
+    vp_d.buildFrom(0., 0.);
+    if (!check(vp, vp_d, 2, "vpFeatureVanishingPoint"))
+      return EXIT_FAILURE;
+
+    vpFeatureDepth d, d_d;
+    d.buildFrom(0.1, -0.2, 0.8, log(0.8 / 0.5));
+    if (!check(d, d_d, 1, "vpFeatureDepth"))
+      return EXIT_FAILURE;
+
+    vpHomogeneousMatrix cdMc(0.05, -0.02, 0.1, vpMath::rad(10), vpMath::rad(-15), vpMath::rad(30));
+    vpFeatureThetaU::vpFeatureThetaURotationRepresentationType tu_types[2] = {vpFeatureThetaU::cdRc,
+                                                                              vpFeatureThetaU::cRcd};
+    for (unsigned int i = 0; i < 2; i++) {
+      vpFeatureThetaU tu(cdMc, tu_types[i]), tu_d(tu_types[i]);
+      if (!check(tu, tu_d, 3, "vpFeatureThetaU"))
+        return EXIT_FAILURE;
+    }
+
+    vpFeatureTranslation::vpFeatureTranslationRepresentationType t_types[2] = {vpFeatureTranslation::cdMc,
+                                                                               vpFeatureTranslation::cMcd};
+    for (unsigned int i = 0; i < 2; i++) {
+      vpFeatureTranslation t(cdMc, t_types[i]), t_d(t_types[i]);
+      if (!check(t, t_d, 3, "vpFeatureTranslation"))
+        return EXIT_FAILURE;
+    }
+
+    std::vector<double> x(5), y(5), Z(5);
+    for (unsigned int i = 0; i < 5; i++) {
+      x[i] = 0.1 * i - 0.2;
+      y[i] = 0.05 * i;
+      Z[i] = 0.5 + 0.1 * i;
+    }
+    vpFeaturePointSet ps, ps_d;
+    ps.buildFrom(x, y, Z);
+    ps_d.buildFrom(y, x, Z);
+    if (!check(ps, ps_d, 2, "vpFeaturePointSet"))
+      return EXIT_FAILURE;
+
+    vpGenericFeature g(3), g_d(3);
+    vpMatrix Lg(3, 6);
+    for (unsigned int i = 0; i < 3; i++)
+      for (unsigned int j = 0; j < 6; j++)
+        Lg[i][j] = i + 0.1 * j;
+    g.setInteractionMatrix(Lg);
+    g.set_s(0.1, 0.2, 0.3);
+    g_d.set_s(-0.1, 0., 0.1);
+    if (!check(g, g_d, 3, "vpGenericFeature"))
+      return EXIT_FAILURE;
+
+    std::cout << "testFeatureFill is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getStringMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
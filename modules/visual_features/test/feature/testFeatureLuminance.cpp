@@ -0,0 +1,215 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Performs various tests on the luminance feature.
+ *
+ *****************************************************************************/
+
+/*!
+  \file testFeatureLuminance.cpp
+  \brief Performs various tests on the luminance feature: gradient
+  computation, pixel selection and pyramid levels.
+*/
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/visual_features/vpFeatureLuminance.h>
+
+#include <iostream>
+#include <stdlib.h>
+
+namespace
+{
+void buildImage(vpImage<unsigned char> &I, double shift)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      double val = 127.5 + 60. * sin((j + shift) / 7.) * cos((i - shift) / 9.) + 60. * sin((i + j) / 23.);
+      I[i][j] = (unsigned char)vpMath::round(val);
+    }
+  }
+}
+
+// Interaction matrix computed as in the original per pixel implementation
+void referenceInteraction(const vpImage<unsigned char> &I, const vpCameraParameters &cam, unsigned int bord,
+                          double Z, vpMatrix &L)
+{
+  unsigned int h = I.getHeight(), w = I.getWidth();
+  L.resize((h - 2 * bord) * (w - 2 * bord), 6);
+  unsigned int m = 0;
+  for (unsigned int i = bord; i < h - bord; i++) {
+    for (unsigned int j = bord; j < w - bord; j++, m++) {
+      double x = 0, y = 0;
+      vpPixelMeterConversion::convertPoint(cam, j, i, x, y);
+      double Ix = cam.get_px() * vpImageFilter::derivativeFilterX(I, i, j);
+      double Iy = cam.get_py() * vpImageFilter::derivativeFilterY(I, i, j);
+      L[m][0] = Ix / Z;
+      L[m][1] = Iy / Z;
+      L[m][2] = -(x * Ix + y * Iy) / Z;
+      L[m][3] = -Ix * x * y - (1 + y * y) * Iy;
+      L[m][4] = (1 + x * x) * Ix + Iy * x * y;
+      L[m][5] = Iy * x - Ix * y;
+    }
+  }
+}
+}
+
+int main()
+{
+  try {
+    unsigned int h = 97, w = 131;
+    vpImage<unsigned char> I(h, w), Id(h, w);
+    buildImage(I, 3.);
+    buildImage(Id, 0.);
+    vpCameraParameters cam(250., 260., w / 2., h / 2.);
+
+    // Dense feature compared to the per pixel implementation
+    vpFeatureLuminance sI;
+    sI.init(h, w, 0.7);
+    sI.setCameraParameters(cam);
+    sI.buildFrom(I);
+
+    vpMatrix L, Lref;
+    sI.interaction(L);
+    referenceInteraction(I, cam, 10, 0.7, Lref);
+    if (L.getRows() != Lref.getRows()) {
+      std::cerr << "Bad interaction matrix size" << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (unsigned int i = 0; i < L.getRows(); i++) {
+      for (unsigned int j = 0; j < 6; j++) {
+        if (std::fabs(L[i][j] - Lref[i][j]) > 1e-9 * std::max(1., std::fabs(Lref[i][j]))) {
+          std::cerr << "Interaction matrix differs at (" << i << ", " << j << "): " << L[i][j] << " vs "
+                    << Lref[i][j] << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    // Normal equations compared to the interaction matrix
+    vpFeatureLuminance sId;
+    sId.init(h, w, 0.7);
+    sId.setCameraParameters(cam);
+    sId.buildFrom(Id);
+    vpColVector e;
+    sI.error(sId, e);
+    vpMatrix LtL(6, 6);
+    vpColVector Lte(6);
+    sI.interactionNormalEquations(e, 0, LtL, Lte);
+    vpMatrix LtL_ref = L.AtA();
+    vpColVector Lte_ref = L.t() * e;
+    for (unsigned int i = 0; i < 6; i++) {
+      if (std::fabs(Lte[i] - Lte_ref[i]) > 1e-6 * std::max(1., std::fabs(Lte_ref[i]))) {
+        std::cerr << "L^T e differs" << std::endl;
+        return EXIT_FAILURE;
+      }
+      for (unsigned int j = 0; j < 6; j++) {
+        if (std::fabs(LtL[i][j] - LtL_ref[i][j]) > 1e-6 * std::max(1., std::fabs(LtL_ref[i][j]))) {
+          std::cerr << "L^T L differs" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    // Subsampling and gradient based selection
+    vpFeatureLuminance sId_sel, sI_sel;
+    sId_sel.init(h, w, 0.7);
+    sId_sel.setCameraParameters(cam);
+    sId_sel.setSubsampling(2);
+    sId_sel.setGradientThreshold(6.);
+    sId_sel.buildFrom(Id);
+    sI_sel.init(h, w, 0.7);
+    sI_sel.setCameraParameters(cam);
+    sI_sel.setPixelSelection(sId_sel);
+    sI_sel.buildFrom(I);
+
+    unsigned int nb_selected = sI_sel.dimension_s();
+    std::cout << "Selected pixels: " << nb_selected << " / " << sI.dimension_s() << std::endl;
+    if (nb_selected == 0 || nb_selected >= sI.dimension_s() / 4 || sId_sel.dimension_s() != nb_selected) {
+      std::cerr << "Bad number of selected pixels" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Each selected row should match a row of the dense interaction matrix
+    vpMatrix L_sel;
+    sI_sel.interaction(L_sel);
+    vpColVector s_sel = sI_sel.get_s();
+    vpColVector s_dense = sI.get_s();
+    for (unsigned int m = 0; m < L_sel.getRows(); m++) {
+      bool found = false;
+      for (unsigned int k = 0; k < L.getRows() && !found; k++) {
+        if (s_dense[k] == s_sel[m] && std::fabs(L[k][0] - L_sel[m][0]) < 1e-9 &&
+            std::fabs(L[k][5] - L_sel[m][5]) < 1e-9) {
+          found = true;
+        }
+      }
+      if (!found) {
+        std::cerr << "Selected pixel " << m << " not found in the dense feature" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Pyramid level
+    vpFeatureLuminance sI_pyr;
+    sI_pyr.init(h, w, 0.7);
+    sI_pyr.setCameraParameters(cam);
+    sI_pyr.setPyramidLevel(1);
+    sI_pyr.buildFrom(I);
+    unsigned int expected = (h / 2 - 20) * (w / 2 - 20);
+    if (sI_pyr.dimension_s() != expected) {
+      std::cerr << "Bad feature size at pyramid level 1: " << sI_pyr.dimension_s() << " instead of " << expected
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // An image with less rows than the feature should be rejected
+    vpImage<unsigned char> I_small(h - 10, w);
+    buildImage(I_small, 3.);
+    bool rejected = false;
+    try {
+      sI.buildFrom(I_small);
+    } catch (vpException &e) {
+      rejected = (e.getCode() == vpException::dimensionError);
+    }
+    if (!rejected) {
+      std::cerr << "Image with less rows than the feature was not rejected" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "testFeatureLuminance is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
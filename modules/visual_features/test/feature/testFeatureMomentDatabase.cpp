@@ -0,0 +1,226 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the dependency ordered update of moment and moment feature databases.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testFeatureMomentDatabase.cpp
+  \brief Compares the moment features updated through vpMomentCommon and
+  vpFeatureMomentCommon to features updated one by one in a known order.
+*/
+
+#include <visp3/core/vpMomentAlpha.h>
+#include <visp3/core/vpMomentArea.h>
+#include <visp3/core/vpMomentAreaNormalized.h>
+#include <visp3/core/vpMomentBasic.h>
+#include <visp3/core/vpMomentCInvariant.h>
+#include <visp3/core/vpMomentCentered.h>
+#include <visp3/core/vpMomentCommon.h>
+#include <visp3/core/vpMomentDatabase.h>
+#include <visp3/core/vpMomentGravityCenter.h>
+#include <visp3/core/vpMomentGravityCenterNormalized.h>
+#include <visp3/core/vpMomentObject.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/visual_features/vpFeatureMomentCommon.h>
+
+#include <iostream>
+#include <stdlib.h>
+
+namespace
+{
+void buildObject(vpMomentObject &obj, double shift)
+{
+  double x[4] = {0.2, 0.25, -0.2, -0.15};
+  double y[4] = {-0.1, 0.12, 0.1, -0.1};
+  std::vector<vpPoint> pts;
+  for (unsigned int i = 0; i < 4; i++) {
+    vpPoint p;
+    p.set_x(x[i] + shift);
+    p.set_y(y[i] - shift);
+    pts.push_back(p);
+  }
+  obj.setType(vpMomentObject::DENSE_POLYGON);
+  obj.fromVector(pts);
+}
+
+bool compare(vpFeatureMoment &f, vpFeatureMoment &f_ref, const std::string &name)
+{
+  vpMatrix L = f.interaction();
+  vpMatrix L_ref = f_ref.interaction();
+  if (L.getRows() != L_ref.getRows() || L.getRows() == 0) {
+    std::cerr << name << ": bad interaction matrix size" << std::endl;
+    return false;
+  }
+  for (unsigned int i = 0; i < L.getRows(); i++) {
+    for (unsigned int j = 0; j < L.getCols(); j++) {
+      if (std::fabs(L[i][j] - L_ref[i][j]) > 1e-9 * std::max(1., std::fabs(L_ref[i][j]))) {
+        std::cerr << name << ": interaction matrices differ at (" << i << ", " << j << ")" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int indexOf(const std::vector<vpMoment *> &order, const char *name)
+{
+  for (size_t i = 0; i < order.size(); i++) {
+    if (std::string(order[i]->name()) == name) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+int indexOf(const std::vector<vpFeatureMoment *> &order, const char *name)
+{
+  for (size_t i = 0; i < order.size(); i++) {
+    if (std::string(order[i]->name()) == name) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+}
+
+int main()
+{
+  try {
+    vpMomentObject dst(6), obj(6);
+    buildObject(dst, 0.);
+    buildObject(obj, 0.05);
+
+    double surface = vpMomentCommon::getSurface(dst);
+    std::vector<double> mu3 = vpMomentCommon::getMu3(dst);
+    double alpha = vpMomentCommon::getAlpha(dst);
+
+    // Databases computed in dependency order
+    vpMomentCommon mdb(surface, mu3, alpha, 1.);
+    vpFeatureMomentCommon fmdb(mdb);
+
+    // Reference databases computed one by one
+    vpMomentDatabase mdb_ref;
+    vpMomentBasic mb;
+    vpMomentGravityCenter mg;
+    vpMomentCentered mc;
+    vpMomentAreaNormalized man(surface, 1.);
+    vpMomentGravityCenterNormalized mgn;
+    vpMomentCInvariant mci;
+    vpMomentAlpha malpha(mu3, alpha);
+    vpMomentArea ma;
+    mb.linkTo(mdb_ref);
+    mg.linkTo(mdb_ref);
+    mc.linkTo(mdb_ref);
+    man.linkTo(mdb_ref);
+    mgn.linkTo(mdb_ref);
+    mci.linkTo(mdb_ref);
+    malpha.linkTo(mdb_ref);
+    ma.linkTo(mdb_ref);
+    vpFeatureMomentCommon fmdb_ref(mdb_ref);
+
+    const std::vector<vpMoment *> &order = mdb.getComputeOrder();
+    for (int iter = 0; iter < 3; iter++) {
+      buildObject(obj, 0.05 * iter);
+      double A = 0.01 * iter, B = -0.02, C = 1. + 0.1 * iter;
+
+      mdb.updateAll(obj);
+      fmdb.updateAll(A, B, C);
+
+      mdb_ref.updateAll(obj);
+      mg.compute();
+      mc.compute();
+      man.compute();
+      mgn.compute();
+      mci.compute();
+      malpha.compute();
+      ma.compute();
+      fmdb_ref.getFeatureMomentBasic().update(A, B, C);
+      fmdb_ref.getFeatureGravityCenter().update(A, B, C);
+      fmdb_ref.getFeatureCentered().update(A, B, C);
+      fmdb_ref.getFeatureAn().update(A, B, C);
+      fmdb_ref.getFeatureGravityNormalized().update(A, B, C);
+      fmdb_ref.getFeatureCInvariant().update(A, B, C);
+      fmdb_ref.getFeatureAlpha().update(A, B, C);
+      fmdb_ref.getFeatureArea().update(A, B, C);
+
+      if (!compare(fmdb.getFeatureGravityNormalized(), fmdb_ref.getFeatureGravityNormalized(), "xn, yn") ||
+          !compare(fmdb.getFeatureAn(), fmdb_ref.getFeatureAn(), "an") ||
+          !compare(fmdb.getFeatureCInvariant(), fmdb_ref.getFeatureCInvariant(), "c invariants") ||
+          !compare(fmdb.getFeatureAlpha(), fmdb_ref.getFeatureAlpha(), "alpha") ||
+          !compare(fmdb.getFeatureArea(), fmdb_ref.getFeatureArea(), "area")) {
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Dependencies are computed first
+    if (order.size() != 8 || indexOf(order, "vpMomentGravityCenter") > indexOf(order, "vpMomentCentered") ||
+        indexOf(order, "vpMomentCentered") > indexOf(order, "vpMomentCInvariant") ||
+        indexOf(order, "vpMomentAreaNormalized") > indexOf(order, "vpMomentGravityCenterNormalized")) {
+      std::cerr << "Bad moment computation order" << std::endl;
+      return EXIT_FAILURE;
+    }
+    const std::vector<vpFeatureMoment *> &forder = fmdb.getUpdateOrder();
+    if (forder.size() != 8 ||
+        indexOf(forder, "vpFeatureMomentCentered") > indexOf(forder, "vpFeatureMomentCInvariant") ||
+        indexOf(forder, "vpFeatureMomentBasic") > indexOf(forder, "vpFeatureMomentCInvariant")) {
+      std::cerr << "Bad feature update order" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // updateAll() always computes the moments
+    unsigned long revision = mdb.getRevision();
+    mdb.updateAll(obj);
+    if (mdb.getRevision() != revision + 1) {
+      std::cerr << "Moments not computed again by updateAll()" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Nothing is computed again when the object did not change and the cache is used
+    revision = mdb.getRevision();
+    if (mdb.computeAllIfChanged(obj) || mdb.getRevision() != revision) {
+      std::cerr << "Moments computed again with the same object" << std::endl;
+      return EXIT_FAILURE;
+    }
+    buildObject(obj, 0.2);
+    if (!mdb.computeAllIfChanged(obj) || mdb.getRevision() != revision + 1) {
+      std::cerr << "Moments not computed with a new object" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "testFeatureMomentDatabase is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,232 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compare the feature sets to stacked individual features.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testFeatureSet.cpp
+  \brief Compares the interaction matrix and the error of vpFeaturePointSet,
+  vpFeatureLineSet and vpFeatureDepthSet to the ones of the same number of
+  vpFeaturePoint, vpFeatureLine and vpFeatureDepth.
+*/
+
+#include <cmath>
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpLine.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/visual_features/vpFeatureBuilder.h>
+#include <visp3/visual_features/vpFeatureDepth.h>
+#include <visp3/visual_features/vpFeatureDepthSet.h>
+#include <visp3/visual_features/vpFeatureLine.h>
+#include <visp3/visual_features/vpFeatureLineSet.h>
+#include <visp3/visual_features/vpFeaturePoint.h>
+#include <visp3/visual_features/vpFeaturePointSet.h>
+
+namespace
+{
+bool equal(double a, double b) { return std::fabs(a - b) <= 1e-10 * std::max(1., std::fabs(b)); }
+
+// Compare the row k of a set against row j of an individual feature
+bool compareRows(const vpMatrix &L, unsigned int k, const vpMatrix &L_ref, unsigned int j, const std::string &name)
+{
+  for (unsigned int c = 0; c < 6; c++) {
+    if (!equal(L[k][c], L_ref[j][c])) {
+      std::cerr << name << ": interaction matrices differ at (" << k << ", " << c << ")" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<vpPoint> buildPoints(const vpHomogeneousMatrix &cMo, unsigned int n)
+{
+  std::vector<vpPoint> points(n);
+  for (unsigned int i = 0; i < n; i++) {
+    double a = 2 * M_PI * i / n;
+    points[i].setWorldCoordinates(0.1 * cos(a), 0.1 * sin(a), 0.02 * cos(3 * a));
+    points[i].track(cMo);
+  }
+  return points;
+}
+
+bool testPointSet(const vpHomogeneousMatrix &cMo, const vpHomogeneousMatrix &cdMo, unsigned int n)
+{
+  std::vector<vpPoint> points = buildPoints(cMo, n), points_d = buildPoints(cdMo, n);
+  vpFeaturePointSet s, s_d;
+  vpFeatureBuilder::create(s, points);
+  vpFeatureBuilder::create(s_d, points_d);
+
+  if (s.getDimension() != 2 * n || s.getDimension(vpFeaturePointSet::selectX()) != n ||
+      s.getDimension(vpFeaturePointSet::selectY()) != n) {
+    std::cerr << "Point set: bad dimension" << std::endl;
+    return false;
+  }
+
+  vpMatrix L = s.interaction();
+  vpColVector e = s.error(s_d);
+  vpMatrix Ly = s.interaction(vpFeaturePointSet::selectY());
+  vpColVector ey = s.error(s_d, vpFeaturePointSet::selectY());
+  for (unsigned int i = 0; i < n; i++) {
+    vpFeaturePoint p, p_d;
+    vpFeatureBuilder::create(p, points[i]);
+    vpFeatureBuilder::create(p_d, points_d[i]);
+    vpMatrix L_ref = p.interaction();
+    vpColVector e_ref = p.error(p_d);
+    if (!compareRows(L, i, L_ref, 0, "Point set") || !compareRows(L, n + i, L_ref, 1, "Point set") ||
+        !compareRows(Ly, i, L_ref, 1, "Point set y")) {
+      return false;
+    }
+    if (!equal(e[i], e_ref[0]) || !equal(e[n + i], e_ref[1]) || !equal(ey[i], e_ref[1])) {
+      std::cerr << "Point set: errors differ for point " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool testLineSet(const vpHomogeneousMatrix &cMo, const vpHomogeneousMatrix &cdMo, unsigned int n)
+{
+  std::vector<vpLine> lines(n), lines_d(n);
+  for (unsigned int i = 0; i < n; i++) {
+    double a = M_PI * i / n;
+    double ca = cos(a), sa = sin(a);
+    // Line of direction (ca, sa, 0) passing through (-0.05 sa, 0.05 ca, 0.01 i)
+    lines[i].setWorldCoordinates(0, 0, 1, -0.01 * i, sa, -ca, 0, 0.05);
+    lines_d[i] = lines[i];
+    lines[i].track(cMo);
+    lines_d[i].track(cdMo);
+  }
+
+  vpFeatureLineSet s, s_d;
+  vpFeatureBuilder::create(s, lines);
+  vpFeatureBuilder::create(s_d, lines_d);
+
+  if (s.getDimension() != 2 * n || s.getDimension(vpFeatureLineSet::selectTheta()) != n) {
+    std::cerr << "Line set: bad dimension" << std::endl;
+    return false;
+  }
+
+  vpMatrix L = s.interaction();
+  vpColVector e = s.error(s_d);
+  for (unsigned int i = 0; i < n; i++) {
+    vpFeatureLine l, l_d;
+    vpFeatureBuilder::create(l, lines[i]);
+    vpFeatureBuilder::create(l_d, lines_d[i]);
+    vpMatrix L_ref = l.interaction();
+    vpColVector e_ref = l.error(l_d);
+    if (!compareRows(L, i, L_ref, 0, "Line set") || !compareRows(L, n + i, L_ref, 1, "Line set")) {
+      return false;
+    }
+    if (!equal(e[i], e_ref[0]) || !equal(e[n + i], e_ref[1])) {
+      std::cerr << "Line set: errors differ for line " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool testDepthSet(const vpHomogeneousMatrix &cMo, const vpHomogeneousMatrix &cdMo, unsigned int n)
+{
+  std::vector<vpPoint> points = buildPoints(cMo, n), points_d = buildPoints(cdMo, n);
+  std::vector<double> x(n), y(n), Z(n), logZ(n);
+  for (unsigned int i = 0; i < n; i++) {
+    x[i] = points[i].get_x();
+    y[i] = points[i].get_y();
+    Z[i] = points[i].get_Z();
+    logZ[i] = log(Z[i] / points_d[i].get_Z());
+  }
+
+  vpFeatureDepthSet s, s_d(n);
+  s.buildFrom(x, y, Z, logZ);
+  if (s.getDimension() != n) {
+    std::cerr << "Depth set: bad dimension" << std::endl;
+    return false;
+  }
+
+  vpMatrix L = s.interaction();
+  vpColVector e = s.error(s_d);
+  for (unsigned int i = 0; i < n; i++) {
+    vpFeatureDepth d, d_d;
+    d.buildFrom(x[i], y[i], Z[i], logZ[i]);
+    vpMatrix L_ref = d.interaction();
+    vpColVector e_ref = d.error(d_d);
+    if (!compareRows(L, i, L_ref, 0, "Depth set")) {
+      return false;
+    }
+    if (!equal(e[i], e_ref[0])) {
+      std::cerr << "Depth set: errors differ for point " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    vpHomogeneousMatrix cMo(0.05, -0.02, 0.8, vpMath::rad(10), vpMath::rad(-15), vpMath::rad(30));
+    vpHomogeneousMatrix cdMo(0, 0, 0.6, 0, 0, vpMath::rad(5));
+
+    unsigned int n[3] = {1, 7, 40};
+    for (unsigned int i = 0; i < 3; i++) {
+      if (!testPointSet(cMo, cdMo, n[i]) || !testLineSet(cMo, cdMo, n[i]) || !testDepthSet(cMo, cdMo, n[i])) {
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Sets of different sizes cannot be compared
+    vpFeaturePointSet s(3), s_d(4);
+    bool thrown = false;
+    try {
+      s.error(s_d);
+    } catch (const vpException &) {
+      thrown = true;
+    }
+    if (!thrown) {
+      std::cerr << "Sets of different sizes should not be compared" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "testFeatureSet is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getStringMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
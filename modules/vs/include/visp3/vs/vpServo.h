@@ -440,6 +440,7 @@ error vector is updated after a call of computeError() or computeControlLaw().
     A recommended value is 4.
   */
   void setMu(double mu_) { this->mu = mu_; }
+  void setNormalEquations(bool normal_equations, double lm_damping = 0.);
   //  Choice of the visual servoing control law
   void setServo(const vpServoType &servo_type);
 
@@ -539,6 +540,9 @@ protected:
    */
   void computeProjectionOperators();
 
+  void computeNormalEquations();
+  void computeTaskNormalEquations(const vpMatrix &cJa);
+
 public:
   //! Interaction matrix
   vpMatrix L;
@@ -674,6 +678,17 @@ protected:
   //! A diag matrix used to determine which are the degrees of freedom that
   //! are controlled in the camera frame
   vpMatrix cJc;
+
+  //! If true, the control law is computed from the normal equations
+  bool useNormalEquations;
+  //! Levenberg-Marquardt damping factor used with the normal equations
+  double lmDamping;
+  //! Normal equations matrix \f${\widehat {\bf L}}^\top {\widehat {\bf L}}\f$
+  vpMatrix LtL;
+  //! Normal equations vector \f${\widehat {\bf L}}^\top {\bf e}\f$
+  vpColVector Lte;
+  //! Vector \f${\bf J}_1^\top {\bf e}\f$ used to compute the large projection operator
+  vpColVector J1te;
 };
 
 #endif
@@ -0,0 +1,148 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Stack of prioritized tasks.
+ *
+ *****************************************************************************/
+
+#ifndef vpServoTaskStack_H
+#define vpServoTaskStack_H
+
+/*!
+  \file vpServoTaskStack.h
+  \brief Stack of prioritized tasks solved with one factorization per level
+*/
+
+#include <vector>
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpMatrix.h>
+
+class vpServo;
+
+/*!
+  \class vpServoTaskStack
+  \ingroup group_task
+  \brief Stack of prioritized tasks for redundant robots.
+
+  Each task \e k is given by its Jacobian \f${\bf J}_k\f$ and the task
+  velocity \f$\dot{\bf e}_k\f$ to achieve, typically \f$-\lambda_k {\bf
+  e}_k\f$. The control law is computed recursively, each task being solved in
+  the null space of the tasks of higher priority:
+
+  \f[ \dot{\bf q}_k = \dot{\bf q}_{k-1} + ({\bf J}_k {\bf P}_{k-1})^+
+  (\dot{\bf e}_k - {\bf J}_k \dot{\bf q}_{k-1}) \qquad {\bf P}_k = {\bf
+  P}_{k-1} - ({\bf J}_k {\bf P}_{k-1})^+ {\bf J}_k {\bf P}_{k-1} \f]
+
+  The projectors are never built: the stack keeps an orthonormal basis \f$
+  {\bf Z}_{k} \f$ of the remaining null space, \f$ {\bf P}_k = {\bf Z}_k {\bf
+  Z}_k^\top \f$. The single SVD of the reduced Jacobian \f$ {\bf J}_k {\bf
+  Z}_{k-1} \f$ gives both the pseudo-inverse of the level and the basis of the
+  next one, and each level works on the remaining degrees of freedom only.
+
+  The factorization of a level is kept between two calls to
+  computeControlLaw() as long as its Jacobian and the tasks of higher
+  priority do not change, so that only the task velocities are propagated for
+  constant tasks. When no degree of freedom remains, the tasks of lower
+  priority are ignored.
+
+  \code
+  vpServoTaskStack stack;
+  stack.addTask(J1, -lambda1 * e1); // Highest priority
+  stack.addTask(J2, -lambda2 * e2);
+  while (...) {
+    ...
+    stack.setTask(0, J1, -lambda1 * e1);
+    stack.setTaskVelocity(1, -lambda2 * e2); // J2 is constant
+    vpColVector qdot = stack.computeControlLaw();
+  }
+  \endcode
+*/
+class VISP_EXPORT vpServoTaskStack
+{
+public:
+  vpServoTaskStack();
+
+  unsigned int addTask(const vpMatrix &J, const vpColVector &de);
+  unsigned int addTask(vpServo &task);
+
+  void clear();
+  vpColVector computeControlLaw();
+
+  vpMatrix getNullSpace(unsigned int level) const;
+  //! Return the number of tasks in the stack.
+  unsigned int getNumberOfTasks() const { return (unsigned int)m_levels.size(); }
+  vpMatrix getProjector(unsigned int level) const;
+  unsigned int getRank(unsigned int level) const;
+
+  vpColVector secondaryTask(const vpColVector &de2dt) const;
+
+  /*!
+    Set the threshold used to compute the rank of the projected Jacobians.
+    A singular value lower than \e threshold times the highest singular value
+    is considered as null. The default value is 1e-6, as in vpServo.
+  */
+  void setRankThreshold(double threshold)
+  {
+    m_threshold = threshold;
+    invalidate(0);
+  }
+  void setTask(unsigned int level, const vpMatrix &J, const vpColVector &de);
+  void setTask(unsigned int level, vpServo &task);
+  void setTaskVelocity(unsigned int level, const vpColVector &de);
+
+private:
+  struct vpTaskLevel {
+    vpTaskLevel() : J(), de(), M(), Z(), rank(0), valid(false) {}
+    //! Task Jacobian
+    vpMatrix J;
+    //! Task velocity
+    vpColVector de;
+    //! Pseudo-inverse of the projected Jacobian, expressed in the joint space
+    vpMatrix M;
+    //! Orthonormal basis of the null space remaining after this level
+    vpMatrix Z;
+    //! Rank of the projected Jacobian
+    unsigned int rank;
+    //! True if M and Z are up to date
+    bool valid;
+  };
+
+  void checkLevel(unsigned int level) const;
+  void factorize(unsigned int level);
+  void invalidate(unsigned int level);
+
+  std::vector<vpTaskLevel> m_levels;
+  unsigned int m_dof;
+  double m_threshold;
+};
+
+#endif
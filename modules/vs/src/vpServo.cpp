@@ -72,7 +72,7 @@ vpServo::vpServo()
     interactionMatrixType(DESIRED), inversionType(PSEUDO_INVERSE), cVe(), init_cVe(false), cVf(), init_cVf(false),
     fVe(), init_fVe(false), eJe(), init_eJe(false), fJe(), init_fJe(false), errorComputed(false),
     interactionMatrixComputed(false), dim_task(0), taskWasKilled(false), forceInteractionMatrixComputation(false),
-    WpW(), I_WpW(), P(), sv(), mu(4.), e1_initial(), iscJcIdentity(true), cJc(6, 6)
+    WpW(), I_WpW(), P(), sv(), mu(4.), e1_initial(), iscJcIdentity(true), cJc(6, 6), useNormalEquations(false), lmDamping(0.), LtL(), Lte(), J1te()
 {
   cJc.eye();
 }
@@ -97,7 +97,7 @@ vpServo::vpServo(vpServoType servo_type)
     inversionType(PSEUDO_INVERSE), cVe(), init_cVe(false), cVf(), init_cVf(false), fVe(), init_fVe(false), eJe(),
     init_eJe(false), fJe(), init_fJe(false), errorComputed(false), interactionMatrixComputed(false), dim_task(0),
     taskWasKilled(false), forceInteractionMatrixComputation(false), WpW(), I_WpW(), P(), sv(), mu(4), e1_initial(),
-    iscJcIdentity(true), cJc(6, 6)
+    iscJcIdentity(true), cJc(6, 6), useNormalEquations(false), lmDamping(0.), LtL(), Lte(), J1te()
 {
   cJc.eye();
 }
@@ -170,6 +170,9 @@ void vpServo::init()
 
   forceInteractionMatrixComputation = false;
 
+  useNormalEquations = false;
+  lmDamping = 0.;
+
   rankJ1 = 0;
 }
 
@@ -586,61 +589,44 @@ static void computeInteractionMatrixFromList(const std::list<vpBasicFeature *> &
     throw(vpServoException(vpServoException::noFeatureError, "feature list empty, cannot compute Ls"));
   }
 
-  /* The matrix dimension is not known before the affectation loop.
-   * It thus should be allocated on the flight, in the loop.
-   * The first assumption is that the size has not changed. A double
-   * reallocation (realloc(dim*2)) is done if necessary. In particular,
-   * [log_2(dim)+1] reallocations are done for the first matrix computation.
-   * If the allocated size is too large, a correction is done after the loop.
-   * The algorithmic cost is linear in affectation, logarithmic in allocation
-   * numbers and linear in allocation size.
-   */
-
-  /* First assumption: matrix dimensions have not changed. If 0, they are
-   * initialized to dim 1.*/
-  unsigned int rowL = L.getRows();
-  const unsigned int colL = 6;
-  if (0 == rowL) {
-    rowL = 1;
-    L.resize(rowL, colL);
-  }
-
-  /* vectTmp is used to store the return values of functions get_s() and
-   * error(). */
-  vpMatrix matrixTmp;
-
-  /* The cursor are the number of the next case of the vector array to
-   * be affected. A memory reallocation should be done when cursor
-   * is out of the vector-array range.*/
-  unsigned int cursorL = 0;
-
   std::list<vpBasicFeature *>::const_iterator it;
   std::list<unsigned int>::const_iterator it_select;
 
+  /* The size of L is known from the features dimension. It is only
+   * reallocated when it changes, and each feature writes its rows in place
+   * starting at the cursor. */
+  unsigned int rowL = 0;
   for (it = featureList.begin(), it_select = featureSelectionList.begin(); it != featureList.end(); ++it, ++it_select) {
-    /* Get s. */
-    matrixTmp = (*it)->interaction(*it_select);
-    unsigned int rowMatrixTmp = matrixTmp.getRows();
-    unsigned int colMatrixTmp = matrixTmp.getCols();
-
-    /* Check the matrix L size, and realloc if needed. */
-    while (rowMatrixTmp + cursorL > rowL) {
-      rowL *= 2;
-      L.resize(rowL, colL, false);
-      vpDEBUG_TRACE(15, "Realloc!");
-    }
+    rowL += (*it)->getDimension(*it_select);
+  }
+  if (L.getRows() != rowL || L.getCols() != 6) {
+    L.resize(rowL, 6, false);
+  }
 
-    /* Copy the temporarily matrix into L. */
-    for (unsigned int k = 0; k < rowMatrixTmp; ++k, ++cursorL) {
-      for (unsigned int j = 0; j < colMatrixTmp; ++j) {
-        L[cursorL][j] = matrixTmp[k][j];
+  unsigned int cursorL = 0;
+  for (it = featureList.begin(), it_select = featureSelectionList.begin(); it != featureList.end();
+       ++it, ++it_select) {
+    try {
+      (*it)->fillInteraction(L, cursorL, *it_select);
+    } catch (vpException &e) {
+      if (e.getCode() != vpException::dimensionError) {
+        throw;
+      }
+      /* The feature interaction matrix does not match its dimension. The
+       * rows of the previous features are kept, and the following matrices
+       * are stacked as they come. When the feature did not write its matrix
+       * at the cursor, it is computed again to be stacked. */
+      if (L.getRows() == rowL) {
+        L.resize(cursorL, 6, false);
+        L.stack((*it)->interaction(*it_select));
       }
+      for (++it, ++it_select; it != featureList.end(); ++it, ++it_select) {
+        L.stack((*it)->interaction(*it_select));
+      }
+      return;
     }
+    cursorL += (*it)->getDimension(*it_select);
   }
-
-  L.resize(cursorL, colL, false);
-
-  return;
 }
 
 /*!
@@ -728,98 +714,74 @@ vpColVector vpServo::computeError()
     vpBasicFeature *current_s;
     vpBasicFeature *desired_s;
 
-    /* The vector dimensions are not known before the affectation loop.
-     * They thus should be allocated on the flight, in the loop.
-     * The first assumption is that the size has not changed. A double
-     * reallocation (realloc(dim*2)) is done if necessary. In particular,
-     * [log_2(dim)+1] reallocations are done for the first error computation.
-     * If the allocated size is too large, a correction is done after the
-     * loop. The algorithmic cost is linear in affectation, logarithmic in
-     * allocation numbers and linear in allocation size. No assumptions are
-     * made concerning size of each vector: they are not said equal, and could
-     * be different.
-     */
-
-    /* First assumption: vector dimensions have not changed. If 0, they are
-     * initialized to dim 1.*/
-    unsigned int dimError = error.getRows();
-    unsigned int dimS = s.getRows();
-    unsigned int dimSStar = sStar.getRows();
-    if (0 == dimError) {
-      dimError = 1;
-      error.resize(dimError);
-    }
-    if (0 == dimS) {
-      dimS = 1;
-      s.resize(dimS);
-    }
-    if (0 == dimSStar) {
-      dimSStar = 1;
-      sStar.resize(dimSStar);
-    }
-
-    /* vectTmp is used to store the return values of functions get_s() and
-     * error(). */
-    vpColVector vectTmp;
-
-    /* The cursor are the number of the next case of the vector array to
-     * be affected. A memory reallocation should be done when cursor
-     * is out of the vector-array range.*/
-    unsigned int cursorS = 0;
-    unsigned int cursorSStar = 0;
-    unsigned int cursorError = 0;
-
-    /* For each cell of the list, copy value of s, s_star and error. */
     std::list<vpBasicFeature *>::const_iterator it_s;
     std::list<vpBasicFeature *>::const_iterator it_s_star;
     std::list<unsigned int>::const_iterator it_select;
 
+    /* The vector dimensions are known from the features dimension. They are
+     * only reallocated when they change, and each feature writes its rows in
+     * place starting at the cursor. */
+    unsigned int dimTask = 0;
+    for (it_s = featureList.begin(), it_select = featureSelectionList.begin(); it_s != featureList.end();
+         ++it_s, ++it_select) {
+      dimTask += (*it_s)->getDimension(*it_select);
+    }
+    if (error.getRows() != dimTask)
+      error.resize(dimTask, false);
+    if (s.getRows() != dimTask)
+      s.resize(dimTask, false);
+    if (sStar.getRows() != dimTask)
+      sStar.resize(dimTask, false);
+
+    /* For each cell of the list, copy value of s, s_star and error. */
+    unsigned int cursor = 0;
+    bool errorStacked = false;
     for (it_s = featureList.begin(), it_s_star = desiredFeatureList.begin(), it_select = featureSelectionList.begin();
          it_s != featureList.end(); ++it_s, ++it_s_star, ++it_select) {
       current_s = (*it_s);
       desired_s = (*it_s_star);
       unsigned int select = (*it_select);
 
-      /* Get s, and store it in the s vector. */
-      vectTmp = current_s->get_s(select);
-      unsigned int dimVectTmp = vectTmp.getRows();
-      while (dimVectTmp + cursorS > dimS) {
-        dimS *= 2;
-        s.resize(dimS, false);
-        vpDEBUG_TRACE(15, "Realloc!");
-      }
-      for (unsigned int k = 0; k < dimVectTmp; ++k) {
-        s[cursorS++] = vectTmp[k];
-      }
-
-      /* Get s_star, and store it in the s vector. */
-      vectTmp = desired_s->get_s(select);
-      dimVectTmp = vectTmp.getRows();
-      while (dimVectTmp + cursorSStar > dimSStar) {
-        dimSStar *= 2;
-        sStar.resize(dimSStar, false);
+      unsigned int dim = current_s->getDimension(select);
+      if (desired_s->getDimension(select) != dim) {
+        break;
       }
-      for (unsigned int k = 0; k < dimVectTmp; ++k) {
-        sStar[cursorSStar++] = vectTmp[k];
+      current_s->fill_s(s, cursor, select);
+      desired_s->fill_s(sStar, cursor, select);
+      try {
+        current_s->fillError(*desired_s, error, cursor, select);
+      } catch (vpException &e) {
+        if (e.getCode() != vpException::dimensionError) {
+          throw;
+        }
+        // The feature error was written at the cursor with its own size
+        errorStacked = true;
+        break;
       }
+      cursor += dim;
+    }
 
-      /* Get error, and store it in the s vector. */
-      vectTmp = current_s->error(*desired_s, select);
-      dimVectTmp = vectTmp.getRows();
-      while (dimVectTmp + cursorError > dimError) {
-        dimError *= 2;
-        error.resize(dimError, false);
+    if (it_s != featureList.end()) {
+      /* A feature vector or error does not match the feature dimension. The
+       * rows of the previous features are kept, and the following vectors
+       * are stacked as they come. Each feature error is computed only once
+       * since error() may update the state of the feature. */
+      s.resize(cursor, false);
+      sStar.resize(cursor, false);
+      if (!errorStacked) {
+        error.resize(cursor, false);
       }
-      for (unsigned int k = 0; k < dimVectTmp; ++k) {
-        error[cursorError++] = vectTmp[k];
+      for (; it_s != featureList.end(); ++it_s, ++it_s_star, ++it_select) {
+        s.stack((*it_s)->get_s(*it_select));
+        sStar.stack((*it_s_star)->get_s(*it_select));
+        if (errorStacked) {
+          errorStacked = false;
+        } else {
+          error.stack((*it_s)->error(*(*it_s_star), *it_select));
+        }
       }
     }
 
-    /* If too much memory has been allocated, realloc. */
-    s.resize(cursorS, false);
-    sStar.resize(cursorSStar, false);
-    error.resize(cursorError, false);
-
     /* Final modifications. */
     dim_task = error.getRows();
     errorComputed = true;
@@ -829,6 +791,135 @@ vpColVector vpServo::computeError()
   return error;
 }
 
+/*!
+  Enable or disable the normal equations control law computation.
+
+  When enabled, the control law is computed from the \f$6 \times 6\f$
+  normal equations \f${\widehat {\bf L}}^\top {\widehat {\bf L}}\f$ and
+  \f${\widehat {\bf L}}^\top {\bf e}\f$ rather than from the pseudo inverse
+  of the task Jacobian \f${\bf J}_1\f$. Since
+  \f${\bf J}_1^+ {\bf e} = ({\bf J}_1^\top {\bf J}_1)^+ {\bf J}_1^\top {\bf e}\f$,
+  the resulting velocity is the same, but the pseudo inverse is computed on a
+  matrix whose size only depends on the number of controlled degrees of
+  freedom. This is useful with high dimensional features like
+  vpFeatureLuminance where the interaction matrix has one row per pixel.
+
+  When the interaction matrix is computed from the current features (see
+  setInteractionMatrixType()), the normal equations are accumulated feature
+  by feature using vpBasicFeature::interactionNormalEquations() without
+  building \f${\widehat {\bf L}}\f$, that is then not updated. With the other
+  interaction matrix types, \f${\widehat {\bf L}}\f$ is computed as usual and
+  the normal equations are deduced from it.
+
+  In this mode the task Jacobian \f${\bf J}_1\f$ and its pseudo inverse are not
+  computed, getTaskJacobian() and getTaskJacobianPseudoInverse() return
+  empty matrices. The projection operators used by secondaryTask() remain
+  available.
+
+  \param normal_equations : If true, use the normal equations to compute the
+  control law.
+  \param lm_damping : Levenberg-Marquardt damping factor \f$\mu_{LM}\f$. When
+  greater than zero, the primary task is computed as \f$({\bf H} + \mu_{LM}
+  \mbox{diag}({\bf H}))^{-1} {\bf J}_1^\top {\bf e}\f$ with \f${\bf H} = {\bf
+  J}_1^\top {\bf J}_1\f$. Default value 0 means no damping.
+*/
+void vpServo::setNormalEquations(bool normal_equations, double lm_damping)
+{
+  if (lm_damping < 0.) {
+    throw(vpServoException(vpServoException::servoError, "Levenberg-Marquardt damping factor should be positive"));
+  }
+  useNormalEquations = normal_equations;
+  lmDamping = lm_damping;
+}
+
+/*!
+  Compute the error vector and the normal equations \f${\widehat {\bf
+  L}}^\top {\widehat {\bf L}}\f$ and \f${\widehat {\bf L}}^\top {\bf e}\f$.
+*/
+void vpServo::computeNormalEquations()
+{
+  computeError();
+
+  LtL.resize(6, 6);
+  Lte.resize(6);
+
+  if (interactionMatrixType == CURRENT) {
+    if (featureList.empty()) {
+      vpERROR_TRACE("feature list empty, cannot compute Ls");
+      throw(vpServoException(vpServoException::noFeatureError, "feature list empty, cannot compute Ls"));
+    }
+
+    unsigned int offset = 0;
+    std::list<vpBasicFeature *>::const_iterator it;
+    std::list<unsigned int>::const_iterator it_select;
+
+    for (it = featureList.begin(), it_select = featureSelectionList.begin(); it != featureList.end();
+         ++it, ++it_select) {
+      (*it)->interactionNormalEquations(error, offset, LtL, Lte, *it_select);
+      offset += (*it)->getDimension(*it_select);
+    }
+  } else {
+    computeInteractionMatrix();
+
+    if (L.getRows() != error.getRows() || L.getCols() != 6) {
+      throw(vpServoException(vpServoException::servoError, "Interaction matrix and error vector sizes differ"));
+    }
+    L.AtA(LtL);
+    Lte = L.t() * error;
+  }
+}
+
+/*!
+  Compute the primary task \f${\bf e}_1\f$, the task rank, the task singular
+  values and the projection operator \f$\bf WpW\f$ from the normal equations.
+
+  \param cJa : Matrix that transforms the robot velocities into the camera
+  velocities; \f${^c}{\bf V}_a {^a}{\bf J}_e\f$ possibly premultiplied by the
+  matrix that selects the camera degrees of freedom.
+*/
+void vpServo::computeTaskNormalEquations(const vpMatrix &cJa)
+{
+  computeNormalEquations();
+
+  unsigned int n = cJa.getCols();
+
+  // Since J1 = sign * L * cJa, J1^T J1 = cJa^T L^T L cJa
+  vpMatrix cJat = cJa.t();
+  vpMatrix JtJ = cJat * LtL * cJa;
+  J1te = cJat * Lte;
+  J1te *= signInteractionMatrix;
+
+  // The singular values of J1^T J1 are the squares of those of J1
+  vpMatrix JtJp;
+  rankJ1 = JtJ.pseudoInverse(JtJp, sv, 1e-12);
+  for (unsigned int i = 0; i < sv.getRows(); i++) {
+    sv[i] = sqrt(sv[i]);
+  }
+
+  J1.resize(0, 0);
+  J1p.resize(0, 0);
+
+  if (rankJ1 == n) {
+    WpW.eye(n, n);
+  } else {
+    WpW = JtJp * JtJ;
+  }
+
+  if (inversionType == PSEUDO_INVERSE) {
+    if (lmDamping > 0.) {
+      vpMatrix H = JtJ;
+      for (unsigned int i = 0; i < n; i++) {
+        H[i][i] *= (1. + lmDamping);
+      }
+      e1 = WpW * H.pseudoInverse(1e-12) * J1te;
+    } else {
+      e1 = JtJp * J1te;
+    }
+  } else {
+    e1 = WpW * J1te;
+  }
+}
+
 bool vpServo::testInitialization()
 {
   switch (servoType) {
@@ -981,65 +1072,68 @@ vpColVector vpServo::computeControlLaw()
       break;
     }
 
-    computeInteractionMatrix();
-    computeError();
-
-    // compute  task Jacobian
-    if (iscJcIdentity)
-      J1 = L * cVa * aJe;
-    else
-      J1 = L * cJc * cVa * aJe;
-
-    // handle the eye-in-hand eye-to-hand case
-    J1 *= signInteractionMatrix;
-
-    // pseudo inverse of the task Jacobian
-    // and rank of the task Jacobian
-    // the image of J1 is also computed to allows the computation
-    // of the projection operator
-    vpMatrix imJ1t, imJ1;
-    bool imageComputed = false;
-
-    if (inversionType == PSEUDO_INVERSE) {
-      rankJ1 = J1.pseudoInverse(J1p, sv, 1e-6, imJ1, imJ1t);
-
-      imageComputed = true;
-    } else
-      J1p = J1.t();
-
-    if (rankJ1 == J1.getCols()) {
-      /* if no degrees of freedom remains (rank J1 = ndof)
-       WpW = I, multiply by WpW is useless
-    */
-      e1 = J1p * error; // primary task
-
-      WpW.eye(J1.getCols(), J1.getCols());
+    if (useNormalEquations) {
+      if (iscJcIdentity)
+        computeTaskNormalEquations(cVa * aJe);
+      else
+        computeTaskNormalEquations(cJc * cVa * aJe);
     } else {
-      if (imageComputed != true) {
-        vpMatrix Jtmp;
-        // image of J1 is computed to allows the computation
-        // of the projection operator
-        rankJ1 = J1.pseudoInverse(Jtmp, sv, 1e-6, imJ1, imJ1t);
-      }
-      WpW = imJ1t * imJ1t.t();
+      computeInteractionMatrix();
+      computeError();
+
+      // compute  task Jacobian
+      if (iscJcIdentity)
+        J1 = L * cVa * aJe;
+      else
+        J1 = L * cJc * cVa * aJe;
+
+      // handle the eye-in-hand eye-to-hand case
+      J1 *= signInteractionMatrix;
+
+      // pseudo inverse of the task Jacobian
+      // and rank of the task Jacobian
+      // the image of J1 is also computed to allows the computation
+      // of the projection operator
+      vpMatrix imJ1t, imJ1;
+      bool imageComputed = false;
+
+      if (inversionType == PSEUDO_INVERSE) {
+        rankJ1 = J1.pseudoInverse(J1p, sv, 1e-6, imJ1, imJ1t);
+
+        imageComputed = true;
+      } else
+        J1p = J1.t();
+
+      if (rankJ1 == J1.getCols()) {
+        /* if no degrees of freedom remains (rank J1 = ndof)
+         WpW = I, multiply by WpW is useless
+      */
+        e1 = J1p * error; // primary task
+
+        WpW.eye(J1.getCols(), J1.getCols());
+      } else {
+        if (imageComputed != true) {
+          vpMatrix Jtmp;
+          // image of J1 is computed to allows the computation
+          // of the projection operator
+          rankJ1 = J1.pseudoInverse(Jtmp, sv, 1e-6, imJ1, imJ1t);
+        }
+        WpW = imJ1t * imJ1t.t();
 
 #ifdef DEBUG
-      std::cout << "rank J1: " << rankJ1 << std::endl;
-      imJ1t.print(std::cout, 10, "imJ1t");
-      imJ1.print(std::cout, 10, "imJ1");
+        std::cout << "rank J1: " << rankJ1 << std::endl;
+        imJ1t.print(std::cout, 10, "imJ1t");
+        imJ1.print(std::cout, 10, "imJ1");
 
-      WpW.print(std::cout, 10, "WpW");
-      J1.print(std::cout, 10, "J1");
-      J1p.print(std::cout, 10, "J1p");
+        WpW.print(std::cout, 10, "WpW");
+        J1.print(std::cout, 10, "J1");
+        J1p.print(std::cout, 10, "J1p");
 #endif
-      e1 = WpW * J1p * error;
+        e1 = WpW * J1p * error;
+      }
     }
     e = -lambda(e1) * e1;
 
-    vpMatrix I;
-
-    I.eye(J1.getCols(), J1.getCols());
-
     computeProjectionOperators();
 
   } catch (...) {
@@ -1134,55 +1228,59 @@ vpColVector vpServo::computeControlLaw(double t)
       break;
     }
 
-    computeInteractionMatrix();
-    computeError();
+    if (useNormalEquations) {
+      computeTaskNormalEquations(cVa * aJe);
+    } else {
+      computeInteractionMatrix();
+      computeError();
 
-    // compute  task Jacobian
-    J1 = L * cVa * aJe;
+      // compute  task Jacobian
+      J1 = L * cVa * aJe;
 
-    // handle the eye-in-hand eye-to-hand case
-    J1 *= signInteractionMatrix;
+      // handle the eye-in-hand eye-to-hand case
+      J1 *= signInteractionMatrix;
 
-    // pseudo inverse of the task Jacobian
-    // and rank of the task Jacobian
-    // the image of J1 is also computed to allows the computation
-    // of the projection operator
-    vpMatrix imJ1t, imJ1;
-    bool imageComputed = false;
+      // pseudo inverse of the task Jacobian
+      // and rank of the task Jacobian
+      // the image of J1 is also computed to allows the computation
+      // of the projection operator
+      vpMatrix imJ1t, imJ1;
+      bool imageComputed = false;
 
-    if (inversionType == PSEUDO_INVERSE) {
-      rankJ1 = J1.pseudoInverse(J1p, sv, 1e-6, imJ1, imJ1t);
+      if (inversionType == PSEUDO_INVERSE) {
+        rankJ1 = J1.pseudoInverse(J1p, sv, 1e-6, imJ1, imJ1t);
 
-      imageComputed = true;
-    } else
-      J1p = J1.t();
+        imageComputed = true;
+      } else
+        J1p = J1.t();
 
-    if (rankJ1 == J1.getCols()) {
-      /* if no degrees of freedom remains (rank J1 = ndof)
-       WpW = I, multiply by WpW is useless
-    */
-      e1 = J1p * error; // primary task
+      if (rankJ1 == J1.getCols()) {
+        /* if no degrees of freedom remains (rank J1 = ndof)
+         WpW = I, multiply by WpW is useless
+      */
+        e1 = J1p * error; // primary task
 
-      WpW.eye(J1.getCols(), J1.getCols());
-    } else {
-      if (imageComputed != true) {
-        vpMatrix Jtmp;
-        // image of J1 is computed to allows the computation
-        // of the projection operator
-        rankJ1 = J1.pseudoInverse(Jtmp, sv, 1e-6, imJ1, imJ1t);
-      }
-      WpW = imJ1t * imJ1t.t();
+        WpW.eye(J1.getCols(), J1.getCols());
+      } else {
+        if (imageComputed != true) {
+          vpMatrix Jtmp;
+          // image of J1 is computed to allows the computation
+          // of the projection operator
+          rankJ1 = J1.pseudoInverse(Jtmp, sv, 1e-6, imJ1, imJ1t);
+        }
+        WpW = imJ1t * imJ1t.t();
 
 #ifdef DEBUG
-      std::cout << "rank J1 " << rankJ1 << std::endl;
-      std::cout << "imJ1t" << std::endl << imJ1t;
-      std::cout << "imJ1" << std::endl << imJ1;
+        std::cout << "rank J1 " << rankJ1 << std::endl;
+        std::cout << "imJ1t" << std::endl << imJ1t;
+        std::cout << "imJ1" << std::endl << imJ1;
 
-      std::cout << "WpW" << std::endl << WpW;
-      std::cout << "J1" << std::endl << J1;
-      std::cout << "J1p" << std::endl << J1p;
+        std::cout << "WpW" << std::endl << WpW;
+        std::cout << "J1" << std::endl << J1;
+        std::cout << "J1p" << std::endl << J1p;
 #endif
-      e1 = WpW * J1p * error;
+        e1 = WpW * J1p * error;
+      }
     }
 
     // memorize the initial e1 value if the function is called the first time
@@ -1197,10 +1295,6 @@ vpColVector vpServo::computeControlLaw(double t)
 
     e = -lambda(e1) * e1 + lambda(e1) * e1_initial * exp(-mu * t);
 
-    vpMatrix I;
-
-    I.eye(J1.getCols(), J1.getCols());
-
     computeProjectionOperators();
   } catch (...) {
     throw;
@@ -1294,55 +1388,59 @@ vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
       break;
     }
 
-    computeInteractionMatrix();
-    computeError();
+    if (useNormalEquations) {
+      computeTaskNormalEquations(cVa * aJe);
+    } else {
+      computeInteractionMatrix();
+      computeError();
 
-    // compute  task Jacobian
-    J1 = L * cVa * aJe;
+      // compute  task Jacobian
+      J1 = L * cVa * aJe;
 
-    // handle the eye-in-hand eye-to-hand case
-    J1 *= signInteractionMatrix;
+      // handle the eye-in-hand eye-to-hand case
+      J1 *= signInteractionMatrix;
 
-    // pseudo inverse of the task Jacobian
-    // and rank of the task Jacobian
-    // the image of J1 is also computed to allows the computation
-    // of the projection operator
-    vpMatrix imJ1t, imJ1;
-    bool imageComputed = false;
+      // pseudo inverse of the task Jacobian
+      // and rank of the task Jacobian
+      // the image of J1 is also computed to allows the computation
+      // of the projection operator
+      vpMatrix imJ1t, imJ1;
+      bool imageComputed = false;
 
-    if (inversionType == PSEUDO_INVERSE) {
-      rankJ1 = J1.pseudoInverse(J1p, sv, 1e-6, imJ1, imJ1t);
+      if (inversionType == PSEUDO_INVERSE) {
+        rankJ1 = J1.pseudoInverse(J1p, sv, 1e-6, imJ1, imJ1t);
 
-      imageComputed = true;
-    } else
-      J1p = J1.t();
+        imageComputed = true;
+      } else
+        J1p = J1.t();
 
-    if (rankJ1 == J1.getCols()) {
-      /* if no degrees of freedom remains (rank J1 = ndof)
-       WpW = I, multiply by WpW is useless
-    */
-      e1 = J1p * error; // primary task
+      if (rankJ1 == J1.getCols()) {
+        /* if no degrees of freedom remains (rank J1 = ndof)
+         WpW = I, multiply by WpW is useless
+      */
+        e1 = J1p * error; // primary task
 
-      WpW.eye(J1.getCols(), J1.getCols());
-    } else {
-      if (imageComputed != true) {
-        vpMatrix Jtmp;
-        // image of J1 is computed to allows the computation
-        // of the projection operator
-        rankJ1 = J1.pseudoInverse(Jtmp, sv, 1e-6, imJ1, imJ1t);
-      }
-      WpW = imJ1t * imJ1t.t();
+        WpW.eye(J1.getCols(), J1.getCols());
+      } else {
+        if (imageComputed != true) {
+          vpMatrix Jtmp;
+          // image of J1 is computed to allows the computation
+          // of the projection operator
+          rankJ1 = J1.pseudoInverse(Jtmp, sv, 1e-6, imJ1, imJ1t);
+        }
+        WpW = imJ1t * imJ1t.t();
 
 #ifdef DEBUG
-      std::cout << "rank J1 " << rankJ1 << std::endl;
-      std::cout << "imJ1t" << std::endl << imJ1t;
-      std::cout << "imJ1" << std::endl << imJ1;
+        std::cout << "rank J1 " << rankJ1 << std::endl;
+        std::cout << "imJ1t" << std::endl << imJ1t;
+        std::cout << "imJ1" << std::endl << imJ1;
 
-      std::cout << "WpW" << std::endl << WpW;
-      std::cout << "J1" << std::endl << J1;
-      std::cout << "J1p" << std::endl << J1p;
+        std::cout << "WpW" << std::endl << WpW;
+        std::cout << "J1" << std::endl << J1;
+        std::cout << "J1p" << std::endl << J1p;
 #endif
-      e1 = WpW * J1p * error;
+        e1 = WpW * J1p * error;
+      }
     }
 
     // memorize the initial e1 value if the function is called the first time
@@ -1357,10 +1455,6 @@ vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
 
     e = -lambda(e1) * e1 + (e_dot_init + lambda(e1) * e1_initial) * exp(-mu * t);
 
-    vpMatrix I;
-
-    I.eye(J1.getCols(), J1.getCols());
-
     computeProjectionOperators();
   } catch (...) {
     throw;
@@ -1373,14 +1467,9 @@ vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
 void vpServo::computeProjectionOperators()
 {
   // Initialization
-  unsigned int n = J1.getCols();
-  P.resize(n, n);
-
-  vpMatrix I;
-  I.eye(n);
-
-  // Compute classical projection operator
-  I_WpW = (I - WpW);
+  unsigned int n = WpW.getCols();
+  P.resize(n, n, false);
+  I_WpW.resize(n, n, false);
 
   // Compute gain depending by the task error to ensure a smooth change
   // between the operators.
@@ -1396,17 +1485,22 @@ void vpServo::computeProjectionOperators()
   else
     sig = 0.0;
 
-  vpMatrix J1t = J1.transpose();
-
-  double pp = (error.t() * (J1 * J1t) * error);
-
-  vpMatrix ee_t(n, n);
-  ee_t = error * error.t();
+  // J1^T e is already available when the normal equations are used
+  if (!useNormalEquations) {
+    J1te = J1.t() * error;
+  }
 
-  vpMatrix P_norm_e(n, n);
-  P_norm_e = I - (1.0 / pp) * J1t * ee_t * J1;
+  double pp = J1te.sumSquare();
 
-  P = sig * P_norm_e + (1 - sig) * I_WpW;
+  // Compute classical projection operator I - WpW and the large projection
+  // operator sig * (I - J1te J1te^T / pp) + (1 - sig) * (I - WpW) in one pass
+  for (unsigned int i = 0; i < n; i++) {
+    for (unsigned int j = 0; j < n; j++) {
+      double delta = (i == j) ? 1.0 : 0.0;
+      I_WpW[i][j] = delta - WpW[i][j];
+      P[i][j] = sig * (delta - J1te[i] * J1te[j] / pp) + (1 - sig) * I_WpW[i][j];
+    }
+  }
 
   return;
 }
@@ -1487,7 +1581,7 @@ vpColVector vpServo::secondaryTask(const vpColVector &de2dt, const bool &useLarg
   vpColVector sec;
 
   if (!useLargeProjectionOperator) {
-    if (rankJ1 == J1.getCols()) {
+    if (rankJ1 == WpW.getCols()) {
       vpERROR_TRACE("no degree of freedom is free, cannot use secondary task");
       throw(vpServoException(vpServoException::noDofFree, "no degree of freedom is free, cannot use secondary task"));
     } else {
@@ -1592,7 +1686,7 @@ vpColVector vpServo::secondaryTask(const vpColVector &e2, const vpColVector &de2
   vpColVector sec;
 
   if (!useLargeProjectionOperator) {
-    if (rankJ1 == J1.getCols()) {
+    if (rankJ1 == WpW.getCols()) {
       vpERROR_TRACE("no degree of freedom is free, cannot use secondary task");
       throw(vpServoException(vpServoException::noDofFree, "no degree of freedom is free, cannot use secondary task"));
     } else {
@@ -1669,7 +1763,7 @@ vpColVector vpServo::secondaryTaskJointLimitAvoidance(const vpColVector &q, cons
                                                       const double &rho, const double &rho1,
                                                       const double &lambda_tune) const
 {
-  unsigned int const n = J1.getCols();
+  unsigned int const n = WpW.getCols();
 
   if (qmin.size() != n || qmax.size() != n) {
     std::stringstream msg;
@@ -1695,8 +1789,9 @@ vpColVector vpServo::secondaryTaskJointLimitAvoidance(const vpColVector &q, cons
   vpColVector q_l1_min(n);
   vpColVector q_l1_max(n);
 
-  // Computation of gi ([nx1] vector) and lambda_l ([nx1] vector)
-  vpMatrix g(n, n);
+  // Computation of gi ([nx1] vector) and lambda_l ([nx1] vector). Since gi
+  // only has one non null component, only its sign is stored
+  vpColVector g(n);
   vpColVector q2_i(n);
 
   for (unsigned int i = 0; i < n; i++) {
@@ -1707,11 +1802,11 @@ vpColVector vpServo::secondaryTaskJointLimitAvoidance(const vpColVector &q, cons
     q_l1_max[i] = q_l0_max[i] + rho * rho1 * (qmax[i] - qmin[i]);
 
     if (q[i] < q_l0_min[i])
-      g[i][i] = -1;
+      g[i] = -1;
     else if (q[i] > q_l0_max[i])
-      g[i][i] = 1;
+      g[i] = 1;
     else
-      g[i][i] = 0;
+      g[i] = 0;
   }
 
   for (unsigned int i = 0; i < n; i++) {
@@ -1719,8 +1814,10 @@ vpColVector vpServo::secondaryTaskJointLimitAvoidance(const vpColVector &q, cons
       q2_i = 0 * q2_i;
 
     else {
+      // P gi is the column i of P times the sign of gi
       vpColVector Pg_i(n);
-      Pg_i = (P * g.getCol(i));
+      for (unsigned int j = 0; j < n; j++)
+        Pg_i[j] = g[i] * P[j][i];
       double b = (vpMath::abs(dq[i])) / (vpMath::abs(Pg_i[i]));
 
       if (b < 1.) // If the ratio b is big we don't activate the joint
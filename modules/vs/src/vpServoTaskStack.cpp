@@ -0,0 +1,353 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Stack of prioritized tasks.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpServoTaskStack.cpp
+  \brief Stack of prioritized tasks solved with one factorization per level
+*/
+
+#include <algorithm>
+
+#include <visp3/vs/vpServo.h>
+#include <visp3/vs/vpServoException.h>
+#include <visp3/vs/vpServoTaskStack.h>
+
+/*!
+  Default constructor that builds an empty stack.
+*/
+vpServoTaskStack::vpServoTaskStack() : m_levels(), m_dof(0), m_threshold(1e-6) {}
+
+/*!
+  Add a task with a lower priority than all the tasks already in the stack.
+
+  \param J : Task Jacobian. All the tasks must have the same number of
+  columns, that is the number of degrees of freedom.
+  \param de : Task velocity \f$\dot{\bf e}\f$ to achieve.
+
+  \return The priority level of the task, 0 being the highest priority.
+*/
+unsigned int vpServoTaskStack::addTask(const vpMatrix &J, const vpColVector &de)
+{
+  m_levels.push_back(vpTaskLevel());
+  unsigned int level = (unsigned int)m_levels.size() - 1;
+  try {
+    setTask(level, J, de);
+  } catch (...) {
+    m_levels.pop_back();
+    throw;
+  }
+  return level;
+}
+
+/*!
+  Add a visual servo task with a lower priority than all the tasks already in
+  the stack. See setTask(unsigned int, vpServo &).
+
+  \return The priority level of the task, 0 being the highest priority.
+*/
+unsigned int vpServoTaskStack::addTask(vpServo &task)
+{
+  m_levels.push_back(vpTaskLevel());
+  unsigned int level = (unsigned int)m_levels.size() - 1;
+  try {
+    setTask(level, task);
+  } catch (...) {
+    m_levels.pop_back();
+    throw;
+  }
+  return level;
+}
+
+/*!
+  Remove all the tasks.
+*/
+void vpServoTaskStack::clear()
+{
+  m_levels.clear();
+  m_dof = 0;
+}
+
+void vpServoTaskStack::checkLevel(unsigned int level) const
+{
+  if (level >= m_levels.size()) {
+    throw(vpServoException(vpServoException::dimensionError, "Task level %d out of range [0, %d[", level,
+                           (int)m_levels.size()));
+  }
+}
+
+void vpServoTaskStack::invalidate(unsigned int level)
+{
+  for (size_t k = level; k < m_levels.size(); k++)
+    m_levels[k].valid = false;
+}
+
+/*!
+  Update the Jacobian and the velocity of a task. The factorization of the
+  level and of the levels of lower priority is only recomputed if the
+  Jacobian changed.
+
+  \param level : Priority level of the task.
+  \param J : Task Jacobian.
+  \param de : Task velocity \f$\dot{\bf e}\f$ to achieve.
+
+  \exception vpServoException::dimensionError : If the level does not exist,
+  if the number of columns of \e J differs from the one of the other tasks or
+  if the size of \e de differs from the number of rows of \e J.
+*/
+void vpServoTaskStack::setTask(unsigned int level, const vpMatrix &J, const vpColVector &de)
+{
+  checkLevel(level);
+  if (J.getRows() != de.getRows()) {
+    throw(vpServoException(vpServoException::dimensionError, "Task Jacobian (%dx%d) and velocity (%d) mismatch",
+                           J.getRows(), J.getCols(), de.getRows()));
+  }
+  if (m_levels.size() == 1)
+    m_dof = J.getCols();
+  if (J.getCols() != m_dof) {
+    throw(vpServoException(vpServoException::dimensionError, "Task Jacobian has %d columns instead of %d",
+                           J.getCols(), m_dof));
+  }
+
+  vpTaskLevel &t = m_levels[level];
+  bool changed = (t.J.getRows() != J.getRows() || t.J.getCols() != J.getCols());
+  for (unsigned int i = 0; i < J.size() && !changed; i++)
+    changed = (t.J.data[i] != J.data[i]);
+
+  if (changed) {
+    t.J = J;
+    invalidate(level);
+  }
+  t.de = de;
+}
+
+/*!
+  Update a task from a visual servo task. vpServo::computeControlLaw() is
+  called to update the task Jacobian \f${\bf J}_1\f$ and the error \f${\bf
+  e}\f$, and the task velocity is set to \f$-\lambda {\bf e}\f$ where the gain
+  \f$\lambda\f$ is computed as in vpServo.
+
+  \param level : Priority level of the task.
+  \param task : Visual servo task. It has to be fully initialized, and the
+  control law has to be computed from the task Jacobian, that is without
+  vpServo::setNormalEquations().
+*/
+void vpServoTaskStack::setTask(unsigned int level, vpServo &task)
+{
+  task.computeControlLaw();
+  setTask(level, task.J1, -task.lambda(task.e1) * task.error);
+}
+
+/*!
+  Update the velocity of a task whose Jacobian did not change.
+
+  \param level : Priority level of the task.
+  \param de : Task velocity \f$\dot{\bf e}\f$ to achieve.
+*/
+void vpServoTaskStack::setTaskVelocity(unsigned int level, const vpColVector &de)
+{
+  checkLevel(level);
+  if (de.getRows() != m_levels[level].J.getRows()) {
+    throw(vpServoException(vpServoException::dimensionError, "Task velocity has %d rows instead of %d",
+                           de.getRows(), m_levels[level].J.getRows()));
+  }
+  m_levels[level].de = de;
+}
+
+/*
+  Compute the pseudo-inverse of the projected Jacobian of a level and the
+  null space basis remaining after it, from one SVD of the Jacobian reduced to
+  the null space of the previous level.
+*/
+void vpServoTaskStack::factorize(unsigned int level)
+{
+  vpTaskLevel &t = m_levels[level];
+  const unsigned int n = m_dof;
+  const unsigned int m = t.J.getRows();
+  const vpMatrix *Zin = (level > 0) ? &m_levels[level - 1].Z : NULL;
+  const unsigned int r = Zin ? Zin->getCols() : n;
+
+  t.M.resize(n, m);
+  t.valid = true;
+  if (r == 0) {
+    t.Z.resize(n, 0);
+    t.rank = 0;
+    return;
+  }
+
+  // Reduced Jacobian A = J Z padded with null rows to get the full V with
+  // the SVD, including the basis of the null space
+  vpMatrix U(std::max(m, r), r);
+  if (Zin) {
+    for (unsigned int i = 0; i < m; i++) {
+      const double *Ji = t.J[i];
+      for (unsigned int j = 0; j < r; j++) {
+        double a = 0;
+        for (unsigned int c = 0; c < n; c++)
+          a += Ji[c] * (*Zin)[c][j];
+        U[i][j] = a;
+      }
+    }
+  } else {
+    for (unsigned int i = 0; i < m; i++)
+      for (unsigned int j = 0; j < r; j++)
+        U[i][j] = t.J[i][j];
+  }
+
+  vpColVector w;
+  vpMatrix V;
+  U.svd(w, V);
+
+  // Singular values are in decreasing order
+  unsigned int rank = 0;
+  double maxsv = w.size() ? w[0] : 0.;
+  while (rank < r && rank < m && w[rank] > maxsv * m_threshold && w[rank] > 0)
+    rank++;
+  t.rank = rank;
+
+  // Z V is the basis of the reduced problem expressed in the joint space
+  vpMatrix ZV;
+  if (Zin)
+    ZV = (*Zin) * V;
+  else
+    ZV = V;
+
+  // M = Z V_r diag(1/w) U_r^T
+  for (unsigned int i = 0; i < n; i++) {
+    for (unsigned int j = 0; j < m; j++) {
+      double a = 0;
+      for (unsigned int k = 0; k < rank; k++)
+        a += ZV[i][k] * U[j][k] / w[k];
+      t.M[i][j] = a;
+    }
+  }
+
+  t.Z.resize(n, r - rank, false);
+  for (unsigned int i = 0; i < n; i++)
+    for (unsigned int j = rank; j < r; j++)
+      t.Z[i][j - rank] = ZV[i][j];
+}
+
+/*!
+  Compute the joint velocity that achieves the tasks in priority order.
+
+  \return The joint velocity \f$\dot{\bf q}\f$.
+*/
+vpColVector vpServoTaskStack::computeControlLaw()
+{
+  vpColVector qdot(m_dof);
+  for (unsigned int k = 0; k < m_levels.size(); k++) {
+    vpTaskLevel &t = m_levels[k];
+    if (!t.valid) {
+      factorize(k);
+      invalidate(k + 1);
+    }
+    if (t.rank == 0)
+      continue;
+
+    // qdot += M (de - J qdot)
+    vpColVector r = t.de;
+    if (k > 0)
+      r -= t.J * qdot;
+    qdot += t.M * r;
+  }
+  return qdot;
+}
+
+/*!
+  Return an orthonormal basis of the null space remaining after a level, as
+  a matrix with one column per remaining degree of freedom. It is updated by
+  computeControlLaw().
+
+  \param level : Priority level of the task.
+*/
+vpMatrix vpServoTaskStack::getNullSpace(unsigned int level) const
+{
+  checkLevel(level);
+  return m_levels[level].Z;
+}
+
+/*!
+  Return the projector \f$ {\bf P}_k \f$ onto the null space of the tasks up
+  to a level, that is \f$ {\bf I - W^+W} \f$ for the first level. It is
+  updated by computeControlLaw().
+
+  \param level : Priority level of the task.
+*/
+vpMatrix vpServoTaskStack::getProjector(unsigned int level) const
+{
+  checkLevel(level);
+  const vpMatrix &Z = m_levels[level].Z;
+  if (Z.getCols() == 0)
+    return vpMatrix(m_dof, m_dof);
+  return Z * Z.t();
+}
+
+/*!
+  Return the rank of the Jacobian of a level projected in the null space of
+  the tasks of higher priority. It is updated by computeControlLaw().
+
+  \param level : Priority level of the task.
+*/
+unsigned int vpServoTaskStack::getRank(unsigned int level) const
+{
+  checkLevel(level);
+  return m_levels[level].rank;
+}
+
+/*!
+  Project a secondary task in the null space of all the tasks of the stack,
+  as vpServo::secondaryTask() does for a single task.
+
+  \param de2dt : Value of \f$\frac{\partial {\bf e_2}}{\partial t}\f$.
+
+  \return The projected secondary task vector.
+
+  \exception vpServoException::noDofFree : If no degree of freedom remains.
+*/
+vpColVector vpServoTaskStack::secondaryTask(const vpColVector &de2dt) const
+{
+  if (m_levels.empty())
+    return de2dt;
+
+  const vpMatrix &Z = m_levels.back().Z;
+  if (Z.getCols() == 0) {
+    throw(vpServoException(vpServoException::noDofFree, "no degree of freedom is free, cannot use secondary task"));
+  }
+  if (de2dt.getRows() != m_dof) {
+    throw(vpServoException(vpServoException::dimensionError, "Secondary task has %d rows instead of %d",
+                           de2dt.getRows(), m_dof));
+  }
+  return Z * (Z.t() * de2dt);
+}
@@ -0,0 +1,196 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Build a task with a feature whose interaction matrix and error sizes differ
+ * from its declared dimension.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpMath.h>
+#include <visp3/visual_features/vpBasicFeature.h>
+#include <visp3/visual_features/vpFeaturePoint.h>
+#include <visp3/visual_features/vpGenericFeature.h>
+#include <visp3/vs/vpServo.h>
+
+#include <iostream>
+
+/*!
+  \example testServoFeatureDimension.cpp
+
+  Check that vpServo stacks the interaction matrices and errors returned by a
+  user feature whose getDimension() does not match the size of what
+  interaction() and error() return, and that the error of each feature is
+  computed only once.
+*/
+
+namespace
+{
+// Feature with two values that only reports a dimension of one
+class vpFeatureMismatch : public vpBasicFeature
+{
+public:
+  vpFeatureMismatch(double s0, double s1) : nbErrors(0)
+  {
+    init();
+    s[0] = s0;
+    s[1] = s1;
+  }
+  void init()
+  {
+    dim_s = 2;
+    nbParameters = 0;
+    s.resize(dim_s);
+  }
+  unsigned int getDimension(const unsigned int) const { return 1; }
+  vpMatrix interaction(const unsigned int)
+  {
+    vpMatrix L(2, 6);
+    for (unsigned int i = 0; i < 2; i++)
+      for (unsigned int j = 0; j < 6; j++)
+        L[i][j] = i + 0.1 * j;
+    return L;
+  }
+  vpColVector error(const vpBasicFeature &s_star, const unsigned int)
+  {
+    nbErrors++;
+    vpColVector e(2);
+    for (unsigned int i = 0; i < 2; i++)
+      e[i] = s[i] - s_star[i];
+    return e;
+  }
+  vpColVector get_s(unsigned int) const { return s; }
+  void display(const vpCameraParameters &, const vpImage<unsigned char> &, const vpColor &, unsigned int) const {}
+  void display(const vpCameraParameters &, const vpImage<vpRGBa> &, const vpColor &, unsigned int) const {}
+  void print(const unsigned int) const {}
+  vpBasicFeature *duplicate() const { return new vpFeatureMismatch(s[0], s[1]); }
+
+  unsigned int nbErrors;
+};
+}
+
+int main()
+{
+  try {
+    vpFeatureMismatch f(0.3, -0.2), fd(0., 0.);
+    vpFeaturePoint p, pd;
+    p.buildFrom(0.1, 0.2, 1.);
+    pd.buildFrom(0., 0., 1.);
+
+    vpServo task;
+    task.setServo(vpServo::EYEINHAND_CAMERA);
+    task.setInteractionMatrixType(vpServo::CURRENT);
+    task.setLambda(0.5);
+    task.addFeature(f, fd);
+    task.addFeature(p, pd);
+
+    // Computed twice to go through the preallocated matrices
+    for (unsigned int iter = 0; iter < 2; iter++) {
+      task.computeControlLaw();
+
+      vpMatrix L_ref = f.interaction(vpBasicFeature::FEATURE_ALL);
+      L_ref.stack(p.interaction());
+      vpColVector e_ref = f.error(fd, vpBasicFeature::FEATURE_ALL);
+      e_ref.stack(p.error(pd));
+
+      vpMatrix L = task.getInteractionMatrix();
+      vpColVector e = task.getError();
+      if (L.getRows() != 4 || e.getRows() != 4 || task.getTaskSingularValues().size() == 0) {
+        std::cerr << "Bad task dimension: " << L.getRows() << " x " << e.getRows() << std::endl;
+        return EXIT_FAILURE;
+      }
+      for (unsigned int i = 0; i < 4; i++) {
+        if (!vpMath::equal(e[i], e_ref[i], 1e-12)) {
+          std::cerr << "Bad error" << std::endl;
+          return EXIT_FAILURE;
+        }
+        for (unsigned int j = 0; j < 6; j++) {
+          if (!vpMath::equal(L[i][j], L_ref[i][j], 1e-12)) {
+            std::cerr << "Bad interaction matrix" << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+    // A generic feature whose error is set with setError() only accepts one
+    // error computation, so the features placed before the mismatching one
+    // must not be computed again
+    vpGenericFeature g(2), gd(2);
+    g.set_s(0.1, 0.2);
+    gd.set_s(0., 0.);
+    vpMatrix Lg(2, 6);
+    for (unsigned int i = 0; i < 2; i++)
+      Lg[i][i] = 1.;
+    g.setInteractionMatrix(Lg);
+
+    vpServo task2;
+    task2.setServo(vpServo::EYEINHAND_CAMERA);
+    task2.setInteractionMatrixType(vpServo::CURRENT);
+    task2.setLambda(0.5);
+    task2.addFeature(g, gd);
+    task2.addFeature(f, fd);
+    task2.addFeature(p, pd);
+
+    for (unsigned int iter = 0; iter < 2; iter++) {
+      vpColVector e_g(2);
+      e_g[0] = 0.5 + iter;
+      e_g[1] = -0.5;
+      g.setError(e_g);
+      f.nbErrors = 0;
+      task2.computeControlLaw();
+      if (f.nbErrors != 1) {
+        std::cerr << "The mismatching feature error is computed " << f.nbErrors << " times" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      vpColVector e = task2.getError();
+      vpColVector e_ref = e_g;
+      e_ref.stack(f.error(fd, vpBasicFeature::FEATURE_ALL));
+      e_ref.stack(p.error(pd));
+      if (e.getRows() != 6 || task2.getInteractionMatrix().getRows() != 6) {
+        std::cerr << "Bad task dimension with a generic feature: " << e.getRows() << std::endl;
+        return EXIT_FAILURE;
+      }
+      for (unsigned int i = 0; i < 6; i++) {
+        if (!vpMath::equal(e[i], e_ref[i], 1e-12)) {
+          std::cerr << "Bad error with a generic feature" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    std::cout << "testServoFeatureDimension is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,198 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compare the control law computed with the normal equations to the one
+ * computed with the pseudo inverse of the task Jacobian.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/visual_features/vpFeatureBuilder.h>
+#include <visp3/visual_features/vpFeatureLuminance.h>
+#include <visp3/visual_features/vpFeaturePoint.h>
+#include <visp3/vs/vpServo.h>
+
+#include <iostream>
+
+/*!
+  \example testServoNormalEquations.cpp
+
+  Check that vpServo::setNormalEquations() leads to the same velocities as
+  the pseudo inverse of the task Jacobian, with point and luminance features.
+*/
+
+namespace
+{
+void buildImage(vpImage<unsigned char> &I, double shift)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      double val = 127.5 + 60. * sin((j + shift) / 7.) * cos((i - shift) / 9.) + 60. * sin((i + j) / 23.);
+      I[i][j] = (unsigned char)vpMath::round(val);
+    }
+  }
+}
+
+bool compare(const vpColVector &v1, const vpColVector &v2, double threshold)
+{
+  if (v1.getRows() != v2.getRows())
+    return false;
+  for (unsigned int i = 0; i < v1.getRows(); i++) {
+    if (std::fabs(v1[i] - v2[i]) > threshold * std::max(1., std::fabs(v1[i])))
+      return false;
+  }
+  return true;
+}
+
+bool testPoints(vpServo::vpServoIteractionMatrixType type)
+{
+  vpHomogeneousMatrix cdMo(0, 0, 0.75, 0, 0, 0);
+  vpHomogeneousMatrix cMo(0.15, -0.1, 1., vpMath::rad(10), vpMath::rad(-10), vpMath::rad(50));
+
+  vpPoint point[4];
+  point[0].setWorldCoordinates(-0.1, -0.1, 0);
+  point[1].setWorldCoordinates(0.1, -0.1, 0);
+  point[2].setWorldCoordinates(0.1, 0.1, 0);
+  point[3].setWorldCoordinates(-0.1, 0.1, 0);
+
+  vpFeaturePoint p[4], pd[4];
+  vpServo task, task_ne;
+  task.setServo(vpServo::EYEINHAND_CAMERA);
+  task.setInteractionMatrixType(type);
+  task.setLambda(0.5);
+  task_ne.setServo(vpServo::EYEINHAND_CAMERA);
+  task_ne.setInteractionMatrixType(type);
+  task_ne.setLambda(0.5);
+  task_ne.setNormalEquations(true);
+
+  for (unsigned int i = 0; i < 4; i++) {
+    point[i].track(cdMo);
+    vpFeatureBuilder::create(pd[i], point[i]);
+    point[i].track(cMo);
+    vpFeatureBuilder::create(p[i], point[i]);
+    task.addFeature(p[i], pd[i]);
+    task_ne.addFeature(p[i], pd[i]);
+  }
+
+  vpColVector v = task.computeControlLaw();
+  vpColVector v_ne = task_ne.computeControlLaw();
+
+  // Secondary task using the large projection operator
+  vpColVector de2dt(6);
+  de2dt[2] = 0.1;
+  vpColVector sec = task.secondaryTask(de2dt, true);
+  vpColVector sec_ne = task_ne.secondaryTask(de2dt, true);
+
+  std::cout << "Points, v: " << v.t() << std::endl;
+  std::cout << "Points, v normal equations: " << v_ne.t() << std::endl;
+
+  bool ok = compare(v, v_ne, 1e-6) && compare(sec, sec_ne, 1e-6) && task.getTaskRank() == task_ne.getTaskRank() &&
+            compare(task.getTaskSingularValues(), task_ne.getTaskSingularValues(), 1e-6);
+
+  task.kill();
+  task_ne.kill();
+  return ok;
+}
+
+bool testLuminance()
+{
+  unsigned int h = 120, w = 160;
+  vpImage<unsigned char> I(h, w), Id(h, w);
+  buildImage(I, 2.);
+  buildImage(Id, 0.);
+
+  vpCameraParameters cam(200., 200., w / 2., h / 2.);
+
+  vpFeatureLuminance sI, sId;
+  sI.init(h, w, 0.8);
+  sI.setCameraParameters(cam);
+  sId.init(h, w, 0.8);
+  sId.setCameraParameters(cam);
+  sI.buildFrom(I);
+  sId.buildFrom(Id);
+
+  vpServo task, task_ne;
+  task.setServo(vpServo::EYEINHAND_CAMERA);
+  task.setInteractionMatrixType(vpServo::CURRENT);
+  task.setLambda(30);
+  task.addFeature(sI, sId);
+
+  task_ne.setServo(vpServo::EYEINHAND_CAMERA);
+  task_ne.setInteractionMatrixType(vpServo::CURRENT);
+  task_ne.setLambda(30);
+  task_ne.setNormalEquations(true);
+  task_ne.addFeature(sI, sId);
+
+  vpColVector v = task.computeControlLaw();
+  vpColVector v_ne = task_ne.computeControlLaw();
+
+  std::cout << "Luminance, v: " << v.t() << std::endl;
+  std::cout << "Luminance, v normal equations: " << v_ne.t() << std::endl;
+
+  bool ok = compare(v, v_ne, 1e-6);
+
+  // A negligible Levenberg-Marquardt damping should not modify the velocity
+  task_ne.setNormalEquations(true, 1e-12);
+  vpColVector v_lm = task_ne.computeControlLaw();
+  std::cout << "Luminance, v damped normal equations: " << v_lm.t() << std::endl;
+  if (!compare(v, v_lm, 1e-6))
+    ok = false;
+
+  task.kill();
+  task_ne.kill();
+  return ok;
+}
+}
+
+int main()
+{
+  try {
+    if (!testPoints(vpServo::CURRENT)) {
+      std::cerr << "Normal equations with current points differ" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!testPoints(vpServo::DESIRED)) {
+      std::cerr << "Normal equations with desired points differ" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!testLuminance()) {
+      std::cerr << "Normal equations with luminance differ" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "testServoNormalEquations is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
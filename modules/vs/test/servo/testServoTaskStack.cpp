@@ -0,0 +1,220 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compare the control law of a stack of prioritized tasks to the explicit
+ * recursive formulation with projection operators.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/visual_features/vpFeatureBuilder.h>
+#include <visp3/visual_features/vpFeaturePoint.h>
+#include <visp3/vs/vpServo.h>
+#include <visp3/vs/vpServoTaskStack.h>
+
+#include <iostream>
+
+/*!
+  \example testServoTaskStack.cpp
+
+  Check that vpServoTaskStack gives the same joint velocities as the
+  recursive formulation with explicit projection operators, and the same
+  control law as vpServo with a secondary task.
+*/
+
+namespace
+{
+bool compare(const vpColVector &v1, const vpColVector &v2, double threshold)
+{
+  if (v1.getRows() != v2.getRows())
+    return false;
+  for (unsigned int i = 0; i < v1.getRows(); i++) {
+    if (std::fabs(v1[i] - v2[i]) > threshold * std::max(1., std::fabs(v1[i])))
+      return false;
+  }
+  return true;
+}
+
+vpMatrix buildJacobian(unsigned int m, unsigned int n, long seed)
+{
+  vpUniRand rand(seed);
+  vpMatrix J(m, n);
+  for (unsigned int i = 0; i < m; i++)
+    for (unsigned int j = 0; j < n; j++)
+      J[i][j] = 2 * rand() - 1;
+  return J;
+}
+
+vpColVector buildVelocity(unsigned int m, long seed)
+{
+  vpUniRand rand(seed);
+  vpColVector de(m);
+  for (unsigned int i = 0; i < m; i++)
+    de[i] = 0.2 * rand() - 0.1;
+  return de;
+}
+
+// Recursive formulation with explicit projection operators
+vpColVector solveExplicit(const std::vector<vpMatrix> &J, const std::vector<vpColVector> &de, vpMatrix &P)
+{
+  unsigned int n = J[0].getCols();
+  vpColVector qdot(n);
+  P.eye(n);
+  for (size_t k = 0; k < J.size(); k++) {
+    vpMatrix JP = J[k] * P;
+    vpMatrix JPp;
+    JP.pseudoInverse(JPp, 1e-6);
+    qdot += JPp * (de[k] - J[k] * qdot);
+    P = P - JPp * JP;
+  }
+  return qdot;
+}
+
+bool testStack()
+{
+  const unsigned int n = 7;
+  std::vector<vpMatrix> J;
+  std::vector<vpColVector> de;
+  J.push_back(buildJacobian(3, n, 1));
+  J.push_back(buildJacobian(2, n, 2));
+  J.push_back(buildJacobian(3, n, 3));
+  for (size_t k = 0; k < J.size(); k++)
+    de.push_back(buildVelocity(J[k].getRows(), 10 + (long)k));
+
+  vpServoTaskStack stack;
+  for (size_t k = 0; k < J.size(); k++)
+    stack.addTask(J[k], de[k]);
+
+  for (unsigned int iter = 0; iter < 3; iter++) {
+    if (iter == 1) {
+      // Only the task velocities change, the factorizations are reused
+      for (unsigned int k = 0; k < J.size(); k++) {
+        de[k] = buildVelocity(J[k].getRows(), 20 + (long)k);
+        stack.setTaskVelocity(k, de[k]);
+      }
+    } else if (iter == 2) {
+      // The Jacobian of the second task changes
+      J[1] = buildJacobian(2, n, 4);
+      stack.setTask(1, J[1], de[1]);
+    }
+
+    vpMatrix P;
+    vpColVector qdot_ref = solveExplicit(J, de, P);
+    vpColVector qdot = stack.computeControlLaw();
+    if (!compare(qdot, qdot_ref, 1e-8)) {
+      std::cerr << "Iteration " << iter << ": joint velocities differ" << std::endl;
+      return false;
+    }
+    vpMatrix P_stack = stack.getProjector(2);
+    for (unsigned int i = 0; i < n; i++) {
+      if (!compare(P_stack.getRow(i).t(), P.getRow(i).t(), 1e-8)) {
+        std::cerr << "Iteration " << iter << ": projectors differ" << std::endl;
+        return false;
+      }
+    }
+    if (stack.getRank(0) != 3 || stack.getRank(1) != 2 || stack.getRank(2) != 2) {
+      std::cerr << "Iteration " << iter << ": bad ranks" << std::endl;
+      return false;
+    }
+  }
+
+  // No degree of freedom remains for a secondary task
+  bool thrown = false;
+  try {
+    stack.secondaryTask(buildVelocity(n, 30));
+  } catch (const vpServoException &) {
+    thrown = true;
+  }
+  return thrown;
+}
+
+bool testServo()
+{
+  const unsigned int n = 7;
+  vpHomogeneousMatrix cdMo(0, 0, 0.75, 0, 0, 0);
+  vpHomogeneousMatrix cMo(0.15, -0.1, 1., vpMath::rad(10), vpMath::rad(-10), vpMath::rad(50));
+
+  vpPoint point[2];
+  point[0].setWorldCoordinates(-0.1, -0.1, 0);
+  point[1].setWorldCoordinates(0.1, 0.1, 0);
+
+  vpFeaturePoint p[2], pd[2];
+  for (unsigned int i = 0; i < 2; i++) {
+    point[i].track(cdMo);
+    vpFeatureBuilder::create(pd[i], point[i]);
+    point[i].track(cMo);
+    vpFeatureBuilder::create(p[i], point[i]);
+  }
+
+  vpMatrix eJe = buildJacobian(6, n, 5);
+  vpServo task;
+  task.setServo(vpServo::EYEINHAND_L_cVe_eJe);
+  task.setInteractionMatrixType(vpServo::CURRENT);
+  task.setLambda(0.5);
+  task.set_cVe(vpVelocityTwistMatrix());
+  task.set_eJe(eJe);
+  for (unsigned int i = 0; i < 2; i++)
+    task.addFeature(p[i], pd[i]);
+
+  vpColVector de2 = buildVelocity(n, 31);
+  vpColVector qdot_ref = task.computeControlLaw();
+  qdot_ref += task.secondaryTask(de2);
+
+  vpServoTaskStack stack;
+  task.set_eJe(eJe);
+  stack.addTask(task);
+  vpColVector qdot = stack.computeControlLaw();
+  qdot += stack.secondaryTask(de2);
+
+  task.kill();
+  return compare(qdot, qdot_ref, 1e-8);
+}
+}
+
+int main()
+{
+  try {
+    if (!testStack()) {
+      std::cerr << "Task stack differs from the explicit formulation" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!testServo()) {
+      std::cerr << "Task stack differs from vpServo" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "testServoTaskStack is ok" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}